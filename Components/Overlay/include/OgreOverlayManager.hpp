@@ -95,6 +95,12 @@ namespace Ogre {
         [[nodiscard]] auto getScriptPatterns() const noexcept -> const StringVector& override;
         /// @copydoc ScriptLoader::parseScript
         void parseScript(DataStreamPtr& stream, std::string_view groupName) override;
+        /// @copydoc ScriptLoader::supportsPreparse
+        [[nodiscard]] auto supportsPreparse() const noexcept -> bool override { return true; }
+        /// @copydoc ScriptLoader::preparseScript
+        [[nodiscard]] auto preparseScript(const DataStreamPtr& stream) -> std::any override;
+        /// @copydoc ScriptLoader::translateScript
+        void translateScript(std::any& preparsed, DataStreamPtr& stream, std::string_view groupName) override;
         /// @copydoc ScriptLoader::getLoadingOrder
         [[nodiscard]] auto getLoadingOrder() const -> Real override;
 
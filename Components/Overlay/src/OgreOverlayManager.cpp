@@ -39,6 +39,7 @@ import :Translator;
 
 import Ogre.Core;
 
+import <any>;
 import <memory>;
 import <utility>;
 
@@ -204,6 +205,24 @@ namespace Ogre {
         ScriptCompilerManager::getSingleton().parseScript(stream, groupName);
     }
     //---------------------------------------------------------------------
+    auto OverlayManager::preparseScript(const DataStreamPtr& stream) -> std::any
+    {
+        return ScriptCompilerManager::getSingleton().preparseScript(stream);
+    }
+    //---------------------------------------------------------------------
+    void OverlayManager::translateScript(std::any& preparsed, DataStreamPtr& stream, std::string_view groupName)
+    {
+        // same deduplication as parseScript, the preparsed result is simply dropped
+        if(!stream->getName().empty() && !mLoadedScripts.emplace(stream->getName()).second)
+        {
+            LogManager::getSingleton().logWarning(
+                std::format("Skipping loading '{}' as it is already loaded", stream->getName()));
+            return;
+        }
+
+        ScriptCompilerManager::getSingleton().translateScript(preparsed, stream, groupName);
+    }
+    //---------------------------------------------------------------------
     void OverlayManager::_queueOverlaysForRendering(Camera* cam, 
         RenderQueue* pQueue, Viewport* vp)
     {
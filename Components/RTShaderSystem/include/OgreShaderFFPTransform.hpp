@@ -79,11 +79,22 @@ public:
         mTexCoordIndex = Parameter::Content(std::to_underlying(Parameter::Content::TEXTURE_COORDINATE0) + texCoordIndex);
     }
 
+    /** Decode octahedral encoded normals and tangents before transforming them.
+    @remarks
+        Enable this for meshes quantised with Mesh::quantiseVertexData, which stores
+        directions as 2 normalised components. Positions need no decoding here, as the
+        decode matrix is folded into the world transform.
+    */
+    void setOctahedralDirections(bool enabled) { mOctahedral = enabled; }
+    [[nodiscard]] auto getOctahedralDirections() const noexcept -> bool { return mOctahedral; }
+
     static std::string_view const Type;
 protected:
     Parameter::Content mTexCoordIndex = Parameter::Content::TEXTURE_COORDINATE0;
     bool mSetPointSize;
     bool mInstanced = false;
+    bool mOctahedral = false;
+    bool mDecodeTangents = false;
     bool mDoLightCalculations;
 };
 
@@ -30,6 +30,7 @@ module;
 
 module Ogre.Components.RTShaderSystem;
 
+import :ShaderExNormalMapLighting;
 import :ShaderFFPRenderState;
 import :ShaderFFPTransform;
 import :ShaderFunction;
@@ -40,6 +41,7 @@ import :ShaderPrecompiledHeaders;
 import :ShaderPrerequisites;
 import :ShaderProgram;
 import :ShaderProgramSet;
+import :ShaderRenderState;
 import :ShaderScriptTranslator;
 
 import Ogre.Core;
@@ -71,6 +73,10 @@ auto FFPTransform::preAddToRenderState(const RenderState* renderState, Pass* src
 {
     mSetPointSize = srcPass->getPointSize() != 1.0f || srcPass->isPointAttenuationEnabled();
     mDoLightCalculations = srcPass->getLightingEnabled();
+    // tangents are only fed to the shader by normal mapping
+    mDecodeTangents = false;
+    for (auto srs : renderState->getSubRenderStates())
+        mDecodeTangents = mDecodeTangents || srs->getType() == NormalMapLighting::Type;
     return true;
 }
 
@@ -101,6 +107,21 @@ auto FFPTransform::createCpuSubPrograms(ProgramSet* programSet) -> bool
         !GpuProgramManager::getSingleton().isSyntaxSupported("glsl300es"))
         mInstanced = false;
 
+    if (mOctahedral)
+    {
+        auto decodeStage = vsEntry->getStage(std::to_underlying(FFPVertexShaderStage::PRE_PROCESS));
+        if (mDoLightCalculations)
+        {
+            auto vsInNormal = vsEntry->resolveInputParameter(Parameter::Content::NORMAL_OBJECT_SPACE);
+            decodeStage.callFunction("FFP_DecodeOctahedral", vsInNormal, vsInNormal);
+        }
+        if (mDecodeTangents)
+        {
+            auto vsInTangent = vsEntry->resolveInputParameter(Parameter::Content::TANGENT_OBJECT_SPACE);
+            decodeStage.callFunction("FFP_DecodeOctahedral", vsInTangent, vsInTangent);
+        }
+    }
+
     auto stage = vsEntry->getStage(std::to_underlying(FFPVertexShaderStage::TRANSFORM));
     if(mInstanced)
     {
@@ -145,6 +166,8 @@ void FFPTransform::copyFrom(const SubRenderState& rhs)
     mSetPointSize = rhsTransform.mSetPointSize;
     mInstanced = rhsTransform.mInstanced;
     mTexCoordIndex = rhsTransform.mTexCoordIndex;
+    mOctahedral = rhsTransform.mOctahedral;
+    mDecodeTangents = rhsTransform.mDecodeTangents;
 }
 
 //-----------------------------------------------------------------------
@@ -172,8 +195,16 @@ auto FFPTransformFactory::createInstance(ScriptCompiler* compiler,
                 hasError = true;
             }
 
-            if(++it != prop->values.end() && !SGScriptTranslator::getInt(*++it, &texCoordSlot))
-                hasError = true;
+            // optional attribute index and octahedral flag, in any order
+            bool octahedral = false;
+            while(++it != prop->values.end())
+            {
+                String flag;
+                if(SGScriptTranslator::getString(*it, &flag) && flag == "octahedral")
+                    octahedral = true;
+                else if(!SGScriptTranslator::getInt(*it, &texCoordSlot))
+                    hasError = true;
+            }
 
             if(hasError)
             {
@@ -183,6 +214,7 @@ auto FFPTransformFactory::createInstance(ScriptCompiler* compiler,
 
             auto ret = static_cast<FFPTransform*>(createOrRetrieveInstance(translator));
             ret->setInstancingParams(modelType == "instanced", texCoordSlot);
+            ret->setOctahedralDirections(octahedral);
 
             return ret;
         }
@@ -197,6 +229,8 @@ void FFPTransformFactory::writeInstance(MaterialSerializer* ser, SubRenderState*
 {
     ser->writeAttribute(4, "transform_stage");
     ser->writeValue("ffp");
+    if (static_cast<FFPTransform*>(subRenderState)->getOctahedralDirections())
+        ser->writeValue("octahedral");
 }
 
 //-----------------------------------------------------------------------
@@ -36,6 +36,7 @@ export import :Any;
 export import :Archive;
 export import :ArchiveFactory;
 export import :ArchiveManager;
+export import :AsyncIO;
 export import :AutoParamDataSource;
 export import :AxisAlignedBox;
 export import :Billboard;
@@ -106,6 +107,7 @@ export import :InstanceBatchVTF;
 export import :InstanceManager;
 export import :InstancedEntity;
 export import :IteratorWrapper;
+export import :KTX2Codec;
 export import :KeyFrame;
 export import :Light;
 export import :LodListener;
@@ -122,7 +124,9 @@ export import :Matrix3;
 export import :Matrix4;
 export import :MemoryAllocatorConfig;
 export import :Mesh;
+export import :MeshLodGenerator;
 export import :MeshManager;
+export import :MeshOptimiser;
 export import :MeshSerializer;
 export import :MeshSerializerImpl;
 export import :MovableObject;
@@ -131,6 +135,7 @@ export import :MurmurHash3;
 export import :NameGenerator;
 export import :Node;
 export import :OptimisedUtil;
+export import :Pack;
 export import :Particle;
 export import :ParticleAffector;
 export import :ParticleAffectorFactory;
@@ -215,6 +220,7 @@ export import :TagPoint;
 export import :TangentSpaceCalc;
 export import :Technique;
 export import :Texture;
+export import :TextureAtlas;
 export import :TextureManager;
 export import :TextureUnitState;
 export import :Timer;
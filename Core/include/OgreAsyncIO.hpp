@@ -0,0 +1,222 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstddef>
+
+export module Ogre.Core:AsyncIO;
+
+export import :DataStream;
+export import :Platform;
+export import :Prerequisites;
+
+export import <condition_variable>;
+export import <map>;
+export import <memory>;
+export import <mutex>;
+export import <span>;
+export import <vector>;
+
+export
+namespace Ogre {
+
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Resources
+    *  @{
+    */
+    /** A read submitted to an AsyncIOService.
+    */
+    class AsyncReadRequest
+    {
+    public:
+        AsyncReadRequest(int fd, uint64 offset, void* dest, size_t size, ::std::shared_ptr<void> buffer)
+            : mFd(fd), mOffset(offset), mDest(dest), mSize(size), mBuffer(::std::move(buffer)) {}
+
+        /** Blocks until the read completed.
+        @return The number of bytes read, less than requested only at the end of the file
+        */
+        auto wait() -> size_t;
+        /// Returns whether the read completed
+        [[nodiscard]] auto isDone() const -> bool;
+
+        [[nodiscard]] auto getFileDescriptor() const noexcept -> int { return mFd; }
+        [[nodiscard]] auto getOffset() const noexcept -> uint64 { return mOffset; }
+        [[nodiscard]] auto getDestination() const noexcept -> void* { return mDest; }
+        [[nodiscard]] auto getSize() const noexcept -> size_t { return mSize; }
+
+        /** Internal method called by the backends
+        @param result The number of bytes read, or a negative errno value
+        */
+        void _complete(long long result);
+
+    private:
+        int mFd;
+        uint64 mOffset;
+        void* mDest;
+        size_t mSize;
+        /// kept alive until the read completed, so the destination may be dropped early
+        ::std::shared_ptr<void> mBuffer;
+
+        mutable ::std::mutex mMutex;
+        ::std::condition_variable mCompleted;
+        bool mDone{false};
+        long long mResult{0};
+    };
+    using AsyncReadRequestPtr = ::std::shared_ptr<AsyncReadRequest>;
+
+    /** Services positioned file reads in the background.
+    @remarks
+        On Linux the reads go through an io_uring, so a whole batch of reads costs a single
+        system call and the device sees them all at once. Where io_uring is not available,
+        a pool of threads issues blocking reads instead.
+    */
+    class AsyncIOService
+    {
+    public:
+        enum class Backend
+        {
+            IO_URING,
+            THREAD_POOL
+        };
+
+        /// A read to submit
+        struct Read
+        {
+            int fd;
+            uint64 offset;
+            void* dest;
+            size_t size;
+            /// Optional owner of dest, kept alive until the read completed
+            ::std::shared_ptr<void> buffer;
+        };
+
+        /** Creates a service.
+        @param backend The preferred backend, THREAD_POOL is used if it is not available
+        @param queueDepth Maximum number of reads in flight
+        */
+        explicit AsyncIOService(Backend backend = Backend::IO_URING, uint32 queueDepth = 128);
+        ~AsyncIOService();
+
+        AsyncIOService(const AsyncIOService&) = delete;
+        auto operator=(const AsyncIOService&) -> AsyncIOService& = delete;
+
+        /// The service shared by all AsyncFileDataStream instances by default
+        static auto getDefault() -> AsyncIOService&;
+
+        /// Submits a single read
+        auto submit(Read read) -> AsyncReadRequestPtr;
+        /// Submits several reads at once
+        auto submit(::std::span<Read> reads) -> ::std::vector<AsyncReadRequestPtr>;
+
+        /// Returns the backend in use
+        [[nodiscard]] auto getBackend() const noexcept -> Backend { return mBackend; }
+
+        class Impl;
+    private:
+        Backend mBackend;
+        ::std::unique_ptr<Impl> mImpl;
+    };
+
+    /** Read-only stream over a file descriptor, reading ahead through an AsyncIOService.
+    @remarks
+        The file is read in blocks. Sequential reads keep a window of blocks in flight ahead of
+        the read position, and large reads are split into blocks that are read in parallel
+        straight into the destination. prefetch() starts reads of a range the caller will
+        need soon, e.g. the chunks of a file that is parsed out of order.
+    */
+    class AsyncFileDataStream : public DataStream
+    {
+    public:
+        /** Creates a stream taking ownership of a file descriptor opened for reading.
+        @param name The name of the stream
+        @param fd The file descriptor, closed with the stream
+        @param size The size of the file
+        @param service The service to read through
+        @param blockSize The size of the blocks the file is read in
+        @param readAhead The number of blocks to keep in flight ahead of the read position
+        */
+        AsyncFileDataStream(std::string_view name, int fd, size_t size,
+                            AsyncIOService& service = AsyncIOService::getDefault(),
+                            size_t blockSize = 256 * 1024, size_t readAhead = 4);
+        ~AsyncFileDataStream() override;
+
+        /** Hints that the given range is going to be read soon.
+        @remarks
+            Starts reads for the blocks of the range that are not in flight yet, as one batch.
+        */
+        void prefetch(size_t offset, size_t count);
+
+        /** @copydoc DataStream::read
+        */
+        auto read(void* buf, size_t count) -> size_t override;
+
+        /** @copydoc DataStream::skip
+        */
+        void skip(long count) override;
+
+        /** @copydoc DataStream::seek
+        */
+        void seek( size_t pos ) override;
+
+        /** @copydoc DataStream::tell
+        */
+        [[nodiscard]] auto tell() const -> size_t override;
+
+        /** @copydoc DataStream::eof
+        */
+        [[nodiscard]] auto eof() const -> bool override;
+
+        /** @copydoc DataStream::close
+        */
+        void close() override;
+
+    private:
+        struct Block
+        {
+            ::std::shared_ptr<uchar[]> data;
+            AsyncReadRequestPtr request;
+        };
+
+        /// Starts reads for the missing blocks in [first, last)
+        void requestBlocks(size_t first, size_t last);
+        /// Drops the blocks before the read position and starts the read-ahead
+        void advance();
+
+        int mFd;
+        size_t mPos{0};
+        size_t mBlockSize;
+        size_t mReadAhead;
+        AsyncIOService& mService;
+        /// blocks by index, offset = index * mBlockSize
+        ::std::map<size_t, Block> mBlocks;
+    };
+    /** @} */
+    /** @} */
+}
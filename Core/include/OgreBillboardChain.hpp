@@ -36,6 +36,7 @@ export module Ogre.Core:BillboardChain;
 export import :AxisAlignedBox;
 export import :ColourValue;
 export import :Common;
+export import :HardwareBufferManager;
 export import :Material;
 export import :MovableObject;
 export import :Prerequisites;
@@ -319,7 +320,7 @@ class VertexData;
         mutable bool mBoundsDirty{true};
         /// Is the index buffer dirty?
         bool mIndexContentDirty{true};
-        /// Is the vertex buffer dirty?
+        /// Is the vertex buffer dirty for all segments?
         bool mVertexContentDirty{true};
         /// AABB
         mutable AxisAlignedBox mAABB;
@@ -343,6 +344,10 @@ class VertexData;
 
         /// The list holding the chain elements
         ElementList mChainElementList;
+        /// Generated vertices in system memory, laid out like the vertex buffer
+        std::vector<char> mVertexCache;
+        /// Range of the streaming ring holding the vertices when dynamic
+        StreamingVertexBuffer::Allocation mStreamAlloc;
 
         /** Simple struct defining a chain segment by referencing a subset of
             the preallocated buffer (which will be mMaxElementsPerChain * mChainCount
@@ -359,6 +364,8 @@ class VertexData;
             size_t head;
             /// The 'tail' of the chain, relative to start
             size_t tail;
+            /// Do the vertices of this segment need rebuilding?
+            bool dirty{true};
         };
         using ChainSegmentList = std::vector<ChainSegment>;
         ChainSegmentList mChainSegmentList;
@@ -371,6 +378,8 @@ class VertexData;
         virtual void setupBuffers();
         /// Update the contents of the vertex buffer
         virtual void updateVertexBuffer(Camera* cam);
+        /// Generate the vertices of one segment into the vertex cache
+        void buildSegmentVertices(const ChainSegment& seg, const Vector3& eyePos);
         /// Update the contents of the index buffer
         virtual void updateIndexBuffer();
         virtual void updateBoundingBox() const;
@@ -35,6 +35,7 @@ export import :AxisAlignedBox;
 export import :Billboard;
 export import :ColourValue;
 export import :Common;
+export import :HardwareBufferManager;
 export import :Material;
 export import :MovableObject;
 export import :Platform;
@@ -192,6 +193,8 @@ class VertexData;
         std::unique_ptr<VertexData> mVertexData;
         /// Shortcut to main buffer (positions, colours, texture coords)
         HardwareVertexBufferSharedPtr mMainBuf;
+        /// Range of the streaming ring used instead of mMainBuf when auto updating
+        StreamingVertexBuffer::Allocation mStreamAlloc;
         /// Locked pointer to buffer
         float* mLockPtr;
         /// Boundary offsets based on origin and camera orientation
@@ -76,20 +76,12 @@ namespace Ogre {
             }
         }
         /** Reverses byte order of chunks in buffer, where 'size' is size of one chunk.
+        @remarks
+            Arrays of 2, 4 and 8 byte chunks are swapped with SSSE3 or AVX2 shuffles
+            where the CPU supports them, so prefer one call over a whole array to
+            swapping its elements one by one.
         */
-        static inline void bswapChunks(void * pData, size_t size, size_t count)
-        {
-            for(size_t c = 0; c < count; ++c)
-            {
-                char swapByte;
-                for(char *p0 = (char*)pData + c * size, *p1 = p0 + size - 1; p0 < p1; ++p0, --p1)
-                {
-                    swapByte = *p0;
-                    *p0 = *p1;
-                    *p1 = swapByte;
-                }
-            }
-        }
+        static void bswapChunks(void * pData, size_t size, size_t count);
 
         /** Returns the most significant bit set in a value.
         */
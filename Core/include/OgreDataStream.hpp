@@ -206,7 +206,14 @@ namespace Ogre {
 
         /** Close the stream; this makes further operations invalid. */
         virtual void close() = 0;
-        
+
+        /** Returns the whole stream contents, if they are held in memory which may outlive the stream.
+        @remarks
+            Streams over memory mapped files return the start of the mapping, with the returned
+            pointer keeping the mapping alive. Readers can then reference the data in place rather
+            than copying it out with read(). All other streams return an empty pointer.
+        */
+        [[nodiscard]] virtual auto getSharedData() const -> ::std::shared_ptr<uchar> { return {}; }
 
     };
 
@@ -226,6 +233,8 @@ namespace Ogre {
         uchar* mEnd;
         /// Do we delete the memory on close
         bool mFreeOnClose;          
+        /// Keeps externally owned memory alive, see getSharedData
+        ::std::shared_ptr<uchar> mSharedData;
     public:
         
         /** Wrap an existing memory chunk in a stream.
@@ -325,6 +334,16 @@ namespace Ogre {
         MemoryDataStream(std::string_view name, size_t size, 
                 bool freeOnClose = true, bool readOnly = false);
 
+        /** Wrap shared memory in a named, read-only stream.
+        @remarks
+            The stream holds a reference to the memory until it is closed, and hands it out
+            through getSharedData so readers can keep using the data in place afterwards.
+        @param name The name to give the stream
+        @param data The memory to wrap
+        @param size The size of the memory chunk in bytes
+        */
+        MemoryDataStream(std::string_view name, ::std::shared_ptr<uchar> data, size_t size);
+
         ~MemoryDataStream() override;
 
         /** Get a pointer to the start of the memory block this stream holds. */
@@ -369,8 +388,27 @@ namespace Ogre {
         */
         void close() override;
 
-        /** Sets whether or not to free the encapsulated memory on close. */
+        /** @copydoc DataStream::getSharedData
+        */
+        [[nodiscard]] auto getSharedData() const -> ::std::shared_ptr<uchar> override { return mSharedData; }
+
+        /** Sets whether or not to free the encapsulated memory on close.
+        @note Has no effect once the memory is shared, see subStream.
+        */
         void setFreeOnClose(bool free) { mFreeOnClose = free; }
+
+        /** Create a read-only stream over a range of this stream's memory, without copying it.
+        @remarks
+            If this stream owns its memory, ownership is moved into a reference count shared
+            with the returned stream, so the slice stays valid after this stream is closed and
+            getSharedData returns the slice start on both. Slices of memory the stream does
+            not own are only valid for as long as the caller keeps that memory alive.
+        @par
+            Writes through this stream remain visible to the slices.
+        @param offset Start of the range, relative to the start of the memory block
+        @param length Size of the range in bytes
+        */
+        [[nodiscard]] auto subStream(size_t offset, size_t length) -> MemoryDataStreamPtr;
     };
 
     /** Common subclass of DataStream for handling data from 
@@ -54,10 +54,18 @@ namespace Ogre {
     {
     private:
         unsigned char* mData;
+        /// Set if mData is owned elsewhere, e.g. by a memory mapped file
+        ::std::shared_ptr<uchar> mSharedData;
         auto lockImpl(size_t offset, size_t length, LockOptions options) -> void* override;
         void unlockImpl() override;
     public:
         DefaultHardwareBuffer(size_t sizeInBytes);
+        /** Use existing memory instead of allocating it.
+        @remarks
+            The buffer reads and writes @p data in place and keeps it alive for its lifetime.
+            Used to back buffers directly by the pages of a memory mapped file.
+        */
+        DefaultHardwareBuffer(::std::shared_ptr<uchar> data, size_t sizeInBytes);
         ~DefaultHardwareBuffer() override;
         void readData(size_t offset, size_t length, void* pDest) override;
         void writeData(size_t offset, size_t length, const void* pSource, bool discardWholeBuffer = false) override;
@@ -122,6 +130,7 @@ namespace Ogre {
         ~DefaultHardwareBufferManager() override
         {
             // have to do this before mImpl is gone
+            destroyAllStreamingBuffers();
             destroyAllDeclarations();
             destroyAllBindings();
         }
@@ -167,6 +167,8 @@ class VertexData;
         bool mVertexProgramInUse : 1;
         /// Has this entity been initialised yet?
         bool mInitialised : 1;
+        /// Flag indicating whether SubMesh meshlets are culled against the camera.
+        bool mMeshletCulling : 1;
 
         /** Internal method - given vertex data which could be from the Mesh or
             any submesh, finds the temporary blend copy.
@@ -850,6 +852,22 @@ class VertexData;
             return mAlwaysUpdateMainSkeleton;
         }
 
+        /** Sets whether the meshlets of the SubMeshes are culled per camera.
+        @remarks
+            When enabled, each SubEntity whose SubMesh has meshlets (see SubMesh::buildMeshlets)
+            tests their bounding spheres against the camera frustum and their normal cones
+            against the camera position, and only submits the surviving clusters. This trades
+            some CPU time and a dynamic index buffer per SubEntity for less vertex work on large,
+            partially visible meshes. Culling is skipped for animated entities, LOD levels
+            other than the first and SubEntities with a custom index range.
+        */
+        void setMeshletCullingEnabled(bool enabled);
+
+        /// Gets whether meshlet culling is enabled, see setMeshletCullingEnabled.
+        auto getMeshletCullingEnabled() const noexcept -> bool {
+            return mMeshletCulling;
+        }
+
         /** If true, the skeleton of the entity will be used to update the bounding box for culling.
             Useful if you have skeletal animations that move the bones away from the root.  Otherwise, the
             bounding box of the mesh in the binding pose will be used.
@@ -49,6 +49,12 @@ class Archive;
     /// internal method to open a FileStreamDataStream
     auto _openFileStream(std::string_view path, std::ios::openmode mode, std::string_view name = "") -> DataStreamPtr;
 
+    /// internal method to open a read-only MemoryDataStream over a memory mapping of a file
+    auto _openMappedFileStream(std::string_view path, std::string_view name = "") -> DataStreamPtr;
+
+    /// internal method to open an AsyncFileDataStream reading through the default AsyncIOService
+    auto _openAsyncFileStream(std::string_view path, std::string_view name = "") -> DataStreamPtr;
+
     /** Specialisation of the ArchiveFactory to allow reading of files from
         filesystem folders / directories.
     */
@@ -69,6 +75,28 @@ class Archive;
 
         /// Get whether hidden files are ignored during filesystem enumeration.
         static auto getIgnoreHidden() noexcept -> bool;
+
+        /** Set whether files opened read-only are memory mapped instead of read through a file stream.
+        @remarks
+            Mapped streams expose their contents through DataStream::getSharedData, which lets
+            loaders such as the MeshSerializer reference the data in place. The mapping is private,
+            so modifying the mapped memory never affects the file. The default is false.
+        */
+        static void setMapFiles(bool map);
+
+        /// Get whether files opened read-only are memory mapped.
+        static auto getMapFiles() noexcept -> bool;
+
+        /** Set whether files opened read-only are read through an AsyncFileDataStream.
+        @remarks
+            The streams read ahead of the read position and split large reads into parallel
+            requests, which suits background loading from fast storage. setMapFiles takes
+            precedence. The default is false.
+        */
+        static void setAsyncStreams(bool async);
+
+        /// Get whether files opened read-only are read through an AsyncFileDataStream.
+        static auto getAsyncStreams() noexcept -> bool;
     };
 
     class APKFileSystemArchiveFactory : public ArchiveFactory
@@ -428,6 +428,40 @@ namespace Ogre {
                     mDelegate->suppressHardwareUpdate(suppress);
             }
 
+            /** Replaces the system memory copy of this buffer by @p data and uploads it.
+            @remarks
+                If the buffer keeps a shadow buffer, @p data becomes the shadow and is uploaded
+                from in place. If the buffer lives in system memory itself, @p data replaces that
+                storage. Lets loaders hand over memory they already hold, e.g. a memory mapped
+                file, instead of copying it into freshly allocated storage.
+            @param data A system memory buffer of the same size as this one
+            @return false if this buffer has no system memory copy, in which case @p data is not
+                used and should be uploaded with writeData instead
+            */
+            auto _adoptSystemMemoryBuffer(std::unique_ptr<HardwareBuffer>& data) -> bool
+            {
+                OgreAssert(data->getSizeInBytes() == mSizeInBytes && data->isSystemMemory(),
+                           "Buffer must be a system memory buffer of the same size");
+                OgreAssert(!isLocked(), "Cannot replace the data of a locked buffer");
+                if (mShadowBuffer)
+                {
+                    mShadowBuffer = std::move(data);
+                    mShadowUpdated = true;
+                    mLockStart = 0;
+                    mLockSize = mSizeInBytes;
+                    _updateFromShadow();
+                    return true;
+                }
+                if (!mDelegate)
+                    return false;
+                if (mDelegate->isSystemMemory() && !mDelegate->mDelegate && !mDelegate->mShadowBuffer)
+                {
+                    mDelegate = std::move(data);
+                    return true;
+                }
+                return mDelegate->_adoptSystemMemoryBuffer(data);
+            }
+
             template <typename T> auto _getImpl() -> T*
             {
                 return static_cast<T*>(mDelegate.get());
@@ -38,11 +38,14 @@ export import :Prerequisites;
 export import :SharedPtr;
 export import :Singleton;
 
+export import <array>;
 export import <map>;
+export import <memory>;
 export import <set>;
 
 export
 namespace Ogre {
+class HardwareBufferManagerBase;
 class HardwareVertexBuffer;
 class VertexBufferBinding;
 class VertexData;
@@ -105,6 +108,114 @@ class VertexDeclaration;
         [[nodiscard]] auto buffersCheckedOut(bool positions = true, bool normals = true) const -> bool;
     };
 
+    /** Ring of dynamic vertex memory which is sub-allocated anew every frame.
+    @remarks
+        Objects which regenerate their geometry every frame (billboards, chains,
+        trails) would otherwise lock their own dynamic buffer with
+        HardwareBuffer::LockOptions::DISCARD, which forces the driver to rename
+        the buffer each time. Instead they can request a range of this ring,
+        which is locked with HardwareBuffer::LockOptions::NO_OVERWRITE. A range
+        handed out in one frame is not reused until FRAMES_IN_FLIGHT frames
+        have passed, so the GPU is never reading memory that is being written.
+        Ranges are kept one frame longer than that, so the next frame can copy
+        their unchanged parts into its own range on the GPU instead of uploading
+        them again.
+    @par
+        All vertices in the ring share one vertex size, which is why
+        HardwareBufferManagerBase keeps one ring per vertex size. Use
+        HardwareBufferManagerBase::getStreamingVertexBuffer to obtain it.
+    */
+    class StreamingVertexBuffer : public BufferAlloc
+    {
+    public:
+        /// Number of frames the GPU may still read an allocation after the frame it was made in
+        static const size_t FRAMES_IN_FLIGHT = 3;
+
+        /** A range of the ring, valid for the frame in which it was allocated. */
+        struct Allocation
+        {
+            /// The buffer to bind, may change when the ring has to grow
+            HardwareVertexBufferPtr buffer;
+            /// First vertex of the range, to be used as VertexData::vertexStart
+            size_t vertexStart{0};
+            /// Number of vertices in the range
+            size_t vertexCount{0};
+            /// Frame in which the range was allocated
+            size_t frame{0};
+        };
+
+        StreamingVertexBuffer(HardwareBufferManagerBase* mgr, size_t vertexSize, size_t initialVertices);
+
+        /** Reserve a range of vertices for the current frame.
+        @remarks
+            If the ring has not enough free space left, it is replaced by a
+            larger buffer. Ranges allocated earlier keep a reference to the old
+            buffer, so they remain valid.
+        */
+        auto allocate(size_t vertexCount) -> Allocation;
+
+        /** Lock the range of an allocation for writing without a discard. */
+        static auto lock(const Allocation& alloc) -> void*;
+        /** Lock a part of the range of an allocation for writing without a discard.
+        @param alloc The allocation
+        @param firstVertex First vertex to lock, relative to the start of the allocation
+        @param vertexCount Number of vertices to lock
+        */
+        static auto lock(const Allocation& alloc, size_t firstVertex, size_t vertexCount) -> void*;
+
+        /** Copy vertices from one allocation to another on the GPU.
+        @remarks
+            The source must still be intact, see canCopyFrom. Neither allocation may be locked.
+        @param src The allocation to copy from
+        @param srcVertex First vertex to copy, relative to the start of src
+        @param dst The allocation to copy to
+        @param dstVertex First vertex to write, relative to the start of dst
+        @param vertexCount Number of vertices to copy
+        */
+        static void copy(const Allocation& src, size_t srcVertex, const Allocation& dst, size_t dstVertex,
+                         size_t vertexCount);
+
+        /** Whether the allocation can still be used for rendering the current frame.
+        @remarks
+            An allocation from an earlier frame may already be overwritten once
+            the frame counter advances, so its contents must be uploaded again.
+        */
+        [[nodiscard]] auto isCurrent(const Allocation& alloc) const noexcept -> bool
+        {
+            return alloc.buffer && alloc.frame == mFrame;
+        }
+
+        /** Whether the contents of an allocation can still be copied into one of the current frame.
+        @remarks
+            This holds for the allocations of the current and of the previous frame.
+        */
+        [[nodiscard]] auto canCopyFrom(const Allocation& alloc) const noexcept -> bool
+        {
+            return alloc.buffer && alloc.frame + 1 >= mFrame;
+        }
+
+        [[nodiscard]] auto getVertexSize() const noexcept -> size_t { return mVertexSize; }
+        /// Total number of vertices the ring can hold
+        [[nodiscard]] auto getCapacity() const noexcept -> size_t { return mCapacity; }
+
+        /// Called once per frame by the manager, retires the oldest frame in flight
+        void _notifyFrameEnded();
+
+    private:
+        void grow(size_t minVertices);
+
+        HardwareBufferManagerBase* mMgr;
+        size_t mVertexSize;
+        size_t mCapacity{0};
+        /// Next free vertex
+        size_t mHead{0};
+        /// Monotonic frame counter
+        size_t mFrame{0};
+        /// Vertices consumed by each frame in flight and the one before, including wasted space at the wrap
+        std::array<size_t, FRAMES_IN_FLIGHT + 1> mFrameUsage{};
+        HardwareVertexBufferPtr mBuffer;
+    };
+
 
     /** Base definition of a hardware buffer manager.
     @remarks
@@ -134,6 +245,12 @@ class VertexDeclaration;
         virtual void destroyAllDeclarations();
         /// Internal method for destroys all vertex buffer bindings.
         virtual void destroyAllBindings();
+        /// Internal method for destroys all streaming vertex buffers.
+        void destroyAllStreamingBuffers();
+
+        using StreamingVertexBufferMap = std::map<size_t, std::unique_ptr<StreamingVertexBuffer>>;
+        /// Streaming rings, keyed by vertex size
+        StreamingVertexBufferMap mStreamingVertexBuffers;
 
         /// Internal method for creates a new vertex declaration, may be overridden by certain rendering APIs.
         virtual auto createVertexDeclarationImpl() -> VertexDeclaration*;
@@ -392,6 +509,22 @@ class VertexDeclaration;
 
         /// Notification that a hardware vertex buffer has been destroyed.
         void _notifyVertexBufferDestroyed(HardwareVertexBuffer* buf);
+
+        /** Get the frame-ring streaming buffer for vertices of the given size.
+        @remarks
+            The ring is created on first use and shared by all callers using the
+            same vertex size. See StreamingVertexBuffer.
+        @param vertexSize
+            The size in bytes of each vertex
+        @param initialVertices
+            Capacity hint used when the ring is created
+        */
+        auto getStreamingVertexBuffer(size_t vertexSize, size_t initialVertices = 16384) -> StreamingVertexBuffer&;
+
+        /** Internal method for advancing the frame counter of all streaming
+            buffers; is called by OGRE at the end of each frame.
+        */
+        void _notifyStreamingFrameEnded();
     };
 
     /** Singleton wrapper for hardware buffer manager. */
@@ -164,6 +164,10 @@ namespace Ogre {
         SHORT4_NORM = 32,
         USHORT2_NORM = 33, /// unsigned shorts (normalized to 0..1)
         USHORT4_NORM = 34,
+        HALF1 = 35,  ///< @deprecated (see #VertexElementType note)
+        HALF2 = 36,  /// half precision floats
+        HALF3 = 37,  ///< @deprecated (see #VertexElementType note)
+        HALF4 = 38,
         COLOUR = UBYTE4_NORM,  ///< @deprecated use UBYTE4_NORM
         COLOUR_ARGB = UBYTE4_NORM,  ///< @deprecated use UBYTE4_NORM
         COLOUR_ABGR = UBYTE4_NORM,  ///< @deprecated use VertexElementType::UBYTE4_NORM
@@ -247,6 +251,36 @@ namespace Ogre {
         /** Utility method to get the most appropriate packed colour vertex element format. */
         static auto getBestColourVertexElementType() -> VertexElementType;
 
+        /** Whether this element holds an octahedral encoded direction.
+        @remarks
+            Normals, tangents and binormals stored in VertexElementType::SHORT2_NORM,
+            VertexElementType::SHORT4_NORM or VertexElementType::BYTE4_NORM elements are
+            octahedral encoded: the first two components map the unit sphere onto a square,
+            the fourth component (if any) holds the tangent handedness.
+        */
+        [[nodiscard]] auto isOctahedral() const noexcept -> bool;
+
+        /** Reads the value of this element as floats, decoding normalised, half precision
+            and octahedral encodings.
+        @param pElem Pointer to the element, see baseVertexPointerToElement
+        @param pOut Receives 4 values, missing components are set to (0, 0, 0, 1)
+        */
+        void readFloats(const void* pElem, float* pOut) const;
+
+        /** Writes floats to this element, encoding them to the element type.
+        @remarks
+            The inverse of readFloats, values outside the range of normalised types are clamped.
+        @param pElem Pointer to the element, see baseVertexPointerToElement
+        @param pIn The values to write, as many as getTypeCount
+        */
+        void writeFloats(void* pElem, const float* pIn) const;
+
+        /// Maps a unit direction onto the octahedral square [-1, 1]^2
+        static void encodeOctahedral(const float* dir, float* pOut);
+
+        /// Maps a point of the octahedral square back onto the unit sphere
+        static void decodeOctahedral(const float* oct, float* pOut);
+
         [[nodiscard]] inline auto operator== (const VertexElement& rhs) const noexcept -> bool = default;
 
         /** Adjusts a pointer to the base of a vertex to point at this element.
@@ -353,6 +387,19 @@ namespace Ogre {
         [[nodiscard]] auto getAutoOrganisedDeclaration(bool skeletalAnimation,
             bool vertexAnimation, bool vertexAnimationNormals) const -> VertexDeclaration*;
 
+        /** Generates a new VertexDeclaration with compact quantised element types,
+            which can be used with VertexData::reorganiseBuffers to compress vertex data.
+        @remarks
+            Float positions become VertexElementType::SHORT4_NORM (see VertexData::positionDecodeMatrix),
+            float normals, tangents and binormals are octahedral encoded (see VertexElement::isOctahedral)
+            and float texture coordinates become half precision. Other elements keep their type.
+            Buffer assignments are kept, offsets are recomputed.
+        @param compactDirections Whether directions use 8 rather than 16 bits per component.
+            Note that the 4 byte attribute alignment pads 8 bit normals to the size of 16 bit ones,
+            so this only saves memory for tangents and binormals.
+        */
+        [[nodiscard]] auto getQuantisedDeclaration(bool compactDirections = false) const -> VertexDeclaration*;
+
         /** Gets the index of the highest source value referenced by this declaration. */
         [[nodiscard]] auto getMaxSource() const noexcept -> unsigned short;
 
@@ -39,6 +39,7 @@ export import :PixelFormat;
 export import :Platform;
 export import :Prerequisites;
 
+export import <memory>;
 export import <vector>;
 
 export
@@ -234,6 +235,15 @@ namespace Ogre {
         {
             return loadDynamicImage(data, width, height, 1, format);
         }
+
+        /** Wraps shared memory, such as a memory mapped file, without copying it.
+            @remarks
+                The image holds a reference to the memory until it is freed or loaded
+                again, and copies of the image share it. See loadDynamicImage for the
+                layout and the other parameters.
+        */
+        auto loadDynamicImage(::std::shared_ptr<uchar> data, uint32 width, uint32 height, uint32 depth,
+                              PixelFormat format, uint32 numFaces = 1, TextureMipmap numMipMaps = {}) -> Image&;
         /** Loads raw data from a stream. See the function
             loadDynamicImage for a description of the parameters.
             @remarks 
@@ -472,19 +482,82 @@ namespace Ogre {
         {
             NEAREST,
             LINEAR,
-            BILINEAR = LINEAR
+            BILINEAR = LINEAR,
+            /// Averages all source pixels covered by a destination pixel
+            BOX,
+            /// Mitchell-Netravali cubic (B = C = 1/3), a good general purpose filter
+            MITCHELL,
+            /// Lanczos windowed sinc with 3 lobes, sharpest but may ring on hard edges
+            LANCZOS,
+            /// Kaiser windowed sinc, a sharp filter well suited to mipmap generation
+            KAISER
         };
         /** Scale a 1D, 2D or 3D image volume. 
             @param  src         PixelBox containing the source pointer, dimensions and format
             @param  dst         PixelBox containing the destination pointer, dimensions and format
             @param  filter      Which filter to use
+            @param  gammaCorrect Whether to filter in linear space, treating the colour channels
+                of the image as sRGB encoded. Ignored for floating point formats.
             @remarks    This function can do pixel format conversion in the process.
+            @par
+                BOX, MITCHELL and LANCZOS, as well as gamma correct BILINEAR scaling, use a
+                separable resampler that widens the filter when minifying and processes
+                bands of rows on multiple threads.
             @note   dst and src can point to the same PixelBox object without any problem
         */
-        static void scale(const PixelBox &src, const PixelBox &dst, Filter filter = Filter::BILINEAR);
+        static void scale(const PixelBox &src, const PixelBox &dst, Filter filter = Filter::BILINEAR, bool gammaCorrect = false);
         
         /** Resize a 2D image, applying the appropriate filter. */
-        void resize(ushort width, ushort height, Filter filter = Filter::BILINEAR);
+        void resize(ushort width, ushort height, Filter filter = Filter::BILINEAR, bool gammaCorrect = false);
+
+        /** Generate the full mipmap chain of every face of the image, replacing any existing mipmaps.
+            @remarks
+                The image buffer is grown to hold the chain if needed. Each level is filtered down
+                from the previous one. Faces are processed on separate threads if there are enough
+                of them to use every thread, otherwise the rows of large levels are split across
+                threads. Box filtering of 8 bit four channel
+                images with even dimensions uses a dedicated SIMD path.
+            @param filter Downsampling filter, BOX or KAISER are the usual choices. NEAREST is
+                treated as BOX.
+            @param gammaCorrect Whether to filter in linear space, treating the colour channels
+                as sRGB encoded. Ignored for floating point formats.
+            @param alphaCoverageRef If greater than zero, the alpha channel of each level is scaled
+                so that the fraction of pixels with alpha of at least this value matches the top
+                level. Keeps alpha tested cutouts such as foliage from thinning out in the distance.
+            @return false if the format can not be filtered on the CPU, e.g. compressed formats
+        */
+        auto generateMipmaps(Filter filter = Filter::BOX, bool gammaCorrect = false, float alphaCoverageRef = 0.0f) -> bool;
+
+        /// Trade-off between encoding time and quality for compress()
+        enum class CompressionQuality
+        {
+            /// Single pass endpoint fit, for images compressed at load time
+            FAST,
+            NORMAL,
+            /// More refinement passes and a wider endpoint search
+            HIGH
+        };
+
+        /** Block compress every face and mipmap of the image, replacing its contents.
+            @remarks
+                Rows of 4x4 blocks are encoded on multiple threads. The result can be saved
+                as DDS or uploaded directly to a texture with the same format.
+            @param format DXT1, DXT5, BC4_UNORM, BC5_UNORM or BC7_UNORM. DXT1 uses its
+                punch-through mode for texels with alpha below one half, BC7 is encoded
+                with its single subset RGBA mode only.
+            @param quality Encoding effort
+        */
+        void compress(PixelFormat format, CompressionQuality quality = CompressionQuality::NORMAL);
+
+        /** Decode every face and mipmap of a block compressed image, replacing its contents.
+            @remarks
+                Supports BC1-BC7 (DXT1-5), ETC1, ETC2 and LDR ASTC. BC6H is decoded to
+                #PixelFormat::FLOAT16_RGBA, BC4 and BC5 to one and two channel formats and
+                everything else to #PixelFormat::BYTE_RGBA. Textures call this on load for
+                formats the render system can not sample, unless
+                TextureManager::setSoftwareDecompression is disabled.
+        */
+        void decompress();
         
         /// Static function to calculate size in bytes from the number of mipmaps, faces and the dimensions
         static auto calculateSize(TextureMipmap mipmaps, uint32 faces, uint32 width, uint32 height, uint32 depth, PixelFormat format) -> size_t;
@@ -514,6 +587,8 @@ namespace Ogre {
         uchar mPixelSize;
         /// A bool to determine if we delete the buffer or the calling app does
         bool mAutoDelete{ true };
+        /// Keeps shared memory alive, e.g. a memory mapped file
+        ::std::shared_ptr<uchar> mSharedData;
     };
 
     using ImagePtrList = std::vector<Image *>;
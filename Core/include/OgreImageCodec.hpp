@@ -96,6 +96,31 @@ namespace Ogre {
         {
             return {};
         }
+
+        /** Reads the size and format of an encoded image without decoding its pixels.
+        @remarks
+            The stream position is undefined afterwards.
+        @return true if the codec can decode this image with decodeInto without buffering
+            the whole image, false otherwise
+        */
+        [[nodiscard]] virtual auto decodeHeader(const DataStreamPtr& input, ImageData& header) const -> bool
+        {
+            return false;
+        }
+
+        /** Decodes an image straight into caller provided memory.
+        @remarks
+            Codecs that support it (see decodeHeader) decode scanline by scanline and convert each
+            one to the format of dst while it is still in cache, so no intermediate buffer of the
+            whole image is allocated. The default implementation decodes to an Image first.
+        @param input The encoded image, positioned at its start
+        @param dst Where to put the pixels, must have the size of the image
+        */
+        virtual void decodeInto(const DataStreamPtr& input, const PixelBox& dst) const;
+
+    protected:
+        /// Makes dest take over the buffer and the metadata of a decoding
+        static void loadDecoded(const DecodeResult& decoded, Image& dest);
     };
 
     /** @} */
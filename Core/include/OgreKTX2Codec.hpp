@@ -0,0 +1,120 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstddef>
+
+export module Ogre.Core:KTX2Codec;
+
+export import :ImageCodec;
+export import :Prerequisites;
+
+export import <vector>;
+
+export
+namespace Ogre {
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Image
+    *  @{
+    */
+
+    /** Codec for Khronos KTX 2.0 containers.
+    @remarks
+        Levels are decoded in parallel, each one straight into its place in the
+        Image, so compressed formats stay compressed and are copied exactly once.
+        Uncompressed, Zstandard and zlib supercompressed levels are read. BasisLZ
+        files are reported as not implemented. Encoding stores the levels
+        uncompressed or zlib supercompressed.
+    @par
+        6 faces are exposed as a cubemap; cubemap arrays are not supported. decode()
+        returns the layers of an array as the depth of the image, which only holds
+        the first level because Image halves the depth of every mipmap. Use
+        loadLayers() to keep the mipmaps of arrays.
+    */
+    class KTX2Codec : public ImageCodec
+    {
+    public:
+        KTX2Codec() = default;
+        ~KTX2Codec() override = default;
+
+        using ImageCodec::decode;
+        using ImageCodec::encode;
+        using ImageCodec::encodeToFile;
+
+        [[nodiscard]] auto encode(const MemoryDataStreamPtr& input, const CodecDataPtr& pData) const -> DataStreamPtr override;
+        void encodeToFile(const MemoryDataStreamPtr& input, std::string_view outFileName, const CodecDataPtr& pData) const override;
+        [[nodiscard]] auto decode(const DataStreamPtr& input) const -> DecodeResult override;
+        auto magicNumberToFileExt(const char *magicNumberPtr, size_t maxbytes) const -> std::string_view override;
+        [[nodiscard]] auto getType() const -> std::string_view override;
+
+        /** Loads only the mip levels whose width and height are at most maxResolution.
+        @remarks
+            The larger levels are not read at all, which allows showing a low resolution
+            version of a texture quickly and loading the full chain later. If even the
+            smallest level is larger, only that one is loaded.
+        @param input The encoded KTX2 file
+        @param dest The image to load into
+        @param maxResolution Largest width or height to load, 0 loads all levels
+        */
+        static auto loadLevels(const DataStreamPtr& input, Image& dest, uint32 maxResolution) -> Image&;
+
+        /** Loads each array layer of a KTX2 file into its own image, with all its mip levels.
+        @remarks
+            The images can be passed to Texture::_loadImages of a TextureType::_2D_ARRAY
+            texture. A file without layers gives a single image.
+        @param input The encoded KTX2 file
+        @param layers Receives one image per layer
+        @param maxResolution Largest width or height to load, 0 loads all levels
+        */
+        static void loadLayers(const DataStreamPtr& input, std::vector<Image>& layers, uint32 maxResolution);
+
+        /** Sets the zlib level used to supercompress the levels when encoding.
+        @param level 0 stores the levels uncompressed, 1 to 9 trade speed for size
+        */
+        void setSupercompressionLevel(int level) { mSupercompressionLevel = level; }
+        [[nodiscard]] auto getSupercompressionLevel() const noexcept -> int { return mSupercompressionLevel; }
+
+        /// Static method to startup and register the KTX2 codec
+        static void startup();
+        /// Static method to shutdown and unregister the KTX2 codec
+        static void shutdown();
+        /// The registered codec instance, nullptr before startup
+        static auto getSingletonPtr() noexcept -> KTX2Codec* { return msInstance; }
+
+    private:
+        int mSupercompressionLevel{0};
+
+        /// Single registered codec instance
+        static KTX2Codec* msInstance;
+    };
+    /** @} */
+    /** @} */
+
+} // namespace
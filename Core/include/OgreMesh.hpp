@@ -109,6 +109,7 @@ class VertexData;
     {
         friend class SubMesh;
         friend class MeshSerializerImpl;
+        friend class MeshSerializerImpl_Mappable;
         friend class MeshSerializerImpl_v1_8;
         friend class MeshSerializerImpl_v1_4;
         friend class MeshSerializerImpl_v1_3;
@@ -739,6 +740,22 @@ class VertexData;
         /// @copydoc VertexData::prepareForShadowVolume
         void prepareForShadowVolume();
 
+        /** Compresses the vertex data of this mesh with quantised attribute types.
+        @remarks
+            Converts the shared and dedicated vertex data to
+            VertexDeclaration::getQuantisedDeclaration, roughly halving its size.
+            The decode matrix of the positions is applied through the world transforms
+            of the entities, which works with shader based rendering only. Normals and
+            tangents need to be decoded in the vertex shader, see the octahedral option
+            of the RTSS FFPTransform.
+        @par
+            Vertex data targeted by morph or pose animation is left alone. Anything that
+            reads positions on the CPU should run before this: tangent generation, LOD
+            generation, meshlets and extremes. Edge lists are built first if needed.
+        @param compactDirections Whether directions use 8 rather than 16 bits per component
+        */
+        void quantiseVertexData(bool compactDirections = false);
+
         /** Return the edge list for this mesh, building it if required. 
         @remarks
             You must ensure that the Mesh as been prepared for shadow volume 
@@ -794,7 +811,9 @@ class VertexData;
             VertexData class containing target position
             and normal buffers which will be updated with the blended versions.
             Note that the layout of the source and target position / normal 
-            buffers must be identical, ie they must use the same buffer indexes
+            buffers must be identical, ie they must use the same buffer indexes.
+            Quantised positions are decoded, blended and encoded again, in which
+            case the positionDecodeMatrix of the target is refitted to the result.
         @param blendMatrices
             Pointer to an array of matrix pointers to be used to blend,
             indexed by blend indices in the sourceVertexData
@@ -805,7 +824,7 @@ class VertexData;
             If @c true, normals are blended as well as positions.
         */
         static void softwareVertexBlend(const VertexData* sourceVertexData, 
-            const VertexData* targetVertexData,
+            VertexData* targetVertexData,
             const Affine3* const* blendMatrices, size_t numMatrices,
             bool blendNormals);
 
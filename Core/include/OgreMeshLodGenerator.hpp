@@ -0,0 +1,150 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstddef>
+
+export module Ogre.Core:MeshLodGenerator;
+
+export import :Prerequisites;
+
+export import <string_view>;
+export import <vector>;
+
+export
+namespace Ogre
+{
+class LodStrategy;
+class Mesh;
+
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup LOD
+    *  @{
+    */
+    /** Generates reduced LOD levels for a Mesh by quadric edge collapse.
+    @remarks
+        Every SubMesh made of an indexed triangle list receives one reduced IndexData
+        per requested level. Collapses always move a vertex onto one of its neighbours,
+        so the vertex data is shared by all levels and only index buffers are added.
+        The cost of a collapse is the quadric error of the removed position plus the
+        change in normal and texture coordinate it causes. Vertices which share a
+        position but not their attributes (UV or normal seams) are always collapsed
+        together so seams stay closed, and open borders only collapse along themselves.
+    @par
+        SubMeshes are simplified in parallel. The result can be written with
+        MeshSerializer, so the levels are simply loaded rather than generated at runtime.
+    */
+    class MeshLodGenerator
+    {
+    public:
+        /// A single generated LOD level
+        struct LodLevel
+        {
+            /// The LOD value in user units (e.g. a distance), see LodStrategy::transformUserValue
+            Real userValue{0};
+            /// Proportion of the full detail triangles to remove, in the range [0, 1)
+            Real reductionRatio{0};
+        };
+        using LodLevelList = std::vector<LodLevel>;
+
+        MeshLodGenerator();
+
+        /** Sets the strategy the LOD values are expressed in.
+        @remarks
+            Defaults to the default strategy of the LodStrategyManager.
+        */
+        void setLodStrategy(LodStrategy* strategy) { mStrategy = strategy; }
+        [[nodiscard]] auto getLodStrategy() const noexcept -> LodStrategy* { return mStrategy; }
+
+        /** Adds a level to generate.
+        @param userValue The LOD value in the units of the LOD strategy.
+        @param reductionRatio Proportion of triangles to remove, e.g. 0.5 to halve the
+            triangle count of every SubMesh.
+        */
+        void addLodLevel(Real userValue, Real reductionRatio);
+        /// Removes all levels added with addLodLevel
+        void clearLodLevels() { mLevels.clear(); }
+        [[nodiscard]] auto getLodLevels() const noexcept -> const LodLevelList& { return mLevels; }
+
+        /** Sets the weight of normal deviation relative to the geometric error.
+        @remarks
+            0 ignores normals, larger values preserve shading discontinuities longer.
+        */
+        void setNormalWeight(Real weight) { mNormalWeight = weight; }
+        [[nodiscard]] auto getNormalWeight() const noexcept -> Real { return mNormalWeight; }
+
+        /** Sets the weight of texture coordinate stretch relative to the geometric error.
+        @remarks
+            Only the first texture coordinate set is considered.
+        */
+        void setUVWeight(Real weight) { mUVWeight = weight; }
+        [[nodiscard]] auto getUVWeight() const noexcept -> Real { return mUVWeight; }
+
+        /** Sets whether vertices on open borders may collapse at all.
+        @remarks
+            When false (the default), border vertices may slide along the border.
+            Enable this for meshes which have to match up with neighbouring geometry.
+        */
+        void setLockBorders(bool lock) { mLockBorders = lock; }
+        [[nodiscard]] auto getLockBorders() const noexcept -> bool { return mLockBorders; }
+
+        /** Sets the number of SubMeshes simplified at the same time.
+        @remarks
+            The work runs on the task pool shared with resource loading. 0 (the default)
+            uses all of its threads, 1 simplifies on the calling thread only.
+        */
+        void setNumThreads(size_t count) { mNumThreads = count; }
+        [[nodiscard]] auto getNumThreads() const noexcept -> size_t { return mNumThreads; }
+
+        /** Replaces the LOD levels of the mesh with generated ones.
+        @remarks
+            Existing LOD levels, manual or generated, are removed. Edge lists are
+            rebuilt if they had been built before.
+        */
+        void generate(Mesh* mesh);
+
+        /** Generates the LOD levels and exports the mesh with MeshSerializer.
+        @param mesh The mesh to reduce.
+        @param filename The .mesh file to write.
+        */
+        void generateAndExport(Mesh* mesh, std::string_view filename);
+
+    private:
+        LodStrategy* mStrategy{nullptr};
+        LodLevelList mLevels;
+        Real mNormalWeight{1};
+        Real mUVWeight{1};
+        bool mLockBorders{false};
+        size_t mNumThreads{0};
+    };
+    /** @} */
+    /** @} */
+
+} // namespace Ogre
@@ -376,6 +376,13 @@ class SubMesh;
         /** Retrieves whether all Meshes should prepare themselves for shadow volumes. */
         auto getPrepareAllMeshesForShadowVolumes() noexcept -> bool;
 
+        /** Tells the mesh manager to decode .mesh files on multiple threads when loading.
+        @see MeshSerializer::setParallelImport
+        */
+        void setParallelImport(bool enable) noexcept { mParallelImport = enable; }
+        /** Retrieves whether .mesh files are decoded on multiple threads. */
+        [[nodiscard]] auto getParallelImport() const noexcept -> bool { return mParallelImport; }
+
         /// @copydoc Singleton::getSingleton()
         static auto getSingleton() noexcept -> MeshManager&;
         /// @copydoc Singleton::getSingleton()
@@ -477,6 +484,7 @@ class SubMesh;
         VertexElementType mBlendWeightsBaseElementType;
 
         bool mPrepAllMeshesForShadowVolumes;
+        bool mParallelImport{false};
     
         //the factor by which the bounding box of an entity is padded   
         Real mBoundsPaddingFactor{0.01};
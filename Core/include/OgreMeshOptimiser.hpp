@@ -0,0 +1,188 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstddef>
+
+export module Ogre.Core:MeshOptimiser;
+
+export import :MeshSerializer;
+export import :Platform;
+export import :Prerequisites;
+
+export import <string_view>;
+export import <utility>;
+export import <vector>;
+
+export
+namespace Ogre
+{
+class Mesh;
+
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Resources
+    *  @{
+    */
+    /** The passes MeshOptimiser may run, in the order they are applied. */
+    enum class MeshOptimiserPass : uint32
+    {
+        NONE = 0x0,
+        /// Merge vertices whose data (including bone assignments) is identical
+        WELD_VERTICES = 0x1,
+        /// Reorder triangles for the post-transform vertex cache
+        VERTEX_CACHE = 0x2,
+        /// Reorder clusters of triangles so outward facing ones are drawn first
+        OVERDRAW = 0x4,
+        /// Reorder vertices into the order the index buffers first use them
+        VERTEX_FETCH = 0x8,
+        ALL = 0xF
+    };
+
+    auto constexpr operator not (MeshOptimiserPass mask) -> bool
+    {
+        return not std::to_underlying(mask);
+    }
+
+    auto constexpr operator bitor(MeshOptimiserPass left, MeshOptimiserPass right) -> MeshOptimiserPass
+    {
+        return
+        static_cast<MeshOptimiserPass>
+        (   std::to_underlying(left)
+        bitor
+            std::to_underlying(right)
+        );
+    }
+
+    auto constexpr operator bitand(MeshOptimiserPass left, MeshOptimiserPass right) -> MeshOptimiserPass
+    {
+        return
+        static_cast<MeshOptimiserPass>
+        (   std::to_underlying(left)
+        bitand
+            std::to_underlying(right)
+        );
+    }
+
+    /** Optimises the vertex and index buffers of a Mesh for rendering.
+    @remarks
+        This supersedes IndexData::optimiseVertexCacheTriList: triangles are ordered
+        with a scoring based cache optimiser, then grouped into clusters which are
+        sorted to reduce overdraw, and finally vertices are welded and stored in
+        the order they are fetched. All index data of the mesh, including LOD levels,
+        is kept consistent, as are bone assignments.
+    @par
+        Vertex data which is targeted by poses or morph animation, uses a non-zero
+        vertexStart or is drawn without indices only gets the triangle passes.
+    @par
+        To optimise every mesh as it is imported, register the optimiser with
+        MeshManager::setListener. optimiseAndExport runs the passes before
+        writing a .mesh file instead.
+    */
+    class MeshOptimiser : public MeshSerializerListener
+    {
+    public:
+        /// Rendering efficiency of the triangle lists of a mesh
+        struct Statistics
+        {
+            size_t vertexCount{0};
+            size_t triangleCount{0};
+            /// Average post-transform cache misses per triangle (0.5 is ideal for grids, 3 the worst)
+            Real acmr{0};
+            /// Average post-transform cache misses per vertex (1 is ideal)
+            Real atvr{0};
+            /// Bytes read from vertex buffers divided by their size (1 is ideal)
+            Real overfetch{0};
+        };
+
+        /// Statistics of the whole mesh before and after a pass
+        struct PassReport
+        {
+            MeshOptimiserPass pass;
+            Statistics before;
+            Statistics after;
+        };
+        using PassReportList = std::vector<PassReport>;
+
+        MeshOptimiser(MeshOptimiserPass passes = MeshOptimiserPass::ALL);
+
+        /// Sets the passes to run
+        void setPasses(MeshOptimiserPass passes) { mPasses = passes; }
+        [[nodiscard]] auto getPasses() const noexcept -> MeshOptimiserPass { return mPasses; }
+
+        /** Sets the FIFO cache size used to measure ACMR and to split overdraw clusters.
+        @remarks
+            Defaults to 16, the size VertexCacheProfiler uses.
+        */
+        void setCacheSize(size_t size) { mCacheSize = size; }
+        [[nodiscard]] auto getCacheSize() const noexcept -> size_t { return mCacheSize; }
+
+        /** Sets how much ACMR the overdraw pass may give up, e.g. 1.05 for 5%.
+        @remarks
+            Higher values create smaller clusters, which can be sorted better.
+        */
+        void setOverdrawThreshold(Real threshold) { mOverdrawThreshold = threshold; }
+        [[nodiscard]] auto getOverdrawThreshold() const noexcept -> Real { return mOverdrawThreshold; }
+
+        /// Sets whether each pass logs its statistics (default true)
+        void setLogStatistics(bool log) { mLogStatistics = log; }
+        [[nodiscard]] auto getLogStatistics() const noexcept -> bool { return mLogStatistics; }
+
+        /** Runs the enabled passes on the mesh.
+        @return One report for each pass that was run.
+        */
+        auto optimise(Mesh* mesh) -> PassReportList;
+
+        /** Optimises the mesh and exports it with MeshSerializer.
+        @param mesh The mesh to optimise.
+        @param filename The .mesh file to write.
+        */
+        auto optimiseAndExport(Mesh* mesh, std::string_view filename) -> PassReportList;
+
+        /** Measures the triangle lists of a mesh.
+        @param mesh The mesh to measure.
+        @param cacheSize Size of the simulated FIFO post-transform cache.
+        */
+        static auto analyse(const Mesh* mesh, size_t cacheSize = 16) -> Statistics;
+
+        void processMaterialName(Mesh* mesh, String* name) override {}
+        void processSkeletonName(Mesh* mesh, String* name) override {}
+        /// Optimises each mesh as soon as it is imported
+        void processMeshCompleted(Mesh* mesh) override;
+
+    private:
+        MeshOptimiserPass mPasses;
+        size_t mCacheSize{16};
+        Real mOverdrawThreshold{1.05};
+        bool mLogStatistics{true};
+    };
+    /** @} */
+    /** @} */
+
+} // namespace Ogre
@@ -46,6 +46,9 @@ namespace Ogre {
     {
         /// Latest version available
         LATEST,
+        /** Latest version, laid out to be loaded in place from a memory mapped file
+            (see MeshSerializerImpl_Mappable) */
+        MAPPABLE,
         
         /// OGRE version v1.10+
         _1_10,
@@ -175,6 +178,12 @@ namespace Ogre {
         void setListener(MeshSerializerListener *listener);
         /// Returns the current listener
         auto getListener() -> MeshSerializerListener *;
+
+        /** Decode independent chunks of the mesh on worker threads when importing.
+        @see MeshSerializerImpl::setParallelImport
+        */
+        void setParallelImport(bool enable) noexcept { mParallelImport = enable; }
+        [[nodiscard]] auto getParallelImport() const noexcept -> bool { return mParallelImport; }
         
     private:
         using MeshVersionDataList = std::vector<::std::unique_ptr<MeshVersionData>>;
@@ -182,6 +191,8 @@ namespace Ogre {
 
         MeshSerializerListener *mListener{nullptr};
 
+        bool mParallelImport{false};
+
     };
 
     /** 
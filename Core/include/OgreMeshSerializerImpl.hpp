@@ -32,18 +32,25 @@ module;
 export module Ogre.Core:MeshSerializerImpl;
 
 export import :EdgeListBuilder;
+export import :HardwareIndexBuffer;
 export import :HardwareVertexBuffer;
 export import :KeyFrame;
 export import :Prerequisites;
 export import :Serializer;
 export import :VertexBoneAssignment;
 
+export import <map>;
+export import <memory>;
+export import <utility>;
+export import <vector>;
+
 export
 namespace Ogre {
     
     class MeshSerializerListener;
     struct MeshLodUsage;
 class Animation;
+class HardwareBuffer;
 class Mesh;
 class Pose;
 class SubMesh;
@@ -92,6 +99,17 @@ class VertexData;
         */
         void importMesh(const DataStreamPtr& stream, Mesh* pDest, MeshSerializerListener *listener);
 
+        /** Decode the chunks of a mesh concurrently when importing.
+        @remarks
+            The chunk directory is read first; geometry, submeshes, LOD levels, edge lists
+            and poses are then decoded on worker threads into staged system memory, and
+            assembled into the Mesh on the calling thread in file order. The result is the
+            same as with a sequential import. Relies on the chunk lengths in the file being
+            correct. Only supported by the latest format; older ones are always read sequentially.
+        */
+        void setParallelImport(bool enable) noexcept { mParallelImport = enable; }
+        [[nodiscard]] auto getParallelImport() const noexcept -> bool { return mParallelImport; }
+
     protected:
 
         // Internal methods
@@ -101,6 +119,7 @@ class VertexData;
         virtual void writeSubMeshOperation(const SubMesh* s);
         virtual void writeSubMeshTextureAliases(const SubMesh* s);
         virtual void writeGeometry(const VertexData* pGeom);
+        virtual void writeGeometryPositionDecode(const VertexData* pGeom);
         virtual void writeSkeletonLink(std::string_view skelName);
         virtual void writeMeshBoneAssignment(const VertexBoneAssignment& assign);
         virtual void writeSubMeshBoneAssignment(const VertexBoneAssignment& assign);
@@ -122,10 +141,13 @@ class VertexData;
         virtual void writePoseKeyframePoseRef(const VertexPoseKeyFrame::PoseRef& poseRef);
         virtual void writeExtremes(const Mesh *pMesh);
         virtual void writeSubMeshExtremes(unsigned short idx, const SubMesh* s);
+        virtual void writeMeshlets(const Mesh *pMesh);
+        virtual void writeSubMeshMeshlets(unsigned short idx, const SubMesh* s);
 
         virtual auto calcMeshSize(const Mesh* pMesh) -> size_t;
         virtual auto calcSubMeshSize(const SubMesh* pSub) -> size_t;
         virtual auto calcGeometrySize(const VertexData* pGeom) -> size_t;
+        virtual auto calcGeometryPositionDecodeSize(const VertexData* pGeom) -> size_t;
         virtual auto calcSkeletonLinkSize(std::string_view skelName) -> size_t;
         virtual auto calcBoneAssignmentSize() -> size_t;
         virtual auto calcSubMeshOperationSize(const SubMesh* pSub) -> size_t;
@@ -150,17 +172,23 @@ class VertexData;
         virtual auto calcBoundsInfoSize(const Mesh* pMesh) -> size_t;
         virtual auto calcExtremesSize(const Mesh* pMesh) -> size_t;
         virtual auto calcSubMeshExtremesSize(unsigned short idx, const SubMesh* s) -> size_t;
+        virtual auto calcMeshletsSize(const Mesh* pMesh) -> size_t;
+        virtual auto calcSubMeshMeshletsSize(const SubMesh* s) -> size_t;
 
         virtual void readTextureLayer(const DataStreamPtr& stream, Mesh* pMesh, MaterialPtr& pMat);
         virtual void readSubMeshNameTable(const DataStreamPtr& stream, Mesh* pMesh);
         virtual void readMesh(const DataStreamPtr& stream, Mesh* pMesh, MeshSerializerListener *listener);
         virtual void readSubMesh(const DataStreamPtr& stream, Mesh* pMesh, MeshSerializerListener *listener);
+        /// Everything of a SUBMESH chunk after the material name
+        void readSubMeshData(const DataStreamPtr& stream, Mesh* pMesh, SubMesh* sm);
+        void setSubMeshMaterial(Mesh* pMesh, SubMesh* sm, String materialName, MeshSerializerListener *listener);
         virtual void readSubMeshOperation(const DataStreamPtr& stream, Mesh* pMesh, SubMesh* sub);
         virtual void readSubMeshTextureAlias(const DataStreamPtr& stream, Mesh* pMesh, SubMesh* sub);
         virtual void readGeometry(const DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
         virtual void readGeometryVertexDeclaration(const DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
         virtual void readGeometryVertexElement(const DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
         virtual void readGeometryVertexBuffer(const DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
+        virtual void readGeometryPositionDecode(const DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
 
         virtual void readSkeletonLink(const DataStreamPtr& stream, Mesh* pMesh, MeshSerializerListener *listener);
         virtual void readMeshBoneAssignment(const DataStreamPtr& stream, Mesh* pMesh);
@@ -173,6 +201,9 @@ class VertexData;
 
         virtual void readBoundsInfo(const DataStreamPtr& stream, Mesh* pMesh);
         virtual void readEdgeList(const DataStreamPtr& stream, Mesh* pMesh);
+        /// Read the edge lists of an EDGE_LISTS chunk without attaching them to the mesh
+        auto readEdgeListLods(const DataStreamPtr& stream) -> std::vector<std::pair<unsigned short, EdgeData*>>;
+        void attachEdgeList(Mesh* pMesh, unsigned short lodIndex, EdgeData* edgeData);
         virtual void readEdgeListLodInfo(const DataStreamPtr& stream, EdgeData* edgeData);
         virtual void readPoses(const DataStreamPtr& stream, Mesh* pMesh);
         virtual void readPose(const DataStreamPtr& stream, Mesh* pMesh);
@@ -183,6 +214,45 @@ class VertexData;
         virtual void readMorphKeyFrame(const DataStreamPtr& stream, Mesh* pMesh, VertexAnimationTrack* track);
         virtual void readPoseKeyFrame(const DataStreamPtr& stream, VertexAnimationTrack* track);
         virtual void readExtremes(const DataStreamPtr& stream, Mesh *pMesh);
+        virtual void readMeshlets(const DataStreamPtr& stream, Mesh *pMesh);
+
+        /// Whether a chunk with this id belongs to the MESH chunk
+        static auto isMeshSubChunk(uint16 streamID) -> bool;
+        void readMeshSubChunk(const DataStreamPtr& stream, Mesh* pMesh, uint16 streamID,
+            MeshSerializerListener *listener);
+        /// Parallel variant of reading the contents of the MESH chunk, see setParallelImport
+        void readMeshParallel(const DataStreamPtr& stream, Mesh* pMesh, MeshSerializerListener *listener);
+        /// A serializer of the same format to decode chunks on a worker thread, nullptr if not supported
+        virtual auto createImportWorker() const -> std::unique_ptr<MeshSerializerImpl>;
+
+        /// Create a buffer for the mesh being read, or a staged one on import workers
+        auto createVertexBuffer(Mesh* pMesh, size_t vertexSize, size_t numVertices) -> HardwareVertexBufferSharedPtr;
+        auto createIndexBuffer(Mesh* pMesh, HardwareIndexBuffer::IndexType type, size_t numIndexes)
+            -> HardwareIndexBufferSharedPtr;
+        /// Replace staged buffers by buffers of the mesh's manager, taking over their memory
+        void realiseBuffers(Mesh* pMesh, VertexData* vertexData);
+        auto realiseBuffer(Mesh* pMesh, const HardwareVertexBufferSharedPtr& staged) -> HardwareVertexBufferSharedPtr;
+        auto realiseBuffer(Mesh* pMesh, const HardwareIndexBufferSharedPtr& staged) -> HardwareIndexBufferSharedPtr;
+        void adoptStagedData(HardwareBuffer* buf, const ::std::shared_ptr<HardwareBuffer>& staged);
+        /// Log a warning, on import workers keep it for the importing thread instead
+        void logReadWarning(std::string_view message);
+
+        /// Write the contents of a vertex buffer (vertexCount vertices)
+        virtual void writeVertexBufferData(const VertexData* vertexData, unsigned short bindIndex,
+            const HardwareVertexBufferSharedPtr& vbuf);
+        /// Size of what writeVertexBufferData writes
+        virtual auto calcVertexBufferDataSize(const VertexData* vertexData,
+            const HardwareVertexBufferSharedPtr& vbuf) -> size_t;
+        /// Create and fill the vertex buffer for @p bindIndex
+        virtual auto readVertexBufferData(const DataStreamPtr& stream, Mesh* pMesh, VertexData* dest,
+            unsigned short bindIndex, unsigned short vertexSize) -> HardwareVertexBufferSharedPtr;
+        /// Write the first @p count indices of an index buffer
+        virtual void writeIndexBufferData(const HardwareIndexBufferSharedPtr& ibuf, size_t count);
+        /// Size of what writeIndexBufferData writes
+        virtual auto calcIndexBufferDataSize(bool idx32bit, size_t count) -> size_t;
+        /// Create and fill an index buffer of @p count indices
+        virtual auto readIndexBufferData(const DataStreamPtr& stream, Mesh* pMesh,
+            HardwareIndexBuffer::IndexType type, size_t count) -> HardwareIndexBufferSharedPtr;
 
 
         /// Flip an entire vertex buffer from little endian
@@ -197,6 +267,55 @@ class VertexData;
         virtual void enableValidation();
 
         ushort exportedLodCount; // Needed to limit exported Edge data, when exporting
+
+        bool mParallelImport{false};
+        /// Set on import workers, which must not use the buffer managers or the log
+        bool mStageBuffers{false};
+        /// Warnings raised on an import worker, logged in file order after the import
+        std::vector<String> mDeferredWarnings;
+    };
+
+    /** Variant of the latest .mesh format that can be loaded in place from a memory mapped file.
+    @remarks
+        All vertex and index buffer payloads are stored in a BUFFER_DATA chunk ahead of
+        the mesh, each at a 64 byte aligned file offset; the mesh chunks reference them by
+        offset. When the file is opened through a memory mapped stream (see
+        FileSystemArchiveFactory::setMapFiles) on a host matching its endianness, system memory
+        and shadow buffers use the mapped pages directly and GPU buffers are uploaded
+        straight from them, without an intermediate copy.
+    */
+    class MeshSerializerImpl_Mappable : public MeshSerializerImpl
+    {
+    public:
+        MeshSerializerImpl_Mappable();
+        ~MeshSerializerImpl_Mappable() override;
+    protected:
+        static const size_t BUFFER_ALIGNMENT = 64;
+
+        auto createImportWorker() const -> std::unique_ptr<MeshSerializerImpl> override
+        { return std::make_unique<MeshSerializerImpl_Mappable>(); }
+
+        void writeMesh(const Mesh* pMesh) override;
+        void writeVertexBufferData(const VertexData* vertexData, unsigned short bindIndex,
+            const HardwareVertexBufferSharedPtr& vbuf) override;
+        auto calcVertexBufferDataSize(const VertexData* vertexData,
+            const HardwareVertexBufferSharedPtr& vbuf) -> size_t override;
+        auto readVertexBufferData(const DataStreamPtr& stream, Mesh* pMesh, VertexData* dest,
+            unsigned short bindIndex, unsigned short vertexSize) -> HardwareVertexBufferSharedPtr override;
+        void writeIndexBufferData(const HardwareIndexBufferSharedPtr& ibuf, size_t count) override;
+        auto calcIndexBufferDataSize(bool idx32bit, size_t count) -> size_t override;
+        auto readIndexBufferData(const DataStreamPtr& stream, Mesh* pMesh,
+            HardwareIndexBuffer::IndexType type, size_t count) -> HardwareIndexBufferSharedPtr override;
+
+        /// Write the BUFFER_DATA chunk and record where each payload went
+        void writeBufferData(const Mesh* pMesh);
+        /// Offset of a payload written by writeBufferData
+        auto getBufferOffset(const HardwareBuffer* buf, size_t size) const -> uint32;
+        /// Fill @p buf with @p size bytes at @p offset, sharing the memory with the stream if possible
+        void readBufferData(const DataStreamPtr& stream, HardwareBuffer* buf, uint32 offset, size_t size);
+
+        /// Payload offsets keyed by buffer and payload size
+        std::map<std::pair<const HardwareBuffer*, size_t>, uint32> mBufferOffsets;
     };
 
 
@@ -222,6 +341,14 @@ class VertexData;
         void writeLodUsageGenerated(const Mesh* pMesh, const MeshLodUsage& usage, unsigned short lodNum) override;
         void writeLodUsageGeneratedSubmesh(const SubMesh* submesh, unsigned short lodNum) override;
         void writeLodUsageManual(const MeshLodUsage& usage) override;
+        // Legacy formats are always read sequentially
+        auto createImportWorker() const -> std::unique_ptr<MeshSerializerImpl> override { return nullptr; }
+        // Meshlets and quantised positions didn't exist yet
+        void writeMeshlets(const Mesh* pMesh) override {}
+        auto calcMeshletsSize(const Mesh* pMesh) -> size_t override { return 0; }
+        /// Throws for quantised positions, which can't be decoded without the matrix
+        void writeGeometryPositionDecode(const VertexData* pGeom) override;
+        auto calcGeometryPositionDecodeSize(const VertexData* pGeom) -> size_t override;
 
         void readMeshLodUsageGenerated(const DataStreamPtr& stream, Mesh* pMesh,
             unsigned short lodNum, MeshLodUsage& usage) override;
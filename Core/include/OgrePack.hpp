@@ -0,0 +1,157 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstddef>
+#include <cstdio>
+
+export module Ogre.Core:Pack;
+
+export import :ArchiveFactory;
+export import :DataStream;
+export import :Platform;
+export import :Prerequisites;
+
+export import <string>;
+export import <vector>;
+
+export
+namespace Ogre {
+class Archive;
+
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Resources
+    *  @{
+    */
+
+    /** Specialisation to allow reading of files from an OgrePack archive.
+
+        OgrePack is a read-only archive format meant for shipping builds. The whole file is
+        memory mapped on load and nothing is copied out of it up front: the directory is sorted
+        by name hash so a lookup is a binary search, and the data of every entry starts on a
+        4 KiB boundary so stored entries are opened as zero-copy views into the mapping.
+        Entries may be deflate, LZ4 or Zstandard compressed, and each carries a hash of its content.
+
+        Packs are written with PackWriter, or with the OgrePacker command-line tool.
+    */
+    class PackArchiveFactory : public ArchiveFactory
+    {
+    public:
+        ~PackArchiveFactory() override = default;
+        /// @copydoc FactoryObj::getType
+        [[nodiscard]] auto getType() const noexcept -> std::string_view override;
+
+        using ArchiveFactory::createInstance;
+
+        auto createInstance( std::string_view name, bool readOnly ) -> Archive * override;
+
+        /** Set whether entries of archives created by this factory are checked against their content hash.
+        @remarks
+            A mismatch throws from Archive::open. Checking means hashing every byte read,
+            so the default is false. Archives keep the setting they were created with.
+        */
+        void setVerifyContent(bool verify) noexcept { mVerifyContent = verify; }
+
+        /// Get whether entries of archives created by this factory are checked against their content hash.
+        [[nodiscard]] auto getVerifyContent() const noexcept -> bool { return mVerifyContent; }
+
+    private:
+        bool mVerifyContent{false};
+    };
+
+    /// Compression of a single OgrePack entry
+    enum class PackCompression : uint32
+    {
+        /// Stored as is, and opened without copying
+        NONE = 0,
+        /// Raw deflate stream
+        DEFLATE = 1,
+        /// LZ4 block, faster to decompress than deflate at a lower ratio
+        LZ4 = 2,
+        /// Zstandard frame, a better ratio than LZ4 and still faster to decompress than deflate
+        ZSTD = 3
+    };
+
+    /** Writes OgrePack archives, see PackArchiveFactory.
+    @remarks
+        Each added file is compressed and spooled to a temporary file right away, so only
+        the file being added is held in memory. write() copies the spooled data into the pack.
+    */
+    class PackWriter
+    {
+    public:
+        PackWriter() = default;
+        ~PackWriter();
+        PackWriter(const PackWriter&) = delete;
+        auto operator=(const PackWriter&) -> PackWriter& = delete;
+
+        /** Add a file to the pack.
+        @param name
+            The name inside the pack, with '/' separated directories.
+        @param stream
+            The contents, read immediately.
+        @param compression
+            How to store the file. Files which do not get smaller when compressed are stored as is.
+        */
+        void addFile(std::string_view name, const DataStreamPtr& stream, PackCompression compression = PackCompression::NONE);
+
+        /** Add all files of a loaded archive, keeping their names relative to the archive root. */
+        void addArchive(Archive* archive, PackCompression compression = PackCompression::NONE);
+
+        /** Write the pack to a file.
+        @remarks
+            Throws if the file cannot be written or a name was added twice.
+        */
+        void write(std::string_view path);
+
+        /// Number of files added so far
+        [[nodiscard]] auto getNumFiles() const noexcept -> size_t { return mFiles.size(); }
+
+    private:
+        struct PendingFile
+        {
+            String name;
+            /// Where the stored bytes are in the spool file
+            uint64 spoolOffset;
+            uint64 storedSize;
+            PackCompression compression;
+            size_t size;
+            uint64 contentHash[2];
+        };
+        std::vector<PendingFile> mFiles;
+        /// Stored bytes of all added files, removed when closed
+        std::FILE* mSpool{nullptr};
+        uint64 mSpoolSize{0};
+    };
+
+    /** @} */
+    /** @} */
+
+}
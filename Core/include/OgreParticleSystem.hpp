@@ -51,6 +51,7 @@ export import <vector>;
 export
 namespace Ogre {
     class Camera;
+    class LodStrategy;
     class Node;
     class Particle;
     class ParticleAffector;
@@ -399,6 +400,54 @@ namespace Ogre {
         */
         static auto getDefaultNonVisibleUpdateTimeout() noexcept -> Real { return msDefaultNonvisibleTimeout; }
 
+        /** Enables level of detail for this particle system.
+        @remarks
+            When enabled, the system is evaluated against every camera it is
+            rendered by, and the smaller it appears, the fewer particles it uses:
+            the emission rate and the particle quota are scaled down by the
+            detail factor, and the simulation is stepped at a coarser interval
+            (see setLodMaxIterationInterval). The highest detail required by any
+            camera in a frame is used.
+        @param strategy The strategy used to evaluate the system, e.g.
+            ScreenRatioPixelCountLodStrategy or DistanceLodSphereStrategy.
+            nullptr (the default) disables level of detail.
+        */
+        void setLodStrategy(LodStrategy* strategy);
+        /** Gets the LOD strategy of this system, or nullptr if LOD is disabled. */
+        auto getLodStrategy() const noexcept -> LodStrategy* { return mLodStrategy; }
+
+        /** Sets the LOD values between which the detail falls off.
+        @param fullDetailValue The value, in the units of the LOD strategy, at which
+            full detail is used, e.g. a screen ratio of 0.1 or a distance of 100.
+        @param minDetailValue The value at and beyond which the minimum detail is used.
+        */
+        void setLodRange(Real fullDetailValue, Real minDetailValue);
+        /** Gets the value at which full detail is used. */
+        auto getLodFullDetailValue() const noexcept -> Real { return mLodFullDetailValue; }
+        /** Gets the value at and beyond which the minimum detail is used. */
+        auto getLodMinDetailValue() const noexcept -> Real { return mLodMinDetailValue; }
+
+        /** Sets the lowest detail factor, between 0 and 1, the system is reduced to. */
+        void setLodMinDetail(Real minDetail) { mLodMinDetail = minDetail; }
+        /** Gets the lowest detail factor the system is reduced to. */
+        auto getLodMinDetail() const noexcept -> Real { return mLodMinDetail; }
+
+        /** Sets the update interval used at the minimum detail.
+        @remarks
+            Between full and minimum detail the interval is interpolated from the
+            regular iteration interval towards this one. 0 (the default) keeps the
+            regular interval at all detail levels.
+        */
+        void setLodMaxIterationInterval(Real interval) { mLodMaxIterationInterval = interval; }
+        /** Gets the update interval used at the minimum detail. */
+        auto getLodMaxIterationInterval() const noexcept -> Real { return mLodMaxIterationInterval; }
+
+        /** Gets the current detail factor, 1 for full detail. */
+        auto getLodDetail() const noexcept -> Real { return mLodDetail; }
+
+        /** Internal method returning the particle quota permitted by the current detail. */
+        auto _getLodQuota() const -> size_t;
+
         auto getMovableType() const noexcept -> std::string_view override;
 
         /** Sets the default dimensions of the particles in this set.
@@ -592,6 +641,22 @@ namespace Ogre {
         bool mEmittedEmitterPoolInitialised;
         /// Used to control if the particle system should emit particles or not.
         bool mIsEmitting;
+        /// Strategy used to compute the detail, nullptr if LOD is disabled
+        LodStrategy* mLodStrategy{nullptr};
+        /// LOD value at which full detail is used, as set by the user
+        Real mLodFullDetailValue{0};
+        /// LOD value at which minimum detail is used, as set by the user
+        Real mLodMinDetailValue{0};
+        /// Lowest detail factor
+        Real mLodMinDetail{0.1f};
+        /// Iteration interval at minimum detail
+        Real mLodMaxIterationInterval{0};
+        /// Current detail factor
+        Real mLodDetail{1};
+        /// Frame for which mLodDetail was computed
+        unsigned long mLodFrame{0};
+        /// Fractional emissions carried over while the emission rate is scaled down
+        std::vector<Real> mLodEmissionRemainder;
 
         using ParticlePool = std::vector<Particle *>;
 
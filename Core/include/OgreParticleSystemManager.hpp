@@ -43,6 +43,7 @@ export import :StringVector;
 export import <map>;
 export import <memory>;
 export import <string>;
+export import <vector>;
 
 export
 namespace Ogre {
@@ -92,8 +93,8 @@ class ParticleSystemRenderer;
         friend class ParticleSystemFactory;
     public:
         using ParticleTemplateMap = std::map<std::string_view, ParticleSystem *>;
-        using ParticleAffectorFactoryMap = std::map<std::string_view, ParticleAffectorFactory *>;
-        using ParticleEmitterFactoryMap = std::map<std::string_view, ParticleEmitterFactory *>;
+        using ParticleAffectorFactoryMap = std::map<String, ParticleAffectorFactory *, std::less<>>;
+        using ParticleEmitterFactoryMap = std::map<String, ParticleEmitterFactory *, std::less<>>;
         using ParticleSystemRendererFactoryMap = std::map<std::string_view, ParticleSystemRendererFactory *>;
     private:
         /// Templates based on scripts
@@ -113,6 +114,27 @@ class ParticleSystemRenderer;
         // Factory instance
         ::std::unique_ptr<ParticleSystemFactory> mFactory;
 
+        /// A visible system competing for the particle budget
+        struct BudgetRequest
+        {
+            ParticleSystem* system;
+            /// Fraction of the screen covered by the system
+            Real coverage;
+        };
+        /// Maximum number of particles alive across all systems, 0 for unlimited
+        size_t mParticleBudget{0};
+        /// Systems seen in mBudgetRequestFrame
+        std::vector<BudgetRequest> mBudgetRequests;
+        /// Frame the requests are being collected for
+        unsigned long mBudgetRequestFrame{0};
+        /// Particle quota per system, apportioned from the requests of the last frame
+        std::map<const ParticleSystem*, size_t> mBudgetAllowances;
+        /// Budget the visible systems left over, for systems that were not rendered
+        size_t mBudgetLeft{0};
+
+        /// Apportion the budget once all requests of a frame have been collected
+        void apportionParticleBudget(unsigned long frame);
+
         /// Internal implementation of createSystem
         auto createSystemImpl(std::string_view name, size_t quota, 
             std::string_view resourceGroup) -> ParticleSystem*;
@@ -304,6 +326,28 @@ class ParticleSystemRenderer;
         */
         void _destroyRenderer(ParticleSystemRenderer* renderer);
 
+        /** Limit the total number of particles alive across all particle systems.
+        @remarks
+            Each frame the systems that were rendered are ranked by how much of the
+            screen they cover. The budget is then handed out in that order, each system
+            receiving at most the quota its level of detail permits, so the most
+            visible systems keep their particles while small or distant ones stop
+            emitting first. Systems that were not visible share what is left over.
+            A system without particles has no bounds, so it could never become
+            visible; it is always allowed to start with one particle.
+        @param budget Maximum number of particles, 0 (the default) for no limit
+        */
+        void setParticleBudget(size_t budget) { mParticleBudget = budget; }
+        /** Gets the maximum number of particles alive across all particle systems. */
+        [[nodiscard]] auto getParticleBudget() const noexcept -> size_t { return mParticleBudget; }
+
+        /** Internal method to register a system rendered this frame with its screen coverage. */
+        void _notifyParticleSystemVisible(ParticleSystem* psys, Real coverage);
+        /** Internal method to forget a system which is being destroyed. */
+        void _notifyParticleSystemDestroyed(ParticleSystem* psys);
+        /** Internal method returning the number of particles the budget grants a system. */
+        auto _getParticleAllowance(const ParticleSystem* psys) -> size_t;
+
         /** Init method to be called by OGRE system.
         @remarks
             Due to dependencies between various objects certain initialisation tasks cannot be done
@@ -315,6 +359,12 @@ class ParticleSystemRenderer;
         [[nodiscard]] auto getScriptPatterns() const noexcept -> const StringVector& override;
         /// @copydoc ScriptLoader::parseScript
         void parseScript(DataStreamPtr& stream, std::string_view groupName) override;
+        /// @copydoc ScriptLoader::supportsPreparse
+        [[nodiscard]] auto supportsPreparse() const noexcept -> bool override { return true; }
+        /// @copydoc ScriptLoader::preparseScript
+        [[nodiscard]] auto preparseScript(const DataStreamPtr& stream) -> std::any override;
+        /// @copydoc ScriptLoader::translateScript
+        void translateScript(std::any& preparsed, DataStreamPtr& stream, std::string_view groupName) override;
         /// @copydoc ScriptLoader::getLoadingOrder
         [[nodiscard]] auto getLoadingOrder() const -> Real override;
 
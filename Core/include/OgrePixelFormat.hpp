@@ -660,6 +660,9 @@ namespace Ogre {
             @param  dst         PixelBox containing the destination pixels, pitches and format
             @remarks The source and destination boxes must have the same
             dimensions. In case the source and destination format match, a plain copy is done.
+            @par
+                Whole levels of BC1-BC7, ETC1/ETC2 and LDR ASTC data are decompressed into
+                any uncompressed destination format. Compressing or recoding is not supported.
         */
         static void bulkPixelConversion(const PixelBox &src, const PixelBox &dst);
 
@@ -76,6 +76,8 @@ namespace Ogre {
             FPU             = 1 << 12,
             PRO             = 1 << 13,
             HTT             = 1 << 14,
+            SSSE3           = 1 << 15,
+            AVX2            = 1 << 16,
 
             NONE            = 0
         };
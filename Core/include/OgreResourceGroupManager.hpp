@@ -285,6 +285,9 @@ namespace Ogre {
 
         ResourceLoadingListener *mLoadingListener{nullptr};
 
+        /// Whether scripts are preparsed on worker threads
+        bool mParallelScriptParsing{false};
+
         /// Resource index entry, resourcename->location 
         using ResourceLocationIndex = std::map<std::string, Archive*, std::less<>>;
 
@@ -339,6 +342,9 @@ namespace Ogre {
             Called as part of initialiseResourceGroup
         */
         void parseResourceGroupScripts(ResourceGroup* grp) const;
+        /// parseResourceGroupScripts with the lexing and parsing done on worker threads
+        void parseResourceGroupScriptsParallel(
+            ResourceGroup* grp, const std::vector<std::pair<ScriptLoader*, FileInfoList>>& scriptLoaderFileList) const;
         /** Create all the pre-declared resources.
         @remarks
             Called as part of initialiseResourceGroup
@@ -907,6 +913,19 @@ namespace Ogre {
         /// Returns the current loading listener
         [[nodiscard]] auto getLoadingListener() const -> ResourceLoadingListener *;
 
+        /** Sets whether scripts of a resource group are lexed and parsed on worker threads.
+        @remarks
+            Only applies to ScriptLoader implementations that support preparsing. The
+            translation into resources still happens on the calling thread in the usual
+            order, so the result does not depend on this setting. ResourceGroupListener
+            callbacks are fired in the same order too, but all script streams are opened -
+            and ResourceLoadingListener::resourceStreamOpened is called - before any script
+            is translated, including scripts a listener later chooses to skip.
+        */
+        void setParallelScriptParsing(bool enable) noexcept { mParallelScriptParsing = enable; }
+        /// Returns whether scripts are parsed on worker threads
+        [[nodiscard]] auto getParallelScriptParsing() const noexcept -> bool { return mParallelScriptParsing; }
+
         /// @copydoc Singleton::getSingleton()
         static auto getSingleton() noexcept -> ResourceGroupManager&;
         /// @copydoc Singleton::getSingleton()
@@ -140,6 +140,7 @@ struct SceneManagerMetaData;
         std::unique_ptr<ArchiveFactory> mFileSystemArchiveFactory;
         std::unique_ptr<ArchiveFactory> mEmbeddedZipArchiveFactory;
         std::unique_ptr<ArchiveFactory> mZipArchiveFactory;
+        std::unique_ptr<ArchiveFactory> mPackArchiveFactory;
         std::unique_ptr<ArchiveManager> mArchiveManager;
 
         MovableObjectFactoryMap mMovableObjectFactoryMap;
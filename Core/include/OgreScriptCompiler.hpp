@@ -285,6 +285,14 @@ class Material;
         auto isNameExcluded(const ObjectAbstractNode& node, AbstractNode *parent) -> bool;
         /// This function sets up the initial values in word id map
         void initWordMap();
+    private: // Split compilation, used by ScriptCompilerManager for the compiled script cache
+        friend class ScriptCompilerManager;
+        /// Sets up the compilation context for a new script
+        void beginCompile(std::string_view group);
+        /// Converts the nodes to an AST and processes imports, inheritance and variables
+        auto process(const ConcreteNodeListPtr &nodes) -> AbstractNodeListPtr;
+        /// Translates a processed AST into resources
+        auto translate(const AbstractNodeListPtr &ast) -> bool;
     private:
         friend auto getPropertyName(const ScriptCompiler *compiler, uint32 id) -> std::string_view;
         // Resource group
@@ -307,6 +315,9 @@ class Material;
         // This stores the imports of the scripts, so they are separated and can be treated specially
         AbstractNodeList mImportTable;
 
+        // The scripts loaded by loadImportPath with the hash of their content
+        std::vector<std::pair<String, std::pair<uint64, uint64>>> mImportedScripts;
+
         // Error list
         // The container for errors
         struct Error
@@ -402,6 +413,72 @@ class Material;
 
     class ScriptTranslator;
 
+    /** Persistent store of processed abstract syntax trees.
+
+        Holds the AST of each script after import resolution, inheritance and variable expansion,
+        keyed by the script name and content, so unchanged scripts skip lexing, parsing and
+        processing. The data is stored in native byte order and tied to the engine version.
+    @see ScriptCompilerManager::setCompiledScriptCache
+    */
+    class ScriptCompilerCache
+    {
+    public:
+        using Hash = std::pair<uint64, uint64>;
+        /// A script loaded through an import statement and the hash of its content
+        using Import = std::pair<String, Hash>;
+
+        struct Entry
+        {
+            /// Name of the script
+            String name;
+            /// The imported scripts the AST depends on
+            std::vector<Import> imports;
+            /// The serialised AST
+            std::vector<uchar> data;
+        };
+
+        /// An AST restored from an Entry
+        struct Tree
+        {
+            AbstractNodeListPtr nodes;
+            /// Must be checked against the current content before using nodes
+            std::vector<Import> imports;
+            /// Backs the ObjectAbstractNode::bases views of nodes
+            SharedPtr<std::vector<String>> strings;
+        };
+
+        /// Returns the hash of a script as stored for imports
+        [[nodiscard]] static auto hash(std::string_view content) -> Hash;
+        /// Returns the key of a script, covering both its content and name
+        [[nodiscard]] static auto makeKey(std::string_view content, std::string_view name) -> Hash;
+
+        /// Returns the entry stored for the key or nullptr. May be called from several threads.
+        [[nodiscard]] auto find(const Hash& key) const -> const Entry*;
+        /// Adds an entry, dropping the one of an older version of the same script
+        void insert(const Hash& key, Entry entry);
+        /// Whether entries were added since the last load or save
+        [[nodiscard]] auto isDirty() const noexcept -> bool { return mDirty; }
+
+        /** Reads the entries of a cache file.
+        @return false if the file is missing, damaged or written by a different version
+        */
+        auto load(std::string_view filename) -> bool;
+        /// Writes all entries to a cache file
+        void save(std::string_view filename);
+
+        /// Serialises a processed AST
+        [[nodiscard]] static auto serialise(const AbstractNodeList& nodes) -> std::vector<uchar>;
+        /** Restores the AST of an entry.
+        @param ids The word ids of the compiler, as they are looked up again rather than stored
+        */
+        [[nodiscard]] static auto deserialise(const Entry& entry, const ScriptCompiler::IdMap& ids) -> Tree;
+
+    private:
+        std::map<Hash, Entry> mEntries;
+        std::map<String, Hash, std::less<>> mKeysByName;
+        bool mDirty{false};
+    };
+
     /** Manages threaded compilation of scripts. This script loader forwards
         scripts compilations to a specific compiler instance.
     */
@@ -419,10 +496,30 @@ class Material;
 
         // the specific compiler instance used
         ScriptCompiler mScriptCompiler;
+
+        // the compiled script cache, if enabled
+        ::std::unique_ptr<ScriptCompilerCache> mCache;
+        String mCacheFile;
+        size_t mCacheHits{0};
     public:
         ScriptCompilerManager();
         ~ScriptCompilerManager() override = default;
 
+        /** Enables a persistent cache of compiled scripts.
+        @remarks
+            Scripts whose content, and the content of every script they import, did not change
+            since they were cached are translated from the stored AST without lexing or parsing.
+            Scripts are not cached while a ScriptCompilerListener is set or if they produced
+            errors, as the listener and the error reports would be skipped on the next run.
+        @param filename The cache file, read now if it exists and written by
+            saveCompiledScriptCache. An empty name disables the cache.
+        */
+        void setCompiledScriptCache(std::string_view filename);
+        /// Writes the compiled script cache back to its file if scripts were added to it
+        void saveCompiledScriptCache();
+        /// Number of scripts translated from the compiled script cache since it was enabled
+        [[nodiscard]] auto getCompiledScriptCacheHits() const noexcept -> size_t { return mCacheHits; }
+
         /// Sets the listener used for compiler instances
         void setListener(ScriptCompilerListener *listener);
         /// Returns the currently set listener used for compiler instances
@@ -456,6 +553,12 @@ class Material;
         [[nodiscard]] auto getScriptPatterns() const noexcept -> const StringVector& override;
         /// @copydoc ScriptLoader::parseScript
         void parseScript(DataStreamPtr& stream, std::string_view groupName) override;
+        /// @copydoc ScriptLoader::supportsPreparse
+        [[nodiscard]] auto supportsPreparse() const noexcept -> bool override { return true; }
+        /// @copydoc ScriptLoader::preparseScript
+        [[nodiscard]] auto preparseScript(const DataStreamPtr& stream) -> std::any override;
+        /// @copydoc ScriptLoader::translateScript
+        void translateScript(std::any& preparsed, DataStreamPtr& stream, std::string_view groupName) override;
         /// @copydoc ScriptLoader::getLoadingOrder
         [[nodiscard]] auto getLoadingOrder() const -> Real override;
 
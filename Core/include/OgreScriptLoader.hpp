@@ -31,6 +31,8 @@ export import :DataStream;
 export import :Prerequisites;
 export import :StringVector;
 
+export import <any>;
+
 export
 namespace Ogre {
 
@@ -76,6 +78,30 @@ namespace Ogre {
         */
         virtual void parseScript(DataStreamPtr& stream, std::string_view groupName) = 0;
 
+        /** Whether parseScript can be split into preparseScript and translateScript.
+        @see ResourceGroupManager::setParallelScriptParsing
+        */
+        [[nodiscard]] virtual auto supportsPreparse() const noexcept -> bool { return false; }
+
+        /** The first, thread-safe half of parseScript.
+
+            Reads and parses the script into an intermediate form without touching any shared
+            state, so several scripts may be preparsed concurrently on worker threads.
+        @param stream The source of the script, only used by the calling thread
+        @return The intermediate form to pass to translateScript
+        */
+        [[nodiscard]] virtual auto preparseScript(const DataStreamPtr& stream) -> std::any { return {}; }
+
+        /** The second half of parseScript, creating what the script defines.
+
+            Called on the main thread, in the same order parseScript would have been called.
+        @param preparsed The result of preparseScript for this script
+        @param stream The source of the script, already read by preparseScript
+        @param groupName The name of a resource group which should be used if any resources
+            are created during the translation of this script.
+        */
+        virtual void translateScript(std::any& preparsed, DataStreamPtr& stream, std::string_view groupName) {}
+
         /** Gets the loading order for scripts of this type.
 
             There are dependencies between some kinds of scripts, and this value enumerates that.
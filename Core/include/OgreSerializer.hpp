@@ -31,6 +31,7 @@ module;
 
 export module Ogre.Core:Serializer;
 
+export import :DataStream;
 export import :MemoryAllocatorConfig;
 export import :Platform;
 export import :Prerequisites;
@@ -38,6 +39,7 @@ export import :Quaternion;
 export import :SharedPtr;
 
 export import <string_view>;
+export import <type_traits>;
 
 export
 namespace Ogre {
@@ -94,6 +96,17 @@ namespace Ogre {
         void readObject(const DataStreamPtr& stream, Vector3& pDest);
         void readObject(const DataStreamPtr& stream, Quaternion& pDest);
 
+        /** Reads an array of plain values straight into pDest and converts them to native
+            byte order in place, with one stream read and one bulk swap for the whole array.
+        */
+        template<typename T>
+        void readArray(const DataStreamPtr& stream, T* pDest, size_t count)
+        {
+            static_assert(::std::is_arithmetic_v<T>, "only plain values have a defined byte order");
+            stream->read(pDest, sizeof(T) * count);
+            flipFromLittleEndian(pDest, sizeof(T), count);
+        }
+
         auto readString(const DataStreamPtr& stream) -> String;
         auto readString(const DataStreamPtr& stream, size_t numChars) -> String;
         
@@ -43,11 +43,13 @@ export import :ResourceGroupManager;
 export import :SharedPtr;
 
 export import <memory>;
+export import <vector>;
 
 export
 namespace Ogre {
 class Camera;
 class Entity;
+class IndexData;
 struct Matrix4;
 class RenderOperation;
 class SubMesh;
@@ -137,6 +139,14 @@ class VertexData;
         bool mVertexAnimationAppliedThisFrame;
         /// The camera for which the cached distance is valid
         mutable const Camera *mCachedCamera{nullptr};
+        /// Index data holding the meshlets which survived culling for the current camera
+        std::unique_ptr<IndexData> mCulledIndexData;
+        /// System memory copy of the SubMesh indices the culled index data is gathered from
+        std::vector<uint8> mMeshletSourceIndices;
+        /// SubMesh::_getIndexGeneration() at the time mMeshletSourceIndices was copied
+        uint32 mMeshletSourceGeneration{0};
+        /// Whether mCulledIndexData replaces the SubMesh index data
+        bool mMeshletsCulled{false};
 
         /** Internal method for preparing this Entity for use in animation. */
         void prepareTempBlendBuffers();
@@ -301,6 +311,17 @@ class VertexData;
         /** Invalidate the camera distance cache */
         void _invalidateCameraCache ()
         { mCachedCamera = nullptr; }
+
+        /** Cull the SubMesh meshlets against the given camera.
+        @remarks
+            Called by Entity::_notifyCurrentCamera. The index ranges of the meshlets which are
+            inside the frustum and not facing away from the camera are gathered into a dynamic
+            index buffer, which getRenderOperation then returns in place of the SubMesh indices.
+        */
+        void _cullMeshlets(const Camera* cam);
+
+        /// Returns true if meshlet culling rejected every cluster for the current camera
+        auto _isMeshletCulledAway() const noexcept -> bool;
     };
     /** @} */
     /** @} */
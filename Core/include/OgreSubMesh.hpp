@@ -140,6 +140,37 @@ class VertexData;
          */
         std::vector<Vector3> extremityPoints;
 
+        /** A cluster of triangles occupying a contiguous range of the submesh index data.
+            @remarks
+                Each meshlet carries a bounding sphere and a normal cone in mesh space,
+                which SubEntity uses to skip clusters that are outside the view frustum
+                or that face entirely away from the camera (see buildMeshlets()).
+        */
+        struct Meshlet
+        {
+            /// First index of the cluster, relative to the start of the index buffer
+            uint32 indexStart;
+            /// Number of indices in the cluster (3 per triangle)
+            uint32 indexCount;
+            /// Bounding sphere of the cluster
+            Vector3 center;
+            Real radius;
+            /// Average facing direction of the cluster triangles (unit length)
+            Vector3 coneAxis;
+            /** Sine of the cone half angle, or 1 if the cone is too wide to be useful.
+                The cluster faces away from a viewer at p if
+                dot(center - p, coneAxis) >= coneCutoff * |center - p| + radius.
+            */
+            Real coneCutoff;
+        };
+        using MeshletList = std::vector<Meshlet>;
+
+        /** The meshlets of the main LOD level (optional).
+            @remarks
+                Empty unless generated with buildMeshlets() or loaded from a .mesh file.
+        */
+        MeshletList meshlets;
+
         /// Reference to parent Mesh (not a smart pointer so child does not keep parent alive).
         Mesh* parent{nullptr};
 
@@ -220,6 +251,28 @@ class VertexData;
         */
         void generateExtremes(size_t count);
 
+        /** Partition the submesh triangles into meshlets (@see meshlets).
+        @remarks
+            Triangles are grouped greedily so that neighbouring triangles sharing
+            vertices end up in the same cluster. The index data is reordered in place
+            so that each meshlet occupies a contiguous index range; the triangles
+            themselves are not changed. Only indexed triangle lists are supported.
+        @param maxVertices
+            Maximum number of unique vertices referenced by one meshlet.
+        @param maxTriangles
+            Maximum number of triangles in one meshlet.
+        */
+        void buildMeshlets(size_t maxVertices = 64, size_t maxTriangles = 124);
+
+        /** Tells the SubMesh that the contents of its index buffer or its meshlets changed.
+        @remarks
+            Anything keeping a copy of the indices, like the meshlet culling of SubEntity,
+            compares _getIndexGeneration() to find out whether the copy is stale.
+        */
+        void _notifyIndicesChanged() { ++mIndexGeneration; }
+        /// Counter bumped by _notifyIndicesChanged()
+        [[nodiscard]] auto _getIndexGeneration() const noexcept -> uint32 { return mIndexGeneration; }
+
         /** Returns true(by default) if the submesh should be included in the mesh EdgeList, otherwise returns false.
         */      
         auto isBuildEdgesEnabled() const noexcept -> bool { return mBuildEdgesEnabled; }
@@ -247,6 +300,9 @@ class VertexData;
         /// Is Build Edges Enabled
         bool mBuildEdgesEnabled{true};
 
+        /// Bumped whenever the indices or meshlets are rebuilt
+        uint32 mIndexGeneration{0};
+
         /// the material this SubMesh uses.
         MaterialPtr mMaterial;
 
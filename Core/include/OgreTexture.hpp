@@ -202,6 +202,20 @@ class ResourceManager;
         */
         auto isHardwareGammaEnabled() const noexcept -> bool { return mHwGamma; }
 
+        /** Sets whether missing mipmaps of images loaded from files are generated on the CPU.
+        @remarks
+            When enabled, source images without custom mipmaps get their full chain built
+            with Image::generateMipmaps while the texture is prepared, possibly on a background
+            thread, instead of relying on the render system. The filtering is done in linear
+            space if hardware gamma is enabled. Compressed formats are left alone.
+        @note
+            Must be called before any 'load' method.
+        */
+        void setSoftwareMipmaps(bool enabled) { mSoftwareMipmaps = enabled; }
+
+        /// Gets whether missing mipmaps are generated on the CPU, see setSoftwareMipmaps
+        auto getSoftwareMipmaps() const noexcept -> bool { return mSoftwareMipmaps; }
+
         /** Set the level of multisample AA to be used if this texture is a 
             rendertarget.
         @note This option will be ignored if TextureUsage::RENDERTARGET is not part of the
@@ -467,6 +481,7 @@ class ResourceManager;
         bool mInternalResourcesCreated{false};
         bool mMipmapsHardwareGenerated{false};
         bool mHwGamma{false};
+        bool mSoftwareMipmaps{false};
 
         /// vector of images that should be loaded (cubemap/ texture array)
         std::vector<String> mLayerNames;
@@ -485,7 +500,20 @@ class ResourceManager;
 
         TextureType mTextureType{TextureType::_2D};
 
-        void readImage(LoadedImages& imgs, std::string_view name, std::string_view ext, bool haveNPOT);
+        /// decodes an image, or maps it from the texture cache, and prepares it for upload
+        void readImage(Image& img, DataStreamPtr dstream, std::string_view ext, bool haveNPOT);
+        /// decodes all of mLayerNames concurrently into imgs, in layer order
+        void readLayers(LoadedImages& imgs, bool haveNPOT);
+
+        /// encoded image that loadImpl decodes straight into the texture, see TextureManager::setStreamingThreshold
+        DataStreamPtr mStreamedImage;
+        String mStreamedImageType;
+        /// keeps dstream for loadStreamedImage if the image can be decoded without an intermediate Image
+        auto prepareStreamedImage(DataStreamPtr& dstream, std::string_view ext, bool haveNPOT) -> bool;
+        void loadStreamedImage(const DataStreamPtr& stream);
+
+        /// sets the size and format from the source and creates the texture
+        void setupFromSource(uint32 width, uint32 height, uint32 depth, PixelFormat format, TextureMipmap imageMips);
 
         void prepareImpl() override;
         void unprepareImpl() override;
@@ -0,0 +1,177 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstddef>
+
+export module Ogre.Core:TextureAtlas;
+
+export import :Image;
+export import :Matrix4;
+export import :PixelFormat;
+export import :Platform;
+export import :Prerequisites;
+export import :Texture;
+
+export import <string>;
+export import <utility>;
+export import <vector>;
+
+export
+namespace Ogre {
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Image
+    *  @{
+    */
+
+    /** Describes where the images packed by a TexturePacker ended up.
+    @remarks
+        The descriptor is plain text, so the packing can run offline: save the
+        packed Image and the descriptor, then at runtime load the descriptor and
+        call apply() on the materials to point their texture units at the packed
+        texture instead of the individual ones.
+    */
+    struct TextureAtlas
+    {
+        /// The rectangle of one packed image, in pixels of the packed texture
+        struct Entry
+        {
+            /// Name of the original texture
+            String name;
+            /// Array layer, 0 for atlases
+            uint32 layer{0};
+            uint32 left{0};
+            uint32 top{0};
+            uint32 width{0};
+            uint32 height{0};
+        };
+
+        /// Name of the packed texture
+        String textureName;
+        /// TextureType::_2D for atlases, TextureType::_2D_ARRAY for arrays
+        TextureType textureType{TextureType::_2D};
+        uint32 width{0};
+        uint32 height{0};
+        uint32 layers{1};
+        std::vector<Entry> entries;
+
+        /// Gets the entry of the named texture, nullptr if it was not packed
+        [[nodiscard]] auto getEntry(std::string_view name) const -> const Entry*;
+
+        /** Gets the texture coordinate transform that maps [0, 1] to the entry.
+        @remarks
+            For arrays the layer is the z translation, the geometry keeps using 2D texture
+            coordinates.
+        */
+        [[nodiscard]] auto getTransform(const Entry& entry) const -> Matrix4;
+
+        /** Points the texture units of material that use a packed texture at the packed one.
+        @remarks
+            The current texture transform of each unit is combined with getTransform() and set
+            as a fixed matrix, so later calls to the scroll, scale and rotate setters of a changed
+            unit replace the atlas transform. Units with effects are left alone for that reason.
+            Texture coordinates outside [0, 1] sample the neighbouring images of an atlas, so for
+            atlases only units with TextureAddressingMode::CLAMP in u and v are changed.
+        @return the number of texture units changed
+        */
+        auto apply(const MaterialPtr& material) const -> size_t;
+
+        /// Writes the descriptor to a text file
+        void save(std::string_view filename) const;
+        /// Reads a descriptor written by save()
+        void load(const DataStreamPtr& stream);
+    };
+
+    /** Packs many small images into one texture to reduce texture changes between passes.
+    @remarks
+        In atlas mode the images are placed into a power of two 2D image with a skyline
+        packer. Each image gets a border of replicated edge pixels and starts on a multiple
+        of the padding, so filtering and the first mipmap levels do not bleed into the
+        neighbours. In array mode every image becomes one layer of a 2D array, images of a
+        different size are scaled to the size of the largest one.
+    */
+    class TexturePacker
+    {
+    public:
+        enum class Layout
+        {
+            ATLAS,
+            ARRAY
+        };
+
+        TexturePacker(Layout layout = Layout::ATLAS) : mLayout(layout) {}
+
+        /// Sets the border around each atlas image in pixels, 4 by default
+        void setPadding(uint32 pixels) { mPadding = pixels; }
+        [[nodiscard]] auto getPadding() const noexcept -> uint32 { return mPadding; }
+
+        /// Sets the largest width and height of an atlas, 4096 by default
+        void setMaxSize(uint32 size) { mMaxSize = size; }
+        [[nodiscard]] auto getMaxSize() const noexcept -> uint32 { return mMaxSize; }
+
+        /// Sets the format of the packed image, must not be compressed
+        void setFormat(PixelFormat format);
+        [[nodiscard]] auto getFormat() const noexcept -> PixelFormat { return mFormat; }
+
+        /// Adds an image, the name is what the texture units refer to
+        void addImage(std::string_view name, const Image& image);
+
+        /** Adds the textures of the material's texture units.
+        @remarks
+            Only named single frame 2D textures are added, each texture once, from the units
+            TextureAtlas::apply() would change.
+        @return the number of textures added
+        */
+        auto addMaterial(const MaterialPtr& material) -> size_t;
+
+        /// Number of images added so far
+        [[nodiscard]] auto getNumImages() const noexcept -> size_t { return mImages.size(); }
+
+        /** Packs the images added so far.
+        @param textureName the name the packed texture will be created with
+        @param dest receives the packed image, as an atlas or with one depth slice per layer
+        @return where each image was placed
+        */
+        auto pack(std::string_view textureName, Image& dest) const -> TextureAtlas;
+
+    private:
+        void packAtlas(TextureAtlas& atlas, Image& dest) const;
+        void packArray(TextureAtlas& atlas, Image& dest) const;
+
+        Layout mLayout;
+        uint32 mPadding{4};
+        uint32 mMaxSize{4096};
+        PixelFormat mFormat{PixelFormat::BYTE_RGBA};
+        std::vector<std::pair<String, Image>> mImages;
+    };
+    /** @} */
+    /** @} */
+
+} // namespace
@@ -43,9 +43,12 @@ export import :Singleton;
 export import :Texture;
 export import :TextureUnitState;
 
+export import <list>;
 export import <map>;
 export import <memory>;
+export import <mutex>;
 export import <string>;
+export import <utility>;
 
 export
 namespace Ogre {
@@ -57,6 +60,80 @@ class Image;
     /** \addtogroup Resources
     *  @{
     */
+    /** Persistent store of decoded textures.
+
+        Holds images as they are uploaded, i.e. after decoding, scaling, mipmap generation and
+        optional block compression, keyed by the content of the source file and the load options.
+        Each entry is a file in the cache directory that is memory mapped when found, so later
+        loads skip decoding and read the pixels in place. The data is stored in native byte order.
+        The total size of the files is bounded, the least recently used entries are removed first.
+    @see TextureManager::setTextureCache
+    */
+    class TextureCache
+    {
+    public:
+        using Hash = std::pair<uint64, uint64>;
+
+        /** Opens a cache directory, creating it if needed.
+        @param directory Where the entries are stored
+        @param maxSize Upper bound of the total size of the entries in bytes
+        */
+        TextureCache(std::string_view directory, size_t maxSize);
+
+        /// Returns the key of a source file, covering both its content and the load options
+        [[nodiscard]] static auto makeKey(const void* data, size_t size, std::string_view options) -> Hash;
+
+        /** Maps the entry stored for the key into the image.
+        @return false if there is no such entry or it is damaged. May be called from several threads.
+        */
+        auto find(const Hash& key, Image& image) -> bool;
+        /** Stores an image, removing least recently used entries beyond the size limit.
+        @remarks
+            Images larger than the size limit are not stored. May be called from several threads.
+        @throws IOException if the entry can not be written
+        */
+        void insert(const Hash& key, const Image& image);
+        /// Removes all entries
+        void clear();
+
+        /// Sets the upper bound of the total size of the entries in bytes, removing entries beyond it
+        void setMaxSize(size_t maxSize);
+        [[nodiscard]] auto getMaxSize() const noexcept -> size_t { return mMaxSize; }
+        /// Total size of the entries in bytes
+        [[nodiscard]] auto getSize() const noexcept -> size_t { return mSize; }
+        [[nodiscard]] auto getDirectory() const noexcept -> std::string_view { return mDirectory; }
+
+        /** Sets the block compressed format images are converted to before they are stored.
+        @remarks
+            Only 8 bit per channel colour images are compressed and only if the texture format is
+            supported by the render system, see Image::compress for the available formats.
+            PixelFormat::UNKNOWN, the default, stores the images as decoded.
+        */
+        void setCompressionFormat(PixelFormat format) { mCompressionFormat = format; }
+        [[nodiscard]] auto getCompressionFormat() const noexcept -> PixelFormat { return mCompressionFormat; }
+
+    private:
+        struct Entry
+        {
+            size_t size;
+            /// position in mLru
+            std::list<Hash>::iterator use;
+        };
+
+        [[nodiscard]] auto getPath(const Hash& key) const -> String;
+        /// removes least recently used entries until the total size is at most maxSize
+        void evict(size_t maxSize);
+
+        String mDirectory;
+        size_t mMaxSize;
+        size_t mSize{0};
+        PixelFormat mCompressionFormat{PixelFormat::UNKNOWN};
+        std::map<Hash, Entry> mEntries;
+        /// most recently used first
+        std::list<Hash> mLru;
+        std::mutex mMutex;
+    };
+
     /** Class for loading & managing textures.
         @remarks
             Note that this class is abstract - the particular
@@ -408,6 +485,42 @@ class Image;
             return mDefaultNumMipmaps;
         }
 
+        /** Enables a persistent cache of decoded textures.
+        @remarks
+            Textures loaded from image files are stored the way they are uploaded, so unchanged
+            files are memory mapped on later runs instead of being decoded, scaled and mipmapped
+            again. Sources that are already block compressed are not cached.
+        @param directory The cache directory, created if needed. An empty name disables the cache.
+        @param maxSize Upper bound of the total size of the cache in bytes
+        */
+        void setTextureCache(std::string_view directory, size_t maxSize = 512 * 1024 * 1024);
+        /// Returns the texture cache or nullptr if it is disabled
+        [[nodiscard]] auto getTextureCache() const noexcept -> TextureCache* { return mCache.get(); }
+
+        /** Sets the decoded size from which images are decoded straight into texture memory.
+        @remarks
+            Images of at least this many bytes whose codec supports it (see ImageCodec::decodeInto)
+            stay encoded after prepare() and are decoded scanline by scanline into the locked texture
+            by load(), converting to the texture format on the way. This avoids the intermediate Image
+            and a full size copy, but the decoding happens on the thread calling load(). Only single 2D
+            images without gamma adjustment, software mipmaps or texture cache are streamed.
+            0 disables streaming.
+        */
+        void setStreamingThreshold(size_t bytes) { mStreamingThreshold = bytes; }
+        /// Gets the decoded size from which images are decoded straight into texture memory
+        [[nodiscard]] auto getStreamingThreshold() const noexcept -> size_t { return mStreamingThreshold; }
+
+        /** Sets whether block compressed images are decoded on the CPU if the render system can not sample them.
+        @remarks
+            Covers the formats Image::decompress supports, e.g. DXT textures on GLES devices without
+            S3TC. The decoded image takes four to eight times the memory of the compressed one, so
+            applications shipping a compressed format for each target can turn this off to have such
+            textures fail instead. On by default. Image::load never decompresses.
+        */
+        void setSoftwareDecompression(bool enabled) { mSoftwareDecompression = enabled; }
+        /// Gets whether block compressed images are decoded on the CPU if the render system can not sample them
+        [[nodiscard]] auto getSoftwareDecompression() const noexcept -> bool { return mSoftwareDecompression; }
+
         /// Internal method to create a warning texture (bound when a texture unit is blank)
         auto _getWarningTexture() -> const TexturePtr&;
 
@@ -429,6 +542,9 @@ class Image;
         TexturePtr mWarningTexture;
         SamplerPtr mDefaultSampler;
         std::map<std::string, SamplerPtr, std::less<>> mNamedSamplers;
+        ::std::unique_ptr<TextureCache> mCache;
+        size_t mStreamingThreshold{32 * 1024 * 1024};
+        bool mSoftwareDecompression{true};
     };
 
     /// Specialisation of TextureManager for offline processing. Cannot be used with an active RenderSystem.
@@ -33,10 +33,12 @@ export module Ogre.Core:VertexIndexData;
 
 export import :HardwareBuffer;
 export import :HardwareVertexBuffer;
+export import :Matrix4;
 export import :MemoryAllocatorConfig;
 export import :Platform;
 export import :Prerequisites;
 export import :SharedPtr;
+export import :Vector;
 
 export import <algorithm>;
 export import <vector>;
@@ -109,6 +111,19 @@ class HardwareBufferManagerBase;
         size_t vertexStart;
         /// The number of vertices to process in this particular rendering group
         size_t vertexCount;
+        /** Transform from the positions stored in the vertex buffers to model space.
+        @remarks
+            Identity unless the positions were quantised by reorganiseBuffers. Renderables
+            fold it into their world transforms (and bone matrices), so it has to be applied
+            by anyone reading positions from the buffers directly.
+        */
+        Affine3 positionDecodeMatrix{Affine3::IDENTITY};
+
+        /** Calculates the positionDecodeMatrix for positions quantised within the given bounds.
+        @remarks
+            The scale is uniform, so that decoding positions does not change the direction of normals.
+        */
+        static auto calcPositionDecodeMatrix(const Vector3& vmin, const Vector3& vmax) -> Affine3;
 
 
         /// Struct used to hold hardware morph / pose vertex data information
@@ -179,6 +194,13 @@ class HardwareBufferManagerBase;
             original buffers will not be damaged by this operation.
             Once this operation has completed, the new declaration 
             passed in will overwrite the current one.
+        @par
+            Elements may change their type, in which case the data is converted. This is
+            how vertex data is compressed, see VertexDeclaration::getQuantisedDeclaration:
+            float, half precision and normalised types convert into each other; directions
+            are octahedral encoded where VertexElement::isOctahedral says so; positions
+            converted to a normalised type are fitted into [-1, 1] with a uniform scale and a
+            bias, which are stored in positionDecodeMatrix.
         @param newDeclaration The vertex declaration which will be used
             for the reorganised buffer state. Note that the new declaration
             must not include any elements which do not already exist in the 
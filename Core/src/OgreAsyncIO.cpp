@@ -0,0 +1,744 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+module Ogre.Core;
+
+import :AsyncIO;
+import :DataStream;
+import :Exception;
+import :Platform;
+import :Prerequisites;
+
+import <algorithm>;
+import <atomic>;
+import <condition_variable>;
+import <deque>;
+import <exception>;
+import <format>;
+import <map>;
+import <memory>;
+import <mutex>;
+import <span>;
+import <thread>;
+import <unordered_map>;
+import <utility>;
+import <vector>;
+
+namespace Ogre {
+    //-----------------------------------------------------------------------
+    auto AsyncReadRequest::wait() -> size_t
+    {
+        long long result;
+        {
+            std::unique_lock lock{mMutex};
+            mCompleted.wait(lock, [this] { return mDone; });
+            result = mResult;
+        }
+
+        if (result < 0)
+        {
+            OGRE_EXCEPT(ExceptionCodes::INTERNAL_ERROR,
+                ::std::format("read of {} bytes at {} failed: {}", mSize, mOffset, strerror(int(-result))),
+                "AsyncReadRequest::wait");
+        }
+        return size_t(result);
+    }
+    //-----------------------------------------------------------------------
+    auto AsyncReadRequest::isDone() const -> bool
+    {
+        std::lock_guard lock{mMutex};
+        return mDone;
+    }
+    //-----------------------------------------------------------------------
+    void AsyncReadRequest::_complete(long long result)
+    {
+        {
+            std::lock_guard lock{mMutex};
+            mDone = true;
+            mResult = result;
+            mBuffer.reset();
+        }
+        mCompleted.notify_all();
+    }
+    //-----------------------------------------------------------------------
+    class AsyncIOService::Impl
+    {
+    public:
+        virtual ~Impl() = default;
+        virtual void submit(std::span<const AsyncReadRequestPtr> requests) = 0;
+    };
+namespace {
+    /// Blocking reads on a pool of threads
+    class ThreadPoolBackend : public AsyncIOService::Impl
+    {
+    public:
+        explicit ThreadPoolBackend(size_t numThreads)
+        {
+            for (size_t i = 0; i < numThreads; ++i)
+                mThreads.emplace_back([this] { run(); });
+        }
+
+        ~ThreadPoolBackend() override
+        {
+            {
+                std::lock_guard lock{mMutex};
+                mStop = true;
+            }
+            mWork.notify_all();
+            for (auto& thread : mThreads)
+                thread.join();
+            for (auto& request : mQueue)
+                request->_complete(-ECANCELED);
+        }
+
+        void submit(std::span<const AsyncReadRequestPtr> requests) override
+        {
+            {
+                std::lock_guard lock{mMutex};
+                mQueue.insert(mQueue.end(), requests.begin(), requests.end());
+            }
+            if (requests.size() == 1)
+                mWork.notify_one();
+            else
+                mWork.notify_all();
+        }
+
+    private:
+        void run()
+        {
+            for (;;)
+            {
+                AsyncReadRequestPtr request;
+                {
+                    std::unique_lock lock{mMutex};
+                    mWork.wait(lock, [this] { return mStop || !mQueue.empty(); });
+                    if (mStop)
+                        return;
+                    request = std::move(mQueue.front());
+                    mQueue.pop_front();
+                }
+
+                auto* dest = static_cast<char*>(request->getDestination());
+                size_t done = 0;
+                long long result = 0;
+                while (done < request->getSize())
+                {
+                    ssize_t n = ::pread(request->getFileDescriptor(), dest + done, request->getSize() - done,
+                                        off_t(request->getOffset() + done));
+                    if (n < 0 && errno == EINTR)
+                        continue;
+                    if (n < 0)
+                    {
+                        result = -errno;
+                        break;
+                    }
+                    if (n == 0)
+                        break;
+                    done += size_t(n);
+                }
+                request->_complete(result < 0 ? result : static_cast<long long>(done));
+            }
+        }
+
+        std::mutex mMutex;
+        std::condition_variable mWork;
+        std::deque<AsyncReadRequestPtr> mQueue;
+        std::vector<std::thread> mThreads;
+        bool mStop{false};
+    };
+
+    /// Reads through a Linux io_uring, completions are reaped on a dedicated thread
+    class IoUringBackend : public AsyncIOService::Impl
+    {
+    public:
+        explicit IoUringBackend(uint32 queueDepth)
+        {
+            io_uring_params params{};
+            mRingFd = int(::syscall(__NR_io_uring_setup, queueDepth, &params));
+            if (mRingFd < 0)
+                OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED, ::std::format("io_uring_setup failed: {}", strerror(errno)));
+
+            // IORING_FEAT_FAST_POLL came with 5.7, so IORING_OP_READ (5.6) is supported as well
+            if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_FAST_POLL))
+            {
+                ::close(mRingFd);
+                OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED, "io_uring is too old");
+            }
+
+            mEntries = params.sq_entries;
+            mRingSize = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                                 params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+            mRing = ::mmap(nullptr, mRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd,
+                           IORING_OFF_SQ_RING);
+            mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            mSqes = static_cast<io_uring_sqe*>(::mmap(nullptr, mSqesSize, PROT_READ | PROT_WRITE,
+                                                       MAP_SHARED | MAP_POPULATE, mRingFd, IORING_OFF_SQES));
+            mWakeFd = ::eventfd(0, EFD_CLOEXEC);
+            if (mRing == MAP_FAILED || mSqes == MAP_FAILED || mWakeFd < 0)
+            {
+                if (mRing != MAP_FAILED)
+                    ::munmap(mRing, mRingSize);
+                if (mSqes != MAP_FAILED)
+                    ::munmap(mSqes, mSqesSize);
+                if (mWakeFd >= 0)
+                    ::close(mWakeFd);
+                ::close(mRingFd);
+                OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED, "cannot map the io_uring");
+            }
+
+            auto* ring = static_cast<char*>(mRing);
+            mSqHead = reinterpret_cast<unsigned*>(ring + params.sq_off.head);
+            mSqTail = reinterpret_cast<unsigned*>(ring + params.sq_off.tail);
+            mSqMask = *reinterpret_cast<unsigned*>(ring + params.sq_off.ring_mask);
+            mSqArray = reinterpret_cast<unsigned*>(ring + params.sq_off.array);
+            mCqHead = reinterpret_cast<unsigned*>(ring + params.cq_off.head);
+            mCqTail = reinterpret_cast<unsigned*>(ring + params.cq_off.tail);
+            mCqMask = *reinterpret_cast<unsigned*>(ring + params.cq_off.ring_mask);
+            mCqes = reinterpret_cast<io_uring_cqe*>(ring + params.cq_off.cqes);
+
+            mReaper = std::thread([this] { reap(); });
+        }
+
+        ~IoUringBackend() override
+        {
+            {
+                std::unique_lock lock{mStateMutex};
+                mStop = true;
+
+                // the kernel writes into the destinations until a read completed, so cancel what is
+                // in flight and let the reaper drain the completions before anything is released
+                if (!mReapFailed && !mPending.empty())
+                {
+                    std::lock_guard ring{mRingMutex};
+                    for (const auto& [id, request] : mPending)
+                    {
+                        io_uring_sqe* sqe = nextSqe();
+                        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                        sqe->addr = id;
+                        sqe->user_data = CANCEL_ID;
+                    }
+                    // without the cancellations the reads simply run to their end
+                    if (enter(unsigned(mPending.size())) != 0)
+                        withdrawUnsubmitted();
+                }
+                mSlotFreed.wait(lock, [this] { return mReapFailed || mPending.empty(); });
+            }
+
+            // the eventfd cannot fail to wake up the reaper, unlike a nop through the ring
+            uint64 const wake = 1;
+            while (::write(mWakeFd, &wake, sizeof(wake)) < 0 && errno == EINTR) {}
+            mReaper.join();
+
+            ::munmap(mSqes, mSqesSize);
+            ::munmap(mRing, mRingSize);
+            ::close(mWakeFd);
+            ::close(mRingFd);
+        }
+
+        void submit(std::span<const AsyncReadRequestPtr> requests) override
+        {
+            while (!requests.empty())
+            {
+                // never have more reads in flight than the rings can hold
+                std::vector<uint64> ids;
+                {
+                    std::unique_lock lock{mStateMutex};
+                    mSlotFreed.wait(lock, [this] { return mReapFailed || mInFlight < mEntries; });
+                    if (mReapFailed)
+                    {
+                        lock.unlock();
+                        for (const auto& request : requests)
+                            request->_complete(mReapError);
+                        return;
+                    }
+                    size_t count = std::min<size_t>(requests.size(), mEntries - mInFlight);
+                    mInFlight += count;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        ids.push_back(++mLastId);
+                        mPending.emplace(ids.back(), requests[i]);
+                    }
+                }
+
+                int error;
+                std::vector<uint64> withdrawn;
+                {
+                    std::lock_guard lock{mRingMutex};
+                    for (size_t i = 0; i < ids.size(); ++i)
+                        pushRead(ids[i], *requests[i], 0);
+                    error = enter(unsigned(ids.size()));
+                    if (error != 0)
+                        withdrawn = withdrawUnsubmitted();
+                }
+                if (error != 0)
+                    fail(withdrawn, error);
+                requests = requests.subspan(ids.size());
+            }
+        }
+
+    private:
+        /// user_data of the cancellations issued on destruction and of withdrawn entries, their
+        /// completions are ignored
+        static uint64 constexpr CANCEL_ID = ~uint64(0);
+
+        /// Must hold mRingMutex. There is always room as the reads in flight are limited to mEntries.
+        auto nextSqe() -> io_uring_sqe*
+        {
+            unsigned tail = *mSqTail;
+            unsigned index = tail & mSqMask;
+            io_uring_sqe* sqe = &mSqes[index];
+            memset(sqe, 0, sizeof(*sqe));
+            mSqArray[index] = index;
+            std::atomic_ref<unsigned>{*mSqTail}.store(tail + 1, std::memory_order_release);
+            return sqe;
+        }
+
+        /// Must hold mRingMutex
+        void pushRead(uint64 id, const AsyncReadRequest& request, size_t done)
+        {
+            io_uring_sqe* sqe = nextSqe();
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = request.getFileDescriptor();
+            sqe->off = request.getOffset() + done;
+            sqe->addr = reinterpret_cast<uint64>(static_cast<char*>(request.getDestination()) + done);
+            sqe->len = unsigned(std::min<size_t>(request.getSize() - done, 0x7ffff000));
+            sqe->user_data = id;
+        }
+
+        /** Must hold mRingMutex. Returns 0, or the negated errno if the kernel refused the entries.
+            Those stay in the queue until withdrawUnsubmitted() is called.
+        */
+        auto enter(unsigned toSubmit) -> int
+        {
+            while (toSubmit > 0)
+            {
+                long n = ::syscall(__NR_io_uring_enter, mRingFd, toSubmit, 0, 0, nullptr, 0);
+                if (n < 0 && (errno == EINTR || errno == EAGAIN || errno == EBUSY))
+                    continue;
+                if (n < 0)
+                    return -errno;
+                toSubmit -= unsigned(n);
+            }
+            return 0;
+        }
+
+        /** Must hold mRingMutex. Turns the entries the kernel has not consumed into nops, so the
+            next submission cannot start a read that was already failed, and returns their ids.
+        */
+        auto withdrawUnsubmitted() -> std::vector<uint64>
+        {
+            std::vector<uint64> ids;
+            unsigned const tail = *mSqTail;
+            for (unsigned head = std::atomic_ref<unsigned>{*mSqHead}.load(std::memory_order_acquire);
+                 head != tail; ++head)
+            {
+                io_uring_sqe& sqe = mSqes[mSqArray[head & mSqMask]];
+                if (sqe.opcode == IORING_OP_READ)
+                    ids.push_back(sqe.user_data);
+                memset(&sqe, 0, sizeof(sqe));
+                sqe.opcode = IORING_OP_NOP;
+                sqe.user_data = CANCEL_ID;
+            }
+            return ids;
+        }
+
+        /// Must not hold mStateMutex. Completes the pending reads with the given ids with error.
+        void fail(std::span<const uint64> ids, int error)
+        {
+            std::vector<AsyncReadRequestPtr> failed;
+            {
+                std::lock_guard lock{mStateMutex};
+                for (uint64 id : ids)
+                {
+                    auto it = mPending.find(id);
+                    if (it == mPending.end())
+                        continue;
+                    failed.push_back(std::move(it->second));
+                    mPending.erase(it);
+                    mPartial.erase(id);
+                    --mInFlight;
+                }
+            }
+            mSlotFreed.notify_all();
+            for (const auto& request : failed)
+                request->_complete(error);
+        }
+
+        void reap()
+        {
+            for (;;)
+            {
+                // the ring is readable while it holds completions
+                pollfd fds[2] = {{mRingFd, POLLIN, 0}, {mWakeFd, POLLIN, 0}};
+                if (::poll(fds, 2, -1) < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    // no completion will arrive anymore, fail what is pending rather than leave it waiting
+                    failPending(-errno);
+                    return;
+                }
+
+                unsigned head = *mCqHead;
+                unsigned tail = std::atomic_ref<unsigned>{*mCqTail}.load(std::memory_order_acquire);
+                std::vector<std::pair<uint64, int>> completions;
+                for (; head != tail; ++head)
+                {
+                    const io_uring_cqe& cqe = mCqes[head & mCqMask];
+                    completions.emplace_back(cqe.user_data, cqe.res);
+                }
+                std::atomic_ref<unsigned>{*mCqHead}.store(head, std::memory_order_release);
+
+                for (auto [id, res] : completions)
+                {
+                    if (id != CANCEL_ID)
+                        complete(id, res);
+                }
+
+                // only the destructor wakes us, once nothing is pending anymore
+                if (fds[1].revents & POLLIN)
+                    return;
+            }
+        }
+
+        void complete(uint64 id, int res)
+        {
+            AsyncReadRequestPtr request;
+            size_t done;
+            {
+                std::lock_guard lock{mStateMutex};
+                auto it = mPending.find(id);
+                if (it == mPending.end())
+                    return;
+                request = it->second;
+                done = (mPartial[id] += size_t(std::max(res, 0)));
+
+                // short reads only end the request at the end of the file, or when shutting down
+                if (res > 0 && done < request->getSize() && !mStop)
+                {
+                    std::lock_guard ring{mRingMutex};
+                    pushRead(id, *request, done);
+                    int const error = enter(1);
+                    if (error == 0)
+                        return;
+                    // submit() never leaves entries behind, so this read is the only one withdrawn
+                    withdrawUnsubmitted();
+                    res = error;
+                }
+
+                mPending.erase(it);
+                mPartial.erase(id);
+                --mInFlight;
+            }
+            // the destructor waits for the last one as well
+            mSlotFreed.notify_all();
+            request->_complete(res < 0 ? res : static_cast<long long>(done));
+        }
+
+        void failPending(int error)
+        {
+            std::unordered_map<uint64, AsyncReadRequestPtr> pending;
+            {
+                std::lock_guard lock{mStateMutex};
+                mReapFailed = true;
+                mReapError = error;
+                pending.swap(mPending);
+                mPartial.clear();
+                mInFlight = 0;
+            }
+            mSlotFreed.notify_all();
+            for (auto& [id, request] : pending)
+                request->_complete(error);
+        }
+
+        int mRingFd;
+        /// eventfd stopping the reaper
+        int mWakeFd;
+        unsigned mEntries;
+        void* mRing;
+        size_t mRingSize;
+        io_uring_sqe* mSqes;
+        size_t mSqesSize;
+        unsigned *mSqHead, *mSqTail, *mSqArray, mSqMask;
+        unsigned *mCqHead, *mCqTail, mCqMask;
+        io_uring_cqe* mCqes;
+
+        /// guards the submission queue
+        std::mutex mRingMutex;
+        /// guards the bookkeeping below, taken before mRingMutex
+        std::mutex mStateMutex;
+        std::condition_variable mSlotFreed;
+        std::unordered_map<uint64, AsyncReadRequestPtr> mPending;
+        std::unordered_map<uint64, size_t> mPartial;
+        uint64 mLastId{0};
+        size_t mInFlight{0};
+        /// set when reaping failed, later submissions fail with mReapError right away
+        bool mReapFailed{false};
+        int mReapError{0};
+
+        std::thread mReaper;
+        std::atomic<bool> mStop{false};
+    };
+}
+    //-----------------------------------------------------------------------
+    AsyncIOService::AsyncIOService(Backend backend, uint32 queueDepth)
+        : mBackend(backend)
+    {
+        if (mBackend == Backend::IO_URING)
+        {
+            try
+            {
+                mImpl = std::make_unique<IoUringBackend>(queueDepth);
+            }
+            catch (const Exception&)
+            {
+                // e.g. an old kernel or a seccomp filter blocking io_uring
+                mBackend = Backend::THREAD_POOL;
+            }
+        }
+
+        if (mBackend == Backend::THREAD_POOL)
+        {
+            // enough threads to keep several reads in flight on fast devices
+            size_t numThreads = std::clamp<size_t>(std::thread::hardware_concurrency(), 4, 16);
+            mImpl = std::make_unique<ThreadPoolBackend>(std::min<size_t>(numThreads, queueDepth));
+        }
+    }
+    //-----------------------------------------------------------------------
+    AsyncIOService::~AsyncIOService() = default;
+    //-----------------------------------------------------------------------
+    auto AsyncIOService::getDefault() -> AsyncIOService&
+    {
+        static AsyncIOService service;
+        return service;
+    }
+    //-----------------------------------------------------------------------
+    auto AsyncIOService::submit(Read read) -> AsyncReadRequestPtr
+    {
+        return submit(std::span<Read>{&read, 1}).front();
+    }
+    //-----------------------------------------------------------------------
+    auto AsyncIOService::submit(std::span<Read> reads) -> std::vector<AsyncReadRequestPtr>
+    {
+        std::vector<AsyncReadRequestPtr> requests;
+        requests.reserve(reads.size());
+        for (auto& read : reads)
+            requests.push_back(std::make_shared<AsyncReadRequest>(read.fd, read.offset, read.dest, read.size,
+                                                                  std::move(read.buffer)));
+        mImpl->submit(requests);
+        return requests;
+    }
+    //-----------------------------------------------------------------------
+    //  AsyncFileDataStream
+    //-----------------------------------------------------------------------
+    AsyncFileDataStream::AsyncFileDataStream(std::string_view name, int fd, size_t size, AsyncIOService& service,
+                                             size_t blockSize, size_t readAhead)
+        : DataStream(name), mFd(fd), mBlockSize(blockSize), mReadAhead(readAhead), mService(service)
+    {
+        mSize = size;
+    }
+    //-----------------------------------------------------------------------
+    AsyncFileDataStream::~AsyncFileDataStream()
+    {
+        close();
+    }
+    //-----------------------------------------------------------------------
+    void AsyncFileDataStream::requestBlocks(size_t first, size_t last)
+    {
+        last = std::min(last, (mSize + mBlockSize - 1) / mBlockSize);
+
+        std::vector<AsyncIOService::Read> reads;
+        std::vector<size_t> indices;
+        for (size_t index = first; index < last; ++index)
+        {
+            if (mBlocks.contains(index))
+                continue;
+            size_t offset = index * mBlockSize;
+            ::std::shared_ptr<uchar[]> data{new uchar[mBlockSize]};
+            reads.push_back({mFd, offset, data.get(), std::min(mBlockSize, mSize - offset), data});
+            indices.push_back(index);
+            mBlocks[index].data = std::move(data);
+        }
+        if (reads.empty())
+            return;
+
+        std::vector<AsyncReadRequestPtr> requests;
+        try
+        {
+            requests = mService.submit(reads);
+        }
+        catch (...)
+        {
+            for (size_t index : indices)
+                mBlocks.erase(index);
+            throw;
+        }
+        for (size_t i = 0; i < indices.size(); ++i)
+            mBlocks[indices[i]].request = std::move(requests[i]);
+    }
+    //-----------------------------------------------------------------------
+    void AsyncFileDataStream::advance()
+    {
+        size_t current = mPos / mBlockSize;
+        mBlocks.erase(mBlocks.begin(), mBlocks.lower_bound(current));
+        if (mPos < mSize)
+            requestBlocks(current, current + 1 + mReadAhead);
+    }
+    //-----------------------------------------------------------------------
+    void AsyncFileDataStream::prefetch(size_t offset, size_t count)
+    {
+        if (offset >= mSize || count == 0)
+            return;
+        requestBlocks(offset / mBlockSize, (std::min(offset + count, mSize) + mBlockSize - 1) / mBlockSize);
+    }
+    //-----------------------------------------------------------------------
+    auto AsyncFileDataStream::read(void* buf, size_t count) -> size_t
+    {
+        count = std::min(count, mSize - std::min(mPos, mSize));
+        auto* dest = static_cast<uchar*>(buf);
+        size_t done = 0;
+
+        while (done < count)
+        {
+            size_t pos = mPos + done;
+            size_t index = pos / mBlockSize;
+            auto it = mBlocks.find(index);
+
+            // large reads go straight to the destination as parallel block sized reads
+            if (it == mBlocks.end() && pos % mBlockSize == 0 && count - done >= 2 * mBlockSize)
+            {
+                size_t direct = (count - done) / mBlockSize * mBlockSize;
+                std::vector<AsyncIOService::Read> reads;
+                for (size_t offset = 0; offset < direct; offset += mBlockSize)
+                    reads.push_back({mFd, pos + offset, dest + done + offset, mBlockSize, nullptr});
+
+                // wait for all of them before leaving, they write into the caller's buffer
+                auto requests = mService.submit(reads);
+                size_t got = 0;
+                bool complete = true;
+                std::exception_ptr error;
+                for (auto& request : requests)
+                {
+                    try
+                    {
+                        size_t n = request->wait();
+                        if (complete)
+                            got += n;
+                        complete = complete && n == mBlockSize;
+                    }
+                    catch (...)
+                    {
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                }
+                if (error)
+                    std::rethrow_exception(error);
+
+                done += got;
+                if (!complete)
+                    break;
+                continue;
+            }
+
+            if (it == mBlocks.end())
+            {
+                requestBlocks(index, index + 1);
+                it = mBlocks.find(index);
+            }
+
+            size_t available = it->second.request->wait();
+            size_t offsetInBlock = pos - index * mBlockSize;
+            if (available <= offsetInBlock)
+                break;
+            size_t n = std::min(available - offsetInBlock, count - done);
+            memcpy(dest + done, it->second.data.get() + offsetInBlock, n);
+            done += n;
+        }
+
+        mPos += done;
+        advance();
+        return done;
+    }
+    //-----------------------------------------------------------------------
+    void AsyncFileDataStream::skip(long count)
+    {
+        seek(size_t(std::max(0l, long(mPos) + count)));
+    }
+    //-----------------------------------------------------------------------
+    void AsyncFileDataStream::seek( size_t pos )
+    {
+        mPos = std::min(pos, mSize);
+    }
+    //-----------------------------------------------------------------------
+    auto AsyncFileDataStream::tell() const -> size_t
+    {
+        return mPos;
+    }
+    //-----------------------------------------------------------------------
+    auto AsyncFileDataStream::eof() const -> bool
+    {
+        return mPos >= mSize;
+    }
+    //-----------------------------------------------------------------------
+    void AsyncFileDataStream::close()
+    {
+        if (mFd < 0)
+            return;
+
+        // reads in flight must not hit a reused descriptor
+        for (auto& [index, block] : mBlocks)
+        {
+            if (!block.request)
+                continue;
+            try
+            {
+                block.request->wait();
+            }
+            catch (const Exception&)
+            {
+            }
+        }
+        mBlocks.clear();
+
+        ::close(mFd);
+        mFd = -1;
+    }
+}
@@ -123,6 +123,7 @@ namespace Ogre {
             ChainSegment& seg = mChainSegmentList[i];
             seg.start = i * mMaxElementsPerChain;
             seg.tail = seg.head = SEGMENT_EMPTY;
+            seg.dirty = true;
 
         }
 
@@ -167,16 +168,25 @@ namespace Ogre {
         setupVertexDeclaration();
         if (mBuffersNeedRecreating)
         {
-            // Create the vertex buffer (always dynamic due to the camera adjust)
-            HardwareVertexBufferSharedPtr pBuffer =
-                HardwareBufferManager::getSingleton().createVertexBuffer(
-                mVertexData->vertexDeclaration->getVertexSize(0),
-                mVertexData->vertexCount,
-                HardwareBuffer::DYNAMIC_WRITE_ONLY_DISCARDABLE);
+            // Vertices are generated into system memory first, so that only the
+            // segments which changed need to be rebuilt
+            mVertexCache.resize(mVertexData->vertexDeclaration->getVertexSize(0) * mVertexData->vertexCount);
+            mStreamAlloc = {};
 
-            // (re)Bind the buffer
-            // Any existing buffer will lose its reference count and be destroyed
-            mVertexData->vertexBufferBinding->setBinding(0, pBuffer);
+            if (!mDynamic)
+            {
+                HardwareVertexBufferSharedPtr pBuffer =
+                    HardwareBufferManager::getSingleton().createVertexBuffer(
+                    mVertexData->vertexDeclaration->getVertexSize(0),
+                    mVertexData->vertexCount,
+                    HardwareBuffer::DYNAMIC_WRITE_ONLY);
+
+                // (re)Bind the buffer
+                // Any existing buffer will lose its reference count and be destroyed
+                mVertexData->vertexBufferBinding->setBinding(0, pBuffer);
+                mVertexData->vertexStart = 0;
+            }
+            // else a range of the streaming ring is bound in updateVertexBuffer
 
             mIndexData->indexBuffer =
                 HardwareBufferManager::getSingleton().createIndexBuffer(
@@ -274,7 +284,7 @@ namespace Ogre {
         // Set the details
         mChainElementList[seg.start + seg.head] = dtls;
 
-        mVertexContentDirty = true;
+        seg.dirty = true;
         mIndexContentDirty = true;
         mBoundsDirty = true;
         // tell parent node to update bounds
@@ -305,7 +315,7 @@ namespace Ogre {
         }
 
         // we removed an entry so indexes need updating
-        mVertexContentDirty = true;
+        seg.dirty = true;
         mIndexContentDirty = true;
         mBoundsDirty = true;
         // tell parent node to update bounds
@@ -322,7 +332,7 @@ namespace Ogre {
         seg.tail = seg.head = SEGMENT_EMPTY;
 
         // we removed an entry so indexes need updating
-        mVertexContentDirty = true;
+        seg.dirty = true;
         mIndexContentDirty = true;
         mBoundsDirty = true;
         // tell parent node to update bounds
@@ -359,7 +369,7 @@ namespace Ogre {
 
         mChainElementList[idx] = dtls;
 
-        mVertexContentDirty = true;
+        seg.dirty = true;
         mBoundsDirty = true;
         // tell parent node to update bounds
         if (mParentNode)
@@ -449,140 +459,209 @@ namespace Ogre {
     void BillboardChain::updateVertexBuffer(Camera* cam)
     {
         setupBuffers();
-        
-        // The contents of the vertex buffer are correct if they are not dirty
-        // and the camera used to build the vertex buffer is still the current 
-        // camera.
-        if (!mVertexContentDirty && mVertexCameraUsed == cam)
-            return;
-
-        HardwareVertexBufferSharedPtr pBuffer =
-            mVertexData->vertexBufferBinding->getBuffer(0);
-        HardwareBufferLockGuard vertexLock(pBuffer, HardwareBuffer::LockOptions::DISCARD);
 
         const Vector3& camPos = cam->getDerivedPosition();
         Vector3 eyePos = mParentNode->convertWorldToLocalPosition(camPos);
 
-        Vector3 chainTangent;
+        // The cached vertices of a segment are correct if neither the segment
+        // nor the whole chain is dirty and the camera used to build them is
+        // still the current camera.
+        bool rebuildAll = mVertexContentDirty || mVertexCameraUsed != cam;
+        bool rebuilt = false;
         for (auto & seg : mChainSegmentList)
         {
-            // Skip 0 or 1 element segment counts
-            if (seg.head != SEGMENT_EMPTY && seg.head != seg.tail)
+            if (rebuildAll || seg.dirty)
             {
-                size_t laste = seg.head;
-                for (size_t e = seg.head; ; ++e) // until break
-                {
-                    // Wrap forwards
-                    if (e == mMaxElementsPerChain)
-                        e = 0;
-
-                    Element& elem = mChainElementList[e + seg.start];
-                    assert (((e + seg.start) * 2) < 65536 && "Too many elements!");
-                    auto baseIdx = static_cast<uint16>((e + seg.start) * 2);
-
-                    // Determine base pointer to vertex #1
-                    auto* pFloat = reinterpret_cast<float*>(
-                        static_cast<char*>(vertexLock.pData) +
-                            pBuffer->getVertexSize() * baseIdx);
+                buildSegmentVertices(seg, eyePos);
+                rebuilt = true;
+            }
+        }
 
-                    // Get index of next item
-                    size_t nexte = e + 1;
-                    if (nexte == mMaxElementsPerChain)
-                        nexte = 0;
+        size_t vertexSize = mVertexData->vertexDeclaration->getVertexSize(0);
+        if (mDynamic)
+        {
+            // Every frame renders from its own range of the ring. The segments which
+            // did not change since the previous range are copied from it on the GPU,
+            // only the rebuilt ones are uploaded.
+            StreamingVertexBuffer& ring =
+                HardwareBufferManager::getSingleton().getStreamingVertexBuffer(vertexSize);
+            if (rebuilt || !ring.isCurrent(mStreamAlloc))
+            {
+                bool copyClean = !rebuildAll && ring.canCopyFrom(mStreamAlloc);
+                StreamingVertexBuffer::Allocation previous = std::move(mStreamAlloc);
+                mStreamAlloc = ring.allocate(mVertexData->vertexCount);
 
-                    if (e == seg.head)
-                    {
-                        // No laste, use next item
-                        chainTangent = mChainElementList[nexte + seg.start].position - elem.position;
-                    }
-                    else if (e == seg.tail)
+                // segments are consecutive, so runs of them are handled at once
+                size_t segmentVertices = mMaxElementsPerChain * 2;
+                for (size_t first = 0; first < mChainSegmentList.size();)
+                {
+                    bool upload = !copyClean || mChainSegmentList[first].dirty;
+                    size_t last = first + 1;
+                    while (last < mChainSegmentList.size() &&
+                           (!copyClean || mChainSegmentList[last].dirty) == upload)
+                        ++last;
+
+                    size_t start = mChainSegmentList[first].start * 2;
+                    size_t count = (last - first) * segmentVertices;
+                    if (upload)
                     {
-                        // No nexte, use only last item
-                        chainTangent = elem.position - mChainElementList[laste + seg.start].position;
+                        memcpy(StreamingVertexBuffer::lock(mStreamAlloc, start, count),
+                               mVertexCache.data() + start * vertexSize, count * vertexSize);
+                        mStreamAlloc.buffer->unlock();
                     }
                     else
-                    {
-                        // A mid position, use tangent across both prev and next
-                        chainTangent = mChainElementList[nexte + seg.start].position - mChainElementList[laste + seg.start].position;
+                        StreamingVertexBuffer::copy(previous, start, mStreamAlloc, start, count);
+                    first = last;
+                }
 
-                    }
+                mVertexData->vertexBufferBinding->setBinding(0, mStreamAlloc.buffer);
+                mVertexData->vertexStart = mStreamAlloc.vertexStart;
+            }
+        }
+        else if (rebuilt)
+        {
+            HardwareVertexBufferSharedPtr pBuffer =
+                mVertexData->vertexBufferBinding->getBuffer(0);
+            if (rebuildAll)
+            {
+                pBuffer->writeData(0, mVertexCache.size(), mVertexCache.data(), true);
+            }
+            else
+            {
+                // only upload the element ranges of the segments that were rebuilt
+                for (auto & seg : mChainSegmentList)
+                {
+                    if (!seg.dirty)
+                        continue;
+                    size_t offset = seg.start * 2 * vertexSize;
+                    pBuffer->writeData(offset, mMaxElementsPerChain * 2 * vertexSize,
+                                       mVertexCache.data() + offset);
+                }
+            }
+        }
 
-                    Vector3 vP1ToEye;
+        for (auto & seg : mChainSegmentList)
+            seg.dirty = false;
 
-                    if( mFaceCamera )
-                        vP1ToEye = eyePos - elem.position;
-                    else
-                        vP1ToEye = elem.orientation * mNormalBase;
+        mVertexCameraUsed = cam;
+        mVertexContentDirty = false;
+    }
+    //-----------------------------------------------------------------------
+    void BillboardChain::buildSegmentVertices(const ChainSegment& seg, const Vector3& eyePos)
+    {
+        // Skip 0 or 1 element segment counts
+        if (seg.head == SEGMENT_EMPTY || seg.head == seg.tail)
+            return;
+
+        size_t vertexSize = mVertexData->vertexDeclaration->getVertexSize(0);
+        Vector3 chainTangent;
+        size_t laste = seg.head;
+        for (size_t e = seg.head; ; ++e) // until break
+        {
+            // Wrap forwards
+            if (e == mMaxElementsPerChain)
+                e = 0;
 
-                    Vector3 vPerpendicular = chainTangent.crossProduct(vP1ToEye);
-                    vPerpendicular.normalise();
-                    vPerpendicular *= (elem.width * 0.5f);
+            Element& elem = mChainElementList[e + seg.start];
+            assert (((e + seg.start) * 2) < 65536 && "Too many elements!");
+            auto baseIdx = static_cast<uint16>((e + seg.start) * 2);
 
-                    Vector3 pos0 = elem.position - vPerpendicular;
-                    Vector3 pos1 = elem.position + vPerpendicular;
+            // Determine base pointer to vertex #1
+            auto* pFloat = reinterpret_cast<float*>(
+                mVertexCache.data() + vertexSize * baseIdx);
 
-                    // pos1
-                    *pFloat++ = pos0.x;
-                    *pFloat++ = pos0.y;
-                    *pFloat++ = pos0.z;
+            // Get index of next item
+            size_t nexte = e + 1;
+            if (nexte == mMaxElementsPerChain)
+                nexte = 0;
 
-                    if (mUseVertexColour)
-                    {
-                        RGBA col = elem.colour.getAsBYTE();
-                        memcpy(pFloat++, &col, sizeof(RGBA));
-                    }
+            if (e == seg.head)
+            {
+                // No laste, use next item
+                chainTangent = mChainElementList[nexte + seg.start].position - elem.position;
+            }
+            else if (e == seg.tail)
+            {
+                // No nexte, use only last item
+                chainTangent = elem.position - mChainElementList[laste + seg.start].position;
+            }
+            else
+            {
+                // A mid position, use tangent across both prev and next
+                chainTangent = mChainElementList[nexte + seg.start].position - mChainElementList[laste + seg.start].position;
 
-                    if (mUseTexCoords)
-                    {
-                        if (mTexCoordDir == TexCoordDirection::U)
-                        {
-                            *pFloat++ = elem.texCoord;
-                            *pFloat++ = mOtherTexCoordRange[0];
-                        }
-                        else
-                        {
-                            *pFloat++ = mOtherTexCoordRange[0];
-                            *pFloat++ = elem.texCoord;
-                        }
-                    }
+            }
 
-                    // pos2
-                    *pFloat++ = pos1.x;
-                    *pFloat++ = pos1.y;
-                    *pFloat++ = pos1.z;
+            Vector3 vP1ToEye;
 
-                    if (mUseVertexColour)
-                    {
-                        RGBA col = elem.colour.getAsBYTE();
-                        memcpy(pFloat++, &col, sizeof(RGBA));
-                    }
+            if( mFaceCamera )
+                vP1ToEye = eyePos - elem.position;
+            else
+                vP1ToEye = elem.orientation * mNormalBase;
 
-                    if (mUseTexCoords)
-                    {
-                        if (mTexCoordDir == TexCoordDirection::U)
-                        {
-                            *pFloat++ = elem.texCoord;
-                            *pFloat++ = mOtherTexCoordRange[1];
-                        }
-                        else
-                        {
-                            *pFloat++ = mOtherTexCoordRange[1];
-                            *pFloat++ = elem.texCoord;
-                        }
-                    }
+            Vector3 vPerpendicular = chainTangent.crossProduct(vP1ToEye);
+            vPerpendicular.normalise();
+            vPerpendicular *= (elem.width * 0.5f);
+
+            Vector3 pos0 = elem.position - vPerpendicular;
+            Vector3 pos1 = elem.position + vPerpendicular;
+
+            // pos1
+            *pFloat++ = pos0.x;
+            *pFloat++ = pos0.y;
+            *pFloat++ = pos0.z;
+
+            if (mUseVertexColour)
+            {
+                RGBA col = elem.colour.getAsBYTE();
+                memcpy(pFloat++, &col, sizeof(RGBA));
+            }
 
-                    if (e == seg.tail)
-                        break; // last one
+            if (mUseTexCoords)
+            {
+                if (mTexCoordDir == TexCoordDirection::U)
+                {
+                    *pFloat++ = elem.texCoord;
+                    *pFloat++ = mOtherTexCoordRange[0];
+                }
+                else
+                {
+                    *pFloat++ = mOtherTexCoordRange[0];
+                    *pFloat++ = elem.texCoord;
+                }
+            }
 
-                    laste = e;
+            // pos2
+            *pFloat++ = pos1.x;
+            *pFloat++ = pos1.y;
+            *pFloat++ = pos1.z;
 
-                } // element
-            } // segment valid?
+            if (mUseVertexColour)
+            {
+                RGBA col = elem.colour.getAsBYTE();
+                memcpy(pFloat++, &col, sizeof(RGBA));
+            }
 
-        } // each segment
+            if (mUseTexCoords)
+            {
+                if (mTexCoordDir == TexCoordDirection::U)
+                {
+                    *pFloat++ = elem.texCoord;
+                    *pFloat++ = mOtherTexCoordRange[1];
+                }
+                else
+                {
+                    *pFloat++ = mOtherTexCoordRange[1];
+                    *pFloat++ = elem.texCoord;
+                }
+            }
 
-        mVertexCameraUsed = cam;
-        mVertexContentDirty = false;
+            if (e == seg.tail)
+                break; // last one
+
+            laste = e;
+
+        } // element
     }
     //-----------------------------------------------------------------------
     void BillboardChain::updateIndexBuffer()
@@ -335,22 +335,28 @@ namespace Ogre {
         mNumVisibleBillboards = 0;
 
         // Lock the buffer
-        if (numBillboards) // optimal lock
+        size_t vertsPerBillboard = mPointRendering ? 1 : 4;
+        if (mAutoUpdate)
+        {
+            // Contents are regenerated every frame, so stream them through the
+            // shared ring instead of renaming our own buffer with a discard
+            numBillboards = numBillboards ? std::min(mPoolSize, numBillboards) : mPoolSize;
+
+            VertexData* vertexData = mVertexData.get();
+            StreamingVertexBuffer& ring = HardwareBufferManager::getSingleton().getStreamingVertexBuffer(
+                vertexData->vertexDeclaration->getVertexSize(0));
+            mStreamAlloc = ring.allocate(numBillboards * vertsPerBillboard);
+            vertexData->vertexBufferBinding->setBinding(0, mStreamAlloc.buffer);
+
+            mLockPtr = static_cast<float*>(StreamingVertexBuffer::lock(mStreamAlloc));
+        }
+        else if (numBillboards) // optimal lock
         {
             // clamp to max
             numBillboards = std::min(mPoolSize, numBillboards);
 
-            size_t billboardSize;
-            if (mPointRendering)
-            {
-                // just one vertex per billboard (this also excludes texcoords)
-                billboardSize = mMainBuf->getVertexSize();
-            }
-            else
-            {
-                // 4 corners
-                billboardSize = mMainBuf->getVertexSize() * 4;
-            }
+            // just one vertex per billboard when point rendering (this also excludes texcoords)
+            size_t billboardSize = mMainBuf->getVertexSize() * vertsPerBillboard;
             assert (numBillboards * billboardSize <= mMainBuf->getSizeInBytes());
 
             mLockPtr = static_cast<float*>(
@@ -369,6 +375,8 @@ namespace Ogre {
     {
         // Don't accept injections beyond pool size
         if (mNumVisibleBillboards == mPoolSize) return;
+        // nor beyond the streamed range, which is followed by other objects' data
+        if (mAutoUpdate && mNumVisibleBillboards * (mPointRendering ? 1 : 4) == mStreamAlloc.vertexCount) return;
 
         // Skip if not visible (NB always true if not bounds checking individual billboards)
         if (!billboardVisible(mCurrentCamera, bb)) return;
@@ -409,7 +417,10 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void BillboardSet::endBillboards()
     {
-        mMainBuf->unlock();
+        if (mAutoUpdate)
+            mStreamAlloc.buffer->unlock();
+        else
+            mMainBuf->unlock();
     }
     //-----------------------------------------------------------------------
     void BillboardSet::setBounds(const AxisAlignedBox& box, Real radius)
@@ -504,7 +515,7 @@ namespace Ogre {
     void BillboardSet::getRenderOperation(RenderOperation& op)
     {
         op.vertexData = mVertexData.get();
-        op.vertexData->vertexStart = 0;
+        op.vertexData->vertexStart = mAutoUpdate ? mStreamAlloc.vertexStart : 0;
 
         if (mPointRendering)
         {
@@ -606,14 +617,17 @@ namespace Ogre {
             decl->addElement(0, offset, VertexElementType::FLOAT2, VertexElementSemantic::TEXTURE_COORDINATES, 0);
         }
 
-        mMainBuf =
-            HardwareBufferManager::getSingleton().createVertexBuffer(
-                decl->getVertexSize(0),
-                mVertexData->vertexCount,
-                mAutoUpdate ? HardwareBuffer::DYNAMIC_WRITE_ONLY_DISCARDABLE :
-                HardwareBuffer::STATIC_WRITE_ONLY);
-        // bind position and diffuses
-        binding->setBinding(0, mMainBuf);
+        // auto updated sets bind a range of the streaming ring in beginBillboards
+        if (!mAutoUpdate)
+        {
+            mMainBuf =
+                HardwareBufferManager::getSingleton().createVertexBuffer(
+                    decl->getVertexSize(0),
+                    mVertexData->vertexCount,
+                    HardwareBuffer::STATIC_WRITE_ONLY);
+            // bind position and diffuses
+            binding->setBinding(0, mMainBuf);
+        }
 
         if (!mPointRendering)
         {
@@ -667,6 +681,7 @@ namespace Ogre {
         mVertexData.reset();
         mIndexData.reset();
         mMainBuf.reset();
+        mStreamAlloc = {};
 
         mBuffersCreated = false;
     }
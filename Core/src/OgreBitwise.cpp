@@ -0,0 +1,164 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <immintrin.h>
+#include <cstring>
+
+module Ogre.Core;
+
+import :Bitwise;
+import :PlatformInformation;
+import :Prerequisites;
+
+import <array>;
+import <bit>;
+
+namespace Ogre {
+namespace {
+    //---------------------------------------------------------------------
+    // Byte shuffle reversing each 'Size' byte element of a 16 byte lane.
+    template<size_t Size>
+    constexpr auto makeSwapMask() -> ::std::array<char, 16>
+    {
+        ::std::array<char, 16> mask{};
+        for (size_t i = 0; i < mask.size(); ++i)
+            mask[i] = static_cast<char>(i / Size * Size + (Size - 1 - i % Size));
+        return mask;
+    }
+
+    template<size_t Size>
+    constexpr ::std::array<char, 16> SwapMask = makeSwapMask<Size>();
+    //---------------------------------------------------------------------
+    template<typename T>
+    void bswapScalar(uchar* pData, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i, pData += sizeof(T))
+        {
+            T value;
+            memcpy(&value, pData, sizeof(T));
+            value = ::std::byteswap(value);
+            memcpy(pData, &value, sizeof(T));
+        }
+    }
+    //---------------------------------------------------------------------
+    template<typename T>
+    [[gnu::target("ssse3")]]
+    void bswapSSSE3(uchar* pData, size_t count)
+    {
+        const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(SwapMask<sizeof(T)>.data()));
+        size_t const perBlock = 16 / sizeof(T);
+        for (; count >= 4 * perBlock; count -= 4 * perBlock, pData += 64)
+        {
+            auto* p = reinterpret_cast<__m128i*>(pData);
+            __m128i v0 = _mm_loadu_si128(p + 0);
+            __m128i v1 = _mm_loadu_si128(p + 1);
+            __m128i v2 = _mm_loadu_si128(p + 2);
+            __m128i v3 = _mm_loadu_si128(p + 3);
+            _mm_storeu_si128(p + 0, _mm_shuffle_epi8(v0, mask));
+            _mm_storeu_si128(p + 1, _mm_shuffle_epi8(v1, mask));
+            _mm_storeu_si128(p + 2, _mm_shuffle_epi8(v2, mask));
+            _mm_storeu_si128(p + 3, _mm_shuffle_epi8(v3, mask));
+        }
+        for (; count >= perBlock; count -= perBlock, pData += 16)
+        {
+            auto* p = reinterpret_cast<__m128i*>(pData);
+            _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+        }
+        bswapScalar<T>(pData, count);
+    }
+    //---------------------------------------------------------------------
+    template<typename T>
+    [[gnu::target("avx2")]]
+    void bswapAVX2(uchar* pData, size_t count)
+    {
+        // vpshufb shuffles within each 128 bit lane, which never splits an element
+        const __m256i mask = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(SwapMask<sizeof(T)>.data())));
+        size_t const perBlock = 32 / sizeof(T);
+        for (; count >= 4 * perBlock; count -= 4 * perBlock, pData += 128)
+        {
+            auto* p = reinterpret_cast<__m256i*>(pData);
+            __m256i v0 = _mm256_loadu_si256(p + 0);
+            __m256i v1 = _mm256_loadu_si256(p + 1);
+            __m256i v2 = _mm256_loadu_si256(p + 2);
+            __m256i v3 = _mm256_loadu_si256(p + 3);
+            _mm256_storeu_si256(p + 0, _mm256_shuffle_epi8(v0, mask));
+            _mm256_storeu_si256(p + 1, _mm256_shuffle_epi8(v1, mask));
+            _mm256_storeu_si256(p + 2, _mm256_shuffle_epi8(v2, mask));
+            _mm256_storeu_si256(p + 3, _mm256_shuffle_epi8(v3, mask));
+        }
+        for (; count >= perBlock; count -= perBlock, pData += 32)
+        {
+            auto* p = reinterpret_cast<__m256i*>(pData);
+            _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask));
+        }
+        bswapScalar<T>(pData, count);
+    }
+    //---------------------------------------------------------------------
+    using SwapFunction = void (*)(uchar*, size_t);
+
+    template<typename T>
+    auto selectSwapFunction() -> SwapFunction
+    {
+        if (PlatformInformation::hasCpuFeature(PlatformInformation::CpuFeatures::AVX2))
+            return &bswapAVX2<T>;
+        if (PlatformInformation::hasCpuFeature(PlatformInformation::CpuFeatures::SSSE3))
+            return &bswapSSSE3<T>;
+        return &bswapScalar<T>;
+    }
+}
+    //---------------------------------------------------------------------
+    void Bitwise::bswapChunks(void * pData, size_t size, size_t count)
+    {
+        static SwapFunction const swap16 = selectSwapFunction<uint16>();
+        static SwapFunction const swap32 = selectSwapFunction<uint32>();
+        static SwapFunction const swap64 = selectSwapFunction<uint64>();
+
+        auto* p = static_cast<uchar*>(pData);
+        switch (size)
+        {
+        case 0:
+        case 1:
+            return;
+        case 2:
+            swap16(p, count);
+            return;
+        case 4:
+            swap32(p, count);
+            return;
+        case 8:
+            swap64(p, count);
+            return;
+        default:
+            for(size_t c = 0; c < count; ++c)
+                bswapBuffer(p + c * size, size);
+            return;
+        }
+    }
+}
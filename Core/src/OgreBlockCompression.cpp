@@ -0,0 +1,661 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <immintrin.h>
+#include <cmath>
+#include <cstring>
+
+module Ogre.Core;
+
+import :BlockCompression;
+import :Image;
+import :ParallelFor;
+import :PixelFormat;
+import :Prerequisites;
+
+import <algorithm>;
+import <limits>;
+import <utility>;
+import <vector>;
+
+namespace Ogre {
+namespace {
+    using Quality = Image::CompressionQuality;
+
+    //---------------------------------------------------------------------
+    // A 4x4 block as 0..255 floats, the 16 texels of each channel are consecutive
+    struct alignas(16) Block
+    {
+        float texels[4][16];
+    };
+
+    struct alignas(16) Palette
+    {
+        float colours[16][4];
+        int size;
+    };
+
+    auto iterationsFor(Quality quality) -> int
+    {
+        switch (quality)
+        {
+        case Quality::FAST:
+            return 1;
+        case Quality::NORMAL:
+            return 3;
+        case Quality::HIGH:
+        default:
+            return 8;
+        }
+    }
+    //---------------------------------------------------------------------
+    // Picks the nearest palette entry for every texel and returns the summed squared
+    // error. Texels with a zero weight still get an index but add no error.
+    auto fitIndices(const Block& block, const Palette& palette, int channels, const float weights[16], uint8 indices[16]) -> float
+    {
+        __m128 total = _mm_setzero_ps();
+        for (int group = 0; group < 16; group += 4)
+        {
+            __m128 texel[4];
+            for (int c = 0; c < channels; ++c)
+                texel[c] = _mm_load_ps(block.texels[c] + group);
+
+            __m128 best = _mm_set1_ps(std::numeric_limits<float>::max());
+            __m128i bestIndex = _mm_setzero_si128();
+            for (int i = 0; i < palette.size; ++i)
+            {
+                __m128 error = _mm_setzero_ps();
+                for (int c = 0; c < channels; ++c)
+                {
+                    __m128 const d = _mm_sub_ps(texel[c], _mm_set1_ps(palette.colours[i][c]));
+                    error = _mm_add_ps(error, _mm_mul_ps(d, d));
+                }
+                __m128i const closer = _mm_castps_si128(_mm_cmplt_ps(error, best));
+                best = _mm_min_ps(error, best);
+                bestIndex = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(i)), _mm_andnot_si128(closer, bestIndex));
+            }
+
+            alignas(16) int32 chosen[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(chosen), bestIndex);
+            for (int k = 0; k < 4; ++k)
+                indices[group + k] = static_cast<uint8>(chosen[k]);
+            total = _mm_add_ps(total, _mm_mul_ps(best, _mm_loadu_ps(weights + group)));
+        }
+
+        alignas(16) float sums[4];
+        _mm_store_ps(sums, total);
+        return sums[0] + sums[1] + sums[2] + sums[3];
+    }
+    //---------------------------------------------------------------------
+    // Weighted mean of the texels and the direction of largest spread around it,
+    // found by power iteration on the covariance matrix
+    void principalAxis(const Block& block, int channels, const float weights[16], float mean[4], float axis[4])
+    {
+        float total = 0;
+        std::fill(mean, mean + 4, 0.0f);
+        std::fill(axis, axis + 4, 0.0f);
+        for (int i = 0; i < 16; ++i)
+        {
+            total += weights[i];
+            for (int c = 0; c < channels; ++c)
+                mean[c] += weights[i] * block.texels[c][i];
+        }
+        if (total == 0)
+            return;
+        for (int c = 0; c < channels; ++c)
+            mean[c] /= total;
+
+        float covariance[4][4] = {};
+        for (int i = 0; i < 16; ++i)
+        {
+            float d[4];
+            for (int c = 0; c < channels; ++c)
+                d[c] = block.texels[c][i] - mean[c];
+            for (int a = 0; a < channels; ++a)
+                for (int b = 0; b < channels; ++b)
+                    covariance[a][b] += weights[i] * d[a] * d[b];
+        }
+
+        // start from the channel with the largest variance
+        int widest = 0;
+        for (int c = 1; c < channels; ++c)
+            if (covariance[c][c] > covariance[widest][widest])
+                widest = c;
+        if (covariance[widest][widest] <= 0)
+            return;
+        for (int c = 0; c < channels; ++c)
+            axis[c] = covariance[widest][c];
+
+        for (int iteration = 0; iteration < 8; ++iteration)
+        {
+            float next[4] = {};
+            float largest = 0;
+            for (int a = 0; a < channels; ++a)
+            {
+                for (int b = 0; b < channels; ++b)
+                    next[a] += covariance[a][b] * axis[b];
+                largest = std::max(largest, std::abs(next[a]));
+            }
+            if (largest == 0)
+                break;
+            for (int c = 0; c < channels; ++c)
+                axis[c] = next[c] / largest;
+        }
+
+        float length = 0;
+        for (int c = 0; c < channels; ++c)
+            length += axis[c] * axis[c];
+        length = std::sqrt(length);
+        for (int c = 0; c < channels; ++c)
+            axis[c] = length > 0 ? axis[c] / length : 0.0f;
+    }
+    //---------------------------------------------------------------------
+    // Endpoints at the extreme projections of the texels onto the axis
+    void axisEndpoints(const Block& block, int channels, const float weights[16], const float mean[4], const float axis[4],
+                       float e0[4], float e1[4])
+    {
+        float low = 0, high = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            if (weights[i] == 0)
+                continue;
+            float t = 0;
+            for (int c = 0; c < channels; ++c)
+                t += (block.texels[c][i] - mean[c]) * axis[c];
+            low = std::min(low, t);
+            high = std::max(high, t);
+        }
+        for (int c = 0; c < 4; ++c)
+        {
+            e0[c] = std::clamp(mean[c] + low * axis[c], 0.0f, 255.0f);
+            e1[c] = std::clamp(mean[c] + high * axis[c], 0.0f, 255.0f);
+        }
+    }
+    //---------------------------------------------------------------------
+    // Endpoints with the least squared error for the given indices, positions maps an
+    // index to its interpolation weight between e0 and e1
+    auto leastSquares(const Block& block, int channels, const float weights[16], const uint8 indices[16],
+                      const float* positions, float e0[4], float e1[4]) -> bool
+    {
+        float a = 0, b = 0, c = 0;
+        float x0[4] = {}, x1[4] = {};
+        for (int i = 0; i < 16; ++i)
+        {
+            float const w = weights[i];
+            float const t = positions[indices[i]];
+            float const s = 1 - t;
+            a += w * s * s;
+            b += w * s * t;
+            c += w * t * t;
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                x0[ch] += w * s * block.texels[ch][i];
+                x1[ch] += w * t * block.texels[ch][i];
+            }
+        }
+
+        float const det = a * c - b * b;
+        if (std::abs(det) < 1e-6f)
+            return false;
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            e0[ch] = std::clamp((c * x0[ch] - b * x1[ch]) / det, 0.0f, 255.0f);
+            e1[ch] = std::clamp((a * x1[ch] - b * x0[ch]) / det, 0.0f, 255.0f);
+        }
+        return true;
+    }
+    //---------------------------------------------------------------------
+    // BC1 colour block
+    struct Endpoint565
+    {
+        uint16 packed;
+        float rgb[3];
+    };
+
+    auto quantise565(const float rgb[4]) -> Endpoint565
+    {
+        int const r = std::clamp(static_cast<int>(std::lround(rgb[0] * 31.0f / 255.0f)), 0, 31);
+        int const g = std::clamp(static_cast<int>(std::lround(rgb[1] * 63.0f / 255.0f)), 0, 63);
+        int const b = std::clamp(static_cast<int>(std::lround(rgb[2] * 31.0f / 255.0f)), 0, 31);
+        return {static_cast<uint16>(r << 11 | g << 5 | b),
+                {float(r << 3 | r >> 2), float(g << 2 | g >> 4), float(b << 3 | b >> 2)}};
+    }
+
+    auto makePaletteBC1(const Endpoint565& e0, const Endpoint565& e1, bool threeColour) -> Palette
+    {
+        Palette palette;
+        palette.size = threeColour ? 3 : 4;
+        for (int c = 0; c < 3; ++c)
+        {
+            palette.colours[0][c] = e0.rgb[c];
+            palette.colours[1][c] = e1.rgb[c];
+            if (threeColour)
+                palette.colours[2][c] = (e0.rgb[c] + e1.rgb[c]) / 2;
+            else
+            {
+                palette.colours[2][c] = (2 * e0.rgb[c] + e1.rgb[c]) / 3;
+                palette.colours[3][c] = (e0.rgb[c] + 2 * e1.rgb[c]) / 3;
+            }
+        }
+        return palette;
+    }
+
+    constexpr float PositionsBC1[4] = {0.0f, 1.0f, 1.0f / 3, 2.0f / 3};
+    constexpr float PositionsBC1ThreeColour[4] = {0.0f, 1.0f, 0.5f, 0.0f};
+
+    void encodeBC1(const Block& block, bool punchThrough, Quality quality, uint8* out)
+    {
+        float weights[16];
+        bool transparent[16];
+        bool anyTransparent = false, allTransparent = true;
+        for (int i = 0; i < 16; ++i)
+        {
+            transparent[i] = punchThrough && block.texels[3][i] < 128;
+            weights[i] = transparent[i] ? 0.0f : 1.0f;
+            anyTransparent |= transparent[i];
+            allTransparent &= transparent[i];
+        }
+
+        uint8 indices[16];
+        Endpoint565 a{}, b{};
+        if (allTransparent)
+            std::fill(indices, indices + 16, uint8(3));
+        else
+        {
+            // transparent texels need the three colour mode, where index 3 is transparent
+            bool const threeColour = anyTransparent;
+            float mean[4], axis[4], e0[4], e1[4];
+            principalAxis(block, 3, weights, mean, axis);
+            axisEndpoints(block, 3, weights, mean, axis, e0, e1);
+
+            float bestError = std::numeric_limits<float>::max();
+            for (int iteration = 0, count = iterationsFor(quality); iteration < count; ++iteration)
+            {
+                Endpoint565 const q0 = quantise565(e0), q1 = quantise565(e1);
+                uint8 candidate[16];
+                float const error = fitIndices(block, makePaletteBC1(q0, q1, threeColour), 3, weights, candidate);
+                if (error >= bestError)
+                    break;
+                bestError = error;
+                a = q0;
+                b = q1;
+                std::copy(candidate, candidate + 16, indices);
+                if (!leastSquares(block, 3, weights, indices, threeColour ? PositionsBC1ThreeColour : PositionsBC1, e0, e1))
+                    break;
+            }
+
+            // the endpoint order selects the mode
+            if (threeColour ? a.packed > b.packed : a.packed < b.packed)
+            {
+                std::swap(a, b);
+                for (auto& index : indices)
+                    index = threeColour ? (index < 2 ? 1 - index : index) : (index ^ 1);
+            }
+            else if (!threeColour && a.packed == b.packed)
+                std::fill(indices, indices + 16, uint8(0));
+
+            for (int i = 0; i < 16; ++i)
+                if (transparent[i])
+                    indices[i] = 3;
+        }
+
+        uint32 bits = 0;
+        for (int i = 0; i < 16; ++i)
+            bits |= uint32(indices[i]) << (2 * i);
+        out[0] = static_cast<uint8>(a.packed);
+        out[1] = static_cast<uint8>(a.packed >> 8);
+        out[2] = static_cast<uint8>(b.packed);
+        out[3] = static_cast<uint8>(b.packed >> 8);
+        for (int i = 0; i < 4; ++i)
+            out[4 + i] = static_cast<uint8>(bits >> (8 * i));
+    }
+    //---------------------------------------------------------------------
+    // BC4 single channel block, also the alpha of BC3 and both halves of BC5
+    auto fitBC4(const float values[16], int a0, int a1, uint8 indices[16]) -> float
+    {
+        float palette[8];
+        palette[0] = float(a0);
+        palette[1] = float(a1);
+        if (a0 > a1)
+        {
+            for (int i = 1; i <= 6; ++i)
+                palette[i + 1] = float((7 - i) * a0 + i * a1) / 7;
+        }
+        else
+        {
+            for (int i = 1; i <= 4; ++i)
+                palette[i + 1] = float((5 - i) * a0 + i * a1) / 5;
+            palette[6] = 0.0f;
+            palette[7] = 255.0f;
+        }
+
+        float total = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            float best = std::numeric_limits<float>::max();
+            for (int p = 0; p < 8; ++p)
+            {
+                float const d = values[i] - palette[p];
+                if (d * d < best)
+                {
+                    best = d * d;
+                    indices[i] = static_cast<uint8>(p);
+                }
+            }
+            total += best;
+        }
+        return total;
+    }
+
+    void encodeBC4(const float values[16], Quality quality, uint8* out)
+    {
+        int low = 255, high = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            low = std::min(low, static_cast<int>(values[i]));
+            high = std::max(high, static_cast<int>(values[i]));
+        }
+
+        int a0 = high, a1 = high;
+        uint8 indices[16] = {};
+        if (low != high)
+        {
+            // eight value mode, pulling the endpoints inwards can lower the error of the
+            // texels in between
+            int const reach = quality == Quality::FAST ? 0 : quality == Quality::NORMAL ? 1 : 4;
+            float bestError = std::numeric_limits<float>::max();
+            for (int d0 = 0; d0 <= reach; ++d0)
+            {
+                for (int d1 = 0; d1 <= reach; ++d1)
+                {
+                    if (high - d0 <= low + d1)
+                        continue;
+                    uint8 candidate[16];
+                    float const error = fitBC4(values, high - d0, low + d1, candidate);
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        a0 = high - d0;
+                        a1 = low + d1;
+                        std::copy(candidate, candidate + 16, indices);
+                    }
+                }
+            }
+
+            // six value mode has exact 0 and 255, which leaves the interpolated
+            // values for the texels in between
+            if (quality != Quality::FAST && (low == 0 || high == 255))
+            {
+                int innerLow = 255, innerHigh = 0;
+                for (int i = 0; i < 16; ++i)
+                {
+                    if (values[i] > 0 && values[i] < 255)
+                    {
+                        innerLow = std::min(innerLow, static_cast<int>(values[i]));
+                        innerHigh = std::max(innerHigh, static_cast<int>(values[i]));
+                    }
+                }
+                if (innerLow > innerHigh)
+                    innerLow = innerHigh = 0;
+
+                uint8 candidate[16];
+                float const error = fitBC4(values, innerLow, innerHigh, candidate);
+                if (error < bestError)
+                {
+                    a0 = innerLow;
+                    a1 = innerHigh;
+                    std::copy(candidate, candidate + 16, indices);
+                }
+            }
+        }
+
+        uint64 bits = 0;
+        for (int i = 0; i < 16; ++i)
+            bits |= uint64(indices[i]) << (3 * i);
+        out[0] = static_cast<uint8>(a0);
+        out[1] = static_cast<uint8>(a1);
+        for (int i = 0; i < 6; ++i)
+            out[2 + i] = static_cast<uint8>(bits >> (8 * i));
+    }
+    //---------------------------------------------------------------------
+    // BC7 in mode 6: one subset, 7 bit RGBA endpoints with a p-bit each, 4 bit indices
+    constexpr int WeightsBC7[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+    constexpr float PositionsBC7[16] = {
+        0 / 64.0f, 4 / 64.0f, 9 / 64.0f, 13 / 64.0f, 17 / 64.0f, 21 / 64.0f, 26 / 64.0f, 30 / 64.0f,
+        34 / 64.0f, 38 / 64.0f, 43 / 64.0f, 47 / 64.0f, 51 / 64.0f, 55 / 64.0f, 60 / 64.0f, 64 / 64.0f};
+
+    struct EndpointBC7
+    {
+        int quantised[4];
+        int pbit;
+        int value[4];
+    };
+
+    auto quantiseBC7(const float e[4], int pbit) -> EndpointBC7
+    {
+        EndpointBC7 endpoint;
+        endpoint.pbit = pbit;
+        for (int c = 0; c < 4; ++c)
+        {
+            endpoint.quantised[c] = std::clamp(static_cast<int>(std::lround((e[c] - pbit) / 2)), 0, 127);
+            endpoint.value[c] = endpoint.quantised[c] << 1 | pbit;
+        }
+        return endpoint;
+    }
+
+    auto quantiseBC7(const float e[4]) -> EndpointBC7
+    {
+        auto error = [&](const EndpointBC7& q)
+        {
+            float sum = 0;
+            for (int c = 0; c < 4; ++c)
+                sum += (q.value[c] - e[c]) * (q.value[c] - e[c]);
+            return sum;
+        };
+        EndpointBC7 const even = quantiseBC7(e, 0), odd = quantiseBC7(e, 1);
+        return error(even) <= error(odd) ? even : odd;
+    }
+
+    auto makePaletteBC7(const EndpointBC7& e0, const EndpointBC7& e1) -> Palette
+    {
+        Palette palette;
+        palette.size = 16;
+        for (int i = 0; i < 16; ++i)
+            for (int c = 0; c < 4; ++c)
+                palette.colours[i][c] = float(((64 - WeightsBC7[i]) * e0.value[c] + WeightsBC7[i] * e1.value[c] + 32) >> 6);
+        return palette;
+    }
+
+    struct BitWriter
+    {
+        uint8* out;
+        int position{0};
+
+        void write(uint32 value, int bits)
+        {
+            for (int i = 0; i < bits; ++i, ++position)
+                if (value >> i & 1)
+                    out[position >> 3] |= static_cast<uint8>(1 << (position & 7));
+        }
+    };
+
+    void encodeBC7(const Block& block, Quality quality, uint8* out)
+    {
+        float weights[16];
+        std::fill(weights, weights + 16, 1.0f);
+        float mean[4], axis[4], e0[4], e1[4];
+        principalAxis(block, 4, weights, mean, axis);
+        axisEndpoints(block, 4, weights, mean, axis, e0, e1);
+
+        EndpointBC7 a{}, b{};
+        uint8 indices[16] = {};
+        float bestError = std::numeric_limits<float>::max();
+        for (int iteration = 0, count = iterationsFor(quality); iteration < count; ++iteration)
+        {
+            // the best p-bit per endpoint is not always the best pair, high quality tries all
+            std::pair<EndpointBC7, EndpointBC7> candidates[4];
+            int numCandidates = 0;
+            if (quality == Quality::HIGH)
+            {
+                for (int p = 0; p < 4; ++p)
+                    candidates[numCandidates++] = {quantiseBC7(e0, p & 1), quantiseBC7(e1, p >> 1)};
+            }
+            else
+                candidates[numCandidates++] = {quantiseBC7(e0), quantiseBC7(e1)};
+
+            bool improved = false;
+            for (int i = 0; i < numCandidates; ++i)
+            {
+                uint8 candidate[16];
+                float const error = fitIndices(block, makePaletteBC7(candidates[i].first, candidates[i].second), 4, weights, candidate);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    a = candidates[i].first;
+                    b = candidates[i].second;
+                    std::copy(candidate, candidate + 16, indices);
+                    improved = true;
+                }
+            }
+            if (!improved || !leastSquares(block, 4, weights, indices, PositionsBC7, e0, e1))
+                break;
+        }
+
+        // the first index is stored without its top bit
+        if (indices[0] & 8)
+        {
+            std::swap(a, b);
+            for (auto& index : indices)
+                index = static_cast<uint8>(15 - index);
+        }
+
+        std::fill(out, out + 16, uint8(0));
+        BitWriter writer{out};
+        writer.write(1 << 6, 7);
+        for (int c = 0; c < 4; ++c)
+        {
+            writer.write(a.quantised[c], 7);
+            writer.write(b.quantised[c], 7);
+        }
+        writer.write(a.pbit, 1);
+        writer.write(b.pbit, 1);
+        writer.write(indices[0], 3);
+        for (int i = 1; i < 16; ++i)
+            writer.write(indices[i], 4);
+    }
+    //---------------------------------------------------------------------
+    auto blockBytes(PixelFormat format) -> size_t
+    {
+        return format == PixelFormat::DXT1 || format == PixelFormat::BC4_UNORM ? 8 : 16;
+    }
+
+    void encodeBlock(const Block& block, PixelFormat format, Quality quality, uint8* out)
+    {
+        using enum PixelFormat;
+        switch (format)
+        {
+        case DXT1:
+            encodeBC1(block, true, quality, out);
+            break;
+        case DXT5:
+            encodeBC4(block.texels[3], quality, out);
+            encodeBC1(block, false, quality, out + 8);
+            break;
+        case BC4_UNORM:
+            encodeBC4(block.texels[0], quality, out);
+            break;
+        case BC5_UNORM:
+            encodeBC4(block.texels[0], quality, out);
+            encodeBC4(block.texels[1], quality, out + 8);
+            break;
+        case BC7_UNORM:
+            encodeBC7(block, quality, out);
+            break;
+        default:
+            break;
+        }
+    }
+}
+    //---------------------------------------------------------------------
+    auto BlockCompressor::isSupported(PixelFormat format) -> bool
+    {
+        using enum PixelFormat;
+        switch (format)
+        {
+        case DXT1:
+        case DXT5:
+        case BC4_UNORM:
+        case BC5_UNORM:
+        case BC7_UNORM:
+            return true;
+        default:
+            return false;
+        }
+    }
+    //---------------------------------------------------------------------
+    void BlockCompressor::compress(const PixelBox& src, uchar* dst, PixelFormat format, Image::CompressionQuality quality)
+    {
+        uint32 const width = src.getWidth();
+        uint32 const height = src.getHeight();
+        uint32 const blocksX = (width + 3) / 4;
+        uint32 const blocksY = (height + 3) / 4;
+        size_t const bytes = blockBytes(format);
+
+        // each slice of a volume is compressed on its own
+        parallelForBands(blocksY * src.getDepth(), 4, [&](uint32 begin, uint32 end)
+        {
+            // four rows of texels in RGBA byte order
+            std::vector<uchar> rows(size_t(width) * 4 * 4);
+            Block block;
+            for (uint32 blockRow = begin; blockRow < end; ++blockRow)
+            {
+                uint32 const z = blockRow / blocksY;
+                uint32 const top = (blockRow % blocksY) * 4;
+                uint32 const rowCount = std::min(4u, height - top);
+                Box const extents{src.left, src.top + top, src.right, src.top + top + rowCount, src.front + z, src.front + z + 1};
+                PixelUtil::bulkPixelConversion(src.getSubVolume(extents),
+                                               PixelBox(width, rowCount, 1, PixelFormat::BYTE_RGBA, rows.data()));
+
+                uchar* out = dst + size_t(blockRow) * blocksX * bytes;
+                for (uint32 blockX = 0; blockX < blocksX; ++blockX, out += bytes)
+                {
+                    for (uint32 i = 0; i < 16; ++i)
+                    {
+                        uint32 const x = std::min(blockX * 4 + i % 4, width - 1);
+                        uint32 const y = std::min(i / 4, rowCount - 1);
+                        const uchar* texel = &rows[(size_t(y) * width + x) * 4];
+                        for (int c = 0; c < 4; ++c)
+                            block.texels[c][i] = texel[c];
+                    }
+                    encodeBlock(block, format, quality, out);
+                }
+            }
+        });
+    }
+}
@@ -0,0 +1,60 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module Ogre.Core:BlockCompression;
+
+import :Image;
+import :PixelFormat;
+import :Prerequisites;
+
+// internal to the Image implementation, used by OgreImage.cpp and
+// OgreBlockCompression.cpp only.
+namespace Ogre {
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Image
+    *  @{
+    */
+
+// CPU encoder for the BC1 (DXT1), BC3 (DXT5), BC4, BC5 and BC7 formats.
+//
+// Rows of blocks are encoded on all hardware threads. Endpoints come from the
+// principal axis of each block and are refined by least squares fitting as
+// the quality level allows, texels are matched to the palettes with SSE.
+struct BlockCompressor
+{
+    [[nodiscard]] static auto isSupported(PixelFormat format) -> bool;
+
+    // Encodes src, which may be in any accessible format, into consecutive blocks
+    // of the given format at dst. Partial blocks at the right and bottom edges
+    // repeat the last texel.
+    static void compress(const PixelBox& src, uchar* dst, PixelFormat format, Image::CompressionQuality quality);
+};
+    /** @} */
+    /** @} */
+}
@@ -0,0 +1,1577 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <emmintrin.h>
+#include <cstdlib>
+#include <cstring>
+
+module Ogre.Core;
+
+import :BlockDecompression;
+import :Exception;
+import :ParallelFor;
+import :PixelFormat;
+import :Prerequisites;
+
+import <algorithm>;
+import <bit>;
+import <vector>;
+
+namespace Ogre {
+namespace {
+    //---------------------------------------------------------------------
+    // 128 bits of a block, little endian
+    struct Bits128
+    {
+        uint64 lo;
+        uint64 hi;
+
+        [[nodiscard]] auto get(uint32 start, uint32 count) const -> uint32
+        {
+            if (count == 0 || start >= 128)
+                return 0;
+            uint64 value;
+            if (start >= 64)
+                value = hi >> (start - 64);
+            else if (start == 0)
+                value = lo;
+            else
+                value = (lo >> start) | (hi << (64 - start));
+            return static_cast<uint32>(value & ((uint64(1) << count) - 1));
+        }
+    };
+
+    auto load128(const uint8* block) -> Bits128
+    {
+        Bits128 bits;
+        memcpy(&bits.lo, block, 8);
+        memcpy(&bits.hi, block + 8, 8);
+        return bits;
+    }
+
+    struct BitReader
+    {
+        Bits128 bits;
+        uint32 position{0};
+
+        auto read(uint32 count) -> uint32
+        {
+            uint32 const value = bits.get(position, count);
+            position += count;
+            return value;
+        }
+    };
+
+    auto clampByte(int value) -> uint8
+    {
+        return static_cast<uint8>(std::clamp(value, 0, 255));
+    }
+
+    auto signExtend(int value, uint32 bits) -> int
+    {
+        int const shift = 32 - static_cast<int>(bits);
+        return static_cast<int>(static_cast<uint32>(value) << shift) >> shift;
+    }
+    //---------------------------------------------------------------------
+    // Blends endpoint pairs with a 0..64 weight per channel, four channels per texel.
+    // BC7 rounds straight to 8 bits, ASTC goes through its 16 bit intermediate
+    // (endpoints times 257) and keeps the top byte.
+    template<bool Astc>
+    void interpolate(const uint8* e0, const uint8* e1, const uint8* weights, uint32 count, uint8* out)
+    {
+        __m128i const zero = _mm_setzero_si128();
+        __m128i const full = _mm_set1_epi16(64);
+        __m128i const half = _mm_set1_epi32(32);
+        auto scale = [&](__m128i sum)
+        {
+            if constexpr (Astc)
+                return _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(sum, 8), sum), half), 14);
+            else
+                return _mm_srli_epi32(_mm_add_epi32(sum, half), 6);
+        };
+
+        uint32 i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128i const a = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(e0 + i * 4)), zero);
+            __m128i const b = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(e1 + i * 4)), zero);
+            __m128i const w = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(weights + i * 4)), zero);
+            __m128i const iw = _mm_sub_epi16(full, w);
+            __m128i const first = _mm_madd_epi16(_mm_unpacklo_epi16(a, b), _mm_unpacklo_epi16(iw, w));
+            __m128i const second = _mm_madd_epi16(_mm_unpackhi_epi16(a, b), _mm_unpackhi_epi16(iw, w));
+            __m128i const packed = _mm_packs_epi32(scale(first), scale(second));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i * 4), _mm_packus_epi16(packed, packed));
+        }
+        for (i *= 4; i < count * 4; ++i)
+        {
+            uint32 const sum = e0[i] * (64u - weights[i]) + e1[i] * uint32(weights[i]);
+            out[i] = static_cast<uint8>(Astc ? (sum * 257 + 32) >> 14 : (sum + 32) >> 6);
+        }
+    }
+    //---------------------------------------------------------------------
+    // BC1 colour block, also the colour half of BC2 and BC3. Only BC1 has the
+    // three colour mode with transparent black.
+    void decodeColour(const uint8* block, uint8* texels, bool threeColourMode)
+    {
+        uint32 const c0 = block[0] | block[1] << 8;
+        uint32 const c1 = block[2] | block[3] << 8;
+        uint8 palette[4][4];
+        auto expand = [](uint32 c, uint8* out)
+        {
+            uint32 const r = c >> 11, g = (c >> 5) & 63, b = c & 31;
+            out[0] = static_cast<uint8>(r << 3 | r >> 2);
+            out[1] = static_cast<uint8>(g << 2 | g >> 4);
+            out[2] = static_cast<uint8>(b << 3 | b >> 2);
+            out[3] = 255;
+        };
+        expand(c0, palette[0]);
+        expand(c1, palette[1]);
+        for (int c = 0; c < 3; ++c)
+        {
+            if (c0 > c1 || !threeColourMode)
+            {
+                palette[2][c] = static_cast<uint8>((2 * palette[0][c] + palette[1][c] + 1) / 3);
+                palette[3][c] = static_cast<uint8>((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+            }
+            else
+            {
+                palette[2][c] = static_cast<uint8>((palette[0][c] + palette[1][c] + 1) / 2);
+                palette[3][c] = 0;
+            }
+        }
+        palette[2][3] = 255;
+        palette[3][3] = c0 > c1 || !threeColourMode ? 255 : 0;
+
+        uint32 const indices = block[4] | block[5] << 8 | block[6] << 16 | uint32(block[7]) << 24;
+        for (uint32 i = 0; i < 16; ++i)
+        {
+            uint8* out = texels + i * 4;
+            uint8 const* colour = palette[(indices >> (2 * i)) & 3];
+            out[0] = colour[0];
+            out[1] = colour[1];
+            out[2] = colour[2];
+            if (threeColourMode)
+                out[3] = colour[3];
+        }
+    }
+
+    // BC4 block, the alpha of BC3 and both channels of BC5, written to one channel
+    void decodeChannel(const uint8* block, uint8* texels, uint32 channel, bool isSigned)
+    {
+        int a0 = block[0], a1 = block[1];
+        if (isSigned)
+        {
+            // -128 is an alias of -127
+            a0 = std::max(-127, static_cast<int>(static_cast<int8>(block[0])));
+            a1 = std::max(-127, static_cast<int>(static_cast<int8>(block[1])));
+        }
+
+        int palette[8] = {a0, a1};
+        if (a0 > a1)
+        {
+            for (int i = 1; i <= 6; ++i)
+                palette[i + 1] = ((7 - i) * a0 + i * a1 + (isSigned ? 0 : 3)) / 7;
+        }
+        else
+        {
+            for (int i = 1; i <= 4; ++i)
+                palette[i + 1] = ((5 - i) * a0 + i * a1 + (isSigned ? 0 : 2)) / 5;
+            palette[6] = isSigned ? -127 : 0;
+            palette[7] = isSigned ? 127 : 255;
+        }
+
+        uint64 indices = 0;
+        for (int i = 0; i < 6; ++i)
+            indices |= uint64(block[2 + i]) << (8 * i);
+        for (uint32 i = 0; i < 16; ++i)
+            texels[i * 4 + channel] = static_cast<uint8>(palette[(indices >> (3 * i)) & 7]);
+    }
+
+    void decodeBC1(const uint8* block, uint8* texels, uint32, uint32)
+    {
+        decodeColour(block, texels, true);
+    }
+
+    void decodeBC2(const uint8* block, uint8* texels, uint32, uint32)
+    {
+        decodeColour(block + 8, texels, false);
+        for (uint32 i = 0; i < 16; ++i)
+            texels[i * 4 + 3] = static_cast<uint8>(((block[i / 2] >> (4 * (i & 1))) & 0xF) * 17);
+    }
+
+    void decodeBC3(const uint8* block, uint8* texels, uint32, uint32)
+    {
+        decodeColour(block + 8, texels, false);
+        decodeChannel(block, texels, 3, false);
+    }
+
+    template<bool Signed, bool TwoChannels>
+    void decodeBC4BC5(const uint8* block, uint8* texels, uint32, uint32)
+    {
+        for (uint32 i = 0; i < 16; ++i)
+        {
+            texels[i * 4 + 1] = 0;
+            texels[i * 4 + 2] = 0;
+            texels[i * 4 + 3] = Signed ? 127 : 255;
+        }
+        decodeChannel(block, texels, 0, Signed);
+        if constexpr (TwoChannels)
+            decodeChannel(block + 8, texels, 1, Signed);
+    }
+    //---------------------------------------------------------------------
+    // BC7
+    struct BC7Mode
+    {
+        uint8 subsets;
+        uint8 partitionBits;
+        uint8 rotationBits;
+        uint8 indexSelectionBits;
+        uint8 colourBits;
+        uint8 alphaBits;
+        uint8 endpointPBits;
+        uint8 sharedPBits;
+        uint8 indexBits;
+        uint8 secondaryIndexBits;
+    };
+
+    constexpr BC7Mode BC7Modes[8] =
+    {
+        {3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+        {2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+        {3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+        {2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+        {1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+        {1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+        {1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+        {2, 6, 0, 0, 5, 5, 1, 0, 2, 0},
+    };
+
+    // bit i is the subset of texel i
+    constexpr uint16 BC7Partitions2[64] =
+    {
+        0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80, 0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+        0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE, 0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+        0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A, 0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+        0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C, 0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+    };
+
+    constexpr uint8 BC7Partitions3[64][16] =
+    {
+        {0,0,1,1,0,0,1,1,0,2,2,1,2,2,2,2}, {0,0,0,1,0,0,1,1,2,2,1,1,2,2,2,1}, {0,0,0,0,2,0,0,1,2,2,1,1,2,2,1,1}, {0,2,2,2,0,0,2,2,0,0,1,1,0,1,1,1},
+        {0,0,0,0,0,0,0,0,1,1,2,2,1,1,2,2}, {0,0,1,1,0,0,1,1,0,0,2,2,0,0,2,2}, {0,0,2,2,0,0,2,2,1,1,1,1,1,1,1,1}, {0,0,1,1,0,0,1,1,2,2,1,1,2,2,1,1},
+        {0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2}, {0,0,0,0,1,1,1,1,1,1,1,1,2,2,2,2}, {0,0,0,0,1,1,1,1,2,2,2,2,2,2,2,2}, {0,0,1,2,0,0,1,2,0,0,1,2,0,0,1,2},
+        {0,1,1,2,0,1,1,2,0,1,1,2,0,1,1,2}, {0,1,2,2,0,1,2,2,0,1,2,2,0,1,2,2}, {0,0,1,1,0,1,1,2,1,1,2,2,1,2,2,2}, {0,0,1,1,2,0,0,1,2,2,0,0,2,2,2,0},
+        {0,0,0,1,0,0,1,1,0,1,1,2,1,1,2,2}, {0,1,1,1,0,0,1,1,2,0,0,1,2,2,0,0}, {0,0,0,0,1,1,2,2,1,1,2,2,1,1,2,2}, {0,0,2,2,0,0,2,2,0,0,2,2,1,1,1,1},
+        {0,1,1,1,0,1,1,1,0,2,2,2,0,2,2,2}, {0,0,0,1,0,0,0,1,2,2,2,1,2,2,2,1}, {0,0,0,0,0,0,1,1,0,1,2,2,0,1,2,2}, {0,0,0,0,1,1,0,0,2,2,1,0,2,2,1,0},
+        {0,1,2,2,0,1,2,2,0,0,1,1,0,0,0,0}, {0,0,1,2,0,0,1,2,1,1,2,2,2,2,2,2}, {0,1,1,0,1,2,2,1,1,2,2,1,0,1,1,0}, {0,0,0,0,0,1,1,0,1,2,2,1,1,2,2,1},
+        {0,0,2,2,1,1,0,2,1,1,0,2,0,0,2,2}, {0,1,1,0,0,1,1,0,2,0,0,2,2,2,2,2}, {0,0,1,1,0,1,2,2,0,1,2,2,0,0,1,1}, {0,0,0,0,2,0,0,0,2,2,1,1,2,2,2,1},
+        {0,0,0,0,0,0,0,2,1,1,2,2,1,2,2,2}, {0,2,2,2,0,0,2,2,0,0,1,2,0,0,1,1}, {0,0,1,1,0,0,1,2,0,0,2,2,0,2,2,2}, {0,1,2,0,0,1,2,0,0,1,2,0,0,1,2,0},
+        {0,0,0,0,1,1,1,1,2,2,2,2,0,0,0,0}, {0,1,2,0,1,2,0,1,2,0,1,2,0,1,2,0}, {0,1,2,0,2,0,1,2,1,2,0,1,0,1,2,0}, {0,0,1,1,2,2,0,0,1,1,2,2,0,0,1,1},
+        {0,0,1,1,1,1,2,2,2,2,0,0,0,0,1,1}, {0,1,0,1,0,1,0,1,2,2,2,2,2,2,2,2}, {0,0,0,0,0,0,0,0,2,1,2,1,2,1,2,1}, {0,0,2,2,1,1,2,2,0,0,2,2,1,1,2,2},
+        {0,0,2,2,0,0,1,1,0,0,2,2,0,0,1,1}, {0,2,2,0,1,2,2,1,0,2,2,0,1,2,2,1}, {0,1,0,1,2,2,2,2,2,2,2,2,0,1,0,1}, {0,0,0,0,2,1,2,1,2,1,2,1,2,1,2,1},
+        {0,1,0,1,0,1,0,1,0,1,0,1,2,2,2,2}, {0,2,2,2,0,1,1,1,0,2,2,2,0,1,1,1}, {0,0,0,2,1,1,1,2,0,0,0,2,1,1,1,2}, {0,0,0,0,2,1,1,2,2,1,1,2,2,1,1,2},
+        {0,2,2,2,0,1,1,1,0,1,1,1,0,2,2,2}, {0,0,0,2,1,1,1,2,1,1,1,2,0,0,0,2}, {0,1,1,0,0,1,1,0,0,1,1,0,2,2,2,2}, {0,0,0,0,0,0,0,0,2,1,1,2,2,1,1,2},
+        {0,1,1,0,0,1,1,0,2,2,2,2,2,2,2,2}, {0,0,2,2,0,0,1,1,0,0,1,1,0,0,2,2}, {0,0,2,2,1,1,2,2,1,1,2,2,0,0,2,2}, {0,0,0,0,0,0,0,0,0,0,0,0,2,1,1,2},
+        {0,0,0,2,0,0,0,1,0,0,0,2,0,0,0,1}, {0,2,2,2,1,2,2,2,0,2,2,2,1,2,2,2}, {0,1,0,1,2,2,2,2,2,2,2,2,2,2,2,2}, {0,1,1,1,2,0,1,1,2,2,0,1,2,2,2,0},
+    };
+
+    constexpr uint8 BC7Anchors2[64] =
+    {
+        15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+        15, 2, 8, 2, 2, 8, 8,15, 2, 8, 2, 2, 8, 8, 2, 2,
+        15,15, 6, 8, 2, 8,15,15, 2, 8, 2, 2, 2,15,15, 6,
+         6, 2, 6, 8,15,15, 2, 2,15,15,15,15,15, 2, 2,15,
+    };
+
+    constexpr uint8 BC7Anchors3a[64] =
+    {
+         3, 3,15,15, 8, 3,15,15, 8, 8, 6, 6, 6, 5, 3, 3,
+         3, 3, 8,15, 3, 3, 6,10, 5, 8, 8, 6, 8, 5,15,15,
+         8,15, 3, 5, 6,10, 8,15,15, 3,15, 5,15,15,15,15,
+         3,15, 5, 5, 5, 8, 5,10, 5,10, 8,13,15,12, 3, 3,
+    };
+
+    constexpr uint8 BC7Anchors3b[64] =
+    {
+        15, 8, 8, 3,15,15, 3, 8,15,15,15,15,15,15,15, 8,
+        15, 8,15, 3,15, 8,15, 8, 3,15, 6,10,15,15,10, 8,
+        15, 3,15,10,10, 8, 9,10, 6,15, 8,15, 3, 6, 6, 8,
+        15, 3,15,15,15,15,15,15,15,15,15,15, 3,15,15, 8,
+    };
+
+    constexpr uint8 BC7Weights2[4] = {0, 21, 43, 64};
+    constexpr uint8 BC7Weights3[8] = {0, 9, 18, 27, 37, 46, 55, 64};
+    constexpr uint8 BC7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    auto bc7Weight(uint32 bits, uint32 index) -> uint8
+    {
+        return bits == 2 ? BC7Weights2[index] : bits == 3 ? BC7Weights3[index] : BC7Weights4[index];
+    }
+
+    auto bc7Subset(const BC7Mode& mode, uint32 partition, uint32 texel) -> uint32
+    {
+        if (mode.subsets == 2)
+            return (BC7Partitions2[partition] >> texel) & 1;
+        if (mode.subsets == 3)
+            return BC7Partitions3[partition][texel];
+        return 0;
+    }
+
+    auto bc7IsAnchor(const BC7Mode& mode, uint32 partition, uint32 texel) -> bool
+    {
+        if (texel == 0)
+            return true;
+        if (mode.subsets == 2)
+            return texel == BC7Anchors2[partition];
+        if (mode.subsets == 3)
+            return texel == BC7Anchors3a[partition] || texel == BC7Anchors3b[partition];
+        return false;
+    }
+
+    void decodeBC7(const uint8* block, uint8* texels, uint32, uint32)
+    {
+        BitReader reader{load128(block)};
+        uint32 modeIndex = 0;
+        while (modeIndex < 8 && reader.read(1) == 0)
+            ++modeIndex;
+        if (modeIndex == 8)
+        {
+            // reserved mode
+            memset(texels, 0, 16 * 4);
+            return;
+        }
+
+        BC7Mode const& mode = BC7Modes[modeIndex];
+        uint32 const partition = reader.read(mode.partitionBits);
+        uint32 const rotation = reader.read(mode.rotationBits);
+        uint32 const indexSelection = reader.read(mode.indexSelectionBits);
+
+        uint32 const endpointCount = mode.subsets * 2u;
+        uint8 endpoints[6][4];
+        for (uint32 c = 0; c < 3; ++c)
+            for (uint32 e = 0; e < endpointCount; ++e)
+                endpoints[e][c] = static_cast<uint8>(reader.read(mode.colourBits));
+        for (uint32 e = 0; e < endpointCount; ++e)
+            endpoints[e][3] = static_cast<uint8>(reader.read(mode.alphaBits));
+
+        uint32 pBits[6] = {};
+        if (mode.endpointPBits)
+            for (uint32 e = 0; e < endpointCount; ++e)
+                pBits[e] = reader.read(1);
+        if (mode.sharedPBits)
+            for (uint32 s = 0; s < mode.subsets; ++s)
+                pBits[s * 2] = pBits[s * 2 + 1] = reader.read(1);
+
+        bool const hasPBit = mode.endpointPBits || mode.sharedPBits;
+        for (uint32 e = 0; e < endpointCount; ++e)
+        {
+            for (uint32 c = 0; c < 4; ++c)
+            {
+                uint32 bits = c < 3 ? mode.colourBits : mode.alphaBits;
+                if (bits == 0)
+                {
+                    endpoints[e][c] = 255;
+                    continue;
+                }
+                uint32 value = endpoints[e][c];
+                if (hasPBit)
+                {
+                    value = value << 1 | pBits[e];
+                    ++bits;
+                }
+                value <<= 8 - bits;
+                endpoints[e][c] = static_cast<uint8>(value | value >> bits);
+            }
+        }
+
+        uint8 primary[16];
+        for (uint32 i = 0; i < 16; ++i)
+            primary[i] = static_cast<uint8>(reader.read(mode.indexBits - (bc7IsAnchor(mode, partition, i) ? 1 : 0)));
+        uint8 secondary[16] = {};
+        if (mode.secondaryIndexBits)
+            for (uint32 i = 0; i < 16; ++i)
+                secondary[i] = static_cast<uint8>(reader.read(mode.secondaryIndexBits - (i == 0 ? 1 : 0)));
+
+        alignas(16) uint8 e0[16 * 4];
+        alignas(16) uint8 e1[16 * 4];
+        alignas(16) uint8 weights[16 * 4];
+        for (uint32 i = 0; i < 16; ++i)
+        {
+            uint32 const subset = bc7Subset(mode, partition, i);
+            memcpy(e0 + i * 4, endpoints[subset * 2], 4);
+            memcpy(e1 + i * 4, endpoints[subset * 2 + 1], 4);
+            uint8 colourWeight = bc7Weight(mode.indexBits, primary[i]);
+            uint8 alphaWeight = colourWeight;
+            if (mode.secondaryIndexBits)
+            {
+                alphaWeight = bc7Weight(mode.secondaryIndexBits, secondary[i]);
+                if (indexSelection)
+                    std::swap(colourWeight, alphaWeight);
+            }
+            weights[i * 4 + 0] = weights[i * 4 + 1] = weights[i * 4 + 2] = colourWeight;
+            weights[i * 4 + 3] = alphaWeight;
+        }
+        interpolate<false>(e0, e1, weights, 16, texels);
+
+        if (rotation)
+            for (uint32 i = 0; i < 16; ++i)
+                std::swap(texels[i * 4 + 3], texels[i * 4 + rotation - 1]);
+    }
+    //---------------------------------------------------------------------
+    // BC6H
+    enum BC6HField : uint8 { RW, GW, BW, RX, GX, BX, RY, GY, BY, RZ, GZ, BZ, D };
+
+    // consecutive bits of one field in stream order, first > last for the reversed runs of the high
+    // precision modes
+    struct BC6HSegment
+    {
+        BC6HField field;
+        uint8 first;
+        uint8 last;
+    };
+
+    struct BC6HMode
+    {
+        uint8 modeValue;
+        uint8 modeBits;
+        uint8 subsets;
+        bool transformed;
+        uint8 endpointBits;
+        uint8 deltaBits[3];
+        BC6HSegment layout[24];
+    };
+
+    constexpr BC6HMode BC6HModes[14] =
+    {
+        {0x00, 2, 2, true, 10, {5, 5, 5}, {{GY,4,4},{BY,4,4},{BZ,4,4},{RW,0,9},{GW,0,9},{BW,0,9},{RX,0,4},{GZ,4,4},{GY,0,3},{GX,0,4},{BZ,0,0},{GZ,0,3},{BX,0,4},{BZ,1,1},{BY,0,3},{RY,0,4},{BZ,2,2},{RZ,0,4},{BZ,3,3},{D,0,4}}},
+        {0x01, 2, 2, true, 7, {6, 6, 6}, {{GY,5,5},{GZ,4,4},{GZ,5,5},{RW,0,6},{BZ,0,0},{BZ,1,1},{BY,4,4},{GW,0,6},{BY,5,5},{BZ,2,2},{GY,4,4},{BW,0,6},{BZ,3,3},{BZ,5,5},{BZ,4,4},{RX,0,5},{GY,0,3},{GX,0,5},{GZ,0,3},{BX,0,5},{BY,0,3},{RY,0,5},{RZ,0,5},{D,0,4}}},
+        {0x02, 5, 2, true, 11, {5, 4, 4}, {{RW,0,9},{GW,0,9},{BW,0,9},{RX,0,4},{RW,10,10},{GY,0,3},{GX,0,3},{GW,10,10},{BZ,0,0},{GZ,0,3},{BX,0,3},{BW,10,10},{BZ,1,1},{BY,0,3},{RY,0,4},{BZ,2,2},{RZ,0,4},{BZ,3,3},{D,0,4}}},
+        {0x06, 5, 2, true, 11, {4, 5, 4}, {{RW,0,9},{GW,0,9},{BW,0,9},{RX,0,3},{RW,10,10},{GZ,4,4},{GY,0,3},{GX,0,4},{GW,10,10},{GZ,0,3},{BX,0,3},{BW,10,10},{BZ,1,1},{BY,0,3},{RY,0,3},{BZ,0,0},{BZ,2,2},{RZ,0,3},{GY,4,4},{BZ,3,3},{D,0,4}}},
+        {0x0A, 5, 2, true, 11, {4, 4, 5}, {{RW,0,9},{GW,0,9},{BW,0,9},{RX,0,3},{RW,10,10},{BY,4,4},{GY,0,3},{GX,0,3},{GW,10,10},{BZ,0,0},{GZ,0,3},{BX,0,4},{BW,10,10},{BY,0,3},{RY,0,3},{BZ,1,1},{BZ,2,2},{RZ,0,3},{BZ,4,4},{BZ,3,3},{D,0,4}}},
+        {0x0E, 5, 2, true, 9, {5, 5, 5}, {{RW,0,8},{BY,4,4},{GW,0,8},{GY,4,4},{BW,0,8},{BZ,4,4},{RX,0,4},{GZ,4,4},{GY,0,3},{GX,0,4},{BZ,0,0},{GZ,0,3},{BX,0,4},{BZ,1,1},{BY,0,3},{RY,0,4},{BZ,2,2},{RZ,0,4},{BZ,3,3},{D,0,4}}},
+        {0x12, 5, 2, true, 8, {6, 5, 5}, {{RW,0,7},{GZ,4,4},{BY,4,4},{GW,0,7},{BZ,2,2},{GY,4,4},{BW,0,7},{BZ,3,3},{BZ,4,4},{RX,0,5},{GY,0,3},{GX,0,4},{BZ,0,0},{GZ,0,3},{BX,0,4},{BZ,1,1},{BY,0,3},{RY,0,5},{RZ,0,5},{D,0,4}}},
+        {0x16, 5, 2, true, 8, {5, 6, 5}, {{RW,0,7},{BZ,0,0},{BY,4,4},{GW,0,7},{GY,5,5},{GY,4,4},{BW,0,7},{GZ,5,5},{BZ,4,4},{RX,0,4},{GZ,4,4},{GY,0,3},{GX,0,5},{GZ,0,3},{BX,0,4},{BZ,1,1},{BY,0,3},{RY,0,4},{BZ,2,2},{RZ,0,4},{BZ,3,3},{D,0,4}}},
+        {0x1A, 5, 2, true, 8, {5, 5, 6}, {{RW,0,7},{BZ,1,1},{BY,4,4},{GW,0,7},{BY,5,5},{GY,4,4},{BW,0,7},{BZ,5,5},{BZ,4,4},{RX,0,4},{GZ,4,4},{GY,0,3},{GX,0,4},{BZ,0,0},{GZ,0,3},{BX,0,5},{BY,0,3},{RY,0,4},{BZ,2,2},{RZ,0,4},{BZ,3,3},{D,0,4}}},
+        {0x1E, 5, 2, false, 6, {6, 6, 6}, {{RW,0,5},{GZ,4,4},{BZ,0,0},{BZ,1,1},{BY,4,4},{GW,0,5},{GY,5,5},{BY,5,5},{BZ,2,2},{GY,4,4},{BW,0,5},{GZ,5,5},{BZ,3,3},{BZ,5,5},{BZ,4,4},{RX,0,5},{GY,0,3},{GX,0,5},{GZ,0,3},{BX,0,5},{BY,0,3},{RY,0,5},{RZ,0,5},{D,0,4}}},
+        {0x03, 5, 1, false, 10, {10, 10, 10}, {{RW,0,9},{GW,0,9},{BW,0,9},{RX,0,9},{GX,0,9},{BX,0,9}}},
+        {0x07, 5, 1, true, 11, {9, 9, 9}, {{RW,0,9},{GW,0,9},{BW,0,9},{RX,0,8},{RW,10,10},{GX,0,8},{GW,10,10},{BX,0,8},{BW,10,10}}},
+        {0x0B, 5, 1, true, 12, {8, 8, 8}, {{RW,0,9},{GW,0,9},{BW,0,9},{RX,0,7},{RW,11,10},{GX,0,7},{GW,11,10},{BX,0,7},{BW,11,10}}},
+        {0x0F, 5, 1, true, 16, {4, 4, 4}, {{RW,0,9},{GW,0,9},{BW,0,9},{RX,0,3},{RW,15,10},{GX,0,3},{GW,15,10},{BX,0,3},{BW,15,10}}},
+    };
+
+    auto bc6hUnquantise(int value, uint32 bits, bool isSigned) -> int
+    {
+        if (!isSigned)
+        {
+            if (bits >= 15 || value == 0)
+                return value;
+            if (value == (1 << bits) - 1)
+                return 0xFFFF;
+            return ((value << 16) + 0x8000) >> bits;
+        }
+
+        if (bits >= 16 || value == 0)
+            return value;
+        int const magnitude = std::abs(value);
+        int const unquantised = magnitude >= (1 << (bits - 1)) - 1
+            ? 0x7FFF
+            : ((magnitude << 15) + 0x4000) >> (bits - 1);
+        return value < 0 ? -unquantised : unquantised;
+    }
+
+    auto bc6hFinish(int value, bool isSigned) -> uint16
+    {
+        if (!isSigned)
+            return static_cast<uint16>((value * 31) >> 6);
+        return value < 0
+            ? static_cast<uint16>(0x8000 | (((-value) * 31) >> 5))
+            : static_cast<uint16>((value * 31) >> 5);
+    }
+
+    template<bool Signed>
+    void decodeBC6H(const uint8* block, uint8* texels, uint32, uint32)
+    {
+        Bits128 const bits = load128(block);
+        uint32 modeValue = bits.get(0, 2);
+        if (modeValue > 1)
+            modeValue = bits.get(0, 5);
+
+        BC6HMode const* mode = nullptr;
+        for (BC6HMode const& candidate : BC6HModes)
+            if (candidate.modeValue == modeValue)
+                mode = &candidate;
+        if (!mode)
+        {
+            // reserved mode, black
+            memset(texels, 0, 16 * 8);
+            return;
+        }
+
+        // the header is 82 bits with two subsets and 65 with one, the indices follow
+        uint32 const headerBits = mode->subsets == 2 ? 82 : 65;
+        int fields[D + 1] = {};
+        uint32 position = mode->modeBits;
+        for (BC6HSegment const& segment : mode->layout)
+        {
+            if (position >= headerBits)
+                break;
+            int const step = segment.first <= segment.last ? 1 : -1;
+            for (int bit = segment.first; ; bit += step)
+            {
+                fields[segment.field] |= static_cast<int>(bits.get(position++, 1)) << bit;
+                if (bit == segment.last)
+                    break;
+            }
+        }
+
+        uint32 const precision = mode->endpointBits;
+        uint32 const endpointCount = mode->subsets * 2u;
+        int endpoints[4][3];
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            for (uint32 e = 0; e < endpointCount; ++e)
+                endpoints[e][c] = fields[e * 3 + c];
+
+            if (Signed)
+                endpoints[0][c] = signExtend(endpoints[0][c], precision);
+            for (uint32 e = 1; e < endpointCount; ++e)
+            {
+                if (mode->transformed)
+                {
+                    int const delta = signExtend(endpoints[e][c], mode->deltaBits[c]);
+                    endpoints[e][c] = (endpoints[0][c] + delta) & ((1 << precision) - 1);
+                }
+                if (Signed)
+                    endpoints[e][c] = signExtend(endpoints[e][c], precision);
+            }
+            for (uint32 e = 0; e < endpointCount; ++e)
+                endpoints[e][c] = bc6hUnquantise(endpoints[e][c], precision, Signed);
+        }
+
+        uint32 const partition = static_cast<uint32>(fields[D]);
+        uint32 const indexBits = mode->subsets == 2 ? 3 : 4;
+        position = headerBits;
+        for (uint32 i = 0; i < 16; ++i)
+        {
+            bool const anchor = i == 0 || (mode->subsets == 2 && i == BC7Anchors2[partition]);
+            uint32 const count = indexBits - (anchor ? 1 : 0);
+            uint32 const index = bits.get(position, count);
+            position += count;
+
+            uint32 const subset = mode->subsets == 2 ? (BC7Partitions2[partition] >> i) & 1 : 0;
+            int const weight = indexBits == 3 ? BC7Weights3[index] : BC7Weights4[index];
+            uint16 texel[4];
+            for (uint32 c = 0; c < 3; ++c)
+            {
+                int const value = (endpoints[subset * 2][c] * (64 - weight) + endpoints[subset * 2 + 1][c] * weight + 32) >> 6;
+                texel[c] = bc6hFinish(value, Signed);
+            }
+            texel[3] = 0x3C00;
+            memcpy(texels + i * 8, texel, 8);
+        }
+    }
+    //---------------------------------------------------------------------
+    // ETC1, ETC2 and EAC, 64 bit big endian blocks
+    auto loadBigEndian64(const uint8* block) -> uint64
+    {
+        uint64 value = 0;
+        for (int i = 0; i < 8; ++i)
+            value = value << 8 | block[i];
+        return value;
+    }
+
+    auto field(uint64 bits, uint32 high, uint32 low) -> int
+    {
+        return static_cast<int>((bits >> low) & ((uint64(1) << (high - low + 1)) - 1));
+    }
+
+    constexpr int ETCModifiers[8][2] =
+    {
+        {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183},
+    };
+
+    constexpr int ETCDistances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+    // texels are stored column major in ETC, the index of texel (x, y) is at bit x * 4 + y
+    auto etcIndex(uint64 bits, uint32 x, uint32 y) -> uint32
+    {
+        uint32 const i = x * 4 + y;
+        return static_cast<uint32>(((bits >> (i + 16)) & 1) << 1 | ((bits >> i) & 1));
+    }
+
+    void writeTexel(uint8* texels, uint32 x, uint32 y, int r, int g, int b, uint8 alpha = 255)
+    {
+        uint8* out = texels + (y * 4 + x) * 4;
+        out[0] = clampByte(r);
+        out[1] = clampByte(g);
+        out[2] = clampByte(b);
+        out[3] = alpha;
+    }
+
+    void decodeETCPaint(uint64 bits, uint8* texels, int const (&paint)[4][3], bool punchThrough)
+    {
+        for (uint32 y = 0; y < 4; ++y)
+            for (uint32 x = 0; x < 4; ++x)
+            {
+                uint32 const index = etcIndex(bits, x, y);
+                if (punchThrough && index == 2)
+                    writeTexel(texels, x, y, 0, 0, 0, 0);
+                else
+                    writeTexel(texels, x, y, paint[index][0], paint[index][1], paint[index][2]);
+            }
+    }
+
+    void decodeETCPlanar(uint64 bits, uint8* texels)
+    {
+        auto expand6 = [](int v) { return v << 2 | v >> 4; };
+        auto expand7 = [](int v) { return v << 1 | v >> 6; };
+        int const origin[3] =
+        {
+            expand6(field(bits, 62, 57)),
+            expand7(field(bits, 56, 56) << 6 | field(bits, 54, 49)),
+            expand6(field(bits, 48, 48) << 5 | field(bits, 44, 43) << 3 | field(bits, 41, 39)),
+        };
+        int const horizontal[3] =
+        {
+            expand6(field(bits, 38, 34) << 1 | field(bits, 32, 32)),
+            expand7(field(bits, 31, 25)),
+            expand6(field(bits, 24, 19)),
+        };
+        int const vertical[3] =
+        {
+            expand6(field(bits, 18, 13)),
+            expand7(field(bits, 12, 6)),
+            expand6(field(bits, 5, 0)),
+        };
+        for (int y = 0; y < 4; ++y)
+            for (int x = 0; x < 4; ++x)
+            {
+                int colour[3];
+                for (int c = 0; c < 3; ++c)
+                    colour[c] = (x * (horizontal[c] - origin[c]) + y * (vertical[c] - origin[c]) + 4 * origin[c] + 2) >> 2;
+                writeTexel(texels, x, y, colour[0], colour[1], colour[2]);
+            }
+    }
+
+    // ETC2 adds the T, H and planar modes to ETC1, encoded as overflowing differential colours.
+    // For RGB8A1 the differential bit is the opaque flag instead.
+    void decodeETCColour(const uint8* block, uint8* texels, bool etc2, bool punchThroughAlpha)
+    {
+        uint64 const bits = loadBigEndian64(block);
+        bool const differential = punchThroughAlpha || field(bits, 33, 33);
+        bool const punchThrough = punchThroughAlpha && !field(bits, 33, 33);
+        bool const flip = field(bits, 32, 32);
+
+        int base[2][3];
+        if (!differential)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                base[0][c] = field(bits, 63 - c * 8, 60 - c * 8) * 17;
+                base[1][c] = field(bits, 59 - c * 8, 56 - c * 8) * 17;
+            }
+        }
+        else
+        {
+            int colour[3], delta[3];
+            for (int c = 0; c < 3; ++c)
+            {
+                colour[c] = field(bits, 63 - c * 8, 59 - c * 8);
+                delta[c] = signExtend(field(bits, 58 - c * 8, 56 - c * 8), 3);
+            }
+
+            auto overflows = [&](int c) { return colour[c] + delta[c] < 0 || colour[c] + delta[c] > 31; };
+            if (etc2 && overflows(0))
+            {
+                // T mode
+                int const c1[3] = {(field(bits, 60, 59) << 2 | field(bits, 57, 56)) * 17, field(bits, 55, 52) * 17, field(bits, 51, 48) * 17};
+                int const c2[3] = {field(bits, 47, 44) * 17, field(bits, 43, 40) * 17, field(bits, 39, 36) * 17};
+                int const d = ETCDistances[field(bits, 35, 34) << 1 | field(bits, 32, 32)];
+                int const paint[4][3] =
+                {
+                    {c1[0], c1[1], c1[2]},
+                    {c2[0] + d, c2[1] + d, c2[2] + d},
+                    {c2[0], c2[1], c2[2]},
+                    {c2[0] - d, c2[1] - d, c2[2] - d},
+                };
+                decodeETCPaint(bits, texels, paint, punchThrough);
+                return;
+            }
+            if (etc2 && overflows(1))
+            {
+                // H mode
+                int const r1 = field(bits, 62, 59), g1 = field(bits, 58, 56) << 1 | field(bits, 52, 52);
+                int const b1 = field(bits, 51, 51) << 3 | field(bits, 49, 47);
+                int const r2 = field(bits, 46, 43), g2 = field(bits, 42, 39), b2 = field(bits, 38, 35);
+                int const order = (r1 << 8 | g1 << 4 | b1) >= (r2 << 8 | g2 << 4 | b2) ? 1 : 0;
+                int const d = ETCDistances[field(bits, 34, 34) << 2 | field(bits, 32, 32) << 1 | order];
+                int const paint[4][3] =
+                {
+                    {r1 * 17 + d, g1 * 17 + d, b1 * 17 + d},
+                    {r1 * 17 - d, g1 * 17 - d, b1 * 17 - d},
+                    {r2 * 17 + d, g2 * 17 + d, b2 * 17 + d},
+                    {r2 * 17 - d, g2 * 17 - d, b2 * 17 - d},
+                };
+                decodeETCPaint(bits, texels, paint, punchThrough);
+                return;
+            }
+            if (etc2 && overflows(2))
+            {
+                decodeETCPlanar(bits, texels);
+                return;
+            }
+
+            for (int c = 0; c < 3; ++c)
+            {
+                base[0][c] = colour[c] << 3 | colour[c] >> 2;
+                int const second = colour[c] + delta[c];
+                base[1][c] = second << 3 | second >> 2;
+            }
+        }
+
+        int const tables[2] = {field(bits, 39, 37), field(bits, 36, 34)};
+        for (uint32 y = 0; y < 4; ++y)
+            for (uint32 x = 0; x < 4; ++x)
+            {
+                uint32 const subBlock = flip ? (y >= 2) : (x >= 2);
+                uint32 const index = etcIndex(bits, x, y);
+                if (punchThrough && index == 2)
+                {
+                    writeTexel(texels, x, y, 0, 0, 0, 0);
+                    continue;
+                }
+                int modifier = ETCModifiers[tables[subBlock]][index & 1];
+                if (punchThrough && (index & 1) == 0)
+                    modifier = 0;
+                if (index & 2)
+                    modifier = -modifier;
+                int const* colour = base[subBlock];
+                writeTexel(texels, x, y, colour[0] + modifier, colour[1] + modifier, colour[2] + modifier);
+            }
+    }
+
+    constexpr int EACModifiers[16][8] =
+    {
+        {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12}, {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10}, {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9}, {-2, -5, -8, -10, 1, 4, 7, 9}, {-2, -4, -8, -10, 1, 3, 7, 9}, {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9}, {-1, -2, -3, -10, 0, 1, 2, 9}, {-4, -6, -8, -9, 3, 5, 7, 8}, {-3, -5, -7, -9, 2, 4, 6, 8},
+    };
+
+    void decodeEACAlpha(const uint8* block, uint8* texels)
+    {
+        uint64 const bits = loadBigEndian64(block);
+        int const base = field(bits, 63, 56);
+        int const multiplier = field(bits, 55, 52);
+        int const* modifiers = EACModifiers[field(bits, 51, 48)];
+        for (uint32 y = 0; y < 4; ++y)
+            for (uint32 x = 0; x < 4; ++x)
+            {
+                uint32 const i = x * 4 + y;
+                int const index = field(bits, 47 - i * 3, 45 - i * 3);
+                texels[(y * 4 + x) * 4 + 3] = clampByte(base + modifiers[index] * multiplier);
+            }
+    }
+
+    void decodeETC1(const uint8* block, uint8* texels, uint32, uint32)
+    {
+        decodeETCColour(block, texels, false, false);
+    }
+
+    void decodeETC2(const uint8* block, uint8* texels, uint32, uint32)
+    {
+        decodeETCColour(block, texels, true, false);
+    }
+
+    void decodeETC2A1(const uint8* block, uint8* texels, uint32, uint32)
+    {
+        decodeETCColour(block, texels, true, true);
+    }
+
+    void decodeETC2RGBA(const uint8* block, uint8* texels, uint32, uint32)
+    {
+        decodeETCColour(block + 8, texels, true, false);
+        decodeEACAlpha(block, texels);
+    }
+    //---------------------------------------------------------------------
+    // ASTC, LDR profile and 2D blocks only
+    constexpr uint8 ASTCErrorColour[4] = {255, 0, 255, 255};
+
+    void fillASTC(uint8* texels, uint32 count, const uint8* colour)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            memcpy(texels + i * 4, colour, 4);
+    }
+
+    // number of values of the quantisation levels, in the order they are encoded
+    constexpr uint16 ASTCRanges[21] = {2, 3, 4, 5, 6, 8, 10, 12, 16, 20, 24, 32, 40, 48, 64, 80, 96, 128, 160, 192, 256};
+
+    struct ASTCRange
+    {
+        uint32 bits;
+        uint32 trits;
+        uint32 quints;
+    };
+
+    auto getASTCRange(uint32 range) -> ASTCRange
+    {
+        if (range % 3 == 0)
+            return {static_cast<uint32>(std::countr_zero(range / 3)), 1, 0};
+        if (range % 5 == 0)
+            return {static_cast<uint32>(std::countr_zero(range / 5)), 0, 1};
+        return {static_cast<uint32>(std::countr_zero(range)), 0, 0};
+    }
+
+    auto getISEBitCount(uint32 count, uint32 range) -> uint32
+    {
+        ASTCRange const r = getASTCRange(range);
+        uint32 const bits = count * r.bits;
+        if (r.trits)
+            return bits + (count * 8 + 4) / 5;
+        if (r.quints)
+            return bits + (count * 7 + 2) / 3;
+        return bits;
+    }
+
+    // Reads count integers of the given range from bits [start, end) of the block, bits past the
+    // end of the sequence read as zero.
+    void decodeISE(const Bits128& bits, uint32 start, uint32 end, uint32 count, uint32 range, uint8* out)
+    {
+        ASTCRange const r = getASTCRange(range);
+        uint32 position = start;
+        auto read = [&](uint32 n) -> uint32
+        {
+            uint32 value = 0;
+            if (position < end)
+                value = bits.get(position, std::min(n, end - position));
+            position += n;
+            return value;
+        };
+
+        if (r.trits)
+        {
+            for (uint32 i = 0; i < count; i += 5)
+            {
+                uint32 m[5], t[5];
+                m[0] = read(r.bits); uint32 T = read(2);
+                m[1] = read(r.bits); T |= read(2) << 2;
+                m[2] = read(r.bits); T |= read(1) << 4;
+                m[3] = read(r.bits); T |= read(2) << 5;
+                m[4] = read(r.bits); T |= read(1) << 7;
+
+                uint32 C;
+                if (((T >> 2) & 7) == 7)
+                {
+                    C = (T >> 5) << 2 | (T & 3);
+                    t[4] = 2;
+                    t[3] = 2;
+                }
+                else
+                {
+                    C = T & 0x1F;
+                    if (((T >> 5) & 3) == 3)
+                    {
+                        t[4] = 2;
+                        t[3] = T >> 7;
+                    }
+                    else
+                    {
+                        t[4] = T >> 7;
+                        t[3] = (T >> 5) & 3;
+                    }
+                }
+                if ((C & 3) == 3)
+                {
+                    t[2] = 2;
+                    t[1] = C >> 4;
+                    t[0] = ((C >> 3) & 1) << 1 | ((C >> 2) & 1 & ~(C >> 3));
+                }
+                else if (((C >> 2) & 3) == 3)
+                {
+                    t[2] = 2;
+                    t[1] = 2;
+                    t[0] = C & 3;
+                }
+                else
+                {
+                    t[2] = C >> 4;
+                    t[1] = (C >> 2) & 3;
+                    t[0] = ((C >> 1) & 1) << 1 | (C & 1 & ~(C >> 1));
+                }
+                for (uint32 j = 0; j < 5 && i + j < count; ++j)
+                    out[i + j] = static_cast<uint8>(t[j] << r.bits | m[j]);
+            }
+        }
+        else if (r.quints)
+        {
+            for (uint32 i = 0; i < count; i += 3)
+            {
+                uint32 m[3], q[3];
+                m[0] = read(r.bits); uint32 Q = read(3);
+                m[1] = read(r.bits); Q |= read(2) << 3;
+                m[2] = read(r.bits); Q |= read(2) << 5;
+
+                if (((Q >> 1) & 3) == 3 && ((Q >> 5) & 3) == 0)
+                {
+                    q[2] = (Q & 1) << 2 | ((Q >> 4) & 1 & ~Q) << 1 | ((Q >> 3) & 1 & ~Q);
+                    q[1] = 4;
+                    q[0] = 4;
+                }
+                else
+                {
+                    uint32 C;
+                    if (((Q >> 1) & 3) == 3)
+                    {
+                        q[2] = 4;
+                        C = ((Q >> 3) & 3) << 3 | (~(Q >> 5) & 3) << 1 | (Q & 1);
+                    }
+                    else
+                    {
+                        q[2] = (Q >> 5) & 3;
+                        C = Q & 0x1F;
+                    }
+                    if ((C & 7) == 5)
+                    {
+                        q[1] = 4;
+                        q[0] = (C >> 3) & 3;
+                    }
+                    else
+                    {
+                        q[1] = (C >> 3) & 3;
+                        q[0] = C & 7;
+                    }
+                }
+                for (uint32 j = 0; j < 3 && i + j < count; ++j)
+                    out[i + j] = static_cast<uint8>(q[j] << r.bits | m[j]);
+            }
+        }
+        else
+        {
+            for (uint32 i = 0; i < count; ++i)
+                out[i] = static_cast<uint8>(read(r.bits));
+        }
+    }
+
+    // replicates the low bits of value up to the given width
+    auto replicate(uint32 value, uint32 bits, uint32 width) -> uint32
+    {
+        if (bits == 0)
+            return 0;
+        uint32 result = 0;
+        int shift = static_cast<int>(width) - static_cast<int>(bits);
+        for (; shift > -static_cast<int>(bits); shift -= static_cast<int>(bits))
+            result |= shift >= 0 ? value << shift : value >> -shift;
+        return result & ((1u << width) - 1);
+    }
+
+    auto unquantiseColour(uint32 value, uint32 range) -> uint8
+    {
+        ASTCRange const r = getASTCRange(range);
+        if (!r.trits && !r.quints)
+            return static_cast<uint8>(replicate(value, r.bits, 8));
+
+        uint32 const m = value & ((1u << r.bits) - 1);
+        uint32 const D = value >> r.bits;
+        uint32 const A = (m & 1) ? 0x1FF : 0;
+        uint32 const b = (m >> 1) & 1, c = (m >> 2) & 1;
+        uint32 const x = m >> 1;
+        uint32 B = 0, C = 0;
+        if (r.trits)
+        {
+            switch (r.bits)
+            {
+            case 1: C = 204; break;
+            case 2: C = 93; B = b * 0x116; break;
+            case 3: C = 44; B = c * 0x10A + b * 0x85; break;
+            case 4: C = 22; B = x << 6 | x; break;
+            case 5: C = 11; B = x << 5 | x >> 2; break;
+            case 6: C = 5; B = x << 4 | x >> 4; break;
+            }
+        }
+        else
+        {
+            switch (r.bits)
+            {
+            case 1: C = 113; break;
+            case 2: C = 54; B = b * 0x10C; break;
+            case 3: C = 26; B = c * 0x105 + b * 0x82; break;
+            case 4: C = 13; B = x << 6 | x >> 1; break;
+            case 5: C = 6; B = x << 5 | x >> 3; break;
+            case 6: C = 3; B = x << 4; break;
+            }
+        }
+        uint32 T = D * C + B;
+        T ^= A;
+        return static_cast<uint8>((A & 0x80) | (T >> 2));
+    }
+
+    auto unquantiseWeight(uint32 value, uint32 range) -> uint8
+    {
+        ASTCRange const r = getASTCRange(range);
+        uint32 result;
+        if (!r.trits && !r.quints)
+            result = replicate(value, r.bits, 6);
+        else if (r.bits == 0)
+            return static_cast<uint8>(r.trits ? value * 32 : value * 16);
+        else
+        {
+            uint32 const m = value & ((1u << r.bits) - 1);
+            uint32 const D = value >> r.bits;
+            uint32 const A = (m & 1) ? 0x7F : 0;
+            uint32 const b = (m >> 1) & 1;
+            uint32 B = 0, C = 0;
+            if (r.trits)
+            {
+                switch (r.bits)
+                {
+                case 1: C = 50; break;
+                case 2: C = 23; B = b * 0x45; break;
+                case 3: C = 11; B = ((m >> 1) & 3) << 5 | ((m >> 1) & 3); break;
+                }
+            }
+            else
+            {
+                switch (r.bits)
+                {
+                case 1: C = 28; break;
+                case 2: C = 13; B = b * 0x42; break;
+                }
+            }
+            uint32 T = D * C + B;
+            T ^= A;
+            result = (A & 0x20) | (T >> 2);
+        }
+        return static_cast<uint8>(result > 32 ? result + 1 : result);
+    }
+
+    void bitTransferSigned(int& a, int& b)
+    {
+        b >>= 1;
+        b |= a & 0x80;
+        a >>= 1;
+        a &= 0x3F;
+        if (a & 0x20)
+            a -= 0x40;
+    }
+
+    void setEndpoint(uint8* out, int r, int g, int b, int a)
+    {
+        out[0] = clampByte(r);
+        out[1] = clampByte(g);
+        out[2] = clampByte(b);
+        out[3] = clampByte(a);
+    }
+
+    void setBlueContracted(uint8* out, int r, int g, int b, int a)
+    {
+        setEndpoint(out, (r + b) >> 1, (g + b) >> 1, b, a);
+    }
+
+    // returns false for the HDR endpoint modes
+    auto decodeEndpoints(uint32 mode, const uint8* values, uint8* e0, uint8* e1) -> bool
+    {
+        int v[8];
+        for (uint32 i = 0; i < 2 * ((mode >> 2) + 1); ++i)
+            v[i] = values[i];
+
+        switch (mode)
+        {
+        case 0:
+            setEndpoint(e0, v[0], v[0], v[0], 255);
+            setEndpoint(e1, v[1], v[1], v[1], 255);
+            return true;
+        case 1:
+        {
+            int const l0 = (v[0] >> 2) | (v[1] & 0xC0);
+            int const l1 = std::min(l0 + (v[1] & 0x3F), 255);
+            setEndpoint(e0, l0, l0, l0, 255);
+            setEndpoint(e1, l1, l1, l1, 255);
+            return true;
+        }
+        case 4:
+            setEndpoint(e0, v[0], v[0], v[0], v[2]);
+            setEndpoint(e1, v[1], v[1], v[1], v[3]);
+            return true;
+        case 5:
+            bitTransferSigned(v[1], v[0]);
+            bitTransferSigned(v[3], v[2]);
+            setEndpoint(e0, v[0], v[0], v[0], v[2]);
+            setEndpoint(e1, v[0] + v[1], v[0] + v[1], v[0] + v[1], v[2] + v[3]);
+            return true;
+        case 6:
+            setEndpoint(e0, (v[0] * v[3]) >> 8, (v[1] * v[3]) >> 8, (v[2] * v[3]) >> 8, 255);
+            setEndpoint(e1, v[0], v[1], v[2], 255);
+            return true;
+        case 8:
+        case 12:
+        {
+            int const a0 = mode == 12 ? v[6] : 255;
+            int const a1 = mode == 12 ? v[7] : 255;
+            if (v[1] + v[3] + v[5] >= v[0] + v[2] + v[4])
+            {
+                setEndpoint(e0, v[0], v[2], v[4], a0);
+                setEndpoint(e1, v[1], v[3], v[5], a1);
+            }
+            else
+            {
+                setBlueContracted(e0, v[1], v[3], v[5], a1);
+                setBlueContracted(e1, v[0], v[2], v[4], a0);
+            }
+            return true;
+        }
+        case 9:
+        case 13:
+        {
+            bitTransferSigned(v[1], v[0]);
+            bitTransferSigned(v[3], v[2]);
+            bitTransferSigned(v[5], v[4]);
+            if (mode == 13)
+                bitTransferSigned(v[7], v[6]);
+            else
+                v[6] = 255, v[7] = 0;
+            if (v[1] + v[3] + v[5] >= 0)
+            {
+                setEndpoint(e0, v[0], v[2], v[4], v[6]);
+                setEndpoint(e1, v[0] + v[1], v[2] + v[3], v[4] + v[5], v[6] + v[7]);
+            }
+            else
+            {
+                setBlueContracted(e0, v[0] + v[1], v[2] + v[3], v[4] + v[5], v[6] + v[7]);
+                setBlueContracted(e1, v[0], v[2], v[4], v[6]);
+            }
+            return true;
+        }
+        case 10:
+            setEndpoint(e0, (v[0] * v[3]) >> 8, (v[1] * v[3]) >> 8, (v[2] * v[3]) >> 8, v[4]);
+            setEndpoint(e1, v[0], v[1], v[2], v[5]);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    auto hash52(uint32 p) -> uint32
+    {
+        p ^= p >> 15;
+        p -= p << 17;
+        p += p << 7;
+        p += p << 4;
+        p ^= p >> 5;
+        p += p << 16;
+        p ^= p >> 7;
+        p ^= p >> 3;
+        p ^= p << 6;
+        p ^= p >> 17;
+        return p;
+    }
+
+    auto selectPartition(uint32 seed, uint32 x, uint32 y, uint32 count, bool smallBlock) -> uint32
+    {
+        if (smallBlock)
+        {
+            x <<= 1;
+            y <<= 1;
+        }
+        seed += (count - 1) * 1024;
+        uint32 const rnum = hash52(seed);
+        uint32 seeds[8];
+        for (uint32 i = 0; i < 8; ++i)
+        {
+            seeds[i] = (rnum >> (i * 4)) & 0xF;
+            seeds[i] *= seeds[i];
+        }
+        uint32 sh1, sh2;
+        if (seed & 1)
+        {
+            sh1 = seed & 2 ? 4 : 5;
+            sh2 = count == 3 ? 6 : 5;
+        }
+        else
+        {
+            sh1 = count == 3 ? 6 : 5;
+            sh2 = seed & 2 ? 4 : 5;
+        }
+        for (uint32 i = 0; i < 8; ++i)
+            seeds[i] >>= i & 1 ? sh2 : sh1;
+
+        // the z terms of the 3D partitioning are always zero here
+        uint32 const a = (seeds[0] * x + seeds[1] * y + (rnum >> 14)) & 0x3F;
+        uint32 const b = (seeds[2] * x + seeds[3] * y + (rnum >> 10)) & 0x3F;
+        uint32 const c = count < 3 ? 0 : (seeds[4] * x + seeds[5] * y + (rnum >> 6)) & 0x3F;
+        uint32 const d = count < 4 ? 0 : (seeds[6] * x + seeds[7] * y + (rnum >> 2)) & 0x3F;
+        if (a >= b && a >= c && a >= d)
+            return 0;
+        if (b >= c && b >= d)
+            return 1;
+        if (c >= d)
+            return 2;
+        return 3;
+    }
+
+    void decodeASTC(const uint8* block, uint8* texels, uint32 blockWidth, uint32 blockHeight)
+    {
+        Bits128 const bits = load128(block);
+        uint32 const texelCount = blockWidth * blockHeight;
+        uint32 const mode = bits.get(0, 11);
+
+        if ((mode & 0x1FF) == 0x1FC)
+        {
+            // void extent, a constant colour block
+            if (mode & 0x200)
+            {
+                fillASTC(texels, texelCount, ASTCErrorColour);
+                return;
+            }
+            uint8 const colour[4] =
+            {
+                static_cast<uint8>(bits.get(64, 16) >> 8),
+                static_cast<uint8>(bits.get(80, 16) >> 8),
+                static_cast<uint8>(bits.get(96, 16) >> 8),
+                static_cast<uint8>(bits.get(112, 16) >> 8),
+            };
+            fillASTC(texels, texelCount, colour);
+            return;
+        }
+
+        uint32 gridWidth, gridHeight, quant;
+        bool highPrecision = mode & 0x200;
+        bool dualPlane = mode & 0x400;
+        uint32 const a = (mode >> 5) & 3;
+        if (mode & 3)
+        {
+            quant = ((mode >> 4) & 1) | (mode & 3) << 1;
+            uint32 b = (mode >> 7) & 3;
+            switch ((mode >> 2) & 3)
+            {
+            case 0: gridWidth = b + 4; gridHeight = a + 2; break;
+            case 1: gridWidth = b + 8; gridHeight = a + 2; break;
+            case 2: gridWidth = a + 2; gridHeight = b + 8; break;
+            default:
+                b &= 1;
+                if (mode & 0x100)
+                {
+                    gridWidth = b + 2;
+                    gridHeight = a + 2;
+                }
+                else
+                {
+                    gridWidth = a + 2;
+                    gridHeight = b + 6;
+                }
+                break;
+            }
+        }
+        else
+        {
+            quant = ((mode >> 4) & 1) | ((mode >> 2) & 3) << 1;
+            uint32 const b = (mode >> 9) & 3;
+            switch ((mode >> 7) & 3)
+            {
+            case 0: gridWidth = 12; gridHeight = a + 2; break;
+            case 1: gridWidth = a + 2; gridHeight = 12; break;
+            case 2: gridWidth = a + 6; gridHeight = b + 6; dualPlane = highPrecision = false; break;
+            default:
+                if ((mode >> 6) & 1)
+                {
+                    fillASTC(texels, texelCount, ASTCErrorColour);
+                    return;
+                }
+                gridWidth = (mode >> 5) & 1 ? 10 : 6;
+                gridHeight = (mode >> 5) & 1 ? 6 : 10;
+                break;
+            }
+        }
+        uint32 const partitionCount = bits.get(11, 2) + 1;
+        if (quant < 2 || gridWidth > blockWidth || gridHeight > blockHeight || (dualPlane && partitionCount == 4))
+        {
+            fillASTC(texels, texelCount, ASTCErrorColour);
+            return;
+        }
+
+        uint32 const weightRange = ASTCRanges[quant - 2 + (highPrecision ? 6 : 0)];
+        uint32 const weightCount = gridWidth * gridHeight * (dualPlane ? 2 : 1);
+        uint32 const weightBits = getISEBitCount(weightCount, weightRange);
+        if (weightCount > 64 || weightBits < 24 || weightBits > 96)
+        {
+            fillASTC(texels, texelCount, ASTCErrorColour);
+            return;
+        }
+
+        // colour endpoint modes
+        uint32 endpointModes[4];
+        uint32 partitionIndex = 0;
+        uint32 colourStart = 17;
+        uint32 extraBits = 0;
+        if (partitionCount == 1)
+            endpointModes[0] = bits.get(13, 4);
+        else
+        {
+            partitionIndex = bits.get(13, 10);
+            colourStart = 29;
+            uint32 encoded = bits.get(23, 6);
+            if ((encoded & 3) == 0)
+            {
+                for (uint32 p = 0; p < partitionCount; ++p)
+                    endpointModes[p] = (encoded >> 2) & 0xF;
+            }
+            else
+            {
+                extraBits = 3 * partitionCount - 4;
+                encoded |= bits.get(128 - weightBits - extraBits, extraBits) << 6;
+                uint32 const baseClass = (encoded & 3) - 1;
+                for (uint32 p = 0; p < partitionCount; ++p)
+                {
+                    uint32 const offset = (encoded >> (2 + p)) & 1;
+                    uint32 const low = (encoded >> (2 + partitionCount + p * 2)) & 3;
+                    endpointModes[p] = (baseClass + offset) << 2 | low;
+                }
+            }
+        }
+
+        uint32 const colourEnd = 128 - weightBits - extraBits - (dualPlane ? 2 : 0);
+        uint32 const planeComponent = dualPlane ? bits.get(colourEnd, 2) : 4;
+        uint32 colourCount = 0;
+        for (uint32 p = 0; p < partitionCount; ++p)
+            colourCount += 2 * ((endpointModes[p] >> 2) + 1);
+        if (colourCount > 18 || colourEnd < colourStart)
+        {
+            fillASTC(texels, texelCount, ASTCErrorColour);
+            return;
+        }
+
+        uint32 colourRange = 0;
+        for (uint32 range : ASTCRanges)
+            if (getISEBitCount(colourCount, range) <= colourEnd - colourStart)
+                colourRange = range;
+        if (colourRange < 6)
+        {
+            fillASTC(texels, texelCount, ASTCErrorColour);
+            return;
+        }
+
+        uint8 colourValues[18];
+        decodeISE(bits, colourStart, colourEnd, colourCount, colourRange, colourValues);
+        for (uint32 i = 0; i < colourCount; ++i)
+            colourValues[i] = unquantiseColour(colourValues[i], colourRange);
+
+        uint8 endpoints[4][2][4];
+        uint32 colourOffset = 0;
+        for (uint32 p = 0; p < partitionCount; ++p)
+        {
+            if (!decodeEndpoints(endpointModes[p], colourValues + colourOffset, endpoints[p][0], endpoints[p][1]))
+            {
+                fillASTC(texels, texelCount, ASTCErrorColour);
+                return;
+            }
+            colourOffset += 2 * ((endpointModes[p] >> 2) + 1);
+        }
+
+        // weights are stored bit reversed from the top of the block
+        Bits128 reversed;
+        reversed.lo = 0;
+        reversed.hi = 0;
+        for (uint32 i = 0; i < 64; ++i)
+        {
+            reversed.lo |= ((bits.hi >> (63 - i)) & 1) << i;
+            reversed.hi |= ((bits.lo >> (63 - i)) & 1) << i;
+        }
+        uint8 weights[64];
+        decodeISE(reversed, 0, weightBits, weightCount, weightRange, weights);
+        for (uint32 i = 0; i < weightCount; ++i)
+            weights[i] = unquantiseWeight(weights[i], weightRange);
+
+        alignas(16) uint8 e0[12 * 12 * 4];
+        alignas(16) uint8 e1[12 * 12 * 4];
+        alignas(16) uint8 texelWeights[12 * 12 * 4];
+        uint32 const stepX = (1024 + blockWidth / 2) / (blockWidth - 1);
+        uint32 const stepY = (1024 + blockHeight / 2) / (blockHeight - 1);
+        uint32 const planes = dualPlane ? 2 : 1;
+        bool const smallBlock = texelCount < 31;
+        for (uint32 y = 0; y < blockHeight; ++y)
+        {
+            uint32 const gy = (stepY * y * (gridHeight - 1) + 32) >> 6;
+            uint32 const jy = gy >> 4, fy = gy & 0xF;
+            for (uint32 x = 0; x < blockWidth; ++x)
+            {
+                uint32 const i = y * blockWidth + x;
+                uint32 const gx = (stepX * x * (gridWidth - 1) + 32) >> 6;
+                uint32 const jx = gx >> 4, fx = gx & 0xF;
+                uint32 const w11 = (fx * fy + 8) >> 4;
+                uint32 const w10 = fy - w11;
+                uint32 const w01 = fx - w11;
+                uint32 const w00 = 16 - fx - fy + w11;
+                uint32 const x1 = std::min(jx + 1, gridWidth - 1);
+                uint32 const y1 = std::min(jy + 1, gridHeight - 1);
+
+                uint8 plane[2];
+                for (uint32 k = 0; k < planes; ++k)
+                {
+                    auto at = [&](uint32 gx2, uint32 gy2) { return uint32(weights[(gy2 * gridWidth + gx2) * planes + k]); };
+                    plane[k] = static_cast<uint8>((at(jx, jy) * w00 + at(x1, jy) * w01 + at(jx, y1) * w10 + at(x1, y1) * w11 + 8) >> 4);
+                }
+                for (uint32 c = 0; c < 4; ++c)
+                    texelWeights[i * 4 + c] = plane[c == planeComponent ? 1 : 0];
+
+                uint32 const partition = partitionCount == 1 ? 0 : selectPartition(partitionIndex, x, y, partitionCount, smallBlock);
+                memcpy(e0 + i * 4, endpoints[partition][0], 4);
+                memcpy(e1 + i * 4, endpoints[partition][1], 4);
+            }
+        }
+        interpolate<true>(e0, e1, texelWeights, texelCount, texels);
+    }
+    //---------------------------------------------------------------------
+    using BlockDecoder = void (*)(const uint8* block, uint8* texels, uint32 blockWidth, uint32 blockHeight);
+
+    struct BlockLayout
+    {
+        BlockDecoder decode;
+        uint32 width;
+        uint32 height;
+        uint32 bytes;
+        PixelFormat texelFormat;
+    };
+
+    auto getBlockLayout(PixelFormat format) -> BlockLayout
+    {
+        using enum PixelFormat;
+        switch (format)
+        {
+        case DXT1: return {decodeBC1, 4, 4, 8, BYTE_RGBA};
+        case DXT2:
+        case DXT3: return {decodeBC2, 4, 4, 16, BYTE_RGBA};
+        case DXT4:
+        case DXT5: return {decodeBC3, 4, 4, 16, BYTE_RGBA};
+        case BC4_UNORM: return {decodeBC4BC5<false, false>, 4, 4, 8, BYTE_RGBA};
+        case BC4_SNORM: return {decodeBC4BC5<true, false>, 4, 4, 8, BYTE_RGBA};
+        case BC5_UNORM: return {decodeBC4BC5<false, true>, 4, 4, 16, BYTE_RGBA};
+        case BC5_SNORM: return {decodeBC4BC5<true, true>, 4, 4, 16, BYTE_RGBA};
+        case BC6H_UF16: return {decodeBC6H<false>, 4, 4, 16, FLOAT16_RGBA};
+        case BC6H_SF16: return {decodeBC6H<true>, 4, 4, 16, FLOAT16_RGBA};
+        case BC7_UNORM: return {decodeBC7, 4, 4, 16, BYTE_RGBA};
+        case ETC1_RGB8: return {decodeETC1, 4, 4, 8, BYTE_RGBA};
+        case ETC2_RGB8: return {decodeETC2, 4, 4, 8, BYTE_RGBA};
+        case ETC2_RGB8A1: return {decodeETC2A1, 4, 4, 8, BYTE_RGBA};
+        case ETC2_RGBA8: return {decodeETC2RGBA, 4, 4, 16, BYTE_RGBA};
+        case ASTC_RGBA_4X4_LDR: return {decodeASTC, 4, 4, 16, BYTE_RGBA};
+        case ASTC_RGBA_5X4_LDR: return {decodeASTC, 5, 4, 16, BYTE_RGBA};
+        case ASTC_RGBA_5X5_LDR: return {decodeASTC, 5, 5, 16, BYTE_RGBA};
+        case ASTC_RGBA_6X5_LDR: return {decodeASTC, 6, 5, 16, BYTE_RGBA};
+        case ASTC_RGBA_6X6_LDR: return {decodeASTC, 6, 6, 16, BYTE_RGBA};
+        case ASTC_RGBA_8X5_LDR: return {decodeASTC, 8, 5, 16, BYTE_RGBA};
+        case ASTC_RGBA_8X6_LDR: return {decodeASTC, 8, 6, 16, BYTE_RGBA};
+        case ASTC_RGBA_8X8_LDR: return {decodeASTC, 8, 8, 16, BYTE_RGBA};
+        case ASTC_RGBA_10X5_LDR: return {decodeASTC, 10, 5, 16, BYTE_RGBA};
+        case ASTC_RGBA_10X6_LDR: return {decodeASTC, 10, 6, 16, BYTE_RGBA};
+        case ASTC_RGBA_10X8_LDR: return {decodeASTC, 10, 8, 16, BYTE_RGBA};
+        case ASTC_RGBA_10X10_LDR: return {decodeASTC, 10, 10, 16, BYTE_RGBA};
+        case ASTC_RGBA_12X10_LDR: return {decodeASTC, 12, 10, 16, BYTE_RGBA};
+        case ASTC_RGBA_12X12_LDR: return {decodeASTC, 12, 12, 16, BYTE_RGBA};
+        default: return {nullptr, 0, 0, 0, UNKNOWN};
+        }
+    }
+}
+    //-----------------------------------------------------------------------
+    auto BlockDecompressor::isSupported(PixelFormat format) -> bool
+    {
+        return getBlockLayout(format).decode != nullptr;
+    }
+    //-----------------------------------------------------------------------
+    auto BlockDecompressor::getDecompressedFormat(PixelFormat format) -> PixelFormat
+    {
+        using enum PixelFormat;
+        switch (format)
+        {
+        case BC4_UNORM: return R8;
+        case BC4_SNORM: return R8_SNORM;
+        case BC5_UNORM: return RG8;
+        case BC5_SNORM: return R8G8_SNORM;
+        default: return getBlockLayout(format).texelFormat;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void BlockDecompressor::decompress(const PixelBox& src, const PixelBox& dst)
+    {
+        BlockLayout const layout = getBlockLayout(src.format);
+        OgreAssert(layout.decode, "Unsupported compressed format");
+        OgreAssert(src.left == 0 && src.top == 0 && src.front == 0, "Compressed data must start at a whole level");
+        OgreAssert(src.getWidth() == dst.getWidth() && src.getHeight() == dst.getHeight() &&
+                   src.getDepth() == dst.getDepth(), "Source and destination size must match");
+
+        uint32 const width = src.getWidth();
+        uint32 const height = src.getHeight();
+        uint32 const blocksX = (width + layout.width - 1) / layout.width;
+        uint32 const blocksY = (height + layout.height - 1) / layout.height;
+        size_t const texelBytes = PixelUtil::getNumElemBytes(layout.texelFormat);
+        bool const direct = dst.format == layout.texelFormat;
+
+        parallelForBands(blocksY * src.getDepth(), 4, [&](uint32 begin, uint32 end)
+        {
+            alignas(16) uint8 texels[12 * 12 * 8];
+            std::vector<uint8> band;
+            for (uint32 row = begin; row < end; ++row)
+            {
+                uint32 const z = row / blocksY;
+                uint32 const top = (row % blocksY) * layout.height;
+                uint32 const rows = std::min(layout.height, height - top);
+                const uint8* blocks = src.data + size_t(row) * blocksX * layout.bytes;
+
+                // decode straight into the destination when no conversion is needed
+                uint8* out;
+                size_t outPitch;
+                if (direct)
+                {
+                    out = dst.data + (dst.left + (dst.top + top) * dst.rowPitch + (dst.front + z) * dst.slicePitch) * texelBytes;
+                    outPitch = dst.rowPitch * texelBytes;
+                }
+                else
+                {
+                    band.resize(size_t(width) * rows * texelBytes);
+                    out = band.data();
+                    outPitch = width * texelBytes;
+                }
+
+                for (uint32 bx = 0; bx < blocksX; ++bx)
+                {
+                    layout.decode(blocks + size_t(bx) * layout.bytes, texels, layout.width, layout.height);
+                    uint32 const left = bx * layout.width;
+                    size_t const columns = std::min(layout.width, width - left) * texelBytes;
+                    for (uint32 y = 0; y < rows; ++y)
+                        memcpy(out + y * outPitch + left * texelBytes, texels + y * layout.width * texelBytes, columns);
+                }
+
+                if (!direct)
+                {
+                    Box const target{dst.left, dst.top + top, dst.right, dst.top + top + rows, dst.front + z, dst.front + z + 1};
+                    PixelUtil::bulkPixelConversion(PixelBox(width, rows, 1, layout.texelFormat, band.data()),
+                                                   dst.getSubVolume(target, false));
+                }
+            }
+        });
+    }
+}
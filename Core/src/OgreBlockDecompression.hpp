@@ -0,0 +1,62 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module Ogre.Core:BlockDecompression;
+
+import :PixelFormat;
+import :Prerequisites;
+
+// internal to the Image implementation, used by OgreImage.cpp,
+// OgrePixelFormat.cpp and OgreBlockDecompression.cpp only.
+namespace Ogre {
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Image
+    *  @{
+    */
+
+// CPU decoders for BC1-BC7 (DXT1-5, BC4, BC5, BC6H, BC7), ETC1, ETC2 with EAC
+// alpha and ASTC LDR.
+//
+// Rows of blocks are decoded on all hardware threads and endpoint blending of
+// the BC7 and ASTC decoders is done with SSE2.
+struct BlockDecompressor
+{
+    [[nodiscard]] static auto isSupported(PixelFormat format) -> bool;
+
+    // Format that holds a decoded image without loss, FLOAT16_RGBA for BC6H,
+    // single and dual channel formats for BC4 and BC5, BYTE_RGBA otherwise.
+    [[nodiscard]] static auto getDecompressedFormat(PixelFormat format) -> PixelFormat;
+
+    // Decodes a whole level or volume at src into dst, which must have the same size
+    // and may be in any accessible format.
+    static void decompress(const PixelBox& src, const PixelBox& dst);
+};
+    /** @} */
+    /** @} */
+}
@@ -32,7 +32,6 @@ module;
 module Ogre.Core;
 
 import :Codec;
-import :ColourValue;
 import :Common;
 import :DDSCodec;
 import :DataStream;
@@ -40,9 +39,6 @@ import :Exception;
 import :Image;
 import :Log;
 import :LogManager;
-import :RenderSystem;
-import :RenderSystemCapabilities;
-import :Root;
 import :SharedPtr;
 import :StableHeaders;
 
@@ -51,6 +47,7 @@ import <memory>;
 import <ostream>;
 import <string>;
 import <utility>;
+import <vector>;
 
 namespace Ogre {
     // Internal DDS structure definitions
@@ -103,34 +100,7 @@ namespace Ogre {
         uint32 arraySize;
         uint32 reserved;
     };
-    
 
-    // An 8-byte DXT colour block, represents a 4x4 texel area. Used by all DXT formats
-    struct DXTColourBlock
-    {
-        // 2 colour ranges
-        uint16 colour_0;
-        uint16 colour_1;
-        // 16 2-bit indexes, each byte here is one row
-        uint8 indexRow[4];
-    };
-    // An 8-byte DXT explicit alpha block, represents a 4x4 texel area. Used by DXT2/3
-    struct DXTExplicitAlphaBlock
-    {
-        // 16 4-bit values, each 16-bit value is one row
-        uint16 alphaRow[4];
-    };
-    // An 8-byte DXT interpolated alpha block, represents a 4x4 texel area. Used by DXT4/5
-    struct DXTInterpolatedAlphaBlock
-    {
-        // 2 alpha ranges
-        uint8 alpha_0;
-        uint8 alpha_1;
-        // 16 3-bit indexes. Unfortunately 3 bits doesn't map too well to row bytes
-        // so just stored raw
-        uint8 indexes[6];
-    };
-    
 #pragma pack ()
 
 namespace {
@@ -159,10 +129,11 @@ namespace {
     const uint32 DDSCAPS2_CUBEMAP_NEGATIVEZ = 0x00008000;
     const uint32 DDSCAPS2_VOLUME = 0x00200000;
 
+    const uint32 DDSD_MIPMAPCOUNT = 0x00020000;
+    const uint32 DDSD_LINEARSIZE = 0x00080000;
+
     // Currently unused
 //    const uint32 DDSD_PITCH = 0x00000008;
-//    const uint32 DDSD_MIPMAPCOUNT = 0x00020000;
-//    const uint32 DDSD_LINEARSIZE = 0x00080000;
 
     // Special FourCC codes
     const uint32 D3DFMT_R16F            = 111;
@@ -207,8 +178,7 @@ namespace {
     { 
     }
     //---------------------------------------------------------------------
-    void DDSCodec::encodeToFile(const MemoryDataStreamPtr& input, std::string_view outFileName,
-                                const CodecDataPtr& pData) const
+    auto DDSCodec::encode(const MemoryDataStreamPtr& input, const CodecDataPtr& pData) const -> DataStreamPtr
     {
         // Unwrap codecDataPtr - data is cleaned by calling function
         auto* imgData = static_cast<ImageData* >(pData.get());  
@@ -225,6 +195,7 @@ namespace {
         bool isFloat16 = (imgData->format == PixelFormat::FLOAT16_RGBA);
         bool isFloat16r = (imgData->format == PixelFormat::FLOAT16_R);
         bool isFloat32 = (imgData->format == PixelFormat::FLOAT32_RGBA);
+        bool isCompressed = PixelUtil::isCompressed(imgData->format);
         bool notImplemented = false;
         String notImplementedString = "";
 
@@ -241,7 +212,7 @@ namespace {
         {
             size <<= 1;
         }
-        if (size != imgData->width)
+        if (size != imgData->width && !isCompressed)
         {
             // Power two textures only
             notImplemented = true;
@@ -261,6 +232,11 @@ namespace {
         case FLOAT16_R:
         case FLOAT16_RGBA:
         case FLOAT32_RGBA:
+        case DXT1:
+        case DXT5:
+        case BC4_UNORM:
+        case BC5_UNORM:
+        case BC7_UNORM:
             break;
         default:
             // No crazy FOURCC or 565 et al. file formats at this stage
@@ -279,10 +255,11 @@ namespace {
         }
         else
         {
-            // Build header and write to disk
+            // Build header and write to a memory stream
 
             // Variables for some DDS header flags
             bool hasAlpha = false;
+            uint32 fourCC = 0;
             uint32 ddsHeaderFlags = 0;
             uint32 ddsHeaderRgbBits = 0;
             uint32 ddsHeaderSizeOrPitch = 0;
@@ -331,6 +308,22 @@ namespace {
                 ddsHeaderRgbBits = 32 * 4;
                 hasAlpha = true;
                 break;
+            case DXT1:
+                fourCC = FOURCC('D','X','T','1');
+                break;
+            case DXT5:
+                fourCC = FOURCC('D','X','T','5');
+                break;
+            case BC4_UNORM:
+                fourCC = FOURCC('A','T','I','1');
+                break;
+            case BC5_UNORM:
+                fourCC = FOURCC('A','T','I','2');
+                break;
+            case BC7_UNORM:
+                // only expressible with the DX10 extended header
+                fourCC = FOURCC('D','X','1','0');
+                break;
             default:
                 ddsHeaderRgbBits = 0;
                 break;
@@ -338,6 +331,13 @@ namespace {
 
             // Initalise the SizeOrPitch flags (power two textures for now)
             ddsHeaderSizeOrPitch = static_cast<uint32>(ddsHeaderRgbBits * imgData->width);
+            if (isCompressed)
+            {
+                // compressed formats store the size of the top level instead of a pitch
+                ddsHeaderFlags |= DDSD_LINEARSIZE;
+                ddsHeaderSizeOrPitch = static_cast<uint32>(
+                    PixelUtil::getMemorySize(imgData->width, imgData->height, 1, imgData->format));
+            }
 
             // Initalise the caps flags
             ddsHeaderCaps1 = (isVolume||isCubeMap) ? DDSCAPS_COMPLEX|DDSCAPS_TEXTURE : DDSCAPS_TEXTURE;
@@ -354,12 +354,15 @@ namespace {
             }
 
             if( imgData->num_mipmaps > TextureMipmap{} )
+            {
                 ddsHeaderCaps1 |= DDSCAPS_MIPMAP;
+                ddsHeaderFlags |= DDSD_MIPMAPCOUNT;
+            }
 
             // Populate the DDS header information
             DDSHeader ddsHeader;
             ddsHeader.size = DDS_HEADER_SIZE;
-            ddsHeader.flags = ddsHeaderFlags;       
+            ddsHeader.flags = ddsHeaderFlags;
             ddsHeader.width = (uint32)imgData->width;
             ddsHeader.height = (uint32)imgData->height;
             ddsHeader.depth = (uint32)(isVolume ? imgData->depth : 0);
@@ -388,7 +391,7 @@ namespace {
                 ddsHeader.pixelFormat.fourCC = D3DFMT_A32B32G32R32F;
             }
             else {
-                ddsHeader.pixelFormat.fourCC = 0;
+                ddsHeader.pixelFormat.fourCC = fourCC;
             }
             ddsHeader.pixelFormat.rgbBits = ddsHeaderRgbBits;
 
@@ -401,47 +404,72 @@ namespace {
             if( flipRgbMasks )
                 std::swap( ddsHeader.pixelFormat.redMask, ddsHeader.pixelFormat.blueMask );
 
+            if (isCompressed)
+            {
+                ddsHeader.pixelFormat.flags = DDPF_FOURCC;
+                ddsHeader.pixelFormat.redMask = ddsHeader.pixelFormat.greenMask = 0;
+                ddsHeader.pixelFormat.blueMask = ddsHeader.pixelFormat.alphaMask = 0;
+            }
+
             ddsHeader.caps.caps1 = ddsHeaderCaps1;
             ddsHeader.caps.caps2 = ddsHeaderCaps2;
 //          ddsHeader.caps.reserved[0] = 0;
 //          ddsHeader.caps.reserved[1] = 0;
 
+            bool const hasExtendedHeader = (fourCC == FOURCC('D','X','1','0'));
+            DDSExtendedHeader extendedHeader{};
+            if (hasExtendedHeader)
+            {
+                extendedHeader.dxgiFormat = 98; // DXGI_FORMAT_BC7_UNORM
+                extendedHeader.resourceDimension = isVolume ? 4 : 3; // D3D10_RESOURCE_DIMENSION_TEXTURE3D / 2D
+                extendedHeader.miscFlag = isCubeMap ? 0x4 : 0; // D3D11_RESOURCE_MISC_TEXTURECUBE
+                extendedHeader.arraySize = 1;
+                flipEndian(&extendedHeader, 4, sizeof(DDSExtendedHeader) / 4);
+            }
+
             // Swap endian
             flipEndian(&ddsMagic, sizeof(uint32));
             flipEndian(&ddsHeader, 4, sizeof(DDSHeader) / 4);
 
-            char *tmpData = nullptr;
-            char const *dataPtr = (char const *)input->getPtr();
+            std::vector<uchar> swizzled;
+            uchar const *dataPtr = input->getPtr();
 
             if( imgData->format == PixelFormat::B8G8R8 )
             {
+                swizzled.resize(imgData->size);
                 PixelBox src( imgData->size / 3, 1, 1, PixelFormat::B8G8R8, input->getPtr() );
-                tmpData = new char[imgData->size];
-                PixelBox dst( imgData->size / 3, 1, 1, PixelFormat::R8G8B8, tmpData );
+                PixelBox dst( imgData->size / 3, 1, 1, PixelFormat::R8G8B8, swizzled.data() );
 
                 PixelUtil::bulkPixelConversion( src, dst );
 
-                dataPtr = tmpData;
+                dataPtr = swizzled.data();
             }
 
-            try
-            {
-                // Write the file
-                std::ofstream of;
-                of.open(std::filesystem::path{outFileName}, std::ios_base::binary|std::ios_base::out);
-                of.write((const char *)&ddsMagic, sizeof(uint32));
-                of.write((const char *)&ddsHeader, DDS_HEADER_SIZE);
-                // XXX flipEndian on each pixel chunk written unless isFloat32r ?
-                of.write(dataPtr, (uint32)imgData->size);
-                of.close();
-            }
-            catch(...)
-            {
-                delete [] tmpData;
-            }
+            size_t const headerSize = sizeof(uint32) + DDS_HEADER_SIZE + (hasExtendedHeader ? sizeof(DDSExtendedHeader) : 0);
+            auto output = std::make_shared<MemoryDataStream>(headerSize + imgData->size);
+            output->write(&ddsMagic, sizeof(uint32));
+            output->write(&ddsHeader, DDS_HEADER_SIZE);
+            if (hasExtendedHeader)
+                output->write(&extendedHeader, sizeof(DDSExtendedHeader));
+            // XXX flipEndian on each pixel chunk written unless isFloat32r ?
+            output->write(dataPtr, imgData->size);
+            output->seek(0);
+            return output;
         }
     }
     //---------------------------------------------------------------------
+    void DDSCodec::encodeToFile(const MemoryDataStreamPtr& input, std::string_view outFileName,
+                                const CodecDataPtr& pData) const
+    {
+        MemoryDataStreamPtr data = static_pointer_cast<MemoryDataStream>(encode(input, pData));
+
+        // Write the file
+        std::ofstream of;
+        of.open(std::filesystem::path{outFileName}, std::ios_base::binary|std::ios_base::out);
+        of.write((const char *)data->getPtr(), data->size());
+        of.close();
+    }
+    //---------------------------------------------------------------------
     auto DDSCodec::convertDXToOgreFormat(uint32 dxfmt) const -> PixelFormat
     {
         switch (dxfmt) {
@@ -636,127 +664,6 @@ namespace {
             "DDSCodec::convertPixelFormat");
     }
     //---------------------------------------------------------------------
-    void DDSCodec::unpackDXTColour(PixelFormat pf, const DXTColourBlock& block, 
-        ColourValue* pCol) const
-    {
-        // Note - we assume all values have already been endian swapped
-
-        // Colour lookup table
-        ColourValue derivedColours[4];
-
-        if (pf == PixelFormat::DXT1 && block.colour_0 <= block.colour_1)
-        {
-            // 1-bit alpha
-            PixelUtil::unpackColour(&(derivedColours[0]), PixelFormat::R5G6B5, &(block.colour_0));
-            PixelUtil::unpackColour(&(derivedColours[1]), PixelFormat::R5G6B5, &(block.colour_1));
-            // one intermediate colour, half way between the other two
-            derivedColours[2] = (derivedColours[0] + derivedColours[1]) / 2;
-            // transparent colour
-            derivedColours[3] = ColourValue::ZERO;
-        }
-        else
-        {
-            PixelUtil::unpackColour(&(derivedColours[0]), PixelFormat::R5G6B5, &(block.colour_0));
-            PixelUtil::unpackColour(&(derivedColours[1]), PixelFormat::R5G6B5, &(block.colour_1));
-            // first interpolated colour, 1/3 of the way along
-            derivedColours[2] = (2 * derivedColours[0] + derivedColours[1]) / 3;
-            // second interpolated colour, 2/3 of the way along
-            derivedColours[3] = (derivedColours[0] + 2 * derivedColours[1]) / 3;
-        }
-
-        // Process 4x4 block of texels
-        for (size_t row = 0; row < 4; ++row)
-        {
-            for (size_t x = 0; x < 4; ++x)
-            {
-                // LSB come first
-                auto colIdx = static_cast<uint8>(block.indexRow[row] >> (x * 2) & 0x3);
-                if (pf == PixelFormat::DXT1)
-                {
-                    // Overwrite entire colour
-                    pCol[(row * 4) + x] = derivedColours[colIdx];
-                }
-                else
-                {
-                    // alpha has already been read (alpha precedes colour)
-                    ColourValue& col = pCol[(row * 4) + x];
-                    col.r = derivedColours[colIdx].r;
-                    col.g = derivedColours[colIdx].g;
-                    col.b = derivedColours[colIdx].b;
-                }
-            }
-
-        }
-
-
-    }
-    //---------------------------------------------------------------------
-    void DDSCodec::unpackDXTAlpha(
-        const DXTExplicitAlphaBlock& block, ColourValue* pCol) const
-    {
-        // Note - we assume all values have already been endian swapped
-        
-        // This is an explicit alpha block, 4 bits per pixel, LSB first
-        for (unsigned short row : block.alphaRow)
-        {
-            for (size_t x = 0; x < 4; ++x)
-            {
-                // Shift and mask off to 4 bits
-                auto val = static_cast<uint8>(row >> (x * 4) & 0xF);
-                // Convert to [0,1]
-                pCol->a = (Real)val / (Real)0xF;
-                pCol++;
-                
-            }
-            
-        }
-
-    }
-    //---------------------------------------------------------------------
-    void DDSCodec::unpackDXTAlpha(
-        const DXTInterpolatedAlphaBlock& block, ColourValue* pCol) const
-    {
-        // Adaptive 3-bit alpha part
-        float derivedAlphas[8];
-
-        // Explicit extremes
-        derivedAlphas[0] = ((float) block.alpha_0) * (1.0f / 255.0f);
-        derivedAlphas[1] = ((float) block.alpha_1) * (1.0f / 255.0f);
-
-        if(block.alpha_0 > block.alpha_1)
-        {
-            // 6 interpolated alpha values.
-            // full range including extremes at [0] and [7]
-            // we want to fill in [1] through [6] at weights ranging
-            // from 1/7 to 6/7
-            for(size_t i = 1; i < 7; ++i)
-                derivedAlphas[i + 1] = (derivedAlphas[0] * (7 - i) + derivedAlphas[1] * i) * (1.0f / 7.0f);
-        }
-        else
-        {
-            // 4 interpolated alpha values.
-            // full range including extremes at [0] and [5]
-            // we want to fill in [1] through [4] at weights ranging
-            // from 1/5 to 4/5
-            for(size_t i = 1; i < 5; ++i)
-                derivedAlphas[i + 1] = (derivedAlphas[0] * (5 - i) + derivedAlphas[1] * i) * (1.0f / 5.0f);
-
-            derivedAlphas[6] = 0.0f;
-            derivedAlphas[7] = 1.0f;
-        }
-
-        // Ok, now we've built the reference values, process the indexes
-        uint32 dw = block.indexes[0] | (block.indexes[1] << 8) | (block.indexes[2] << 16);
-
-        for(size_t i = 0; i < 8; ++i, dw >>= 3)
-            pCol[i].a = derivedAlphas[dw & 0x7];
-
-        dw = block.indexes[3] | (block.indexes[4] << 8) | (block.indexes[5] << 16);
-
-        for(size_t i = 8; i < 16; ++i, dw >>= 3)
-            pCol[i].a = derivedAlphas[dw & 0x7];
-    }
-    //---------------------------------------------------------------------
     auto DDSCodec::decode(const DataStreamPtr& stream) const -> ImageCodec::DecodeResult
     {
         // Read 4 character code
@@ -807,7 +714,6 @@ namespace {
         }
         imgData->flags = {};
 
-        bool decompressDXT = false;
         // Figure out basic image type
         if (header.caps.caps2 & DDSCAPS2_CUBEMAP)
         {
@@ -848,67 +754,10 @@ namespace {
                 header.pixelFormat.alphaMask : 0);
         }
 
+        imgData->format = sourceFormat;
+        // Keep compressed data compressed, Image::load decodes it when the render system can not
         if (PixelUtil::isCompressed(sourceFormat))
-        {
-            if (Root::getSingleton().getRenderSystem() == nullptr ||
-                !Root::getSingleton().getRenderSystem()->getCapabilities()->hasCapability(Capabilities::TEXTURE_COMPRESSION_DXT))
-            {
-                // We'll need to decompress
-                decompressDXT = true;
-                // Convert format
-                using enum PixelFormat;
-                switch (sourceFormat)
-                {
-                case DXT1:
-                    // source can be either 565 or 5551 depending on whether alpha present
-                    // unfortunately you have to read a block to figure out which
-                    // Note that we upgrade to 32-bit pixel formats here, even 
-                    // though the source is 16-bit; this is because the interpolated
-                    // values will benefit from the 32-bit results, and the source
-                    // from which the 16-bit samples are calculated may have been
-                    // 32-bit so can benefit from this.
-                    DXTColourBlock block;
-                    stream->read(&block, sizeof(DXTColourBlock));
-                    flipEndian(&(block.colour_0), sizeof(uint16));
-                    flipEndian(&(block.colour_1), sizeof(uint16));
-                    // skip back since we'll need to read this again
-                    stream->skip(0 - (long)sizeof(DXTColourBlock));
-                    // colour_0 <= colour_1 means transparency in DXT1
-                    if (block.colour_0 <= block.colour_1)
-                    {
-                        imgData->format = BYTE_RGBA;
-                    }
-                    else
-                    {
-                        imgData->format = BYTE_RGB;
-                    }
-                    break;
-                case DXT2:
-                case DXT3:
-                case DXT4:
-                case DXT5:
-                    // full alpha present, formats vary only in encoding 
-                    imgData->format = BYTE_RGBA;
-                    break;
-                default:
-                    // all other cases need no special format handling
-                    break;
-                }
-            }
-            else
-            {
-                // Use original format
-                imgData->format = sourceFormat;
-                // Keep DXT data compressed
-                imgData->flags |= ImageFlags::COMPRESSED;
-            }
-        }
-        else // not compressed
-        {
-            // Don't test against DDPF_RGB since greyscale DDS doesn't set this
-            // just derive any other kind of format
-            imgData->format = sourceFormat;
-        }
+            imgData->flags |= ImageFlags::COMPRESSED;
 
         // Calculate total size from number of mipmaps, faces and size
         imgData->size = Image::calculateSize(imgData->num_mipmaps, numFaces, 
@@ -934,105 +783,11 @@ namespace {
                 
                 if (PixelUtil::isCompressed(sourceFormat))
                 {
-                    // Compressed data
-                    if (decompressDXT)
-                    {
-                        DXTColourBlock col;
-                        DXTInterpolatedAlphaBlock iAlpha;
-                        DXTExplicitAlphaBlock eAlpha;
-                        // 4x4 block of decompressed colour
-                        ColourValue tempColours[16];
-                        size_t destBpp = PixelUtil::getNumElemBytes(imgData->format);
-
-                        // slices are done individually
-                        for(size_t z = 0; z < depth; ++z)
-                        {
-                            size_t remainingHeight = height;
-
-                            // 4x4 blocks in x/y
-                            for (size_t y = 0; y < height; y += 4)
-                            {
-                                size_t sy = std::min<size_t>( remainingHeight, 4u );
-                                remainingHeight -= sy;
-
-                                size_t remainingWidth = width;
-
-                                for (size_t x = 0; x < width; x += 4)
-                                {
-                                    size_t sx = std::min<size_t>( remainingWidth, 4u );
-                                    size_t destPitchMinus4 = dstPitch - destBpp * sx;
-
-                                    remainingWidth -= sx;
-
-                                    if (sourceFormat == PixelFormat::DXT2 || 
-                                        sourceFormat == PixelFormat::DXT3)
-                                    {
-                                        // explicit alpha
-                                        stream->read(&eAlpha, sizeof(DXTExplicitAlphaBlock));
-                                        flipEndian(eAlpha.alphaRow, sizeof(uint16), 4);
-                                        unpackDXTAlpha(eAlpha, tempColours) ;
-                                    }
-                                    else if (sourceFormat == PixelFormat::DXT4 || 
-                                        sourceFormat == PixelFormat::DXT5)
-                                    {
-                                        // interpolated alpha
-                                        stream->read(&iAlpha, sizeof(DXTInterpolatedAlphaBlock));
-                                        flipEndian(&(iAlpha.alpha_0), sizeof(uint16));
-                                        flipEndian(&(iAlpha.alpha_1), sizeof(uint16));
-                                        unpackDXTAlpha(iAlpha, tempColours) ;
-                                    }
-                                    // always read colour
-                                    stream->read(&col, sizeof(DXTColourBlock));
-                                    flipEndian(&(col.colour_0), sizeof(uint16));
-                                    flipEndian(&(col.colour_1), sizeof(uint16));
-                                    unpackDXTColour(sourceFormat, col, tempColours);
-
-                                    // write 4x4 block to uncompressed version
-                                    for (size_t by = 0; by < sy; ++by)
-                                    {
-                                        for (size_t bx = 0; bx < sx; ++bx)
-                                        {
-                                            PixelUtil::packColour(tempColours[by*4+bx],
-                                                imgData->format, destPtr);
-                                            destPtr = static_cast<void*>(
-                                                static_cast<uchar*>(destPtr) + destBpp);
-                                        }
-                                        // advance to next row
-                                        destPtr = static_cast<void*>(
-                                            static_cast<uchar*>(destPtr) + destPitchMinus4);
-                                    }
-                                    // next block. Our dest pointer is 4 lines down
-                                    // from where it started
-                                    if (x + 4 >= width)
-                                    {
-                                        // Jump back to the start of the line
-                                        destPtr = static_cast<void*>(
-                                            static_cast<uchar*>(destPtr) - destPitchMinus4);
-                                    }
-                                    else
-                                    {
-                                        // Jump back up 4 rows and 4 pixels to the
-                                        // right to be at the next block to the right
-                                        destPtr = static_cast<void*>(
-                                            static_cast<uchar*>(destPtr) - dstPitch * sy + destBpp * sx);
-
-                                    }
-
-                                }
-
-                            }
-                        }
-
-                    }
-                    else
-                    {
-                        // load directly
-                        // DDS format lies! sizeOrPitch is not always set for DXT!!
-                        size_t dxtSize = PixelUtil::getMemorySize(width, height, depth, imgData->format);
-                        stream->read(destPtr, dxtSize);
-                        destPtr = static_cast<void*>(static_cast<uchar*>(destPtr) + dxtSize);
-                    }
-
+                    // load directly
+                    // DDS format lies! sizeOrPitch is not always set for DXT!!
+                    size_t dxtSize = PixelUtil::getMemorySize(width, height, depth, imgData->format);
+                    stream->read(destPtr, dxtSize);
+                    destPtr = static_cast<void*>(static_cast<uchar*>(destPtr) + dxtSize);
                 }
                 else
                 {
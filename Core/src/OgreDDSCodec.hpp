@@ -44,12 +44,6 @@ namespace Ogre {
     *  @{
     */
 
-    // Forward declarations
-    struct DXTColourBlock;
-    struct DXTExplicitAlphaBlock;
-    struct DXTInterpolatedAlphaBlock;
-struct ColourValue;
-
     /** Codec specialized in loading DDS (Direct Draw Surface) images.
     @remarks
         We implement our own codec here since we need to be able to keep DXT
@@ -65,13 +59,6 @@ struct ColourValue;
         [[nodiscard]] auto convertPixelFormat(uint32 rgbBits, uint32 rMask,
             uint32 gMask, uint32 bMask, uint32 aMask) const -> PixelFormat;
 
-        /// Unpack DXT colours into array of 16 colour values
-        void unpackDXTColour(PixelFormat pf, const DXTColourBlock& block, ColourValue* pCol) const;
-        /// Unpack DXT alphas into array of 16 colour values
-        void unpackDXTAlpha(const DXTExplicitAlphaBlock& block, ColourValue* pCol) const;
-        /// Unpack DXT alphas into array of 16 colour values
-        void unpackDXTAlpha(const DXTInterpolatedAlphaBlock& block, ColourValue* pCol) const;
-
         /// Single registered codec instance
         static DDSCodec* msInstance;
     public:
@@ -82,6 +69,7 @@ struct ColourValue;
         using ImageCodec::encode;
         using ImageCodec::encodeToFile;
 
+        [[nodiscard]] auto encode(const MemoryDataStreamPtr& input, const CodecDataPtr& pData) const -> DataStreamPtr override;
         void encodeToFile(const MemoryDataStreamPtr& input, std::string_view outFileName, const CodecDataPtr& pData) const override;
         [[nodiscard]] auto decode(const DataStreamPtr& input) const -> DecodeResult override;
         auto magicNumberToFileExt(const char *magicNumberPtr, size_t maxbytes) const -> std::string_view override;
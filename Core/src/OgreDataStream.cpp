@@ -42,6 +42,7 @@ import :SharedPtr;
 import :String;
 
 import <algorithm>;
+import <format>;
 import <fstream>;
 import <string>;
 
@@ -225,6 +226,15 @@ namespace Ogre {
         assert(mEnd >= mPos);
     }
     //-----------------------------------------------------------------------
+    MemoryDataStream::MemoryDataStream(std::string_view name, ::std::shared_ptr<uchar> data, size_t inSize)
+        : DataStream(name, std::to_underlying(READ)), mSharedData(::std::move(data))
+    {
+        mData = mPos = mSharedData.get();
+        mSize = inSize;
+        mEnd = mData + mSize;
+        mFreeOnClose = false;
+    }
+    //-----------------------------------------------------------------------
     MemoryDataStream::MemoryDataStream(DataStream& sourceStream, 
         bool freeOnClose, bool readOnly)
         : DataStream(static_cast<uint16>(readOnly ? READ : (READ | WRITE)))
@@ -236,14 +246,14 @@ namespace Ogre {
             // size of source is unknown, read all of it into memory
             String contents = sourceStream.getAsString();
             mSize = contents.size();
-            mData = new  uchar[mSize];
+            mData = static_cast<uchar*>(malloc(mSize));
             mPos = mData;
             memcpy(mData, contents.data(), mSize);
             mEnd = mData + mSize;
         }
         else
         {
-            mData = new uchar[mSize];
+            mData = static_cast<uchar*>(malloc(mSize));
             mPos = mData;
             mEnd = mData + sourceStream.read(mData, mSize);
         }
@@ -288,14 +298,14 @@ namespace Ogre {
             // size of source is unknown, read all of it into memory
             String contents = sourceStream.getAsString();
             mSize = contents.size();
-            mData = new uchar[mSize];
+            mData = static_cast<uchar*>(malloc(mSize));
             mPos = mData;
             memcpy(mData, contents.data(), mSize);
             mEnd = mData + mSize;
         }
         else
         {
-            mData = new uchar[mSize];
+            mData = static_cast<uchar*>(malloc(mSize));
             mPos = mData;
             mEnd = mData + sourceStream.read(mData, mSize);
         }
@@ -314,7 +324,7 @@ namespace Ogre {
             // size of source is unknown, read all of it into memory
             String contents = sourceStream->getAsString();
             mSize = contents.size();
-            mData = new uchar[mSize];
+            mData = static_cast<uchar*>(malloc(mSize));
             mPos = mData;
             memcpy(mData, contents.data(), mSize);
             mEnd = mData + mSize;
@@ -345,7 +355,7 @@ namespace Ogre {
         : DataStream(name, static_cast<uint16>(readOnly ? READ : (READ | WRITE)))
     {
         mSize = inSize;
-        mData = new uchar[mSize];
+        mData = static_cast<uchar*>(malloc(mSize));
         mPos = mData;
         mEnd = mData + mSize;
         mFreeOnClose = freeOnClose;
@@ -477,11 +487,35 @@ namespace Ogre {
     void MemoryDataStream::close()    
     {
         mAccess = 0;
-        if (mFreeOnClose && mData)
+        if (mFreeOnClose && mData && !mSharedData)
         {
             free(mData);
             mData = nullptr;
         }
+        mSharedData.reset();
+    }
+    //-----------------------------------------------------------------------
+    auto MemoryDataStream::subStream(size_t offset, size_t length) -> MemoryDataStreamPtr
+    {
+        auto const available = static_cast<size_t>(mEnd - mData);
+        if (offset > available || length > available - offset)
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                        ::std::format("Range {}+{} exceeds the {} bytes of stream '{}'", offset, length, available, mName),
+                        "MemoryDataStream::subStream");
+        }
+
+        // Hand the memory over to a reference count, so slices can outlive this stream
+        if (!mSharedData && mFreeOnClose && mData)
+        {
+            mSharedData.reset(mData, [](uchar* p) { free(p); });
+            mFreeOnClose = false;
+        }
+
+        if (!mSharedData)
+            return ::std::make_shared<MemoryDataStream>(mName, mData + offset, length, false, true);
+
+        return ::std::make_shared<MemoryDataStream>(mName, ::std::shared_ptr<uchar>(mSharedData, mData + offset), length);
     }
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
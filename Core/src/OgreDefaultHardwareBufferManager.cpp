@@ -45,9 +45,17 @@ namespace Ogre {
         mData = (uchar*)AlignedMemory::allocate(mSizeInBytes);
     }
     //-----------------------------------------------------------------------
+    DefaultHardwareBuffer::DefaultHardwareBuffer(::std::shared_ptr<uchar> data, size_t sizeInBytes)
+    : HardwareBuffer(HardwareBufferUsage::CPU_ONLY, true, false), mSharedData(::std::move(data))
+    {
+        mSizeInBytes = sizeInBytes;
+        mData = mSharedData.get();
+    }
+    //-----------------------------------------------------------------------
     DefaultHardwareBuffer::~DefaultHardwareBuffer()
     {
-        AlignedMemory::deallocate(mData);
+        if (!mSharedData)
+            AlignedMemory::deallocate(mData);
     }
     //-----------------------------------------------------------------------
     auto DefaultHardwareBuffer::lockImpl(size_t offset, size_t length, LockOptions options) -> void*
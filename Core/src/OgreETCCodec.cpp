@@ -175,7 +175,8 @@ namespace Ogre {
             if (PKM_MAGIC == fileType)
                 return {"pkm"};
 
-            if (KTX_MAGIC == fileType)
+            // the identifier continues with the version, "20" belongs to the KTX2 codec
+            if (KTX_MAGIC == fileType && (maxbytes < 6 || magicNumberPtr[5] == '1'))
                 return {"ktx"};
         }
 
@@ -242,8 +243,8 @@ namespace Ogre {
         // ETC is a compressed format
         imgData->flags |= ImageFlags::COMPRESSED;
 
-        // Calculate total size from number of mipmaps, faces and size
-        imgData->size = (paddedWidth * paddedHeight) >> 1;
+        // Calculate total size from number of mipmaps, faces and size, EAC alpha doubles it
+        imgData->size = PixelUtil::getMemorySize(paddedWidth, paddedHeight, 1, imgData->format);
 
         // Bind output buffer
         MemoryDataStreamPtr output(new MemoryDataStream(imgData->size));
@@ -253,9 +254,8 @@ namespace Ogre {
         stream->read(destPtr, imgData->size);
         destPtr = static_cast<void*>(static_cast<uchar*>(destPtr));
 
-        DecodeResult ret;
-        ret.first = output;
-        ret.second = CodecDataPtr(imgData);
+        result.first = output;
+        result.second = CodecDataPtr(imgData);
 
         return true;
     }
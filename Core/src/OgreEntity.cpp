@@ -95,6 +95,7 @@ namespace Ogre {
           mUpdateBoundingBoxFromSkeleton(false),
           mVertexProgramInUse(false),
           mInitialised(false),
+          mMeshletCulling(false),
           mHardwarePoseCount(0),
           mNumBoneMatrices(0),
           mBoneWorldMatrices(nullptr),
@@ -455,6 +456,9 @@ namespace Ogre {
 
                 // Also invalidate any camera distance cache
                 i->_invalidateCameraCache ();
+
+                // Compact the visible clusters for this camera
+                i->_cullMeshlets(cam);
             }
 
 
@@ -466,6 +470,16 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void Entity::setMeshletCullingEnabled(bool enabled)
+    {
+        mMeshletCulling = enabled;
+        if (!enabled)
+        {
+            for (auto & i : mSubEntityList)
+                i->mMeshletsCulled = false;
+        }
+    }
+    //-----------------------------------------------------------------------
     void Entity::setUpdateBoundingBoxFromSkeleton(bool update)
     {
         mUpdateBoundingBoxFromSkeleton = update;
@@ -647,7 +661,7 @@ namespace Ogre {
         // Add each visible SubEntity to the queue
         for (auto & i : displayEntity->mSubEntityList)
         {
-            if(i->isVisible())
+            if(i->isVisible() && !i->_isMeshletCulledAway())
             {
                 // Order: first use subentity queue settings, if available
                 //        if not then use entity queue settings, if available
@@ -30,9 +30,15 @@ module;
 #include <cstdint>
 #include <cstdio>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 module Ogre.Core;
 
 import :Archive;
+import :AsyncIO;
 import :DataStream;
 import :Exception;
 import :FileSystem;
@@ -113,6 +119,8 @@ namespace {
     };
 
     bool gIgnoreHidden = true;
+    bool gMapFiles = false;
+    bool gAsyncStreams = false;
 }
 
     //-----------------------------------------------------------------------
@@ -314,6 +322,11 @@ namespace {
 
         if(!readOnly) mode |= std::ios::out;
 
+        if (readOnly && gMapFiles)
+            return _openMappedFileStream(concatenate_path(mName, filename).native(), filename);
+        if (readOnly && gAsyncStreams)
+            return _openAsyncFileStream(concatenate_path(mName, filename).native(), filename);
+
         return _openFileStream(concatenate_path(mName, filename), mode, std::filesystem::path{filename});
     }
 
@@ -322,6 +335,63 @@ namespace {
         return _openFileStream(std::filesystem::path{full_path}, mode, std::filesystem::path{name});
     }
 
+    //---------------------------------------------------------------------
+    auto _openMappedFileStream(std::string_view full_path, std::string_view name) -> DataStreamPtr
+    {
+        String path{full_path};
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            OGRE_EXCEPT(ExceptionCodes::FILE_NOT_FOUND, ::std::format("Cannot open file: {}", full_path));
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            OGRE_EXCEPT(ExceptionCodes::FILE_NOT_FOUND, ::std::format("Cannot stat file: {}", full_path));
+        }
+
+        auto size = static_cast<size_t>(st.st_size);
+        ::std::shared_ptr<uchar> data;
+        if (size > 0)
+        {
+            // private writable mapping: pages are copied on write and never reach the file
+            void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED)
+            {
+                ::close(fd);
+                OGRE_EXCEPT(ExceptionCodes::INTERNAL_ERROR, ::std::format("Cannot map file: {}", full_path));
+            }
+            data.reset(static_cast<uchar*>(addr), [size](uchar* p) { ::munmap(p, size); });
+        }
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+
+        return DataStreamPtr(new MemoryDataStream(name.empty() ? full_path : name, ::std::move(data), size));
+    }
+    //---------------------------------------------------------------------
+    auto _openAsyncFileStream(std::string_view full_path, std::string_view name) -> DataStreamPtr
+    {
+        String path{full_path};
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            OGRE_EXCEPT(ExceptionCodes::FILE_NOT_FOUND, ::std::format("Cannot open file: {}", full_path));
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            OGRE_EXCEPT(ExceptionCodes::FILE_NOT_FOUND, ::std::format("Cannot stat file: {}", full_path));
+        }
+
+        // the stream does its own read-ahead
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_RANDOM);
+
+        return DataStreamPtr(new AsyncFileDataStream(name.empty() ? full_path : name, fd, size_t(st.st_size)));
+    }
     //---------------------------------------------------------------------
     auto FileSystemArchive::create(std::string_view filename) -> DataStreamPtr
     {
@@ -463,4 +533,24 @@ namespace {
     {
         return gIgnoreHidden;
     }
+
+    void FileSystemArchiveFactory::setMapFiles(bool map)
+    {
+        gMapFiles = map;
+    }
+
+    auto FileSystemArchiveFactory::getMapFiles() noexcept -> bool
+    {
+        return gMapFiles;
+    }
+
+    void FileSystemArchiveFactory::setAsyncStreams(bool async)
+    {
+        gAsyncStreams = async;
+    }
+
+    auto FileSystemArchiveFactory::getAsyncStreams() noexcept -> bool
+    {
+        return gAsyncStreams;
+    }
 }
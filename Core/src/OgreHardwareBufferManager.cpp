@@ -43,6 +43,8 @@ import :SharedPtr;
 import :Singleton;
 import :VertexIndexData;
 
+import <algorithm>;
+import <array>;
 import <list>;
 import <map>;
 import <memory>;
@@ -81,6 +83,7 @@ namespace Ogre {
     HardwareBufferManagerBase::~HardwareBufferManagerBase()
     {
         // Destroy everything
+        destroyAllStreamingBuffers();
         destroyAllDeclarations();
         destroyAllBindings();
         // No need to destroy main buffers - they will be destroyed by removal of bindings
@@ -155,6 +158,25 @@ namespace Ogre {
         mVertexBufferBindings.clear();
     }
     //-----------------------------------------------------------------------
+    void HardwareBufferManagerBase::destroyAllStreamingBuffers()
+    {
+        mStreamingVertexBuffers.clear();
+    }
+    //-----------------------------------------------------------------------
+    auto HardwareBufferManagerBase::getStreamingVertexBuffer(size_t vertexSize, size_t initialVertices) -> StreamingVertexBuffer&
+    {
+        auto& ring = mStreamingVertexBuffers[vertexSize];
+        if (!ring)
+            ring = std::make_unique<StreamingVertexBuffer>(this, vertexSize, initialVertices);
+        return *ring;
+    }
+    //-----------------------------------------------------------------------
+    void HardwareBufferManagerBase::_notifyStreamingFrameEnded()
+    {
+        for (auto const& [vertexSize, ring] : mStreamingVertexBuffers)
+            ring->_notifyFrameEnded();
+    }
+    //-----------------------------------------------------------------------
     void HardwareBufferManagerBase::registerVertexBufferSourceAndCopy(
             const HardwareVertexBufferSharedPtr& sourceBuffer,
             const HardwareVertexBufferSharedPtr& copy)
@@ -418,6 +440,91 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     //-----------------------------------------------------------------------------
     //-----------------------------------------------------------------------------
+    StreamingVertexBuffer::StreamingVertexBuffer(HardwareBufferManagerBase* mgr, size_t vertexSize,
+                                                 size_t initialVertices)
+        : mMgr(mgr)
+        , mVertexSize(vertexSize)
+    {
+        grow(initialVertices);
+    }
+    //-----------------------------------------------------------------------------
+    void StreamingVertexBuffer::grow(size_t minVertices)
+    {
+        // Leave room for every frame kept to use the same amount again
+        mCapacity = std::max(mCapacity * 2, minVertices * mFrameUsage.size());
+        // Allocations made earlier keep the old buffer alive until they are rebound
+        mBuffer = mMgr->createVertexBuffer(mVertexSize, mCapacity, HardwareBuffer::DYNAMIC_WRITE_ONLY);
+        mHead = 0;
+        mFrameUsage.fill(0);
+    }
+    //-----------------------------------------------------------------------------
+    auto StreamingVertexBuffer::allocate(size_t vertexCount) -> Allocation
+    {
+        size_t& frameUsage = mFrameUsage[mFrame % mFrameUsage.size()];
+        size_t used = 0;
+        for (size_t usage : mFrameUsage)
+            used += usage;
+        size_t free = mCapacity - used;
+
+        if (mHead + vertexCount <= mCapacity && vertexCount <= free)
+        {
+            // fits behind the head
+        }
+        else if (mCapacity - mHead + vertexCount <= free)
+        {
+            // wrap around, the skipped tail end counts as used by this frame
+            frameUsage += mCapacity - mHead;
+            mHead = 0;
+        }
+        else
+        {
+            grow(vertexCount);
+        }
+
+        Allocation ret;
+        ret.buffer = mBuffer;
+        ret.vertexStart = mHead;
+        ret.vertexCount = vertexCount;
+        ret.frame = mFrame;
+
+        mHead += vertexCount;
+        frameUsage += vertexCount;
+        return ret;
+    }
+    //-----------------------------------------------------------------------------
+    auto StreamingVertexBuffer::lock(const Allocation& alloc) -> void*
+    {
+        size_t vertexSize = alloc.buffer->getVertexSize();
+        return alloc.buffer->lock(alloc.vertexStart * vertexSize, alloc.vertexCount * vertexSize,
+                                  HardwareBuffer::LockOptions::NO_OVERWRITE);
+    }
+    //-----------------------------------------------------------------------------
+    auto StreamingVertexBuffer::lock(const Allocation& alloc, size_t firstVertex, size_t vertexCount) -> void*
+    {
+        assert(firstVertex + vertexCount <= alloc.vertexCount);
+        size_t vertexSize = alloc.buffer->getVertexSize();
+        return alloc.buffer->lock((alloc.vertexStart + firstVertex) * vertexSize, vertexCount * vertexSize,
+                                  HardwareBuffer::LockOptions::NO_OVERWRITE);
+    }
+    //-----------------------------------------------------------------------------
+    void StreamingVertexBuffer::copy(const Allocation& src, size_t srcVertex, const Allocation& dst,
+                                     size_t dstVertex, size_t vertexCount)
+    {
+        assert(srcVertex + vertexCount <= src.vertexCount && dstVertex + vertexCount <= dst.vertexCount);
+        size_t vertexSize = dst.buffer->getVertexSize();
+        dst.buffer->copyData(*src.buffer, (src.vertexStart + srcVertex) * vertexSize,
+                             (dst.vertexStart + dstVertex) * vertexSize, vertexCount * vertexSize);
+    }
+    //-----------------------------------------------------------------------------
+    void StreamingVertexBuffer::_notifyFrameEnded()
+    {
+        ++mFrame;
+        // the oldest frame kept is done and no longer copied from, its range can be reused
+        mFrameUsage[mFrame % mFrameUsage.size()] = 0;
+    }
+    //-----------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------
     TempBlendedBufferInfo::~TempBlendedBufferInfo()
     {
         // check that temp buffers have been released
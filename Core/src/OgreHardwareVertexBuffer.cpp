@@ -28,9 +28,12 @@ THE SOFTWARE.
 module;
 
 #include <cassert>
+#include <cmath>
+#include <cstring>
 
 module Ogre.Core;
 
+import :Bitwise;
 import :DefaultHardwareBufferManager;
 import :Exception;
 import :HardwareBufferManager;
@@ -42,6 +45,7 @@ import :StringConverter;
 
 import <algorithm>;
 import <iterator>;
+import <map>;
 import <memory>;
 import <string>;
 
@@ -162,19 +166,23 @@ namespace Ogre {
             return sizeof(double)*4;
         case SHORT1:
         case USHORT1:
+        case HALF1:
             return sizeof( short );
         case SHORT2:
         case SHORT2_NORM:
         case USHORT2:
         case USHORT2_NORM:
+        case HALF2:
             return sizeof( short ) * 2;
         case SHORT3:
         case USHORT3:
+        case HALF3:
             return sizeof( short ) * 3;
         case SHORT4:
         case SHORT4_NORM:
         case USHORT4:
         case USHORT4_NORM:
+        case HALF4:
             return sizeof( short ) * 4;
         case INT1:
         case UINT1:
@@ -209,6 +217,7 @@ namespace Ogre {
         case UINT1:
         case INT1:
         case DOUBLE1:
+        case HALF1:
             return 1;
         case FLOAT2:
         case SHORT2:
@@ -218,6 +227,7 @@ namespace Ogre {
         case UINT2:
         case INT2:
         case DOUBLE2:
+        case HALF2:
             return 2;
         case FLOAT3:
         case SHORT3:
@@ -225,6 +235,7 @@ namespace Ogre {
         case UINT3:
         case INT3:
         case DOUBLE3:
+        case HALF3:
             return 3;
         case FLOAT4:
         case SHORT4:
@@ -234,6 +245,7 @@ namespace Ogre {
         case UINT4:
         case INT4:
         case DOUBLE4:
+        case HALF4:
         case BYTE4:
         case UBYTE4:
         case BYTE4_NORM:
@@ -257,6 +269,7 @@ namespace Ogre {
         case DOUBLE1:
         case INT1:
         case UINT1:
+        case HALF1:
             // evil enumeration arithmetic
             return static_cast<VertexElementType>( std::to_underlying(baseType) + count - 1 );
 
@@ -316,7 +329,173 @@ namespace Ogre {
 
         // Conversion between ARGB and ABGR is always a case of flipping R/B
         *ptr = 
-           ((*ptr&0x00FF0000)>>16)|((*ptr&0x000000FF)<<16)|(*ptr&0xFF00FF00);               
+           ((*ptr&0x00FF0000)>>16)|((*ptr&0x000000FF)<<16)|(*ptr&0xFF00FF00);
+    }
+    //-----------------------------------------------------------------------------
+    auto VertexElement::isOctahedral() const noexcept -> bool
+    {
+        using enum VertexElementSemantic;
+        if (mSemantic != NORMAL && mSemantic != TANGENT && mSemantic != BINORMAL)
+            return false;
+
+        return mType == VertexElementType::SHORT2_NORM || mType == VertexElementType::SHORT4_NORM ||
+               mType == VertexElementType::BYTE4_NORM;
+    }
+    //-----------------------------------------------------------------------------
+    void VertexElement::encodeOctahedral(const float* dir, float* pOut)
+    {
+        float l1 = std::abs(dir[0]) + std::abs(dir[1]) + std::abs(dir[2]);
+        if (l1 == 0)
+        {
+            pOut[0] = pOut[1] = 0;
+            return;
+        }
+
+        float x = dir[0] / l1;
+        float y = dir[1] / l1;
+        if (dir[2] < 0)
+        {
+            // fold the lower hemisphere over the diagonals
+            float fx = (1 - std::abs(y)) * (x >= 0 ? 1 : -1);
+            float fy = (1 - std::abs(x)) * (y >= 0 ? 1 : -1);
+            x = fx;
+            y = fy;
+        }
+        pOut[0] = x;
+        pOut[1] = y;
+    }
+    //-----------------------------------------------------------------------------
+    void VertexElement::decodeOctahedral(const float* oct, float* pOut)
+    {
+        float x = oct[0];
+        float y = oct[1];
+        float z = 1 - std::abs(x) - std::abs(y);
+        float t = std::max(-z, 0.0f);
+        x += x >= 0 ? -t : t;
+        y += y >= 0 ? -t : t;
+
+        float len = std::sqrt(x * x + y * y + z * z);
+        pOut[0] = x / len;
+        pOut[1] = y / len;
+        pOut[2] = z / len;
+    }
+    //-----------------------------------------------------------------------------
+    void VertexElement::readFloats(const void* pElem, float* pOut) const
+    {
+        pOut[0] = pOut[1] = pOut[2] = 0;
+        pOut[3] = 1;
+
+        unsigned short count = getTypeCount(mType);
+        float values[4];
+        auto pSrc = static_cast<const uchar*>(pElem);
+
+        switch (getBaseType(mType))
+        {
+        using enum VertexElementType;
+        case FLOAT1:
+            memcpy(values, pSrc, sizeof(float) * count);
+            break;
+        case HALF1:
+            for (unsigned short i = 0; i < count; ++i)
+            {
+                uint16 h;
+                memcpy(&h, pSrc + i * sizeof(uint16), sizeof(uint16));
+                values[i] = Bitwise::halfToFloat(h);
+            }
+            break;
+        case SHORT2_NORM:
+            for (unsigned short i = 0; i < count; ++i)
+            {
+                int16 v;
+                memcpy(&v, pSrc + i * sizeof(int16), sizeof(int16));
+                values[i] = std::max(v / 32767.0f, -1.0f);
+            }
+            break;
+        case USHORT2_NORM:
+            for (unsigned short i = 0; i < count; ++i)
+            {
+                uint16 v;
+                memcpy(&v, pSrc + i * sizeof(uint16), sizeof(uint16));
+                values[i] = v / 65535.0f;
+            }
+            break;
+        case BYTE4_NORM:
+            for (unsigned short i = 0; i < count; ++i)
+                values[i] = std::max(static_cast<int8>(pSrc[i]) / 127.0f, -1.0f);
+            break;
+        case UBYTE4_NORM:
+            for (unsigned short i = 0; i < count; ++i)
+                values[i] = pSrc[i] / 255.0f;
+            break;
+        default:
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Unsupported vertex element type",
+                "VertexElement::readFloats");
+        }
+
+        if (isOctahedral())
+        {
+            decodeOctahedral(values, pOut);
+            if (count == 4)
+                pOut[3] = values[3];
+            return;
+        }
+
+        std::copy(values, values + count, pOut);
+    }
+    //-----------------------------------------------------------------------------
+    void VertexElement::writeFloats(void* pElem, const float* pIn) const
+    {
+        unsigned short count = getTypeCount(mType);
+        float values[4] = {pIn[0], count > 1 ? pIn[1] : 0, count > 2 ? pIn[2] : 0, count > 3 ? pIn[3] : 1};
+        if (isOctahedral())
+        {
+            encodeOctahedral(pIn, values);
+            values[2] = 0;
+            // keep the tangent handedness
+            values[3] = count == 4 ? pIn[3] : 0;
+        }
+
+        auto pDst = static_cast<uchar*>(pElem);
+
+        switch (getBaseType(mType))
+        {
+        using enum VertexElementType;
+        case FLOAT1:
+            memcpy(pDst, values, sizeof(float) * count);
+            break;
+        case HALF1:
+            for (unsigned short i = 0; i < count; ++i)
+            {
+                uint16 h = Bitwise::floatToHalf(values[i]);
+                memcpy(pDst + i * sizeof(uint16), &h, sizeof(uint16));
+            }
+            break;
+        case SHORT2_NORM:
+            for (unsigned short i = 0; i < count; ++i)
+            {
+                auto v = static_cast<int16>(std::lround(std::clamp(values[i], -1.0f, 1.0f) * 32767));
+                memcpy(pDst + i * sizeof(int16), &v, sizeof(int16));
+            }
+            break;
+        case USHORT2_NORM:
+            for (unsigned short i = 0; i < count; ++i)
+            {
+                auto v = static_cast<uint16>(std::lround(std::clamp(values[i], 0.0f, 1.0f) * 65535));
+                memcpy(pDst + i * sizeof(uint16), &v, sizeof(uint16));
+            }
+            break;
+        case BYTE4_NORM:
+            for (unsigned short i = 0; i < count; ++i)
+                pDst[i] = static_cast<uchar>(static_cast<int8>(std::lround(std::clamp(values[i], -1.0f, 1.0f) * 127)));
+            break;
+        case UBYTE4_NORM:
+            for (unsigned short i = 0; i < count; ++i)
+                pDst[i] = static_cast<uchar>(std::lround(std::clamp(values[i], 0.0f, 1.0f) * 255));
+            break;
+        default:
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Unsupported vertex element type",
+                "VertexElement::writeFloats");
+        }
     }
     //-----------------------------------------------------------------------------
     auto VertexElement::getBaseType(VertexElementType multiType) -> VertexElementType
@@ -360,6 +539,11 @@ namespace Ogre {
             case USHORT2_NORM:
             case USHORT4_NORM:
                 return USHORT2_NORM;
+            case HALF1:
+            case HALF2:
+            case HALF3:
+            case HALF4:
+                return HALF1;
             case BYTE4:
                 return BYTE4;
             case BYTE4_NORM:
@@ -674,6 +858,51 @@ namespace Ogre {
         return newDecl;
 
 
+    }
+    //-----------------------------------------------------------------------------
+    auto VertexDeclaration::getQuantisedDeclaration(bool compactDirections) const -> VertexDeclaration*
+    {
+        VertexDeclaration* newDecl = this->clone();
+        const VertexDeclaration::VertexElementList& elems = newDecl->getElements();
+
+        // Offsets are reassigned per source in the current element order
+        std::map<unsigned short, size_t> offsets;
+        for (unsigned short c = 0;
+             const auto & elem : elems)
+        {
+            VertexElementType type = elem.getType();
+            bool isFloat = VertexElement::getBaseType(type) == VertexElementType::FLOAT1;
+            using enum VertexElementSemantic;
+            switch (elem.getSemantic())
+            {
+            case POSITION:
+                if (type == VertexElementType::FLOAT3)
+                    type = VertexElementType::SHORT4_NORM;
+                break;
+            case NORMAL:
+                if (type == VertexElementType::FLOAT3)
+                    type = compactDirections ? VertexElementType::BYTE4_NORM : VertexElementType::SHORT2_NORM;
+                break;
+            case TANGENT:
+            case BINORMAL:
+                if (type == VertexElementType::FLOAT3 || type == VertexElementType::FLOAT4)
+                    type = compactDirections ? VertexElementType::BYTE4_NORM : VertexElementType::SHORT4_NORM;
+                break;
+            case TEXTURE_COORDINATES:
+                if (isFloat)
+                    type = VertexElement::getTypeCount(type) <= 2 ? VertexElementType::HALF2 : VertexElementType::HALF4;
+                break;
+            default:
+                break;
+            }
+
+            size_t& offset = offsets[elem.getSource()];
+            newDecl->modifyElement(c, elem.getSource(), offset, type, elem.getSemantic(), elem.getIndex());
+            offset += VertexElement::getTypeSize(type);
+            ++c;
+        }
+
+        return newDecl;
     }
     //-----------------------------------------------------------------------------
     auto VertexDeclaration::getMaxSource() const noexcept -> unsigned short
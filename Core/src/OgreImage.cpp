@@ -32,6 +32,8 @@ module;
 
 module Ogre.Core;
 
+import :BlockCompression;
+import :BlockDecompression;
 import :Codec;
 import :DataStream;
 import :Exception;
@@ -39,12 +41,14 @@ import :Image;
 import :ImageCodec;
 import :ImageResampler;
 import :Math;
+import :ParallelFor;
 import :ResourceGroupManager;
 import :SharedPtr;
 import :String;
 
 import <algorithm>;
 import <any>;
+import <format>;
 import <memory>;
 import <span>;
 
@@ -53,24 +57,41 @@ namespace Ogre {
 
     void ImageCodec::decode(const DataStreamPtr& input, ::std::any const& output) const
     {
-        auto[data, codec] = decode(input);
+        loadDecoded(decode(input), *any_cast<Image*>(output));
+    }
 
+    void ImageCodec::loadDecoded(const DecodeResult& decoded, Image& dest)
+    {
+        const auto& [data, codec] = decoded;
         auto pData = static_cast<ImageCodec::ImageData*>(codec.get());
 
-        auto* dest = any_cast<Image*>(output);
-        dest->mWidth = pData->width;
-        dest->mHeight = pData->height;
-        dest->mDepth = pData->depth;
-        dest->mBufSize = pData->size;
-        dest->mNumMipmaps = pData->num_mipmaps;
-        dest->mFlags = pData->flags;
-        dest->mFormat = pData->format;
+        dest.freeMemory();
+        dest.mWidth = pData->width;
+        dest.mHeight = pData->height;
+        dest.mDepth = pData->depth;
+        dest.mBufSize = pData->size;
+        dest.mNumMipmaps = pData->num_mipmaps;
+        dest.mFlags = pData->flags;
+        dest.mFormat = pData->format;
+        dest.mPixelSize = static_cast<uchar>(PixelUtil::getNumElemBytes(pData->format));
         // Just use internal buffer of returned memory stream
-        dest->mBuffer = data->getPtr();
+        dest.mBuffer = data->getPtr();
+        dest.mAutoDelete = true;
         // Make sure stream does not delete
         data->setFreeOnClose(false);
     }
 
+    void ImageCodec::decodeInto(const DataStreamPtr& input, const PixelBox& dst) const
+    {
+        Image img;
+        img.load(input, getType());
+        if (img.getWidth() != dst.getWidth() || img.getHeight() != dst.getHeight() ||
+            img.getDepth() != dst.getDepth())
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Destination size does not match the image",
+                        "ImageCodec::decodeInto");
+        PixelUtil::bulkPixelConversion(img.getPixelBox(), dst);
+    }
+
     auto ImageCodec::encode(::std::any const& input) const -> DataStreamPtr
     {
         auto* src = any_cast<Image*>(input);
@@ -161,7 +182,7 @@ namespace Ogre {
             free(mBuffer);
             mBuffer = nullptr;
         }
-
+        mSharedData.reset();
     }
 
     //-----------------------------------------------------------------------------
@@ -175,8 +196,10 @@ namespace Ogre {
         }
         else
         {
+            auto sharedData = img.mSharedData;
             loadDynamicImage(img.mBuffer, img.mWidth, img.mHeight, img.mDepth, img.mFormat, false,
                              img.getNumFaces(), img.mNumMipmaps);
+            mSharedData = ::std::move(sharedData);
         }
 
         return *this;
@@ -289,6 +312,14 @@ namespace Ogre {
 
         return *this;
     }
+    //-----------------------------------------------------------------------------
+    auto Image::loadDynamicImage(::std::shared_ptr<uchar> data, uint32 width, uint32 height, uint32 depth,
+                                 PixelFormat format, uint32 numFaces, TextureMipmap numMipMaps) -> Image&
+    {
+        loadDynamicImage(data.get(), width, height, depth, format, false, numFaces, numMipMaps);
+        mSharedData = ::std::move(data);
+        return *this;
+    }
 
     //-----------------------------------------------------------------------------
     auto Image::loadRawData(const DataStreamPtr& stream, uint32 uWidth, uint32 uHeight, uint32 uDepth,
@@ -482,7 +513,7 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------------
-    void Image::resize(ushort width, ushort height, Filter filter)
+    void Image::resize(ushort width, ushort height, Filter filter, bool gammaCorrect)
     {
         OgreAssert(mAutoDelete, "resizing dynamic images is not supported");
         OgreAssert(mDepth == 1, "only 2D formats supported");
@@ -497,10 +528,10 @@ namespace Ogre {
         create(mFormat, width, height); // Loses precomputed mipmaps
 
         // scale the image from temp into our resized buffer
-        Image::scale(temp.getPixelBox(), getPixelBox(), filter);
+        Image::scale(temp.getPixelBox(), getPixelBox(), filter, gammaCorrect);
     }
     //-----------------------------------------------------------------------
-    void Image::scale(const PixelBox &src, const PixelBox &scaled, Filter filter) 
+    void Image::scale(const PixelBox &src, const PixelBox &scaled, Filter filter, bool gammaCorrect) 
     {
         assert(PixelUtil::isAccessible(src.format));
         assert(PixelUtil::isAccessible(scaled.format));
@@ -510,6 +541,12 @@ namespace Ogre {
         using enum Filter;
         switch (filter) 
         {
+        case BOX:
+        case MITCHELL:
+        case LANCZOS:
+        case KAISER:
+            SeparableResampler::scale(src, scaled, filter, gammaCorrect);
+            break;
         default:
         case NEAREST:
             if(src.format != scaled.format)
@@ -541,6 +578,11 @@ namespace Ogre {
             break;
 
         case BILINEAR:
+            if (gammaCorrect && !PixelUtil::isFloatingPoint(src.format))
+            {
+                SeparableResampler::scale(src, scaled, filter, gammaCorrect);
+                break;
+            }
             switch (src.format) 
             {
                 using enum PixelFormat;
@@ -555,17 +597,20 @@ namespace Ogre {
                     buf.create(src.format, scaled.getWidth(), scaled.getHeight(), scaled.getDepth());
                     temp = buf.getPixelBox();
                 }
-                // super-optimized: byte-oriented math, no conversion
-                switch (PixelUtil::getNumElemBytes(src.format)) 
+                // super-optimized: byte-oriented math, no conversion, bands of rows in parallel
+                parallelForBands(temp.getDepth() > 1 ? 1 : temp.getHeight(), 64, [&](uint32 rowBegin, uint32 rowEnd)
                 {
-                case 1: LinearResampler_Byte<1>::scale(src, temp); break;
-                case 2: LinearResampler_Byte<2>::scale(src, temp); break;
-                case 3: LinearResampler_Byte<3>::scale(src, temp); break;
-                case 4: LinearResampler_Byte<4>::scale(src, temp); break;
-                default:
-                    // never reached
-                    assert(false);
-                }
+                    switch (PixelUtil::getNumElemBytes(src.format)) 
+                    {
+                    case 1: LinearResampler_Byte<1>::scale(src, temp, rowBegin, rowEnd); break;
+                    case 2: LinearResampler_Byte<2>::scale(src, temp, rowBegin, rowEnd); break;
+                    case 3: LinearResampler_Byte<3>::scale(src, temp, rowBegin, rowEnd); break;
+                    case 4: LinearResampler_Byte<4>::scale(src, temp, rowBegin, rowEnd); break;
+                    default:
+                        // never reached
+                        assert(false);
+                    }
+                });
                 if(temp.data != scaled.data)
                 {
                     // Blit temp buffer
@@ -589,6 +634,142 @@ namespace Ogre {
         }
     }
 
+    //-----------------------------------------------------------------------
+    auto Image::generateMipmaps(Filter filter, bool gammaCorrect, float alphaCoverageRef) -> bool
+    {
+        if (!mBuffer || !PixelUtil::isAccessible(mFormat))
+            return false;
+
+        // levels until every dimension is down to 1
+        uint32 levels = 0;
+        for (uint32 w = mWidth, h = mHeight, d = mDepth; w > 1 || h > 1 || d > 1; ++levels)
+        {
+            w = std::max(1u, w / 2);
+            h = std::max(1u, h / 2);
+            d = std::max(1u, d / 2);
+        }
+        auto const numMipmaps = static_cast<TextureMipmap>(levels);
+        uint32 const faces = getNumFaces();
+
+        if (mNumMipmaps != numMipmaps)
+        {
+            // move the top levels into a buffer with room for the whole chain
+            auto* buffer = static_cast<uchar*>(malloc(calculateSize(numMipmaps, faces, mWidth, mHeight, mDepth, mFormat)));
+            Image chain(PixelFormat::UNKNOWN);
+            chain.loadDynamicImage(buffer, mWidth, mHeight, mDepth, mFormat, false, faces, numMipmaps);
+            for (uint32 face = 0; face < faces; ++face)
+                PixelUtil::bulkPixelConversion(getPixelBox(face), chain.getPixelBox(face));
+            loadDynamicImage(buffer, mWidth, mHeight, mDepth, mFormat, true, faces, numMipmaps);
+        }
+
+        bool const alphaCoverage = alphaCoverageRef > 0.0f && PixelUtil::hasAlpha(mFormat);
+        // 8 bit per channel four byte formats can be averaged without unpacking
+        int bits[4];
+        PixelUtil::getBitDepths(mFormat, bits);
+        bool const byteChannels = PixelUtil::getNumElemBytes(mFormat) == 4 && !PixelUtil::isFloatingPoint(mFormat) &&
+            std::all_of(bits, bits + 4, [](int b) { return b == 8 || b == 0; });
+        bool const halfBox = (filter == Filter::BOX || filter == Filter::NEAREST) && !gammaCorrect && mDepth == 1 && byteChannels;
+
+        // Either the faces or the rows of each level are spread over the pool, never both.
+        // With at least as many faces as threads the faces are, and the nested row bands run
+        // inline on the thread of their face. Otherwise the faces are filtered in turn with
+        // the rows of each level in parallel.
+        auto const filterFaces = [&](uint32 faceBegin, uint32 faceEnd)
+        {
+            for (uint32 face = faceBegin; face < faceEnd; ++face)
+            {
+                for (uint32 mip = 1; mip <= levels; ++mip)
+                {
+                    PixelBox const src = getPixelBox(face, static_cast<TextureMipmap>(mip - 1));
+                    PixelBox const dst = getPixelBox(face, static_cast<TextureMipmap>(mip));
+                    if (halfBox && src.getWidth() == 2 * dst.getWidth() && src.getHeight() == 2 * dst.getHeight())
+                    {
+                        parallelForBands(dst.getHeight(), 32, [&](uint32 rowBegin, uint32 rowEnd)
+                        {
+                            HalfResampler_Byte4::scale(src, dst, rowBegin, rowEnd);
+                        });
+                    }
+                    else
+                        SeparableResampler::scale(src, dst, filter == Filter::NEAREST ? Filter::BOX : filter, gammaCorrect);
+                }
+
+                // scale alpha once the chain is built, so every level is filtered from unscaled data
+                if (alphaCoverage)
+                {
+                    float const coverage = getAlphaCoverage(getPixelBox(face), alphaCoverageRef);
+                    for (uint32 mip = 1; mip <= levels; ++mip)
+                        scaleAlphaToCoverage(getPixelBox(face, static_cast<TextureMipmap>(mip)), alphaCoverageRef, coverage);
+                }
+            }
+        };
+        if (faces >= TaskPool::get().getConcurrency())
+            parallelForBands(faces, 1, filterFaces);
+        else
+            filterFaces(0, faces);
+
+        return true;
+    }
+    //-----------------------------------------------------------------------------
+    void Image::compress(PixelFormat format, CompressionQuality quality)
+    {
+        if (!BlockCompressor::isSupported(format))
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                        ::std::format("Can not encode {}", PixelUtil::getFormatName(format)), "Image::compress");
+        if (!mBuffer || !PixelUtil::isAccessible(mFormat))
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                        ::std::format("Can not compress from {}", PixelUtil::getFormatName(mFormat)), "Image::compress");
+
+        uint32 const faces = getNumFaces();
+        auto* buffer = static_cast<uchar*>(malloc(calculateSize(mNumMipmaps, faces, mWidth, mHeight, mDepth, format)));
+        try
+        {
+            // a view of the new buffer gives the offsets of every level
+            Image compressed(PixelFormat::UNKNOWN);
+            compressed.loadDynamicImage(buffer, mWidth, mHeight, mDepth, format, false, faces, mNumMipmaps);
+            for (uint32 face = 0; face < faces; ++face)
+                for (uint32 mip = 0; mip <= static_cast<uint32>(mNumMipmaps); ++mip)
+                {
+                    auto const level = static_cast<TextureMipmap>(mip);
+                    BlockCompressor::compress(getPixelBox(face, level), compressed.getPixelBox(face, level).data, format, quality);
+                }
+        }
+        catch (...)
+        {
+            free(buffer);
+            throw;
+        }
+
+        loadDynamicImage(buffer, mWidth, mHeight, mDepth, format, true, faces, mNumMipmaps);
+    }
+    //-----------------------------------------------------------------------------
+    void Image::decompress()
+    {
+        if (!mBuffer || !BlockDecompressor::isSupported(mFormat))
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                        ::std::format("Can not decode {}", PixelUtil::getFormatName(mFormat)), "Image::decompress");
+
+        PixelFormat const format = BlockDecompressor::getDecompressedFormat(mFormat);
+        uint32 const faces = getNumFaces();
+        auto* buffer = static_cast<uchar*>(malloc(calculateSize(mNumMipmaps, faces, mWidth, mHeight, mDepth, format)));
+        try
+        {
+            Image decompressed(PixelFormat::UNKNOWN);
+            decompressed.loadDynamicImage(buffer, mWidth, mHeight, mDepth, format, false, faces, mNumMipmaps);
+            for (uint32 face = 0; face < faces; ++face)
+                for (uint32 mip = 0; mip <= static_cast<uint32>(mNumMipmaps); ++mip)
+                {
+                    auto const level = static_cast<TextureMipmap>(mip);
+                    BlockDecompressor::decompress(getPixelBox(face, level), decompressed.getPixelBox(face, level));
+                }
+        }
+        catch (...)
+        {
+            free(buffer);
+            throw;
+        }
+
+        loadDynamicImage(buffer, mWidth, mHeight, mDepth, format, true, faces, mNumMipmaps);
+    }
     //-----------------------------------------------------------------------------    
 
     auto Image::getColourAt(uint32 x, uint32 y, uint32 z) const -> ColourValue
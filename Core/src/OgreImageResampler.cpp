@@ -0,0 +1,527 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <immintrin.h>
+#include <cmath>
+#include <cstring>
+
+module Ogre.Core;
+
+import :Image;
+import :ImageResampler;
+import :ParallelFor;
+import :PixelFormat;
+import :PlatformInformation;
+import :Prerequisites;
+
+import <algorithm>;
+import <array>;
+import <numbers>;
+import <vector>;
+
+namespace Ogre {
+namespace {
+    // Working format of the separable resampler: linear RGBA floats
+    constexpr auto WORK_FORMAT = PixelFormat::FLOAT32_RGBA;
+    constexpr size_t WORK_CHANNELS = 4;
+
+    //---------------------------------------------------------------------
+    // Filter kernels, evaluated in source pixel units around the sample centre
+    struct Kernel
+    {
+        float support;
+        float (*evaluate)(float);
+    };
+
+    auto boxKernel(float x) -> float
+    {
+        // half open, so a pixel exactly between two samples counts only once
+        return (x >= -0.5f && x < 0.5f) ? 1.0f : 0.0f;
+    }
+
+    auto triangleKernel(float x) -> float
+    {
+        return std::max(0.0f, 1.0f - std::abs(x));
+    }
+
+    auto mitchellKernel(float x) -> float
+    {
+        constexpr float B = 1.0f / 3.0f, C = 1.0f / 3.0f;
+        x = std::abs(x);
+        if (x < 1.0f)
+            return ((12 - 9 * B - 6 * C) * x * x * x + (-18 + 12 * B + 6 * C) * x * x + (6 - 2 * B)) / 6;
+        if (x < 2.0f)
+            return ((-B - 6 * C) * x * x * x + (6 * B + 30 * C) * x * x + (-12 * B - 48 * C) * x + (8 * B + 24 * C)) / 6;
+        return 0.0f;
+    }
+
+    auto lanczosKernel(float x) -> float
+    {
+        constexpr float lobes = 3.0f;
+        x = std::abs(x);
+        if (x < 1e-6f)
+            return 1.0f;
+        if (x >= lobes)
+            return 0.0f;
+        float const px = std::numbers::pi_v<float> * x;
+        return lobes * std::sin(px) * std::sin(px / lobes) / (px * px);
+    }
+
+    // modified Bessel function of the first kind, order 0
+    auto besselI0(float x) -> float
+    {
+        float sum = 1.0f, term = 1.0f;
+        for (int k = 1; k < 32 && term > 1e-7f * sum; ++k)
+        {
+            float const t = x / (2.0f * k);
+            term *= t * t;
+            sum += term;
+        }
+        return sum;
+    }
+
+    auto kaiserKernel(float x) -> float
+    {
+        constexpr float width = 3.0f, alpha = 4.0f;
+        x = std::abs(x);
+        if (x >= width)
+            return 0.0f;
+        float const px = std::numbers::pi_v<float> * x;
+        float const sinc = x < 1e-6f ? 1.0f : std::sin(px) / px;
+        float const r = x / width;
+        return sinc * besselI0(alpha * std::sqrt(1.0f - r * r)) / besselI0(alpha);
+    }
+
+    auto getKernel(Image::Filter filter) -> Kernel
+    {
+        switch (filter)
+        {
+            using enum Image::Filter;
+        case NEAREST:
+        case BOX:
+            return {0.5f, &boxKernel};
+        case MITCHELL:
+            return {2.0f, &mitchellKernel};
+        case LANCZOS:
+            return {3.0f, &lanczosKernel};
+        case KAISER:
+            return {3.0f, &kaiserKernel};
+        default:
+            return {1.0f, &triangleKernel};
+        }
+    }
+
+    //---------------------------------------------------------------------
+    // Source samples and weights contributing to each destination sample along one axis
+    struct WeightTable
+    {
+        uint32 taps{0};
+        std::vector<uint32> first;
+        std::vector<uint32> count;
+        // taps weights per destination sample
+        std::vector<float> weights;
+
+        WeightTable(uint32 srcSize, uint32 dstSize, const Kernel& kernel)
+            : first(dstSize), count(dstSize)
+        {
+            float const scale = float(dstSize) / float(srcSize);
+            // widen the kernel when minifying, so every source pixel contributes
+            float const filterScale = std::max(1.0f, 1.0f / scale);
+            float const support = kernel.support * filterScale;
+
+            std::vector<std::vector<float>> windows(dstSize);
+            for (uint32 i = 0; i < dstSize; ++i)
+            {
+                float const centre = (i + 0.5f) / scale;
+                auto const lo = static_cast<int64>(std::floor(centre - support));
+                auto const hi = static_cast<int64>(std::ceil(centre + support));
+                auto const begin = static_cast<uint32>(std::clamp<int64>(lo, 0, srcSize - 1));
+                auto const end = static_cast<uint32>(std::clamp<int64>(hi, begin + 1, srcSize));
+
+                // samples outside the image are clamped to the edge
+                std::vector<float>& window = windows[i];
+                window.assign(end - begin, 0.0f);
+                float total = 0.0f;
+                for (int64 j = lo; j <= hi; ++j)
+                {
+                    float const weight = kernel.evaluate((j + 0.5f - centre) / filterScale);
+                    if (weight == 0.0f)
+                        continue;
+                    auto const index = static_cast<uint32>(std::clamp<int64>(j, begin, end - 1));
+                    window[index - begin] += weight;
+                    total += weight;
+                }
+                if (total == 0.0f)
+                {
+                    // degenerate window, fall back to the nearest sample
+                    auto const nearest = std::clamp(static_cast<uint32>(centre), begin, end - 1);
+                    window[nearest - begin] = total = 1.0f;
+                }
+                for (float& weight : window)
+                    weight /= total;
+
+                // trim zero weights from both ends of the window
+                uint32 skip = 0;
+                while (skip + 1 < window.size() && window[skip] == 0.0f)
+                    ++skip;
+                window.erase(window.begin(), window.begin() + skip);
+                while (window.size() > 1 && window.back() == 0.0f)
+                    window.pop_back();
+
+                first[i] = begin + skip;
+                count[i] = static_cast<uint32>(window.size());
+                taps = std::max(taps, count[i]);
+            }
+
+            weights.assign(size_t(dstSize) * taps, 0.0f);
+            for (uint32 i = 0; i < dstSize; ++i)
+                std::copy(windows[i].begin(), windows[i].end(), weights.begin() + size_t(i) * taps);
+        }
+    };
+
+    //---------------------------------------------------------------------
+    // sRGB transfer functions, tabulated and linearly interpolated
+    class GammaTables
+    {
+    public:
+        static constexpr uint32 SIZE = 4096;
+
+        GammaTables()
+        {
+            for (uint32 i = 0; i <= SIZE; ++i)
+            {
+                float const v = float(i) / SIZE;
+                mToLinear[i] = v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+                mToGamma[i] = v <= 0.0031308f ? v * 12.92f : 1.055f * std::pow(v, 1.0f / 2.4f) - 0.055f;
+            }
+        }
+
+        static auto get() -> const GammaTables&
+        {
+            static const GammaTables tables;
+            return tables;
+        }
+
+        void toLinear(float* rgba, size_t count) const { apply(mToLinear, rgba, count); }
+        void toGamma(float* rgba, size_t count) const { apply(mToGamma, rgba, count); }
+
+    private:
+        std::array<float, SIZE + 1> mToLinear;
+        std::array<float, SIZE + 1> mToGamma;
+
+        static void apply(const std::array<float, SIZE + 1>& table, float* rgba, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i, rgba += WORK_CHANNELS)
+            {
+                // colour channels only, alpha is linear coverage
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    float const pos = std::clamp(rgba[c], 0.0f, 1.0f) * SIZE;
+                    auto const index = std::min(static_cast<uint32>(pos), SIZE - 1);
+                    float const frac = pos - float(index);
+                    rgba[c] = table[index] + (table[index + 1] - table[index]) * frac;
+                }
+            }
+        }
+    };
+
+    //---------------------------------------------------------------------
+    // Horizontal pass: one RGBA pixel is one SSE register
+    void filterRow(const float* src, float* dst, const WeightTable& table)
+    {
+        size_t const dstSize = table.first.size();
+        for (size_t i = 0; i < dstSize; ++i)
+        {
+            const float* in = src + size_t(table.first[i]) * WORK_CHANNELS;
+            const float* w = &table.weights[i * table.taps];
+            __m128 acc = _mm_setzero_ps();
+            for (uint32 k = 0; k < table.count[i]; ++k)
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(in + k * WORK_CHANNELS), _mm_set1_ps(w[k])));
+            _mm_storeu_ps(dst + i * WORK_CHANNELS, acc);
+        }
+    }
+
+    //---------------------------------------------------------------------
+    // Vertical pass: dst = sum(weights[k] * rows[k]) over n floats
+    using CombineFunction = void (*)(const float* const* rows, const float* weights, uint32 count, float* dst, size_t n);
+
+    void combineRowsSSE(const float* const* rows, const float* weights, uint32 count, float* dst, size_t n)
+    {
+        size_t x = 0;
+        for (; x + 4 <= n; x += 4)
+        {
+            __m128 acc = _mm_setzero_ps();
+            for (uint32 k = 0; k < count; ++k)
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(rows[k] + x), _mm_set1_ps(weights[k])));
+            _mm_storeu_ps(dst + x, acc);
+        }
+        for (; x < n; ++x)
+        {
+            float acc = 0.0f;
+            for (uint32 k = 0; k < count; ++k)
+                acc += rows[k][x] * weights[k];
+            dst[x] = acc;
+        }
+    }
+
+    // FMA is a separate CPU feature, so this sticks to multiply and add like the SSE path
+    [[gnu::target("avx2")]]
+    void combineRowsAVX2(const float* const* rows, const float* weights, uint32 count, float* dst, size_t n)
+    {
+        size_t x = 0;
+        for (; x + 16 <= n; x += 16)
+        {
+            __m256 acc0 = _mm256_setzero_ps();
+            __m256 acc1 = _mm256_setzero_ps();
+            for (uint32 k = 0; k < count; ++k)
+            {
+                __m256 const w = _mm256_set1_ps(weights[k]);
+                acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(rows[k] + x), w));
+                acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(rows[k] + x + 8), w));
+            }
+            _mm256_storeu_ps(dst + x, acc0);
+            _mm256_storeu_ps(dst + x + 8, acc1);
+        }
+        combineRowsSSE(rows, weights, count, dst + x, n - x);
+    }
+
+    auto getCombineFunction() -> CombineFunction
+    {
+        static CombineFunction const combine =
+            PlatformInformation::hasCpuFeature(PlatformInformation::CpuFeatures::AVX2) ? &combineRowsAVX2 : &combineRowsSSE;
+        return combine;
+    }
+
+    //---------------------------------------------------------------------
+    auto getRow(const PixelBox& box, uint32 y, uint32 z) -> PixelBox
+    {
+        return box.getSubVolume(Box{box.left, box.top + y, box.right, box.top + y + 1, box.front + z, box.front + z + 1});
+    }
+
+    //---------------------------------------------------------------------
+    // Calls visit(row) for every row of box converted to the working format, and
+    // writes the row back if visit returns true
+    template<typename Visitor>
+    void visitRows(const PixelBox& box, Visitor&& visit)
+    {
+        std::vector<float> row(size_t(box.getWidth()) * WORK_CHANNELS);
+        PixelBox const work(box.getWidth(), 1, 1, WORK_FORMAT, row.data());
+        for (uint32 z = 0; z < box.getDepth(); ++z)
+            for (uint32 y = 0; y < box.getHeight(); ++y)
+            {
+                PixelBox const target = getRow(box, y, z);
+                PixelUtil::bulkPixelConversion(target, work);
+                if (visit(row.data(), box.getWidth()))
+                    PixelUtil::bulkPixelConversion(work, target);
+            }
+    }
+
+    auto countCoverage(const PixelBox& box, float alphaRef, float alphaScale) -> size_t
+    {
+        size_t covered = 0;
+        visitRows(box, [&](const float* row, uint32 width)
+        {
+            for (uint32 x = 0; x < width; ++x)
+                covered += row[x * WORK_CHANNELS + 3] * alphaScale >= alphaRef;
+            return false;
+        });
+        return covered;
+    }
+}
+    //-----------------------------------------------------------------------
+    auto getAlphaCoverage(const PixelBox& box, float alphaRef) -> float
+    {
+        size_t const pixels = size_t(box.getWidth()) * box.getHeight() * box.getDepth();
+        return pixels ? float(countCoverage(box, alphaRef, 1.0f)) / float(pixels) : 0.0f;
+    }
+    //-----------------------------------------------------------------------
+    void scaleAlphaToCoverage(const PixelBox& box, float alphaRef, float coverage)
+    {
+        size_t const pixels = size_t(box.getWidth()) * box.getHeight() * box.getDepth();
+        if (!pixels)
+            return;
+
+        // coverage grows with the scale, so bisect for the one matching the target. Alpha
+        // takes few distinct values in small or filtered levels, so the coverage jumps and
+        // the closest scale seen is kept rather than the last one tried.
+        float low = 0.0f, high = 4.0f, alphaScale = 1.0f;
+        float bestError = std::abs(getAlphaCoverage(box, alphaRef) - coverage);
+        for (int i = 0; i < 12 && bestError > 0.0f; ++i)
+        {
+            float const scale = 0.5f * (low + high);
+            float const current = float(countCoverage(box, alphaRef, scale)) / float(pixels);
+            if (std::abs(current - coverage) < bestError)
+            {
+                bestError = std::abs(current - coverage);
+                alphaScale = scale;
+            }
+            if (current < coverage)
+                low = scale;
+            else
+                high = scale;
+        }
+
+        visitRows(box, [&](float* row, uint32 width)
+        {
+            for (uint32 x = 0; x < width; ++x)
+                row[x * WORK_CHANNELS + 3] = std::min(1.0f, row[x * WORK_CHANNELS + 3] * alphaScale);
+            return true;
+        });
+    }
+    //-----------------------------------------------------------------------
+    void HalfResampler_Byte4::scale(const PixelBox& src, const PixelBox& dst, uint32 rowBegin, uint32 rowEnd)
+    {
+        uint32 const width = dst.getWidth();
+        __m128i const zero = _mm_setzero_si128();
+        __m128i const two = _mm_set1_epi16(2);
+        for (uint32 y = rowBegin; y < rowEnd; ++y)
+        {
+            const uchar* r0 = src.getTopLeftFrontPixelPtr() + size_t(2 * y) * src.rowPitch * 4;
+            const uchar* r1 = r0 + src.rowPitch * 4;
+            uchar* out = dst.getTopLeftFrontPixelPtr() + size_t(y) * dst.rowPitch * 4;
+
+            uint32 x = 0;
+            for (; x + 4 <= width; x += 4)
+            {
+                // 8 source pixels of both rows make 4 destination pixels
+                __m128i const a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + 8 * x));
+                __m128i const a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + 8 * x + 16));
+                __m128i const b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + 8 * x));
+                __m128i const b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + 8 * x + 16));
+
+                // vertical sums in 16 bit, two pixels per register
+                __m128i const v0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+                __m128i const v1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+                __m128i const v2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+                __m128i const v3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+                // horizontal sums of neighbouring pixels, rounded
+                __m128i s0 = _mm_add_epi16(_mm_unpacklo_epi64(v0, v1), _mm_unpackhi_epi64(v0, v1));
+                __m128i s1 = _mm_add_epi16(_mm_unpacklo_epi64(v2, v3), _mm_unpackhi_epi64(v2, v3));
+                s0 = _mm_srli_epi16(_mm_add_epi16(s0, two), 2);
+                s1 = _mm_srli_epi16(_mm_add_epi16(s1, two), 2);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * x), _mm_packus_epi16(s0, s1));
+            }
+            for (; x < width; ++x)
+                for (uint32 c = 0; c < 4; ++c)
+                    out[4 * x + c] = static_cast<uchar>(
+                        (r0[8 * x + c] + r0[8 * x + 4 + c] + r1[8 * x + c] + r1[8 * x + 4 + c] + 2) >> 2);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void SeparableResampler::scale(const PixelBox& src, const PixelBox& dst, Image::Filter filter, bool gammaCorrect)
+    {
+        // in place scaling would overwrite rows that are still to be read
+        if (src.data == dst.data)
+        {
+            Image copy(src.format, src.getWidth(), src.getHeight(), src.getDepth());
+            PixelUtil::bulkPixelConversion(src, copy.getPixelBox());
+            scale(copy.getPixelBox(), dst, filter, gammaCorrect);
+            return;
+        }
+
+        Kernel const kernel = getKernel(filter);
+        WeightTable const xWeights(src.getWidth(), dst.getWidth(), kernel);
+        WeightTable const yWeights(src.getHeight(), dst.getHeight(), kernel);
+        const GammaTables* gamma = (gammaCorrect && !PixelUtil::isFloatingPoint(src.format)) ? &GammaTables::get() : nullptr;
+        CombineFunction const combine = getCombineFunction();
+
+        uint32 const dstWidth = dst.getWidth();
+        size_t const rowFloats = size_t(dstWidth) * WORK_CHANNELS;
+        bool const resampleDepth = src.getDepth() != dst.getDepth();
+
+        // with a depth change, slices are resampled in 2D into a float volume first
+        std::vector<float> volume;
+        if (resampleDepth)
+            volume.resize(rowFloats * dst.getHeight() * src.getDepth());
+
+        auto storeRow = [&](float* row, uint32 y, uint32 z)
+        {
+            if (gamma)
+                gamma->toGamma(row, dstWidth);
+            PixelUtil::bulkPixelConversion(PixelBox(dstWidth, 1, 1, WORK_FORMAT, row), getRow(dst, y, z));
+        };
+
+        for (uint32 z = 0; z < src.getDepth(); ++z)
+        {
+            parallelForBands(dst.getHeight(), 16, [&](uint32 rowBegin, uint32 rowEnd)
+            {
+                // horizontally filtered source rows needed by this band
+                uint32 srcBegin = yWeights.first[rowBegin], srcEnd = srcBegin;
+                for (uint32 y = rowBegin; y < rowEnd; ++y)
+                {
+                    srcBegin = std::min(srcBegin, yWeights.first[y]);
+                    srcEnd = std::max(srcEnd, yWeights.first[y] + yWeights.count[y]);
+                }
+
+                std::vector<float> srcRow(size_t(src.getWidth()) * WORK_CHANNELS);
+                std::vector<float> filtered(rowFloats * (srcEnd - srcBegin));
+                for (uint32 sy = srcBegin; sy < srcEnd; ++sy)
+                {
+                    PixelUtil::bulkPixelConversion(getRow(src, sy, z), PixelBox(src.getWidth(), 1, 1, WORK_FORMAT, srcRow.data()));
+                    if (gamma)
+                        gamma->toLinear(srcRow.data(), src.getWidth());
+                    filterRow(srcRow.data(), &filtered[rowFloats * (sy - srcBegin)], xWeights);
+                }
+
+                std::vector<float> outRow(rowFloats);
+                std::vector<const float*> rows(yWeights.taps);
+                for (uint32 y = rowBegin; y < rowEnd; ++y)
+                {
+                    for (uint32 k = 0; k < yWeights.count[y]; ++k)
+                        rows[k] = &filtered[rowFloats * (yWeights.first[y] + k - srcBegin)];
+
+                    float* out = resampleDepth ? &volume[rowFloats * (size_t(z) * dst.getHeight() + y)] : outRow.data();
+                    combine(rows.data(), &yWeights.weights[size_t(y) * yWeights.taps], yWeights.count[y], out, rowFloats);
+                    if (!resampleDepth)
+                        storeRow(out, y, z);
+                }
+            });
+        }
+
+        if (!resampleDepth)
+            return;
+
+        WeightTable const zWeights(src.getDepth(), dst.getDepth(), kernel);
+        uint32 const dstHeight = dst.getHeight();
+        parallelForBands(dstHeight * dst.getDepth(), 16, [&](uint32 rowBegin, uint32 rowEnd)
+        {
+            std::vector<float> outRow(rowFloats);
+            std::vector<const float*> slices(zWeights.taps);
+            for (uint32 row = rowBegin; row < rowEnd; ++row)
+            {
+                uint32 const y = row % dstHeight, z = row / dstHeight;
+                for (uint32 k = 0; k < zWeights.count[z]; ++k)
+                    slices[k] = &volume[rowFloats * (size_t(zWeights.first[z] + k) * dstHeight + y)];
+                combine(slices.data(), &zWeights.weights[size_t(z) * zWeights.taps], zWeights.count[z], outRow.data(), rowFloats);
+                storeRow(outRow.data(), y, z);
+            }
+        });
+    }
+}
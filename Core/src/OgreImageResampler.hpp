@@ -27,12 +27,15 @@ THE SOFTWARE.
 */
 module Ogre.Core:ImageResampler;
 
+import :Image;
+import :ParallelFor;
 import :PixelFormat;
 
 import <algorithm>;
+import <vector>;
 
-// this file is inlined into OgreImage.cpp!
-// do not include anywhere else.
+// internal to the Image implementation, used by OgreImage.cpp and
+// OgreImageResampler.cpp only.
 namespace Ogre {
     /** \addtogroup Core
     *  @{
@@ -280,9 +283,10 @@ struct LinearResampler_Float32 {
 // only handles pixel formats that use 1 byte per color channel.
 // 2D only; punts 3D pixelboxes to default LinearResampler (slow).
 // templated on bytes-per-pixel to allow compiler optimizations, such
-// as unrolling loops and replacing multiplies with bitshifts
+// as unrolling loops and replacing multiplies with bitshifts.
+// rows [rowBegin, rowEnd) of dst are written, so bands can be scaled in parallel
 template<unsigned int channels> struct LinearResampler_Byte {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, uint32 rowBegin = 0, uint32 rowEnd = ~0u) {
         // assert(src.format == dst.format);
 
         // only optimized for 2D
@@ -290,18 +294,19 @@ template<unsigned int channels> struct LinearResampler_Byte {
             LinearResampler::scale(src, dst);
             return;
         }
+        rowEnd = std::min(rowEnd, dst.getHeight());
 
         // srcdata stays at beginning of slice, pdst is a moving pointer
         auto* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
-        auto* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+        auto* pdst = (uchar*)dst.getTopLeftFrontPixelPtr() + size_t(rowBegin) * dst.rowPitch * channels;
 
         // sx_48,sy_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
         uint64 stepx = ((uint64)src.getWidth() << 48) / dst.getWidth();
         uint64 stepy = ((uint64)src.getHeight() << 48) / dst.getHeight();
         
-        uint64 sy_48 = (stepy >> 1) - 1;
-        for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+        uint64 sy_48 = (stepy >> 1) - 1 + rowBegin * stepy;
+        for (size_t y = dst.top + rowBegin; y < dst.top + rowEnd; y++, sy_48+=stepy) {
             // bottom 28 bits of temp are 16/12 bit fixed precision, used to
             // adjust a source coordinate backwards by half a pixel so that the
             // integer bits represent the first sample (eg, sx1) and the
@@ -338,6 +343,24 @@ template<unsigned int channels> struct LinearResampler_Byte {
         }
     }
 };
+
+// separable resampler for the wider filters and gamma correct scaling, see
+// OgreImageResampler.cpp. Converts through linear float RGBA, so any accessible
+// format pair is supported; rows are processed in parallel bands.
+struct SeparableResampler {
+    static void scale(const PixelBox& src, const PixelBox& dst, Image::Filter filter, bool gammaCorrect);
+};
+
+// exact 2:1 box downsampling of 2D 4 byte per pixel formats, the common mipmap case.
+// rows [rowBegin, rowEnd) of dst are written, so bands can be scaled in parallel
+struct HalfResampler_Byte4 {
+    static void scale(const PixelBox& src, const PixelBox& dst, uint32 rowBegin, uint32 rowEnd);
+};
+
+// fraction of pixels whose alpha reaches alphaRef
+auto getAlphaCoverage(const PixelBox& box, float alphaRef) -> float;
+// scales alpha so that the alpha coverage of box approximates coverage
+void scaleAlphaToCoverage(const PixelBox& box, float alphaRef, float coverage);
 /** @} */
 /** @} */
 
@@ -0,0 +1,738 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstdlib>
+#include <cstring>
+#define MINIZ_HEADER_FILE_ONLY
+#include <miniz.h>
+
+module Ogre.Core;
+
+import :Codec;
+import :DataStream;
+import :Exception;
+import :Image;
+import :KTX2Codec;
+import :LogManager;
+import :ParallelFor;
+import :PixelFormat;
+import :Platform;
+import :Zstd;
+
+import <algorithm>;
+import <array>;
+import <filesystem>;
+import <format>;
+import <fstream>;
+import <memory>;
+import <numeric>;
+import <span>;
+import <string>;
+import <utility>;
+import <vector>;
+
+namespace Ogre {
+namespace {
+    const std::array<uint8, 12> KTX2_IDENTIFIER = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+    struct KTX2Header
+    {
+        uint8 identifier[12];
+        uint32 vkFormat;
+        uint32 typeSize;
+        uint32 pixelWidth;
+        uint32 pixelHeight;
+        uint32 pixelDepth;
+        uint32 layerCount;
+        uint32 faceCount;
+        uint32 levelCount;
+        uint32 supercompressionScheme;
+        // index
+        uint32 dfdByteOffset;
+        uint32 dfdByteLength;
+        uint32 kvdByteOffset;
+        uint32 kvdByteLength;
+        uint64 sgdByteOffset;
+        uint64 sgdByteLength;
+    };
+    static_assert(sizeof(KTX2Header) == 80);
+
+    struct KTX2LevelIndex
+    {
+        uint64 byteOffset;
+        uint64 byteLength;
+        uint64 uncompressedByteLength;
+    };
+    static_assert(sizeof(KTX2LevelIndex) == 24);
+
+    enum class Supercompression : uint32
+    {
+        NONE = 0,
+        BASISLZ = 1,
+        ZSTD = 2,
+        ZLIB = 3
+    };
+
+    // Khronos data format descriptor colour models
+    enum : uint8
+    {
+        DF_MODEL_UNSPECIFIED = 0,
+        DF_MODEL_RGBSDA = 1,
+        DF_MODEL_BC1A = 128,
+        DF_MODEL_BC2 = 129,
+        DF_MODEL_BC3 = 130,
+        DF_MODEL_BC4 = 131,
+        DF_MODEL_BC5 = 132,
+        DF_MODEL_BC6H = 133,
+        DF_MODEL_BC7 = 134,
+        DF_MODEL_ETC2 = 161,
+        DF_MODEL_ASTC = 162,
+        DF_MODEL_PVRTC = 164,
+        DF_MODEL_PVRTC2 = 165
+    };
+
+    struct KTX2Format
+    {
+        uint32 vkFormat;
+        PixelFormat format;
+        // DF_MODEL_UNSPECIFIED for formats that are only read
+        uint8 model;
+        uint8 blockWidth{1};
+        uint8 blockHeight{1};
+    };
+
+    // the first entry of a PixelFormat is the one written by encode
+    using enum PixelFormat;
+    const KTX2Format KTX2_FORMATS[] = {
+        {9, R8, DF_MODEL_RGBSDA},                   // VK_FORMAT_R8_UNORM
+        {15, R8, DF_MODEL_UNSPECIFIED},             // VK_FORMAT_R8_SRGB
+        {16, R8G8, DF_MODEL_RGBSDA},                // VK_FORMAT_R8G8_UNORM
+        {22, R8G8, DF_MODEL_UNSPECIFIED},           // VK_FORMAT_R8G8_SRGB
+        {23, BYTE_RGB, DF_MODEL_RGBSDA},            // VK_FORMAT_R8G8B8_UNORM
+        {29, BYTE_RGB, DF_MODEL_UNSPECIFIED},       // VK_FORMAT_R8G8B8_SRGB
+        {30, BYTE_BGR, DF_MODEL_RGBSDA},            // VK_FORMAT_B8G8R8_UNORM
+        {36, BYTE_BGR, DF_MODEL_UNSPECIFIED},       // VK_FORMAT_B8G8R8_SRGB
+        {37, BYTE_RGBA, DF_MODEL_RGBSDA},           // VK_FORMAT_R8G8B8A8_UNORM
+        {43, BYTE_RGBA, DF_MODEL_UNSPECIFIED},      // VK_FORMAT_R8G8B8A8_SRGB
+        {44, BYTE_BGRA, DF_MODEL_RGBSDA},           // VK_FORMAT_B8G8R8A8_UNORM
+        {50, BYTE_BGRA, DF_MODEL_UNSPECIFIED},      // VK_FORMAT_B8G8R8A8_SRGB
+        {64, A2B10G10R10, DF_MODEL_UNSPECIFIED},    // VK_FORMAT_A2B10G10R10_UNORM_PACK32
+        {76, FLOAT16_R, DF_MODEL_RGBSDA},           // VK_FORMAT_R16_SFLOAT
+        {77, SHORT_GR, DF_MODEL_RGBSDA},            // VK_FORMAT_R16G16_UNORM
+        {83, FLOAT16_GR, DF_MODEL_RGBSDA},          // VK_FORMAT_R16G16_SFLOAT
+        {84, SHORT_RGB, DF_MODEL_RGBSDA},           // VK_FORMAT_R16G16B16_UNORM
+        {90, FLOAT16_RGB, DF_MODEL_RGBSDA},         // VK_FORMAT_R16G16B16_SFLOAT
+        {91, SHORT_RGBA, DF_MODEL_RGBSDA},          // VK_FORMAT_R16G16B16A16_UNORM
+        {97, FLOAT16_RGBA, DF_MODEL_RGBSDA},        // VK_FORMAT_R16G16B16A16_SFLOAT
+        {100, FLOAT32_R, DF_MODEL_RGBSDA},          // VK_FORMAT_R32_SFLOAT
+        {103, FLOAT32_GR, DF_MODEL_RGBSDA},         // VK_FORMAT_R32G32_SFLOAT
+        {106, FLOAT32_RGB, DF_MODEL_RGBSDA},        // VK_FORMAT_R32G32B32_SFLOAT
+        {109, FLOAT32_RGBA, DF_MODEL_RGBSDA},       // VK_FORMAT_R32G32B32A32_SFLOAT
+        {122, R11G11B10_FLOAT, DF_MODEL_UNSPECIFIED}, // VK_FORMAT_B10G11R11_UFLOAT_PACK32
+        {123, R9G9B9E5_SHAREDEXP, DF_MODEL_UNSPECIFIED}, // VK_FORMAT_E5B9G9R9_UFLOAT_PACK32
+        {133, DXT1, DF_MODEL_BC1A, 4, 4},           // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+        {131, DXT1, DF_MODEL_UNSPECIFIED, 4, 4},    // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+        {132, DXT1, DF_MODEL_UNSPECIFIED, 4, 4},    // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+        {134, DXT1, DF_MODEL_UNSPECIFIED, 4, 4},    // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+        {135, DXT3, DF_MODEL_BC2, 4, 4},            // VK_FORMAT_BC2_UNORM_BLOCK
+        {136, DXT3, DF_MODEL_UNSPECIFIED, 4, 4},    // VK_FORMAT_BC2_SRGB_BLOCK
+        {137, DXT5, DF_MODEL_BC3, 4, 4},            // VK_FORMAT_BC3_UNORM_BLOCK
+        {138, DXT5, DF_MODEL_UNSPECIFIED, 4, 4},    // VK_FORMAT_BC3_SRGB_BLOCK
+        {139, BC4_UNORM, DF_MODEL_BC4, 4, 4},       // VK_FORMAT_BC4_UNORM_BLOCK
+        {140, BC4_SNORM, DF_MODEL_BC4, 4, 4},       // VK_FORMAT_BC4_SNORM_BLOCK
+        {141, BC5_UNORM, DF_MODEL_BC5, 4, 4},       // VK_FORMAT_BC5_UNORM_BLOCK
+        {142, BC5_SNORM, DF_MODEL_BC5, 4, 4},       // VK_FORMAT_BC5_SNORM_BLOCK
+        {143, BC6H_UF16, DF_MODEL_BC6H, 4, 4},      // VK_FORMAT_BC6H_UFLOAT_BLOCK
+        {144, BC6H_SF16, DF_MODEL_BC6H, 4, 4},      // VK_FORMAT_BC6H_SFLOAT_BLOCK
+        {145, BC7_UNORM, DF_MODEL_BC7, 4, 4},       // VK_FORMAT_BC7_UNORM_BLOCK
+        {146, BC7_UNORM, DF_MODEL_UNSPECIFIED, 4, 4}, // VK_FORMAT_BC7_SRGB_BLOCK
+        {147, ETC2_RGB8, DF_MODEL_ETC2, 4, 4},      // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+        {147, ETC1_RGB8, DF_MODEL_ETC2, 4, 4},      // ETC2 decoders read ETC1 data
+        {148, ETC2_RGB8, DF_MODEL_UNSPECIFIED, 4, 4}, // VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+        {149, ETC2_RGB8A1, DF_MODEL_ETC2, 4, 4},    // VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK
+        {150, ETC2_RGB8A1, DF_MODEL_UNSPECIFIED, 4, 4}, // VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK
+        {151, ETC2_RGBA8, DF_MODEL_ETC2, 4, 4},     // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+        {152, ETC2_RGBA8, DF_MODEL_UNSPECIFIED, 4, 4}, // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+        {157, ASTC_RGBA_4X4_LDR, DF_MODEL_ASTC, 4, 4},     // VK_FORMAT_ASTC_4x4_UNORM_BLOCK
+        {159, ASTC_RGBA_5X4_LDR, DF_MODEL_ASTC, 5, 4},
+        {161, ASTC_RGBA_5X5_LDR, DF_MODEL_ASTC, 5, 5},
+        {163, ASTC_RGBA_6X5_LDR, DF_MODEL_ASTC, 6, 5},
+        {165, ASTC_RGBA_6X6_LDR, DF_MODEL_ASTC, 6, 6},
+        {167, ASTC_RGBA_8X5_LDR, DF_MODEL_ASTC, 8, 5},
+        {169, ASTC_RGBA_8X6_LDR, DF_MODEL_ASTC, 8, 6},
+        {171, ASTC_RGBA_8X8_LDR, DF_MODEL_ASTC, 8, 8},
+        {173, ASTC_RGBA_10X5_LDR, DF_MODEL_ASTC, 10, 5},
+        {175, ASTC_RGBA_10X6_LDR, DF_MODEL_ASTC, 10, 6},
+        {177, ASTC_RGBA_10X8_LDR, DF_MODEL_ASTC, 10, 8},
+        {179, ASTC_RGBA_10X10_LDR, DF_MODEL_ASTC, 10, 10},
+        {181, ASTC_RGBA_12X10_LDR, DF_MODEL_ASTC, 12, 10},
+        {183, ASTC_RGBA_12X12_LDR, DF_MODEL_ASTC, 12, 12}, // VK_FORMAT_ASTC_12x12_UNORM_BLOCK
+        {1000054000, PVRTC_RGBA2, DF_MODEL_PVRTC, 8, 4}, // VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG
+        {1000054000, PVRTC_RGB2, DF_MODEL_PVRTC, 8, 4},
+        {1000054001, PVRTC_RGBA4, DF_MODEL_PVRTC, 4, 4}, // VK_FORMAT_PVRTC1_4BPP_UNORM_BLOCK_IMG
+        {1000054001, PVRTC_RGB4, DF_MODEL_PVRTC, 4, 4},
+        {1000054002, PVRTC2_2BPP, DF_MODEL_PVRTC2, 8, 4}, // VK_FORMAT_PVRTC2_2BPP_UNORM_BLOCK_IMG
+        {1000054003, PVRTC2_4BPP, DF_MODEL_PVRTC2, 4, 4}, // VK_FORMAT_PVRTC2_4BPP_UNORM_BLOCK_IMG
+    };
+
+    auto findFormat(uint32 vkFormat) -> const KTX2Format*
+    {
+        // the sRGB variants of the ASTC formats follow their UNORM format
+        if (vkFormat >= 158 && vkFormat <= 184 && vkFormat % 2 == 0)
+            --vkFormat;
+        auto it = std::ranges::find(KTX2_FORMATS, vkFormat, &KTX2Format::vkFormat);
+        return it == std::end(KTX2_FORMATS) ? nullptr : &*it;
+    }
+
+    auto findFormat(PixelFormat format) -> const KTX2Format*
+    {
+        auto it = std::ranges::find(KTX2_FORMATS, format, &KTX2Format::format);
+        return it == std::end(KTX2_FORMATS) || it->model == DF_MODEL_UNSPECIFIED ? nullptr : &*it;
+    }
+
+    // one sample of a basic data format descriptor block
+    struct DFDSample
+    {
+        uint8 channel;
+        uint16 bitOffset;
+        uint16 bitLength;
+    };
+
+    /// builds the data format descriptor (the dfdTotalSize word and one basic block) of format
+    auto makeDFD(const KTX2Format& info, bool supercompressed) -> std::vector<uint32>
+    {
+        enum : uint8
+        {
+            CHANNEL_R = 0,
+            CHANNEL_G = 1,
+            CHANNEL_B = 2,
+            CHANNEL_A = 15,
+            QUALIFIER_SIGNED = 0x40,
+            QUALIFIER_FLOAT = 0x80
+        };
+
+        PixelFormat const format = info.format;
+        std::vector<DFDSample> samples;
+        uint8 qualifiers = 0;
+        uint32 bytesPlane0 = 0;
+        switch (info.model)
+        {
+        case DF_MODEL_RGBSDA:
+        {
+            auto const count = static_cast<uint32>(PixelUtil::getComponentCount(format));
+            auto const bits = static_cast<uint16>(PixelUtil::getNumElemBits(format) / count);
+            // vkFormat 30 and 44 are the BGR(A) orders
+            bool const bgr = info.vkFormat == 30 || info.vkFormat == 44;
+            uint8 const order[] = {bgr ? CHANNEL_B : CHANNEL_R, CHANNEL_G, bgr ? CHANNEL_R : CHANNEL_B, CHANNEL_A};
+            for (uint32 c = 0; c < count; ++c)
+                samples.push_back({order[c], static_cast<uint16>(c * bits), bits});
+            if (PixelUtil::isFloatingPoint(format))
+                qualifiers = QUALIFIER_FLOAT | QUALIFIER_SIGNED;
+            bytesPlane0 = static_cast<uint32>(PixelUtil::getNumElemBytes(format));
+            break;
+        }
+        case DF_MODEL_BC2:
+        case DF_MODEL_BC3:
+            samples = {{CHANNEL_A, 0, 64}, {0, 64, 64}};
+            break;
+        case DF_MODEL_BC5:
+            samples = {{CHANNEL_R, 0, 64}, {CHANNEL_G, 64, 64}};
+            break;
+        case DF_MODEL_BC6H:
+        case DF_MODEL_BC7:
+        case DF_MODEL_ASTC:
+            samples = {{0, 0, 128}};
+            break;
+        case DF_MODEL_ETC2:
+            if (format == ETC2_RGBA8)
+                samples = {{CHANNEL_A, 0, 64}, {CHANNEL_B, 64, 64}};
+            else
+                samples = {{CHANNEL_B, 0, 64}}; // the ETC2 colour channel
+            break;
+        case DF_MODEL_BC1A:
+            samples = {{1, 0, 64}}; // colour with punch through alpha
+            break;
+        default: // BC4 and PVRTC
+            samples = {{0, 0, 64}};
+            break;
+        }
+
+        if (PixelUtil::isCompressed(format))
+        {
+            bytesPlane0 = static_cast<uint32>(PixelUtil::getMemorySize(info.blockWidth, info.blockHeight, 1, format));
+            if (format == BC4_SNORM || format == BC5_SNORM)
+                qualifiers = QUALIFIER_SIGNED;
+            else if (format == BC6H_SF16)
+                qualifiers = QUALIFIER_FLOAT | QUALIFIER_SIGNED;
+            else if (format == BC6H_UF16)
+                qualifiers = QUALIFIER_FLOAT;
+        }
+
+        auto const blockSize = static_cast<uint32>(24 + 16 * samples.size());
+        std::vector<uint32> dfd;
+        dfd.reserve(1 + blockSize / 4);
+        dfd.push_back(4 + blockSize);
+        dfd.push_back(0);                             // Khronos vendor, basic descriptor type
+        dfd.push_back(2 | blockSize << 16);           // version 1.3
+        dfd.push_back(info.model | 1 << 8 | 1 << 16); // BT.709 primaries, linear transfer, straight alpha
+        dfd.push_back(uint32(info.blockWidth - 1) | uint32(info.blockHeight - 1) << 8);
+        // the planes have no fixed size once the levels are supercompressed
+        dfd.push_back(supercompressed ? 0 : bytesPlane0);
+        dfd.push_back(0);
+        for (const auto& sample : samples)
+        {
+            dfd.push_back(sample.bitOffset | uint32(sample.bitLength - 1) << 16 | uint32(sample.channel | qualifiers) << 24);
+            dfd.push_back(0);
+            if (qualifiers & QUALIFIER_FLOAT)
+            {
+                // -1.0f or 0.0f to 1.0f
+                dfd.push_back(qualifiers & QUALIFIER_SIGNED ? 0xBF800000 : 0);
+                dfd.push_back(0x3F800000);
+            }
+            else if (qualifiers & QUALIFIER_SIGNED)
+            {
+                dfd.push_back(0x80000000);
+                dfd.push_back(0x7FFFFFFF);
+            }
+            else
+            {
+                dfd.push_back(0);
+                dfd.push_back(sample.bitLength >= 32 ? 0xFFFFFFFF : (1u << sample.bitLength) - 1);
+            }
+        }
+        return dfd;
+    }
+
+    // the encoded file, referenced in place when the stream is already in memory
+    class KTX2Source
+    {
+    public:
+        explicit KTX2Source(const DataStreamPtr& stream)
+            : mStream(stream)
+            , mMemory(dynamic_cast<MemoryDataStream*>(stream.get()))
+            , mBase(mMemory ? mMemory->getCurrentPtr() : nullptr)
+            , mStart(stream->tell())
+        {
+        }
+
+        [[nodiscard]] auto inMemory() const noexcept -> bool { return mMemory != nullptr; }
+
+        void read(uint64 offset, void* dest, size_t size) const
+        {
+            if (mMemory)
+            {
+                memcpy(dest, at(offset, size), size);
+                return;
+            }
+            mStream->seek(mStart + offset);
+            if (mStream->read(dest, size) != size)
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Truncated KTX2 file", "KTX2Codec::decode");
+        }
+
+        /// the bytes at offset, only for streams in memory
+        [[nodiscard]] auto at(uint64 offset, uint64 size) const -> const uchar*
+        {
+            if (offset + size > mMemory->size() - mStart || offset + size < offset)
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Truncated KTX2 file", "KTX2Codec::decode");
+            return mBase + offset;
+        }
+
+    private:
+        DataStreamPtr mStream;
+        MemoryDataStream* mMemory;
+        const uchar* mBase;
+        size_t mStart;
+    };
+
+    void inflateLevel(std::span<const uchar> stored, std::span<uchar> dest)
+    {
+        size_t const written = tinfl_decompress_mem_to_mem(dest.data(), dest.size(), stored.data(), stored.size(),
+                                                           TINFL_FLAG_PARSE_ZLIB_HEADER);
+        if (written != dest.size())
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Corrupt zlib supercompressed KTX2 level",
+                        "KTX2Codec::decode");
+    }
+
+    /// decodes the levels of a KTX2 file, either into one image holding the array layers as its depth
+    /// or into one image per layer
+    auto decodeKTX2(const DataStreamPtr& stream, uint32 maxResolution, bool splitLayers)
+        -> std::vector<ImageCodec::DecodeResult>
+    {
+        KTX2Source source(stream);
+
+        KTX2Header header;
+        source.read(0, &header, sizeof(header));
+        if (memcmp(header.identifier, KTX2_IDENTIFIER.data(), KTX2_IDENTIFIER.size()) != 0)
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "This is not a KTX2 file", "KTX2Codec::decode");
+
+        auto const scheme = Supercompression(header.supercompressionScheme);
+        if (scheme == Supercompression::BASISLZ || header.vkFormat == 0)
+            OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED, "BasisLZ supercompressed KTX2 files are not supported",
+                        "KTX2Codec::decode");
+        if (scheme != Supercompression::NONE && scheme != Supercompression::ZSTD && scheme != Supercompression::ZLIB)
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                        ::std::format("Unknown KTX2 supercompression scheme {}", header.supercompressionScheme),
+                        "KTX2Codec::decode");
+
+        const KTX2Format* info = findFormat(header.vkFormat);
+        if (!info)
+            OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED,
+                        ::std::format("Unsupported KTX2 vkFormat {}", header.vkFormat), "KTX2Codec::decode");
+        PixelFormat const format = info->format;
+
+        uint32 const faces = header.faceCount;
+        uint32 const layers = std::max(1u, header.layerCount);
+        if (faces != 1 && faces != 6)
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, ::std::format("Invalid KTX2 face count {}", faces),
+                        "KTX2Codec::decode");
+        if (layers > 1 && (faces > 1 || header.pixelDepth > 1))
+            OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED, "KTX2 cubemap and 3D texture arrays are not supported",
+                        "KTX2Codec::decode");
+        if (header.pixelWidth == 0)
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Invalid KTX2 size", "KTX2Codec::decode");
+
+        // levelCount 0 asks the loader to generate the mipmaps
+        uint32 const levelCount = std::max(1u, header.levelCount);
+        if (levelCount > 32)
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Invalid KTX2 level count", "KTX2Codec::decode");
+        std::vector<KTX2LevelIndex> levelIndex(levelCount);
+        source.read(sizeof(header), levelIndex.data(), levelIndex.size() * sizeof(KTX2LevelIndex));
+
+        auto levelSize = [](uint32 level, uint32 dim) { return std::max(1u, dim >> level); };
+        uint32 const width = header.pixelWidth;
+        uint32 const height = std::max(1u, header.pixelHeight);
+        uint32 const depth = std::max(1u, header.pixelDepth);
+
+        uint32 first = 0;
+        if (maxResolution)
+        {
+            while (first + 1 < levelCount &&
+                   std::max(levelSize(first, width), levelSize(first, height)) > maxResolution)
+                ++first;
+        }
+        // Image halves the depth of every mipmap, so an image holding all layers keeps a single level
+        bool const layersAsDepth = layers > 1 && !splitLayers;
+        uint32 const numLevels = layersAsDepth ? 1 : levelCount - first;
+        uint32 const numImages = splitLayers ? layers : 1;
+
+        auto *imgData = new ImageCodec::ImageData();
+        ImageCodec::CodecDataPtr codecData(imgData);
+        imgData->width = levelSize(first, width);
+        imgData->height = levelSize(first, height);
+        imgData->depth = layersAsDepth ? layers : levelSize(first, depth);
+        imgData->num_mipmaps = static_cast<TextureMipmap>(numLevels - 1);
+        imgData->format = format;
+        if (PixelUtil::isCompressed(format))
+            imgData->flags |= ImageFlags::COMPRESSED;
+        if (faces == 6)
+            imgData->flags |= ImageFlags::CUBEMAP;
+        if (depth > 1)
+            imgData->flags |= ImageFlags::_3D_TEXTURE;
+        imgData->size = Image::calculateSize(imgData->num_mipmaps, faces, imgData->width, imgData->height,
+                                             imgData->depth, format);
+
+        std::vector<ImageCodec::DecodeResult> images;
+        for (uint32 i = 0; i < numImages; ++i)
+            images.emplace_back(std::make_shared<MemoryDataStream>(imgData->size), codecData);
+        size_t const faceStride = imgData->size / faces;
+
+        // where each level goes in the images, which store all mipmaps of a face together
+        struct Level
+        {
+            const KTX2LevelIndex* index;
+            // one face of one layer
+            size_t partSize;
+            size_t offset;
+            std::span<const uchar> stored;
+            std::vector<uchar> storage;
+        };
+        std::vector<Level> levels(numLevels);
+        size_t mipOffset = 0;
+        for (uint32 r = 0; r < numLevels; ++r)
+        {
+            uint32 const level = first + r;
+            Level& l = levels[r];
+            l.index = &levelIndex[level];
+            l.partSize = PixelUtil::getMemorySize(levelSize(level, width), levelSize(level, height),
+                                                  levelSize(level, depth), format);
+            l.offset = mipOffset;
+            mipOffset += l.partSize * (layersAsDepth ? layers : 1);
+
+            uint64 const expected = uint64(l.partSize) * faces * layers;
+            if (l.index->uncompressedByteLength != expected ||
+                (scheme == Supercompression::NONE && l.index->byteLength != expected))
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                            ::std::format("KTX2 level {} has {} bytes, expected {}", level,
+                                          l.index->uncompressedByteLength, expected),
+                            "KTX2Codec::decode");
+        }
+
+        // KTX2 stores the faces of each layer after another. A level is contiguous in the images
+        // unless it has several faces or its layers go to separate images.
+        bool const contiguous = faces == 1 && (layers == 1 || layersAsDepth);
+        uint32 const numParts = contiguous ? 1 : layers * faces;
+        auto partSize = [&](const Level& l) { return contiguous ? l.partSize * layers : l.partSize; };
+        auto partDest = [&](const Level& l, uint32 part) -> uchar*
+        {
+            uint32 const layer = part / faces;
+            uint32 const face = part % faces;
+            return images[splitLayers ? layer : 0].first->getPtr() + face * faceStride + l.offset;
+        };
+
+        // bring the stored bytes of the levels into memory, the larger levels are never touched
+        // when they are skipped. Uncompressed levels are read straight into place.
+        for (auto& l : levels)
+        {
+            if (source.inMemory())
+                l.stored = {source.at(l.index->byteOffset, l.index->byteLength), size_t(l.index->byteLength)};
+            else if (scheme == Supercompression::NONE)
+            {
+                for (uint32 part = 0; part < numParts; ++part)
+                    source.read(l.index->byteOffset + part * partSize(l), partDest(l, part), partSize(l));
+            }
+            else
+            {
+                l.storage.resize(l.index->byteLength);
+                source.read(l.index->byteOffset, l.storage.data(), l.storage.size());
+                l.stored = l.storage;
+            }
+        }
+
+        auto decompress = [&](std::span<const uchar> stored, std::span<uchar> dest)
+        {
+            if (scheme == Supercompression::ZSTD)
+                zstdDecompress(stored, dest);
+            else
+                inflateLevel(stored, dest);
+        };
+
+        // the largest level is about three quarters of the work, so this mostly helps
+        // files with many faces or layers
+        parallelForBands(numLevels, 1, [&](uint32 begin, uint32 end)
+        {
+            for (uint32 r = begin; r < end; ++r)
+            {
+                Level& l = levels[r];
+                size_t const size = partSize(l);
+                if (scheme == Supercompression::NONE)
+                {
+                    if (l.stored.empty())
+                        continue; // already read in place
+                    for (uint32 part = 0; part < numParts; ++part)
+                        memcpy(partDest(l, part), l.stored.data() + part * size, size);
+                }
+                else if (numParts == 1)
+                    decompress(l.stored, {partDest(l, 0), size});
+                else
+                {
+                    std::vector<uchar> decompressed(size * numParts);
+                    decompress(l.stored, decompressed);
+                    for (uint32 part = 0; part < numParts; ++part)
+                        memcpy(partDest(l, part), decompressed.data() + part * size, size);
+                }
+            }
+        });
+
+        return images;
+    }
+}
+    //---------------------------------------------------------------------
+    KTX2Codec* KTX2Codec::msInstance = nullptr;
+    //---------------------------------------------------------------------
+    void KTX2Codec::startup()
+    {
+        if (!msInstance)
+        {
+            LogManager::getSingleton().logMessage(LogMessageLevel::Normal, "KTX2 codec registering");
+
+            msInstance = new KTX2Codec();
+            Codec::registerCodec(msInstance);
+        }
+    }
+    //---------------------------------------------------------------------
+    void KTX2Codec::shutdown()
+    {
+        if(msInstance)
+        {
+            Codec::unregisterCodec(msInstance);
+            delete msInstance;
+            msInstance = nullptr;
+        }
+    }
+    //---------------------------------------------------------------------
+    auto KTX2Codec::encode(const MemoryDataStreamPtr& input, const CodecDataPtr& pData) const -> DataStreamPtr
+    {
+        auto* imgData = static_cast<ImageData*>(pData.get());
+
+        const KTX2Format* info = findFormat(imgData->format);
+        if (!info)
+            OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED,
+                        ::std::format("KTX2 encoding of {} is not supported",
+                                      PixelUtil::getFormatName(imgData->format)),
+                        "KTX2Codec::encode");
+
+        uint32 const levelCount = std::to_underlying(imgData->num_mipmaps) + 1;
+        // as in the DDS codec, the faces are deduced from the size
+        uint32 const faces = imgData->size == Image::calculateSize(imgData->num_mipmaps, 6, imgData->width,
+                                                                   imgData->height, imgData->depth,
+                                                                   imgData->format) ? 6 : 1;
+        size_t const faceStride = imgData->size / faces;
+
+        // gather every level contiguously, layer and face interleaved as KTX2 stores them
+        struct Level
+        {
+            size_t offset;
+            size_t faceSize;
+            std::vector<uchar> data;
+        };
+        std::vector<Level> levels(levelCount);
+        size_t mipOffset = 0;
+        for (uint32 level = 0; level < levelCount; ++level)
+        {
+            levels[level].offset = mipOffset;
+            levels[level].faceSize = PixelUtil::getMemorySize(std::max(1u, imgData->width >> level),
+                                                              std::max(1u, imgData->height >> level),
+                                                              std::max(1u, imgData->depth >> level),
+                                                              imgData->format);
+            mipOffset += levels[level].faceSize;
+        }
+
+        int const zlibLevel = std::clamp(mSupercompressionLevel, 0, 9);
+        parallelForBands(levelCount, 1, [&](uint32 begin, uint32 end)
+        {
+            for (uint32 level = begin; level < end; ++level)
+            {
+                Level& l = levels[level];
+                std::vector<uchar> raw(l.faceSize * faces);
+                for (uint32 face = 0; face < faces; ++face)
+                    memcpy(raw.data() + face * l.faceSize, input->getPtr() + face * faceStride + l.offset,
+                           l.faceSize);
+                if (!zlibLevel)
+                {
+                    l.data = std::move(raw);
+                    continue;
+                }
+
+                auto compressedSize = mz_compressBound(static_cast<mz_ulong>(raw.size()));
+                l.data.resize(compressedSize);
+                if (mz_compress2(l.data.data(), &compressedSize, raw.data(), static_cast<mz_ulong>(raw.size()),
+                                 zlibLevel) != MZ_OK)
+                    OGRE_EXCEPT(ExceptionCodes::INTERNAL_ERROR, "zlib compression failed", "KTX2Codec::encode");
+                l.data.resize(compressedSize);
+            }
+        });
+
+        KTX2Header header{};
+        memcpy(header.identifier, KTX2_IDENTIFIER.data(), KTX2_IDENTIFIER.size());
+        header.vkFormat = info->vkFormat;
+        header.typeSize = PixelUtil::isCompressed(imgData->format)
+                              ? 1
+                              : static_cast<uint32>(PixelUtil::getNumElemBytes(imgData->format) /
+                                                    PixelUtil::getComponentCount(imgData->format));
+        header.pixelWidth = imgData->width;
+        header.pixelHeight = imgData->height;
+        header.pixelDepth = imgData->depth > 1 ? imgData->depth : 0;
+        header.layerCount = 0;
+        header.faceCount = faces;
+        header.levelCount = levelCount;
+        header.supercompressionScheme = std::to_underlying(zlibLevel ? Supercompression::ZLIB : Supercompression::NONE);
+
+        std::vector<uint32> const dfd = makeDFD(*info, zlibLevel != 0);
+        header.dfdByteOffset = static_cast<uint32>(sizeof(KTX2Header) + levelCount * sizeof(KTX2LevelIndex));
+        header.dfdByteLength = static_cast<uint32>(dfd.size() * sizeof(uint32));
+
+        // the levels follow smallest first, uncompressed ones aligned to the texel block size
+        size_t const alignment = zlibLevel ? 1 : std::lcm<size_t>(dfd[5], 4); // dfd[5] holds bytesPlane0
+        std::vector<KTX2LevelIndex> levelIndex(levelCount);
+        uint64 fileSize = header.dfdByteOffset + header.dfdByteLength;
+        for (uint32 level = levelCount; level-- > 0;)
+        {
+            fileSize = (fileSize + alignment - 1) / alignment * alignment;
+            levelIndex[level] = {fileSize, levels[level].data.size(), levels[level].faceSize * faces};
+            fileSize += levels[level].data.size();
+        }
+
+        auto output = std::make_shared<MemoryDataStream>(static_cast<size_t>(fileSize));
+        uchar* dest = output->getPtr();
+        memset(dest, 0, output->size());
+        memcpy(dest, &header, sizeof(header));
+        memcpy(dest + sizeof(header), levelIndex.data(), levelIndex.size() * sizeof(KTX2LevelIndex));
+        memcpy(dest + header.dfdByteOffset, dfd.data(), header.dfdByteLength);
+        for (uint32 level = 0; level < levelCount; ++level)
+            memcpy(dest + levelIndex[level].byteOffset, levels[level].data.data(), levels[level].data.size());
+
+        return output;
+    }
+    //---------------------------------------------------------------------
+    void KTX2Codec::encodeToFile(const MemoryDataStreamPtr& input, std::string_view outFileName,
+                                 const CodecDataPtr& pData) const
+    {
+        MemoryDataStreamPtr data = static_pointer_cast<MemoryDataStream>(encode(input, pData));
+
+        // Write the file
+        std::ofstream of;
+        of.open(std::filesystem::path{outFileName}, std::ios_base::binary|std::ios_base::out);
+        of.write((const char *)data->getPtr(), data->size());
+        of.close();
+    }
+    //---------------------------------------------------------------------
+    auto KTX2Codec::decode(const DataStreamPtr& stream) const -> DecodeResult
+    {
+        return std::move(decodeKTX2(stream, 0, false).front());
+    }
+    //---------------------------------------------------------------------
+    auto KTX2Codec::loadLevels(const DataStreamPtr& input, Image& dest, uint32 maxResolution) -> Image&
+    {
+        // the Image takes over the buffer, keeping the flags so arrays are not taken for volumes
+        loadDecoded(decodeKTX2(input, maxResolution, false).front(), dest);
+        return dest;
+    }
+    //---------------------------------------------------------------------
+    void KTX2Codec::loadLayers(const DataStreamPtr& input, std::vector<Image>& layers, uint32 maxResolution)
+    {
+        auto decoded = decodeKTX2(input, maxResolution, true);
+        layers.resize(decoded.size());
+        for (size_t i = 0; i < decoded.size(); ++i)
+            loadDecoded(decoded[i], layers[i]);
+    }
+    //---------------------------------------------------------------------
+    auto KTX2Codec::getType() const -> std::string_view
+    {
+        return "ktx2";
+    }
+    //---------------------------------------------------------------------
+    auto KTX2Codec::magicNumberToFileExt(const char *magicNumberPtr, size_t maxbytes) const -> std::string_view
+    {
+        if (maxbytes >= KTX2_IDENTIFIER.size() &&
+            memcmp(magicNumberPtr, KTX2_IDENTIFIER.data(), KTX2_IDENTIFIER.size()) == 0)
+            return "ktx2";
+
+        return BLANKSTRING;
+    }
+}
@@ -239,8 +239,10 @@ namespace Ogre {
             ResourceGroupManager::getSingleton().openResource(
                 mName, mGroup, this);
  
-        // fully prebuffer into host RAM
-        mFreshFromDisk = DataStreamPtr(new MemoryDataStream(mName,mFreshFromDisk));
+        // fully prebuffer into host RAM, unless the stream is already a mapping the
+        // serializer can read in place
+        if (!mFreshFromDisk->getSharedData())
+            mFreshFromDisk = DataStreamPtr(new MemoryDataStream(mName,mFreshFromDisk));
     }
     //-----------------------------------------------------------------------
     void Mesh::unprepareImpl()
@@ -1791,6 +1793,30 @@ namespace Ogre {
         mPreparedForShadowVolumes = true;
     }
     //---------------------------------------------------------------------
+    void Mesh::quantiseVertexData(bool compactDirections)
+    {
+        // The edge list builder reads model space positions
+        if (!mEdgeListsBuilt && mAutoBuildEdgeLists)
+        {
+            buildEdgeList();
+        }
+
+        auto quantise = [compactDirections](VertexData* vertexData, VertexAnimationType animType)
+        {
+            if (!vertexData || animType != VertexAnimationType::NONE)
+                return;
+            vertexData->reorganiseBuffers(
+                vertexData->vertexDeclaration->getQuantisedDeclaration(compactDirections));
+        };
+
+        quantise(sharedVertexData, getSharedVertexDataAnimationType());
+        for (auto s : mSubMeshList)
+        {
+            if (!s->useSharedVertices)
+                quantise(s->vertexData.get(), s->getVertexAnimationType());
+        }
+    }
+    //---------------------------------------------------------------------
     auto Mesh::getEdgeList(unsigned short lodIndex) -> EdgeData*
     {
         // Build edge list on demand
@@ -1817,7 +1843,7 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     void Mesh::softwareVertexBlend(const VertexData* sourceVertexData,
-        const VertexData* targetVertexData,
+        VertexData* targetVertexData,
         const Affine3* const* blendMatrices, size_t numMatrices,
         bool blendNormals)
     {
@@ -1930,16 +1956,92 @@ namespace Ogre {
             destElemNorm->baseVertexPointerToElement(destNormBuf != destPosBuf ? destNormLock.pData : destPosLock.pData, &pDestNorm);
         }
 
+        bool quantised = srcElemPos->getType() != VertexElementType::FLOAT3 ||
+            destElemPos->getType() != VertexElementType::FLOAT3 ||
+            (includeNormals && (srcElemNorm->getType() != VertexElementType::FLOAT3 ||
+                                destElemNorm->getType() != VertexElementType::FLOAT3));
+        if (!quantised)
+        {
+            OptimisedUtil::getImplementation()->softwareVertexSkinning(
+                pSrcPos, pDestPos,
+                pSrcNorm, pDestNorm,
+                pBlendWeight, pBlendIdx,
+                blendMatrices,
+                srcPosStride, destPosStride,
+                srcNormStride, destNormStride,
+                blendWeightStride, blendIdxStride,
+                numWeightsPerVertex,
+                targetVertexData->vertexCount);
+            return;
+        }
+
+        // Quantised vertex data, decode to model space, blend as floats and encode again
+        // with a decode matrix fitted to the blended positions
+        size_t numVertices = targetVertexData->vertexCount;
+        std::vector<float> srcPos(numVertices * 3), destPos(numVertices * 3);
+        std::vector<float> srcNorm, destNorm;
+        if (includeNormals)
+        {
+            srcNorm.resize(numVertices * 3);
+            destNorm.resize(numVertices * 3);
+        }
+
+        float values[4];
+        for (size_t v = 0; v < numVertices; ++v)
+        {
+            srcElemPos->readFloats(reinterpret_cast<const uchar*>(pSrcPos) + v * srcPosStride, values);
+            Vector3 pos = sourceVertexData->positionDecodeMatrix * Vector3{values[0], values[1], values[2]};
+            srcPos[v * 3] = pos.x;
+            srcPos[v * 3 + 1] = pos.y;
+            srcPos[v * 3 + 2] = pos.z;
+            if (includeNormals)
+            {
+                srcElemNorm->readFloats(reinterpret_cast<const uchar*>(pSrcNorm) + v * srcNormStride, values);
+                std::copy_n(values, 3, &srcNorm[v * 3]);
+            }
+        }
+
         OptimisedUtil::getImplementation()->softwareVertexSkinning(
-            pSrcPos, pDestPos,
-            pSrcNorm, pDestNorm,
+            srcPos.data(), destPos.data(),
+            includeNormals ? srcNorm.data() : nullptr, includeNormals ? destNorm.data() : nullptr,
             pBlendWeight, pBlendIdx,
             blendMatrices,
-            srcPosStride, destPosStride,
-            srcNormStride, destNormStride,
+            sizeof(float) * 3, sizeof(float) * 3,
+            sizeof(float) * 3, sizeof(float) * 3,
             blendWeightStride, blendIdxStride,
             numWeightsPerVertex,
-            targetVertexData->vertexCount);
+            numVertices);
+
+        targetVertexData->positionDecodeMatrix = Affine3::IDENTITY;
+        VertexElementType destPosBase = VertexElement::getBaseType(destElemPos->getType());
+        if (destPosBase != VertexElementType::FLOAT1 && destPosBase != VertexElementType::HALF1 && numVertices)
+        {
+            Vector3 vmin = Vector3::Fill(Math::POS_INFINITY), vmax = Vector3::Fill(Math::NEG_INFINITY);
+            for (size_t v = 0; v < numVertices; ++v)
+            {
+                Vector3 pos{destPos[v * 3], destPos[v * 3 + 1], destPos[v * 3 + 2]};
+                vmin.makeFloor(pos);
+                vmax.makeCeil(pos);
+            }
+            targetVertexData->positionDecodeMatrix = VertexData::calcPositionDecodeMatrix(vmin, vmax);
+        }
+        Affine3 encode = targetVertexData->positionDecodeMatrix.inverse();
+
+        for (size_t v = 0; v < numVertices; ++v)
+        {
+            Vector3 pos = encode * Vector3{destPos[v * 3], destPos[v * 3 + 1], destPos[v * 3 + 2]};
+            values[0] = pos.x;
+            values[1] = pos.y;
+            values[2] = pos.z;
+            values[3] = 1;
+            destElemPos->writeFloats(reinterpret_cast<uchar*>(pDestPos) + v * destPosStride, values);
+            if (includeNormals)
+            {
+                std::copy_n(&destNorm[v * 3], 3, values);
+                values[3] = 0;
+                destElemNorm->writeFloats(reinterpret_cast<uchar*>(pDestNorm) + v * destNormStride, values);
+            }
+        }
     }
     //---------------------------------------------------------------------
     void Mesh::softwareVertexMorph(Real t,
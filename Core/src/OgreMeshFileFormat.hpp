@@ -57,6 +57,12 @@ namespace Ogre {
     enum class MeshChunkID {
         HEADER                = 0x1000,
             // char*          version           : Version number check
+        BUFFER_DATA         = 0x2000,
+            // Only in the mappable variant of the format.
+            // Raw vertex and index buffer payloads, each starting at a 64 byte aligned
+            // offset from the start of the file and zero padded in between.
+            // The buffer payloads in the MESH chunk are then replaced by
+            // unsigned int offset;         // absolute offset of the payload in the file
         MESH                = 0x3000,
             // bool skeletallyAnimated   // important flag which affects h/w buffer policies
             // Optional GEOMETRY chunk
@@ -97,6 +103,8 @@ namespace Ogre {
                     // unsigned short vertexSize;   // Per-vertex size, must agree with declaration at this index
                     GEOMETRY_VERTEX_BUFFER_DATA = 0x5210,
                         // raw buffer data
+                GEOMETRY_POSITION_DECODE = 0x5300, // Optional, present only for quantised positions
+                    // float decodeMatrix[3][4];    // VertexData::positionDecodeMatrix, row major
             MESH_SKELETON_LINK = 0x6000,
                 // Optional link to skeleton
                 // char* skeletonName           : name of .skeleton to use
@@ -207,6 +215,18 @@ namespace Ogre {
             // unsigned short submesh_index;
             // float extremes [n_extremes][3];
 
+            // Optional submesh meshlet list chunk
+            TABLE_MESHLETS = 0xE100,
+            // unsigned short submesh_index;
+            // unsigned int meshlet_count;
+            // repeat meshlet_count times:
+            //   unsigned int index_start;
+            //   unsigned int index_count;
+            //   float center[3];
+            //   float radius;
+            //   float cone_axis[3];
+            //   float cone_cutoff;
+
     /* Version 1.2 of the .mesh format (deprecated)
     enum class MeshChunkID {
         HEADER                = 0x1000,
@@ -0,0 +1,793 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstring>
+
+module Ogre.Core;
+
+import :Exception;
+import :HardwareBuffer;
+import :HardwareBufferManager;
+import :HardwareIndexBuffer;
+import :HardwareVertexBuffer;
+import :LodStrategy;
+import :LodStrategyManager;
+import :Mesh;
+import :MeshLodGenerator;
+import :MeshSerializer;
+import :ParallelFor;
+import :RenderOperation;
+import :SharedPtr;
+import :SubMesh;
+import :Vector;
+import :VertexIndexData;
+
+import <algorithm>;
+import <array>;
+import <atomic>;
+import <exception>;
+import <format>;
+import <functional>;
+import <map>;
+import <queue>;
+import <tuple>;
+import <utility>;
+import <vector>;
+
+namespace Ogre
+{
+namespace
+{
+    /// Attributes of one VertexData, read once and shared by all SubMeshes referencing it
+    struct VertexAttributes
+    {
+        std::vector<Vector3> positions;
+        std::vector<Vector3> normals;
+        std::vector<Vector2> uvs;
+    };
+    //---------------------------------------------------------------------
+    template<int dims>
+    void readFloatElement(const VertexData* vertexData, VertexElementSemantic sem,
+        std::vector<Vector<dims, Real>>& dest)
+    {
+        const VertexElement* elem = vertexData->vertexDeclaration->findElementBySemantic(sem);
+        if (!elem || VertexElement::getBaseType(elem->getType()) != VertexElementType::FLOAT1 ||
+            VertexElement::getTypeCount(elem->getType()) < dims)
+            return;
+
+        HardwareVertexBufferSharedPtr vbuf = vertexData->vertexBufferBinding->getBuffer(elem->getSource());
+        HardwareBufferLockGuard vertexLock(vbuf, HardwareBuffer::LockOptions::READ_ONLY);
+        auto* pVertex = static_cast<unsigned char*>(vertexLock.pData) +
+            vertexData->vertexStart * vbuf->getVertexSize();
+
+        dest.resize(vertexData->vertexCount);
+        for (auto& v : dest)
+        {
+            float* pFloat;
+            elem->baseVertexPointerToElement(pVertex, &pFloat);
+            for (int i = 0; i < dims; ++i)
+                v[i] = pFloat[i];
+            pVertex += vbuf->getVertexSize();
+        }
+    }
+    //---------------------------------------------------------------------
+    auto readVertexAttributes(const VertexData* vertexData) -> VertexAttributes
+    {
+        VertexAttributes attribs;
+        readFloatElement(vertexData, VertexElementSemantic::POSITION, attribs.positions);
+        readFloatElement(vertexData, VertexElementSemantic::NORMAL, attribs.normals);
+        readFloatElement(vertexData, VertexElementSemantic::TEXTURE_COORDINATES, attribs.uvs);
+        return attribs;
+    }
+    //---------------------------------------------------------------------
+    auto readIndices(const IndexData* indexData) -> std::vector<uint32>
+    {
+        std::vector<uint32> indices(indexData->indexCount - indexData->indexCount % 3);
+        HardwareBufferLockGuard indexLock(indexData->indexBuffer, HardwareBuffer::LockOptions::READ_ONLY);
+        if (indexData->indexBuffer->getType() == HardwareIndexBuffer::IndexType::_32BIT)
+        {
+            const auto* pIdx = static_cast<const uint32*>(indexLock.pData) + indexData->indexStart;
+            std::copy_n(pIdx, indices.size(), indices.begin());
+        }
+        else
+        {
+            const auto* pIdx = static_cast<const uint16*>(indexLock.pData) + indexData->indexStart;
+            std::copy_n(pIdx, indices.size(), indices.begin());
+        }
+        return indices;
+    }
+
+    /// Symmetric 4x4 error quadric of a set of planes
+    struct Quadric
+    {
+        double a2{0}, ab{0}, ac{0}, ad{0};
+        double b2{0}, bc{0}, bd{0};
+        double c2{0}, cd{0};
+        double d2{0};
+
+        void addPlane(const Vector3& n, double d, double weight)
+        {
+            a2 += weight * n.x * n.x; ab += weight * n.x * n.y; ac += weight * n.x * n.z; ad += weight * n.x * d;
+            b2 += weight * n.y * n.y; bc += weight * n.y * n.z; bd += weight * n.y * d;
+            c2 += weight * n.z * n.z; cd += weight * n.z * d;
+            d2 += weight * d * d;
+        }
+
+        void add(const Quadric& q)
+        {
+            a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+            b2 += q.b2; bc += q.bc; bd += q.bd;
+            c2 += q.c2; cd += q.cd;
+            d2 += q.d2;
+        }
+
+        [[nodiscard]] auto evaluate(const Vector3& p) const -> double
+        {
+            double x = p.x, y = p.y, z = p.z;
+            return a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+                + b2 * y * y + 2 * bc * y * z + 2 * bd * y
+                + c2 * z * z + 2 * cd * z
+                + d2;
+        }
+    };
+
+    /** Incremental half-edge collapse of one SubMesh.
+    @remarks
+        Vertices are the indexed vertices of the SubMesh, positions are groups of
+        vertices at exactly the same location. Collapses are decided per position
+        and move every vertex of the position onto the vertex it shares an edge with,
+        so that seams between vertices with different attributes stay closed.
+    */
+    class SubMeshSimplifier
+    {
+    public:
+        SubMeshSimplifier(const VertexAttributes& attribs, const std::vector<uint32>& indices,
+            Real normalWeight, Real uvWeight, bool lockBorders);
+
+        /// Collapses until at most targetTris triangles remain and returns their indices
+        auto simplify(size_t targetTris) -> std::vector<uint32>;
+
+    private:
+        static constexpr uint32 NONE = ~0u;
+        /// Weight of the planes keeping borders and seams in place
+        static constexpr double CONSTRAINT_WEIGHT = 10.0;
+
+        struct Collapse
+        {
+            double cost;
+            uint32 from;
+            uint32 version;
+
+            auto operator>(const Collapse& rhs) const -> bool { return cost > rhs.cost; }
+        };
+
+        using VertexMove = std::pair<uint32, uint32>;
+
+        [[nodiscard]] auto containsPosition(uint32 tri, uint32 pos) const -> bool;
+        void gatherNeighbours(uint32 pos, std::vector<uint32>& neighbours) const;
+        [[nodiscard]] auto countEdgeTriangles(uint32 from, uint32 to) const -> size_t;
+        auto evaluateCollapse(uint32 from, uint32 to, size_t edgeTris,
+            const std::vector<uint32>& neighbours, std::vector<VertexMove>& moves) -> double;
+        auto findBestCollapse(uint32 pos, uint32& bestTo, std::vector<VertexMove>& bestMoves) -> double;
+        void updateCollapse(uint32 pos);
+        auto collapse(uint32 from, uint32 to, const std::vector<VertexMove>& moves) -> size_t;
+
+        Real mNormalWeight;
+        Real mUVWeight;
+        bool mLockBorders;
+
+        /// Per vertex
+        std::vector<uint32> mVertexIndex;
+        std::vector<uint32> mVertexPosition;
+        std::vector<Vector3> mVertexNormal;
+        std::vector<Vector2> mVertexUV;
+        std::vector<std::vector<uint32>> mVertexTris;
+
+        /// Per position
+        std::vector<Vector3> mPositions;
+        std::vector<std::vector<uint32>> mPositionVertices;
+        std::vector<Quadric> mQuadrics;
+        std::vector<uint32> mVersions;
+        std::vector<bool> mPositionDead;
+
+        /// Per triangle
+        std::vector<std::array<uint32, 3>> mTris;
+        std::vector<bool> mTriDead;
+        size_t mLiveTris{0};
+
+        std::priority_queue<Collapse, std::vector<Collapse>, std::greater<>> mQueue;
+
+        /// Scratch space, kept to avoid reallocating per evaluation
+        std::vector<uint32> mNeighbours;
+        std::vector<uint32> mTargetNeighbours;
+        std::vector<VertexMove> mMoves;
+        std::vector<VertexMove> mBestMoves;
+    };
+    //---------------------------------------------------------------------
+    SubMeshSimplifier::SubMeshSimplifier(const VertexAttributes& attribs, const std::vector<uint32>& indices,
+        Real normalWeight, Real uvWeight, bool lockBorders)
+        : mNormalWeight(attribs.normals.empty() ? 0 : normalWeight)
+        , mUVWeight(attribs.uvs.empty() ? 0 : uvWeight)
+        , mLockBorders(lockBorders)
+    {
+        // Compact the referenced vertices
+        std::vector<uint32> localIndex(attribs.positions.size(), NONE);
+        mTris.resize(indices.size() / 3);
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            uint32& local = localIndex[indices[i]];
+            if (local == NONE)
+            {
+                local = static_cast<uint32>(mVertexIndex.size());
+                mVertexIndex.push_back(indices[i]);
+            }
+            mTris[i / 3][i % 3] = local;
+        }
+        const size_t numVertices = mVertexIndex.size();
+
+        // Weld vertices at identical positions, working in a unit sized space so
+        // that errors are comparable between meshes of any scale
+        std::vector<uint32> order(numVertices);
+        for (uint32 i = 0; i < numVertices; ++i)
+            order[i] = i;
+        auto positionOf = [&](uint32 v) -> const Vector3& { return attribs.positions[mVertexIndex[v]]; };
+        std::ranges::sort(order, [&](uint32 lhs, uint32 rhs)
+        {
+            const Vector3& a = positionOf(lhs);
+            const Vector3& b = positionOf(rhs);
+            return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+        });
+
+        Vector3 minimum = positionOf(order.front()), maximum = minimum;
+        for (uint32 v : order)
+        {
+            minimum.makeFloor(positionOf(v));
+            maximum.makeCeil(positionOf(v));
+        }
+        Vector3 extent = maximum - minimum;
+        Real scale = std::max({extent.x, extent.y, extent.z});
+        scale = scale > 0 ? 1 / scale : 1;
+
+        mVertexPosition.resize(numVertices);
+        for (uint32 v : order)
+        {
+            if (mPositions.empty() || positionOf(v) != positionOf(mPositionVertices.back().front()))
+            {
+                mPositions.push_back((positionOf(v) - minimum) * scale);
+                mPositionVertices.emplace_back();
+            }
+            mVertexPosition[v] = static_cast<uint32>(mPositions.size() - 1);
+            mPositionVertices.back().push_back(v);
+        }
+        const size_t numPositions = mPositions.size();
+        mQuadrics.resize(numPositions);
+        mVersions.resize(numPositions, 0);
+        mPositionDead.resize(numPositions, false);
+
+        if (mNormalWeight > 0)
+        {
+            mVertexNormal.resize(numVertices);
+            for (uint32 v = 0; v < numVertices; ++v)
+                mVertexNormal[v] = attribs.normals[mVertexIndex[v]].normalisedCopy();
+        }
+        if (mUVWeight > 0)
+        {
+            mVertexUV.resize(numVertices);
+            for (uint32 v = 0; v < numVertices; ++v)
+                mVertexUV[v] = attribs.uvs[mVertexIndex[v]];
+        }
+
+        // Triangle planes, weighted by area
+        mVertexTris.resize(numVertices);
+        mTriDead.resize(mTris.size(), false);
+        std::vector<Vector3> triNormals(mTris.size());
+        for (uint32 t = 0; t < mTris.size(); ++t)
+        {
+            const auto& tri = mTris[t];
+            const Vector3& p0 = mPositions[mVertexPosition[tri[0]]];
+            const Vector3& p1 = mPositions[mVertexPosition[tri[1]]];
+            const Vector3& p2 = mPositions[mVertexPosition[tri[2]]];
+            Vector3 normal = (p1 - p0).crossProduct(p2 - p0);
+            Real length = normal.length();
+            if (length <= 0 || mVertexPosition[tri[0]] == mVertexPosition[tri[1]] ||
+                mVertexPosition[tri[1]] == mVertexPosition[tri[2]] ||
+                mVertexPosition[tri[2]] == mVertexPosition[tri[0]])
+            {
+                // Degenerate triangles are dropped from every LOD level
+                mTriDead[t] = true;
+                continue;
+            }
+            normal /= length;
+            triNormals[t] = normal;
+            for (uint32 v : tri)
+            {
+                mQuadrics[mVertexPosition[v]].addPlane(normal, -normal.dotProduct(p0), length * 0.5);
+                mVertexTris[v].push_back(t);
+            }
+            ++mLiveTris;
+        }
+
+        // Planes perpendicular to border and seam edges keep them from drifting
+        struct EdgeUse
+        {
+            uint32 count{0};
+            uint32 tri{NONE};
+            VertexMove vertices;
+            bool seam{false};
+        };
+        std::map<std::pair<uint32, uint32>, EdgeUse> edges;
+        for (uint32 t = 0; t < mTris.size(); ++t)
+        {
+            if (mTriDead[t])
+                continue;
+            for (int i = 0; i < 3; ++i)
+            {
+                uint32 va = mTris[t][i], vb = mTris[t][(i + 1) % 3];
+                uint32 pa = mVertexPosition[va], pb = mVertexPosition[vb];
+                auto& use = edges[std::minmax(pa, pb)];
+                VertexMove vertices = pa < pb ? VertexMove{va, vb} : VertexMove{vb, va};
+                if (use.count++ == 0)
+                {
+                    use.tri = t;
+                    use.vertices = vertices;
+                }
+                else if (use.vertices != vertices)
+                    use.seam = true;
+            }
+        }
+        for (const auto& [edge, use] : edges)
+        {
+            if (use.count != 1 && !use.seam)
+                continue;
+            const Vector3& pa = mPositions[edge.first];
+            const Vector3& pb = mPositions[edge.second];
+            Vector3 edgeDir = pb - pa;
+            Vector3 normal = edgeDir.crossProduct(triNormals[use.tri]);
+            Real length = normal.length();
+            if (length <= 0)
+                continue;
+            normal /= length;
+            double weight = CONSTRAINT_WEIGHT * edgeDir.squaredLength();
+            mQuadrics[edge.first].addPlane(normal, -normal.dotProduct(pa), weight);
+            mQuadrics[edge.second].addPlane(normal, -normal.dotProduct(pa), weight);
+        }
+
+        for (uint32 p = 0; p < numPositions; ++p)
+            updateCollapse(p);
+    }
+    //---------------------------------------------------------------------
+    auto SubMeshSimplifier::containsPosition(uint32 tri, uint32 pos) const -> bool
+    {
+        const auto& t = mTris[tri];
+        return mVertexPosition[t[0]] == pos || mVertexPosition[t[1]] == pos || mVertexPosition[t[2]] == pos;
+    }
+    //---------------------------------------------------------------------
+    void SubMeshSimplifier::gatherNeighbours(uint32 pos, std::vector<uint32>& neighbours) const
+    {
+        neighbours.clear();
+        for (uint32 v : mPositionVertices[pos])
+        {
+            for (uint32 t : mVertexTris[v])
+            {
+                if (mTriDead[t])
+                    continue;
+                for (uint32 other : mTris[t])
+                {
+                    if (mVertexPosition[other] != pos)
+                        neighbours.push_back(mVertexPosition[other]);
+                }
+            }
+        }
+        std::ranges::sort(neighbours);
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+    }
+    //---------------------------------------------------------------------
+    auto SubMeshSimplifier::countEdgeTriangles(uint32 from, uint32 to) const -> size_t
+    {
+        size_t count = 0;
+        for (uint32 v : mPositionVertices[from])
+        {
+            for (uint32 t : mVertexTris[v])
+            {
+                if (!mTriDead[t] && containsPosition(t, to))
+                    ++count;
+            }
+        }
+        return count;
+    }
+    //---------------------------------------------------------------------
+    auto SubMeshSimplifier::evaluateCollapse(uint32 from, uint32 to, size_t edgeTris,
+        const std::vector<uint32>& neighbours, std::vector<VertexMove>& moves) -> double
+    {
+        // Link condition: the positions shared by both ends may only be the ones
+        // opposite the collapsed edge, otherwise the surface gets pinched
+        gatherNeighbours(to, mTargetNeighbours);
+        size_t common = 0;
+        for (auto a = neighbours.cbegin(), b = mTargetNeighbours.cbegin();
+             a != neighbours.end() && b != mTargetNeighbours.end();)
+        {
+            if (*a < *b)
+                ++a;
+            else if (*b < *a)
+                ++b;
+            else
+            {
+                ++common;
+                ++a;
+                ++b;
+            }
+        }
+        if (common > edgeTris)
+            return -1;
+
+        // Every vertex at the source position has to follow an edge to exactly one
+        // vertex at the target, which keeps attribute seams closed
+        moves.clear();
+        for (uint32 v : mPositionVertices[from])
+        {
+            uint32 target = NONE;
+            bool used = false;
+            for (uint32 t : mVertexTris[v])
+            {
+                if (mTriDead[t])
+                    continue;
+                used = true;
+                for (uint32 other : mTris[t])
+                {
+                    if (mVertexPosition[other] != to)
+                        continue;
+                    if (target != NONE && target != other)
+                        return -1;
+                    target = other;
+                }
+            }
+            if (!used)
+                continue;
+            if (target == NONE)
+                return -1;
+            moves.emplace_back(v, target);
+        }
+
+        // Reject collapses that flip a remaining triangle
+        const Vector3& newPos = mPositions[to];
+        for (const auto& [v, target] : moves)
+        {
+            for (uint32 t : mVertexTris[v])
+            {
+                if (mTriDead[t] || containsPosition(t, to))
+                    continue;
+                std::array<Vector3, 3> p;
+                for (int i = 0; i < 3; ++i)
+                    p[i] = mPositions[mVertexPosition[mTris[t][i]]];
+                Vector3 before = (p[1] - p[0]).crossProduct(p[2] - p[0]);
+                for (int i = 0; i < 3; ++i)
+                {
+                    if (mTris[t][i] == v)
+                        p[i] = newPos;
+                }
+                Vector3 after = (p[1] - p[0]).crossProduct(p[2] - p[0]);
+                if (before.dotProduct(after) <= 0)
+                    return -1;
+            }
+        }
+
+        double cost = mQuadrics[from].evaluate(newPos);
+        double attributeError = 0;
+        for (const auto& [v, target] : moves)
+        {
+            if (mNormalWeight > 0)
+                attributeError += mNormalWeight *
+                    (1 - std::clamp(mVertexNormal[v].dotProduct(mVertexNormal[target]), Real(-1), Real(1)));
+            if (mUVWeight > 0)
+                attributeError += mUVWeight * (mVertexUV[v] - mVertexUV[target]).squaredLength();
+        }
+        // Attribute changes matter in proportion to the area they are spread over
+        cost += attributeError * (mPositions[from] - newPos).squaredLength();
+        return std::max(cost, 0.0);
+    }
+    //---------------------------------------------------------------------
+    auto SubMeshSimplifier::findBestCollapse(uint32 pos, uint32& bestTo, std::vector<VertexMove>& bestMoves) -> double
+    {
+        bestTo = NONE;
+        if (mPositionDead[pos])
+            return -1;
+
+        gatherNeighbours(pos, mNeighbours);
+        std::vector<size_t> edgeTris(mNeighbours.size());
+        bool border = false;
+        for (size_t i = 0; i < mNeighbours.size(); ++i)
+        {
+            edgeTris[i] = countEdgeTriangles(pos, mNeighbours[i]);
+            // Non-manifold positions are never moved
+            if (edgeTris[i] > 2)
+                return -1;
+            border |= edgeTris[i] == 1;
+        }
+        if (border && mLockBorders)
+            return -1;
+
+        double bestCost = -1;
+        for (size_t i = 0; i < mNeighbours.size(); ++i)
+        {
+            // Border positions only slide along the border
+            if (border && edgeTris[i] != 1)
+                continue;
+            double cost = evaluateCollapse(pos, mNeighbours[i], edgeTris[i], mNeighbours, mMoves);
+            if (cost >= 0 && (bestCost < 0 || cost < bestCost))
+            {
+                bestCost = cost;
+                bestTo = mNeighbours[i];
+                bestMoves.swap(mMoves);
+            }
+        }
+        return bestCost;
+    }
+    //---------------------------------------------------------------------
+    void SubMeshSimplifier::updateCollapse(uint32 pos)
+    {
+        uint32 to;
+        double cost = findBestCollapse(pos, to, mBestMoves);
+        ++mVersions[pos];
+        if (cost >= 0)
+            mQueue.push({cost, pos, mVersions[pos]});
+    }
+    //---------------------------------------------------------------------
+    auto SubMeshSimplifier::collapse(uint32 from, uint32 to, const std::vector<VertexMove>& moves) -> size_t
+    {
+        size_t removed = 0;
+        for (const auto& [v, target] : moves)
+        {
+            for (uint32 t : mVertexTris[v])
+            {
+                if (mTriDead[t])
+                    continue;
+                if (containsPosition(t, to))
+                {
+                    mTriDead[t] = true;
+                    ++removed;
+                    continue;
+                }
+                std::ranges::replace(mTris[t], v, target);
+                mVertexTris[target].push_back(t);
+            }
+            mVertexTris[v].clear();
+        }
+        mQuadrics[to].add(mQuadrics[from]);
+        mPositionDead[from] = true;
+        return removed;
+    }
+    //---------------------------------------------------------------------
+    auto SubMeshSimplifier::simplify(size_t targetTris) -> std::vector<uint32>
+    {
+        std::vector<uint32> neighbours;
+        while (mLiveTris > targetTris && !mQueue.empty())
+        {
+            Collapse top = mQueue.top();
+            mQueue.pop();
+            if (mPositionDead[top.from] || top.version != mVersions[top.from])
+                continue;
+
+            // The neighbourhood may have changed since this entry was queued
+            uint32 to;
+            double cost = findBestCollapse(top.from, to, mBestMoves);
+            if (cost < 0)
+                continue;
+            if (cost > top.cost * 1.0001 + 1e-12)
+            {
+                ++mVersions[top.from];
+                mQueue.push({cost, top.from, mVersions[top.from]});
+                continue;
+            }
+
+            // Never remove the last triangles of the SubMesh
+            if (countEdgeTriangles(top.from, to) >= mLiveTris)
+                break;
+
+            mLiveTris -= collapse(top.from, to, mBestMoves);
+
+            gatherNeighbours(to, neighbours);
+            updateCollapse(to);
+            for (uint32 p : neighbours)
+                updateCollapse(p);
+        }
+
+        std::vector<uint32> indices;
+        indices.reserve(mLiveTris * 3);
+        for (uint32 t = 0; t < mTris.size(); ++t)
+        {
+            if (mTriDead[t])
+                continue;
+            for (uint32 v : mTris[t])
+                indices.push_back(mVertexIndex[v]);
+        }
+        return indices;
+    }
+    //---------------------------------------------------------------------
+    auto createLodIndexData(Mesh* mesh, const SubMesh* sm, const std::vector<uint32>* indices) -> IndexData*
+    {
+        auto* indexData = new IndexData();
+        if (!indices)
+        {
+            // Geometry the generator can't reduce is drawn at full detail
+            indexData->indexBuffer = sm->indexData->indexBuffer;
+            indexData->indexStart = sm->indexData->indexStart;
+            indexData->indexCount = sm->indexData->indexCount;
+            return indexData;
+        }
+
+        HardwareIndexBuffer::IndexType type = sm->indexData->indexBuffer->getType();
+        indexData->indexBuffer = mesh->getHardwareBufferManager()->createIndexBuffer(
+            type, indices->size(), mesh->getIndexBufferUsage(), mesh->isIndexBufferShadowed());
+        indexData->indexStart = 0;
+        indexData->indexCount = indices->size();
+
+        HardwareBufferLockGuard indexLock(indexData->indexBuffer, HardwareBuffer::LockOptions::DISCARD);
+        if (type == HardwareIndexBuffer::IndexType::_32BIT)
+            memcpy(indexLock.pData, indices->data(), indices->size() * sizeof(uint32));
+        else
+            std::ranges::transform(*indices, static_cast<uint16*>(indexLock.pData),
+                [](uint32 i) { return static_cast<uint16>(i); });
+        return indexData;
+    }
+}
+    //---------------------------------------------------------------------
+    MeshLodGenerator::MeshLodGenerator() = default;
+    //---------------------------------------------------------------------
+    void MeshLodGenerator::addLodLevel(Real userValue, Real reductionRatio)
+    {
+        OgreAssert(reductionRatio >= 0 && reductionRatio < 1, "reduction ratio must be in [0, 1)");
+        mLevels.push_back({userValue, reductionRatio});
+    }
+    //---------------------------------------------------------------------
+    void MeshLodGenerator::generate(Mesh* mesh)
+    {
+        if (mLevels.empty())
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "No LOD levels to generate",
+                "MeshLodGenerator::generate");
+        }
+
+        LodStrategy* strategy = mStrategy ? mStrategy : LodStrategyManager::getSingleton().getDefaultStrategy();
+
+        // Coarser levels have to come later in the strategy's order too
+        LodLevelList levels = mLevels;
+        std::ranges::stable_sort(levels, {}, &LodLevel::reductionRatio);
+        Mesh::LodValueList values;
+        for (const auto& level : levels)
+            values.push_back(strategy->transformUserValue(level.userValue));
+        if (!strategy->isSorted(values))
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, ::std::format(
+                "LOD values of mesh {} do not decrease in detail as the reduction ratio increases "
+                "for LOD strategy {}", mesh->getName(), strategy->getName()),
+                "MeshLodGenerator::generate");
+        }
+
+        // Read the source geometry up front so the workers never touch hardware buffers
+        struct SubMeshJob
+        {
+            const VertexAttributes* attribs{nullptr};
+            std::vector<uint32> indices;
+            std::vector<std::vector<uint32>> lodIndices;
+            std::exception_ptr error;
+        };
+        std::map<const VertexData*, VertexAttributes> attributeCache;
+        std::vector<SubMeshJob> jobs(mesh->getSubMeshes().size());
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            const SubMesh* sm = mesh->getSubMeshes()[i];
+            const VertexData* vertexData = sm->useSharedVertices ? mesh->sharedVertexData : sm->vertexData.get();
+            if (sm->operationType != RenderOperation::OperationType::TRIANGLE_LIST || !vertexData ||
+                !sm->indexData || !sm->indexData->indexBuffer || sm->indexData->indexCount < 3)
+                continue;
+
+            auto it = attributeCache.find(vertexData);
+            if (it == attributeCache.end())
+                it = attributeCache.emplace(vertexData, readVertexAttributes(vertexData)).first;
+            if (it->second.positions.empty())
+                continue;
+
+            jobs[i].attribs = &it->second;
+            jobs[i].indices = readIndices(sm->indexData.get());
+            if (std::ranges::any_of(jobs[i].indices, [&](uint32 idx) { return idx >= it->second.positions.size(); }))
+            {
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, ::std::format(
+                    "SubMesh {} of mesh {} references vertices outside of its vertex data", i, mesh->getName()),
+                    "MeshLodGenerator::generate");
+            }
+        }
+
+        // Each SubMesh is simplified once, taking a snapshot at every level
+        std::atomic<size_t> nextJob{0};
+        auto worker = [&]
+        {
+            for (size_t i; (i = nextJob++) < jobs.size();)
+            {
+                SubMeshJob& job = jobs[i];
+                if (!job.attribs)
+                    continue;
+                try
+                {
+                    SubMeshSimplifier simplifier(*job.attribs, job.indices, mNormalWeight, mUVWeight, mLockBorders);
+                    size_t numTris = job.indices.size() / 3;
+                    for (const auto& level : levels)
+                    {
+                        auto target = static_cast<size_t>(numTris * (1 - level.reductionRatio));
+                        job.lodIndices.push_back(simplifier.simplify(std::max<size_t>(target, 1)));
+                    }
+                }
+                catch (...)
+                {
+                    job.error = std::current_exception();
+                }
+            }
+        };
+
+        TaskPool& pool = TaskPool::get();
+        size_t const numTasks = std::min<size_t>(mNumThreads ? mNumThreads : pool.getConcurrency(), jobs.size());
+        pool.run(static_cast<uint32>(numTasks), [&](uint32) { worker(); });
+
+        for (const auto& job : jobs)
+        {
+            if (job.error)
+                std::rethrow_exception(job.error);
+        }
+
+        // Replace the LOD setup of the mesh
+        bool edgeListsBuilt = mesh->isEdgeListBuilt();
+        mesh->freeEdgeList();
+        mesh->removeLodLevels();
+        mesh->_setLodInfo(static_cast<unsigned short>(levels.size() + 1));
+        for (unsigned short l = 1; l <= levels.size(); ++l)
+        {
+            MeshLodUsage usage;
+            usage.userValue = levels[l - 1].userValue;
+            usage.value = values[l - 1];
+            mesh->_setLodUsage(l, usage);
+
+            for (unsigned short i = 0; i < jobs.size(); ++i)
+            {
+                const std::vector<uint32>* indices = jobs[i].attribs ? &jobs[i].lodIndices[l - 1] : nullptr;
+                mesh->_setSubMeshLodFaceList(i, l, createLodIndexData(mesh, mesh->getSubMeshes()[i], indices));
+            }
+        }
+        mesh->setLodStrategy(strategy);
+
+        if (edgeListsBuilt)
+            mesh->buildEdgeList();
+    }
+    //---------------------------------------------------------------------
+    void MeshLodGenerator::generateAndExport(Mesh* mesh, std::string_view filename)
+    {
+        generate(mesh);
+
+        MeshSerializer serializer;
+        serializer.exportMesh(mesh, filename);
+    }
+}
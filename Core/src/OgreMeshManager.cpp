@@ -80,6 +80,7 @@ namespace Ogre
             Mesh* dst = any_cast<Mesh*>(output);
             MeshSerializer serializer;
             serializer.setListener(MeshManager::getSingleton().getListener());
+            serializer.setParallelImport(MeshManager::getSingleton().getParallelImport());
             serializer.importMesh(input, dst);
         }
     };
@@ -0,0 +1,885 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cmath>
+#include <cstring>
+
+module Ogre.Core;
+
+import :Exception;
+import :HardwareBuffer;
+import :HardwareBufferManager;
+import :HardwareIndexBuffer;
+import :HardwareVertexBuffer;
+import :LogManager;
+import :Mesh;
+import :MeshOptimiser;
+import :MeshSerializer;
+import :RenderOperation;
+import :SharedPtr;
+import :SubMesh;
+import :Vector;
+import :VertexBoneAssignment;
+import :VertexIndexData;
+
+import <algorithm>;
+import <format>;
+import <map>;
+import <numeric>;
+import <tuple>;
+import <vector>;
+
+namespace Ogre
+{
+namespace
+{
+    constexpr uint32 NO_VERTEX = ~0u;
+
+    /// CPU copy of an index range
+    struct IndexRange
+    {
+        IndexData* indexData;
+        /// The SubMesh the index data belongs to
+        SubMesh* subMesh;
+        /// Triangle list that is not sharing its buffer, so its triangles may be reordered
+        bool reorderable{false};
+        /// Part of the full detail geometry, used for statistics
+        bool fullDetail{false};
+        bool changed{false};
+        std::vector<uint32> indices;
+    };
+
+    /// A VertexData and all the index ranges referencing it
+    struct VertexSet
+    {
+        VertexData* vertexData;
+        /// The SubMesh owning the vertex data, nullptr for shared vertex data
+        SubMesh* owner{nullptr};
+        std::vector<IndexRange> ranges;
+        bool canRemapVertices{true};
+        bool verticesChanged{false};
+
+        size_t vertexCount{0};
+        std::vector<unsigned short> sources;
+        std::vector<size_t> vertexSizes;
+        std::vector<std::vector<uint8>> vertexBytes;
+        std::vector<Vector3> positions;
+        std::vector<std::vector<VertexBoneAssignment>> boneAssignments;
+    };
+
+    /// Limits the meshlets of a SubMesh were built with, so rebuilding them keeps their size
+    struct MeshletLimits
+    {
+        size_t maxVertices{3};
+        size_t maxTriangles{1};
+    };
+
+    /// FIFO post-transform cache, as simulated by VertexCacheProfiler
+    class FifoCache
+    {
+    public:
+        explicit FifoCache(size_t size) : mEntries(size, NO_VERTEX) {}
+
+        void reset()
+        {
+            std::ranges::fill(mEntries, NO_VERTEX);
+            mTail = 0;
+        }
+
+        /// Returns true on a cache miss
+        auto access(uint32 vertex) -> bool
+        {
+            if (std::ranges::find(mEntries, vertex) != mEntries.end())
+                return false;
+            mEntries[mTail] = vertex;
+            mTail = (mTail + 1) % mEntries.size();
+            return true;
+        }
+
+        auto accessTriangle(const uint32* tri) -> size_t
+        {
+            return size_t(access(tri[0])) + access(tri[1]) + access(tri[2]);
+        }
+
+    private:
+        std::vector<uint32> mEntries;
+        size_t mTail{0};
+    };
+    //---------------------------------------------------------------------
+    auto getPassName(MeshOptimiserPass pass) -> std::string_view
+    {
+        switch (pass)
+        {
+        case MeshOptimiserPass::WELD_VERTICES: return "vertex welding";
+        case MeshOptimiserPass::VERTEX_CACHE: return "vertex cache";
+        case MeshOptimiserPass::OVERDRAW: return "overdraw";
+        case MeshOptimiserPass::VERTEX_FETCH: return "vertex fetch";
+        default: return "none";
+        }
+    }
+    //---------------------------------------------------------------------
+    auto readIndexRange(IndexData* indexData) -> std::vector<uint32>
+    {
+        std::vector<uint32> indices(indexData->indexCount);
+        HardwareBufferLockGuard indexLock(indexData->indexBuffer, HardwareBuffer::LockOptions::READ_ONLY);
+        if (indexData->indexBuffer->getType() == HardwareIndexBuffer::IndexType::_32BIT)
+            std::copy_n(static_cast<const uint32*>(indexLock.pData) + indexData->indexStart,
+                indices.size(), indices.begin());
+        else
+            std::copy_n(static_cast<const uint16*>(indexLock.pData) + indexData->indexStart,
+                indices.size(), indices.begin());
+        return indices;
+    }
+    //---------------------------------------------------------------------
+    void writeIndexRange(const IndexRange& range)
+    {
+        IndexData* indexData = range.indexData;
+        const auto& ibuf = indexData->indexBuffer;
+        size_t indexSize = ibuf->getIndexSize();
+        if (ibuf->getType() == HardwareIndexBuffer::IndexType::_32BIT)
+        {
+            ibuf->writeData(indexData->indexStart * indexSize, range.indices.size() * indexSize,
+                range.indices.data());
+        }
+        else
+        {
+            std::vector<uint16> indices16(range.indices.begin(), range.indices.end());
+            ibuf->writeData(indexData->indexStart * indexSize, indices16.size() * indexSize,
+                indices16.data());
+        }
+    }
+    //---------------------------------------------------------------------
+    auto collectVertexSets(const Mesh* mesh) -> std::vector<VertexSet>
+    {
+        std::vector<VertexSet> sets;
+        std::map<const VertexData*, size_t> setIndex;
+        // Index buffers referenced by more than one IndexData must keep their layout
+        std::map<const HardwareIndexBuffer*, size_t> bufferUsers;
+
+        for (SubMesh* sm : mesh->getSubMeshes())
+        {
+            VertexData* vertexData = sm->useSharedVertices ? mesh->sharedVertexData : sm->vertexData.get();
+            if (!vertexData)
+                continue;
+            auto it = setIndex.emplace(vertexData, sets.size()).first;
+            if (it->second == sets.size())
+            {
+                sets.emplace_back().vertexData = vertexData;
+                sets.back().owner = sm->useSharedVertices ? nullptr : sm;
+            }
+            VertexSet& set = sets[it->second];
+
+            if (!sm->indexData || !sm->indexData->indexBuffer || sm->indexData->indexCount == 0)
+            {
+                // Drawn straight from the vertex buffer, the vertex order is significant
+                set.canRemapVertices = false;
+                continue;
+            }
+
+            bool triangleList = sm->operationType == RenderOperation::OperationType::TRIANGLE_LIST;
+            set.ranges.push_back({sm->indexData.get(), sm, triangleList, true});
+            for (IndexData* lod : sm->mLodFaceList)
+            {
+                if (lod && lod->indexBuffer && lod->indexCount > 0)
+                    set.ranges.push_back({lod, sm, triangleList, false});
+            }
+        }
+
+        for (const auto& set : sets)
+            for (const auto& range : set.ranges)
+                ++bufferUsers[range.indexData->indexBuffer.get()];
+
+        const bool vertexAnimation = mesh->hasVertexAnimation() || mesh->getPoseCount() > 0;
+        for (auto& set : sets)
+        {
+            VertexData* vertexData = set.vertexData;
+            set.vertexCount = vertexData->vertexCount;
+            if (vertexAnimation || vertexData->vertexStart != 0)
+                set.canRemapVertices = false;
+
+            for (auto& range : set.ranges)
+            {
+                range.reorderable &= bufferUsers[range.indexData->indexBuffer.get()] == 1;
+                range.indices = readIndexRange(range.indexData);
+            }
+
+            for (const auto& [source, vbuf] : vertexData->vertexBufferBinding->getBindings())
+            {
+                set.sources.push_back(source);
+                set.vertexSizes.push_back(vbuf->getVertexSize());
+                auto& bytes = set.vertexBytes.emplace_back(set.vertexCount * vbuf->getVertexSize());
+                vbuf->readData(vertexData->vertexStart * vbuf->getVertexSize(), bytes.size(), bytes.data());
+            }
+
+            const VertexElement* posElem =
+                vertexData->vertexDeclaration->findElementBySemantic(VertexElementSemantic::POSITION);
+            if (posElem && posElem->getType() == VertexElementType::FLOAT3)
+            {
+                size_t src = std::ranges::find(set.sources, posElem->getSource()) - set.sources.begin();
+                if (src < set.sources.size())
+                {
+                    set.positions.resize(set.vertexCount);
+                    for (size_t v = 0; v < set.vertexCount; ++v)
+                        memcpy(&set.positions[v], &set.vertexBytes[src][v * set.vertexSizes[src] + posElem->getOffset()],
+                            sizeof(float) * 3);
+                }
+            }
+
+            set.boneAssignments.resize(set.vertexCount);
+            const auto& assignments = set.owner ? set.owner->getBoneAssignments() : mesh->getBoneAssignments();
+            for (const auto& [vertex, assignment] : assignments)
+            {
+                if (vertex < set.vertexCount)
+                    set.boneAssignments[vertex].push_back(assignment);
+            }
+            for (auto& list : set.boneAssignments)
+                std::ranges::sort(list, {}, &VertexBoneAssignment::boneIndex);
+
+            // Indices outside of the vertex data can't be remapped
+            for (const auto& range : set.ranges)
+            {
+                if (std::ranges::any_of(range.indices, [&](uint32 i) { return i >= set.vertexCount; }))
+                    set.canRemapVertices = false;
+            }
+        }
+        return sets;
+    }
+    //---------------------------------------------------------------------
+    auto measure(const std::vector<VertexSet>& sets, size_t cacheSize) -> MeshOptimiser::Statistics
+    {
+        // Vertex fetches are measured with a small direct mapped cache of 64 byte lines
+        static constexpr size_t LINE_SIZE = 64;
+        static constexpr size_t LINE_COUNT = 64;
+
+        MeshOptimiser::Statistics stats;
+        size_t misses = 0, fetchedBytes = 0, vertexBytes = 0;
+        FifoCache cache(cacheSize);
+        std::vector<std::vector<size_t>> lines;
+        for (const auto& set : sets)
+        {
+            bool hasTriangles = false;
+            lines.assign(set.vertexSizes.size(), std::vector<size_t>(LINE_COUNT, ~size_t(0)));
+            for (const auto& range : set.ranges)
+            {
+                if (!range.fullDetail || !range.reorderable)
+                    continue;
+                hasTriangles = true;
+                cache.reset();
+                for (auto& sourceLines : lines)
+                    std::ranges::fill(sourceLines, ~size_t(0));
+                for (size_t i = 0; i + 2 < range.indices.size(); i += 3)
+                {
+                    ++stats.triangleCount;
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        uint32 v = range.indices[i + k];
+                        if (!cache.access(v))
+                            continue;
+                        ++misses;
+                        for (size_t s = 0; s < set.vertexSizes.size(); ++s)
+                        {
+                            size_t first = v * set.vertexSizes[s] / LINE_SIZE;
+                            size_t last = ((v + 1) * set.vertexSizes[s] - 1) / LINE_SIZE;
+                            for (size_t line = first; line <= last; ++line)
+                            {
+                                size_t& slot = lines[s][line % LINE_COUNT];
+                                if (slot != line)
+                                {
+                                    slot = line;
+                                    fetchedBytes += LINE_SIZE;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            if (hasTriangles)
+            {
+                stats.vertexCount += set.vertexCount;
+                vertexBytes += set.vertexCount * std::accumulate(set.vertexSizes.begin(), set.vertexSizes.end(), size_t(0));
+            }
+        }
+
+        if (stats.triangleCount)
+            stats.acmr = Real(misses) / stats.triangleCount;
+        if (stats.vertexCount)
+            stats.atvr = Real(misses) / stats.vertexCount;
+        if (vertexBytes)
+            stats.overfetch = Real(fetchedBytes) / vertexBytes;
+        return stats;
+    }
+    //---------------------------------------------------------------------
+    /// Moves vertex v to newIndex[v], dropping vertices mapped to NO_VERTEX
+    void remapVertices(VertexSet& set, const std::vector<uint32>& newIndex, size_t newCount)
+    {
+        for (size_t s = 0; s < set.vertexBytes.size(); ++s)
+        {
+            size_t size = set.vertexSizes[s];
+            std::vector<uint8> bytes(newCount * size);
+            for (size_t v = 0; v < set.vertexCount; ++v)
+            {
+                if (newIndex[v] != NO_VERTEX)
+                    memcpy(&bytes[newIndex[v] * size], &set.vertexBytes[s][v * size], size);
+            }
+            set.vertexBytes[s].swap(bytes);
+        }
+
+        auto remapList = [&](auto& list)
+        {
+            std::remove_reference_t<decltype(list)> remapped(newCount);
+            for (size_t v = 0; v < set.vertexCount; ++v)
+            {
+                if (newIndex[v] != NO_VERTEX)
+                    remapped[newIndex[v]] = list[v];
+            }
+            list.swap(remapped);
+        };
+        if (!set.positions.empty())
+            remapList(set.positions);
+        remapList(set.boneAssignments);
+
+        for (auto& range : set.ranges)
+        {
+            for (uint32& i : range.indices)
+                i = newIndex[i];
+            range.changed = true;
+        }
+
+        set.vertexCount = newCount;
+        set.verticesChanged = true;
+    }
+    //---------------------------------------------------------------------
+    void weldVertices(VertexSet& set)
+    {
+        auto compareVertices = [&](uint32 a, uint32 b) -> int
+        {
+            for (size_t s = 0; s < set.vertexBytes.size(); ++s)
+            {
+                size_t size = set.vertexSizes[s];
+                if (int diff = memcmp(&set.vertexBytes[s][a * size], &set.vertexBytes[s][b * size], size))
+                    return diff;
+            }
+            const auto& ba = set.boneAssignments[a];
+            const auto& bb = set.boneAssignments[b];
+            auto key = [](const VertexBoneAssignment& vba) { return std::tuple(vba.boneIndex, vba.weight); };
+            if (std::ranges::lexicographical_compare(ba, bb, {}, key, key))
+                return -1;
+            if (std::ranges::lexicographical_compare(bb, ba, {}, key, key))
+                return 1;
+            return 0;
+        };
+
+        std::vector<uint32> order(set.vertexCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::sort(order, [&](uint32 a, uint32 b)
+        {
+            int diff = compareVertices(a, b);
+            return diff != 0 ? diff < 0 : a < b;
+        });
+
+        // Every vertex refers to the first of its duplicates
+        std::vector<uint32> canonical(set.vertexCount);
+        bool duplicates = false;
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            if (i > 0 && compareVertices(order[i - 1], order[i]) == 0)
+            {
+                canonical[order[i]] = canonical[order[i - 1]];
+                duplicates = true;
+            }
+            else
+                canonical[order[i]] = order[i];
+        }
+        if (!duplicates)
+            return;
+
+        // Duplicates are no longer referenced and dropped, the rest keeps its order
+        std::vector<uint32> kept(set.vertexCount, NO_VERTEX);
+        uint32 newCount = 0;
+        for (uint32 v = 0; v < set.vertexCount; ++v)
+        {
+            if (canonical[v] == v)
+                kept[v] = newCount++;
+        }
+        for (auto& range : set.ranges)
+        {
+            for (uint32& i : range.indices)
+                i = canonical[i];
+        }
+        remapVertices(set, kept, newCount);
+    }
+    //---------------------------------------------------------------------
+    void optimiseVertexFetch(VertexSet& set)
+    {
+        std::vector<uint32> newIndex(set.vertexCount, NO_VERTEX);
+        uint32 newCount = 0;
+        bool identity = true;
+        for (const auto& range : set.ranges)
+        {
+            for (uint32 i : range.indices)
+            {
+                if (newIndex[i] == NO_VERTEX)
+                {
+                    identity &= newCount == i;
+                    newIndex[i] = newCount++;
+                }
+            }
+        }
+        if (identity && newCount == set.vertexCount)
+            return;
+        remapVertices(set, newIndex, newCount);
+    }
+    //---------------------------------------------------------------------
+    /** Linear speed vertex cache optimisation (Forsyth).
+    @remarks
+        Triangles are emitted greedily by the score of their vertices, which favours
+        vertices recently used and vertices with few remaining triangles.
+    */
+    auto optimiseVertexCache(const std::vector<uint32>& indices, size_t vertexCount) -> std::vector<uint32>
+    {
+        static constexpr int CACHE_SIZE = 32;
+        static constexpr float CACHE_DECAY_POWER = 1.5f;
+        static constexpr float LAST_TRI_SCORE = 0.75f;
+        static constexpr float VALENCE_BOOST_SCALE = 2.0f;
+        static constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+        const size_t numTris = indices.size() / 3;
+
+        // Triangles adjacent to each vertex
+        std::vector<uint32> offsets(vertexCount + 1, 0);
+        for (size_t i = 0; i < numTris * 3; ++i)
+            ++offsets[indices[i] + 1];
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        std::vector<uint32> remaining(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+            remaining[v] = offsets[v + 1] - offsets[v];
+        std::vector<uint32> adjacency(numTris * 3);
+        {
+            std::vector<uint32> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < numTris * 3; ++i)
+                adjacency[fill[indices[i]]++] = static_cast<uint32>(i / 3);
+        }
+
+        std::vector<int> cachePosition(vertexCount, -1);
+        auto vertexScore = [&](uint32 v) -> float
+        {
+            if (remaining[v] == 0)
+                return -1.0f;
+            float score = 0;
+            int pos = cachePosition[v];
+            if (pos >= 0)
+            {
+                if (pos < 3)
+                    score = LAST_TRI_SCORE;
+                else
+                    score = std::pow(1.0f - float(pos - 3) / (CACHE_SIZE - 3), CACHE_DECAY_POWER);
+            }
+            return score + VALENCE_BOOST_SCALE * std::pow(float(remaining[v]), -VALENCE_BOOST_POWER);
+        };
+
+        std::vector<float> scores(vertexCount);
+        for (uint32 v = 0; v < vertexCount; ++v)
+            scores[v] = vertexScore(v);
+        std::vector<float> triScores(numTris);
+        for (size_t t = 0; t < numTris; ++t)
+            triScores[t] = scores[indices[t * 3]] + scores[indices[t * 3 + 1]] + scores[indices[t * 3 + 2]];
+
+        std::vector<bool> emitted(numTris, false);
+        std::vector<uint32> result;
+        result.reserve(numTris * 3);
+        std::vector<uint32> cache, newCache;
+        cache.reserve(CACHE_SIZE + 3);
+        newCache.reserve(CACHE_SIZE + 3);
+
+        uint32 best = numTris ? static_cast<uint32>(std::ranges::max_element(triScores) - triScores.begin()) : NO_VERTEX;
+        size_t cursor = 0;
+        for (size_t count = 0; count < numTris; ++count)
+        {
+            if (best == NO_VERTEX)
+            {
+                // Nothing in the cache has triangles left, continue with the next unused one
+                while (emitted[cursor])
+                    ++cursor;
+                best = static_cast<uint32>(cursor);
+            }
+
+            const uint32* tri = &indices[best * 3];
+            result.insert(result.end(), tri, tri + 3);
+            emitted[best] = true;
+
+            for (int k = 0; k < 3; ++k)
+            {
+                uint32 v = tri[k];
+                auto begin = adjacency.begin() + offsets[v];
+                auto end = begin + remaining[v];
+                std::iter_swap(std::find(begin, end, best), end - 1);
+                --remaining[v];
+            }
+
+            // Move the triangle's vertices to the front of the LRU cache
+            newCache.assign(tri, tri + 3);
+            for (uint32 v : cache)
+            {
+                if (v != tri[0] && v != tri[1] && v != tri[2])
+                    newCache.push_back(v);
+            }
+            for (size_t i = 0; i < newCache.size(); ++i)
+                cachePosition[newCache[i]] = i < CACHE_SIZE ? int(i) : -1;
+
+            // Rescore everything touched, evicted vertices included
+            best = NO_VERTEX;
+            float bestScore = -1;
+            for (uint32 v : newCache)
+            {
+                float score = vertexScore(v);
+                float delta = score - scores[v];
+                scores[v] = score;
+                for (uint32 i = 0; i < remaining[v]; ++i)
+                {
+                    uint32 t = adjacency[offsets[v] + i];
+                    triScores[t] += delta;
+                }
+            }
+            if (newCache.size() > CACHE_SIZE)
+                newCache.resize(CACHE_SIZE);
+            for (uint32 v : newCache)
+            {
+                for (uint32 i = 0; i < remaining[v]; ++i)
+                {
+                    uint32 t = adjacency[offsets[v] + i];
+                    if (triScores[t] > bestScore)
+                    {
+                        bestScore = triScores[t];
+                        best = t;
+                    }
+                }
+            }
+            cache.swap(newCache);
+        }
+
+        result.insert(result.end(), indices.begin() + numTris * 3, indices.end());
+        return result;
+    }
+    //---------------------------------------------------------------------
+    /** Reorders clusters of triangles to reduce overdraw (Sander et al. 2007).
+    @remarks
+        The cache optimised order is split into clusters where the cache restarts
+        anyway, and further where the ACMR within the cluster is good enough. The
+        clusters are then sorted so those facing away from the mesh centre come first.
+    */
+    auto optimiseOverdraw(const std::vector<uint32>& indices, const std::vector<Vector3>& positions,
+        size_t cacheSize, Real threshold) -> std::vector<uint32>
+    {
+        const size_t numTris = indices.size() / 3;
+        if (numTris < 2)
+            return indices;
+
+        FifoCache cache(cacheSize);
+        std::vector<size_t> hardBoundaries;
+        for (size_t t = 0; t < numTris; ++t)
+        {
+            if (cache.accessTriangle(&indices[t * 3]) == 3 || t == 0)
+                hardBoundaries.push_back(t);
+        }
+        hardBoundaries.push_back(numTris);
+
+        std::vector<size_t> clusters;
+        for (size_t h = 0; h + 1 < hardBoundaries.size(); ++h)
+        {
+            size_t start = hardBoundaries[h], end = hardBoundaries[h + 1];
+            cache.reset();
+            size_t clusterMisses = 0;
+            for (size_t t = start; t < end; ++t)
+                clusterMisses += cache.accessTriangle(&indices[t * 3]);
+            Real clusterThreshold = threshold * Real(clusterMisses) / (end - start);
+
+            clusters.push_back(start);
+            cache.reset();
+            size_t misses = 0, tris = 0;
+            for (size_t t = start; t + 1 < end; ++t)
+            {
+                misses += cache.accessTriangle(&indices[t * 3]);
+                ++tris;
+                if (Real(misses) / tris <= clusterThreshold)
+                {
+                    clusters.push_back(t + 1);
+                    cache.reset();
+                    misses = tris = 0;
+                }
+            }
+        }
+        clusters.push_back(numTris);
+
+        auto triangleGeometry = [&](size_t t, Vector3& centroid, Vector3& normal)
+        {
+            const Vector3& p0 = positions[indices[t * 3]];
+            const Vector3& p1 = positions[indices[t * 3 + 1]];
+            const Vector3& p2 = positions[indices[t * 3 + 2]];
+            normal = (p1 - p0).crossProduct(p2 - p0);
+            centroid = (p0 + p1 + p2) / 3;
+        };
+
+        Vector3 meshCentroid = Vector3::ZERO;
+        Real meshArea = 0;
+        for (size_t t = 0; t < numTris; ++t)
+        {
+            Vector3 centroid, normal;
+            triangleGeometry(t, centroid, normal);
+            Real area = normal.length();
+            meshCentroid += centroid * area;
+            meshArea += area;
+        }
+        if (meshArea > 0)
+            meshCentroid /= meshArea;
+
+        std::vector<std::pair<Real, size_t>> sortKeys;
+        for (size_t c = 0; c + 1 < clusters.size(); ++c)
+        {
+            Vector3 clusterCentroid = Vector3::ZERO, clusterNormal = Vector3::ZERO;
+            Real clusterArea = 0;
+            for (size_t t = clusters[c]; t < clusters[c + 1]; ++t)
+            {
+                Vector3 centroid, normal;
+                triangleGeometry(t, centroid, normal);
+                Real area = normal.length();
+                clusterCentroid += centroid * area;
+                clusterNormal += normal;
+                clusterArea += area;
+            }
+            Real key = 0;
+            Real normalLength = clusterNormal.length();
+            if (clusterArea > 0 && normalLength > 0)
+                key = (clusterCentroid / clusterArea - meshCentroid).dotProduct(clusterNormal / normalLength);
+            sortKeys.emplace_back(-key, c);
+        }
+        std::ranges::stable_sort(sortKeys, {}, &std::pair<Real, size_t>::first);
+
+        std::vector<uint32> result;
+        result.reserve(indices.size());
+        for (const auto& [key, c] : sortKeys)
+            result.insert(result.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+        result.insert(result.end(), indices.begin() + numTris * 3, indices.end());
+        return result;
+    }
+    //---------------------------------------------------------------------
+    auto measureMeshlets(const IndexRange& range) -> MeshletLimits
+    {
+        MeshletLimits limits;
+        for (const auto& meshlet : range.subMesh->meshlets)
+        {
+            // Meshlets assigned by hand are not validated, stay inside the indices
+            size_t start = std::min<size_t>(meshlet.indexStart - range.indexData->indexStart, range.indices.size());
+            size_t count = std::min<size_t>(meshlet.indexCount, range.indices.size() - start);
+            std::vector<uint32> vertices(range.indices.begin() + start, range.indices.begin() + start + count);
+            std::ranges::sort(vertices);
+            auto const unique = static_cast<size_t>(std::ranges::unique(vertices).begin() - vertices.begin());
+            limits.maxVertices = std::max(limits.maxVertices, unique);
+            limits.maxTriangles = std::max<size_t>(limits.maxTriangles, count / 3);
+        }
+        return limits;
+    }
+    //---------------------------------------------------------------------
+    void writeBack(Mesh* mesh, VertexSet& set)
+    {
+        if (set.verticesChanged)
+        {
+            VertexBufferBinding* binding = set.vertexData->vertexBufferBinding;
+            for (size_t s = 0; s < set.sources.size(); ++s)
+            {
+                const HardwareVertexBufferSharedPtr& oldBuf = binding->getBuffer(set.sources[s]);
+                HardwareVertexBufferSharedPtr vbuf = mesh->getHardwareBufferManager()->createVertexBuffer(
+                    set.vertexSizes[s], set.vertexCount, oldBuf->getUsage(), oldBuf->hasShadowBuffer());
+                vbuf->writeData(0, set.vertexBytes[s].size(), set.vertexBytes[s].data(), true);
+                binding->setBinding(set.sources[s], vbuf);
+            }
+            set.vertexData->vertexCount = set.vertexCount;
+
+            bool hasAssignments = std::ranges::any_of(set.boneAssignments, [](const auto& l) { return !l.empty(); });
+            if (hasAssignments)
+            {
+                auto reassign = [&](auto* target)
+                {
+                    target->clearBoneAssignments();
+                    for (uint32 v = 0; v < set.vertexCount; ++v)
+                    {
+                        for (VertexBoneAssignment vba : set.boneAssignments[v])
+                        {
+                            vba.vertexIndex = v;
+                            target->addBoneAssignment(vba);
+                        }
+                    }
+                };
+                if (set.owner)
+                    reassign(set.owner);
+                else
+                    reassign(mesh);
+            }
+        }
+
+        for (const auto& range : set.ranges)
+        {
+            if (range.changed)
+                writeIndexRange(range);
+        }
+    }
+}
+    //---------------------------------------------------------------------
+    MeshOptimiser::MeshOptimiser(MeshOptimiserPass passes)
+        : mPasses(passes)
+    {
+    }
+    //---------------------------------------------------------------------
+    auto MeshOptimiser::analyse(const Mesh* mesh, size_t cacheSize) -> Statistics
+    {
+        return measure(collectVertexSets(mesh), cacheSize);
+    }
+    //---------------------------------------------------------------------
+    auto MeshOptimiser::optimise(Mesh* mesh) -> PassReportList
+    {
+        std::vector<VertexSet> sets = collectVertexSets(mesh);
+        PassReportList reports;
+
+        std::map<SubMesh*, MeshletLimits> meshletLimits;
+        for (const auto& set : sets)
+        {
+            for (const auto& range : set.ranges)
+            {
+                if (range.fullDetail && !range.subMesh->meshlets.empty())
+                    meshletLimits[range.subMesh] = measureMeshlets(range);
+            }
+        }
+
+        auto runPass = [&](MeshOptimiserPass pass, auto&& apply)
+        {
+            if (!(mPasses & pass))
+                return;
+            PassReport report{pass, measure(sets, mCacheSize), {}};
+            for (auto& set : sets)
+                apply(set);
+            report.after = measure(sets, mCacheSize);
+            reports.push_back(report);
+
+            if (mLogStatistics)
+            {
+                LogManager::getSingleton().logMessage(::std::format(
+                    "MeshOptimiser: {} {}: vertices {} -> {}, ACMR {:.3f} -> {:.3f}, "
+                    "ATVR {:.3f} -> {:.3f}, overfetch {:.3f} -> {:.3f}",
+                    mesh->getName(), getPassName(pass),
+                    report.before.vertexCount, report.after.vertexCount,
+                    report.before.acmr, report.after.acmr,
+                    report.before.atvr, report.after.atvr,
+                    report.before.overfetch, report.after.overfetch));
+            }
+        };
+
+        runPass(MeshOptimiserPass::WELD_VERTICES, [&](VertexSet& set)
+        {
+            if (set.canRemapVertices)
+                weldVertices(set);
+        });
+        runPass(MeshOptimiserPass::VERTEX_CACHE, [&](VertexSet& set)
+        {
+            for (auto& range : set.ranges)
+            {
+                if (!range.reorderable)
+                    continue;
+                range.indices = optimiseVertexCache(range.indices, set.vertexCount);
+                range.changed = true;
+            }
+        });
+        runPass(MeshOptimiserPass::OVERDRAW, [&](VertexSet& set)
+        {
+            if (set.positions.empty())
+                return;
+            for (auto& range : set.ranges)
+            {
+                if (!range.reorderable)
+                    continue;
+                range.indices = optimiseOverdraw(range.indices, set.positions, mCacheSize, mOverdrawThreshold);
+                range.changed = true;
+            }
+        });
+        runPass(MeshOptimiserPass::VERTEX_FETCH, [&](VertexSet& set)
+        {
+            if (set.canRemapVertices)
+                optimiseVertexFetch(set);
+        });
+
+        bool edgeListsBuilt = mesh->isEdgeListBuilt();
+        if (edgeListsBuilt)
+            mesh->freeEdgeList();
+
+        for (auto& set : sets)
+            writeBack(mesh, set);
+
+        for (const auto& set : sets)
+        {
+            for (const auto& range : set.ranges)
+            {
+                if (!range.fullDetail || !range.changed)
+                    continue;
+                SubMesh* sm = range.subMesh;
+                sm->_notifyIndicesChanged();
+
+                // Reordered triangles no longer match the meshlet ranges. Shared index
+                // buffers are only renumbered, which leaves the ranges valid.
+                auto limits = meshletLimits.find(sm);
+                if (limits == meshletLimits.end() || !range.reorderable)
+                    continue;
+                try
+                {
+                    sm->buildMeshlets(limits->second.maxVertices, limits->second.maxTriangles);
+                }
+                catch (const InvalidParametersException&)
+                {
+                    // buildMeshlets cleared the stale meshlets before giving up
+                }
+            }
+        }
+
+        if (edgeListsBuilt)
+            mesh->buildEdgeList();
+
+        return reports;
+    }
+    //---------------------------------------------------------------------
+    auto MeshOptimiser::optimiseAndExport(Mesh* mesh, std::string_view filename) -> PassReportList
+    {
+        PassReportList reports = optimise(mesh);
+
+        MeshSerializer serializer;
+        serializer.exportMesh(mesh, filename);
+        return reports;
+    }
+    //---------------------------------------------------------------------
+    void MeshOptimiser::processMeshCompleted(Mesh* mesh)
+    {
+        optimise(mesh);
+    }
+}
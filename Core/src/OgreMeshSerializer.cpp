@@ -62,6 +62,10 @@ namespace Ogre {
             MeshVersion::_1_10, "[MeshSerializer_v1.100]",
             ::std::make_unique<MeshSerializerImpl>()));
 
+        mVersionData.push_back(::std::make_unique<MeshVersionData>(
+            MeshVersion::MAPPABLE, "[MeshSerializer_v1.100_mappable]",
+            ::std::make_unique<MeshSerializerImpl_Mappable>()));
+
         mVersionData.push_back(::std::make_unique<MeshVersionData>(
             MeshVersion::_1_8, "[MeshSerializer_v1.8]",
             ::std::make_unique<MeshSerializerImpl_v1_8>()));
@@ -179,9 +183,10 @@ namespace Ogre {
                         ::std::format("Cannot find serializer implementation for mesh version {}", ver), "MeshSerializer::importMesh");
         
         // Call implementation
+        impl->setParallelImport(mParallelImport);
         impl->importMesh(stream, pDest, mListener);
         // Warn on old version of mesh
-        if (ver != mVersionData[0]->versionString)
+        if (ver != mVersionData[0]->versionString && ver != mVersionData[1]->versionString)
         {
             LogManager::getSingleton().logWarning(
                 ::std::format("{} uses an old format {}; upgrade with the OgreMeshUpgrader tool",
@@ -39,6 +39,7 @@ import :Bitwise;
 import :ColourValue;
 import :Common;
 import :DataStream;
+import :DefaultHardwareBufferManager;
 import :DistanceLodStrategy;
 import :Exception;
 import :HardwareBuffer;
@@ -54,6 +55,7 @@ import :Mesh;
 import :MeshFileFormat;
 import :MeshSerializer;
 import :MeshSerializerImpl;
+import :ParallelFor;
 import :Platform;
 import :Pose;
 import :RenderOperation;
@@ -62,7 +64,12 @@ import :SubMesh;
 import :Vector;
 import :VertexIndexData;
 
+import <algorithm>;
+import <exception>;
 import <format>;
+import <functional>;
+import <iterator>;
+import <limits>;
 import <list>;
 import <map>;
 import <memory>;
@@ -139,6 +146,10 @@ namespace Ogre {
             case MESH:
                 readMesh(stream, pMesh, listener);
                 break;
+            case BUFFER_DATA:
+                // payloads are fetched by offset when reading the mesh
+                stream->skip(mCurrentstreamLen - MSTREAM_OVERHEAD_SIZE);
+                break;
             default:
                 break;
             }
@@ -230,6 +241,9 @@ namespace Ogre {
 
         // Write submesh extremes
         writeExtremes(pMesh);
+
+        // Write submesh meshlets
+        writeMeshlets(pMesh);
             popInnerChunk(mStream);
         }
     }
@@ -278,18 +292,7 @@ namespace Ogre {
         if (indexCount > 0)
         {
             // unsigned short* faceVertexIndices ((indexCount)
-            HardwareIndexBufferSharedPtr ibuf = s->indexData->indexBuffer;
-            HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::LockOptions::READ_ONLY);
-            if (idx32bit)
-            {
-                auto* pIdx32 = static_cast<unsigned int*>(ibufLock.pData);
-                writeInts(pIdx32, s->indexData->indexCount);
-            }
-            else
-            {
-                auto* pIdx16 = static_cast<unsigned short*>(ibufLock.pData);
-                writeShorts(pIdx16, s->indexData->indexCount);
-            }
+            writeIndexBufferData(s->indexData->indexBuffer, s->indexData->indexCount);
         }
 
         pushInnerChunk(mStream);
@@ -377,6 +380,62 @@ namespace Ogre {
         return MSTREAM_OVERHEAD_SIZE + sizeof (unsigned short) +
             s->extremityPoints.size() * sizeof (float)* 3;
     }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeMeshlets(const Mesh *pMesh)
+    {
+        bool has_meshlets = false;
+        for (unsigned short i = 0; i < pMesh->getNumSubMeshes(); ++i)
+        {
+            SubMesh *sm = pMesh->getSubMesh(i);
+            if (sm->meshlets.empty())
+                continue;
+            if (!has_meshlets)
+            {
+                has_meshlets = true;
+                LogManager::getSingleton().logMessage("Writing submesh meshlets...");
+            }
+            writeSubMeshMeshlets(i, sm);
+        }
+        if (has_meshlets)
+            LogManager::getSingleton().logMessage("Meshlets exported.");
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::calcMeshletsSize(const Mesh* pMesh) -> size_t
+    {
+        size_t size = 0;
+        for (unsigned short i = 0; i < pMesh->getNumSubMeshes(); ++i)
+        {
+            SubMesh *sm = pMesh->getSubMesh(i);
+            if (!sm->meshlets.empty())
+                size += calcSubMeshMeshletsSize(sm);
+        }
+        return size;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeSubMeshMeshlets(unsigned short idx, const SubMesh* s)
+    {
+        writeChunkHeader(std::to_underlying(MeshChunkID::TABLE_MESHLETS), calcSubMeshMeshletsSize(s));
+
+        writeShorts(&idx, 1);
+        auto count = static_cast<uint32>(s->meshlets.size());
+        writeInts(&count, 1);
+
+        for (const auto& meshlet : s->meshlets)
+        {
+            uint32 range[2] = {meshlet.indexStart, meshlet.indexCount};
+            writeInts(range, 2);
+            float bounds[8] = {
+                meshlet.center.x, meshlet.center.y, meshlet.center.z, meshlet.radius,
+                meshlet.coneAxis.x, meshlet.coneAxis.y, meshlet.coneAxis.z, meshlet.coneCutoff};
+            writeFloats(bounds, 8);
+        }
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::calcSubMeshMeshletsSize(const SubMesh* s) -> size_t
+    {
+        return MSTREAM_OVERHEAD_SIZE + sizeof (unsigned short) + sizeof (uint32) +
+            s->meshlets.size() * (sizeof (uint32) * 2 + sizeof (float) * 8);
+    }
 
 
     //---------------------------------------------------------------------
@@ -462,8 +521,8 @@ namespace Ogre {
             // Buffers and bindings
             for (auto const& [key, vbuf] : bindings)
             {
-                size_t vbufSizeInBytes = vbuf->getVertexSize() * vertexData->vertexCount; // vbuf->getSizeInBytes() is too large for meshes prepared for shadow volumes
-                size = (MSTREAM_OVERHEAD_SIZE * 2) + (sizeof(unsigned short) * 2) + vbufSizeInBytes;
+                size_t dataSize = calcVertexBufferDataSize(vertexData, vbuf);
+                size = (MSTREAM_OVERHEAD_SIZE * 2) + (sizeof(unsigned short) * 2) + dataSize;
                 writeChunkHeader(std::to_underlying(MeshChunkID::GEOMETRY_VERTEX_BUFFER),  size);
                 // unsigned short bindIndex;    // Index to bind this buffer to
                 unsigned short tmp = key;
@@ -474,35 +533,37 @@ namespace Ogre {
                 pushInnerChunk(mStream);
                 {
                     // Data
-                    size = MSTREAM_OVERHEAD_SIZE + vbufSizeInBytes;
+                    size = MSTREAM_OVERHEAD_SIZE + dataSize;
                     writeChunkHeader(std::to_underlying(MeshChunkID::GEOMETRY_VERTEX_BUFFER_DATA), size);
-                    HardwareBufferLockGuard vbufLock(vbuf, HardwareBuffer::LockOptions::READ_ONLY);
-
-                    if (mFlipEndian)
-                    {
-                        // endian conversion
-                        // Copy data
-                        auto* tempData = new unsigned char[vbufSizeInBytes];
-                        memcpy(tempData, vbufLock.pData, vbufSizeInBytes);
-                        flipToLittleEndian(
-                            tempData,
-                            vertexData->vertexCount,
-                            vbuf->getVertexSize(),
-                            vertexData->vertexDeclaration->findElementsBySource(key));
-                        writeData(tempData, vbuf->getVertexSize(), vertexData->vertexCount);
-                        delete[] tempData;
-                    }
-                    else
-                    {
-                        writeData(vbufLock.pData, vbuf->getVertexSize(), vertexData->vertexCount);
-                    }
+                    writeVertexBufferData(vertexData, key, vbuf);
                 }
                 popInnerChunk(mStream);
             }
+
+            writeGeometryPositionDecode(vertexData);
         }
         popInnerChunk(mStream);
     }
     //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeGeometryPositionDecode(const VertexData* vertexData)
+    {
+        if (vertexData->positionDecodeMatrix == Affine3::IDENTITY)
+            return;
+
+        writeChunkHeader(std::to_underlying(MeshChunkID::GEOMETRY_POSITION_DECODE),
+            calcGeometryPositionDecodeSize(vertexData));
+        // 3 contiguous rows of 4
+        writeFloats(vertexData->positionDecodeMatrix[0], 12);
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::calcGeometryPositionDecodeSize(const VertexData* vertexData) -> size_t
+    {
+        if (vertexData->positionDecodeMatrix == Affine3::IDENTITY)
+            return 0;
+
+        return MSTREAM_OVERHEAD_SIZE + sizeof(float) * 12;
+    }
+    //---------------------------------------------------------------------
     auto MeshSerializerImpl::calcSubMeshNameTableSize(const Mesh* pMesh) -> size_t
     {
         size_t size = MSTREAM_OVERHEAD_SIZE;
@@ -574,6 +635,7 @@ namespace Ogre {
         }
 
         size += calcExtremesSize(pMesh);
+        size += calcMeshletsSize(pMesh);
 
         return size;
     }
@@ -595,10 +657,7 @@ namespace Ogre {
         bool idx32bit = (pSub->indexData->indexBuffer &&
             pSub->indexData->indexBuffer->getType() == HardwareIndexBuffer::IndexType::_32BIT);
         // unsigned int* / unsigned short* faceVertexIndices
-        if (idx32bit)
-            size += sizeof(unsigned int) * pSub->indexData->indexCount;
-        else
-            size += sizeof(unsigned short) * pSub->indexData->indexCount;
+        size += calcIndexBufferDataSize(idx32bit, pSub->indexData->indexCount);
 
         // Geometry
         if (!pSub->useSharedVertices)
@@ -661,8 +720,10 @@ namespace Ogre {
         // Buffer data
         for (auto const& [key, vbuf] : bindings)
         {
-            size += vbuf->getVertexSize() * vertexData->vertexCount; // vbuf->getSizeInBytes() is too large for meshes prepared for shadow volumes
+            size += calcVertexBufferDataSize(vertexData, vbuf);
         }
+
+        size += calcGeometryPositionDecodeSize(vertexData);
         return size;
     }
     //---------------------------------------------------------------------
@@ -682,7 +743,8 @@ namespace Ogre {
             auto streamID = static_cast<MeshChunkID>(readChunk(stream));
             while(!stream->eof() &&
                 (streamID == MeshChunkID::GEOMETRY_VERTEX_DECLARATION ||
-                 streamID == MeshChunkID::GEOMETRY_VERTEX_BUFFER ))
+                 streamID == MeshChunkID::GEOMETRY_VERTEX_BUFFER ||
+                 streamID == MeshChunkID::GEOMETRY_POSITION_DECODE ))
             {
                 using enum MeshChunkID;
                 switch (streamID)
@@ -693,6 +755,9 @@ namespace Ogre {
                 case GEOMETRY_VERTEX_BUFFER:
                     readGeometryVertexBuffer(stream, pMesh, dest);
                     break;
+                case GEOMETRY_POSITION_DECODE:
+                    readGeometryPositionDecode(stream, pMesh, dest);
+                    break;
                 default:
                     break;
                 }
@@ -776,9 +841,9 @@ namespace Ogre {
 
         if (vType == VertexElementType::_DETAIL_SWAP_RB)
         {
-            LogManager::getSingleton().stream(LogMessageLevel::Warning)
-                << "Warning: VertexElementType::COLOUR_ARGB element type is deprecated and incurs conversion on load. "
-                << "Use OgreMeshUpgrader on '" << pMesh->getName() << "' as soon as possible.";
+            logReadWarning(::std::format(
+                "Warning: VertexElementType::COLOUR_ARGB element type is deprecated and incurs conversion on load. "
+                "Use OgreMeshUpgrader on '{}' as soon as possible.", pMesh->getName()));
         }
 
     }
@@ -808,12 +873,60 @@ namespace Ogre {
         }
 
         // Create / populate vertex buffer
-        HardwareVertexBufferSharedPtr vbuf;
-        vbuf = pMesh->getHardwareBufferManager()->createVertexBuffer(
-            vertexSize,
-            dest->vertexCount,
-            pMesh->mVertexBufferUsage,
-            pMesh->mVertexBufferShadowBuffer);
+        HardwareVertexBufferSharedPtr vbuf = readVertexBufferData(stream, pMesh, dest, bindIndex, vertexSize);
+
+        // Set binding
+        dest->vertexBufferBinding->setBinding(bindIndex, vbuf);
+        }
+        popInnerChunk(stream);
+
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::readGeometryPositionDecode(const DataStreamPtr& stream,
+        Mesh* pMesh, VertexData* dest)
+    {
+        float decode[12];
+        readFloats(stream, decode, 12);
+        dest->positionDecodeMatrix = Affine3::FromPtr(decode);
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeVertexBufferData(const VertexData* vertexData, unsigned short bindIndex,
+        const HardwareVertexBufferSharedPtr& vbuf)
+    {
+        size_t vbufSizeInBytes = vbuf->getVertexSize() * vertexData->vertexCount;
+        HardwareBufferLockGuard vbufLock(vbuf, HardwareBuffer::LockOptions::READ_ONLY);
+
+        if (mFlipEndian)
+        {
+            // endian conversion
+            // Copy data
+            auto* tempData = new unsigned char[vbufSizeInBytes];
+            memcpy(tempData, vbufLock.pData, vbufSizeInBytes);
+            flipToLittleEndian(
+                tempData,
+                vertexData->vertexCount,
+                vbuf->getVertexSize(),
+                vertexData->vertexDeclaration->findElementsBySource(bindIndex));
+            writeData(tempData, vbuf->getVertexSize(), vertexData->vertexCount);
+            delete[] tempData;
+        }
+        else
+        {
+            writeData(vbufLock.pData, vbuf->getVertexSize(), vertexData->vertexCount);
+        }
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::calcVertexBufferDataSize(const VertexData* vertexData,
+        const HardwareVertexBufferSharedPtr& vbuf) -> size_t
+    {
+        // vbuf->getSizeInBytes() is too large for meshes prepared for shadow volumes
+        return vbuf->getVertexSize() * vertexData->vertexCount;
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::readVertexBufferData(const DataStreamPtr& stream, Mesh* pMesh,
+        VertexData* dest, unsigned short bindIndex, unsigned short vertexSize) -> HardwareVertexBufferSharedPtr
+    {
+        HardwareVertexBufferSharedPtr vbuf = createVertexBuffer(pMesh, vertexSize, dest->vertexCount);
         HardwareBufferLockGuard vbufLock(vbuf, HardwareBuffer::LockOptions::DISCARD);
         stream->read(vbufLock.pData, dest->vertexCount * vertexSize);
 
@@ -823,12 +936,33 @@ namespace Ogre {
             dest->vertexCount,
             vertexSize,
             dest->vertexDeclaration->findElementsBySource(bindIndex));
-
-        // Set binding
-        dest->vertexBufferBinding->setBinding(bindIndex, vbuf);
-        }
-        popInnerChunk(stream);
-
+        return vbuf;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeIndexBufferData(const HardwareIndexBufferSharedPtr& ibuf, size_t count)
+    {
+        HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::LockOptions::READ_ONLY);
+        if (ibuf->getType() == HardwareIndexBuffer::IndexType::_32BIT)
+            writeInts(static_cast<uint32*>(ibufLock.pData), count);
+        else
+            writeShorts(static_cast<uint16*>(ibufLock.pData), count);
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::calcIndexBufferDataSize(bool idx32bit, size_t count) -> size_t
+    {
+        return (idx32bit ? sizeof(uint32) : sizeof(uint16)) * count;
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::readIndexBufferData(const DataStreamPtr& stream, Mesh* pMesh,
+        HardwareIndexBuffer::IndexType type, size_t count) -> HardwareIndexBufferSharedPtr
+    {
+        HardwareIndexBufferSharedPtr ibuf = createIndexBuffer(pMesh, type, count);
+        HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::LockOptions::DISCARD);
+        if (type == HardwareIndexBuffer::IndexType::_32BIT)
+            readInts(stream, static_cast<uint32*>(ibufLock.pData), count);
+        else
+            readShorts(stream, static_cast<uint16*>(ibufLock.pData), count);
+        return ibuf;
     }
     //---------------------------------------------------------------------
     void MeshSerializerImpl::readSubMeshNameTable(const DataStreamPtr& stream, Mesh* pMesh)
@@ -891,89 +1025,438 @@ namespace Ogre {
         bool skeletallyAnimated;
         readBools(stream, &skeletallyAnimated, 1);
 
+        if (mParallelImport && !stream->eof() && createImportWorker())
+        {
+            readMeshParallel(stream, pMesh, listener);
+            return;
+        }
+
         // Find all substreams
         if (!stream->eof())
         {
             pushInnerChunk(stream);
-            auto streamID = static_cast<MeshChunkID>(readChunk(stream));
-            using enum MeshChunkID;
-            while(!stream->eof() &&
-                (streamID == GEOMETRY ||
-                 streamID == SUBMESH ||
-                 streamID == MESH_SKELETON_LINK ||
-                 streamID == MESH_BONE_ASSIGNMENT ||
-                 streamID == MESH_LOD_LEVEL ||
-                 streamID == MESH_BOUNDS ||
-                 streamID == SUBMESH_NAME_TABLE ||
-                 streamID == EDGE_LISTS ||
-                 streamID == POSES ||
-                 streamID == ANIMATIONS ||
-                 streamID == TABLE_EXTREMES))
+            uint16 streamID = readChunk(stream);
+            while(!stream->eof() && isMeshSubChunk(streamID))
             {
-                switch(streamID)
+                readMeshSubChunk(stream, pMesh, streamID, listener);
+
+                if (!stream->eof())
+                {
+                    streamID = readChunk(stream);
+                }
+
+            }
+            if (!stream->eof())
+            {
+                // Backpedal back to start of stream
+                backpedalChunkHeader(stream);
+            }
+            popInnerChunk(stream);
+        }
+
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::isMeshSubChunk(uint16 id) -> bool
+    {
+        using enum MeshChunkID;
+        auto const streamID = static_cast<MeshChunkID>(id);
+        return streamID == GEOMETRY ||
+               streamID == SUBMESH ||
+               streamID == MESH_SKELETON_LINK ||
+               streamID == MESH_BONE_ASSIGNMENT ||
+               streamID == MESH_LOD_LEVEL ||
+               streamID == MESH_BOUNDS ||
+               streamID == SUBMESH_NAME_TABLE ||
+               streamID == EDGE_LISTS ||
+               streamID == POSES ||
+               streamID == ANIMATIONS ||
+               streamID == TABLE_EXTREMES ||
+               streamID == TABLE_MESHLETS;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::readMeshSubChunk(const DataStreamPtr& stream, Mesh* pMesh, uint16 streamID,
+        MeshSerializerListener *listener)
+    {
+        using enum MeshChunkID;
+        switch(static_cast<MeshChunkID>(streamID))
+        {
+        case GEOMETRY:
+            pMesh->sharedVertexData = new VertexData();
+            try {
+                readGeometry(stream, pMesh, pMesh->sharedVertexData);
+            }
+            catch (ItemIdentityException&)
+            {
+                // duff geometry data entry with 0 vertices
+                delete pMesh->sharedVertexData;
+                pMesh->sharedVertexData = nullptr;
+                // Skip this stream (pointer will have been returned to just after header)
+                stream->skip(mCurrentstreamLen - MSTREAM_OVERHEAD_SIZE);
+            }
+            break;
+        case SUBMESH:
+            readSubMesh(stream, pMesh, listener);
+            break;
+        case MESH_SKELETON_LINK:
+            readSkeletonLink(stream, pMesh, listener);
+            break;
+        case MESH_BONE_ASSIGNMENT:
+            readMeshBoneAssignment(stream, pMesh);
+            break;
+        case MESH_LOD_LEVEL:
+            readMeshLodLevel(stream, pMesh);
+            break;
+        case MESH_BOUNDS:
+            readBoundsInfo(stream, pMesh);
+            break;
+        case SUBMESH_NAME_TABLE:
+            readSubMeshNameTable(stream, pMesh);
+            break;
+        case EDGE_LISTS:
+            readEdgeList(stream, pMesh);
+            break;
+        case POSES:
+            readPoses(stream, pMesh);
+            break;
+        case ANIMATIONS:
+            readAnimations(stream, pMesh);
+            break;
+        case TABLE_EXTREMES:
+            readExtremes(stream, pMesh);
+            break;
+        case TABLE_MESHLETS:
+            readMeshlets(stream, pMesh);
+            break;
+        default:
+            break;
+        }
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::readMeshParallel(const DataStreamPtr& stream, Mesh* pMesh, MeshSerializerListener *listener)
+    {
+        // Every worker reads from its own stream over the whole file, so that
+        // absolute offsets within the file stay valid
+        ::std::shared_ptr<uchar> data = stream->getSharedData();
+        size_t dataSize = stream->size();
+        if (!data)
+        {
+            size_t pos = stream->tell();
+            stream->seek(0);
+            data = ::std::shared_ptr<uchar>(new uchar[dataSize], std::default_delete<uchar[]>());
+            stream->read(data.get(), dataSize);
+            stream->seek(pos);
+        }
+
+        // Read the chunk directory
+        struct Chunk
+        {
+            MeshChunkID id;
+            /// stream position after the chunk header
+            size_t start;
+            uint32 length;
+        };
+        std::vector<Chunk> chunks;
+        uint16 streamID = readChunk(stream);
+        while(!stream->eof() && isMeshSubChunk(streamID))
+        {
+            chunks.push_back({static_cast<MeshChunkID>(streamID), stream->tell(), mCurrentstreamLen});
+            stream->skip(mCurrentstreamLen - MSTREAM_OVERHEAD_SIZE);
+
+            if (!stream->eof())
+            {
+                streamID = readChunk(stream);
+            }
+        }
+        if (!stream->eof())
+        {
+            // Backpedal back to start of stream
+            backpedalChunkHeader(stream);
+        }
+        size_t endPos = stream->tell();
+
+        // Chunks that can be decoded independently become tasks. Each touches distinct
+        // parts of the mesh; everything shared is created up front or assembled afterwards.
+        struct Task
+        {
+            const Chunk* chunk;
+            std::function<void(MeshSerializerImpl& worker, const DataStreamPtr& stream)> decode;
+            std::exception_ptr error;
+            std::vector<String> warnings;
+        };
+        std::vector<Task> tasks;
+        // tasks touching the SubMeshes that the first wave of tasks fills
+        std::vector<Task> lateTasks;
+        std::vector<const Chunk*> sequentialChunks;
+        std::vector<std::pair<SubMesh*, String>> subMeshMaterials;
+        std::vector<std::vector<std::pair<unsigned short, EdgeData*>>> edgeLists;
+        bool duffSharedGeometry = false;
+        bool hasLodLevel = false, hasPoses = false;
+        edgeLists.reserve(chunks.size());
+
+        using enum MeshChunkID;
+        for (const Chunk& chunk : chunks)
+        {
+            switch (chunk.id)
+            {
+            case GEOMETRY:
+                if (pMesh->sharedVertexData)
+                {
+                    sequentialChunks.push_back(&chunk);
+                    break;
+                }
+                pMesh->sharedVertexData = new VertexData();
+                tasks.push_back({&chunk, [&chunk, pMesh, &duffSharedGeometry](MeshSerializerImpl& worker, const DataStreamPtr& ws)
                 {
-                case GEOMETRY:
-                    pMesh->sharedVertexData = new VertexData();
                     try {
-                        readGeometry(stream, pMesh, pMesh->sharedVertexData);
+                        worker.readGeometry(ws, pMesh, pMesh->sharedVertexData);
                     }
                     catch (ItemIdentityException&)
                     {
                         // duff geometry data entry with 0 vertices
-                        delete pMesh->sharedVertexData;
-                        pMesh->sharedVertexData = nullptr;
-                        // Skip this stream (pointer will have been returned to just after header)
-                        stream->skip(mCurrentstreamLen - MSTREAM_OVERHEAD_SIZE);
+                        duffSharedGeometry = true;
+                        ws->seek(chunk.start + chunk.length - MSTREAM_OVERHEAD_SIZE);
                     }
+                }});
+                break;
+            case SUBMESH:
+            {
+                SubMesh* sm = pMesh->createSubMesh();
+                // Peek at the material name, resolved on this thread, and whether
+                // the submesh brings its own vertex data, which must be created here
+                stream->seek(chunk.start);
+                String materialName = readString(stream);
+                bool useSharedVertices;
+                readBools(stream, &useSharedVertices, 1);
+                if (!useSharedVertices)
+                    sm->vertexData = ::std::make_unique<VertexData>();
+                subMeshMaterials.emplace_back(sm, materialName);
+
+                tasks.push_back({&chunk, [pMesh, sm](MeshSerializerImpl& worker, const DataStreamPtr& ws)
+                {
+                    worker.readString(ws);
+                    worker.readSubMeshData(ws, pMesh, sm);
+                }});
+                break;
+            }
+            case MESH_LOD_LEVEL:
+                if (std::exchange(hasLodLevel, true))
+                {
+                    sequentialChunks.push_back(&chunk);
                     break;
-                case SUBMESH:
-                    readSubMesh(stream, pMesh, listener);
-                    break;
-                case MESH_SKELETON_LINK:
-                    readSkeletonLink(stream, pMesh, listener);
-                    break;
-                case MESH_BONE_ASSIGNMENT:
-                    readMeshBoneAssignment(stream, pMesh);
-                    break;
-                case MESH_LOD_LEVEL:
-                    readMeshLodLevel(stream, pMesh);
-                    break;
-                case MESH_BOUNDS:
-                    readBoundsInfo(stream, pMesh);
-                    break;
-                case SUBMESH_NAME_TABLE:
-                    readSubMeshNameTable(stream, pMesh);
-                    break;
-                case EDGE_LISTS:
-                    readEdgeList(stream, pMesh);
-                    break;
-                case POSES:
-                    readPoses(stream, pMesh);
-                    break;
-                case ANIMATIONS:
-                    readAnimations(stream, pMesh);
-                    break;
-                case TABLE_EXTREMES:
-                    readExtremes(stream, pMesh);
-                    break;
-                default:
+                }
+                lateTasks.push_back({&chunk, [pMesh](MeshSerializerImpl& worker, const DataStreamPtr& ws)
+                {
+                    worker.readMeshLodLevel(ws, pMesh);
+                }});
+                break;
+            case EDGE_LISTS:
+                tasks.push_back({&chunk, [&lods = edgeLists.emplace_back()](MeshSerializerImpl& worker, const DataStreamPtr& ws)
+                {
+                    lods = worker.readEdgeListLods(ws);
+                }});
+                break;
+            case POSES:
+                if (std::exchange(hasPoses, true))
+                {
+                    sequentialChunks.push_back(&chunk);
                     break;
                 }
+                tasks.push_back({&chunk, [pMesh](MeshSerializerImpl& worker, const DataStreamPtr& ws)
+                {
+                    worker.readPoses(ws, pMesh);
+                }});
+                break;
+            default:
+                sequentialChunks.push_back(&chunk);
+                break;
+            }
+        }
 
-                if (!stream->eof())
+        auto runTask = [&](Task& task)
+        {
+            std::unique_ptr<MeshSerializerImpl> impl = createImportWorker();
+            try
+            {
+                impl->mFlipEndian = mFlipEndian;
+                impl->mStageBuffers = true;
+                impl->mCurrentstreamLen = task.chunk->length;
+
+                DataStreamPtr ws(new MemoryDataStream(stream->getName(), data, dataSize));
+                ws->seek(task.chunk->start);
+                task.decode(*impl, ws);
+
+                if (ws->tell() != task.chunk->start + task.chunk->length - MSTREAM_OVERHEAD_SIZE)
                 {
-                    streamID = static_cast<MeshChunkID>(readChunk(stream));
+                    OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                        ::std::format("Chunk {:#x} of {} does not match its length; "
+                        "load it with parallel import disabled",
+                        std::to_underlying(task.chunk->id), stream->getName()),
+                        "MeshSerializerImpl::readMeshParallel");
                 }
-
             }
-            if (!stream->eof())
+            catch (...)
             {
-                // Backpedal back to start of stream
-                backpedalChunkHeader(stream);
+                task.error = std::current_exception();
             }
-            popInnerChunk(stream);
+            task.warnings = std::move(impl->mDeferredWarnings);
+        };
+
+        TaskPool& pool = TaskPool::get();
+        pool.run(static_cast<uint32>(tasks.size()), [&](uint32 i) { runTask(tasks[i]); });
+        pool.run(static_cast<uint32>(lateTasks.size()), [&](uint32 i) { runTask(lateTasks[i]); });
+
+        // Log what the workers ran into, in file order
+        tasks.insert(tasks.end(), std::make_move_iterator(lateTasks.begin()), std::make_move_iterator(lateTasks.end()));
+        std::ranges::sort(tasks, {}, [](const Task& task) { return task.chunk->start; });
+        for (const auto& task : tasks)
+            for (const auto& warning : task.warnings)
+                LogManager::getSingleton().logWarning(warning);
+
+        for (const auto& task : tasks)
+        {
+            if (task.error)
+                std::rethrow_exception(task.error);
+        }
+
+        // Assemble in file order
+        if (duffSharedGeometry)
+        {
+            delete pMesh->sharedVertexData;
+            pMesh->sharedVertexData = nullptr;
+        }
+        else if (pMesh->sharedVertexData)
+        {
+            realiseBuffers(pMesh, pMesh->sharedVertexData);
+        }
+
+        std::map<HardwareIndexBufferSharedPtr, HardwareIndexBufferSharedPtr> lodBuffers;
+        for (auto const& [sm, materialName] : subMeshMaterials)
+        {
+            setSubMeshMaterial(pMesh, sm, materialName, listener);
+
+            if (!sm->useSharedVertices)
+                realiseBuffers(pMesh, sm->vertexData.get());
+            if (sm->indexData->indexBuffer)
+                sm->indexData->indexBuffer = realiseBuffer(pMesh, sm->indexData->indexBuffer);
+
+            // generated LOD levels may share buffers
+            for (IndexData* lodIndexData : sm->mLodFaceList)
+            {
+                if (!lodIndexData->indexBuffer)
+                    continue;
+                auto& realBuffer = lodBuffers[lodIndexData->indexBuffer];
+                if (!realBuffer)
+                    realBuffer = realiseBuffer(pMesh, lodIndexData->indexBuffer);
+                lodIndexData->indexBuffer = realBuffer;
+            }
+        }
+
+        if (!edgeLists.empty())
+        {
+            for (auto const& lods : edgeLists)
+                for (auto const& [lodIndex, edgeData] : lods)
+                    attachEdgeList(pMesh, lodIndex, edgeData);
+            pMesh->mEdgeListsBuilt = true;
+        }
+
+        // The rest depends on the assembled mesh
+        for (const Chunk* chunk : sequentialChunks)
+        {
+            stream->seek(chunk->start);
+            mCurrentstreamLen = chunk->length;
+            readMeshSubChunk(stream, pMesh, std::to_underlying(chunk->id), listener);
+        }
+        stream->seek(endPos);
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::createImportWorker() const -> std::unique_ptr<MeshSerializerImpl>
+    {
+        return std::make_unique<MeshSerializerImpl>();
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::logReadWarning(std::string_view message)
+    {
+        // the log is not thread safe
+        if (mStageBuffers)
+            mDeferredWarnings.emplace_back(message);
+        else
+            LogManager::getSingleton().logWarning(message);
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::createVertexBuffer(Mesh* pMesh, size_t vertexSize, size_t numVertices)
+        -> HardwareVertexBufferSharedPtr
+    {
+        // Buffer managers are not thread safe, so import workers decode into
+        // plain system memory that realiseBuffer hands over afterwards
+        if (mStageBuffers)
+            return HardwareVertexBufferSharedPtr(new HardwareVertexBuffer(
+                nullptr, vertexSize, numVertices, new DefaultHardwareBuffer(vertexSize * numVertices)));
+
+        return pMesh->getHardwareBufferManager()->createVertexBuffer(
+            vertexSize,
+            numVertices,
+            pMesh->mVertexBufferUsage,
+            pMesh->mVertexBufferShadowBuffer);
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::createIndexBuffer(Mesh* pMesh, HardwareIndexBuffer::IndexType type, size_t numIndexes)
+        -> HardwareIndexBufferSharedPtr
+    {
+        if (mStageBuffers)
+            return HardwareIndexBufferSharedPtr(new HardwareIndexBuffer(
+                nullptr, type, numIndexes, new DefaultHardwareBuffer(HardwareIndexBuffer::indexSize(type) * numIndexes)));
+
+        return pMesh->getHardwareBufferManager()->createIndexBuffer(
+            type, numIndexes, pMesh->mIndexBufferUsage, pMesh->mIndexBufferShadowBuffer);
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::realiseBuffers(Mesh* pMesh, VertexData* vertexData)
+    {
+        VertexBufferBinding* binding = vertexData->vertexBufferBinding;
+        for (auto const& [key, vbuf] : binding->getBindings())
+        {
+            HardwareVertexBufferSharedPtr realBuffer = realiseBuffer(pMesh, vbuf);
+            binding->setBinding(key, realBuffer);
         }
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::realiseBuffer(Mesh* pMesh, const HardwareVertexBufferSharedPtr& staged)
+        -> HardwareVertexBufferSharedPtr
+    {
+        HardwareVertexBufferSharedPtr vbuf = pMesh->getHardwareBufferManager()->createVertexBuffer(
+            staged->getVertexSize(),
+            staged->getNumVertices(),
+            pMesh->mVertexBufferUsage,
+            pMesh->mVertexBufferShadowBuffer);
+        adoptStagedData(vbuf.get(), staged);
+        return vbuf;
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::realiseBuffer(Mesh* pMesh, const HardwareIndexBufferSharedPtr& staged)
+        -> HardwareIndexBufferSharedPtr
+    {
+        HardwareIndexBufferSharedPtr ibuf = pMesh->getHardwareBufferManager()->createIndexBuffer(
+            staged->getType(), staged->getNumIndexes(), pMesh->mIndexBufferUsage, pMesh->mIndexBufferShadowBuffer);
+        adoptStagedData(ibuf.get(), staged);
+        return ibuf;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::adoptStagedData(HardwareBuffer* buf, const ::std::shared_ptr<HardwareBuffer>& staged)
+    {
+        size_t size = staged->getSizeInBytes();
+        if (size == 0)
+            return;
+
+        // The staged memory stays valid after unlocking; keep it alive through the
+        // staged buffer so it can become the system memory copy of buf as is
+        HardwareBufferLockGuard stagedLock(staged.get(), HardwareBuffer::LockOptions::READ_ONLY);
+        auto* pData = static_cast<uchar*>(stagedLock.pData);
+        stagedLock.unlock();
 
+        std::unique_ptr<HardwareBuffer> data =
+            std::make_unique<DefaultHardwareBuffer>(::std::shared_ptr<uchar>(staged, pData), size);
+        if (!buf->_adoptSystemMemoryBuffer(data))
+            buf->writeData(0, size, pData, true);
     }
     //---------------------------------------------------------------------
     void MeshSerializerImpl::readSubMesh(const DataStreamPtr& stream, Mesh* pMesh, MeshSerializerListener *listener)
@@ -982,6 +1465,14 @@ namespace Ogre {
 
         // char* materialName
         String materialName = readString(stream);
+        setSubMeshMaterial(pMesh, sm, materialName, listener);
+
+        readSubMeshData(stream, pMesh, sm);
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::setSubMeshMaterial(Mesh* pMesh, SubMesh* sm, String materialName,
+        MeshSerializerListener *listener)
+    {
         if(listener)
             listener->processMaterialName(pMesh, &materialName);
         if (auto material = MaterialManager::getSingleton().getByName(materialName, pMesh->getGroup()))
@@ -996,7 +1487,10 @@ namespace Ogre {
                 "Material does not exist in group '{}'. Have you forgotten to define it in a "
                 ".material script?", materialName, pMesh->getName(), pMesh->getGroup()));
         }
-
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::readSubMeshData(const DataStreamPtr& stream, Mesh* pMesh, SubMesh* sm)
+    {
         // bool useSharedVertices
         readBools(stream,&sm->useSharedVertices, 1);
 
@@ -1011,27 +1505,9 @@ namespace Ogre {
         readBools(stream, &idx32bit, 1);
         if (indexCount > 0)
         {
-            if (idx32bit)
-            {
-                ibuf = pMesh->getHardwareBufferManager()->createIndexBuffer(
-                        HardwareIndexBuffer::IndexType::_32BIT,
-                        sm->indexData->indexCount,
-                        pMesh->mIndexBufferUsage,
-                        pMesh->mIndexBufferShadowBuffer);
-                HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::LockOptions::DISCARD);
-                readInts(stream, static_cast<unsigned int*>(ibufLock.pData), sm->indexData->indexCount);
-
-            }
-            else // 16-bit
-            {
-                ibuf = pMesh->getHardwareBufferManager()->createIndexBuffer(
-                        HardwareIndexBuffer::IndexType::_16BIT,
-                        sm->indexData->indexCount,
-                        pMesh->mIndexBufferUsage,
-                        pMesh->mIndexBufferShadowBuffer);
-                HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::LockOptions::DISCARD);
-                readShorts(stream, static_cast<unsigned short*>(ibufLock.pData), sm->indexData->indexCount);
-            }
+            ibuf = readIndexBufferData(stream, pMesh,
+                idx32bit ? HardwareIndexBuffer::IndexType::_32BIT : HardwareIndexBuffer::IndexType::_16BIT,
+                sm->indexData->indexCount);
         }
         sm->indexData->indexBuffer = ibuf;
 
@@ -1046,7 +1522,9 @@ namespace Ogre {
                 OGRE_EXCEPT(ExceptionCodes::INTERNAL_ERROR, "Missing geometry data in mesh file",
                     "MeshSerializerImpl::readSubMesh");
             }
-            sm->vertexData = ::std::make_unique<VertexData>();
+            // may have been created up front by readMeshParallel
+            if (!sm->vertexData)
+                sm->vertexData = ::std::make_unique<VertexData>();
             readGeometry(stream, pMesh, sm->vertexData.get());
         }
 
@@ -1086,8 +1564,7 @@ namespace Ogre {
             }
 
             if (seenTexAlias)
-                LogManager::getSingleton().logWarning(std::format("texture aliases for SubMeshes are deprecated - {}",
-                                                      stream->getName()));
+                logReadWarning(std::format("texture aliases for SubMeshes are deprecated - {}", stream->getName()));
 
             if (!stream->eof())
             {
@@ -1283,16 +1760,7 @@ namespace Ogre {
 
             if (bufIndexCount > 0)
             {
-                if (is32BitIndices)
-                {
-                    HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::LockOptions::READ_ONLY);
-                    writeInts(static_cast<unsigned int*>(ibufLock.pData), bufIndexCount);
-                }
-                else
-                {
-                    HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::LockOptions::READ_ONLY);
-                    writeShorts(static_cast<unsigned short*>(ibufLock.pData), bufIndexCount);
-                }
+                writeIndexBufferData(ibuf, bufIndexCount);
             }
         }
     }
@@ -1374,7 +1842,8 @@ namespace Ogre {
         if(bufferIndex == (unsigned int)-1) {
             size += sizeof(bool); // bool indexes32Bit
             size += sizeof(unsigned int); // unsigned int ibuf->getNumIndexes()
-            size += !ibuf ? 0 : static_cast<unsigned long>(ibuf->getIndexSize() * ibuf->getNumIndexes()); // faces
+            size += !ibuf ? 0 : calcIndexBufferDataSize(
+                ibuf->getType() == HardwareIndexBuffer::IndexType::_32BIT, ibuf->getNumIndexes()); // faces
         }
         return size;
     }
@@ -1532,19 +2001,9 @@ namespace Ogre {
                 unsigned int buffIndexCount;
                 readInts(stream, &buffIndexCount, 1);
 
-                indexData->indexBuffer = pMesh->getHardwareBufferManager()->createIndexBuffer(
+                indexData->indexBuffer = readIndexBufferData(stream, pMesh,
                     idx32Bit ? HardwareIndexBuffer::IndexType::_32BIT : HardwareIndexBuffer::IndexType::_16BIT,
-                    buffIndexCount, pMesh->mIndexBufferUsage, pMesh->mIndexBufferShadowBuffer);
-                HardwareBufferLockGuard ibufLock(indexData->indexBuffer, HardwareBuffer::LockOptions::DISCARD);
-
-                if (idx32Bit)
-                {
-                    readInts(stream, (uint32*)ibufLock.pData, buffIndexCount);
-                }
-                else
-                {
-                    readShorts(stream, (uint16*)ibufLock.pData, buffIndexCount);
-                }
+                    buffIndexCount);
             }
         }
     }
@@ -1591,9 +2050,12 @@ namespace Ogre {
                         typeSize = sizeof(double);
                         break;
                     case SHORT1:
+                    case SHORT2_NORM:
                         typeSize = sizeof(short);
                         break;
                     case USHORT1:
+                    case USHORT2_NORM:
+                    case HALF1:
                         typeSize = sizeof(unsigned short);
                         break;
                     case INT1:
@@ -1604,6 +2066,8 @@ namespace Ogre {
                         break;
                     case UBYTE4_NORM:
                     case UBYTE4:
+                    case BYTE4_NORM:
+                    case BYTE4:
                         typeSize = 0; // NO FLIPPING
                         break;
                     default:
@@ -1806,6 +2270,16 @@ namespace Ogre {
     //---------------------------------------------------------------------
     void MeshSerializerImpl::readEdgeList(const DataStreamPtr& stream, Mesh* pMesh)
     {
+        for (auto const& [lodIndex, edgeData] : readEdgeListLods(stream))
+            attachEdgeList(pMesh, lodIndex, edgeData);
+
+        pMesh->mEdgeListsBuilt = true;
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl::readEdgeListLods(const DataStreamPtr& stream)
+        -> std::vector<std::pair<unsigned short, EdgeData*>>
+    {
+        std::vector<std::pair<unsigned short, EdgeData*>> edgeLists;
         if (!stream->eof())
         {
             pushInnerChunk(stream);
@@ -1825,37 +2299,11 @@ namespace Ogre {
                 // Only load in non-manual levels; others will be connected up by Mesh on demand
 
                 if (!isManual) {
-                    MeshLodUsage& usage = pMesh->mMeshLodUsageList[lodIndex];
-
-                    usage.edgeData = new EdgeData();
+                    auto* edgeData = new EdgeData();
+                    edgeLists.emplace_back(lodIndex, edgeData);
 
                     // Read detail information of the edge list
-                    readEdgeListLodInfo(stream, usage.edgeData);
-
-                    // Postprocessing edge groups
-                    for (auto & edgeGroup : usage.edgeData->edgeGroups)
-                    {
-                        // Populate edgeGroup.vertexData pointers
-                        // If there is shared vertex data, vertexSet 0 is that,
-                        // otherwise 0 is first dedicated
-                        if (pMesh->sharedVertexData)
-                        {
-                            if (edgeGroup.vertexSet == 0)
-                            {
-                                edgeGroup.vertexData = pMesh->sharedVertexData;
-                            }
-                            else
-                            {
-                                edgeGroup.vertexData = pMesh->getSubMesh(
-                                    (unsigned short)edgeGroup.vertexSet-1)->vertexData.get();
-                            }
-                        }
-                        else
-                        {
-                            edgeGroup.vertexData = pMesh->getSubMesh(
-                                (unsigned short)edgeGroup.vertexSet)->vertexData.get();
-                        }
-                    }
+                    readEdgeListLodInfo(stream, edgeData);
                 }
 
                 if (!stream->eof())
@@ -1871,8 +2319,39 @@ namespace Ogre {
             }
             popInnerChunk(stream);
         }
+        return edgeLists;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::attachEdgeList(Mesh* pMesh, unsigned short lodIndex, EdgeData* edgeData)
+    {
+        MeshLodUsage& usage = pMesh->mMeshLodUsageList[lodIndex];
 
-        pMesh->mEdgeListsBuilt = true;
+        usage.edgeData = edgeData;
+
+        // Postprocessing edge groups
+        for (auto & edgeGroup : usage.edgeData->edgeGroups)
+        {
+            // Populate edgeGroup.vertexData pointers
+            // If there is shared vertex data, vertexSet 0 is that,
+            // otherwise 0 is first dedicated
+            if (pMesh->sharedVertexData)
+            {
+                if (edgeGroup.vertexSet == 0)
+                {
+                    edgeGroup.vertexData = pMesh->sharedVertexData;
+                }
+                else
+                {
+                    edgeGroup.vertexData = pMesh->getSubMesh(
+                        (unsigned short)edgeGroup.vertexSet-1)->vertexData.get();
+                }
+            }
+            else
+            {
+                edgeGroup.vertexData = pMesh->getSubMesh(
+                    (unsigned short)edgeGroup.vertexSet)->vertexData.get();
+            }
+        }
     }
     //---------------------------------------------------------------------
     void MeshSerializerImpl::readEdgeListLodInfo(const DataStreamPtr& stream,
@@ -2625,12 +3104,253 @@ namespace Ogre {
         
         delete[] vert;
     }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::readMeshlets(const DataStreamPtr& stream, Mesh *pMesh)
+    {
+        unsigned short idx;
+        readShorts(stream, &idx, 1);
+        uint32 count;
+        readInts(stream, &count, 1);
+
+        if (idx >= pMesh->getNumSubMeshes())
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                ::std::format("Meshlets of {} refer to missing SubMesh {}", pMesh->getName(), idx),
+                "MeshSerializerImpl::readMeshlets");
+
+        // SubEntity copies the ranges out of the index buffer, so they must lie inside the
+        // triangles of the main LOD level
+        SubMesh *sm = pMesh->getSubMesh(idx);
+        const IndexData* indexData = sm->indexData.get();
+        uint64 const first = indexData->indexStart;
+        uint64 const last = first + indexData->indexCount;
+        if (count > indexData->indexCount / 3)
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                ::std::format("SubMesh {} of {} has more meshlets than triangles", idx, pMesh->getName()),
+                "MeshSerializerImpl::readMeshlets");
+
+        sm->meshlets.resize(count);
+        for (auto& meshlet : sm->meshlets)
+        {
+            uint32 range[2];
+            readInts(stream, range, 2);
+            if (range[0] < first || range[0] + uint64(range[1]) > last || (range[0] - first) % 3 != 0 ||
+                range[1] % 3 != 0)
+            {
+                sm->meshlets.clear();
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                    ::std::format("Meshlet index range {}+{} of SubMesh {} of {} is not a set of its triangles",
+                    range[0], range[1], idx, pMesh->getName()),
+                    "MeshSerializerImpl::readMeshlets");
+            }
+            float bounds[8];
+            readFloats(stream, bounds, 8);
+            meshlet = {range[0], range[1],
+                Vector3{bounds[0], bounds[1], bounds[2]}, bounds[3],
+                Vector3{bounds[4], bounds[5], bounds[6]}, bounds[7]};
+        }
+        sm->_notifyIndicesChanged();
+    }
 
     void MeshSerializerImpl::enableValidation()
     {
     }
 
 
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    MeshSerializerImpl_Mappable::MeshSerializerImpl_Mappable()
+    {
+        // Version number
+        mVersion = "[MeshSerializer_v1.100_mappable]";
+    }
+    //---------------------------------------------------------------------
+    MeshSerializerImpl_Mappable::~MeshSerializerImpl_Mappable()
+    = default;
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_Mappable::writeMesh(const Mesh* pMesh)
+    {
+        writeBufferData(pMesh);
+        MeshSerializerImpl::writeMesh(pMesh);
+        mBufferOffsets.clear();
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_Mappable::writeBufferData(const Mesh* pMesh)
+    {
+        // Either a vertex buffer binding or an index buffer
+        struct Payload
+        {
+            const VertexData* vertexData;
+            unsigned short bindIndex;
+            HardwareVertexBufferSharedPtr vbuf;
+            HardwareIndexBufferSharedPtr ibuf;
+            HardwareBuffer* buf;
+            size_t size;
+        };
+        std::vector<Payload> payloads;
+        mBufferOffsets.clear();
+
+        auto addPayload = [&](Payload payload)
+        {
+            if (payload.size && mBufferOffsets.emplace(std::make_pair(payload.buf, payload.size), 0).second)
+                payloads.push_back(std::move(payload));
+        };
+        auto addVertexData = [&](const VertexData* vertexData)
+        {
+            for (auto const& [key, vbuf] : vertexData->vertexBufferBinding->getBindings())
+                addPayload({vertexData, key, vbuf, nullptr, vbuf.get(),
+                    MeshSerializerImpl::calcVertexBufferDataSize(vertexData, vbuf)});
+        };
+        auto addIndexData = [&](const HardwareIndexBufferSharedPtr& ibuf, size_t count)
+        {
+            if (ibuf)
+                addPayload({nullptr, 0, nullptr, ibuf, ibuf.get(), ibuf->getIndexSize() * count});
+        };
+
+        if (pMesh->sharedVertexData)
+            addVertexData(pMesh->sharedVertexData);
+        for (unsigned short i = 0; i < pMesh->getNumSubMeshes(); ++i)
+        {
+            const SubMesh* s = pMesh->getSubMesh(i);
+            addIndexData(s->indexData->indexBuffer, s->indexData->indexCount);
+            if (!s->useSharedVertices)
+                addVertexData(s->vertexData.get());
+            for (const IndexData* lodIndexData : s->mLodFaceList)
+                addIndexData(lodIndexData->indexBuffer,
+                    lodIndexData->indexBuffer ? lodIndexData->indexBuffer->getNumIndexes() : 0);
+        }
+
+        // The chunk starts right after the file header
+        size_t chunkStart = sizeof(uint16) + calcStringSize(mVersion);
+        size_t pos = chunkStart + MSTREAM_OVERHEAD_SIZE;
+        for (auto const& payload : payloads)
+        {
+            pos = (pos + BUFFER_ALIGNMENT - 1) / BUFFER_ALIGNMENT * BUFFER_ALIGNMENT;
+            mBufferOffsets[std::make_pair(payload.buf, payload.size)] = static_cast<uint32>(pos);
+            pos += payload.size;
+        }
+        if (pos > std::numeric_limits<uint32>::max())
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Mesh buffer data exceeds 4 GB",
+                "MeshSerializerImpl_Mappable::writeBufferData");
+        }
+
+        writeChunkHeader(std::to_underlying(MeshChunkID::BUFFER_DATA), pos - chunkStart);
+        static const uchar padding[BUFFER_ALIGNMENT] = {};
+        pos = chunkStart + MSTREAM_OVERHEAD_SIZE;
+        for (auto const& payload : payloads)
+        {
+            size_t offset = getBufferOffset(payload.buf, payload.size);
+            writeData(padding, 1, offset - pos);
+            if (payload.vbuf)
+                MeshSerializerImpl::writeVertexBufferData(payload.vertexData, payload.bindIndex, payload.vbuf);
+            else
+                MeshSerializerImpl::writeIndexBufferData(payload.ibuf, payload.size / payload.ibuf->getIndexSize());
+            pos = offset + payload.size;
+        }
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl_Mappable::getBufferOffset(const HardwareBuffer* buf, size_t size) const -> uint32
+    {
+        auto it = mBufferOffsets.find(std::make_pair(buf, size));
+        OgreAssert(it != mBufferOffsets.end(), "Buffer was not written to the BUFFER_DATA chunk");
+        return it->second;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_Mappable::writeVertexBufferData(const VertexData* vertexData,
+        unsigned short bindIndex, const HardwareVertexBufferSharedPtr& vbuf)
+    {
+        uint32 offset = getBufferOffset(vbuf.get(), MeshSerializerImpl::calcVertexBufferDataSize(vertexData, vbuf));
+        writeInts(&offset, 1);
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl_Mappable::calcVertexBufferDataSize(const VertexData* vertexData,
+        const HardwareVertexBufferSharedPtr& vbuf) -> size_t
+    {
+        return sizeof(uint32);
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl_Mappable::readVertexBufferData(const DataStreamPtr& stream, Mesh* pMesh,
+        VertexData* dest, unsigned short bindIndex, unsigned short vertexSize) -> HardwareVertexBufferSharedPtr
+    {
+        uint32 offset;
+        readInts(stream, &offset, 1);
+
+        HardwareVertexBufferSharedPtr vbuf = createVertexBuffer(pMesh, vertexSize, dest->vertexCount);
+        readBufferData(stream, vbuf.get(), offset, vbuf->getSizeInBytes());
+        if (mFlipEndian)
+        {
+            HardwareBufferLockGuard vbufLock(vbuf, HardwareBuffer::LockOptions::NORMAL);
+            flipFromLittleEndian(
+                vbufLock.pData,
+                dest->vertexCount,
+                vertexSize,
+                dest->vertexDeclaration->findElementsBySource(bindIndex));
+        }
+        return vbuf;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_Mappable::writeIndexBufferData(const HardwareIndexBufferSharedPtr& ibuf, size_t count)
+    {
+        uint32 offset = getBufferOffset(ibuf.get(), ibuf->getIndexSize() * count);
+        writeInts(&offset, 1);
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl_Mappable::calcIndexBufferDataSize(bool idx32bit, size_t count) -> size_t
+    {
+        return count ? sizeof(uint32) : 0;
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl_Mappable::readIndexBufferData(const DataStreamPtr& stream, Mesh* pMesh,
+        HardwareIndexBuffer::IndexType type, size_t count) -> HardwareIndexBufferSharedPtr
+    {
+        HardwareIndexBufferSharedPtr ibuf = createIndexBuffer(pMesh, type, count);
+        if (count == 0)
+            return ibuf;
+
+        uint32 offset;
+        readInts(stream, &offset, 1);
+        readBufferData(stream, ibuf.get(), offset, ibuf->getSizeInBytes());
+        if (mFlipEndian)
+        {
+            HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::LockOptions::NORMAL);
+            Serializer::flipFromLittleEndian(ibufLock.pData, ibuf->getIndexSize(), count);
+        }
+        return ibuf;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_Mappable::readBufferData(const DataStreamPtr& stream, HardwareBuffer* buf,
+        uint32 offset, size_t size)
+    {
+        if (offset + size > stream->size())
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                ::std::format("Buffer data out of range in {}", stream->getName()),
+                "MeshSerializerImpl_Mappable::readBufferData");
+        }
+
+        ::std::shared_ptr<uchar> shared = stream->getSharedData();
+        if (shared && !mFlipEndian)
+        {
+            // Share the mapped pages; the aliasing pointer keeps the whole mapping alive
+            uchar* pData = shared.get() + offset;
+            std::unique_ptr<HardwareBuffer> data =
+                std::make_unique<DefaultHardwareBuffer>(::std::shared_ptr<uchar>(shared, pData), size);
+            if (!buf->_adoptSystemMemoryBuffer(data))
+                buf->writeData(0, size, pData, true);
+            return;
+        }
+
+        size_t pos = stream->tell();
+        stream->seek(offset);
+        {
+            HardwareBufferLockGuard bufLock(buf, HardwareBuffer::LockOptions::DISCARD);
+            stream->read(bufLock.pData, size);
+        }
+        stream->seek(pos);
+    }
+
+
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -2996,6 +3716,23 @@ namespace Ogre {
         popInnerChunk(stream);
     }
 
+    void MeshSerializerImpl_v1_8::writeGeometryPositionDecode(const VertexData* pGeom)
+    {
+        calcGeometryPositionDecodeSize(pGeom);
+    }
+    //---------------------------------------------------------------------
+    auto MeshSerializerImpl_v1_8::calcGeometryPositionDecodeSize(const VertexData* pGeom) -> size_t
+    {
+        if (pGeom->positionDecodeMatrix != Affine3::IDENTITY)
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                ::std::format("{} can't store quantised positions, export the mesh in the latest "
+                "version or before Mesh::quantiseVertexData", mVersion),
+                "MeshSerializerImpl_v1_8::calcGeometryPositionDecodeSize");
+        }
+        return 0;
+    }
+    //---------------------------------------------------------------------
     void MeshSerializerImpl_v1_8::enableValidation()
     {
 
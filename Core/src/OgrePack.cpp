@@ -0,0 +1,752 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+// NOLINTBEGIN
+#define MINIZ_HEADER_FILE_ONLY
+#include <miniz.h>
+
+module Ogre.Core;
+
+import :Archive;
+import :DataStream;
+import :Exception;
+import :FileSystem;
+import :MurmurHash3;
+import :Pack;
+import :PackFileFormat;
+import :Platform;
+import :Prerequisites;
+import :SharedPtr;
+import :String;
+import :StringVector;
+import :Zstd;
+
+import <algorithm>;
+import <bit>;
+import <filesystem>;
+import <format>;
+import <fstream>;
+import <limits>;
+import <memory>;
+import <set>;
+import <string>;
+import <utility>;
+import <vector>;
+
+// NOLINTEND
+namespace Ogre {
+namespace {
+    void checkEndian(std::string_view source)
+    {
+        if constexpr (std::endian::native != std::endian::little)
+        {
+            OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED, "OgrePack archives are only supported on little endian platforms",
+                source);
+        }
+    }
+
+    /** Archive over a memory mapped OgrePack file, see PackArchiveFactory.
+    @remarks
+        The directory is used in place. All methods only read state set up by load(),
+        so open() may be called from several threads at once.
+    */
+    class PackArchive : public Archive
+    {
+    protected:
+        /// The whole memory mapped pack
+        ::std::shared_ptr<uchar> mData;
+        size_t mDataSize{0};
+        /// The directory inside the mapping
+        const PackEntry* mEntries{nullptr};
+        uint32 mEntryCount{0};
+        const char* mNames{nullptr};
+        /// Files sorted by name, followed by the directories
+        FileInfoList mFileList;
+        /// Directory names, derived from the file names
+        std::set<String, std::less<>> mDirectories;
+        /// Check opened entries against their content hash
+        bool mVerifyContent;
+
+        [[nodiscard]] auto getName(const PackEntry& entry) const -> std::string_view
+        { return {mNames + entry.nameOffset, entry.nameLength}; }
+
+        /// Binary search of the directory
+        [[nodiscard]] auto findEntry(std::string_view filename) const -> const PackEntry*;
+    public:
+        PackArchive(std::string_view name, std::string_view archType, bool verifyContent)
+            : Archive(name, archType), mVerifyContent(verifyContent) {}
+        ~PackArchive() override { unload(); }
+
+        /// @copydoc Archive::isCaseSensitive
+        [[nodiscard]] auto isCaseSensitive() const noexcept -> bool override { return true; }
+
+        /// @copydoc Archive::load
+        void load() override;
+        /// @copydoc Archive::unload
+        void unload() override;
+
+        /// @copydoc Archive::open
+        [[nodiscard]] auto open(std::string_view filename, bool readOnly = true) const -> DataStreamPtr override;
+
+        /// @copydoc Archive::create
+        auto create(std::string_view filename) -> DataStreamPtr override;
+
+        /// @copydoc Archive::remove
+        void remove(std::string_view filename) override;
+
+        /// @copydoc Archive::list
+        [[nodiscard]] auto list(bool recursive = true, bool dirs = false) const -> StringVectorPtr override;
+
+        /// @copydoc Archive::listFileInfo
+        [[nodiscard]] auto listFileInfo(bool recursive = true, bool dirs = false) const -> FileInfoListPtr override;
+
+        /// @copydoc Archive::find
+        [[nodiscard]] auto find(std::string_view pattern, bool recursive = true,
+            bool dirs = false) const -> StringVectorPtr override;
+
+        /// @copydoc Archive::findFileInfo
+        [[nodiscard]] auto findFileInfo(std::string_view pattern, bool recursive = true,
+            bool dirs = false) const -> FileInfoListPtr override;
+
+        /// @copydoc Archive::exists
+        [[nodiscard]] auto exists(std::string_view filename) const -> bool override;
+
+        /// @copydoc Archive::getModifiedTime
+        [[nodiscard]] auto getModifiedTime(std::string_view filename) const -> std::filesystem::file_time_type override;
+    };
+
+    auto alignPackOffset(uint64 offset) -> uint64
+    {
+        return (offset + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+    }
+
+    /** Greedy LZ4 block compressor.
+    @return
+        The compressed block, or an empty vector if it would not be smaller than the input.
+    */
+    auto compressLZ4(const uchar* src, size_t size) -> std::vector<uchar>
+    {
+        size_t constexpr MIN_MATCH = 4;
+        // the block format requires the last 5 bytes to be literals and the last match to start 12 bytes before the end
+        size_t constexpr LAST_LITERALS = 5;
+        size_t constexpr MATCH_FIND_LIMIT = 12;
+        size_t constexpr MAX_OFFSET = 65535;
+        uint32 constexpr HASH_BITS = 16;
+
+        // positions are kept in 32 bits
+        if (size > std::numeric_limits<uint32>::max())
+            return {};
+
+        std::vector<uchar> out;
+        out.reserve(size);
+        std::vector<uint32> table(size_t(1) << HASH_BITS, 0);
+
+        auto read32 = [src](size_t pos)
+        {
+            uint32 value;
+            std::memcpy(&value, src + pos, sizeof(value));
+            return value;
+        };
+        auto writeLength = [&out](size_t length)
+        {
+            for (; length >= 255; length -= 255)
+                out.push_back(255);
+            out.push_back(uchar(length));
+        };
+        auto writeLiterals = [&](size_t begin, size_t end, uchar matchToken)
+        {
+            size_t count = end - begin;
+            out.push_back(uchar(std::min<size_t>(count, 15) << 4 | matchToken));
+            if (count >= 15)
+                writeLength(count - 15);
+            out.insert(out.end(), src + begin, src + end);
+        };
+
+        size_t anchor = 0;
+        for (size_t pos = 0; pos + MATCH_FIND_LIMIT <= size;)
+        {
+            uint32 sequence = read32(pos);
+            uint32& slot = table[(sequence * 2654435761u) >> (32 - HASH_BITS)];
+            size_t candidate = slot;
+            slot = uint32(pos);
+            if (candidate >= pos || pos - candidate > MAX_OFFSET || read32(candidate) != sequence)
+            {
+                ++pos;
+                continue;
+            }
+
+            size_t length = MIN_MATCH;
+            while (pos + length < size - LAST_LITERALS && src[candidate + length] == src[pos + length])
+                ++length;
+
+            size_t extra = length - MIN_MATCH;
+            writeLiterals(anchor, pos, uchar(std::min<size_t>(extra, 15)));
+            size_t offset = pos - candidate;
+            out.push_back(uchar(offset));
+            out.push_back(uchar(offset >> 8));
+            if (extra >= 15)
+                writeLength(extra - 15);
+
+            pos += length;
+            anchor = pos;
+            if (out.size() >= size)
+                return {};
+        }
+        writeLiterals(anchor, size, 0);
+
+        if (out.size() >= size)
+            return {};
+        return out;
+    }
+
+    /** Decompress an LZ4 block.
+    @return
+        Whether the block was valid and decompressed to exactly dstSize bytes.
+    */
+    auto decompressLZ4(const uchar* src, size_t srcSize, uchar* dst, size_t dstSize) -> bool
+    {
+        size_t in = 0, out = 0;
+        auto readLength = [&](size_t& length) -> bool
+        {
+            if (length != 15)
+                return true;
+            for (;;)
+            {
+                if (in == srcSize)
+                    return false;
+                uchar byte = src[in++];
+                length += byte;
+                if (byte != 255)
+                    return true;
+            }
+        };
+
+        while (in < srcSize)
+        {
+            uchar token = src[in++];
+            size_t literals = token >> 4;
+            if (!readLength(literals) || literals > srcSize - in || literals > dstSize - out)
+                return false;
+            std::memcpy(dst + out, src + in, literals);
+            in += literals;
+            out += literals;
+
+            // the last sequence has no match
+            if (in == srcSize)
+                break;
+
+            if (srcSize - in < 2)
+                return false;
+            size_t offset = src[in] | size_t(src[in + 1]) << 8;
+            in += 2;
+            size_t length = token & 15;
+            if (offset == 0 || offset > out || !readLength(length))
+                return false;
+            length += 4;
+            if (length > dstSize - out)
+                return false;
+            // the match may overlap the bytes it produces
+            for (size_t end = out + length; out < end; ++out)
+                dst[out] = dst[out - offset];
+        }
+        return out == dstSize;
+    }
+}
+    //-----------------------------------------------------------------------
+    void PackArchive::load()
+    {
+        if (mData)
+            return;
+
+        checkEndian("PackArchive::load");
+
+        DataStreamPtr mapped = _openMappedFileStream(mName);
+        ::std::shared_ptr<uchar> data = mapped->getSharedData();
+        size_t dataSize = mapped->size();
+
+        auto corrupt = [this](std::string_view what)
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, ::std::format("{}: {}", mName, what), "PackArchive::load");
+        };
+
+        if (dataSize < sizeof(PackHeader))
+            corrupt("not an OgrePack archive");
+
+        const auto* header = reinterpret_cast<const PackHeader*>(data.get());
+        if (std::string_view{header->magic, sizeof(header->magic)} != PACK_MAGIC)
+            corrupt("not an OgrePack archive");
+        if (header->version != PACK_VERSION)
+            corrupt(::std::format("unsupported version {}", header->version));
+
+        // written as differences so corrupt sizes cannot wrap around
+        auto inBounds = [](uint64 offset, uint64 size, uint64 limit)
+        {
+            return offset <= limit && size <= limit - offset;
+        };
+
+        uint64 directoryEnd = sizeof(PackHeader) + uint64(header->entryCount) * sizeof(PackEntry);
+        if (directoryEnd > dataSize || header->namesOffset < directoryEnd ||
+            !inBounds(header->namesOffset, header->namesSize, dataSize))
+            corrupt("truncated directory");
+
+        const auto* entries = reinterpret_cast<const PackEntry*>(data.get() + sizeof(PackHeader));
+        const auto* names = reinterpret_cast<const char*>(data.get() + header->namesOffset);
+        for (uint32 i = 0; i < header->entryCount; ++i)
+        {
+            const PackEntry& entry = entries[i];
+            if (!inBounds(entry.nameOffset, entry.nameLength, header->namesSize) ||
+                !inBounds(entry.dataOffset, entry.storedSize, dataSize))
+                corrupt("entry out of bounds");
+            // stored entries are opened as views of size bytes
+            if (PackCompression(entry.compression) == PackCompression::NONE && entry.size != entry.storedSize)
+                corrupt("stored entry size mismatch");
+        }
+
+        mData = std::move(data);
+        mDataSize = dataSize;
+        mEntries = entries;
+        mEntryCount = header->entryCount;
+        mNames = names;
+
+        // Cache file infos
+        mFileList.reserve(mEntryCount);
+        for (uint32 i = 0; i < mEntryCount; ++i)
+        {
+            FileInfo info;
+            info.archive = this;
+            info.filename = getName(mEntries[i]);
+            std::string_view basename, path;
+            StringUtil::splitFilename(info.filename, basename, path);
+            info.basename = basename;
+            info.path = path;
+            info.compressedSize = mEntries[i].storedSize;
+            info.uncompressedSize = mEntries[i].size;
+            mFileList.push_back(info);
+
+            // every parent directory of the file
+            for (size_t slash = info.path.find('/'); slash != String::npos; slash = info.path.find('/', slash + 1))
+                mDirectories.emplace(info.path.substr(0, slash));
+        }
+        std::ranges::sort(mFileList, {}, &FileInfo::filename);
+
+        for (const String& dir : mDirectories)
+        {
+            FileInfo info;
+            info.archive = this;
+            info.filename = dir;
+            std::string_view basename, path;
+            StringUtil::splitFilename(info.filename, basename, path);
+            info.basename = basename;
+            info.path = path;
+            // same convention as the zip archive
+            info.compressedSize = size_t(-1);
+            info.uncompressedSize = 0;
+            mFileList.push_back(info);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void PackArchive::unload()
+    {
+        mFileList.clear();
+        mDirectories.clear();
+        mEntries = nullptr;
+        mEntryCount = 0;
+        mNames = nullptr;
+        // streams handed out by open() keep their own reference to the mapping
+        mData.reset();
+        mDataSize = 0;
+    }
+    //-----------------------------------------------------------------------
+    auto PackArchive::findEntry(std::string_view filename) const -> const PackEntry*
+    {
+        uint64 hash = packNameHash(filename);
+        const PackEntry* end = mEntries + mEntryCount;
+        const PackEntry* it = std::lower_bound(mEntries, end, hash,
+            [](const PackEntry& entry, uint64 h) { return entry.nameHash < h; });
+
+        // equal hashes are ordered by name
+        for (; it != end && it->nameHash == hash; ++it)
+            if (getName(*it) == filename)
+                return it;
+
+        return nullptr;
+    }
+    //-----------------------------------------------------------------------
+    auto PackArchive::open(std::string_view filename, bool readOnly) const -> DataStreamPtr
+    {
+        const PackEntry* entry = findEntry(filename);
+        if (!entry)
+        {
+            OGRE_EXCEPT(ExceptionCodes::FILE_NOT_FOUND, ::std::format("could not open {}", filename));
+        }
+
+        const uchar* stored = mData.get() + entry->dataOffset;
+        MemoryDataStreamPtr ret;
+
+        using enum PackCompression;
+        switch (PackCompression(entry->compression))
+        {
+        case NONE:
+        {
+            // hand out a view into the mapping, which the stream keeps alive
+            ::std::shared_ptr<uchar> view{mData, const_cast<uchar*>(stored)};
+            ret = std::make_shared<MemoryDataStream>(filename, std::move(view), entry->size);
+            break;
+        }
+        case DEFLATE:
+        {
+            ret = std::make_shared<MemoryDataStream>(filename, entry->size);
+            size_t written = tinfl_decompress_mem_to_mem(ret->getPtr(), ret->size(), stored, entry->storedSize, 0);
+            if (written != entry->size)
+                OGRE_EXCEPT(ExceptionCodes::FILE_NOT_FOUND, ::std::format("could not read {}", filename));
+            break;
+        }
+        case LZ4:
+        {
+            ret = std::make_shared<MemoryDataStream>(filename, entry->size);
+            if (!decompressLZ4(stored, entry->storedSize, ret->getPtr(), ret->size()))
+                OGRE_EXCEPT(ExceptionCodes::FILE_NOT_FOUND, ::std::format("could not read {}", filename));
+            break;
+        }
+        case ZSTD:
+        {
+            ret = std::make_shared<MemoryDataStream>(filename, entry->size);
+            try
+            {
+                zstdDecompress({stored, size_t(entry->storedSize)}, {ret->getPtr(), ret->size()});
+            }
+            catch (const InvalidParametersException&)
+            {
+                OGRE_EXCEPT(ExceptionCodes::FILE_NOT_FOUND, ::std::format("could not read {}", filename));
+            }
+            break;
+        }
+        default:
+            OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED, ::std::format("unsupported compression for {}", filename),
+                "PackArchive::open");
+        }
+
+        if (mVerifyContent)
+        {
+            uint64 hash[2];
+            MurmurHash3_128(ret->getPtr(), ret->size(), 0, hash);
+            if (hash[0] != entry->contentHash[0] || hash[1] != entry->contentHash[1])
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, ::std::format("content hash mismatch for {}", filename),
+                    "PackArchive::open");
+        }
+
+        return ret;
+    }
+    //---------------------------------------------------------------------
+    auto PackArchive::create(std::string_view filename) -> DataStreamPtr
+    {
+        OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED, "Modification of OgrePack archives is not implemented, use PackWriter");
+    }
+    //---------------------------------------------------------------------
+    void PackArchive::remove(std::string_view filename)
+    {
+        OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED, "Modification of OgrePack archives is not implemented, use PackWriter");
+    }
+    //-----------------------------------------------------------------------
+    auto PackArchive::list(bool recursive, bool dirs) const -> StringVectorPtr
+    {
+        StringVectorPtr ret = StringVectorPtr(new StringVector());
+
+        for (const auto & i : mFileList)
+            if ((dirs == (i.compressedSize == size_t (-1))) &&
+                (recursive || i.path.empty()))
+                ret->emplace_back(i.filename);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    auto PackArchive::listFileInfo(bool recursive, bool dirs) const -> FileInfoListPtr
+    {
+        auto* fil = new FileInfoList();
+        for (const auto & i : mFileList)
+            if ((dirs == (i.compressedSize == size_t (-1))) &&
+                (recursive || i.path.empty()))
+                fil->push_back(i);
+
+        return FileInfoListPtr(fil);
+    }
+    //-----------------------------------------------------------------------
+    auto PackArchive::find(std::string_view pattern, bool recursive, bool dirs) const -> StringVectorPtr
+    {
+        StringVectorPtr ret = StringVectorPtr(new StringVector());
+        // If pattern contains a directory name, do a full match
+        bool full_match = (pattern.find ('/') != String::npos) ||
+                          (pattern.find ('\\') != String::npos);
+        bool wildCard = pattern.find('*') != String::npos;
+
+        for (const auto & i : mFileList)
+            if ((dirs == (i.compressedSize == size_t (-1))) &&
+                (recursive || full_match || wildCard))
+                if (StringUtil::match(full_match ? i.filename : i.basename, pattern, false))
+                    ret->emplace_back(i.filename);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    auto PackArchive::findFileInfo(std::string_view pattern,
+        bool recursive, bool dirs) const -> FileInfoListPtr
+    {
+        FileInfoListPtr ret = FileInfoListPtr(new FileInfoList());
+        // If pattern contains a directory name, do a full match
+        bool full_match = (pattern.find ('/') != String::npos) ||
+                          (pattern.find ('\\') != String::npos);
+        bool wildCard = pattern.find('*') != String::npos;
+
+        for (const auto & i : mFileList)
+            if ((dirs == (i.compressedSize == size_t (-1))) &&
+                (recursive || full_match || wildCard))
+                if (StringUtil::match(full_match ? i.filename : i.basename, pattern, false))
+                    ret->push_back(i);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    auto PackArchive::exists(std::string_view filename) const -> bool
+    {
+        return findEntry(filename) || mDirectories.contains(filename);
+    }
+    //---------------------------------------------------------------------
+    auto PackArchive::getModifiedTime(std::string_view filename) const -> std::filesystem::file_time_type
+    {
+        // entries have no time of their own
+        std::error_code ec{};
+        auto const lastWriteTime = std::filesystem::last_write_time(mName, ec);
+        if (ec == std::error_code{})
+        {
+            return lastWriteTime;
+        }
+        else
+        {
+            return {};
+        }
+    }
+    //-----------------------------------------------------------------------
+    //  PackArchiveFactory
+    //-----------------------------------------------------------------------
+    auto PackArchiveFactory::createInstance( std::string_view name, bool readOnly ) -> Archive *
+    {
+        if(!readOnly)
+            return nullptr;
+
+        return new PackArchive(name, getType(), mVerifyContent);
+    }
+    //-----------------------------------------------------------------------
+    auto PackArchiveFactory::getType() const noexcept -> std::string_view
+    {
+        static std::string_view const constexpr name = "OgrePack";
+        return name;
+    }
+    //-----------------------------------------------------------------------
+    //  PackWriter
+    //-----------------------------------------------------------------------
+    PackWriter::~PackWriter()
+    {
+        // tmpfile() spools are deleted when closed
+        if (mSpool)
+            std::fclose(mSpool);
+    }
+    //-----------------------------------------------------------------------
+    void PackWriter::addFile(std::string_view name, const DataStreamPtr& stream, PackCompression compression)
+    {
+        if (!mSpool)
+        {
+            mSpool = std::tmpfile();
+            if (!mSpool)
+            {
+                OGRE_EXCEPT(ExceptionCodes::CANNOT_WRITE_TO_FILE, "Cannot create the spool file", "PackWriter::addFile");
+            }
+        }
+
+        String contents = stream->getAsString();
+        const auto* data = reinterpret_cast<const uchar*>(contents.data());
+
+        PendingFile file{String{name}, mSpoolSize, contents.size(), PackCompression::NONE, contents.size(), {}};
+        MurmurHash3_128(data, contents.size(), 0, file.contentHash);
+
+        std::vector<uchar> compressedLZ4;
+        std::vector<uchar> compressedZstd;
+        void* compressedDeflate = nullptr;
+        if (!contents.empty())
+        {
+            // keep the compressed data only if it pays off
+            if (compression == PackCompression::DEFLATE)
+            {
+                size_t compressedSize = 0;
+                compressedDeflate = tdefl_compress_mem_to_heap(data, contents.size(), &compressedSize,
+                                                               TDEFL_DEFAULT_MAX_PROBES);
+                if (compressedDeflate && compressedSize < contents.size())
+                {
+                    data = static_cast<const uchar*>(compressedDeflate);
+                    file.storedSize = compressedSize;
+                    file.compression = PackCompression::DEFLATE;
+                }
+            }
+            else if (compression == PackCompression::LZ4)
+            {
+                compressedLZ4 = compressLZ4(data, contents.size());
+                if (!compressedLZ4.empty())
+                {
+                    data = compressedLZ4.data();
+                    file.storedSize = compressedLZ4.size();
+                    file.compression = PackCompression::LZ4;
+                }
+            }
+            else if (compression == PackCompression::ZSTD)
+            {
+                compressedZstd = zstdCompress({data, contents.size()});
+                if (compressedZstd.size() < contents.size())
+                {
+                    data = compressedZstd.data();
+                    file.storedSize = compressedZstd.size();
+                    file.compression = PackCompression::ZSTD;
+                }
+            }
+        }
+
+        size_t written = std::fwrite(data, 1, file.storedSize, mSpool);
+        mz_free(compressedDeflate);
+        if (written != file.storedSize)
+        {
+            OGRE_EXCEPT(ExceptionCodes::CANNOT_WRITE_TO_FILE, ::std::format("Failed spooling {}", name),
+                "PackWriter::addFile");
+        }
+
+        mSpoolSize += file.storedSize;
+        mFiles.push_back(std::move(file));
+    }
+    //-----------------------------------------------------------------------
+    void PackWriter::addArchive(Archive* archive, PackCompression compression)
+    {
+        StringVectorPtr files = archive->list(true, false);
+        for (const String& name : *files)
+            addFile(name, archive->open(name), compression);
+    }
+    //-----------------------------------------------------------------------
+    void PackWriter::write(std::string_view path)
+    {
+        checkEndian("PackWriter::write");
+
+        // directory order
+        std::vector<const PendingFile*> files;
+        for (const PendingFile& file : mFiles)
+            files.push_back(&file);
+        std::ranges::sort(files, [](const PendingFile* a, const PendingFile* b)
+        {
+            uint64 ha = packNameHash(a->name), hb = packNameHash(b->name);
+            return ha != hb ? ha < hb : a->name < b->name;
+        });
+        for (size_t i = 1; i < files.size(); ++i)
+        {
+            if (files[i]->name == files[i - 1]->name)
+                OGRE_EXCEPT(ExceptionCodes::DUPLICATE_ITEM, ::std::format("{} was added twice", files[i]->name),
+                    "PackWriter::write");
+        }
+
+        PackHeader header{};
+        std::ranges::copy(PACK_MAGIC, header.magic);
+        header.version = PACK_VERSION;
+        header.entryCount = uint32(files.size());
+        header.namesOffset = sizeof(PackHeader) + files.size() * sizeof(PackEntry);
+
+        std::vector<PackEntry> entries(files.size());
+        String names;
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            entries[i].nameHash = packNameHash(files[i]->name);
+            entries[i].nameOffset = uint32(names.size());
+            entries[i].nameLength = uint32(files[i]->name.size());
+            names += files[i]->name;
+        }
+        header.namesSize = names.size();
+
+        uint64 offset = alignPackOffset(header.namesOffset + header.namesSize);
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            entries[i].dataOffset = offset;
+            entries[i].storedSize = files[i]->storedSize;
+            entries[i].size = files[i]->size;
+            entries[i].compression = std::to_underlying(files[i]->compression);
+            entries[i].contentHash[0] = files[i]->contentHash[0];
+            entries[i].contentHash[1] = files[i]->contentHash[1];
+            offset = alignPackOffset(offset + entries[i].storedSize);
+        }
+
+        std::ofstream out{std::filesystem::path{path}, std::ios::binary | std::ios::trunc};
+        if (!out)
+        {
+            OGRE_EXCEPT(ExceptionCodes::CANNOT_WRITE_TO_FILE, ::std::format("Cannot open {} for writing", path),
+                "PackWriter::write");
+        }
+
+        auto padTo = [&out](uint64 target)
+        {
+            static char const constexpr zeros[PACK_ALIGNMENT] = {};
+            auto pos = uint64(out.tellp());
+            out.write(zeros, std::streamsize(target - pos));
+        };
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(entries.data()), std::streamsize(entries.size() * sizeof(PackEntry)));
+        out.write(names.data(), std::streamsize(names.size()));
+
+        // copy the stored data over from the spool in bounded chunks
+        std::vector<char> buffer(1 << 20);
+        bool spoolFailed = false;
+        for (size_t i = 0; i < files.size() && !spoolFailed; ++i)
+        {
+            padTo(entries[i].dataOffset);
+            spoolFailed = std::fseek(mSpool, long(files[i]->spoolOffset), SEEK_SET) != 0;
+            for (uint64 left = files[i]->storedSize; left && !spoolFailed;)
+            {
+                size_t chunk = size_t(std::min<uint64>(left, buffer.size()));
+                spoolFailed = std::fread(buffer.data(), 1, chunk, mSpool) != chunk;
+                out.write(buffer.data(), std::streamsize(chunk));
+                left -= chunk;
+            }
+        }
+        // later files are appended at the end
+        if (mSpool)
+            std::fseek(mSpool, 0, SEEK_END);
+
+        if (!out || spoolFailed)
+        {
+            OGRE_EXCEPT(ExceptionCodes::CANNOT_WRITE_TO_FILE, ::std::format("Failed writing {}", path),
+                "PackWriter::write");
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstddef>
+
+module Ogre.Core:PackFileFormat;
+
+import :MurmurHash3;
+import :Platform;
+import :Prerequisites;
+
+import <string_view>;
+
+namespace Ogre {
+
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Resources
+    *  @{
+    */
+/** Definition of the OgrePack archive format
+
+    OgrePack files are made to be memory mapped and read in place. All fields are little endian
+    and the file is laid out as follows:
+        PackHeader          : at offset 0
+        PackEntry[count]    : the directory, sorted by (nameHash, name)
+        char[namesSize]     : entry names, not zero terminated, referenced by the directory
+        padding             : up to the next PACK_ALIGNMENT boundary
+        data                : the entries, each starting on a PACK_ALIGNMENT boundary
+*/
+    auto constexpr inline PACK_MAGIC = std::string_view{"OGREPACK"};
+    uint32 constexpr inline PACK_VERSION = 1;
+    /// Alignment of the entry data, matching the page size so entries map to whole pages
+    size_t constexpr inline PACK_ALIGNMENT = 4096;
+
+    struct PackHeader
+    {
+        char magic[8];          // PACK_MAGIC
+        uint32 version;         // PACK_VERSION
+        uint32 entryCount;      // number of PackEntry records following the header
+        uint64 namesOffset;     // absolute offset of the name table
+        uint64 namesSize;       // size of the name table in bytes
+    };
+    static_assert(sizeof(PackHeader) == 32);
+
+    struct PackEntry
+    {
+        uint64 nameHash;        // packNameHash of the name
+        uint32 nameOffset;      // relative to PackHeader::namesOffset
+        uint32 nameLength;
+        uint64 dataOffset;      // absolute, multiple of PACK_ALIGNMENT
+        uint64 storedSize;      // bytes stored in the pack
+        uint64 size;            // bytes after decompression
+        uint32 compression;     // PackCompression
+        uint32 reserved;        // 0
+        uint64 contentHash[2];  // MurmurHash3_128 of the uncompressed data
+    };
+    static_assert(sizeof(PackEntry) == 64);
+
+    /// Hash the directory is sorted by
+    inline auto packNameHash(std::string_view name) -> uint64
+    {
+        uint64 hash[2];
+        MurmurHash3_128(name.data(), name.size(), 0, hash);
+        return hash[0];
+    }
+    /** @} */
+    /** @} */
+}
@@ -0,0 +1,130 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module Ogre.Core;
+
+import :ParallelFor;
+import :Prerequisites;
+
+import <algorithm>;
+import <condition_variable>;
+import <exception>;
+import <functional>;
+import <mutex>;
+import <thread>;
+
+namespace Ogre {
+    //-----------------------------------------------------------------------
+    auto TaskPool::get() -> TaskPool&
+    {
+        static TaskPool pool{std::max(1u, std::thread::hardware_concurrency()) - 1};
+        return pool;
+    }
+    //-----------------------------------------------------------------------
+    TaskPool::TaskPool(uint32 numWorkers)
+    {
+        mWorkers.reserve(numWorkers);
+        for (uint32 i = 0; i < numWorkers; ++i)
+            mWorkers.emplace_back([this] { workerLoop(); });
+    }
+    //-----------------------------------------------------------------------
+    TaskPool::~TaskPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mShutdown = true;
+        }
+        mWork.notify_all();
+        for (auto& worker : mWorkers)
+            worker.join();
+    }
+    //-----------------------------------------------------------------------
+    void TaskPool::runOne(Batch& batch, std::unique_lock<std::mutex>& lock)
+    {
+        uint32 const index = batch.next++;
+        if (batch.next == batch.count)
+            mBatches.remove(&batch);
+
+        lock.unlock();
+        std::exception_ptr error;
+        bool const nested = tInParallelBand;
+        tInParallelBand = true;
+        try
+        {
+            (*batch.task)(index);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        tInParallelBand = nested;
+        lock.lock();
+
+        if (error && !batch.error)
+            batch.error = error;
+        if (++batch.finished == batch.count)
+            mDone.notify_all();
+    }
+    //-----------------------------------------------------------------------
+    void TaskPool::run(uint32 count, const std::function<void(uint32)>& task)
+    {
+        if (count == 0)
+            return;
+
+        if (mWorkers.empty() || tInParallelBand || count == 1)
+        {
+            for (uint32 i = 0; i < count; ++i)
+                task(i);
+            return;
+        }
+
+        Batch batch{&task, count};
+        std::unique_lock<std::mutex> lock(mMutex);
+        mBatches.push_back(&batch);
+        mWork.notify_all();
+
+        while (batch.next < batch.count)
+            runOne(batch, lock);
+        mDone.wait(lock, [&] { return batch.finished == batch.count; });
+        lock.unlock();
+
+        if (batch.error)
+            std::rethrow_exception(batch.error);
+    }
+    //-----------------------------------------------------------------------
+    void TaskPool::workerLoop()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        for (;;)
+        {
+            mWork.wait(lock, [this] { return mShutdown || !mBatches.empty(); });
+            if (mShutdown)
+                return;
+            runOne(*mBatches.front(), lock);
+        }
+    }
+}
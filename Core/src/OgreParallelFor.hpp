@@ -0,0 +1,124 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module Ogre.Core:ParallelFor;
+
+import :Prerequisites;
+
+import <algorithm>;
+import <condition_variable>;
+import <exception>;
+import <functional>;
+import <list>;
+import <mutex>;
+import <thread>;
+import <vector>;
+
+// internal task pool shared by the image processing code (resampling, block
+// compression) and resource loading (texture layers, mesh import, LOD
+// generation, script parsing).
+namespace Ogre {
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup General
+    *  @{
+    */
+
+// set while a thread runs a pool task, nested calls then run inline instead of
+// oversubscribing the machine
+inline thread_local bool tInParallelBand = false;
+
+// A fixed set of worker threads started on first use and kept for the lifetime
+// of the process. The thread submitting a batch works on it as well, so a batch
+// always completes even if all workers are busy with other batches.
+class TaskPool
+{
+public:
+    // the pool shared by all users, with one worker less than hardware threads
+    static auto get() -> TaskPool&;
+
+    explicit TaskPool(uint32 numWorkers);
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    auto operator=(const TaskPool&) -> TaskPool& = delete;
+
+    // workers plus the calling thread
+    [[nodiscard]] auto getConcurrency() const noexcept -> uint32 { return static_cast<uint32>(mWorkers.size()) + 1; }
+
+    // Runs task(i) for every i in [0, count) and returns once all have finished.
+    // The first exception thrown by a task is rethrown on the calling thread.
+    // Called from within a task, the batch runs inline on that thread.
+    void run(uint32 count, const std::function<void(uint32)>& task);
+
+private:
+    struct Batch
+    {
+        const std::function<void(uint32)>* task;
+        uint32 count;
+        uint32 next{0};
+        uint32 finished{0};
+        std::exception_ptr error;
+    };
+
+    // claims and runs one task of batch, lock is held on entry and exit
+    void runOne(Batch& batch, std::unique_lock<std::mutex>& lock);
+    void workerLoop();
+
+    std::mutex mMutex;
+    std::condition_variable mWork;
+    std::condition_variable mDone;
+    std::list<Batch*> mBatches;
+    bool mShutdown{false};
+    std::vector<std::thread> mWorkers;
+};
+
+// Runs work(begin, end) over the range [0, count) split into bands of at least
+// minBand items, spread over the shared task pool. Exceptions thrown by a band are
+// rethrown on the calling thread once all bands have finished.
+template<typename Work>
+void parallelForBands(uint32 count, uint32 minBand, Work&& work)
+{
+    TaskPool& pool = TaskPool::get();
+    uint32 const bands = std::min(count / std::max(1u, minBand), pool.getConcurrency() * 4);
+    if (bands <= 1 || tInParallelBand)
+    {
+        work(0u, count);
+        return;
+    }
+
+    pool.run(bands, [&](uint32 band)
+    {
+        work(static_cast<uint32>(uint64(count) * band / bands),
+             static_cast<uint32>(uint64(count) * (band + 1) / bands));
+    });
+}
+
+    /** @} */
+    /** @} */
+}
@@ -36,6 +36,8 @@ import :Common;
 import :Controller;
 import :ControllerManager;
 import :Exception;
+import :LodStrategy;
+import :LodStrategyManager;
 import :LogManager;
 import :Material;
 import :MaterialManager;
@@ -49,6 +51,7 @@ import :ParticleEmitter;
 import :ParticleSystem;
 import :ParticleSystemManager;
 import :ParticleSystemRenderer;
+import :PixelCountLodStrategy;
 import :RadixSort;
 import :Root;
 import :SceneManager;
@@ -137,6 +140,34 @@ namespace Ogre {
         void doSet(void* target, std::string_view val) override;
     };
     /// Command objects
+    /** Command object for LOD strategy (see ParamCommand).*/
+    class CmdLodStrategy : public ParamCommand
+    {
+    public:
+        auto doGet(const void* target) const -> String override;
+        void doSet(void* target, std::string_view val) override;
+    };
+    /** Command object for LOD range (see ParamCommand).*/
+    class CmdLodRange : public ParamCommand
+    {
+    public:
+        auto doGet(const void* target) const -> String override;
+        void doSet(void* target, std::string_view val) override;
+    };
+    /** Command object for LOD minimum detail (see ParamCommand).*/
+    class CmdLodMinDetail : public ParamCommand
+    {
+    public:
+        auto doGet(const void* target) const -> String override;
+        void doSet(void* target, std::string_view val) override;
+    };
+    /** Command object for LOD maximum iteration interval (see ParamCommand).*/
+    class CmdLodMaxIterationInterval : public ParamCommand
+    {
+    public:
+        auto doGet(const void* target) const -> String override;
+        void doSet(void* target, std::string_view val) override;
+    };
     static CmdCull msCullCmd;
     static CmdHeight msHeightCmd;
     static CmdMaterial msMaterialCmd;
@@ -148,6 +179,10 @@ namespace Ogre {
     static CmdLocalSpace msLocalSpaceCmd;
     static CmdIterationInterval msIterationIntervalCmd;
     static CmdNonvisibleTimeout msNonvisibleTimeoutCmd;
+    static CmdLodStrategy msLodStrategyCmd;
+    static CmdLodRange msLodRangeCmd;
+    static CmdLodMinDetail msLodMinDetailCmd;
+    static CmdLodMaxIterationInterval msLodMaxIterationIntervalCmd;
 
     Real constinit ParticleSystem::msDefaultIterationInterval = 0;
     Real constinit ParticleSystem::msDefaultNonvisibleTimeout = 0;
@@ -239,6 +274,9 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     ParticleSystem::~ParticleSystem()
     {
+        if (auto manager = ParticleSystemManager::getSingletonPtr())
+            manager->_notifyParticleSystemDestroyed(this);
+
         if (mTimeController)
         {
             // Destroy controller
@@ -373,6 +411,11 @@ namespace Ogre {
         mIterationIntervalSet = rhs.mIterationIntervalSet;
         mNonvisibleTimeout = rhs.mNonvisibleTimeout;
         mNonvisibleTimeoutSet = rhs.mNonvisibleTimeoutSet;
+        mLodStrategy = rhs.mLodStrategy;
+        mLodFullDetailValue = rhs.mLodFullDetailValue;
+        mLodMinDetailValue = rhs.mLodMinDetailValue;
+        mLodMinDetail = rhs.mLodMinDetail;
+        mLodMaxIterationInterval = rhs.mLodMaxIterationInterval;
         // last frame visible and time since last visible should be left default
 
         setRenderer(rhs.getRendererName());
@@ -478,6 +521,12 @@ namespace Ogre {
 
         Real iterationInterval = mIterationIntervalSet ? 
             mIterationInterval : msDefaultIterationInterval;
+        if (mLodStrategy && mLodMaxIterationInterval > iterationInterval)
+        {
+            // Step coarser as the detail drops
+            Real lodFactor = (1 - mLodDetail) / (1 - std::min(mLodMinDetail, Real(0.999f)));
+            iterationInterval += (mLodMaxIterationInterval - iterationInterval) * lodFactor;
+        }
         if (iterationInterval > 0)
         {
             mUpdateRemainTime += timeElapsed;
@@ -581,6 +630,13 @@ namespace Ogre {
         emissionAllowed = mFreeParticles.size();
         totalRequested = 0;
 
+        // Level of detail and the global budget may cap the quota below the pool size
+        size_t quota = _getLodQuota();
+        if (ParticleSystemManager::getSingleton().getParticleBudget())
+            quota = std::min(quota, ParticleSystemManager::getSingleton()._getParticleAllowance(this));
+        emissionAllowed = std::min(emissionAllowed,
+            quota > mActiveParticles.size() ? quota - mActiveParticles.size() : 0);
+
         // Count up total requested emissions for regular emitters (and exclude the ones that are used as
         // a template for emitted emitters)
         for (size_t i = 0;
@@ -603,6 +659,32 @@ namespace Ogre {
             ++i;
         }
 
+        // Scale the emission rate by the detail, carrying the fractions over
+        // so that low rates still emit now and then
+        if (mLodDetail < 1)
+        {
+            mLodEmissionRemainder.resize(emitterCount + emittedEmitterCount);
+            auto scale = [this](unsigned& count, Real& remainder)
+            {
+                remainder += count * mLodDetail;
+                count = static_cast<unsigned>(remainder);
+                remainder -= count;
+            };
+            totalRequested = 0;
+            for (size_t i = 0; i < emitterCount; ++i)
+            {
+                if (mEmitters[i]->isEmitted())
+                    continue;
+                scale(requested[i], mLodEmissionRemainder[i]);
+                totalRequested += requested[i];
+            }
+            for (size_t i = 0; i < emittedEmitterCount; ++i)
+            {
+                scale(emittedRequested[i], mLodEmissionRemainder[emitterCount + i]);
+                totalRequested += emittedRequested[i];
+            }
+        }
+
         // Check if the quota will be exceeded, if so reduce demand
         Real ratio =  1.0f;
         if (totalRequested > emissionAllowed)
@@ -848,6 +930,28 @@ namespace Ogre {
                 ParameterType::REAL),
                 &msNonvisibleTimeoutCmd);
 
+            dict->addParameter(ParameterDef("lod_strategy", 
+                "Sets the LOD strategy used to reduce the detail of the system, "
+                "or 'none' to always use full detail.",
+                ParameterType::STRING),
+                &msLodStrategyCmd);
+
+            dict->addParameter(ParameterDef("lod_range", 
+                "Sets the LOD values at which full and minimum detail are used.",
+                ParameterType::STRING),
+                &msLodRangeCmd);
+
+            dict->addParameter(ParameterDef("lod_min_detail", 
+                "Sets the lowest factor the emission rate and quota are reduced to.",
+                ParameterType::REAL),
+                &msLodMinDetailCmd);
+
+            dict->addParameter(ParameterDef("lod_max_iteration_interval", 
+                "Sets the update interval used at the minimum detail, or 0 to keep "
+                "the regular interval.",
+                ParameterType::REAL),
+                &msLodMaxIterationIntervalCmd);
+
         }
     }
     //-----------------------------------------------------------------------
@@ -997,6 +1101,29 @@ namespace Ogre {
             mLastVisibleFrame = Root::getSingleton().getNextFrameNumber();
             mTimeSinceLastVisible = 0.0f;
 
+            if (mLodStrategy && mParentNode)
+            {
+                // Interpolate the detail between the full and minimum detail values
+                Real value = mLodStrategy->getValue(this, cam);
+                Real fullValue = mLodStrategy->transformUserValue(mLodFullDetailValue);
+                Real minValue = mLodStrategy->transformUserValue(mLodMinDetailValue);
+                Real t = fullValue != minValue ? (value - fullValue) / (minValue - fullValue) : 0;
+                Real detail = 1 - Math::saturate(t) * (1 - mLodMinDetail);
+
+                // Several cameras in one frame, keep the highest detail
+                if (mLodFrame != mLastVisibleFrame)
+                    mLodDetail = detail;
+                else
+                    mLodDetail = std::max(mLodDetail, detail);
+                mLodFrame = mLastVisibleFrame;
+            }
+
+            if (mParentNode && ParticleSystemManager::getSingleton().getParticleBudget())
+            {
+                ParticleSystemManager::getSingleton()._notifyParticleSystemVisible(this,
+                    ScreenRatioPixelCountLodStrategy::getSingleton().getValue(this, cam));
+            }
+
             if (mSorted)
             {
                 _sortParticles(cam);
@@ -1012,6 +1139,27 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void ParticleSystem::setLodStrategy(LodStrategy* strategy)
+    {
+        mLodStrategy = strategy;
+        if (!mLodStrategy)
+            mLodDetail = 1;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::setLodRange(Real fullDetailValue, Real minDetailValue)
+    {
+        mLodFullDetailValue = fullDetailValue;
+        mLodMinDetailValue = minDetailValue;
+    }
+    //-----------------------------------------------------------------------
+    auto ParticleSystem::_getLodQuota() const -> size_t
+    {
+        if (!mLodStrategy)
+            return mPoolSize;
+        // Keep at least one particle so the effect never vanishes entirely
+        return std::max(size_t(1), static_cast<size_t>(mPoolSize * mLodDetail));
+    }
+    //-----------------------------------------------------------------------
     void ParticleSystem::_notifyAttached(Node* parent, bool isTagPoint)
     {
         MovableObject::_notifyAttached(parent, isTagPoint);
@@ -1563,6 +1711,50 @@ namespace Ogre {
         static_cast<ParticleSystem*>(target)->setNonVisibleUpdateTimeout(
             StringConverter::parseReal(val));
     }
+    //-----------------------------------------------------------------------
+    auto CmdLodStrategy::doGet(const void* target) const -> String
+    {
+        LodStrategy* strategy = static_cast<const ParticleSystem*>(target)->getLodStrategy();
+        return String{strategy ? strategy->getName() : "none"};
+    }
+    void CmdLodStrategy::doSet(void* target, std::string_view val)
+    {
+        static_cast<ParticleSystem*>(target)->setLodStrategy(
+            val == "none" ? nullptr : LodStrategyManager::getSingleton().getStrategy(val));
+    }
+    //-----------------------------------------------------------------------
+    auto CmdLodRange::doGet(const void* target) const -> String
+    {
+        const auto* psys = static_cast<const ParticleSystem*>(target);
+        return StringConverter::toString(Vector2{psys->getLodFullDetailValue(), psys->getLodMinDetailValue()});
+    }
+    void CmdLodRange::doSet(void* target, std::string_view val)
+    {
+        Vector2 range = StringConverter::parseVector2(val);
+        static_cast<ParticleSystem*>(target)->setLodRange(range.x, range.y);
+    }
+    //-----------------------------------------------------------------------
+    auto CmdLodMinDetail::doGet(const void* target) const -> String
+    {
+        return StringConverter::toString(
+            static_cast<const ParticleSystem*>(target)->getLodMinDetail());
+    }
+    void CmdLodMinDetail::doSet(void* target, std::string_view val)
+    {
+        static_cast<ParticleSystem*>(target)->setLodMinDetail(
+            StringConverter::parseReal(val));
+    }
+    //-----------------------------------------------------------------------
+    auto CmdLodMaxIterationInterval::doGet(const void* target) const -> String
+    {
+        return StringConverter::toString(
+            static_cast<const ParticleSystem*>(target)->getLodMaxIterationInterval());
+    }
+    void CmdLodMaxIterationInterval::doSet(void* target, std::string_view val)
+    {
+        static_cast<ParticleSystem*>(target)->setLodMaxIterationInterval(
+            StringConverter::parseReal(val));
+    }
    //-----------------------------------------------------------------------
     ParticleAffector::~ParticleAffector() 
     = default;
@@ -52,9 +52,12 @@ import :Singleton;
 import :StringConverter;
 import :StringVector;
 
+import <algorithm>;
+import <any>;
 import <map>;
 import <string>;
 import <utility>;
+import <vector>;
 
 namespace Ogre {
 
@@ -97,6 +100,68 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void ParticleSystemManager::apportionParticleBudget(unsigned long frame)
+    {
+        // Requests are complete once the frame number has moved on
+        if (frame == mBudgetRequestFrame)
+            return;
+
+        // Most visible first
+        std::ranges::stable_sort(mBudgetRequests, [](const BudgetRequest& a, const BudgetRequest& b)
+        {
+            return a.coverage > b.coverage;
+        });
+
+        mBudgetAllowances.clear();
+        size_t remaining = mParticleBudget;
+        for (auto const& request : mBudgetRequests)
+        {
+            size_t allowance = std::min(request.system->_getLodQuota(), remaining);
+            mBudgetAllowances[request.system] = allowance;
+            remaining -= allowance;
+        }
+        mBudgetLeft = remaining;
+
+        mBudgetRequests.clear();
+        mBudgetRequestFrame = frame;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystemManager::_notifyParticleSystemVisible(ParticleSystem* psys, Real coverage)
+    {
+        apportionParticleBudget(Root::getSingleton().getNextFrameNumber());
+
+        // Seen by several cameras, rank by the largest coverage
+        auto it = std::ranges::find(mBudgetRequests, psys, &BudgetRequest::system);
+        if (it != mBudgetRequests.end())
+            it->coverage = std::max(it->coverage, coverage);
+        else
+            mBudgetRequests.push_back({psys, coverage});
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystemManager::_notifyParticleSystemDestroyed(ParticleSystem* psys)
+    {
+        std::erase_if(mBudgetRequests, [psys](const BudgetRequest& r) { return r.system == psys; });
+        mBudgetAllowances.erase(psys);
+    }
+    //-----------------------------------------------------------------------
+    auto ParticleSystemManager::_getParticleAllowance(const ParticleSystem* psys) -> size_t
+    {
+        apportionParticleBudget(Root::getSingleton().getNextFrameNumber());
+
+        auto it = mBudgetAllowances.find(psys);
+        if (it != mBudgetAllowances.end())
+            return it->second;
+
+        // Not rendered last frame, first come first served from the leftovers
+        size_t allowance = std::min(psys->_getLodQuota(), mBudgetLeft);
+        mBudgetLeft -= allowance;
+        // Without particles the system has no bounds and would never be ranked
+        if (allowance == 0 && psys->getNumParticles() == 0)
+            allowance = 1;
+        mBudgetAllowances[psys] = allowance;
+        return allowance;
+    }
+    //-----------------------------------------------------------------------
     auto ParticleSystemManager::getScriptPatterns() const noexcept -> const StringVector&
     {
         return mScriptPatterns;
@@ -113,6 +178,16 @@ namespace Ogre {
         ScriptCompilerManager::getSingleton().parseScript(stream, groupName);
     }
     //-----------------------------------------------------------------------
+    auto ParticleSystemManager::preparseScript(const DataStreamPtr& stream) -> std::any
+    {
+        return ScriptCompilerManager::getSingleton().preparseScript(stream);
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystemManager::translateScript(std::any& preparsed, DataStreamPtr& stream, std::string_view groupName)
+    {
+        ScriptCompilerManager::getSingleton().translateScript(preparsed, stream, groupName);
+    }
+    //-----------------------------------------------------------------------
     void ParticleSystemManager::addEmitterFactory(ParticleEmitterFactory* factory)
     {
         String name = factory->getName();
@@ -0,0 +1,419 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <immintrin.h>
+#include <cstring>
+
+module Ogre.Core;
+
+import :Bitwise;
+import :PixelConversions;
+import :PixelFormat;
+import :PlatformInformation;
+import :Prerequisites;
+
+import <array>;
+import <bit>;
+
+namespace Ogre {
+namespace {
+    //---------------------------------------------------------------------
+    /// Byte offsets of the red, green, blue and alpha channel within a pixel, -1 if absent
+    struct ByteLayout
+    {
+        size_t size;
+        int channel[4];
+    };
+
+    auto getByteLayout(PixelFormat format, ByteLayout& layout) -> bool
+    {
+        if (format == PixelFormat::BYTE_LA)
+        {
+            layout = {2, {0, 0, 0, 1}};
+            return true;
+        }
+
+        // the shifts of native endian formats are byte offsets on little endian machines only
+        PixelFormatFlags const flags = PixelUtil::getFlags(format);
+        if (::std::endian::native != ::std::endian::little ||
+            (flags & PixelFormatFlags::NATIVEENDIAN) == PixelFormatFlags{} ||
+            (flags & PixelFormatFlags::INTEGER) != PixelFormatFlags{} ||
+            PixelUtil::getComponentType(format) != PixelComponentType::BYTE)
+            return false;
+
+        int bits[4];
+        unsigned char shifts[4];
+        PixelUtil::getBitDepths(format, bits);
+        PixelUtil::getBitShifts(format, shifts);
+        layout.size = PixelUtil::getNumElemBytes(format);
+        for (int c = 0; c < 4; ++c)
+        {
+            if (bits[c] != 8 && bits[c] != 0)
+                return false;
+            layout.channel[c] = bits[c] ? shifts[c] / 8 : -1;
+        }
+        if ((flags & PixelFormatFlags::LUMINANCE) != PixelFormatFlags{})
+            layout.channel[1] = layout.channel[2] = layout.channel[0];
+
+        // unpackColour only defaults a missing alpha channel
+        return layout.channel[0] >= 0 && layout.channel[1] >= 0 && layout.channel[2] >= 0;
+    }
+    //---------------------------------------------------------------------
+    struct RowConversion;
+    using RowFunction = void (*)(const RowConversion& conv, const uchar* src, uchar* dst, size_t count);
+
+    /** Conversion of a row of pixels that gathers one source byte, or a constant, into each
+        of four destination bytes or floats.
+    */
+    struct RowConversion
+    {
+        RowFunction function;
+        /// Source pixel size in bytes, or channel count for float to half conversions
+        size_t srcSize;
+        /// Pixels read by one 16 byte load
+        size_t pixelsPerLoad;
+        /// Source byte offset for each destination byte or float, -1 for the constant
+        int source[4];
+        uchar constant[4];
+        /** pshufb masks, one per output register. For byte output register r holds pixels
+            4r to 4r+3 of the load, for float output register r holds pixel r.
+        */
+        alignas(16) char masks[16][16];
+        /// Or-ed into each output register to supply the constants
+        alignas(16) uchar fillBytes[16];
+        alignas(16) int32 fillInts[4];
+    };
+
+    constexpr char Zero = static_cast<char>(0x80);
+    //---------------------------------------------------------------------
+    void gatherBytesScalar(const RowConversion& conv, const uchar* src, uchar* dst, size_t count)
+    {
+        for (size_t x = 0; x < count; ++x, src += conv.srcSize, dst += 4)
+            for (int j = 0; j < 4; ++j)
+                dst[j] = conv.source[j] < 0 ? conv.constant[j] : src[conv.source[j]];
+    }
+    //---------------------------------------------------------------------
+    void gatherFloatsScalar(const RowConversion& conv, const uchar* src, uchar* dst, size_t count)
+    {
+        auto* out = reinterpret_cast<float*>(dst);
+        for (size_t x = 0; x < count; ++x, src += conv.srcSize, out += 4)
+            for (int c = 0; c < 4; ++c)
+                out[c] = Bitwise::fixedToFloat(conv.source[c] < 0 ? conv.constant[c] : src[conv.source[c]], 8);
+    }
+    //---------------------------------------------------------------------
+    [[gnu::target("ssse3")]]
+    void gatherBytesSSSE3(const RowConversion& conv, const uchar* src, uchar* dst, size_t count)
+    {
+        __m128i const fill = _mm_load_si128(reinterpret_cast<const __m128i*>(conv.fillBytes));
+        size_t const outputs = conv.pixelsPerLoad / 4;
+        size_t x = 0;
+        // a load may reach past the pixels it converts, but never past the row
+        for (; (count - x) * conv.srcSize >= 16 && count - x >= conv.pixelsPerLoad; x += conv.pixelsPerLoad)
+        {
+            __m128i const v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * conv.srcSize));
+            for (size_t r = 0; r < outputs; ++r)
+            {
+                __m128i const mask = _mm_load_si128(reinterpret_cast<const __m128i*>(conv.masks[r]));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (x + 4 * r) * 4),
+                                 _mm_or_si128(_mm_shuffle_epi8(v, mask), fill));
+            }
+        }
+        gatherBytesScalar(conv, src + x * conv.srcSize, dst + x * 4, count - x);
+    }
+    //---------------------------------------------------------------------
+    [[gnu::target("avx2")]]
+    void gatherBytesAVX2(const RowConversion& conv, const uchar* src, uchar* dst, size_t count)
+    {
+        // pshufb works per 128 bit lane, so each lane loads its own four pixels
+        __m256i const mask = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(conv.masks[0])));
+        __m256i const fill = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(conv.fillBytes)));
+        size_t const srcSize = conv.srcSize;
+        size_t x = 0;
+        for (; x + 8 <= count && (count - x - 4) * srcSize >= 16; x += 8)
+        {
+            __m128i const lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * srcSize));
+            __m128i const hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (x + 4) * srcSize));
+            __m256i const v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 4), _mm256_or_si256(_mm256_shuffle_epi8(v, mask), fill));
+        }
+        gatherBytesSSSE3(conv, src + x * srcSize, dst + x * 4, count - x);
+    }
+    //---------------------------------------------------------------------
+    [[gnu::target("ssse3")]]
+    void gatherFloatsSSSE3(const RowConversion& conv, const uchar* src, uchar* dst, size_t count)
+    {
+        __m128i const fill = _mm_load_si128(reinterpret_cast<const __m128i*>(conv.fillInts));
+        __m128 const scale = _mm_set1_ps(255.0f);
+        auto* out = reinterpret_cast<float*>(dst);
+        size_t x = 0;
+        for (; (count - x) * conv.srcSize >= 16 && count - x >= conv.pixelsPerLoad; x += conv.pixelsPerLoad)
+        {
+            __m128i const v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * conv.srcSize));
+            for (size_t r = 0; r < conv.pixelsPerLoad; ++r)
+            {
+                __m128i const mask = _mm_load_si128(reinterpret_cast<const __m128i*>(conv.masks[r]));
+                __m128i const channels = _mm_or_si128(_mm_shuffle_epi8(v, mask), fill);
+                // divide rather than multiply by the reciprocal to match fixedToFloat exactly
+                _mm_storeu_ps(out + (x + r) * 4, _mm_div_ps(_mm_cvtepi32_ps(channels), scale));
+            }
+        }
+        gatherFloatsScalar(conv, src + x * conv.srcSize, dst + x * 16, count - x);
+    }
+    //---------------------------------------------------------------------
+    [[gnu::target("avx2")]]
+    void gatherFloatsAVX2(const RowConversion& conv, const uchar* src, uchar* dst, size_t count)
+    {
+        __m256i const fill = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(conv.fillInts)));
+        __m256 const scale = _mm256_set1_ps(255.0f);
+        auto* out = reinterpret_cast<float*>(dst);
+        size_t x = 0;
+        for (; (count - x) * conv.srcSize >= 16 && count - x >= conv.pixelsPerLoad; x += conv.pixelsPerLoad)
+        {
+            // both lanes see the same pixels, each picks a different one
+            __m256i const v = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * conv.srcSize)));
+            for (size_t r = 0; r < conv.pixelsPerLoad; r += 2)
+            {
+                __m256i const mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(conv.masks[r]));
+                __m256i const channels = _mm256_or_si256(_mm256_shuffle_epi8(v, mask), fill);
+                _mm256_storeu_ps(out + (x + r) * 4, _mm256_div_ps(_mm256_cvtepi32_ps(channels), scale));
+            }
+        }
+        gatherFloatsScalar(conv, src + x * conv.srcSize, dst + x * 16, count - x);
+    }
+    //---------------------------------------------------------------------
+    void halfScalar(const RowConversion& conv, const uchar* src, uchar* dst, size_t count)
+    {
+        for (size_t i = 0, n = count * conv.srcSize; i < n; ++i, src += 4, dst += 2)
+        {
+            uint32 bits;
+            memcpy(&bits, src, sizeof(bits));
+            uint16 const half = Bitwise::floatToHalfI(bits);
+            memcpy(dst, &half, sizeof(half));
+        }
+    }
+    //---------------------------------------------------------------------
+    inline auto select(__m128i mask, __m128i a, __m128i b) -> __m128i
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    /// Branch free Bitwise::floatToHalfI, with the result in the low 16 bits of each lane
+    inline auto floatToHalf(__m128i i) -> __m128i
+    {
+        __m128i const zero = _mm_setzero_si128();
+        __m128i const s = _mm_and_si128(_mm_srli_epi32(i, 16), _mm_set1_epi32(0x8000));
+        __m128i const magnitude = _mm_and_si128(i, _mm_set1_epi32(0x7fffffff));
+        __m128i const e = _mm_srli_epi32(magnitude, 23);
+        __m128i const m = _mm_and_si128(i, _mm_set1_epi32(0x007fffff));
+        __m128i const inf = _mm_or_si128(s, _mm_set1_epi32(0x7c00));
+
+        // normal range, rebias the exponent and drop 13 mantissa bits
+        __m128i result = _mm_or_si128(s, _mm_sub_epi32(_mm_srli_epi32(magnitude, 13), _mm_set1_epi32(112 << 10)));
+        // denormal range, scaling by 2^24 is exact so truncating it drops the same bits as the shifts
+        __m128i const denormal = _mm_or_si128(s, _mm_cvttps_epi32(_mm_mul_ps(_mm_castsi128_ps(magnitude), _mm_set1_ps(16777216.0f))));
+        result = select(_mm_cmplt_epi32(e, _mm_set1_epi32(113)), denormal, result);
+        result = select(_mm_cmplt_epi32(e, _mm_set1_epi32(102)), zero, result);
+        // overflow and infinity
+        result = select(_mm_cmpgt_epi32(e, _mm_set1_epi32(142)), inf, result);
+        // NaN keeps the top mantissa bits, forcing one set
+        __m128i const m13 = _mm_srli_epi32(m, 13);
+        __m128i const nan = _mm_or_si128(inf, _mm_or_si128(m13, _mm_and_si128(_mm_cmpeq_epi32(m13, zero), _mm_set1_epi32(1))));
+        __m128i const isNaN = _mm_andnot_si128(_mm_cmpeq_epi32(m, zero), _mm_cmpeq_epi32(e, _mm_set1_epi32(255)));
+        return select(isNaN, nan, result);
+    }
+
+    void halfSSE2(const RowConversion& conv, const uchar* src, uchar* dst, size_t count)
+    {
+        size_t const n = count * conv.srcSize;
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            __m128i const h0 = floatToHalf(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4)));
+            __m128i const h1 = floatToHalf(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4 + 16)));
+            // sign extend so the signed saturating pack keeps all 16 bits
+            __m128i const packed = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(h0, 16), 16),
+                                                   _mm_srai_epi32(_mm_slli_epi32(h1, 16), 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), packed);
+        }
+        RowConversion tail = conv;
+        tail.srcSize = 1;
+        halfScalar(tail, src + i * 4, dst + i * 2, n - i);
+    }
+    //---------------------------------------------------------------------
+    [[gnu::target("avx2")]]
+    inline auto select(__m256i mask, __m256i a, __m256i b) -> __m256i
+    {
+        return _mm256_blendv_epi8(b, a, mask);
+    }
+
+    [[gnu::target("avx2")]]
+    inline auto floatToHalf(__m256i i) -> __m256i
+    {
+        __m256i const zero = _mm256_setzero_si256();
+        __m256i const s = _mm256_and_si256(_mm256_srli_epi32(i, 16), _mm256_set1_epi32(0x8000));
+        __m256i const magnitude = _mm256_and_si256(i, _mm256_set1_epi32(0x7fffffff));
+        __m256i const e = _mm256_srli_epi32(magnitude, 23);
+        __m256i const m = _mm256_and_si256(i, _mm256_set1_epi32(0x007fffff));
+        __m256i const inf = _mm256_or_si256(s, _mm256_set1_epi32(0x7c00));
+
+        __m256i result = _mm256_or_si256(s, _mm256_sub_epi32(_mm256_srli_epi32(magnitude, 13), _mm256_set1_epi32(112 << 10)));
+        __m256i const denormal = _mm256_or_si256(s, _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_castsi256_ps(magnitude), _mm256_set1_ps(16777216.0f))));
+        result = select(_mm256_cmpgt_epi32(_mm256_set1_epi32(113), e), denormal, result);
+        result = select(_mm256_cmpgt_epi32(_mm256_set1_epi32(102), e), zero, result);
+        result = select(_mm256_cmpgt_epi32(e, _mm256_set1_epi32(142)), inf, result);
+        __m256i const m13 = _mm256_srli_epi32(m, 13);
+        __m256i const nan = _mm256_or_si256(inf, _mm256_or_si256(m13, _mm256_and_si256(_mm256_cmpeq_epi32(m13, zero), _mm256_set1_epi32(1))));
+        __m256i const isNaN = _mm256_andnot_si256(_mm256_cmpeq_epi32(m, zero), _mm256_cmpeq_epi32(e, _mm256_set1_epi32(255)));
+        return select(isNaN, nan, result);
+    }
+
+    [[gnu::target("avx2")]]
+    void halfAVX2(const RowConversion& conv, const uchar* src, uchar* dst, size_t count)
+    {
+        size_t const n = count * conv.srcSize;
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m256i const h0 = floatToHalf(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4)));
+            __m256i const h1 = floatToHalf(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4 + 32)));
+            // the pack interleaves the lanes, put them back in order
+            __m256i const packed = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_slli_epi32(h0, 16), 16),
+                                                      _mm256_srai_epi32(_mm256_slli_epi32(h1, 16), 16));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2), _mm256_permute4x64_epi64(packed, 0xD8));
+        }
+        RowConversion tail = conv;
+        tail.srcSize = 1;
+        halfSSE2(tail, src + i * 4, dst + i * 2, n - i);
+    }
+    //---------------------------------------------------------------------
+    template<RowFunction Scalar, RowFunction SSSE3, RowFunction AVX2>
+    auto selectRowFunction() -> RowFunction
+    {
+        if (PlatformInformation::hasCpuFeature(PlatformInformation::CpuFeatures::AVX2))
+            return AVX2;
+        if (PlatformInformation::hasCpuFeature(PlatformInformation::CpuFeatures::SSSE3))
+            return SSSE3;
+        return Scalar;
+    }
+    //---------------------------------------------------------------------
+    auto selectConversion(PixelFormat srcFormat, PixelFormat dstFormat, RowConversion& conv) -> bool
+    {
+        using enum PixelFormat;
+        if (PixelUtil::getComponentType(srcFormat) == PixelComponentType::FLOAT32 &&
+            PixelUtil::getComponentType(dstFormat) == PixelComponentType::FLOAT16)
+        {
+            // all pairs with the same channels convert element by element
+            if (!((srcFormat == FLOAT32_R && dstFormat == FLOAT16_R) || (srcFormat == FLOAT32_GR && dstFormat == FLOAT16_GR) ||
+                  (srcFormat == FLOAT32_RGB && dstFormat == FLOAT16_RGB) || (srcFormat == FLOAT32_RGBA && dstFormat == FLOAT16_RGBA)))
+                return false;
+            static RowFunction const half = PlatformInformation::hasCpuFeature(PlatformInformation::CpuFeatures::AVX2)
+                ? &halfAVX2 : &halfSSE2;
+            conv.function = half;
+            conv.srcSize = PixelUtil::getComponentCount(srcFormat);
+            return true;
+        }
+
+        ByteLayout src, dst;
+        if (!getByteLayout(srcFormat, src))
+            return false;
+        conv.srcSize = src.size;
+        conv.pixelsPerLoad = src.size == 3 ? 4 : 16 / src.size;
+
+        bool const floatOutput = dstFormat == FLOAT32_RGBA;
+        if (floatOutput)
+        {
+            for (int c = 0; c < 4; ++c)
+                conv.source[c] = src.channel[c];
+        }
+        else
+        {
+            if (!getByteLayout(dstFormat, dst) || dst.size != 4 || dst.channel[3] < 0 ||
+                (PixelUtil::getFlags(dstFormat) & PixelFormatFlags::LUMINANCE) != PixelFormatFlags{})
+                return false;
+            for (int c = 0; c < 4; ++c)
+                conv.source[dst.channel[c]] = src.channel[c];
+        }
+
+        // only alpha can be missing, which unpackColour treats as opaque
+        for (int j = 0; j < 4; ++j)
+            conv.constant[j] = conv.source[j] < 0 ? 255 : 0;
+
+        memset(conv.masks, Zero, sizeof(conv.masks));
+        if (floatOutput)
+        {
+            for (size_t r = 0; r < conv.pixelsPerLoad; ++r)
+                for (int c = 0; c < 4; ++c)
+                    if (conv.source[c] >= 0)
+                        conv.masks[r][4 * c] = static_cast<char>(r * src.size + conv.source[c]);
+            for (int c = 0; c < 4; ++c)
+                conv.fillInts[c] = conv.constant[c];
+
+            static RowFunction const gather = selectRowFunction<&gatherFloatsScalar, &gatherFloatsSSSE3, &gatherFloatsAVX2>();
+            conv.function = gather;
+        }
+        else
+        {
+            for (size_t r = 0; r < conv.pixelsPerLoad / 4; ++r)
+                for (size_t p = 0; p < 4; ++p)
+                    for (int j = 0; j < 4; ++j)
+                        if (conv.source[j] >= 0)
+                            conv.masks[r][4 * p + j] = static_cast<char>((4 * r + p) * src.size + conv.source[j]);
+            for (size_t i = 0; i < 16; ++i)
+                conv.fillBytes[i] = conv.constant[i % 4];
+
+            static RowFunction const gather = selectRowFunction<&gatherBytesScalar, &gatherBytesSSSE3, &gatherBytesAVX2>();
+            conv.function = gather;
+        }
+        return true;
+    }
+}
+}
+//-----------------------------------------------------------------------
+auto doVectorisedConversion(const Ogre::PixelBox &src, const Ogre::PixelBox &dst) -> bool
+{
+    using namespace Ogre;
+    RowConversion conv;
+    if (!selectConversion(src.format, dst.format, conv))
+        return false;
+
+    size_t const srcPixelSize = PixelUtil::getNumElemBytes(src.format);
+    size_t const dstPixelSize = PixelUtil::getNumElemBytes(dst.format);
+    const uchar* srcptr = src.getTopLeftFrontPixelPtr();
+    uchar* dstptr = dst.getTopLeftFrontPixelPtr();
+    size_t const width = src.getWidth();
+    for (size_t z = 0; z < src.getDepth(); ++z)
+    {
+        for (size_t y = 0; y < src.getHeight(); ++y)
+        {
+            conv.function(conv, srcptr + (z * src.slicePitch + y * src.rowPitch) * srcPixelSize,
+                          dstptr + (z * dst.slicePitch + y * dst.rowPitch) * dstPixelSize, width);
+        }
+    }
+    return true;
+}
@@ -449,6 +449,15 @@ struct X8B8G8R8toR8G8B8A8: public PixelConverter <Ogre::uint32, Ogre::uint32, FM
     }
 };
 
+/** Convert with SIMD kernels chosen for the running CPU.
+    @remarks
+        Covers swizzles between the 8 bit RGBA orders, expansion of 24 bit RGB, L8 and L8A8 to
+        them, 8 bit to FLOAT32_RGBA and float32 to float16 with the same channels. Results
+        are identical to unpackColour followed by packColour.
+    @return false if the pair is not covered
+*/
+auto doVectorisedConversion(const Ogre::PixelBox &src, const Ogre::PixelBox &dst) -> bool;
+
 #define CASECONVERTER(type) case type::ID : PixelBoxConverter<type>::conversion(src, dst); return 1;
 inline auto doOptimizedConversion(const Ogre::PixelBox &src, const Ogre::PixelBox &dst) -> int
 {;
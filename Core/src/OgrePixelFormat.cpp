@@ -34,6 +34,7 @@ module Ogre.Core;
 
 import :AlignedAllocator;
 import :Bitwise;
+import :BlockDecompression;
 import :Exception;
 import :Math;
 import :PixelConversions;
@@ -159,9 +160,11 @@ namespace Ogre {
                 // https://www.khronos.org/registry/OpenGL/extensions/OES/OES_compressed_ETC1_RGB8_texture.txt
                 case ETC1_RGB8:
                 case ETC2_RGB8:
-                case ETC2_RGBA8:
                 case ETC2_RGB8A1:
-                    return ((width + 3) / 4) * ((height + 3) / 4) * 8;
+                    return ((width + 3) / 4) * ((height + 3) / 4) * 8 * depth;
+                // the EAC alpha block doubles the size
+                case ETC2_RGBA8:
+                    return ((width + 3) / 4) * ((height + 3) / 4) * 16 * depth;
 
                 case ATC_RGB:
                     return ((width + 3) / 4) * ((height + 3) / 4) * 8;
@@ -692,10 +695,16 @@ namespace Ogre {
     {
         OgreAssert(src.getSize() == dst.getSize(), "");
 
-        // Check for compressed formats, we don't support decompression, compression or recoding
+        // Check for compressed formats, we only support decompressing whole levels
         if(PixelUtil::isCompressed(src.format) || PixelUtil::isCompressed(dst.format))
         {
-            if(src.format == dst.format && src.isConsecutive() && dst.isConsecutive())
+            if(!PixelUtil::isCompressed(dst.format) && BlockDecompressor::isSupported(src.format) &&
+               src.left == 0 && src.top == 0 && src.front == 0)
+            {
+                BlockDecompressor::decompress(src, dst);
+                return;
+            }
+            else if(src.format == dst.format && src.isConsecutive() && dst.isConsecutive())
             {
                 // we can copy with slice granularity, useful for Tex2DArray handling
                 size_t bytesPerSlice = getMemorySize(src.getWidth(), src.getHeight(), 1, src.format);
@@ -707,7 +716,7 @@ namespace Ogre {
             else
             {
                 OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED,
-                    "This method can not be used to compress or decompress images",
+                    "This method can not be used to compress or recode images",
                     "PixelUtil::bulkPixelConversion");
             }
         }
@@ -775,6 +784,10 @@ namespace Ogre {
             return;
         }
 
+        // Is there a vectorised conversion?
+        if(doVectorisedConversion(src, dst))
+            return;
+
         // Is there a specialized, inlined, conversion?
         if(doOptimizedConversion(src, dst))
         {
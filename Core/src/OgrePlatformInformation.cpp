@@ -68,12 +68,12 @@ namespace Ogre {
     }
 
     //---------------------------------------------------------------------
-    // Performs CPUID instruction with 'query', fill the results, and return value of eax.
+    // Performs CPUID instruction with 'query' (sub-leaf 0), fill the results, and return value of eax.
     static auto _performCpuid(int query, CpuidResult& result) -> uint
     {
         __asm__
         (
-            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query)
+            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query), "c" (0)
         );
         return result._eax;
     }
@@ -86,6 +86,20 @@ namespace Ogre {
         return true;
     }
 
+    //---------------------------------------------------------------------
+    // Detect whether or not os saves the AVX register state, requires OSXSAVE.
+
+    static auto _checkOperatingSystemSupportAVX() -> bool
+    {
+        uint eax, edx;
+        __asm__
+        (
+            "xgetbv": "=a" (eax), "=d" (edx) : "c" (0)
+        );
+        // XMM and YMM state enabled
+        return (eax & 0x6) == 0x6;
+    }
+
     //---------------------------------------------------------------------
     // Compiler-independent routines
     //---------------------------------------------------------------------
@@ -98,6 +112,7 @@ namespace Ogre {
 #define CPUID_FUNC_EXTENSION_QUERY           0x80000000
 #define CPUID_FUNC_EXTENDED_FEATURES         0x80000001
 #define CPUID_FUNC_ADVANCED_POWER_MANAGEMENT 0x80000007
+#define CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES 0x7
 
 #define CPUID_STD_FPU               (1<<0)
 #define CPUID_STD_TSC               (1<<4)
@@ -110,6 +125,11 @@ namespace Ogre {
 #define CPUID_STD_SSE3              (1<<0)      // ECX[0]  - Bit 0 of standard function 1 indicate SSE3 supported
 #define CPUID_STD_SSE41             (1<<19)     // ECX[19] - Bit 0 of standard function 1 indicate SSE41 supported
 #define CPUID_STD_SSE42             (1<<20)     // ECX[20] - Bit 0 of standard function 1 indicate SSE42 supported
+#define CPUID_STD_SSSE3             (1<<9)      // ECX[9]  - Bit 9 of standard function 1 indicate SSSE3 supported
+#define CPUID_STD_OSXSAVE           (1<<27)     // ECX[27] - Bit 27 of standard function 1 indicate XGETBV is enabled by the os
+#define CPUID_STD_AVX               (1<<28)     // ECX[28] - Bit 28 of standard function 1 indicate AVX supported
+
+#define CPUID_SEF_AVX2              (1<<5)      // EBX[5]  - Bit 5 of structured extended function 7 indicate AVX2 supported
 
 #define CPUID_FAMILY_ID_MASK        0x0F00      // EAX[11:8] - Bit 11 thru 8 contains family  processor id
 #define CPUID_EXT_FAMILY_ID_MASK    0x0F00000   // EAX[23:20] - Bit 23 thru 20 contains extended family processor id
@@ -130,7 +150,7 @@ namespace Ogre {
             CpuidResult result;
 
             // Has standard feature ?
-            if (_performCpuid(CPUID_FUNC_VENDOR_ID, result))
+            if (const uint maxStandardFunctionSupport = _performCpuid(CPUID_FUNC_VENDOR_ID, result))
             {
                 // Check vendor strings
                 if (memcmp(&result._ebx, "GenuineIntel", 12) == 0)
@@ -226,6 +246,22 @@ namespace Ogre {
                             features |= PlatformInformation::CpuFeatures::INVARIANT_TSC;
                     }
                 }
+
+                // Vendor independent features
+                _performCpuid(CPUID_FUNC_STANDARD_FEATURES, result);
+
+                if (result._ecx & CPUID_STD_SSSE3)
+                    features |= PlatformInformation::CpuFeatures::SSSE3;
+
+                if ((result._ecx & CPUID_STD_OSXSAVE) && (result._ecx & CPUID_STD_AVX) &&
+                    maxStandardFunctionSupport >= CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES &&
+                    _checkOperatingSystemSupportAVX())
+                {
+                    _performCpuid(CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES, result);
+
+                    if (result._ebx & CPUID_SEF_AVX2)
+                        features |= PlatformInformation::CpuFeatures::AVX2;
+                }
             }
         }
 
@@ -240,6 +276,7 @@ namespace Ogre {
                 PlatformInformation::CpuFeatures::SSE
             | PlatformInformation::CpuFeatures::SSE2
             | PlatformInformation::CpuFeatures::SSE3
+            | PlatformInformation::CpuFeatures::SSSE3
             | PlatformInformation::CpuFeatures::SSE41
             | PlatformInformation::CpuFeatures::SSE42;
 
@@ -359,10 +396,14 @@ namespace Ogre {
                 ::std::format(" *         SSE2: {}", hasCpuFeature(CpuFeatures::SSE2)));
             pLog->logMessage(
                 ::std::format(" *         SSE3: {}", hasCpuFeature(CpuFeatures::SSE3)));
+            pLog->logMessage(
+                ::std::format(" *        SSSE3: {}", hasCpuFeature(CpuFeatures::SSSE3)));
             pLog->logMessage(
                 ::std::format(" *        SSE41: {}", hasCpuFeature(CpuFeatures::SSE41)));
             pLog->logMessage(
                 ::std::format(" *        SSE42: {}", hasCpuFeature(CpuFeatures::SSE42)));
+            pLog->logMessage(
+                ::std::format(" *         AVX2: {}", hasCpuFeature(CpuFeatures::AVX2)));
             pLog->logMessage(
                 ::std::format(" *          MMX: {}", hasCpuFeature(CpuFeatures::MMX)));
             pLog->logMessage(
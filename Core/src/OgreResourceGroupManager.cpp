@@ -38,6 +38,7 @@ import :DataStream;
 import :Exception;
 import :Log;
 import :LogManager;
+import :ParallelFor;
 import :Platform;
 import :Prerequisites;
 import :Resource;
@@ -49,6 +50,9 @@ import :Singleton;
 import :String;
 import :StringVector;
 
+import <algorithm>;
+import <any>;
+import <exception>;
 import <format>;
 import <iterator>;
 import <list>;
@@ -56,6 +60,7 @@ import <map>;
 import <memory>;
 import <ostream>;
 import <ranges>;
+import <span>;
 import <string>;
 import <utility>;
 import <vector>;
@@ -784,6 +789,12 @@ namespace Ogre {
         // Fire scripting event
         fireResourceGroupScriptingStarted(grp->name, scriptCount);
 
+        if (mParallelScriptParsing && scriptCount > 1)
+        {
+            parseResourceGroupScriptsParallel(grp, scriptLoaderFileList);
+            return;
+        }
+
         // Iterate over scripts and parse
         // Note we respect original ordering
         for (auto const& [su, item] : scriptLoaderFileList)
@@ -808,7 +819,7 @@ namespace Ogre {
                         if (mLoadingListener)
                             mLoadingListener->resourceStreamOpened(fii.filename, grp->name, nullptr, stream);
 
-                        if(fii.archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024)
+                        if(fii.archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024 && !stream->getSharedData())
                         {
                             DataStreamPtr cachedCopy(new MemoryDataStream(stream->getName(), stream));
                             su->parseScript(cachedCopy, grp->name);
@@ -826,6 +837,94 @@ namespace Ogre {
             ::std::format("Finished parsing scripts for resource group {}", grp->name));
     }
     //-----------------------------------------------------------------------
+    void ResourceGroupManager::parseResourceGroupScriptsParallel(
+        ResourceGroup* grp, const std::vector<std::pair<ScriptLoader*, FileInfoList>>& scriptLoaderFileList) const
+    {
+        struct ScriptJob
+        {
+            ScriptLoader* loader;
+            const FileInfo* info;
+            DataStreamPtr stream;
+            std::any preparsed;
+            std::exception_ptr error;
+        };
+        std::vector<ScriptJob> jobs;
+        for (auto const& [su, item] : scriptLoaderFileList)
+            for (auto & fii : item)
+                jobs.push_back({su, &fii});
+
+        // Streams are opened per batch, so that large groups do not hold a file
+        // descriptor and the preparsed form of every script at the same time
+        TaskPool& pool = TaskPool::get();
+        size_t const batchSize = pool.getConcurrency() * 4;
+        std::vector<ScriptJob*> preparseJobs;
+        for (size_t batchBegin = 0; batchBegin < jobs.size(); batchBegin += batchSize)
+        {
+            auto const batch = std::span{jobs}.subspan(batchBegin, std::min(batchSize, jobs.size() - batchBegin));
+
+            // archives and the loading listener are not thread-safe, so open the streams here
+            preparseJobs.clear();
+            for (auto& job : batch)
+            {
+                job.stream = job.info->archive->open(job.info->filename);
+                if (job.stream && mLoadingListener)
+                    mLoadingListener->resourceStreamOpened(job.info->filename, grp->name, nullptr, job.stream);
+
+                if (job.stream && job.loader->supportsPreparse())
+                    preparseJobs.push_back(&job);
+            }
+
+            pool.run(static_cast<uint32>(preparseJobs.size()), [&](uint32 i)
+            {
+                ScriptJob& job = *preparseJobs[i];
+                try
+                {
+                    job.preparsed = job.loader->preparseScript(job.stream);
+                }
+                catch (...)
+                {
+                    job.error = std::current_exception();
+                }
+            });
+
+            // translate on this thread in the original order
+            for (auto& job : batch)
+            {
+                const String& filename = job.info->filename;
+                bool skipScript = false;
+                fireScriptStarted(filename, skipScript);
+                if(skipScript)
+                {
+                    LogManager::getSingleton().logMessage(
+                        ::std::format("Skipping script {}", filename));
+                }
+                else
+                {
+                    LogManager::getSingleton().logMessage(
+                        ::std::format("Parsing script {}", filename));
+                    if (job.error)
+                        std::rethrow_exception(job.error);
+
+                    if (job.stream)
+                    {
+                        if (job.loader->supportsPreparse())
+                            job.loader->translateScript(job.preparsed, job.stream, grp->name);
+                        else
+                            job.loader->parseScript(job.stream, grp->name);
+                    }
+                }
+                fireScriptEnded(filename, skipScript);
+
+                job.stream.reset();
+                job.preparsed.reset();
+            }
+        }
+
+        fireResourceGroupScriptingEnded(grp->name);
+        LogManager::getSingleton().logMessage(
+            ::std::format("Finished parsing scripts for resource group {}", grp->name));
+    }
+    //-----------------------------------------------------------------------
     void ResourceGroupManager::createDeclaredResources(ResourceGroup* grp)
     {
 
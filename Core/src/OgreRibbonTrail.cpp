@@ -369,7 +369,8 @@ namespace Ogre
             }
         } // end while
 
-
+        // the head moved, so this segment needs new vertices
+        mChainSegmentList[index].dirty = true;
         mBoundsDirty = true;
         // Need to dirty the parent node, but can't do it using needUpdate() here 
         // since we're in the middle of the scene graph update (node listener), 
@@ -389,7 +390,8 @@ namespace Ogre
             ChainSegment& seg = mChainSegmentList[s];
             if (seg.head != SEGMENT_EMPTY && seg.head != seg.tail)
             {
-                
+                seg.dirty = true;
+
                 for(size_t e = seg.head + 1;; ++e) // until break
                 {
                     e = e % mMaxElementsPerChain;
@@ -405,7 +407,6 @@ namespace Ogre
                 }
             }
         }
-        mVertexContentDirty = true;
     }
     //-----------------------------------------------------------------------
     void RibbonTrail::resetTrail(size_t index, const Node* node)
@@ -59,6 +59,7 @@ import :FileSystemLayer;
 import :FrameListener;
 import :GpuProgramManager;
 import :HardwareBufferManager;
+import :KTX2Codec;
 import :Light;
 import :LodStrategyManager;
 import :LogManager;
@@ -67,6 +68,7 @@ import :MaterialManager;
 import :Math;
 import :MeshManager;
 import :MovableObject;
+import :Pack;
 import :ParticleSystemManager;
 import :Platform;
 import :PlatformInformation;
@@ -198,11 +200,14 @@ namespace Ogre {
         ArchiveManager::getSingleton().addArchiveFactory( mZipArchiveFactory.get() );
         mEmbeddedZipArchiveFactory = std::make_unique<EmbeddedZipArchiveFactory>();
         ArchiveManager::getSingleton().addArchiveFactory( mEmbeddedZipArchiveFactory.get() );
+        mPackArchiveFactory = std::make_unique<PackArchiveFactory>();
+        ArchiveManager::getSingleton().addArchiveFactory( mPackArchiveFactory.get() );
 
         // Register image codecs
         DDSCodec::startup();
         ETCCodec::startup();
         ASTCCodec::startup();
+        KTX2Codec::startup();
 
         mGpuProgramManager = std::make_unique<GpuProgramManager>();
         mExternalTextureSourceManager = std::make_unique<ExternalTextureSourceManager>();
@@ -251,6 +256,7 @@ namespace Ogre {
         DDSCodec::shutdown();
         ETCCodec::shutdown();
         ASTCCodec::shutdown();
+        KTX2Codec::shutdown();
 
 		mCompositorManager.reset(); // needs rendersystem
         mParticleManager.reset(); // may use plugins
@@ -650,8 +656,12 @@ namespace Ogre {
         }
 
         // Tell buffer manager to free temp buffers used this frame
+        // and to retire the oldest streamed frame
         if (HardwareBufferManager::getSingletonPtr())
+        {
             HardwareBufferManager::getSingleton()._releaseBufferCopies();
+            HardwareBufferManager::getSingleton()._notifyStreamingFrameEnded();
+        }
 
         // Tell the queue to process responses
         mWorkQueue->processResponses();
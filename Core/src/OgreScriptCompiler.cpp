@@ -34,6 +34,7 @@ module Ogre.Core;
 
 import :BuiltinScriptTranslators;
 import :DataStream;
+import :Exception;
 import :LogManager;
 import :Platform;
 import :Prerequisites;
@@ -48,6 +49,7 @@ import :String;
 import :StringVector;
 
 import <algorithm>;
+import <any>;
 import <format>;
 import <list>;
 import <map>;
@@ -295,6 +297,12 @@ namespace Ogre
     }
 
     auto ScriptCompiler::compile(const ConcreteNodeListPtr &nodes, std::string_view group) -> bool
+    {
+        beginCompile(group);
+        return translate(process(nodes));
+    }
+
+    void ScriptCompiler::beginCompile(std::string_view group)
     {
         // Set up the compilation context
         mGroup = group;
@@ -305,6 +313,11 @@ namespace Ogre
         // Clear the environment
         mEnv.clear();
 
+        mImportedScripts.clear();
+    }
+
+    auto ScriptCompiler::process(const ConcreteNodeListPtr &nodes) -> AbstractNodeListPtr
+    {
         if(mListener)
             mListener->preConversion(this, nodes);
 
@@ -317,6 +330,11 @@ namespace Ogre
         // Process variable expansion
         processVariables(*ast);
 
+        return ast;
+    }
+
+    auto ScriptCompiler::translate(const AbstractNodeListPtr &ast) -> bool
+    {
         // Allows early bail-out through the listener
         if(mListener && !mListener->postConversion(this, ast))
             return mErrors.empty();
@@ -485,7 +503,9 @@ namespace Ogre
             if (!stream)
                 return retval;
 
-            nodes = ScriptParser::parse(ScriptLexer::tokenize(stream->getAsString(), name), name);
+            String content = stream->getAsString();
+            mImportedScripts.emplace_back(name, ScriptCompilerCache::hash(content));
+            nodes = ScriptParser::parse(ScriptLexer::tokenize(content, name), name);
         }
 
         if(nodes)
@@ -1558,14 +1578,127 @@ namespace Ogre
         return 90.0f;
     }
     //-----------------------------------------------------------------------
+    void ScriptCompilerManager::setCompiledScriptCache(std::string_view filename)
+    {
+        mCacheFile = filename;
+        mCache.reset();
+        mCacheHits = 0;
+        if (mCacheFile.empty())
+            return;
+
+        mCache = std::make_unique<ScriptCompilerCache>();
+        if (!mCache->load(mCacheFile))
+            LogManager::getSingleton().logMessage(
+                ::std::format("ScriptCompilerManager - starting new compiled script cache '{}'", mCacheFile));
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::saveCompiledScriptCache()
+    {
+        if (mCache && mCache->isDirty())
+            mCache->save(mCacheFile);
+    }
+    //-----------------------------------------------------------------------
     void ScriptCompilerManager::parseScript(DataStreamPtr& stream, std::string_view groupName)
     {
-        ConcreteNodeListPtr nodes =
-            ScriptParser::parse(ScriptLexer::tokenize(stream->getAsString(), stream->getName()), stream->getName());
+        std::any preparsed = preparseScript(stream);
+        translateScript(preparsed, stream, groupName);
+    }
+    //-----------------------------------------------------------------------
+    namespace
+    {
+        /// Result of ScriptCompilerManager::preparseScript
+        struct PreparsedScript
+        {
+            ConcreteNodeListPtr nodes;
+            /// lexer errors are logged on the main thread, LogManager is not thread-safe
+            String lexerError;
+
+            /// whether the processed AST is to be added to the compiled script cache
+            bool cacheable{false};
+            ScriptCompilerCache::Hash key;
+            /// the AST restored from the compiled script cache instead of nodes
+            ScriptCompilerCache::Tree cached;
+            /// kept on a cache hit in case an import changed
+            String content;
+        };
+    }
+    //-----------------------------------------------------------------------
+    auto ScriptCompilerManager::preparseScript(const DataStreamPtr& stream) -> std::any
+    {
+        // the concrete nodes refer to the stream name, which outlives them
+        std::string_view const name = stream->getName();
+        PreparsedScript result;
+        String content = stream->getAsString();
+
+        if (mCache && !mScriptCompiler.getListener())
+        {
+            result.cacheable = true;
+            result.key = ScriptCompilerCache::makeKey(content, name);
+            if (const auto* entry = mCache->find(result.key))
+            {
+                try
+                {
+                    result.cached = ScriptCompilerCache::deserialise(*entry, mScriptCompiler.mIds);
+                    result.content = std::move(content);
+                    return result;
+                }
+                catch (const Exception&)
+                {
+                    // damaged entry, compile from source and replace it
+                }
+            }
+        }
+
+        ScriptTokenList tokens = ScriptLexer::_tokenize(content, name.data(), result.lexerError);
+        result.nodes = ScriptParser::parse(tokens, name);
+        return result;
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::translateScript(std::any& preparsed, DataStreamPtr& stream, std::string_view groupName)
+    {
+        auto& script = std::any_cast<PreparsedScript&>(preparsed);
+
+        if (script.cached.nodes)
+        {
+            // the imports are resolved in the group being loaded, so they can only be checked now
+            bool upToDate = true;
+            for (auto const& [name, hash] : script.cached.imports)
+            {
+                auto importStream = ResourceGroupManager::getSingleton().openResource(name, groupName, nullptr, false);
+                if (!importStream || ScriptCompilerCache::hash(importStream->getAsString()) != hash)
+                {
+                    upToDate = false;
+                    break;
+                }
+            }
+
+            if (upToDate)
+            {
+                ++mCacheHits;
+                mScriptCompiler.beginCompile(groupName);
+                mScriptCompiler.translate(script.cached.nodes);
+                return;
+            }
+
+            script.cached = {};
+            ScriptTokenList tokens = ScriptLexer::_tokenize(script.content, stream->getName().data(), script.lexerError);
+            script.nodes = ScriptParser::parse(tokens, stream->getName());
+        }
+
+        if (!script.lexerError.empty())
+            LogManager::getSingleton().logError(::std::format("ScriptLexer - {}", script.lexerError));
+
+        // compile is not reentrant
+        mScriptCompiler.beginCompile(groupName);
+        AbstractNodeListPtr ast = mScriptCompiler.process(script.nodes);
+
+        if (script.cacheable && mCache && script.lexerError.empty() && mScriptCompiler.mErrors.empty())
         {
-            // compile is not reentrant
-            mScriptCompiler.compile(nodes, groupName);
+            mCache->insert(script.key,
+                           {String{stream->getName()}, mScriptCompiler.mImportedScripts, ScriptCompilerCache::serialise(*ast)});
         }
+
+        mScriptCompiler.translate(ast);
     }
 
     //-------------------------------------------------------------------------
@@ -0,0 +1,464 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstddef>
+#include <cstring>
+
+module Ogre.Core;
+
+import :Exception;
+import :MurmurHash3;
+import :Platform;
+import :Prerequisites;
+import :ScriptCompiler;
+import :SharedPtr;
+
+import <filesystem>;
+import <format>;
+import <fstream>;
+import <iterator>;
+import <map>;
+import <memory>;
+import <string>;
+import <string_view>;
+import <unordered_map>;
+import <utility>;
+import <vector>;
+
+namespace Ogre {
+namespace {
+    /** Layout of a compiled script cache file, all in native byte order:
+        char[8]             : CACHE_MAGIC
+        uint32              : CACHE_VERSION
+        uint32              : COMPILER_VERSION
+        uint32              : entry count
+        entries             : key, name, imports, serialised AST
+
+    Strings are stored as a uint32 length followed by the characters. The serialised AST starts
+    with a table of all strings it uses, which the nodes then refer to by index.
+    */
+    auto constexpr CACHE_MAGIC = std::string_view{"OGRESCC\0", 8};
+    /// Bump whenever the file layout or the AST processing changes
+    uint32 constexpr CACHE_VERSION = 1;
+    uint32 constexpr COMPILER_VERSION =
+        (/*OGRE_VERSION_MAJOR*/13 << 16) | (/*OGRE_VERSION_MINOR*/3 << 8) | /*OGRE_VERSION_PATCH*/3;
+
+    struct Writer
+    {
+        std::vector<uchar>& out;
+
+        template<typename T>
+        void write(T value)
+        {
+            auto const* bytes = reinterpret_cast<const uchar*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        void writeString(std::string_view str)
+        {
+            write(uint32(str.size()));
+            out.insert(out.end(), str.begin(), str.end());
+        }
+    };
+
+    struct Reader
+    {
+        const uchar* pos;
+        const uchar* end;
+
+        void require(size_t size) const
+        {
+            if (size_t(end - pos) < size)
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "truncated compiled script data", "ScriptCompilerCache");
+        }
+
+        template<typename T>
+        auto read() -> T
+        {
+            require(sizeof(T));
+            T value;
+            memcpy(&value, pos, sizeof(T));
+            pos += sizeof(T);
+            return value;
+        }
+
+        auto readString() -> String
+        {
+            auto size = read<uint32>();
+            require(size);
+            String str{reinterpret_cast<const char*>(pos), size};
+            pos += size;
+            return str;
+        }
+
+        auto readBytes() -> std::vector<uchar>
+        {
+            auto size = read<uint64>();
+            require(size);
+            std::vector<uchar> bytes{pos, pos + size};
+            pos += size;
+            return bytes;
+        }
+    };
+
+    class TreeWriter
+    {
+        std::unordered_map<std::string_view, uint32> mStringIndex;
+        std::vector<std::string_view> mStrings;
+        std::vector<uchar> mNodes;
+        Writer mOut{mNodes};
+
+        void writeIndex(std::string_view str)
+        {
+            auto [it, inserted] = mStringIndex.try_emplace(str, uint32(mStrings.size()));
+            if (inserted)
+                mStrings.push_back(str);
+            mOut.write(it->second);
+        }
+
+        void writeNode(const AbstractNode& node)
+        {
+            mOut.write(uint8(node.type));
+            writeIndex(node.file);
+            mOut.write(uint32(node.line));
+
+            switch (node.type)
+            {
+            using enum AbstractNodeType;
+            case ATOM:
+                writeIndex(static_cast<const AtomAbstractNode&>(node).value);
+                break;
+            case OBJECT:
+            {
+                auto const& obj = static_cast<const ObjectAbstractNode&>(node);
+                writeIndex(obj.name);
+                writeIndex(obj.cls);
+                mOut.write(uint8(obj.abstract));
+                mOut.write(uint32(obj.bases.size()));
+                for (auto base : obj.bases)
+                    writeIndex(base);
+                mOut.write(uint32(obj.getVariables().size()));
+                for (auto const& [name, value] : obj.getVariables())
+                {
+                    writeIndex(name);
+                    writeIndex(value);
+                }
+                // overrides were merged into the children by processObjects
+                writeList(obj.children);
+                writeList(obj.values);
+                break;
+            }
+            case PROPERTY:
+            {
+                auto const& prop = static_cast<const PropertyAbstractNode&>(node);
+                writeIndex(prop.name);
+                writeList(prop.values);
+                break;
+            }
+            case IMPORT:
+            {
+                auto const& import = static_cast<const ImportAbstractNode&>(node);
+                writeIndex(import.target);
+                writeIndex(import.source);
+                break;
+            }
+            case VARIABLE_ACCESS:
+                writeIndex(static_cast<const VariableAccessAbstractNode&>(node).name);
+                break;
+            default:
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "unsupported abstract node type", "ScriptCompilerCache::serialise");
+            }
+        }
+
+    public:
+        void writeList(const AbstractNodeList& nodes)
+        {
+            mOut.write(uint32(nodes.size()));
+            for (auto const& node : nodes)
+                writeNode(*node);
+        }
+
+        auto finish() -> std::vector<uchar>
+        {
+            std::vector<uchar> data;
+            Writer out{data};
+            out.write(uint32(mStrings.size()));
+            for (auto str : mStrings)
+                out.writeString(str);
+            data.insert(data.end(), mNodes.begin(), mNodes.end());
+            return data;
+        }
+    };
+
+    class TreeReader
+    {
+        Reader mIn;
+        const ScriptCompiler::IdMap& mIds;
+        const std::vector<String>& mStrings;
+
+        auto readIndex() -> const String&
+        {
+            auto index = mIn.read<uint32>();
+            if (index >= mStrings.size())
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "invalid string index in compiled script data",
+                    "ScriptCompilerCache::deserialise");
+            return mStrings[index];
+        }
+
+        auto lookupId(std::string_view word) const -> uint32
+        {
+            auto it = mIds.find(word);
+            return it != mIds.end() ? it->second : 0;
+        }
+
+        auto readNode(AbstractNode* parent) -> AbstractNodePtr
+        {
+            auto type = AbstractNodeType(mIn.read<uint8>());
+            const String& file = readIndex();
+            auto line = mIn.read<uint32>();
+
+            AbstractNodePtr node;
+            switch (type)
+            {
+            using enum AbstractNodeType;
+            case ATOM:
+            {
+                auto* atom = new AtomAbstractNode(parent);
+                node.reset(atom);
+                atom->value = readIndex();
+                atom->id = lookupId(atom->value);
+                break;
+            }
+            case OBJECT:
+            {
+                auto* obj = new ObjectAbstractNode(parent);
+                node.reset(obj);
+                obj->name = readIndex();
+                obj->cls = readIndex();
+                obj->id = lookupId(obj->cls);
+                obj->abstract = mIn.read<uint8>() != 0;
+                for (auto count = mIn.read<uint32>(); count > 0; --count)
+                    obj->bases.emplace_back(readIndex());
+                for (auto count = mIn.read<uint32>(); count > 0; --count)
+                {
+                    const String& name = readIndex();
+                    obj->setVariable(name, readIndex());
+                }
+                readList(obj->children, obj);
+                readList(obj->values, obj);
+                break;
+            }
+            case PROPERTY:
+            {
+                auto* prop = new PropertyAbstractNode(parent);
+                node.reset(prop);
+                prop->name = readIndex();
+                prop->id = lookupId(prop->name);
+                readList(prop->values, prop);
+                break;
+            }
+            case IMPORT:
+            {
+                auto* import = new ImportAbstractNode();
+                node.reset(import);
+                import->target = readIndex();
+                import->source = readIndex();
+                break;
+            }
+            case VARIABLE_ACCESS:
+            {
+                auto* var = new VariableAccessAbstractNode(parent);
+                node.reset(var);
+                var->name = readIndex();
+                break;
+            }
+            default:
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "invalid node type in compiled script data",
+                    "ScriptCompilerCache::deserialise");
+            }
+
+            node->file = file;
+            node->line = line;
+            return node;
+        }
+
+    public:
+        TreeReader(Reader in, const ScriptCompiler::IdMap& ids, const std::vector<String>& strings)
+            : mIn{in}, mIds{ids}, mStrings{strings}
+        {}
+
+        void readList(AbstractNodeList& nodes, AbstractNode* parent)
+        {
+            for (auto count = mIn.read<uint32>(); count > 0; --count)
+                nodes.push_back(readNode(parent));
+        }
+    };
+}
+    //-----------------------------------------------------------------------
+    auto ScriptCompilerCache::hash(std::string_view content) -> Hash
+    {
+        uint64 out[2];
+        MurmurHash3_128(content.data(), content.size(), 0, out);
+        return {out[0], out[1]};
+    }
+    //-----------------------------------------------------------------------
+    auto ScriptCompilerCache::makeKey(std::string_view content, std::string_view name) -> Hash
+    {
+        Hash nameHash = hash(name);
+        uint64 out[2];
+        MurmurHash3_128(content.data(), content.size(), uint32(nameHash.first), out);
+        return {out[0] ^ nameHash.second, out[1]};
+    }
+    //-----------------------------------------------------------------------
+    auto ScriptCompilerCache::find(const Hash& key) const -> const Entry*
+    {
+        auto it = mEntries.find(key);
+        return it != mEntries.end() ? &it->second : nullptr;
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerCache::insert(const Hash& key, Entry entry)
+    {
+        auto [it, inserted] = mKeysByName.try_emplace(entry.name, key);
+        if (!inserted)
+        {
+            // an older version of the script is not going to be hit again
+            mEntries.erase(it->second);
+            it->second = key;
+        }
+        mEntries.insert_or_assign(key, std::move(entry));
+        mDirty = true;
+    }
+    //-----------------------------------------------------------------------
+    auto ScriptCompilerCache::load(std::string_view filename) -> bool
+    {
+        mEntries.clear();
+        mKeysByName.clear();
+        mDirty = false;
+
+        std::ifstream in{std::filesystem::path{filename}, std::ios::binary};
+        if (!in)
+            return false;
+        std::vector<uchar> data{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+
+        try
+        {
+            Reader reader{data.data(), data.data() + data.size()};
+            reader.require(CACHE_MAGIC.size());
+            if (CACHE_MAGIC != std::string_view{reinterpret_cast<const char*>(reader.pos), CACHE_MAGIC.size()})
+                return false;
+            reader.pos += CACHE_MAGIC.size();
+            if (reader.read<uint32>() != CACHE_VERSION || reader.read<uint32>() != COMPILER_VERSION)
+                return false;
+
+            for (auto count = reader.read<uint32>(); count > 0; --count)
+            {
+                Hash key;
+                key.first = reader.read<uint64>();
+                key.second = reader.read<uint64>();
+
+                Entry entry;
+                entry.name = reader.readString();
+                for (auto imports = reader.read<uint32>(); imports > 0; --imports)
+                {
+                    Import& import = entry.imports.emplace_back();
+                    import.first = reader.readString();
+                    import.second.first = reader.read<uint64>();
+                    import.second.second = reader.read<uint64>();
+                }
+                entry.data = reader.readBytes();
+
+                mKeysByName.insert_or_assign(entry.name, key);
+                mEntries.insert_or_assign(key, std::move(entry));
+            }
+        }
+        catch (const Exception&)
+        {
+            mEntries.clear();
+            mKeysByName.clear();
+            return false;
+        }
+
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerCache::save(std::string_view filename)
+    {
+        std::vector<uchar> data;
+        Writer out{data};
+        data.insert(data.end(), CACHE_MAGIC.begin(), CACHE_MAGIC.end());
+        out.write(CACHE_VERSION);
+        out.write(COMPILER_VERSION);
+        out.write(uint32(mEntries.size()));
+        for (auto const& [key, entry] : mEntries)
+        {
+            out.write(key.first);
+            out.write(key.second);
+            out.writeString(entry.name);
+            out.write(uint32(entry.imports.size()));
+            for (auto const& [name, hash] : entry.imports)
+            {
+                out.writeString(name);
+                out.write(hash.first);
+                out.write(hash.second);
+            }
+            out.write(uint64(entry.data.size()));
+            data.insert(data.end(), entry.data.begin(), entry.data.end());
+        }
+
+        std::ofstream file{std::filesystem::path{filename}, std::ios::binary | std::ios::trunc};
+        file.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+        if (!file)
+        {
+            OGRE_EXCEPT(ExceptionCodes::CANNOT_WRITE_TO_FILE, ::std::format("Failed writing {}", filename),
+                "ScriptCompilerCache::save");
+        }
+        mDirty = false;
+    }
+    //-----------------------------------------------------------------------
+    auto ScriptCompilerCache::serialise(const AbstractNodeList& nodes) -> std::vector<uchar>
+    {
+        TreeWriter writer;
+        writer.writeList(nodes);
+        return writer.finish();
+    }
+    //-----------------------------------------------------------------------
+    auto ScriptCompilerCache::deserialise(const Entry& entry, const ScriptCompiler::IdMap& ids) -> Tree
+    {
+        Tree tree{AbstractNodeListPtr{new AbstractNodeList}, entry.imports,
+                  SharedPtr<std::vector<String>>{new std::vector<String>}};
+
+        Reader in{entry.data.data(), entry.data.data() + entry.data.size()};
+        for (auto count = in.read<uint32>(); count > 0; --count)
+            tree.strings->push_back(in.readString());
+
+        TreeReader reader{in, ids, *tree.strings};
+        reader.readList(*tree.nodes, nullptr);
+        return tree;
+    }
+}
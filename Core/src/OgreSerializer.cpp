@@ -271,35 +271,33 @@ namespace Ogre {
     //---------------------------------------------------------------------
     void Serializer::readFloats(const DataStreamPtr& stream, float* pDest, size_t count)
     {
-        stream->read(pDest, sizeof(float) * count);
-        flipFromLittleEndian(pDest, sizeof(float), count);
+        readArray(stream, pDest, count);
     }
     //---------------------------------------------------------------------
     void Serializer::readFloats(const DataStreamPtr& stream, double* pDest, size_t count)
     {
-        // Read from float, convert to double
-        auto* tmp = new float[count];
-        float* ptmp = tmp;
-        stream->read(tmp, sizeof(float) * count);
-        flipFromLittleEndian(tmp, sizeof(float), count);
-        // Convert to doubles (no cast required)
-        while(count--)
+        // Read the floats into the upper half of the destination and widen them
+        // front to back, each double only overwrites floats that were already converted
+        auto* bytes = reinterpret_cast<uchar*>(pDest);
+        uchar* floats = bytes + sizeof(float) * count;
+        readArray(stream, reinterpret_cast<float*>(floats), count);
+        for (size_t i = 0; i < count; ++i)
         {
-            *pDest++ = *ptmp++;
+            float value;
+            memcpy(&value, floats + i * sizeof(float), sizeof(float));
+            double const widened = value;
+            memcpy(bytes + i * sizeof(double), &widened, sizeof(double));
         }
-        delete[] tmp;
     }
     //---------------------------------------------------------------------
     void Serializer::readShorts(const DataStreamPtr& stream, unsigned short* pDest, size_t count)
     {
-        stream->read(pDest, sizeof(unsigned short) * count);
-        flipFromLittleEndian(pDest, sizeof(unsigned short), count);
+        readArray(stream, pDest, count);
     }
     //---------------------------------------------------------------------
     void Serializer::readInts(const DataStreamPtr& stream, uint32* pDest, size_t count)
     {
-        stream->read(pDest, sizeof(uint32) * count);
-        flipFromLittleEndian(pDest, sizeof(uint32), count);
+        readArray(stream, pDest, count);
     }
     //---------------------------------------------------------------------
     auto Serializer::readString(const DataStreamPtr& stream, size_t numChars) -> String
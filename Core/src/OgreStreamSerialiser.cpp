@@ -53,6 +53,7 @@ import :Vector;
 
 import <format>;
 import <string>;
+import <type_traits>;
 
 namespace Ogre
 {
@@ -486,28 +487,42 @@ namespace Ogre
 
     }
     //---------------------------------------------------------------------
+    // The vector, quaternion and Matrix3 types are tightly packed arrays of
+    // Real, so a whole array of them goes out in a single write.
     void StreamSerialiser::write(const Vector2* vec, size_t count)
     {
-        for (size_t i = 0; i < count; ++i, ++vec)
-            write(vec->ptr(), 2);
+        if constexpr (sizeof(Vector2) == 2 * sizeof(Real))
+            write(vec->ptr(), 2 * count);
+        else
+            for (size_t i = 0; i < count; ++i, ++vec)
+                write(vec->ptr(), 2);
     }
     //---------------------------------------------------------------------
     void StreamSerialiser::write(const Vector3* vec, size_t count)
     {
-        for (size_t i = 0; i < count; ++i, ++vec)
-            write(vec->ptr(), 3);
+        if constexpr (sizeof(Vector3) == 3 * sizeof(Real))
+            write(vec->ptr(), 3 * count);
+        else
+            for (size_t i = 0; i < count; ++i, ++vec)
+                write(vec->ptr(), 3);
     }
     //---------------------------------------------------------------------
     void StreamSerialiser::write(const Vector4* vec, size_t count)
     {
-        for (size_t i = 0; i < count; ++i, ++vec)
-            write(vec->ptr(), 4);
+        if constexpr (sizeof(Vector4) == 4 * sizeof(Real))
+            write(vec->ptr(), 4 * count);
+        else
+            for (size_t i = 0; i < count; ++i, ++vec)
+                write(vec->ptr(), 4);
     }
     //---------------------------------------------------------------------
     void StreamSerialiser::write(const Quaternion* q, size_t count)
     {
-        for (size_t i = 0; i < count; ++i, ++q)
-            write(q->ptr(), 4);
+        if constexpr (sizeof(Quaternion) == 4 * sizeof(Real))
+            write(q->ptr(), 4 * count);
+        else
+            for (size_t i = 0; i < count; ++i, ++q)
+                write(q->ptr(), 4);
     }
     //---------------------------------------------------------------------
     void StreamSerialiser::write(const String* string)
@@ -520,8 +535,8 @@ namespace Ogre
     //---------------------------------------------------------------------
     void StreamSerialiser::write(const Matrix3* m, size_t count)
     {
-        for (size_t i = 0; i < count; ++i, ++m)
-            write((*m)[0], 9);
+        static_assert(sizeof(Matrix3) == 9 * sizeof(Real) && ::std::is_standard_layout_v<Matrix3>);
+        write(reinterpret_cast<const Real*>(m), 9 * count);
     }
     //---------------------------------------------------------------------
     void StreamSerialiser::write(const Matrix4* m, size_t count)
@@ -618,44 +633,48 @@ namespace Ogre
 
     }
     //---------------------------------------------------------------------
+    // As with writing, arrays of the packed math types are read and
+    // endian-swapped in one go.
     void StreamSerialiser::read(Vector2* vec, size_t count)
     {
-        for (size_t i = 0; i < count; ++i, ++vec)
-        {
-            read(vec->ptr(), 2);
-        }
+        if constexpr (sizeof(Vector2) == 2 * sizeof(Real))
+            read(vec->ptr(), 2 * count);
+        else
+            for (size_t i = 0; i < count; ++i, ++vec)
+                read(vec->ptr(), 2);
     }
     //---------------------------------------------------------------------
     void StreamSerialiser::read(Vector3* vec, size_t count)
     {
-        for (size_t i = 0; i < count; ++i, ++vec)
-        {
-            read(vec->ptr(), 3);
-        }
+        if constexpr (sizeof(Vector3) == 3 * sizeof(Real))
+            read(vec->ptr(), 3 * count);
+        else
+            for (size_t i = 0; i < count; ++i, ++vec)
+                read(vec->ptr(), 3);
     }
     //---------------------------------------------------------------------
     void StreamSerialiser::read(Vector4* vec, size_t count)
     {
-        for (size_t i = 0; i < count; ++i, ++vec)
-        {
-            read(vec->ptr(), 4);
-        }
+        if constexpr (sizeof(Vector4) == 4 * sizeof(Real))
+            read(vec->ptr(), 4 * count);
+        else
+            for (size_t i = 0; i < count; ++i, ++vec)
+                read(vec->ptr(), 4);
     }
     //---------------------------------------------------------------------
     void StreamSerialiser::read(Quaternion* q, size_t count)
     {
-        for (size_t i = 0; i < count; ++i, ++q)
-        {
-            read(q->ptr(), 4);
-        }
+        if constexpr (sizeof(Quaternion) == 4 * sizeof(Real))
+            read(q->ptr(), 4 * count);
+        else
+            for (size_t i = 0; i < count; ++i, ++q)
+                read(q->ptr(), 4);
     }
     //---------------------------------------------------------------------
     void StreamSerialiser::read(Matrix3* m, size_t count)
     {
-        for (size_t i = 0; i < count; ++i, ++m)
-        {
-            read((*m)[0], 9);
-        }
+        static_assert(sizeof(Matrix3) == 9 * sizeof(Real) && ::std::is_standard_layout_v<Matrix3>);
+        read(reinterpret_cast<Real*>(m), 9 * count);
     }
     //---------------------------------------------------------------------
     void StreamSerialiser::read(Matrix4* m, size_t count)
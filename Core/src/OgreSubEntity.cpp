@@ -28,23 +28,31 @@ THE SOFTWARE.
 module;
 
 #include <cassert>
+#include <cstring>
 
 module Ogre.Core;
 
 import :AnimationTrack;
 import :Camera;
 import :Entity;
+import :HardwareBuffer;
+import :HardwareIndexBuffer;
 import :HardwareVertexBuffer;
 import :LogManager;
 import :Material;
 import :MaterialManager;
 import :Math;
+import :Matrix3;
 import :Matrix4;
 import :Mesh;
 import :Node;
+import :Pass;
 import :RenderOperation;
+import :SceneManager;
+import :Sphere;
 import :SubEntity;
 import :SubMesh;
+import :Technique;
 import :Vector;
 import :VertexIndexData;
 
@@ -140,6 +148,114 @@ namespace Ogre {
             op.indexData->indexStart = mIndexStart;
             op.indexData->indexCount = mIndexEnd;
         }
+        else if (mMeshletsCulled)
+        {
+            op.indexData = mCulledIndexData.get();
+        }
+    }
+    //-----------------------------------------------------------------------
+    void SubEntity::_cullMeshlets(const Camera* cam)
+    {
+        mMeshletsCulled = false;
+
+        const SubMesh::MeshletList& meshlets = mSubMesh->meshlets;
+        if (meshlets.empty() || !mParentEntity->getMeshletCullingEnabled() ||
+            mParentEntity->mMeshLodIndex != 0 || mIndexStart != mIndexEnd ||
+            mParentEntity->hasSkeleton() || mParentEntity->hasVertexAnimation())
+            return;
+
+        const IndexData* source = mSubMesh->indexData.get();
+        const HardwareIndexBufferSharedPtr& ibuf = source->indexBuffer;
+        size_t indexSize = ibuf->getIndexSize();
+
+        // Keep a system memory copy so culling never reads back from the GPU
+        if (mMeshletSourceIndices.size() != ibuf->getSizeInBytes() ||
+            mMeshletSourceGeneration != mSubMesh->_getIndexGeneration())
+        {
+            mMeshletSourceGeneration = mSubMesh->_getIndexGeneration();
+            mMeshletSourceIndices.resize(ibuf->getSizeInBytes());
+            ibuf->readData(0, mMeshletSourceIndices.size(), mMeshletSourceIndices.data());
+        }
+
+        const Affine3& xform = mParentEntity->_getParentNodeFullTransform();
+        Matrix3 linear = xform.linear();
+        Real scaleX = linear.GetColumn(0).length();
+        Real scaleY = linear.GetColumn(1).length();
+        Real scaleZ = linear.GetColumn(2).length();
+        Real maxScale = std::max({scaleX, scaleY, scaleZ});
+
+        // The normal cone only says something about back faces if they are really culled
+        bool coneCulling = !cam->isReflected() && !linear.hasNegativeScale() &&
+            Math::RealEqual(scaleX, scaleY, maxScale * 1e-3f) && Math::RealEqual(scaleX, scaleZ, maxScale * 1e-3f) &&
+            cam->getSceneManager()->_getCurrentRenderStage() != SceneManager::IlluminationRenderStage::RENDER_TO_TEXTURE;
+        if (coneCulling)
+        {
+            for (const Pass* pass : getTechnique()->getPasses())
+            {
+                if (pass->getCullingMode() != CullingMode::CLOCKWISE)
+                {
+                    coneCulling = false;
+                    break;
+                }
+            }
+        }
+
+        const Vector3& camPos = cam->getDerivedPosition();
+        size_t visibleIndices = 0;
+        std::vector<const SubMesh::Meshlet*> visible;
+        visible.reserve(meshlets.size());
+        for (const auto& meshlet : meshlets)
+        {
+            Vector3 center = xform * meshlet.center;
+            Real radius = meshlet.radius * maxScale;
+            if (!cam->isVisible(Sphere{center, radius}))
+                continue;
+
+            if (coneCulling && meshlet.coneCutoff < 1)
+            {
+                Vector3 axis = (linear * meshlet.coneAxis).normalisedCopy();
+                Vector3 toCenter = center - camPos;
+                if (toCenter.dotProduct(axis) >= meshlet.coneCutoff * toCenter.length() + radius)
+                    continue;
+            }
+
+            visible.push_back(&meshlet);
+            visibleIndices += meshlet.indexCount;
+        }
+
+        // Nothing gained, draw the SubMesh indices as they are
+        if (visibleIndices == source->indexCount)
+            return;
+
+        if (!mCulledIndexData)
+            mCulledIndexData = std::make_unique<IndexData>();
+        mCulledIndexData->indexStart = 0;
+        mCulledIndexData->indexCount = visibleIndices;
+        mMeshletsCulled = true;
+
+        if (visibleIndices == 0)
+            return;
+
+        const HardwareIndexBufferSharedPtr& dest = mCulledIndexData->indexBuffer;
+        if (!dest || dest->getType() != ibuf->getType() || dest->getNumIndexes() < source->indexCount)
+        {
+            mCulledIndexData->indexBuffer = mSubMesh->parent->getHardwareBufferManager()->createIndexBuffer(
+                ibuf->getType(), source->indexCount, HardwareBuffer::Usage::CPU_TO_GPU);
+        }
+
+        HardwareBufferLockGuard indexLock(mCulledIndexData->indexBuffer, 0, visibleIndices * indexSize,
+            HardwareBuffer::LockOptions::DISCARD);
+        auto* pDest = static_cast<uint8*>(indexLock.pData);
+        for (const SubMesh::Meshlet* meshlet : visible)
+        {
+            memcpy(pDest, &mMeshletSourceIndices[meshlet->indexStart * indexSize], meshlet->indexCount * indexSize);
+            pDest += meshlet->indexCount * indexSize;
+        }
+    }
+    //-----------------------------------------------------------------------
+    auto SubEntity::_isMeshletCulledAway() const noexcept -> bool
+    {
+        return mMeshletsCulled && mCulledIndexData->indexCount == 0;
     }
     //-----------------------------------------------------------------------
     void SubEntity::setIndexDataStartIndex(size_t start_index)
@@ -201,11 +317,16 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void SubEntity::getWorldTransforms(Matrix4* xform) const
     {
+        // Quantised positions are decoded by folding the decode matrix into the transforms
+        const Affine3& decode = const_cast<SubEntity*>(this)->getVertexDataForBinding()->positionDecodeMatrix;
+
         if (!mParentEntity->mNumBoneMatrices ||
             !mParentEntity->isHardwareAnimationEnabled())
         {
             // No skeletal animation, or software skinning
             *xform = mParentEntity->_getParentNodeFullTransform();
+            if (decode != Affine3::IDENTITY)
+                *xform = *xform * decode;
         }
         else
         {
@@ -213,6 +334,7 @@ namespace Ogre {
             const Mesh::IndexMap& indexMap = mSubMesh->useSharedVertices ?
                 mSubMesh->parent->sharedBlendIndexToBoneIndexMap : mSubMesh->blendIndexToBoneIndexMap;
             assert(indexMap.size() <= mParentEntity->mNumBoneMatrices);
+            Matrix4* first = xform;
 
             if (mParentEntity->_isSkeletonAnimated())
             {
@@ -230,6 +352,12 @@ namespace Ogre {
                 // All animations disabled, use parent entity world transform only
                 std::ranges::fill(std::span{xform, indexMap.size()}, mParentEntity->_getParentNodeFullTransform());
             }
+
+            if (decode != Affine3::IDENTITY)
+            {
+                for (Matrix4& m : std::span{first, indexMap.size()})
+                    m = m * decode;
+            }
         }
     }
     //-----------------------------------------------------------------------
@@ -27,6 +27,7 @@ THE SOFTWARE.
 */
 module;
 
+#include <cmath>
 #include <cstddef>
 
 module Ogre.Core;
@@ -50,6 +51,8 @@ import :Vector;
 import :VertexBoneAssignment;
 import :VertexIndexData;
 
+import <algorithm>;
+import <limits>;
 import <map>;
 import <memory>;
 import <set>;
@@ -365,6 +368,232 @@ namespace Ogre {
         vbuf->unlock ();
     }
     //---------------------------------------------------------------------
+    void SubMesh::buildMeshlets(size_t maxVertices, size_t maxTriangles)
+    {
+        OgreAssert(maxVertices >= 3 && maxTriangles >= 1, "a meshlet must hold at least one triangle");
+        meshlets.clear();
+
+        if (operationType != RenderOperation::OperationType::TRIANGLE_LIST || !indexData->indexBuffer)
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                "Meshlets can only be built for indexed triangle lists",
+                "SubMesh::buildMeshlets");
+        }
+
+        VertexData *vert = useSharedVertices ? parent->sharedVertexData : vertexData.get();
+        const VertexElement *poselem =
+            vert->vertexDeclaration->findElementBySemantic(VertexElementSemantic::POSITION);
+        if (!poselem || poselem->getType() != VertexElementType::FLOAT3)
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                "Meshlets require FLOAT3 vertex positions",
+                "SubMesh::buildMeshlets");
+        }
+
+        size_t triCount = indexData->indexCount / 3;
+        if (triCount == 0)
+            return;
+
+        // Gather positions and triangles
+        std::vector<Vector3> positions(vert->vertexCount);
+        {
+            HardwareVertexBufferSharedPtr vbuf = vert->vertexBufferBinding->getBuffer(poselem->getSource());
+            HardwareBufferLockGuard vertexLock(vbuf, HardwareBuffer::LockOptions::READ_ONLY);
+            auto *vdata = static_cast<uint8 *>(vertexLock.pData) + vert->vertexStart * vbuf->getVertexSize();
+            for (auto & position : positions)
+            {
+                float *v;
+                poselem->baseVertexPointerToElement(vdata, &v);
+                position = Vector3{v[0], v[1], v[2]};
+                vdata += vbuf->getVertexSize();
+            }
+        }
+
+        const HardwareIndexBufferSharedPtr& ibuf = indexData->indexBuffer;
+        bool use32bit = ibuf->getType() == HardwareIndexBuffer::IndexType::_32BIT;
+        std::vector<uint32> indices(triCount * 3);
+        {
+            HardwareBufferLockGuard indexLock(ibuf, HardwareBuffer::LockOptions::READ_ONLY);
+            if (use32bit)
+                std::copy_n(static_cast<const uint32 *>(indexLock.pData) + indexData->indexStart,
+                    indices.size(), indices.begin());
+            else
+                std::copy_n(static_cast<const uint16 *>(indexLock.pData) + indexData->indexStart,
+                    indices.size(), indices.begin());
+        }
+        if (std::ranges::any_of(indices, [&](uint32 i) { return i >= positions.size(); }))
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                "Index out of range of the vertex data",
+                "SubMesh::buildMeshlets");
+        }
+
+        // Vertex to triangle adjacency
+        std::vector<uint32> adjacencyOffsets(positions.size() + 1, 0);
+        for (uint32 i : indices)
+            ++adjacencyOffsets[i + 1];
+        for (size_t v = 0; v < positions.size(); ++v)
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        std::vector<uint32> adjacency(indices.size());
+        {
+            std::vector<uint32> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); ++i)
+                adjacency[fill[indices[i]]++] = static_cast<uint32>(i / 3);
+        }
+
+        std::vector<bool> triAssigned(triCount, false);
+        // Last meshlet each vertex was added to, to count new vertices quickly
+        std::vector<size_t> vertexMeshlet(positions.size(), size_t(-1));
+        std::vector<uint32> meshletVertices;
+        std::vector<uint32> meshletTriangles;
+        std::vector<uint32> newIndices;
+        newIndices.reserve(indices.size());
+        size_t seed = 0;
+
+        auto newVertexCount = [&](uint32 tri, size_t id) -> size_t
+        {
+            return size_t(vertexMeshlet[indices[tri * 3 + 0]] != id) +
+                   size_t(vertexMeshlet[indices[tri * 3 + 1]] != id) +
+                   size_t(vertexMeshlet[indices[tri * 3 + 2]] != id);
+        };
+
+        while (true)
+        {
+            while (seed < triCount && triAssigned[seed])
+                ++seed;
+            if (seed == triCount)
+                break;
+
+            size_t id = meshlets.size();
+            meshletVertices.clear();
+            meshletTriangles.clear();
+            Vector3 vertexSum = Vector3::ZERO;
+
+            auto addTriangle = [&](uint32 tri)
+            {
+                triAssigned[tri] = true;
+                meshletTriangles.push_back(tri);
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    uint32 v = indices[tri * 3 + k];
+                    if (vertexMeshlet[v] != id)
+                    {
+                        vertexMeshlet[v] = id;
+                        meshletVertices.push_back(v);
+                        vertexSum += positions[v];
+                    }
+                }
+            };
+
+            addTriangle(static_cast<uint32>(seed));
+
+            // Grow the cluster through shared vertices, preferring triangles adding the fewest
+            // vertices and then the ones closest to the cluster centre to keep it compact
+            while (meshletTriangles.size() < maxTriangles)
+            {
+                Vector3 centroid = vertexSum / Real(meshletVertices.size());
+                uint32 best = static_cast<uint32>(triCount);
+                size_t bestNew = 4;
+                Real bestDistance = 0;
+                for (uint32 v : meshletVertices)
+                {
+                    for (uint32 a = adjacencyOffsets[v]; a < adjacencyOffsets[v + 1]; ++a)
+                    {
+                        uint32 tri = adjacency[a];
+                        if (triAssigned[tri])
+                            continue;
+                        size_t added = newVertexCount(tri, id);
+                        if (added > bestNew)
+                            continue;
+                        Real distance = ((positions[indices[tri * 3 + 0]] + positions[indices[tri * 3 + 1]] +
+                            positions[indices[tri * 3 + 2]]) / 3 - centroid).squaredLength();
+                        if (added < bestNew || distance < bestDistance)
+                        {
+                            best = tri;
+                            bestNew = added;
+                            bestDistance = distance;
+                        }
+                    }
+                }
+                if (best == triCount || meshletVertices.size() + bestNew > maxVertices)
+                    break;
+                addTriangle(best);
+            }
+
+            // Bounding sphere around the cluster box centre
+            Vector3 vmin = positions[meshletVertices[0]];
+            Vector3 vmax = vmin;
+            for (uint32 v : meshletVertices)
+            {
+                vmin.makeFloor(positions[v]);
+                vmax.makeCeil(positions[v]);
+            }
+            Vector3 center = (vmin + vmax) * 0.5f;
+            Real radius = 0;
+            for (uint32 v : meshletVertices)
+                radius = std::max(radius, (positions[v] - center).length());
+
+            // Normal cone from the unit face normals
+            std::vector<Vector3> normals;
+            normals.reserve(meshletTriangles.size());
+            Vector3 axis = Vector3::ZERO;
+            for (uint32 tri : meshletTriangles)
+            {
+                const Vector3& p0 = positions[indices[tri * 3 + 0]];
+                Vector3 n = (positions[indices[tri * 3 + 1]] - p0).crossProduct(positions[indices[tri * 3 + 2]] - p0);
+                Real len = n.length();
+                if (len <= std::numeric_limits<Real>::min())
+                    continue;
+                normals.push_back(n / len);
+                axis += normals.back();
+            }
+            Real cutoff = 1;
+            Real axisLength = axis.length();
+            if (!normals.empty() && axisLength > 1e-6f)
+            {
+                axis /= axisLength;
+                Real minDot = 1;
+                for (const auto& n : normals)
+                    minDot = std::min(minDot, n.dotProduct(axis));
+                // Wider than ~84 degrees the cone never rejects anything useful
+                if (minDot > 0.1f)
+                    cutoff = std::sqrt(1 - minDot * minDot);
+            }
+            else
+            {
+                axis = Vector3::UNIT_Z;
+            }
+
+            meshlets.push_back({
+                static_cast<uint32>(indexData->indexStart + newIndices.size()),
+                static_cast<uint32>(meshletTriangles.size() * 3),
+                center, radius, axis, cutoff});
+
+            for (uint32 tri : meshletTriangles)
+                newIndices.insert(newIndices.end(), &indices[tri * 3], &indices[tri * 3] + 3);
+        }
+
+        // Write the triangles back in meshlet order
+        if (use32bit)
+        {
+            ibuf->writeData(indexData->indexStart * sizeof(uint32), newIndices.size() * sizeof(uint32),
+                newIndices.data());
+        }
+        else
+        {
+            std::vector<uint16> indices16(newIndices.begin(), newIndices.end());
+            ibuf->writeData(indexData->indexStart * sizeof(uint16), indices16.size() * sizeof(uint16),
+                indices16.data());
+        }
+        _notifyIndicesChanged();
+
+        if (parent && parent->isEdgeListBuilt())
+        {
+            parent->freeEdgeList();
+            parent->buildEdgeList();
+        }
+    }
+    //---------------------------------------------------------------------
     void SubMesh::setBuildEdgesEnabled(bool b)
     {
         mBuildEdgesEnabled = b;
@@ -390,6 +619,7 @@ namespace Ogre {
         newSub->operationType = this->operationType;
         newSub->useSharedVertices = this->useSharedVertices;
         newSub->extremityPoints = this->extremityPoints;
+        newSub->meshlets = this->meshlets;
 
         if (!this->useSharedVertices)
         {
@@ -32,12 +32,17 @@ module;
 module Ogre.Core;
 
 import :Bitwise;
+import :BlockDecompression;
+import :Codec;
 import :Common;
+import :DataStream;
 import :Exception;
 import :HardwarePixelBuffer;
 import :Image;
+import :ImageCodec;
 import :Log;
 import :LogManager;
+import :ParallelFor;
 import :RenderSystem;
 import :RenderSystemCapabilities;
 import :ResourceGroupManager;
@@ -49,9 +54,52 @@ import :TextureManager;
 
 import <algorithm>;
 import <atomic>;
+import <exception>;
 import <memory>;
+import <mutex>;
+import <vector>;
 
 namespace Ogre {
+namespace {
+    // whether the active render system can sample the compressed format as is
+    auto isSampleable(PixelFormat format) -> bool
+    {
+        auto* root = Root::getSingletonPtr();
+        if (!root || !root->getRenderSystem())
+            return false;
+
+        const RenderSystemCapabilities* caps = root->getRenderSystem()->getCapabilities();
+        using enum PixelFormat;
+        switch (format)
+        {
+        case DXT1:
+        case DXT2:
+        case DXT3:
+        case DXT4:
+        case DXT5:
+            return caps->hasCapability(Capabilities::TEXTURE_COMPRESSION_DXT);
+        case BC4_UNORM:
+        case BC4_SNORM:
+        case BC5_UNORM:
+        case BC5_SNORM:
+            return caps->hasCapability(Capabilities::TEXTURE_COMPRESSION_BC4_BC5);
+        case BC6H_UF16:
+        case BC6H_SF16:
+        case BC7_UNORM:
+            return caps->hasCapability(Capabilities::TEXTURE_COMPRESSION_BC6H_BC7);
+        case ETC1_RGB8:
+            // ETC2 decoders read ETC1 data
+            return caps->hasCapability(Capabilities::TEXTURE_COMPRESSION_ETC1) ||
+                   caps->hasCapability(Capabilities::TEXTURE_COMPRESSION_ETC2);
+        case ETC2_RGB8:
+        case ETC2_RGBA8:
+        case ETC2_RGB8A1:
+            return caps->hasCapability(Capabilities::TEXTURE_COMPRESSION_ETC2);
+        default:
+            return caps->hasCapability(Capabilities::TEXTURE_COMPRESSION_ASTC);
+        }
+    }
+}
     const char* Texture::CUBEMAP_SUFFIXES[] = {"_rt", "_lf", "_up", "_dn", "_fr", "_bk"};
     //--------------------------------------------------------------------------
     Texture::Texture(ResourceManager* creator, std::string_view name, 
@@ -168,41 +216,13 @@ namespace Ogre {
     {
         OgreAssert(!images.empty(), "Cannot load empty vector of images");
 
-        // Set desired texture size and properties from images[0]
-        mSrcWidth = mWidth = images[0]->getWidth();
-        mSrcHeight = mHeight = images[0]->getHeight();
-        mSrcDepth = mDepth = images[0]->getDepth();
-        mSrcFormat = images[0]->getFormat();
-
-        if(!mLayerNames.empty() && mTextureType != TextureType::CUBE_MAP)
-            mDepth = uint32(mLayerNames.size());
-
-        if(mTreatLuminanceAsAlpha && mSrcFormat == PixelFormat::L8)
-            mDesiredFormat = PixelFormat::A8;
-
-        if (mDesiredFormat != PixelFormat::UNKNOWN)
-        {
-            // If have desired format, use it
-            mFormat = mDesiredFormat;
-        }
-        else
-        {
-            // Get the format according with desired bit depth
-            mFormat = PixelUtil::getFormatForBitDepths(mSrcFormat, mDesiredIntegerBitDepth, mDesiredFloatBitDepth);
-        }
-
         // The custom mipmaps in the image clamp the request
         auto imageMips = images[0]->getNumMipmaps();
 
-        if(imageMips > TextureMipmap{})
-        {
-            mNumMipmaps = mNumRequestedMipmaps = std::min(mNumRequestedMipmaps, imageMips);
-            // Disable flag for auto mip generation
-            mUsage &= ~TextureUsage::AUTOMIPMAP;
-        }
+        // Set desired texture size and properties from images[0]
+        setupFromSource(images[0]->getWidth(), images[0]->getHeight(), images[0]->getDepth(),
+                        images[0]->getFormat(), imageMips);
 
-        // Create the texture
-        createInternalResources();
         // Check if we're loading one image with multiple faces
         // or a vector of images representing the faces
         uint32 faces;
@@ -311,6 +331,41 @@ namespace Ogre {
         mSize = getNumFaces() * PixelUtil::getMemorySize(mWidth, mHeight, mDepth, mFormat);
 
     }
+    //--------------------------------------------------------------------------
+    void Texture::setupFromSource(uint32 width, uint32 height, uint32 depth, PixelFormat format, TextureMipmap imageMips)
+    {
+        mSrcWidth = mWidth = width;
+        mSrcHeight = mHeight = height;
+        mSrcDepth = mDepth = depth;
+        mSrcFormat = format;
+
+        if(!mLayerNames.empty() && mTextureType != TextureType::CUBE_MAP)
+            mDepth = uint32(mLayerNames.size());
+
+        if(mTreatLuminanceAsAlpha && mSrcFormat == PixelFormat::L8)
+            mDesiredFormat = PixelFormat::A8;
+
+        if (mDesiredFormat != PixelFormat::UNKNOWN)
+        {
+            // If have desired format, use it
+            mFormat = mDesiredFormat;
+        }
+        else
+        {
+            // Get the format according with desired bit depth
+            mFormat = PixelUtil::getFormatForBitDepths(mSrcFormat, mDesiredIntegerBitDepth, mDesiredFloatBitDepth);
+        }
+
+        if(imageMips > TextureMipmap{})
+        {
+            mNumMipmaps = mNumRequestedMipmaps = std::min(mNumRequestedMipmaps, imageMips);
+            // Disable flag for auto mip generation
+            mUsage &= ~TextureUsage::AUTOMIPMAP;
+        }
+
+        // Create the texture
+        createInternalResources();
+    }
     //-----------------------------------------------------------------------------
     void Texture::createInternalResources()
     {
@@ -424,24 +479,191 @@ namespace Ogre {
     {
     }
 
-    void Texture::readImage(LoadedImages& imgs, std::string_view name, std::string_view ext, bool haveNPOT)
+    void Texture::readImage(Image& img, DataStreamPtr dstream, std::string_view ext, bool haveNPOT)
     {
-        DataStreamPtr dstream = ResourceGroupManager::getSingleton().openResource(name, mGroup, this);
+        TextureCache* cache = TextureManager::getSingleton().getTextureCache();
+        TextureCache::Hash key;
+        PixelFormat compression = PixelFormat::UNKNOWN;
+        if (cache)
+        {
+            compression = cache->getCompressionFormat();
+            if (compression != PixelFormat::UNKNOWN &&
+                !TextureManager::getSingleton().isFormatSupported(mTextureType, compression, mUsage))
+                compression = PixelFormat::UNKNOWN;
+
+            // the key covers everything that changes the image between decoding and upload
+            auto memStream = std::dynamic_pointer_cast<MemoryDataStream>(dstream);
+            if (!memStream)
+                dstream = memStream = std::make_shared<MemoryDataStream>(dstream);
+            auto const options = std::format("{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}", ext, haveNPOT, mSoftwareMipmaps,
+                                             std::to_underlying(mNumRequestedMipmaps), mHwGamma,
+                                             std::to_underlying(compression), std::to_underlying(mDesiredFormat),
+                                             mDesiredIntegerBitDepth, mDesiredFloatBitDepth, mTreatLuminanceAsAlpha,
+                                             TextureManager::getSingleton().getSoftwareDecompression());
+            key = TextureCache::makeKey(memStream->getPtr(), memStream->size(), options);
+            if (cache->find(key, img))
+                return;
+        }
 
-        imgs.push_back(Image());
-        Image& img = imgs.back();
         img.load(dstream, ext);
 
-        if( haveNPOT )
+        // software fallback for formats the render system can not sample
+        if (TextureManager::getSingleton().getSoftwareDecompression() && img.hasFlag(ImageFlags::COMPRESSED) &&
+            BlockDecompressor::isSupported(img.getFormat()) && !isSampleable(img.getFormat()))
+            img.decompress();
+
+        // already in a GPU format, mapping the source is as fast as mapping a copy
+        if (img.hasFlag(ImageFlags::COMPRESSED))
+            cache = nullptr;
+
+        if( !haveNPOT )
+        {
+            // Scale to nearest power of 2
+            uint32 w = Bitwise::firstPO2From(img.getWidth());
+            uint32 h = Bitwise::firstPO2From(img.getHeight());
+            if((img.getWidth() != w) || (img.getHeight() != h))
+                img.resize(w, h);
+        }
+
+        // build the chain here rather than on the render thread, _loadImages then
+        // picks it up as custom mipmaps
+        if (mSoftwareMipmaps && mNumRequestedMipmaps != TextureMipmap{} && img.getNumMipmaps() == TextureMipmap{})
+            img.generateMipmaps(Image::Filter::BOX, mHwGamma);
+
+        if (!cache)
             return;
 
-        // Scale to nearest power of 2
-        uint32 w = Bitwise::firstPO2From(img.getWidth());
-        uint32 h = Bitwise::firstPO2From(img.getHeight());
-        if((img.getWidth() != w) || (img.getHeight() != h))
-            img.resize(w, h);
+        // store the image in the format the texture is created in, as setupFromSource
+        // picks it, a compressed entry could not be converted on upload any more
+        PixelFormat target = mDesiredFormat;
+        if (mTreatLuminanceAsAlpha && img.getFormat() == PixelFormat::L8)
+            target = PixelFormat::A8;
+        if (target == PixelFormat::UNKNOWN)
+            target = PixelUtil::getFormatForBitDepths(img.getFormat(), mDesiredIntegerBitDepth, mDesiredFloatBitDepth);
+
+        if (target != img.getFormat())
+        {
+            if (PixelUtil::isCompressed(target))
+            {
+                try
+                {
+                    img.compress(target);
+                }
+                catch (const Exception&)
+                {
+                    // left to the upload, like without a cache
+                    return;
+                }
+            }
+            else
+            {
+                uint32 const faces = img.getNumFaces();
+                TextureMipmap const numMipmaps = img.getNumMipmaps();
+                auto* buffer = static_cast<uchar*>(malloc(Image::calculateSize(
+                    numMipmaps, faces, img.getWidth(), img.getHeight(), img.getDepth(), target)));
+                // a view of the new buffer gives the offsets of every level
+                Image converted(PixelFormat::UNKNOWN);
+                converted.loadDynamicImage(buffer, img.getWidth(), img.getHeight(), img.getDepth(), target, false,
+                                           faces, numMipmaps);
+                for (uint32 face = 0; face < faces; ++face)
+                    for (uint32 mip = 0; mip <= static_cast<uint32>(numMipmaps); ++mip)
+                    {
+                        auto const level = static_cast<TextureMipmap>(mip);
+                        PixelUtil::bulkPixelConversion(img.getPixelBox(face, level), converted.getPixelBox(face, level));
+                    }
+                img.loadDynamicImage(buffer, img.getWidth(), img.getHeight(), img.getDepth(), target, true, faces,
+                                     numMipmaps);
+            }
+        }
+        // a requested format wins over the compression of the cache
+        else if (mDesiredFormat == PixelFormat::UNKNOWN && compression != PixelFormat::UNKNOWN &&
+                 !PixelUtil::isFloatingPoint(img.getFormat()) &&
+                 PixelUtil::getComponentType(img.getFormat()) == PixelComponentType::BYTE)
+            img.compress(compression);
+
+        try
+        {
+            cache->insert(key, img);
+        }
+        catch (const Exception&)
+        {
+            // an entry that can not be written only costs decoding again next time
+        }
     }
+    //--------------------------------------------------------------------------
+    void Texture::readLayers(LoadedImages& imgs, bool haveNPOT)
+    {
+        auto const count = static_cast<uint32>(mLayerNames.size());
+        // one slot per layer, so the images end up in layer order whichever
+        // worker finishes first
+        imgs.resize(count);
+
+        // the ResourceGroupManager and the archives are not thread safe. Only the
+        // lookup and the read of the encoded bytes are serialised, decoding and
+        // scaling run concurrently. Each worker holds the encoded bytes of a single
+        // layer at a time, so the transient memory is bounded by the thread count.
+        std::mutex openMutex;
+        std::vector<std::exception_ptr> errors(count);
+        parallelForBands(count, 1, [&](uint32 begin, uint32 end)
+        {
+            for (uint32 i = begin; i < end; ++i)
+            {
+                try
+                {
+                    std::string_view baseName, ext;
+                    StringUtil::splitBaseFilename(mLayerNames[i], baseName, ext);
+
+                    DataStreamPtr dstream;
+                    {
+                        std::lock_guard<std::mutex> lock(openMutex);
+                        dstream = std::make_shared<MemoryDataStream>(
+                            ResourceGroupManager::getSingleton().openResource(mLayerNames[i], mGroup, this));
+                    }
+                    readImage(imgs[i], dstream, ext, haveNPOT);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            }
+        });
 
+        auto const failed = std::ranges::count_if(errors, [](auto const& e) { return !!e; });
+        if (failed == 0)
+            return;
+        if (failed == 1)
+            std::rethrow_exception(*std::ranges::find_if(errors, [](auto const& e) { return !!e; }));
+
+        // report every broken layer at once rather than one per load attempt
+        String desc = std::format("{} of {} layers of texture '{}' failed to load:", failed, count, mName);
+        bool allMissing = true;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            if (!errors[i])
+                continue;
+            try
+            {
+                std::rethrow_exception(errors[i]);
+            }
+            catch (const FileNotFoundException& e)
+            {
+                desc += std::format("\n  layer {} '{}': {}", i, mLayerNames[i], e.getDescription());
+            }
+            catch (const Exception& e)
+            {
+                allMissing = false;
+                desc += std::format("\n  layer {} '{}': {}", i, mLayerNames[i], e.getDescription());
+            }
+            catch (const std::exception& e)
+            {
+                allMissing = false;
+                desc += std::format("\n  layer {} '{}': {}", i, mLayerNames[i], e.what());
+            }
+        }
+        OGRE_EXCEPT(allMissing ? ExceptionCodes::FILE_NOT_FOUND : ExceptionCodes::INVALIDPARAMS, desc,
+                    "Texture::readLayers");
+    }
+    //--------------------------------------------------------------------------
     void Texture::prepareImpl()
     {
         if (!!(mUsage & TextureUsage::RENDERTARGET))
@@ -462,7 +684,12 @@ namespace Ogre {
         {
             if(mLayerNames.empty())
             {
-                readImage(loadedImages, mName, ext, haveNPOT);
+                DataStreamPtr dstream = ResourceGroupManager::getSingleton().openResource(mName, mGroup, this);
+                if (prepareStreamedImage(dstream, ext, haveNPOT))
+                    return;
+
+                loadedImages.resize(1);
+                readImage(loadedImages[0], dstream, ext, haveNPOT);
 
                 // If this is a volumetric texture set the texture type flag accordingly.
                 // If this is a cube map, set the texture type flag accordingly.
@@ -475,6 +702,7 @@ namespace Ogre {
         }
         catch(const FileNotFoundException&)
         {
+            loadedImages.clear();
             if(mTextureType == TextureType::CUBE_MAP)
             {
                 mLayerNames.resize(6);
@@ -489,11 +717,8 @@ namespace Ogre {
         }
 
         // read sub-images
-        for(std::string_view name : mLayerNames)
-        {
-            StringUtil::splitBaseFilename(name, baseName, ext);
-            readImage(loadedImages, name, ext, haveNPOT);
-        }
+        if (!mLayerNames.empty())
+            readLayers(loadedImages, haveNPOT);
 
         // If compressed and 0 custom mipmap, disable auto mip generation and
         // disable software mipmap creation.
@@ -510,9 +735,83 @@ namespace Ogre {
         std::swap(mLoadedImages, loadedImages);
     }
 
+    auto Texture::prepareStreamedImage(DataStreamPtr& dstream, std::string_view ext, bool haveNPOT) -> bool
+    {
+        auto& manager = TextureManager::getSingleton();
+        size_t const threshold = manager.getStreamingThreshold();
+        // everything that needs the whole decoded image in memory
+        if (threshold == 0 || ext.empty() || manager.getTextureCache() || mTextureType != TextureType::_2D ||
+            mGamma != 1.0f || (mSoftwareMipmaps && mNumRequestedMipmaps != TextureMipmap{}) ||
+            PixelUtil::isCompressed(mDesiredFormat))
+            return false;
+
+        String type{ext};
+        StringUtil::toLowerCase(type);
+        // unknown types are left to readImage, which reports them
+        if (!Codec::isCodecRegistered(type))
+            return false;
+        auto* codec = dynamic_cast<ImageCodec*>(Codec::getCodec(type));
+        if (!codec)
+            return false;
+
+        // the encoded bytes are kept until loadImpl, read them once
+        if (!std::dynamic_pointer_cast<MemoryDataStream>(dstream))
+            dstream = std::make_shared<MemoryDataStream>(dstream);
+
+        ImageCodec::ImageData header;
+        bool const streamable = codec->decodeHeader(dstream, header);
+        dstream->seek(0);
+        if (!streamable || header.size < threshold || header.depth != 1 ||
+            (!haveNPOT && (!Bitwise::isPO2(header.width) || !Bitwise::isPO2(header.height))))
+            return false;
+
+        mStreamedImage = dstream;
+        mStreamedImageType = type;
+        return true;
+    }
+
+    void Texture::loadStreamedImage(const DataStreamPtr& stream)
+    {
+        auto* codec = static_cast<ImageCodec*>(Codec::getCodec(mStreamedImageType));
+        ImageCodec::ImageData header;
+        bool const streamable = codec->decodeHeader(stream, header);
+        stream->seek(0);
+        OgreAssert(streamable, "The image can no longer be streamed");
+
+        setupFromSource(header.width, header.height, 1, header.format, TextureMipmap{});
+
+        const auto& buffer = getBuffer(0, TextureMipmap{});
+        if (buffer->getWidth() != header.width || buffer->getHeight() != header.height)
+        {
+            // the render system clamped the size, blitFromMemory does the scaling
+            Image img;
+            img.load(stream, mStreamedImageType);
+            buffer->blitFromMemory(img.getPixelBox());
+        }
+        else
+        {
+            // decode straight into the staging memory, converting each row to the texture format
+            const PixelBox& dst = buffer->lock(Box::FromVector3(buffer->getSize()), HardwareBuffer::LockOptions::DISCARD);
+            try
+            {
+                codec->decodeInto(stream, dst);
+            }
+            catch (...)
+            {
+                buffer->unlock();
+                throw;
+            }
+            buffer->unlock();
+        }
+
+        // Update size (the final size, not including temp space)
+        mSize = getNumFaces() * PixelUtil::getMemorySize(mWidth, mHeight, mDepth, mFormat);
+    }
+
     void Texture::unprepareImpl()
     {
         mLoadedImages.clear();
+        mStreamedImage.reset();
     }
 
     void Texture::loadImpl()
@@ -523,6 +822,15 @@ namespace Ogre {
             return;
         }
 
+        if (mStreamedImage)
+        {
+            DataStreamPtr stream;
+            // as below, the only reference is on the stack
+            std::swap(stream, mStreamedImage);
+            loadStreamedImage(stream);
+            return;
+        }
+
         LoadedImages loadedImages;
         // Now the only copy is on the stack and will be cleaned in case of
         // exceptions being thrown from _loadImages
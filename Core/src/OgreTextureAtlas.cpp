@@ -0,0 +1,454 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstring>
+
+module Ogre.Core;
+
+import :Bitwise;
+import :Common;
+import :DataStream;
+import :Exception;
+import :Image;
+import :Material;
+import :Pass;
+import :PixelFormat;
+import :String;
+import :StringConverter;
+import :Technique;
+import :TextureAtlas;
+import :TextureUnitState;
+
+import <algorithm>;
+import <cmath>;
+import <filesystem>;
+import <format>;
+import <fstream>;
+import <limits>;
+import <string>;
+import <utility>;
+import <vector>;
+
+namespace Ogre {
+namespace {
+    // the upper edge of the packed area, as horizontal segments from left to right
+    struct SkylineNode
+    {
+        uint32 x;
+        uint32 y;
+        uint32 width;
+    };
+
+    constexpr uint32 NO_FIT = std::numeric_limits<uint32>::max();
+
+    // the lowest y at which a rectangle of the given width rests when its left edge is at node i
+    auto fitAt(const std::vector<SkylineNode>& skyline, size_t i, uint32 width, uint32 atlasWidth) -> uint32
+    {
+        if (skyline[i].x + width > atlasWidth)
+            return NO_FIT;
+
+        uint32 y = 0;
+        for (size_t j = i; width > 0; ++j)
+        {
+            y = std::max(y, skyline[j].y);
+            width -= std::min(width, skyline[j].width);
+        }
+        return y;
+    }
+
+    void place(std::vector<SkylineNode>& skyline, size_t i, uint32 y, uint32 width, uint32 height)
+    {
+        SkylineNode const node{skyline[i].x, y + height, width};
+        skyline.insert(skyline.begin() + i, node);
+
+        // cut the segments now below the new one
+        uint32 const end = node.x + node.width;
+        for (size_t j = i + 1; j < skyline.size() && skyline[j].x < end;)
+        {
+            uint32 const overlap = end - skyline[j].x;
+            if (overlap < skyline[j].width)
+            {
+                skyline[j].x += overlap;
+                skyline[j].width -= overlap;
+                break;
+            }
+            skyline.erase(skyline.begin() + j);
+        }
+
+        for (size_t j = 0; j + 1 < skyline.size();)
+        {
+            if (skyline[j].y == skyline[j + 1].y)
+            {
+                skyline[j].width += skyline[j + 1].width;
+                skyline.erase(skyline.begin() + j + 1);
+            }
+            else
+                ++j;
+        }
+    }
+
+    struct PackRect
+    {
+        size_t image;
+        uint32 width;
+        uint32 height;
+        uint32 x{0};
+        uint32 y{0};
+    };
+
+    // places rects (sorted tallest first) into width x height with a bottom left skyline
+    auto packSkyline(std::vector<PackRect>& rects, uint32 width, uint32 height) -> bool
+    {
+        std::vector<SkylineNode> skyline{{0, 0, width}};
+        for (auto& rect : rects)
+        {
+            size_t best = skyline.size();
+            uint32 bestTop = NO_FIT;
+            uint32 bestY = 0;
+            for (size_t i = 0; i < skyline.size(); ++i)
+            {
+                uint32 const y = fitAt(skyline, i, rect.width, width);
+                if (y == NO_FIT || y + rect.height > height)
+                    continue;
+                if (y + rect.height < bestTop)
+                {
+                    best = i;
+                    bestTop = y + rect.height;
+                    bestY = y;
+                }
+            }
+            if (best == skyline.size())
+                return false;
+
+            rect.x = skyline[best].x;
+            rect.y = bestY;
+            place(skyline, best, bestY, rect.width, rect.height);
+        }
+        return true;
+    }
+
+    // fills the border of the inner rectangle with copies of its edge pixels
+    void replicateEdges(Image& dest, uint32 left, uint32 top, uint32 width, uint32 height, uint32 padding)
+    {
+        size_t const pixelSize = PixelUtil::getNumElemBytes(dest.getFormat());
+        size_t const rowSize = dest.getWidth() * pixelSize;
+        uchar* const base = dest.getData();
+        auto pixel = [&](uint32 x, uint32 y) { return base + y * rowSize + x * pixelSize; };
+
+        for (uint32 y = top; y < top + height; ++y)
+        {
+            for (uint32 x = left - padding; x < left; ++x)
+                memcpy(pixel(x, y), pixel(left, y), pixelSize);
+            for (uint32 x = left + width; x < left + width + padding; ++x)
+                memcpy(pixel(x, y), pixel(left + width - 1, y), pixelSize);
+        }
+
+        size_t const span = (width + 2 * padding) * pixelSize;
+        for (uint32 y = top - padding; y < top; ++y)
+            memcpy(pixel(left - padding, y), pixel(left - padding, top), span);
+        for (uint32 y = top + height; y < top + height + padding; ++y)
+            memcpy(pixel(left - padding, y), pixel(left - padding, top + height - 1), span);
+    }
+
+    // the texture units whose texture can be replaced by one packed as packedType
+    // effects recalculate the texture matrix every frame, dropping the atlas transform, or generate
+    // coordinates outside the packed image. Wrapping and mirroring would sample the neighbours of an
+    // atlas image, arrays keep them within the layer.
+    auto isPackable(const TextureUnitState* tus, TextureType packedType) -> bool
+    {
+        if (tus->getContentType() != TextureUnitState::ContentType::NAMED || tus->getNumFrames() != 1 ||
+            tus->getTextureType() != TextureType::_2D || tus->getTextureName().empty() || !tus->getEffects().empty())
+            return false;
+
+        const auto& mode = tus->getTextureAddressingMode();
+        return packedType == TextureType::_2D_ARRAY ||
+               (mode.u == TextureAddressingMode::CLAMP && mode.v == TextureAddressingMode::CLAMP);
+    }
+}
+    //-----------------------------------------------------------------------
+    auto TextureAtlas::getEntry(std::string_view name) const -> const Entry*
+    {
+        auto it = std::ranges::find(entries, name, &Entry::name);
+        return it == entries.end() ? nullptr : &*it;
+    }
+    //-----------------------------------------------------------------------
+    auto TextureAtlas::getTransform(const Entry& entry) const -> Matrix4
+    {
+        Matrix4 xform = Matrix4::IDENTITY;
+        xform[0][0] = Real(entry.width) / width;
+        xform[1][1] = Real(entry.height) / height;
+        xform[0][3] = Real(entry.left) / width;
+        xform[1][3] = Real(entry.top) / height;
+        xform[2][3] = Real(entry.layer);
+        return xform;
+    }
+    //-----------------------------------------------------------------------
+    auto TextureAtlas::apply(const MaterialPtr& material) const -> size_t
+    {
+        size_t changed = 0;
+        for (auto* tech : material->getTechniques())
+            for (auto* pass : tech->getPasses())
+                for (auto* tus : pass->getTextureUnitStates())
+                {
+                    if (!isPackable(tus, textureType))
+                        continue;
+                    const Entry* entry = getEntry(tus->getTextureName());
+                    if (!entry)
+                        continue;
+
+                    // the atlas transform applies after the unit's own scrolling and scaling
+                    Matrix4 const xform = getTransform(*entry) * tus->getTextureTransform();
+                    tus->setTextureName(textureName, textureType);
+                    tus->setTextureTransform(xform);
+                    ++changed;
+                }
+        return changed;
+    }
+    //-----------------------------------------------------------------------
+    void TextureAtlas::save(std::string_view filename) const
+    {
+        std::ofstream of(std::filesystem::path{filename}, std::ios_base::out | std::ios_base::trunc);
+        if (!of)
+            OGRE_EXCEPT(ExceptionCodes::CANNOT_WRITE_TO_FILE, ::std::format("cannot open '{}'", filename),
+                        "TextureAtlas::save");
+
+        of << "texture " << textureName << '\n';
+        of << "type " << (textureType == TextureType::_2D_ARRAY ? "2d_array" : "2d") << '\n';
+        of << "size " << width << ' ' << height << ' ' << layers << '\n';
+        for (const auto& entry : entries)
+            of << ::std::format("entry {} {} {} {} {} {}\n", entry.layer, entry.left, entry.top, entry.width,
+                                entry.height, entry.name);
+        if (!of)
+            OGRE_EXCEPT(ExceptionCodes::CANNOT_WRITE_TO_FILE, ::std::format("cannot write '{}'", filename),
+                        "TextureAtlas::save");
+    }
+    //-----------------------------------------------------------------------
+    void TextureAtlas::load(const DataStreamPtr& stream)
+    {
+        *this = TextureAtlas{};
+
+        auto invalid = [&](size_t line)
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                        ::std::format("{}:{}: invalid texture atlas line", stream->getName(), line),
+                        "TextureAtlas::load");
+        };
+
+        for (size_t line = 1; !stream->eof(); ++line)
+        {
+            String const text = stream->getLine();
+            if (text.empty() || text[0] == '#')
+                continue;
+
+            auto const fields = StringUtil::split(text, " ", 6);
+            if (fields[0] == "texture" && fields.size() >= 2)
+                textureName = text.substr(text.find(' ') + 1);
+            else if (fields[0] == "type" && fields.size() == 2)
+            {
+                if (fields[1] == "2d")
+                    textureType = TextureType::_2D;
+                else if (fields[1] == "2d_array")
+                    textureType = TextureType::_2D_ARRAY;
+                else
+                    invalid(line);
+            }
+            else if (fields[0] == "size" && fields.size() == 4)
+            {
+                if (!StringConverter::parse(fields[1], width) || !StringConverter::parse(fields[2], height) ||
+                    !StringConverter::parse(fields[3], layers))
+                    invalid(line);
+            }
+            else if (fields[0] == "entry" && fields.size() == 7)
+            {
+                Entry& entry = entries.emplace_back();
+                if (!StringConverter::parse(fields[1], entry.layer) || !StringConverter::parse(fields[2], entry.left) ||
+                    !StringConverter::parse(fields[3], entry.top) || !StringConverter::parse(fields[4], entry.width) ||
+                    !StringConverter::parse(fields[5], entry.height))
+                    invalid(line);
+                entry.name = fields[6];
+            }
+            else
+                invalid(line);
+        }
+
+        if (textureName.empty() || !width || !height || !layers)
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                        ::std::format("{}: incomplete texture atlas", stream->getName()), "TextureAtlas::load");
+    }
+    //-----------------------------------------------------------------------
+    void TexturePacker::setFormat(PixelFormat format)
+    {
+        OgreAssert(!PixelUtil::isCompressed(format), "the packed format must not be compressed");
+        mFormat = format;
+    }
+    //-----------------------------------------------------------------------
+    void TexturePacker::addImage(std::string_view name, const Image& image)
+    {
+        OgreAssert(image.getDepth() == 1 && image.getNumFaces() == 1, "only 2D images can be packed");
+        if (std::ranges::find(mImages, name, &std::pair<String, Image>::first) != mImages.end())
+            return;
+
+        Image src = image;
+        if (PixelUtil::isCompressed(src.getFormat()))
+            src.decompress();
+
+        // keep only the top level, the packed texture gets its own mipmaps
+        Image top(src.getFormat(), src.getWidth(), src.getHeight());
+        PixelUtil::bulkPixelConversion(src.getPixelBox(), top.getPixelBox());
+        mImages.emplace_back(name, top);
+    }
+    //-----------------------------------------------------------------------
+    auto TexturePacker::addMaterial(const MaterialPtr& material) -> size_t
+    {
+        size_t const before = mImages.size();
+        TextureType const packedType = mLayout == Layout::ARRAY ? TextureType::_2D_ARRAY : TextureType::_2D;
+        for (auto* tech : material->getTechniques())
+            for (auto* pass : tech->getPasses())
+                for (auto* tus : pass->getTextureUnitStates())
+                {
+                    if (!isPackable(tus, packedType) ||
+                        std::ranges::find(mImages, tus->getTextureName(), &std::pair<String, Image>::first) !=
+                            mImages.end())
+                        continue;
+
+                    Image image;
+                    image.load(tus->getTextureName(), material->getGroup());
+                    addImage(tus->getTextureName(), image);
+                }
+        return mImages.size() - before;
+    }
+    //-----------------------------------------------------------------------
+    auto TexturePacker::pack(std::string_view textureName, Image& dest) const -> TextureAtlas
+    {
+        OgreAssert(!mImages.empty(), "no images to pack");
+
+        TextureAtlas atlas;
+        atlas.textureName = textureName;
+        if (mLayout == Layout::ARRAY)
+            packArray(atlas, dest);
+        else
+            packAtlas(atlas, dest);
+        return atlas;
+    }
+    //-----------------------------------------------------------------------
+    void TexturePacker::packAtlas(TextureAtlas& atlas, Image& dest) const
+    {
+        // aligning the rectangles to the padding keeps the first mipmaps from mixing images
+        uint32 const alignment = std::max(1u, Bitwise::firstPO2From(mPadding));
+        auto align = [alignment](uint32 v) { return (v + alignment - 1) / alignment * alignment; };
+
+        std::vector<PackRect> rects;
+        rects.reserve(mImages.size());
+        uint64 area = 0;
+        uint32 maxWidth = 0, maxHeight = 0;
+        for (size_t i = 0; i < mImages.size(); ++i)
+        {
+            const Image& image = mImages[i].second;
+            PackRect& rect = rects.emplace_back(
+                PackRect{i, align(image.getWidth() + 2 * mPadding), align(image.getHeight() + 2 * mPadding)});
+            area += uint64(rect.width) * rect.height;
+            maxWidth = std::max(maxWidth, rect.width);
+            maxHeight = std::max(maxHeight, rect.height);
+        }
+        if (maxWidth > mMaxSize || maxHeight > mMaxSize)
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                        ::std::format("an image is larger than the maximum atlas size {}", mMaxSize),
+                        "TexturePacker::pack");
+
+        std::ranges::stable_sort(rects, [](const PackRect& a, const PackRect& b)
+                                 { return std::pair(a.height, a.width) > std::pair(b.height, b.width); });
+
+        // grow a power of two atlas from the total area until everything fits
+        auto const side = Bitwise::firstPO2From(static_cast<uint32>(std::ceil(std::sqrt(double(area)))));
+        uint32 width = std::max(side, Bitwise::firstPO2From(maxWidth));
+        uint32 height = std::max(side, Bitwise::firstPO2From(maxHeight));
+        while (!packSkyline(rects, width, height))
+        {
+            if (width <= height)
+                width *= 2;
+            else
+                height *= 2;
+            if (width > mMaxSize || height > mMaxSize)
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                            ::std::format("{} images do not fit into a {}x{} atlas", mImages.size(), mMaxSize,
+                                          mMaxSize),
+                            "TexturePacker::pack");
+        }
+
+        dest.create(mFormat, width, height);
+        memset(dest.getData(), 0, dest.getSize());
+
+        atlas.textureType = TextureType::_2D;
+        atlas.width = width;
+        atlas.height = height;
+        atlas.layers = 1;
+        atlas.entries.resize(mImages.size());
+        for (const auto& rect : rects)
+        {
+            const auto& [name, image] = mImages[rect.image];
+            TextureAtlas::Entry& entry = atlas.entries[rect.image];
+            entry = {name, 0, rect.x + mPadding, rect.y + mPadding, image.getWidth(), image.getHeight()};
+
+            PixelBox const box = dest.getPixelBox().getSubVolume(
+                {entry.left, entry.top, entry.left + entry.width, entry.top + entry.height, 0, 1});
+            PixelUtil::bulkPixelConversion(image.getPixelBox(), box);
+            replicateEdges(dest, entry.left, entry.top, entry.width, entry.height, mPadding);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void TexturePacker::packArray(TextureAtlas& atlas, Image& dest) const
+    {
+        uint32 width = 0, height = 0;
+        for (const auto& [name, image] : mImages)
+        {
+            width = std::max(width, image.getWidth());
+            height = std::max(height, image.getHeight());
+        }
+
+        auto const layers = static_cast<uint32>(mImages.size());
+        dest.create(mFormat, width, height, layers);
+
+        atlas.textureType = TextureType::_2D_ARRAY;
+        atlas.width = width;
+        atlas.height = height;
+        atlas.layers = layers;
+        atlas.entries.clear();
+        for (uint32 layer = 0; layer < layers; ++layer)
+        {
+            const auto& [name, image] = mImages[layer];
+            atlas.entries.push_back({name, layer, 0, 0, width, height});
+
+            PixelBox const box = dest.getPixelBox().getSubVolume({0, 0, width, height, layer, layer + 1});
+            if (image.getWidth() == width && image.getHeight() == height)
+                PixelUtil::bulkPixelConversion(image.getPixelBox(), box);
+            else
+                Image::scale(image.getPixelBox(), box);
+        }
+    }
+}
@@ -0,0 +1,308 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstddef>
+#include <cstring>
+
+module Ogre.Core;
+
+import :DataStream;
+import :Exception;
+import :FileSystem;
+import :Image;
+import :MurmurHash3;
+import :PixelFormat;
+import :Platform;
+import :Prerequisites;
+import :SharedPtr;
+import :TextureManager;
+
+import <algorithm>;
+import <atomic>;
+import <charconv>;
+import <chrono>;
+import <filesystem>;
+import <format>;
+import <fstream>;
+import <list>;
+import <map>;
+import <memory>;
+import <mutex>;
+import <string>;
+import <string_view>;
+import <system_error>;
+import <tuple>;
+import <utility>;
+import <vector>;
+
+namespace Ogre {
+namespace {
+    /** Layout of a texture cache entry, in native byte order:
+        Header              : see below, 64 bytes so the pixels start aligned
+        pixel data          : as held by Image, all mipmaps of face 0, then face 1 and so on
+
+    The file is named after the key, so the header only repeats it to detect a mismatch.
+    */
+    auto constexpr CACHE_MAGIC = std::string_view{"OGRETXC\0", 8};
+    /// Bump whenever the file layout or the image processing changes
+    uint32 constexpr CACHE_VERSION = 1;
+    auto constexpr CACHE_EXTENSION = std::string_view{".otc"};
+
+    struct Header
+    {
+        char magic[8];
+        uint32 version;
+        uint32 format;
+        uint32 width;
+        uint32 height;
+        uint32 depth;
+        uint32 faces;
+        uint32 mipmaps;
+        uint32 reserved;
+        uint64 key[2];
+        uint64 dataSize;
+    };
+    static_assert(sizeof(Header) == 64);
+
+    /// distinguishes the temporary files of concurrent inserts
+    std::atomic<uint32> gTempCounter{0};
+
+    auto parseKey(std::string_view stem, TextureCache::Hash& key) -> bool
+    {
+        if (stem.size() != 32)
+            return false;
+        auto parseHalf = [](std::string_view hex, uint64& value)
+        {
+            auto [ptr, ec] = std::from_chars(hex.data(), hex.data() + hex.size(), value, 16);
+            return ec == std::errc{} && ptr == hex.data() + hex.size();
+        };
+        return parseHalf(stem.substr(0, 16), key.first) && parseHalf(stem.substr(16), key.second);
+    }
+}
+    //-----------------------------------------------------------------------
+    TextureCache::TextureCache(std::string_view directory, size_t maxSize)
+        : mDirectory{directory}, mMaxSize{maxSize}
+    {
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        fs::create_directories(fs::path{mDirectory}, ec);
+        if (ec)
+            OGRE_EXCEPT(ExceptionCodes::CANNOT_WRITE_TO_FILE,
+                        ::std::format("Cannot create texture cache directory {}", mDirectory), "TextureCache");
+
+        // the modification time of an entry is its last use, see find
+        std::vector<std::tuple<fs::file_time_type, Hash, size_t>> found;
+        for (auto const& file : fs::directory_iterator{fs::path{mDirectory}, ec})
+        {
+            auto const& path = file.path();
+            if (path.extension() != CACHE_EXTENSION)
+            {
+                // left over by an interrupted insert
+                if (path.extension().string().starts_with(".tmp"))
+                    fs::remove(path, ec);
+                continue;
+            }
+
+            Hash key;
+            if (!file.is_regular_file(ec) || !parseKey(path.stem().string(), key))
+                continue;
+            found.emplace_back(file.last_write_time(ec), key, size_t(file.file_size(ec)));
+        }
+
+        std::ranges::sort(found, std::greater<>{}, [](auto const& entry) { return std::get<0>(entry); });
+        for (auto const& [time, key, size] : found)
+        {
+            mEntries[key] = {size, mLru.insert(mLru.end(), key)};
+            mSize += size;
+        }
+        evict(mMaxSize);
+    }
+    //-----------------------------------------------------------------------
+    auto TextureCache::makeKey(const void* data, size_t size, std::string_view options) -> Hash
+    {
+        uint64 optionsHash[2];
+        MurmurHash3_128(options.data(), options.size(), 0, optionsHash);
+        uint64 out[2];
+        MurmurHash3_128(data, size, uint32(optionsHash[0]), out);
+        return {out[0] ^ optionsHash[1], out[1]};
+    }
+    //-----------------------------------------------------------------------
+    auto TextureCache::getPath(const Hash& key) const -> String
+    {
+        return (std::filesystem::path{mDirectory} /
+                ::std::format("{:016x}{:016x}{}", key.first, key.second, CACHE_EXTENSION)).string();
+    }
+    //-----------------------------------------------------------------------
+    auto TextureCache::find(const Hash& key, Image& image) -> bool
+    {
+        String path;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto it = mEntries.find(key);
+            if (it == mEntries.end())
+                return false;
+            mLru.splice(mLru.begin(), mLru, it->second.use);
+            path = getPath(key);
+        }
+
+        try
+        {
+            DataStreamPtr stream = _openMappedFileStream(path);
+            ::std::shared_ptr<uchar> data = stream->getSharedData();
+
+            Header header;
+            if (!data || stream->size() < sizeof(Header))
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "truncated texture cache entry", "TextureCache::find");
+            memcpy(&header, data.get(), sizeof(Header));
+
+            auto const format = PixelFormat(header.format);
+            auto const mipmaps = TextureMipmap(header.mipmaps);
+            if (CACHE_MAGIC != std::string_view{header.magic, sizeof(header.magic)} ||
+                header.version != CACHE_VERSION || header.key[0] != key.first || header.key[1] != key.second ||
+                format >= PixelFormat::COUNT || (header.faces != 1 && header.faces != 6) ||
+                stream->size() != sizeof(Header) + header.dataSize ||
+                Image::calculateSize(mipmaps, header.faces, header.width, header.height, header.depth, format) !=
+                    header.dataSize)
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "damaged texture cache entry", "TextureCache::find");
+
+            // the image refers to the mapped pixels and keeps the mapping alive
+            image.loadDynamicImage(::std::shared_ptr<uchar>{data, data.get() + sizeof(Header)}, header.width,
+                                   header.height, header.depth, format, header.faces, mipmaps);
+        }
+        catch (const Exception&)
+        {
+            // missing or damaged, the caller decodes the source and replaces it
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (auto it = mEntries.find(key); it != mEntries.end())
+            {
+                mSize -= it->second.size;
+                mLru.erase(it->second.use);
+                mEntries.erase(it);
+            }
+            std::error_code ec;
+            std::filesystem::remove(std::filesystem::path{path}, ec);
+            return false;
+        }
+
+        // record the use for the next run
+        std::error_code ec;
+        std::filesystem::last_write_time(std::filesystem::path{path}, std::filesystem::file_time_type::clock::now(), ec);
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    void TextureCache::insert(const Hash& key, const Image& image)
+    {
+        size_t const size = sizeof(Header) + image.getSize();
+        if (image.getSize() == 0 || size > mMaxSize)
+            return;
+
+        Header header{};
+        memcpy(header.magic, CACHE_MAGIC.data(), sizeof(header.magic));
+        header.version = CACHE_VERSION;
+        header.format = uint32(image.getFormat());
+        header.width = image.getWidth();
+        header.height = image.getHeight();
+        header.depth = image.getDepth();
+        header.faces = image.getNumFaces();
+        header.mipmaps = uint32(image.getNumMipmaps());
+        header.key[0] = key.first;
+        header.key[1] = key.second;
+        header.dataSize = image.getSize();
+
+        // written under a temporary name and renamed, so find never maps a partial entry
+        String const path = getPath(key);
+        std::filesystem::path const temp{::std::format("{}.tmp{}", path, gTempCounter++)};
+        {
+            std::ofstream file{temp, std::ios::binary | std::ios::trunc};
+            file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            file.write(reinterpret_cast<const char*>(image.getData()), std::streamsize(image.getSize()));
+            if (!file)
+            {
+                file.close();
+                std::error_code ec;
+                std::filesystem::remove(temp, ec);
+                OGRE_EXCEPT(ExceptionCodes::CANNOT_WRITE_TO_FILE, ::std::format("Failed writing {}", path),
+                            "TextureCache::insert");
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::error_code ec;
+        std::filesystem::rename(temp, std::filesystem::path{path}, ec);
+        if (ec)
+        {
+            std::filesystem::remove(temp, ec);
+            OGRE_EXCEPT(ExceptionCodes::CANNOT_WRITE_TO_FILE, ::std::format("Failed writing {}", path),
+                        "TextureCache::insert");
+        }
+
+        if (auto it = mEntries.find(key); it != mEntries.end())
+        {
+            // stored by another thread in the meantime
+            mSize -= it->second.size;
+            it->second.size = size;
+            mLru.splice(mLru.begin(), mLru, it->second.use);
+        }
+        else
+            mEntries[key] = {size, mLru.insert(mLru.begin(), key)};
+        mSize += size;
+
+        // the new entry is the most recently used and fits, so it is never evicted here
+        evict(mMaxSize);
+    }
+    //-----------------------------------------------------------------------
+    void TextureCache::evict(size_t maxSize)
+    {
+        while (mSize > maxSize && !mLru.empty())
+        {
+            Hash const key = mLru.back();
+            mLru.pop_back();
+            auto it = mEntries.find(key);
+            mSize -= it->second.size;
+            mEntries.erase(it);
+
+            // entries that are still mapped stay readable until they are unmapped
+            std::error_code ec;
+            std::filesystem::remove(std::filesystem::path{getPath(key)}, ec);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void TextureCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        evict(0);
+    }
+    //-----------------------------------------------------------------------
+    void TextureCache::setMaxSize(size_t maxSize)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mMaxSize = maxSize;
+        evict(mMaxSize);
+    }
+}
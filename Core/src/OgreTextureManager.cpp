@@ -313,6 +313,13 @@ namespace Ogre {
         mDefaultNumMipmaps = num;
     }
     //-----------------------------------------------------------------------
+    void TextureManager::setTextureCache(std::string_view directory, size_t maxSize)
+    {
+        mCache.reset();
+        if (!directory.empty())
+            mCache = std::make_unique<TextureCache>(directory, maxSize);
+    }
+    //-----------------------------------------------------------------------
     auto TextureManager::isFormatSupported(TextureType ttype, PixelFormat format, HardwareBufferUsage usage) -> bool
     {
         return getNativeFormat(ttype, format, usage) == format;
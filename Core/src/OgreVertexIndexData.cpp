@@ -37,7 +37,10 @@ import :Exception;
 import :HardwareBufferManager;
 import :HardwareIndexBuffer;
 import :HardwareVertexBuffer;
+import :Math;
+import :Matrix4;
 import :Root;
+import :Vector;
 import :VertexIndexData;
 
 import <algorithm>;
@@ -49,6 +52,25 @@ import <set>;
 import <utility>;
 
 namespace Ogre {
+    namespace {
+    /// Types which VertexElement::readFloats and VertexElement::writeFloats handle
+    auto isConvertibleType(VertexElementType type) -> bool
+    {
+        using enum VertexElementType;
+        switch (VertexElement::getBaseType(type))
+        {
+        case FLOAT1:
+        case HALF1:
+        case SHORT2_NORM:
+        case USHORT2_NORM:
+        case BYTE4_NORM:
+        case UBYTE4_NORM:
+            return true;
+        default:
+            return false;
+        }
+    }
+    }
     //-----------------------------------------------------------------------
     VertexData::VertexData(HardwareBufferManagerBase* mgr)
     {
@@ -118,6 +140,7 @@ namespace Ogre {
         // Basic vertex info
         dest->vertexStart = this->vertexStart;
         dest->vertexCount = this->vertexCount;
+        dest->positionDecodeMatrix = this->positionDecodeMatrix;
         // Copy elements
         const VertexDeclaration::VertexElementList elems = 
             this->vertexDeclaration->getElements();
@@ -200,6 +223,28 @@ namespace Ogre {
             auto *pDest = static_cast<float*>(newPosBuffer->lock(HardwareBuffer::LockOptions::DISCARD));
             float* pDest2 = pDest + oldVertexCount * 3; 
 
+            // Quantised positions are decoded, the extrusion needs them in model space
+            bool decodePositions = posElem->getType() != VertexElementType::FLOAT3;
+            auto copyPosition = [&](unsigned char* pBase)
+            {
+                if (!decodePositions)
+                {
+                    posElem->baseVertexPointerToElement(pBase, &pSrc);
+                    *pDest++ = *pDest2++ = *pSrc++;
+                    *pDest++ = *pDest2++ = *pSrc++;
+                    *pDest++ = *pDest2++ = *pSrc++;
+                    return;
+                }
+                void* pElem;
+                float values[4];
+                posElem->baseVertexPointerToElement(pBase, &pElem);
+                posElem->readFloats(pElem, values);
+                Vector3 pos = positionDecodeMatrix * Vector3{values[0], values[1], values[2]};
+                *pDest++ = *pDest2++ = pos.x;
+                *pDest++ = *pDest2++ = pos.y;
+                *pDest++ = *pDest2++ = pos.z;
+            };
+
             // Precalculate any dimensions of vertex areas outside the position
             size_t prePosVertexSize = 0;
             unsigned char *pBaseDestRem = nullptr;
@@ -218,10 +263,7 @@ namespace Ogre {
                 for (v = 0; v < oldVertexCount; ++v)
                 {
                     // Copy position, into both buffers
-                    posElem->baseVertexPointerToElement(pBaseSrc, &pSrc);
-                    *pDest++ = *pDest2++ = *pSrc++;
-                    *pDest++ = *pDest2++ = *pSrc++;
-                    *pDest++ = *pDest2++ = *pSrc++;
+                    copyPosition(pBaseSrc);
 
                     // now deal with any other elements 
                     // Basically we just memcpy the vertex excluding the position
@@ -236,12 +278,22 @@ namespace Ogre {
 
                 } // next vertex
             }
-            else
+            else if (!decodePositions)
             {
                 // Unshared buffer, can block copy the whole thing
                 memcpy(pDest, pBaseSrc, vbuf->getSizeInBytes());
                 memcpy(pDest2, pBaseSrc, vbuf->getSizeInBytes());
             }
+            else
+            {
+                for (v = 0; v < oldVertexCount; ++v)
+                {
+                    copyPosition(pBaseSrc);
+                    pBaseSrc += vbuf->getVertexSize();
+                }
+            }
+            // The new position buffer is always in model space
+            positionDecodeMatrix = Affine3::IDENTITY;
 
             vbuf->unlock();
             newPosBuffer->unlock();
@@ -329,6 +381,15 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    auto VertexData::calcPositionDecodeMatrix(const Vector3& vmin, const Vector3& vmax) -> Affine3
+    {
+        Vector3 halfSize = (vmax - vmin) * 0.5f;
+        Real scale = std::max({halfSize.x, halfSize.y, halfSize.z});
+        if (!(scale > 0))
+            scale = 1;
+        return Affine3::getTrans((vmin + vmax) * 0.5f) * Affine3::getScale(scale, scale, scale);
+    }
+    //-----------------------------------------------------------------------
     void VertexData::reorganiseBuffers(VertexDeclaration* newDeclaration, 
         const BufferUsageList& bufferUsages, HardwareBufferManagerBase* mgr)
     {
@@ -402,8 +463,45 @@ namespace Ogre {
                     "Element not found in old vertex declaration", 
                     "VertexData::reorganiseBuffers");
             }
+            if (oldElem->getType() != ei.getType() &&
+                (!isConvertibleType(oldElem->getType()) || !isConvertibleType(ei.getType())))
+            {
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS,
+                    "Cannot convert between these vertex element types",
+                    "VertexData::reorganiseBuffers");
+            }
             newToOldElementMap[&ei] = oldElem;
         }
+
+        // Positions changing type are brought back to model space and, if the new type is
+        // normalised, fitted into [-1, 1] with a uniform scale so directions stay unchanged
+        Affine3 newPositionDecode = positionDecodeMatrix;
+        Affine3 positionRecode = Affine3::IDENTITY;
+        const VertexElement* newPosElem = newDeclaration->findElementBySemantic(VertexElementSemantic::POSITION);
+        if (newPosElem && newPosElem->getType() != newToOldElementMap[newPosElem]->getType())
+        {
+            const VertexElement* oldPosElem = newToOldElementMap[newPosElem];
+            newPositionDecode = Affine3::IDENTITY;
+            VertexElementType baseType = VertexElement::getBaseType(newPosElem->getType());
+            if (baseType != VertexElementType::FLOAT1 && baseType != VertexElementType::HALF1 && vertexCount)
+            {
+                Vector3 vmin = Vector3::Fill(Math::POS_INFINITY), vmax = Vector3::Fill(Math::NEG_INFINITY);
+                auto* pBase = static_cast<unsigned char*>(oldBufferLocks[oldPosElem->getSource()]);
+                for (size_t v = 0; v < vertexCount; ++v)
+                {
+                    void* pElem;
+                    float values[4];
+                    oldPosElem->baseVertexPointerToElement(pBase + v * oldBufferVertexSizes[oldPosElem->getSource()], &pElem);
+                    oldPosElem->readFloats(pElem, values);
+                    Vector3 pos = positionDecodeMatrix * Vector3{values[0], values[1], values[2]};
+                    vmin.makeFloor(pos);
+                    vmax.makeCeil(pos);
+                }
+                newPositionDecode = calcPositionDecodeMatrix(vmin, vmax);
+            }
+            positionRecode = newPositionDecode.inverse() * positionDecodeMatrix;
+        }
+
         // Now iterate over the new buffers, pulling data out of the old ones
         // For each vertex
         for (size_t v = 0; v < vertexCount; ++v)
@@ -425,9 +523,25 @@ namespace Ogre {
                 void *pSrc, *pDst;
                 oldElem->baseVertexPointerToElement(pSrcBase, &pSrc);
                 newElem->baseVertexPointerToElement(pDstBase, &pDst);
-                
-                memcpy(pDst, pSrc, newElem->getSize());
-                
+
+                if (oldElem->getType() == newElem->getType())
+                {
+                    memcpy(pDst, pSrc, newElem->getSize());
+                    continue;
+                }
+
+                float values[4];
+                oldElem->readFloats(pSrc, values);
+                if (newElem == newPosElem)
+                {
+                    Vector3 pos = positionRecode * Vector3{values[0], values[1], values[2]};
+                    values[0] = pos.x;
+                    values[1] = pos.y;
+                    values[2] = pos.z;
+                    values[3] = 1;
+                }
+                newElem->writeFloats(pDst, values);
+
             }
         }
 
@@ -451,6 +565,7 @@ namespace Ogre {
         // Assign new binding and declaration
         vertexDeclaration = newDeclaration;
         vertexBufferBinding = newBinding;       
+        positionDecodeMatrix = newPositionDecode;
         // after this is complete, new manager should be used
         mMgr = pManager;
         mDeleteDclBinding = true; // because we created these through a manager
@@ -27,10 +27,11 @@ THE SOFTWARE.
 */
 module;
 
-#include <zip.h>
 #include <cstddef>
+#include <cstring>
 // NOLINTBEGIN
-#include <zip.h>
+#define MINIZ_HEADER_FILE_ONLY
+#include <miniz.h>
 
 module Ogre.Core;
 
@@ -52,20 +53,45 @@ import <iosfwd>;
 import <map>;
 import <memory>;
 import <string>;
+import <unordered_map>;
 import <utility>;
 import <vector>;
 
 // NOLINTEND
 namespace Ogre {
 namespace {
+    /** Zip archive reading entries straight out of a read-only view of the whole file.
+    @remarks
+        The central directory is parsed once on load. Entries are then located through a
+        hashed name index and decompressed independently, so open() may be called from
+        several threads at once. Stored entries are returned as views into the mapping.
+    */
     class ZipArchive : public Archive
     {
     protected:
-        /// Handle to root zip file
-        zip_t* mZipFile{nullptr};
-        MemoryDataStreamPtr mBuffer;
+        /// Where to find the data of one entry
+        struct Entry
+        {
+            size_t localHeaderOffset;
+            size_t compressedSize;
+            size_t uncompressedSize;
+            uint16 method;
+        };
+
+        /// The whole archive, memory mapped or owned by the embedding application
+        ::std::shared_ptr<uchar> mData;
+        size_t mDataSize{0};
+        /// Entry locations, parallel to mFileList
+        std::vector<Entry> mEntries;
+        /// Index into mFileList by full entry name
+        std::unordered_map<String, size_t, StringHash, std::equal_to<>> mIndex;
         /// File list (since zziplib seems to only allow scanning of dir tree once)
         FileInfoList mFileList;
+        /// Whether the archive data was supplied by the application
+        bool mExternal{false};
+
+        /// Offset of the first data byte of an entry, after its local header
+        [[nodiscard]] auto getDataOffset(const Entry& entry, std::string_view filename) const -> size_t;
     public:
         ZipArchive(std::string_view name, std::string_view archType, const uint8* externBuf = nullptr, size_t externBufSz = 0);
         ~ZipArchive() override;
@@ -106,13 +132,22 @@ namespace {
         /// @copydoc Archive::getModifiedTime
         [[nodiscard]] auto getModifiedTime(std::string_view filename) const -> std::filesystem::file_time_type override;
     };
+
+    /// little endian field of a zip header
+    auto readLE16(const uchar* p) -> uint16 { return uint16(p[0] | (p[1] << 8)); }
+    auto readLE32(const uchar* p) -> uint32 { return uint32(readLE16(p)) | (uint32(readLE16(p + 2)) << 16); }
 }
     //-----------------------------------------------------------------------
     ZipArchive::ZipArchive(std::string_view name, std::string_view archType, const uint8* externBuf, size_t externBufSz)
         : Archive(name, archType) 
     {
         if(externBuf)
-            mBuffer = std::make_shared<MemoryDataStream>(const_cast<uint8*>(externBuf), externBufSz);
+        {
+            // owned by the application, see EmbeddedZipArchiveFactory::addEmbbeddedFile
+            mData.reset(const_cast<uint8*>(externBuf), [](uchar*) {});
+            mDataSize = externBufSz;
+            mExternal = true;
+        }
     }
     //-----------------------------------------------------------------------
     ZipArchive::~ZipArchive()
@@ -122,79 +157,132 @@ namespace {
     //-----------------------------------------------------------------------
     void ZipArchive::load()
     {
-        if (!mZipFile)
-        {
-            if(!mBuffer)
-                mBuffer = std::make_shared<MemoryDataStream>(_openFileStream(mName, std::ios::binary));
-
-            mZipFile = zip_stream_open((const char*)mBuffer->getPtr(), mBuffer->size(), 0, 'r');
+        if (!mFileList.empty())
+            return;
 
-            // Cache names
-            int n = zip_entries_total(mZipFile);
-            for (int i = 0; i < n; ++i) {
-                FileInfo info;
-                info.archive = this;
+        if (!mData)
+        {
+            DataStreamPtr mapped = _openMappedFileStream(mName);
+            mData = mapped->getSharedData();
+            mDataSize = mapped->size();
+        }
 
-                zip_entry_openbyindex(mZipFile, i);
+        mz_zip_archive zip{};
+        if (!mz_zip_reader_init_mem(&zip, mData.get(), mDataSize, 0))
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, ::std::format("{} is not a valid zip archive", mName),
+                "ZipArchive::load");
+        }
 
-                info.filename = zip_entry_name(mZipFile);
-                // Get basename / path
-                std::string_view basename, path;
+        // Cache names and data locations
+        mz_uint n = mz_zip_reader_get_num_files(&zip);
+        mFileList.reserve(n);
+        mEntries.reserve(n);
+        for (mz_uint i = 0; i < n; ++i) {
+            mz_zip_archive_file_stat stat;
+            if (!mz_zip_reader_file_stat(&zip, i, &stat))
+                continue;
+
+            FileInfo info;
+            info.archive = this;
+
+            info.filename = stat.m_filename;
+            // Get basename / path
+            std::string_view basename, path;
+            StringUtil::splitFilename(info.filename, basename, path);
+            info.basename = basename;
+            info.path = path;
+
+            // Get sizes
+            info.uncompressedSize = stat.m_uncomp_size;
+            info.compressedSize = stat.m_comp_size;
+
+            if (stat.m_is_directory)
+            {
+                info.filename = info.filename.substr(0, info.filename.length() - 1);
                 StringUtil::splitFilename(info.filename, basename, path);
                 info.basename = basename;
                 info.path = path;
-
-                // Get sizes
-                info.uncompressedSize = zip_entry_size(mZipFile);
-                info.compressedSize = zip_entry_comp_size(mZipFile);
-
-                if (zip_entry_isdir(mZipFile))
-                {
-                    info.filename = info.filename.substr(0, info.filename.length() - 1);
-                    StringUtil::splitFilename(info.filename, basename, path);
-                    info.basename = basename;
-                    info.path = path;
-                    // Set compressed size to -1 for folders; anyway nobody will check
-                    // the compressed size of a folder, and if he does, its useless anyway
-                    info.compressedSize = size_t(-1);
-                }
-
-                zip_entry_close(mZipFile);
-                mFileList.push_back(info);
+                // Set compressed size to -1 for folders; anyway nobody will check
+                // the compressed size of a folder, and if he does, its useless anyway
+                info.compressedSize = size_t(-1);
             }
+
+            mIndex.emplace(info.filename, mFileList.size());
+            mEntries.push_back({size_t(stat.m_local_header_ofs), size_t(stat.m_comp_size),
+                                size_t(stat.m_uncomp_size), stat.m_method});
+            mFileList.push_back(info);
         }
+
+        mz_zip_reader_end(&zip);
     }
     //-----------------------------------------------------------------------
     void ZipArchive::unload()
     {
-        if (mZipFile)
+        mFileList.clear();
+        mEntries.clear();
+        mIndex.clear();
+        // streams handed out by open() keep their own reference to the mapping
+        if (!mExternal)
         {
-            zip_close(mZipFile);
-            mZipFile = nullptr;
-            mFileList.clear();
-            mBuffer.reset();
+            mData.reset();
+            mDataSize = 0;
         }
-    
+    }
+    //-----------------------------------------------------------------------
+    auto ZipArchive::getDataOffset(const Entry& entry, std::string_view filename) const -> size_t
+    {
+        static size_t constexpr LOCAL_HEADER_SIZE = 30;
+        const uchar* header = mData.get() + entry.localHeaderOffset;
+        if (entry.localHeaderOffset + LOCAL_HEADER_SIZE > mDataSize || readLE32(header) != 0x04034b50)
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, ::std::format("corrupt local header for {}", filename),
+                "ZipArchive::open");
+        }
+
+        // the local name and extra field lengths may differ from the central directory
+        size_t offset = entry.localHeaderOffset + LOCAL_HEADER_SIZE + readLE16(header + 26) + readLE16(header + 28);
+        if (offset + entry.compressedSize > mDataSize)
+        {
+            OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, ::std::format("truncated data for {}", filename),
+                "ZipArchive::open");
+        }
+        return offset;
     }
     //-----------------------------------------------------------------------
     auto ZipArchive::open(std::string_view filename, bool readOnly) const -> DataStreamPtr
     {
-        // zip is not threadsafe
-        String lookUpFileName{ filename };
+        // only reads immutable state, so safe to call concurrently
+        auto it = mIndex.find(filename);
+        if (it == mIndex.end() || mFileList[it->second].compressedSize == size_t(-1))
+        {
+            OGRE_EXCEPT(ExceptionCodes::FILE_NOT_FOUND, ::std::format("could not open {}", filename));
+        }
 
-        bool open = zip_entry_open(mZipFile, lookUpFileName.c_str(), true) == 0;
+        const Entry& entry = mEntries[it->second];
+        size_t offset = getDataOffset(entry, filename);
 
-        if (!open)
+        if (entry.method == 0)
         {
-            OGRE_EXCEPT(ExceptionCodes::FILE_NOT_FOUND, ::std::format("could not open {}", lookUpFileName));
+            // stored: hand out a view into the archive, which the stream keeps alive
+            ::std::shared_ptr<uchar> view{mData, mData.get() + offset};
+            return std::make_shared<MemoryDataStream>(filename, std::move(view), entry.uncompressedSize);
+        }
+
+        if (entry.method != MZ_DEFLATED)
+        {
+            OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED, ::std::format("unsupported compression method for {}", filename),
+                "ZipArchive::open");
         }
 
         // Construct & return stream
-        auto ret = std::make_shared<MemoryDataStream>(zip_entry_size(mZipFile));
+        auto ret = std::make_shared<MemoryDataStream>(filename, entry.uncompressedSize);
 
-        if(zip_entry_noallocread(mZipFile, ret->getPtr(), ret->size()) < 0)
-            OGRE_EXCEPT(ExceptionCodes::FILE_NOT_FOUND, ::std::format("could not read {}", lookUpFileName));
-        zip_entry_close(mZipFile);
+        // raw deflate, the decompressor state lives on the stack
+        size_t written = tinfl_decompress_mem_to_mem(ret->getPtr(), ret->size(), mData.get() + offset,
+                                                     entry.compressedSize, 0);
+        if (written != entry.uncompressedSize)
+            OGRE_EXCEPT(ExceptionCodes::FILE_NOT_FOUND, ::std::format("could not read {}", filename));
 
         return ret;
     }
@@ -270,10 +358,8 @@ namespace {
     }
     //-----------------------------------------------------------------------
     auto ZipArchive::exists(std::string_view cleanName) const -> bool
-    {       
-        return std::ranges::find_if(mFileList, [&cleanName](const Ogre::FileInfo& fi) {
-                   return fi.filename == cleanName;
-               }) != mFileList.end();
+    {
+        return mIndex.contains(cleanName);
     }
     //---------------------------------------------------------------------
     auto ZipArchive::getModifiedTime(std::string_view filename) const -> std::filesystem::file_time_type
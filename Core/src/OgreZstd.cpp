@@ -0,0 +1,1107 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <cstddef>
+#include <cstring>
+
+module Ogre.Core;
+
+import :Exception;
+import :Platform;
+import :Prerequisites;
+import :Zstd;
+
+import <algorithm>;
+import <array>;
+import <bit>;
+import <span>;
+import <utility>;
+import <vector>;
+
+namespace Ogre {
+namespace {
+    [[noreturn]] void corrupt()
+    {
+        OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Corrupt zstd data", "zstdDecompress");
+    }
+
+    auto readLE(const uchar* p, size_t bytes) -> uint64
+    {
+        uint64 value = 0;
+        for (size_t i = 0; i < bytes; ++i)
+            value |= uint64(p[i]) << (8 * i);
+        return value;
+    }
+
+    // bits read from the start of a byte range, least significant first
+    class ForwardBitReader
+    {
+    public:
+        explicit ForwardBitReader(std::span<const uchar> data) : mData(data) {}
+
+        auto peek(uint32 count) const -> uint32
+        {
+            uint64 const byte = mBit / 8;
+            if (byte >= mData.size())
+                return 0;
+            uint64 const word = readLE(mData.data() + byte, std::min<size_t>(8, mData.size() - byte));
+            return uint32(word >> (mBit % 8)) & ((1u << count) - 1);
+        }
+        void consume(uint32 count)
+        {
+            mBit += count;
+            if (mBit > mData.size() * 8)
+                corrupt();
+        }
+        auto read(uint32 count) -> uint32
+        {
+            uint32 const value = peek(count);
+            consume(count);
+            return value;
+        }
+        // whole bytes touched so far
+        [[nodiscard]] auto getBytesRead() const noexcept -> size_t { return size_t((mBit + 7) / 8); }
+
+    private:
+        std::span<const uchar> mData;
+        uint64 mBit{0};
+    };
+
+    // bits read from the end of a byte range towards its start, as written by the entropy coders.
+    // Reading past the start yields zeros, which the callers detect through getBitsLeft() < 0.
+    class BackwardBitReader
+    {
+    public:
+        explicit BackwardBitReader(std::span<const uchar> data) : mData(data)
+        {
+            // the highest set bit of the last byte marks the start of the stream
+            if (data.empty() || data.back() == 0)
+                corrupt();
+            mBits = int64(data.size()) * 8 - 9 + std::bit_width(data.back());
+        }
+
+        // the next count bits, at most 56
+        [[nodiscard]] auto peek(uint32 count) const -> uint64
+        {
+            if (count == 0)
+                return 0;
+            if (mBits <= 0)
+                return 0;
+            int64 const start = mBits - count;
+            if (start < 0)
+                return load(0, uint32(mBits)) << -start;
+            return load(uint64(start), count);
+        }
+        void consume(uint32 count) { mBits -= count; }
+        auto read(uint32 count) -> uint64
+        {
+            uint64 const value = peek(count);
+            consume(count);
+            return value;
+        }
+        [[nodiscard]] auto getBitsLeft() const noexcept -> int64 { return mBits; }
+
+    private:
+        [[nodiscard]] auto load(uint64 bit, uint32 count) const -> uint64
+        {
+            size_t const byte = size_t(bit / 8);
+            uint64 const word = readLE(mData.data() + byte, std::min<size_t>(8, mData.size() - byte));
+            return (word >> (bit % 8)) & ((uint64(1) << count) - 1);
+        }
+
+        std::span<const uchar> mData;
+        int64 mBits;
+    };
+
+    // finite state entropy decoding table
+    struct FSETable
+    {
+        struct Entry
+        {
+            uint16 symbol;
+            uint8 numBits;
+            uint16 baseline;
+        };
+        uint32 accuracyLog{0};
+        std::vector<Entry> entries;
+
+        void build(std::span<const int16> probabilities, uint32 log)
+        {
+            accuracyLog = log;
+            uint32 const size = 1u << log;
+            entries.assign(size, {});
+
+            std::vector<uint32> next(probabilities.size());
+            uint32 highThreshold = size - 1;
+            for (size_t s = 0; s < probabilities.size(); ++s)
+            {
+                if (probabilities[s] == -1)
+                {
+                    entries[highThreshold--].symbol = uint16(s);
+                    next[s] = 1;
+                }
+                else
+                    next[s] = uint32(probabilities[s]);
+            }
+
+            uint32 const step = (size >> 1) + (size >> 3) + 3;
+            uint32 position = 0;
+            for (size_t s = 0; s < probabilities.size(); ++s)
+            {
+                for (int16 i = 0; i < probabilities[s]; ++i)
+                {
+                    entries[position].symbol = uint16(s);
+                    do
+                        position = (position + step) & (size - 1);
+                    while (position > highThreshold);
+                }
+            }
+            if (position != 0)
+                corrupt();
+
+            for (auto& entry : entries)
+            {
+                uint32 const state = next[entry.symbol]++;
+                entry.numBits = uint8(log + 1 - std::bit_width(state));
+                entry.baseline = uint16((state << entry.numBits) - size);
+            }
+        }
+
+        // a single symbol taking no bits
+        void buildRLE(uint16 symbol)
+        {
+            accuracyLog = 0;
+            entries.assign(1, {symbol, 0, 0});
+        }
+
+        // reads a table description, returns the bytes it took
+        auto read(std::span<const uchar> src, uint32 maxLog, uint32 maxSymbol) -> size_t
+        {
+            ForwardBitReader bits(src);
+            uint32 const log = bits.read(4) + 5;
+            if (log > maxLog)
+                corrupt();
+
+            std::vector<int16> probabilities;
+            int32 remaining = (1 << log) + 1;
+            int32 threshold = 1 << log;
+            uint32 numBits = log + 1;
+            while (remaining > 1)
+            {
+                if (probabilities.size() > maxSymbol)
+                    corrupt();
+
+                auto const max = uint32(2 * threshold - 1 - remaining);
+                uint32 value = bits.peek(numBits);
+                if ((value & (threshold - 1)) < max)
+                {
+                    value &= threshold - 1;
+                    bits.consume(numBits - 1);
+                }
+                else
+                {
+                    if (value >= uint32(threshold))
+                        value -= max;
+                    bits.consume(numBits);
+                }
+
+                auto const probability = int16(int32(value) - 1);
+                remaining -= probability < 0 ? -probability : probability;
+                probabilities.push_back(probability);
+
+                if (probability == 0)
+                {
+                    for (uint32 repeat = 3; repeat == 3;)
+                    {
+                        repeat = bits.read(2);
+                        probabilities.insert(probabilities.end(), repeat, 0);
+                    }
+                }
+
+                while (remaining < threshold)
+                {
+                    --numBits;
+                    threshold >>= 1;
+                }
+            }
+            if (remaining != 1 || probabilities.size() > maxSymbol + 1)
+                corrupt();
+
+            build(probabilities, log);
+            return bits.getBytesRead();
+        }
+    };
+
+    class FSEState
+    {
+    public:
+        FSEState(const FSETable& table, BackwardBitReader& bits)
+            : mTable(table), mState(uint32(bits.read(table.accuracyLog))) {}
+
+        [[nodiscard]] auto symbol() const -> uint16 { return mTable.entries[mState].symbol; }
+        void update(BackwardBitReader& bits)
+        {
+            const auto& entry = mTable.entries[mState];
+            mState = entry.baseline + uint32(bits.read(entry.numBits));
+        }
+
+    private:
+        const FSETable& mTable;
+        uint32 mState;
+    };
+
+    // canonical prefix code of the literals, decoded by table lookup of maxBits bits
+    struct HuffmanTable
+    {
+        uint32 maxBits{0};
+        std::vector<std::pair<uchar, uint8>> entries;
+
+        [[nodiscard]] auto isValid() const noexcept -> bool { return maxBits != 0; }
+
+        // reads the tree description, returns the bytes it took
+        auto read(std::span<const uchar> src) -> size_t
+        {
+            if (src.empty())
+                corrupt();
+
+            std::vector<uchar> weights;
+            size_t size;
+            uint32 const header = src[0];
+            if (header < 128)
+            {
+                // FSE compressed weights, decoded with two interleaved states
+                size = 1 + header;
+                if (size > src.size())
+                    corrupt();
+                std::span<const uchar> const data = src.subspan(1, header);
+                FSETable table;
+                size_t const tableSize = table.read(data, 6, 255);
+                if (tableSize > data.size())
+                    corrupt();
+
+                BackwardBitReader bits(data.subspan(tableSize));
+                FSEState first(table, bits), second(table, bits);
+                for (;;)
+                {
+                    weights.push_back(uchar(first.symbol()));
+                    first.update(bits);
+                    if (bits.getBitsLeft() < 0)
+                    {
+                        weights.push_back(uchar(second.symbol()));
+                        break;
+                    }
+                    weights.push_back(uchar(second.symbol()));
+                    second.update(bits);
+                    if (bits.getBitsLeft() < 0)
+                    {
+                        weights.push_back(uchar(first.symbol()));
+                        break;
+                    }
+                    if (weights.size() > 255)
+                        corrupt();
+                }
+            }
+            else
+            {
+                // 4 bit weights
+                uint32 const count = header - 127;
+                size = 1 + (count + 1) / 2;
+                if (size > src.size())
+                    corrupt();
+                for (uint32 i = 0; i < count; ++i)
+                    weights.push_back(i % 2 ? src[1 + i / 2] & 15 : src[1 + i / 2] >> 4);
+            }
+            if (weights.size() > 255)
+                corrupt();
+
+            // the weight of the last symbol completes the sum to a power of two
+            uint32 total = 0;
+            for (uchar weight : weights)
+            {
+                if (weight > 11)
+                    corrupt();
+                total += weight ? 1u << (weight - 1) : 0;
+            }
+            if (total == 0)
+                corrupt();
+            maxBits = std::bit_width(total);
+            uint32 const rest = (1u << maxBits) - total;
+            if (!std::has_single_bit(rest) || maxBits > 11)
+                corrupt();
+            weights.push_back(uchar(std::bit_width(rest)));
+
+            // codes are assigned from the lowest weight up, each symbol covering 2^(weight-1) entries
+            entries.assign(size_t(1) << maxBits, {});
+            size_t position = 0;
+            for (uint32 weight = 1; weight <= maxBits; ++weight)
+            {
+                for (size_t symbol = 0; symbol < weights.size(); ++symbol)
+                {
+                    if (weights[symbol] != weight)
+                        continue;
+                    size_t const count = size_t(1) << (weight - 1);
+                    std::fill_n(entries.begin() + position, count,
+                                std::pair{uchar(symbol), uint8(maxBits + 1 - weight)});
+                    position += count;
+                }
+            }
+            return size;
+        }
+
+        void decodeStream(std::span<const uchar> src, uchar* dest, size_t count) const
+        {
+            BackwardBitReader bits(src);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto& [symbol, numBits] = entries[bits.peek(maxBits)];
+                dest[i] = symbol;
+                bits.consume(numBits);
+            }
+            if (bits.getBitsLeft() != 0)
+                corrupt();
+        }
+    };
+
+    struct SequenceCode
+    {
+        uint32 baseline;
+        uint8 extraBits;
+    };
+
+    constexpr std::array<SequenceCode, 36> LITERALS_LENGTH_CODES = {{
+        {0, 0}, {1, 0}, {2, 0}, {3, 0}, {4, 0}, {5, 0}, {6, 0}, {7, 0}, {8, 0}, {9, 0}, {10, 0}, {11, 0},
+        {12, 0}, {13, 0}, {14, 0}, {15, 0}, {16, 1}, {18, 1}, {20, 1}, {22, 1}, {24, 2}, {28, 2}, {32, 3},
+        {40, 3}, {48, 4}, {64, 6}, {128, 7}, {256, 8}, {512, 9}, {1024, 10}, {2048, 11}, {4096, 12},
+        {8192, 13}, {16384, 14}, {32768, 15}, {65536, 16}}};
+
+    constexpr std::array<SequenceCode, 53> MATCH_LENGTH_CODES = {{
+        {3, 0}, {4, 0}, {5, 0}, {6, 0}, {7, 0}, {8, 0}, {9, 0}, {10, 0}, {11, 0}, {12, 0}, {13, 0}, {14, 0},
+        {15, 0}, {16, 0}, {17, 0}, {18, 0}, {19, 0}, {20, 0}, {21, 0}, {22, 0}, {23, 0}, {24, 0}, {25, 0},
+        {26, 0}, {27, 0}, {28, 0}, {29, 0}, {30, 0}, {31, 0}, {32, 0}, {33, 0}, {34, 0}, {35, 1}, {37, 1},
+        {39, 1}, {41, 1}, {43, 2}, {47, 2}, {51, 3}, {59, 3}, {67, 4}, {83, 4}, {99, 5}, {131, 7}, {259, 8},
+        {515, 9}, {1027, 10}, {2051, 11}, {4099, 12}, {8195, 13}, {16387, 14}, {32771, 15}, {65539, 16}}};
+
+    constexpr uint32 MAX_OFFSET_CODE = 31;
+
+    constexpr int16 DEFAULT_LITERALS_LENGTH[] = {4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 2, 2,
+                                                 2, 2, 2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1, -1, -1, -1, -1};
+    constexpr int16 DEFAULT_MATCH_LENGTH[] = {1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                                              1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                                              1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1, -1, -1};
+    constexpr int16 DEFAULT_OFFSET[] = {1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1,
+                                        1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1};
+
+    constexpr size_t MAX_BLOCK_SIZE = 128 * 1024;
+
+    // what carries over from one block of a frame to the next
+    struct FrameState
+    {
+        HuffmanTable literals;
+        FSETable literalsLength, offset, matchLength;
+        std::array<size_t, 3> repeatOffsets{1, 4, 8};
+    };
+
+    // decodes the literals section into literals, returns the bytes it took
+    auto decodeLiterals(std::span<const uchar> src, FrameState& state, std::vector<uchar>& literals) -> size_t
+    {
+        if (src.empty())
+            corrupt();
+
+        uint32 const type = src[0] & 3;
+        uint32 const sizeFormat = (src[0] >> 2) & 3;
+        if (type < 2)
+        {
+            // raw or a single repeated byte
+            size_t headerSize, size;
+            if (sizeFormat == 0 || sizeFormat == 2)
+            {
+                headerSize = 1;
+                size = src[0] >> 3;
+            }
+            else
+            {
+                headerSize = sizeFormat == 1 ? 2 : 3;
+                if (src.size() < headerSize)
+                    corrupt();
+                size = size_t(readLE(src.data(), headerSize) >> 4);
+            }
+            if (size > MAX_BLOCK_SIZE)
+                corrupt();
+
+            if (type == 0)
+            {
+                if (src.size() - headerSize < size)
+                    corrupt();
+                literals.assign(src.begin() + headerSize, src.begin() + headerSize + size);
+                return headerSize + size;
+            }
+            if (src.size() <= headerSize)
+                corrupt();
+            literals.assign(size, src[headerSize]);
+            return headerSize + 1;
+        }
+
+        // Huffman coded, with a new tree or the one of the previous block
+        static constexpr uint32 HEADER_SIZES[] = {3, 3, 4, 5};
+        static constexpr uint32 SIZE_BITS[] = {10, 10, 14, 18};
+        size_t const headerSize = HEADER_SIZES[sizeFormat];
+        if (src.size() < headerSize)
+            corrupt();
+        uint64 const header = readLE(src.data(), headerSize) >> 4;
+        uint32 const bits = SIZE_BITS[sizeFormat];
+        auto const size = size_t(header & ((1u << bits) - 1));
+        auto const compressedSize = size_t(header >> bits);
+        bool const fourStreams = sizeFormat != 0;
+        if (size > MAX_BLOCK_SIZE || src.size() - headerSize < compressedSize)
+            corrupt();
+
+        std::span<const uchar> data = src.subspan(headerSize, compressedSize);
+        if (type == 2)
+            data = data.subspan(std::min(data.size(), state.literals.read(data)));
+        else if (!state.literals.isValid())
+            corrupt();
+
+        literals.resize(size);
+        if (!fourStreams)
+            state.literals.decodeStream(data, literals.data(), size);
+        else
+        {
+            if (data.size() < 6)
+                corrupt();
+            size_t const sizes[3] = {size_t(readLE(data.data(), 2)), size_t(readLE(data.data() + 2, 2)),
+                                     size_t(readLE(data.data() + 4, 2))};
+            size_t offset = 6;
+            size_t const streamSize = (size + 3) / 4;
+            if (size < 3 * streamSize)
+                corrupt();
+            for (uint32 i = 0; i < 4; ++i)
+            {
+                size_t const length = i < 3 ? sizes[i] : data.size() - std::min(data.size(), offset);
+                if (offset + length > data.size())
+                    corrupt();
+                size_t const count = i < 3 ? streamSize : size - 3 * streamSize;
+                state.literals.decodeStream(data.subspan(offset, length), literals.data() + i * streamSize, count);
+                offset += length;
+            }
+        }
+        return headerSize + compressedSize;
+    }
+
+    // reads the table of one sequence field according to its compression mode, returns the bytes it took
+    auto readSequenceTable(std::span<const uchar> src, uint32 mode, FSETable& table, std::span<const int16> defaults,
+                           uint32 defaultLog, uint32 maxLog, uint32 maxSymbol, bool& valid) -> size_t
+    {
+        switch (mode)
+        {
+        case 0: // predefined
+            table.build(defaults, defaultLog);
+            valid = true;
+            return 0;
+        case 1: // a single symbol
+            if (src.empty() || src[0] > maxSymbol)
+                corrupt();
+            table.buildRLE(src[0]);
+            valid = true;
+            return 1;
+        case 2: // described in the block
+        {
+            size_t const size = table.read(src, maxLog, maxSymbol);
+            valid = true;
+            return size;
+        }
+        default: // the table of the previous block
+            if (!valid)
+                corrupt();
+            return 0;
+        }
+    }
+
+    struct SequenceTables
+    {
+        bool literalsLength{false}, offset{false}, matchLength{false};
+    };
+
+    void decodeBlock(std::span<const uchar> src, FrameState& state, SequenceTables& valid, uchar* frameStart,
+                     uchar*& out, uchar* end)
+    {
+        std::vector<uchar> literals;
+        size_t position = decodeLiterals(src, state, literals);
+        if (position >= src.size())
+            corrupt();
+
+        // number of sequences
+        size_t count = src[position++];
+        if (count >= 128)
+        {
+            if (position >= src.size())
+                corrupt();
+            if (count < 255)
+                count = ((count - 128) << 8) + src[position++];
+            else
+            {
+                if (position + 1 >= src.size())
+                    corrupt();
+                count = src[position] + (size_t(src[position + 1]) << 8) + 0x7F00;
+                position += 2;
+            }
+        }
+
+        const uchar* literal = literals.data();
+        const uchar* const literalsEnd = literal + literals.size();
+        if (count > 0)
+        {
+            if (position >= src.size())
+                corrupt();
+            uint32 const modes = src[position++];
+            if (modes & 3)
+                corrupt();
+
+            position += readSequenceTable(src.subspan(position), modes >> 6, state.literalsLength,
+                                          DEFAULT_LITERALS_LENGTH, 6, 9, 35, valid.literalsLength);
+            position += readSequenceTable(src.subspan(std::min(position, src.size())), (modes >> 4) & 3, state.offset,
+                                          DEFAULT_OFFSET, 5, 8, MAX_OFFSET_CODE, valid.offset);
+            position += readSequenceTable(src.subspan(std::min(position, src.size())), (modes >> 2) & 3,
+                                          state.matchLength, DEFAULT_MATCH_LENGTH, 6, 9, 52, valid.matchLength);
+            if (position > src.size())
+                corrupt();
+
+            BackwardBitReader bits(src.subspan(position));
+            FSEState literalsLength(state.literalsLength, bits);
+            FSEState offset(state.offset, bits);
+            FSEState matchLength(state.matchLength, bits);
+            auto& repeat = state.repeatOffsets;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                uint32 const offsetCode = offset.symbol();
+                uint32 const matchLengthCode = matchLength.symbol();
+                uint32 const literalsLengthCode = literalsLength.symbol();
+                if (offsetCode > MAX_OFFSET_CODE || matchLengthCode >= MATCH_LENGTH_CODES.size() ||
+                    literalsLengthCode >= LITERALS_LENGTH_CODES.size())
+                    corrupt();
+
+                auto const offsetValue = size_t((uint64(1) << offsetCode) + bits.read(offsetCode));
+                const auto& ml = MATCH_LENGTH_CODES[matchLengthCode];
+                size_t const matchSize = ml.baseline + size_t(bits.read(ml.extraBits));
+                const auto& ll = LITERALS_LENGTH_CODES[literalsLengthCode];
+                size_t const literalsSize = ll.baseline + size_t(bits.read(ll.extraBits));
+
+                size_t distance;
+                if (offsetValue > 3)
+                {
+                    distance = offsetValue - 3;
+                    repeat = {distance, repeat[0], repeat[1]};
+                }
+                else
+                {
+                    // without literals the repeat offsets shift by one
+                    size_t const index = offsetValue - 1 + (literalsSize == 0 ? 1 : 0);
+                    distance = index == 3 ? repeat[0] - 1 : repeat[index];
+                    if (index == 1)
+                        repeat = {distance, repeat[0], repeat[2]};
+                    else if (index > 1)
+                        repeat = {distance, repeat[0], repeat[1]};
+                }
+
+                if (i + 1 < count)
+                {
+                    literalsLength.update(bits);
+                    matchLength.update(bits);
+                    offset.update(bits);
+                }
+
+                // execute the sequence
+                if (literalsSize > size_t(literalsEnd - literal) || literalsSize + matchSize > size_t(end - out) ||
+                    distance == 0 || distance > size_t(out - frameStart) + literalsSize)
+                    corrupt();
+                out = std::copy_n(literal, literalsSize, out);
+                literal += literalsSize;
+                // the match may overlap the bytes it produces
+                const uchar* match = out - distance;
+                for (size_t j = 0; j < matchSize; ++j)
+                    out[j] = match[j];
+                out += matchSize;
+            }
+            if (bits.getBitsLeft() != 0)
+                corrupt();
+        }
+        else if (position != src.size())
+            corrupt();
+
+        if (size_t(literalsEnd - literal) > size_t(end - out))
+            corrupt();
+        out = std::copy(literal, literalsEnd, out);
+    }
+
+    auto xxHash64(const uchar* data, size_t size) -> uint64
+    {
+        constexpr uint64 PRIME1 = 0x9E3779B185EBCA87ull, PRIME2 = 0xC2B2AE3D27D4EB4Full,
+                         PRIME3 = 0x165667B19E3779F9ull, PRIME4 = 0x85EBCA77C2B2AE63ull,
+                         PRIME5 = 0x27D4EB2F165667C5ull;
+        auto round = [](uint64 acc, uint64 input) { return std::rotl(acc + input * PRIME2, 31) * PRIME1; };
+        auto merge = [&](uint64 acc, uint64 value) { return (acc ^ round(0, value)) * PRIME1 + PRIME4; };
+
+        const uchar* p = data;
+        const uchar* const end = data + size;
+        uint64 hash;
+        if (size >= 32)
+        {
+            uint64 v[4] = {PRIME1 + PRIME2, PRIME2, 0, 0 - PRIME1};
+            for (; end - p >= 32; p += 32)
+                for (int i = 0; i < 4; ++i)
+                    v[i] = round(v[i], readLE(p + 8 * i, 8));
+            hash = std::rotl(v[0], 1) + std::rotl(v[1], 7) + std::rotl(v[2], 12) + std::rotl(v[3], 18);
+            for (uint64 lane : v)
+                hash = merge(hash, lane);
+        }
+        else
+            hash = PRIME5;
+
+        hash += size;
+        for (; end - p >= 8; p += 8)
+            hash = std::rotl(hash ^ round(0, readLE(p, 8)), 27) * PRIME1 + PRIME4;
+        if (end - p >= 4)
+        {
+            hash = std::rotl(hash ^ (readLE(p, 4) * PRIME1), 23) * PRIME2 + PRIME3;
+            p += 4;
+        }
+        for (; p < end; ++p)
+            hash = std::rotl(hash ^ (*p * PRIME5), 11) * PRIME1;
+
+        hash ^= hash >> 33;
+        hash *= PRIME2;
+        hash ^= hash >> 29;
+        hash *= PRIME3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    // decodes the frame at the start of src, returns the bytes it took
+    auto decodeFrame(std::span<const uchar> src, uchar*& out, uchar* end) -> size_t
+    {
+        if (src.size() < 6)
+            corrupt();
+        uint32 const descriptor = src[4];
+        uint32 const contentSizeFlag = descriptor >> 6;
+        bool const singleSegment = descriptor & 0x20;
+        bool const hasChecksum = descriptor & 4;
+        uint32 const dictionaryFlag = descriptor & 3;
+        if (descriptor & 8)
+            corrupt();
+
+        size_t position = 5 + (singleSegment ? 0 : 1);
+        static constexpr size_t DICTIONARY_ID_SIZES[] = {0, 1, 2, 4};
+        size_t const dictionarySize = DICTIONARY_ID_SIZES[dictionaryFlag];
+        if (position + dictionarySize > src.size())
+            corrupt();
+        if (readLE(src.data() + position, dictionarySize) != 0)
+        {
+            OGRE_EXCEPT(ExceptionCodes::NOT_IMPLEMENTED, "zstd frames with a dictionary are not supported",
+                        "zstdDecompress");
+        }
+        position += dictionarySize;
+
+        static constexpr size_t CONTENT_SIZE_SIZES[] = {0, 2, 4, 8};
+        size_t const contentSizeSize = contentSizeFlag == 0 && singleSegment ? 1 : CONTENT_SIZE_SIZES[contentSizeFlag];
+        if (position + contentSizeSize > src.size())
+            corrupt();
+        uint64 contentSize = readLE(src.data() + position, contentSizeSize);
+        if (contentSizeSize == 2)
+            contentSize += 256;
+        position += contentSizeSize;
+        if (contentSizeSize && contentSize > uint64(end - out))
+            corrupt();
+
+        uchar* const frameStart = out;
+        FrameState state;
+        SequenceTables valid;
+        for (bool last = false; !last;)
+        {
+            if (position + 3 > src.size())
+                corrupt();
+            auto const header = uint32(readLE(src.data() + position, 3));
+            position += 3;
+            last = header & 1;
+            uint32 const type = (header >> 1) & 3;
+            size_t const size = header >> 3;
+            if (size > MAX_BLOCK_SIZE)
+                corrupt();
+
+            switch (type)
+            {
+            case 0: // raw
+                if (size > src.size() - position || size > size_t(end - out))
+                    corrupt();
+                out = std::copy_n(src.data() + position, size, out);
+                position += size;
+                break;
+            case 1: // a single repeated byte
+                if (position >= src.size() || size > size_t(end - out))
+                    corrupt();
+                out = std::fill_n(out, size, src[position]);
+                position += 1;
+                break;
+            case 2:
+                if (size > src.size() - position)
+                    corrupt();
+                decodeBlock(src.subspan(position, size), state, valid, frameStart, out, end);
+                position += size;
+                break;
+            default:
+                corrupt();
+            }
+        }
+
+        if (contentSizeSize && uint64(out - frameStart) != contentSize)
+            corrupt();
+        if (hasChecksum)
+        {
+            if (position + 4 > src.size())
+                corrupt();
+            if (uint32(xxHash64(frameStart, size_t(out - frameStart))) != uint32(readLE(src.data() + position, 4)))
+                corrupt();
+            position += 4;
+        }
+        return position;
+    }
+
+    void writeLE(std::vector<uchar>& out, uint64 value, size_t bytes)
+    {
+        for (size_t i = 0; i < bytes; ++i)
+            out.push_back(uchar(value >> (8 * i)));
+    }
+
+    // bits written least significant first, for BackwardBitReader to read from the end
+    class BitWriter
+    {
+    public:
+        explicit BitWriter(std::vector<uchar>& out) : mOut(out) {}
+
+        // at most 32 bits
+        void write(uint64 value, uint32 count)
+        {
+            mBits |= (value & ((uint64(1) << count) - 1)) << mCount;
+            mCount += count;
+            for (; mCount >= 8; mCount -= 8)
+            {
+                mOut.push_back(uchar(mBits));
+                mBits >>= 8;
+            }
+        }
+        // the set bit the reader starts from, padded to a whole byte
+        void close()
+        {
+            write(1, 1);
+            if (mCount)
+                mOut.push_back(uchar(mBits));
+            mBits = 0;
+            mCount = 0;
+        }
+
+    private:
+        std::vector<uchar>& mOut;
+        uint64 mBits{0};
+        uint32 mCount{0};
+    };
+
+    // finite state entropy encoding table, producing the states FSETable decodes
+    struct FSEEncoder
+    {
+        struct Transform
+        {
+            int32 deltaFindState;
+            uint32 deltaNumBits;
+        };
+        uint32 accuracyLog;
+        std::vector<uint16> states;
+        std::vector<Transform> symbols;
+
+        FSEEncoder(std::span<const int16> probabilities, uint32 log) : accuracyLog(log)
+        {
+            uint32 const size = 1u << log;
+
+            // the same spread as FSETable::build
+            std::vector<uint16> spread(size);
+            uint32 highThreshold = size - 1;
+            for (size_t s = 0; s < probabilities.size(); ++s)
+            {
+                if (probabilities[s] == -1)
+                    spread[highThreshold--] = uint16(s);
+            }
+            uint32 const step = (size >> 1) + (size >> 3) + 3;
+            uint32 position = 0;
+            for (size_t s = 0; s < probabilities.size(); ++s)
+            {
+                for (int16 i = 0; i < probabilities[s]; ++i)
+                {
+                    spread[position] = uint16(s);
+                    do
+                        position = (position + step) & (size - 1);
+                    while (position > highThreshold);
+                }
+            }
+
+            // the states of each symbol in ascending order
+            std::vector<uint32> next(probabilities.size() + 1, 0);
+            for (size_t s = 0; s < probabilities.size(); ++s)
+                next[s + 1] = next[s] + uint32(probabilities[s] == -1 ? 1 : probabilities[s]);
+            states.resize(size);
+            for (uint32 u = 0; u < size; ++u)
+                states[next[spread[u]]++] = uint16(size + u);
+
+            symbols.resize(probabilities.size(), {0, ((log + 1) << 16) - size});
+            int32 total = 0;
+            for (size_t s = 0; s < probabilities.size(); ++s)
+            {
+                int32 const probability = probabilities[s];
+                if (probability == -1 || probability == 1)
+                {
+                    symbols[s] = {total - 1, (log << 16) - size};
+                    ++total;
+                }
+                else if (probability > 1)
+                {
+                    uint32 const maxBits = log + 1 - std::bit_width(uint32(probability - 1));
+                    symbols[s] = {total - probability, (maxBits << 16) - (uint32(probability) << maxBits)};
+                    total += probability;
+                }
+            }
+        }
+    };
+
+    class FSEEncoderState
+    {
+    public:
+        FSEEncoderState(const FSEEncoder& table, uint32 symbol) : mTable(table)
+        {
+            const auto& transform = table.symbols[symbol];
+            uint32 const numBits = (transform.deltaNumBits + (1 << 15)) >> 16;
+            uint32 const value = (numBits << 16) - transform.deltaNumBits;
+            mState = table.states[size_t(int32(value >> numBits) + transform.deltaFindState)];
+        }
+
+        void encode(BitWriter& bits, uint32 symbol)
+        {
+            const auto& transform = mTable.symbols[symbol];
+            uint32 const numBits = (mState + transform.deltaNumBits) >> 16;
+            bits.write(mState, numBits);
+            mState = mTable.states[size_t(int32(mState >> numBits) + transform.deltaFindState)];
+        }
+        void flush(BitWriter& bits) { bits.write(mState, mTable.accuracyLog); }
+
+    private:
+        const FSEEncoder& mTable;
+        uint32 mState;
+    };
+
+    // the last code whose baseline does not exceed value
+    template<size_t N>
+    auto findCode(const std::array<SequenceCode, N>& codes, size_t value) -> uint32
+    {
+        auto const next = std::ranges::upper_bound(codes, value, {}, &SequenceCode::baseline);
+        return uint32(next - codes.begin() - 1);
+    }
+
+    struct Sequence
+    {
+        uint32 literalsSize;
+        uint32 matchSize;
+        uint32 distance;
+    };
+
+    // a compressed block with raw literals and the sequences coded with the predefined tables
+    void encodeBlock(std::span<const uchar> literals, std::span<const Sequence> sequences, std::vector<uchar>& out)
+    {
+        size_t const literalsSize = literals.size();
+        if (literalsSize < 32)
+            out.push_back(uchar(literalsSize << 3));
+        else if (literalsSize < 4096)
+            writeLE(out, (literalsSize << 4) | (1 << 2), 2);
+        else
+            writeLE(out, (literalsSize << 4) | (3 << 2), 3);
+        out.insert(out.end(), literals.begin(), literals.end());
+
+        size_t const count = sequences.size();
+        if (count < 128)
+            out.push_back(uchar(count));
+        else if (count < 0x7F00)
+            writeLE(out, ((count >> 8) + 128) | ((count & 255) << 8), 2);
+        else
+        {
+            out.push_back(255);
+            writeLE(out, count - 0x7F00, 2);
+        }
+        if (count == 0)
+            return;
+        out.push_back(0);
+
+        static const FSEEncoder literalsLengthTable{DEFAULT_LITERALS_LENGTH, 6};
+        static const FSEEncoder offsetTable{DEFAULT_OFFSET, 5};
+        static const FSEEncoder matchLengthTable{DEFAULT_MATCH_LENGTH, 6};
+
+        struct Codes
+        {
+            uint32 literalsLength, matchLength, offset;
+        };
+        std::vector<Codes> codes(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            // distances are coded as new offsets, the repeat offsets are never referenced
+            codes[i] = {findCode(LITERALS_LENGTH_CODES, sequences[i].literalsSize),
+                        findCode(MATCH_LENGTH_CODES, sequences[i].matchSize),
+                        uint32(std::bit_width(sequences[i].distance + 3u) - 1)};
+        }
+
+        // written back to front, in the reverse order decodeBlock reads
+        BitWriter bits(out);
+        auto writeExtraBits = [&](size_t i)
+        {
+            const auto& ll = LITERALS_LENGTH_CODES[codes[i].literalsLength];
+            bits.write(sequences[i].literalsSize - ll.baseline, ll.extraBits);
+            const auto& ml = MATCH_LENGTH_CODES[codes[i].matchLength];
+            bits.write(sequences[i].matchSize - ml.baseline, ml.extraBits);
+            bits.write(sequences[i].distance + 3u, codes[i].offset);
+        };
+        FSEEncoderState matchLength(matchLengthTable, codes.back().matchLength);
+        FSEEncoderState offset(offsetTable, codes.back().offset);
+        FSEEncoderState literalsLength(literalsLengthTable, codes.back().literalsLength);
+        writeExtraBits(count - 1);
+        for (size_t i = count - 1; i-- > 0;)
+        {
+            offset.encode(bits, codes[i].offset);
+            matchLength.encode(bits, codes[i].matchLength);
+            literalsLength.encode(bits, codes[i].literalsLength);
+            writeExtraBits(i);
+        }
+        matchLength.flush(bits);
+        offset.flush(bits);
+        literalsLength.flush(bits);
+        bits.close();
+    }
+}
+    //-----------------------------------------------------------------------
+    void zstdDecompress(std::span<const uchar> src, std::span<uchar> dest)
+    {
+        uchar* out = dest.data();
+        uchar* const end = dest.data() + dest.size();
+        while (!src.empty())
+        {
+            if (src.size() < 8)
+                corrupt();
+            auto const magic = uint32(readLE(src.data(), 4));
+            size_t size;
+            if ((magic & 0xFFFFFFF0) == 0x184D2A50)
+            {
+                // skippable frame
+                size = 8 + size_t(readLE(src.data() + 4, 4));
+                if (size > src.size())
+                    corrupt();
+            }
+            else if (magic == 0xFD2FB528)
+                size = decodeFrame(src, out, end);
+            else
+                corrupt();
+            src = src.subspan(size);
+        }
+        if (out != end)
+            corrupt();
+    }
+    //-----------------------------------------------------------------------
+    auto zstdCompress(std::span<const uchar> src) -> std::vector<uchar>
+    {
+        constexpr size_t MIN_MATCH = 4;
+        constexpr uint32 HASH_BITS = 16;
+        // keeps the offset codes within the predefined table
+        constexpr size_t MAX_DISTANCE = size_t(1) << 27;
+        constexpr size_t NO_POSITION = ~size_t(0);
+
+        std::vector<uchar> out;
+        writeLE(out, 0xFD2FB528, 4);
+        // a single segment, so the window is the whole content and its size is stored
+        size_t const size = src.size();
+        uint32 const contentSizeFlag = size < 256 ? 0 : size < 65536 + 256 ? 1 : size <= 0xFFFFFFFFu ? 2 : 3;
+        static constexpr size_t CONTENT_SIZE_SIZES[] = {1, 2, 4, 8};
+        out.push_back(uchar(contentSizeFlag << 6 | 0x20));
+        writeLE(out, contentSizeFlag == 1 ? size - 256 : size, CONTENT_SIZE_SIZES[contentSizeFlag]);
+
+        auto read32 = [&](size_t position) { return uint32(readLE(src.data() + position, 4)); };
+        std::vector<size_t> lastPosition(size_t(1) << HASH_BITS, NO_POSITION);
+        std::vector<uchar> literals;
+        std::vector<Sequence> sequences;
+        std::vector<uchar> block;
+        size_t position = 0;
+        do
+        {
+            size_t const blockEnd = std::min(size, position + MAX_BLOCK_SIZE);
+            literals.clear();
+            sequences.clear();
+
+            // greedy matching against the most recent position with the same hash
+            size_t anchor = position;
+            for (size_t i = position; i + MIN_MATCH <= blockEnd;)
+            {
+                uint32 const value = read32(i);
+                size_t& slot = lastPosition[(value * 2654435761u) >> (32 - HASH_BITS)];
+                size_t const candidate = slot;
+                slot = i;
+                if (candidate == NO_POSITION || i - candidate > MAX_DISTANCE || read32(candidate) != value)
+                {
+                    ++i;
+                    continue;
+                }
+
+                size_t length = MIN_MATCH;
+                while (i + length < blockEnd && src[candidate + length] == src[i + length])
+                    ++length;
+                literals.insert(literals.end(), src.begin() + anchor, src.begin() + i);
+                sequences.push_back({uint32(i - anchor), uint32(length), uint32(i - candidate)});
+                i += length;
+                anchor = i;
+            }
+            literals.insert(literals.end(), src.begin() + anchor, src.begin() + blockEnd);
+
+            block.clear();
+            encodeBlock(literals, sequences, block);
+            bool const last = blockEnd == size;
+            size_t const rawSize = blockEnd - position;
+            if (block.size() < rawSize)
+            {
+                writeLE(out, uint32(last) | 2 << 1 | block.size() << 3, 3);
+                out.insert(out.end(), block.begin(), block.end());
+            }
+            else
+            {
+                writeLE(out, uint32(last) | rawSize << 3, 3);
+                out.insert(out.end(), src.begin() + position, src.begin() + blockEnd);
+            }
+            position = blockEnd;
+        } while (position < size);
+        return out;
+    }
+}
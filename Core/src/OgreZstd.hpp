@@ -0,0 +1,58 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module Ogre.Core:Zstd;
+
+import :Platform;
+import :Prerequisites;
+
+import <span>;
+import <vector>;
+
+// internal Zstandard coder for supercompressed images and OgrePack entries
+namespace Ogre {
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Image
+    *  @{
+    */
+
+// Decompresses the Zstandard frames (RFC 8878) in src into dest, which must have exactly the
+// size of the decompressed content. Skippable frames are skipped and content checksums are
+// verified. Frames needing a dictionary are not supported.
+// Throws InvalidParametersException if the data is corrupt or does not fill dest.
+void zstdDecompress(std::span<const uchar> src, std::span<uchar> dest);
+
+// Compresses src into a single Zstandard frame. Matches are found greedily and coded with the
+// predefined sequence tables, the literals are stored raw, so the ratio is between LZ4 and
+// the reference encoder at its lowest level. Blocks that do not get smaller are stored.
+auto zstdCompress(std::span<const uchar> src) -> std::vector<uchar>;
+
+    /** @} */
+    /** @} */
+}
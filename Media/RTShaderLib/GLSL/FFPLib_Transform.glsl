@@ -108,6 +108,27 @@ void FFP_Transform(in mat4 m,
 #endif
 }
 
+//-----------------------------------------------------------------------------
+// Octahedral encoded direction in v.xy, see VertexElement::encodeOctahedral
+void FFP_DecodeOctahedral(in vec3 v,
+                          out vec3 vOut)
+{
+	vec3 n = vec3(v.xy, 1.0 - abs(v.x) - abs(v.y));
+	float t = max(-n.z, 0.0);
+	n.x += n.x >= 0.0 ? -t : t;
+	n.y += n.y >= 0.0 ? -t : t;
+	vOut = normalize(n);
+}
+
+//-----------------------------------------------------------------------------
+void FFP_DecodeOctahedral(in vec4 v,
+                          out vec4 vOut)
+{
+	vec3 n;
+	FFP_DecodeOctahedral(v.xyz, n);
+	vOut = vec4(n, v.w);
+}
+
 //-----------------------------------------------------------------------------
 void FFP_DerivePointSize(in vec4 params,
                          in float d,
@@ -64,6 +64,9 @@ namespace Ogre {
         [[nodiscard]] auto encode(const MemoryDataStreamPtr& input, const CodecDataPtr& pData) const -> DataStreamPtr override;
         void encodeToFile(const MemoryDataStreamPtr& input, std::string_view outFileName, const CodecDataPtr& pData) const override;
         [[nodiscard]] auto decode(const DataStreamPtr& input) const -> DecodeResult  override;
+        /// Only non interlaced PNG images are decoded scanline by scanline
+        [[nodiscard]] auto decodeHeader(const DataStreamPtr& input, ImageData& header) const -> bool override;
+        void decodeInto(const DataStreamPtr& input, const PixelBox& dst) const override;
 
         [[nodiscard]] auto getType() const -> std::string_view override;
         auto magicNumberToFileExt(const char *magicNumberPtr, size_t maxbytes) const -> std::string_view override;
@@ -28,6 +28,7 @@ THE SOFTWARE.
 module;
 
 #include <cstdlib>
+#include <cstring>
 #define STBI_NO_STDIO
 #define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_STATIC
@@ -44,10 +45,14 @@ module Ogre.PlugIns.STBICodec;
 
 import Ogre.Core;
 
+import <algorithm>;
+import <array>;
 import <format>;
+import <limits>;
 import <memory>;
 import <ostream>;
 import <string>;
+import <string_view>;
 import <utility>;
 import <vector>;
 
@@ -67,6 +72,339 @@ extern "C" auto custom_zlib_compress(Ogre::uchar* data, int data_len, int* out_l
 }
 
 namespace Ogre {
+namespace {
+    // the encoded bytes of a stream, referenced in place if the stream already holds them in memory
+    struct EncodedData
+    {
+        ::std::shared_ptr<uchar> shared;
+        String contents;
+        const uchar* data{nullptr};
+        size_t size{0};
+
+        explicit EncodedData(const DataStreamPtr& input)
+            : shared{input->getSharedData()}, data{shared.get()}, size{input->size()}
+        {
+            if (!data)
+            {
+                if (auto memory = dynamic_cast<MemoryDataStream*>(input.get()))
+                    data = memory->getPtr();
+            }
+            if (!data)
+            {
+                contents = input->getAsString();
+                data = reinterpret_cast<const uchar*>(contents.data());
+                size = contents.size();
+            }
+        }
+    };
+
+    auto readBE32(const uchar* p) -> uint32
+    {
+        return uint32(p[0]) << 24 | uint32(p[1]) << 16 | uint32(p[2]) << 8 | uint32(p[3]);
+    }
+
+    auto readBE16(const uchar* p) -> uint32 { return uint32(p[0]) << 8 | uint32(p[1]); }
+
+    auto paeth(int a, int b, int c) -> int
+    {
+        int p = a + b - c;
+        int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+        if (pa <= pb && pa <= pc)
+            return a;
+        return pb <= pc ? b : c;
+    }
+
+    /** Scanline decoder for non interlaced PNG images.
+
+        Inflates the image data one row at a time, so only the previous and the current row are
+        held in memory. Produces the same pixels and format as stb_image: samples are reduced to
+        8 bits, palettes are expanded and tRNS chunks add an alpha channel. Interlaced and Apple
+        CgBI images are left to stb_image.
+    */
+    class PNGScanlineDecoder
+    {
+        const uchar* mData{nullptr};
+        size_t mSize{0};
+        /// offset of the first IDAT chunk
+        size_t mImageData{0};
+
+        uint32 mWidth{0};
+        uint32 mHeight{0};
+        uint32 mBitDepth{0};
+        uint32 mColourType{0};
+        /// samples per pixel in the file
+        uint32 mChannels{0};
+        /// bytes per pixel of the decoded rows
+        uint32 mOutChannels{0};
+
+        std::array<uchar, 256 * 4> mPalette{};
+        uint32 mPaletteSize{0};
+        bool mPaletteAlpha{false};
+        /// tRNS colour key of grey and truecolour images, in file sample units
+        std::array<uint32, 3> mKey{};
+        bool mHasKey{false};
+
+        [[nodiscard]] auto getSample(const uchar* row, size_t index) const -> uint32
+        {
+            switch (mBitDepth)
+            {
+            case 16:
+                return readBE16(row + index * 2);
+            case 8:
+                return row[index];
+            default:
+                size_t const bit = index * mBitDepth;
+                return (row[bit / 8] >> (8 - mBitDepth - bit % 8)) & ((1u << mBitDepth) - 1);
+            }
+        }
+
+        [[nodiscard]] auto to8Bit(uint32 sample) const -> uchar
+        {
+            // same scaling as stb_image, high byte of 16 bit samples
+            static constexpr uchar scale[] = {0, 0xff, 0x55, 0, 0x11, 0, 0, 0, 0x01};
+            return mBitDepth == 16 ? uchar(sample >> 8) : uchar(sample * scale[mBitDepth]);
+        }
+
+        void expandRow(const uchar* row, uchar* out) const
+        {
+            for (uint32 x = 0; x < mWidth; ++x)
+            {
+                size_t const first = size_t(x) * mChannels;
+                if (mColourType == 3)
+                {
+                    const uchar* entry = &mPalette[getSample(row, first) * 4];
+                    std::copy_n(entry, mOutChannels, out);
+                }
+                else
+                {
+                    bool keyed = mHasKey;
+                    for (uint32 c = 0; c < mChannels; ++c)
+                    {
+                        uint32 const sample = getSample(row, first + c);
+                        keyed = keyed && sample == mKey[c];
+                        // palette style scaling only applies to grey
+                        out[c] = mBitDepth < 8 ? to8Bit(sample) : mBitDepth == 16 ? uchar(sample >> 8) : uchar(sample);
+                    }
+                    if (mHasKey)
+                        out[mChannels] = keyed ? 0 : 255;
+                }
+                out += mOutChannels;
+            }
+        }
+
+        static void unfilter(uchar filter, uchar* row, const uchar* prior, size_t size, size_t stride)
+        {
+            switch (filter)
+            {
+            case 0:
+                break;
+            case 1:
+                for (size_t i = stride; i < size; ++i)
+                    row[i] = uchar(row[i] + row[i - stride]);
+                break;
+            case 2:
+                for (size_t i = 0; i < size; ++i)
+                    row[i] = uchar(row[i] + prior[i]);
+                break;
+            case 3:
+                for (size_t i = 0; i < size; ++i)
+                    row[i] = uchar(row[i] + ((i >= stride ? row[i - stride] : 0) + prior[i]) / 2);
+                break;
+            case 4:
+                for (size_t i = 0; i < size; ++i)
+                    row[i] = uchar(row[i] + paeth(i >= stride ? row[i - stride] : 0, prior[i],
+                                                  i >= stride ? prior[i - stride] : 0));
+                break;
+            default:
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Corrupt PNG: invalid filter type",
+                            "STBIImageCodec::decodeInto");
+            }
+        }
+
+    public:
+        /// Parses the chunks up to the image data, returns false if the image is not supported
+        auto readHeader(const uchar* data, size_t size) -> bool
+        {
+            static constexpr uchar signature[] = {137, 80, 78, 71, 13, 10, 26, 10};
+            if (size < sizeof(signature) || memcmp(data, signature, sizeof(signature)) != 0)
+                return false;
+
+            mData = data;
+            mSize = size;
+            // entries the palette does not define are opaque black
+            for (size_t i = 3; i < mPalette.size(); i += 4)
+                mPalette[i] = 255;
+
+            for (size_t pos = sizeof(signature); pos + 12 <= size;)
+            {
+                uint32 const length = readBE32(data + pos);
+                if (length > size - pos - 12)
+                    return false;
+                std::string_view const type{reinterpret_cast<const char*>(data + pos + 4), 4};
+                const uchar* chunk = data + pos + 8;
+
+                if (type == "IHDR")
+                {
+                    if (length != 13)
+                        return false;
+                    mWidth = readBE32(chunk);
+                    mHeight = readBE32(chunk + 4);
+                    mBitDepth = chunk[8];
+                    mColourType = chunk[9];
+                    // compression, filter method and interlacing
+                    if (mWidth == 0 || mHeight == 0 || chunk[10] != 0 || chunk[11] != 0 || chunk[12] != 0)
+                        return false;
+
+                    static constexpr uint32 channels[] = {1, 0, 3, 1, 2, 0, 4};
+                    mChannels = mColourType < 7 ? channels[mColourType] : 0;
+                    bool const lowDepth = mBitDepth == 1 || mBitDepth == 2 || mBitDepth == 4;
+                    bool const validDepth = mBitDepth == 8 || (mBitDepth == 16 && mColourType != 3) ||
+                                            (lowDepth && (mColourType == 0 || mColourType == 3));
+                    if (mChannels == 0 || !validDepth)
+                        return false;
+
+                    // the dimension limit of stb, which also keeps the bits of a row within 32 bits
+                    constexpr uint32 MAX_DIMENSION = 1 << 24;
+                    if (mWidth > MAX_DIMENSION || mHeight > MAX_DIMENSION ||
+                        uint64(mWidth) * mChannels * mBitDepth > std::numeric_limits<uint32>::max())
+                        return false;
+                }
+                else if (type == "PLTE")
+                {
+                    if (length == 0 || length % 3 != 0 || length / 3 > 256)
+                        return false;
+                    mPaletteSize = length / 3;
+                    for (uint32 i = 0; i < mPaletteSize; ++i)
+                        std::copy_n(chunk + i * 3, 3, &mPalette[i * 4]);
+                }
+                else if (type == "tRNS")
+                {
+                    if (mColourType == 3 && length <= mPaletteSize)
+                    {
+                        for (uint32 i = 0; i < length; ++i)
+                            mPalette[i * 4 + 3] = chunk[i];
+                        mPaletteAlpha = true;
+                    }
+                    else if ((mColourType == 0 || mColourType == 2) && length == mChannels * 2)
+                    {
+                        for (uint32 c = 0; c < mChannels; ++c)
+                            mKey[c] = readBE16(chunk + c * 2);
+                        mHasKey = true;
+                    }
+                    else
+                        return false;
+                }
+                else if (type == "IDAT")
+                {
+                    if (mChannels == 0 || (mColourType == 3 && mPaletteSize == 0))
+                        return false;
+                    mImageData = pos;
+                    break;
+                }
+                else if (type == "IEND" || type == "CgBI")
+                    return false;
+
+                pos += 12 + length;
+            }
+            if (mImageData == 0)
+                return false;
+
+            mOutChannels = mColourType == 3 ? (mPaletteAlpha ? 4 : 3) : mChannels + (mHasKey ? 1 : 0);
+            return true;
+        }
+
+        void getHeader(ImageCodec::ImageData& header) const
+        {
+            static constexpr PixelFormat formats[] = {PixelFormat::BYTE_L, PixelFormat::BYTE_LA,
+                                                      PixelFormat::BYTE_RGB, PixelFormat::BYTE_RGBA};
+            header.width = mWidth;
+            header.height = mHeight;
+            header.depth = 1;
+            header.num_mipmaps = {};
+            header.flags = {};
+            header.format = formats[mOutChannels - 1];
+            header.size = size_t(mWidth) * mHeight * mOutChannels;
+        }
+
+        /// Decodes row by row, converting each to the format of dst
+        void decode(const PixelBox& dst) const
+        {
+            if (dst.getWidth() != mWidth || dst.getHeight() != mHeight || dst.getDepth() != 1)
+                OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Destination size does not match the image",
+                            "STBIImageCodec::decodeInto");
+
+            ImageCodec::ImageData header;
+            getHeader(header);
+
+            size_t const rowSize = (size_t(mWidth) * mChannels * mBitDepth + 7) / 8;
+            size_t const stride = std::max<size_t>(1, mChannels * mBitDepth / 8);
+            // 8 bit rows without a colour key already are in the output format
+            bool const expand = mBitDepth != 8 || mColourType == 3 || mHasKey;
+
+            // filter type byte followed by the row, the prior row starts out as zeros
+            std::vector<uchar> current(rowSize + 1), prior(rowSize + 1);
+            std::vector<uchar> expanded(expand ? size_t(mWidth) * mOutChannels : 0);
+
+            z_stream zs{};
+            if (inflateInit(&zs) != Z_OK)
+                OGRE_EXCEPT(ExceptionCodes::INTERNAL_ERROR, "inflateInit failed", "STBIImageCodec::decodeInto");
+            struct InflateEnd
+            {
+                z_stream& zs;
+                ~InflateEnd() { inflateEnd(&zs); }
+            } inflateEnd{zs};
+
+            // the image data may be split over consecutive IDAT chunks
+            size_t pos = mImageData;
+            auto nextChunk = [&]() -> bool
+            {
+                if (pos + 12 > mSize || std::string_view{reinterpret_cast<const char*>(mData + pos + 4), 4} != "IDAT")
+                    return false;
+                uint32 const length = readBE32(mData + pos);
+                if (length > mSize - pos - 12)
+                    return false;
+                zs.next_in = const_cast<uchar*>(mData + pos + 8);
+                zs.avail_in = length;
+                pos += 12 + length;
+                return true;
+            };
+
+            size_t const dstPixelSize = PixelUtil::getNumElemBytes(dst.format);
+            uchar* dstRow = dst.getTopLeftFrontPixelPtr();
+            for (uint32 y = 0; y < mHeight; ++y)
+            {
+                zs.next_out = current.data();
+                zs.avail_out = uInt(current.size());
+                while (zs.avail_out > 0)
+                {
+                    if (zs.avail_in == 0 && !nextChunk())
+                        OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Corrupt PNG: image data is truncated",
+                                    "STBIImageCodec::decodeInto");
+                    int const ret = inflate(&zs, Z_NO_FLUSH);
+                    if (ret == Z_STREAM_END && zs.avail_out > 0)
+                        OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Corrupt PNG: image data is truncated",
+                                    "STBIImageCodec::decodeInto");
+                    if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+                        OGRE_EXCEPT(ExceptionCodes::INVALIDPARAMS, "Corrupt PNG: invalid image data",
+                                    "STBIImageCodec::decodeInto");
+                }
+
+                unfilter(current[0], current.data() + 1, prior.data() + 1, rowSize, stride);
+                uchar* row = current.data() + 1;
+                if (expand)
+                {
+                    expandRow(row, expanded.data());
+                    row = expanded.data();
+                }
+
+                // convert while the row is still in cache
+                PixelUtil::bulkPixelConversion(row, header.format, dstRow, dst.format, mWidth);
+                dstRow += dst.rowPitch * dstPixelSize;
+                std::swap(current, prior);
+            }
+        }
+    };
+}
 
     STBIImageCodec::RegisteredCodecList STBIImageCodec::msCodecList;
     //---------------------------------------------------------------------
@@ -169,11 +507,12 @@ namespace Ogre {
     //---------------------------------------------------------------------
     auto STBIImageCodec::decode(const DataStreamPtr& input) const -> ImageCodec::DecodeResult
     {
-        String contents = input->getAsString();
+        // decode in place if the stream already holds its contents in memory
+        EncodedData const encoded{input};
 
         int width, height, components;
-        stbi_uc* pixelData = stbi_load_from_memory((const uchar*)contents.data(),
-                static_cast<int>(contents.size()), &width, &height, &components, 0);
+        stbi_uc* pixelData = stbi_load_from_memory(encoded.data,
+                static_cast<int>(encoded.size), &width, &height, &components, 0);
 
         if (!pixelData)
         {
@@ -221,6 +560,32 @@ namespace Ogre {
         ret.second = imgData;
         return ret;
     }
+    //---------------------------------------------------------------------
+    auto STBIImageCodec::decodeHeader(const DataStreamPtr& input, ImageData& header) const -> bool
+    {
+        // stb_image can only decode whole images
+        if (mType != "png")
+            return false;
+
+        EncodedData const encoded{input};
+        PNGScanlineDecoder decoder;
+        if (!decoder.readHeader(encoded.data, encoded.size))
+            return false;
+        decoder.getHeader(header);
+        return true;
+    }
+    //---------------------------------------------------------------------
+    void STBIImageCodec::decodeInto(const DataStreamPtr& input, const PixelBox& dst) const
+    {
+        EncodedData const encoded{input};
+        PNGScanlineDecoder decoder;
+        if (mType != "png" || !decoder.readHeader(encoded.data, encoded.size))
+        {
+            ImageCodec::decodeInto(input, dst);
+            return;
+        }
+        decoder.decode(dst);
+    }
     //---------------------------------------------------------------------    
     auto STBIImageCodec::getType() const -> std::string_view
     {
@@ -30,6 +30,10 @@ module;
 #include "glad/glad.h"
 #include <cassert>
 
+#ifndef GL_HALF_FLOAT
+#define GL_HALF_FLOAT 0x140B
+#endif
+
 module Ogre.RenderSystems.GL;
 
 import :HardwareBuffer;
@@ -70,6 +74,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     GLHardwareBufferManager::~GLHardwareBufferManager()
     {
+        destroyAllStreamingBuffers();
         destroyAllDeclarations();
         destroyAllBindings();
 
@@ -142,6 +147,11 @@ namespace Ogre {
             case USHORT2_NORM:
             case USHORT4_NORM:
                 return GL_UNSIGNED_SHORT;
+            case HALF1:
+            case HALF2:
+            case HALF3:
+            case HALF4:
+                return GL_HALF_FLOAT;
             default:
                 return 0;
         };
@@ -2948,6 +2948,7 @@ namespace Ogre {
             switch(elem.getType())
             {
             case UBYTE4_NORM:
+            case BYTE4_NORM:
             case SHORT2_NORM:
             case USHORT2_NORM:
             case SHORT4_NORM:
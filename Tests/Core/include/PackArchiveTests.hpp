@@ -0,0 +1,55 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <gtest/gtest.h>
+
+export module Ogre.Tests:Core.PackArchive;
+
+export import Ogre.Core;
+
+export
+class PackArchiveTests : public ::testing::Test
+{
+
+protected:
+    Ogre::PackArchiveFactory mFactory;
+    Ogre::Archive* mArch;
+    /// The ArchiveTest directory
+    Ogre::Archive* mSource;
+    Ogre::FileSystemArchiveFactory mSourceFactory;
+    Ogre::String mPackPath;
+
+    /// Pack the ArchiveTest directory and open the result
+    void pack(Ogre::PackCompression compression);
+    /// Write a pack whose only entry, "frames.zst", holds the given Zstandard frames and is size bytes, and open it
+    void packFrames(const std::vector<Ogre::uchar>& frames, size_t size);
+public:
+    void SetUp() override;
+    void TearDown() override;
+};
@@ -35,6 +35,7 @@ module Ogre.Tests;
 import Ogre.Core;
 
 import <initializer_list>;
+import <vector>;
 
 using namespace Ogre;
 //--------------------------------------------------------------------------
@@ -113,3 +114,23 @@ TEST(BitwiseTests,Half)
     }
 }
 //--------------------------------------------------------------------------
+TEST(BitwiseTests,BswapChunks)
+{
+    // odd counts and offsets cover the vector loops, their tails and unaligned access
+    for(size_t size : {2u, 3u, 4u, 8u})
+    {
+        for(size_t count : {0u, 1u, 7u, 33u, 257u})
+        {
+            std::vector<uint8> data(size * count + 1), expected;
+            for(size_t i = 0; i < data.size(); ++i)
+                data[i] = static_cast<uint8>(i * 37 + size);
+            expected = data;
+            for(size_t c = 0; c < count; ++c)
+                Bitwise::bswapBuffer(&expected[1 + c * size], size);
+
+            Bitwise::bswapChunks(&data[1], size, count);
+            EXPECT_EQ(data, expected) << size << " byte chunks, count " << count;
+        }
+    }
+}
+//--------------------------------------------------------------------------
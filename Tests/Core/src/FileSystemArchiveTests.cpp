@@ -29,6 +29,9 @@ module;
 
 #include <gtest/gtest.h>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 module Ogre.Tests;
 
 import :Core.FileSystemArchive;
@@ -36,8 +39,11 @@ import :Core.FileSystemArchive;
 import Ogre.Core;
 
 import <algorithm>;
+import <filesystem>;
 import <format>;
+import <fstream>;
 import <map>;
+import <memory>;
 import <string>;
 import <utility>;
 import <vector>;
@@ -303,6 +309,101 @@ TEST_F(FileSystemArchiveTests,ReadInterleave)
     EXPECT_TRUE(stream2->eof());
 }
 //--------------------------------------------------------------------------
+TEST_F(FileSystemArchiveTests,FileReadAsync)
+{
+    String expected = mArch->open("rootfile2.txt")->getAsString();
+
+    FileSystemArchiveFactory::setAsyncStreams(true);
+    DataStreamPtr stream = mArch->open("rootfile.txt");
+    DataStreamPtr stream2 = mArch->open("rootfile2.txt");
+    FileSystemArchiveFactory::setAsyncStreams(false);
+
+    ASSERT_TRUE(dynamic_cast<AsyncFileDataStream*>(stream.get()));
+    EXPECT_EQ(String("this is line 1 in file 1"), stream->getLine());
+    EXPECT_EQ(String("this is line 2 in file 1"), stream->getLine());
+    EXPECT_EQ(String("this is line 3 in file 1"), stream->getLine());
+    EXPECT_EQ(String("this is line 4 in file 1"), stream->getLine());
+    EXPECT_EQ(String("this is line 5 in file 1"), stream->getLine());
+    EXPECT_EQ(BLANKSTRING, stream->getLine()); // blank at end of file
+    EXPECT_TRUE(stream->eof());
+
+    static_cast<AsyncFileDataStream*>(stream2.get())->prefetch(0, stream2->size());
+    EXPECT_EQ(expected, stream2->getAsString());
+}
+//--------------------------------------------------------------------------
+TEST_F(FileSystemArchiveTests,FileReadAsyncBlocks)
+{
+    // many small blocks, the last one partial
+    size_t const blockSize = 4096;
+    std::vector<uchar> contents(10 * blockSize + 1234);
+    for (size_t i = 0; i < contents.size(); ++i)
+        contents[i] = uchar(i * 7 + i / blockSize);
+    String path = (std::filesystem::temp_directory_path() / "FileReadAsyncBlocks.bin").string();
+    std::ofstream{path, std::ios::binary}.write(reinterpret_cast<const char*>(contents.data()),
+                                                std::streamsize(contents.size()));
+
+    for (auto backend : {AsyncIOService::Backend::IO_URING, AsyncIOService::Backend::THREAD_POOL})
+    {
+        // a shallow queue makes the submissions wait for free slots
+        AsyncIOService service{backend, 4};
+        SCOPED_TRACE(::std::format("backend {}", int(service.getBackend())));
+        auto open = [&]
+        {
+            return std::make_unique<AsyncFileDataStream>("FileReadAsyncBlocks.bin", ::open(path.c_str(), O_RDONLY),
+                                                         contents.size(), service, blockSize, 3);
+        };
+
+        // the first read of a block crossing the end comes back short, the one resubmitted for the rest is empty
+        {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            ASSERT_GE(fd, 0);
+            std::vector<uchar> tail(blockSize);
+            EXPECT_EQ(100u, service.submit(AsyncIOService::Read{fd, contents.size() - 100, tail.data(), tail.size(), nullptr})->wait());
+            EXPECT_TRUE(std::equal(contents.end() - 100, contents.end(), tail.begin()));
+            ::close(fd);
+        }
+
+        // small sequential reads run on the read-ahead blocks
+        {
+            auto stream = open();
+            std::vector<uchar> read(contents.size());
+            for (size_t pos = 0; pos < read.size();)
+            {
+                size_t n = stream->read(read.data() + pos, std::min<size_t>(1000, read.size() - pos));
+                ASSERT_GT(n, 0u);
+                pos += n;
+            }
+            EXPECT_TRUE(stream->eof());
+            EXPECT_EQ(0u, stream->read(read.data(), 1));
+            EXPECT_EQ(contents, read);
+        }
+
+        // a large read goes straight into the destination, the partial block at the end through the blocks
+        {
+            auto stream = open();
+            std::vector<uchar> read(contents.size());
+            EXPECT_EQ(read.size(), stream->read(read.data(), read.size()));
+            EXPECT_EQ(contents, read);
+        }
+
+        // out of order, reading a prefetched range first
+        {
+            auto stream = open();
+            std::vector<uchar> read(contents.size());
+            size_t const middle = 5 * blockSize + 10, end = middle + 3 * blockSize;
+            stream->prefetch(5 * blockSize, 4 * blockSize);
+            stream->seek(middle);
+            EXPECT_EQ(end - middle, stream->read(read.data() + middle, end - middle));
+            stream->seek(0);
+            EXPECT_EQ(middle, stream->read(read.data(), middle));
+            stream->seek(end);
+            EXPECT_EQ(read.size() - end, stream->read(read.data() + end, read.size()));
+            EXPECT_EQ(contents, read);
+        }
+    }
+    std::filesystem::remove(path);
+}
+//--------------------------------------------------------------------------
 TEST_F(FileSystemArchiveTests,CreateAndRemoveFile)
 {
     EXPECT_TRUE(!mArch->isReadOnly());
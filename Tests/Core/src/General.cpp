@@ -28,6 +28,8 @@ THE SOFTWARE.
 module;
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
 
 module Ogre.Tests;
@@ -38,6 +40,11 @@ import Ogre.Components.Bites;
 import Ogre.Core;
 import Ogre.PlugIns.STBICodec;
 
+import <algorithm>;
+import <deque>;
+import <filesystem>;
+import <format>;
+import <fstream>;
 import <list>;
 import <map>;
 import <memory>;
@@ -243,6 +250,454 @@ TEST(Image, Resize)
     STBIImageCodec::shutdown();
     ASSERT_TRUE(!memcmp(img.getData(), ref.getData(), ref.getSize()));
 }
+TEST(Image, DecodeInto)
+{
+    ResourceGroupManager mgr;
+    STBIImageCodec::startup();
+    ConfigFile cf;
+    cf.load(FileSystemLayer(/*OGRE_VERSION_NAME*/"Tsathoggua").getConfigFilePath("resources.cfg"));
+    auto testPath = cf.getSettings("Tests").begin()->second;
+
+    Image src;
+    src.load(Root::openFileStream(::std::format("{}/decal1.png", testPath)), "png");
+    Image ref(PixelFormat::BYTE_RGBA, src.getWidth(), src.getHeight());
+    PixelUtil::bulkPixelConversion(src.getPixelBox(), ref.getPixelBox());
+
+    auto codec = static_cast<ImageCodec*>(Codec::getCodec("png"));
+    auto stream = Root::openFileStream(::std::format("{}/decal1.png", testPath));
+    ImageCodec::ImageData header;
+    ASSERT_TRUE(codec->decodeHeader(stream, header));
+    EXPECT_EQ(header.width, ref.getWidth());
+    EXPECT_EQ(header.height, ref.getHeight());
+
+    Image img(PixelFormat::BYTE_RGBA, header.width, header.height);
+    stream->seek(0);
+    codec->decodeInto(stream, img.getPixelBox());
+
+    STBIImageCodec::shutdown();
+    ASSERT_TRUE(!memcmp(img.getData(), ref.getData(), ref.getSize()));
+}
+TEST(Image, DecodeIntoPNGVariants)
+{
+    ResourceGroupManager mgr;
+    STBIImageCodec::startup();
+    ConfigFile cf;
+    cf.load(FileSystemLayer(/*OGRE_VERSION_NAME*/"Tsathoggua").getConfigFilePath("resources.cfg"));
+    auto testPath = cf.getSettings("Tests").begin()->second;
+
+    // 37x23 images using every row filter, the odd width leaves partial bytes at low bit depths
+    for (const char* name : {"png_palette4",      // 4 bit palette
+                             "png_palette8_trns", // palette with alpha
+                             "png_grey1", "png_grey2", "png_grey4",
+                             "png_grey4_key",     // tRNS colour key on low bit depth grey
+                             "png_rgb8_key",      // tRNS colour key
+                             "png_rgb16_key",     // 16 bit colour key
+                             "png_rgba16",
+                             "png_rgb8_idat"})    // image data split over 61 byte IDAT chunks
+    {
+        SCOPED_TRACE(name);
+        auto path = ::std::format("{}/png/{}.png", testPath, name);
+
+        // stb_image decodes the whole image
+        Image ref;
+        ref.load(Root::openFileStream(path), "png");
+
+        auto stream = Root::openFileStream(path);
+        auto* codec = static_cast<ImageCodec*>(Codec::getCodec("png"));
+        ImageCodec::ImageData header;
+        ASSERT_TRUE(codec->decodeHeader(stream, header));
+        EXPECT_EQ(header.format, ref.getFormat());
+        ASSERT_EQ(header.width, ref.getWidth());
+        ASSERT_EQ(header.height, ref.getHeight());
+
+        Image img(header.format, header.width, header.height);
+        stream->seek(0);
+        codec->decodeInto(stream, img.getPixelBox());
+        EXPECT_TRUE(!memcmp(img.getData(), ref.getData(), ref.getSize()));
+    }
+
+    STBIImageCodec::shutdown();
+}
+TEST(Image, DecodeHeaderPNGLimits)
+{
+    ResourceGroupManager mgr;
+    STBIImageCodec::startup();
+    auto* codec = static_cast<ImageCodec*>(Codec::getCodec("png"));
+
+    // just the chunks the header parser looks at, CRCs are not checked before decoding
+    auto decodeHeader = [&](uint32 width, uint32 height)
+    {
+        std::vector<uchar> png = {137, 80, 78, 71, 13, 10, 26, 10, 0, 0, 0, 13, 'I', 'H', 'D', 'R'};
+        for (uint32 value : {width, height})
+            for (int shift = 24; shift >= 0; shift -= 8)
+                png.push_back(uchar(value >> shift));
+        png.insert(png.end(), {16, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 'I', 'D', 'A', 'T', 0, 0, 0, 0});
+        ImageCodec::ImageData header;
+        return codec->decodeHeader(std::make_shared<MemoryDataStream>(png.data(), png.size()), header);
+    };
+    EXPECT_TRUE(decodeHeader(1 << 24, 1));
+    EXPECT_FALSE(decodeHeader((1 << 24) + 1, 1));
+    EXPECT_FALSE(decodeHeader(1, (1 << 24) + 1));
+    EXPECT_FALSE(decodeHeader(~0u, 1));
+
+    STBIImageCodec::shutdown();
+}
+TEST(Image, KTX2Levels)
+{
+    size_t size = Image::calculateSize(TextureMipmap(6), 1, 64, 32, 1, PixelFormat::BYTE_RGBA);
+    auto* data = static_cast<uchar*>(malloc(size));
+    for (size_t i = 0; i < size; ++i)
+        data[i] = uchar(i * 7 / 5);
+    Image img;
+    img.loadDynamicImage(data, 64, 32, 1, PixelFormat::BYTE_RGBA, true, 1, TextureMipmap(6));
+
+    KTX2Codec codec;
+    codec.setSupercompressionLevel(6);
+    DataStreamPtr encoded = codec.encode(&img);
+
+    Image full;
+    KTX2Codec::loadLevels(encoded, full, 0);
+    EXPECT_EQ(full.getNumMipmaps(), TextureMipmap(6));
+    ASSERT_EQ(full.getSize(), img.getSize());
+    EXPECT_TRUE(!memcmp(full.getData(), img.getData(), img.getSize()));
+
+    // only the levels up to 8x4 are loaded
+    encoded->seek(0);
+    Image low;
+    KTX2Codec::loadLevels(encoded, low, 8);
+    EXPECT_EQ(low.getWidth(), 8u);
+    EXPECT_EQ(low.getHeight(), 4u);
+    EXPECT_EQ(low.getNumMipmaps(), TextureMipmap(3));
+    EXPECT_TRUE(!memcmp(low.getData(), img.getPixelBox(0, TextureMipmap(3)).data, low.getSize()));
+}
+TEST(Image, KTX2Cubemap)
+{
+    size_t size = Image::calculateSize(TextureMipmap(4), 6, 16, 16, 1, PixelFormat::BYTE_RGBA);
+    auto* data = static_cast<uchar*>(malloc(size));
+    for (size_t i = 0; i < size; ++i)
+        data[i] = uchar(i * 3 / 7);
+    Image img;
+    img.loadDynamicImage(data, 16, 16, 1, PixelFormat::BYTE_RGBA, true, 6, TextureMipmap(4));
+
+    // uncompressed and zlib supercompressed
+    for (int level : {0, 6})
+    {
+        KTX2Codec codec;
+        codec.setSupercompressionLevel(level);
+        DataStreamPtr encoded = codec.encode(&img);
+
+        Image cube;
+        KTX2Codec::loadLevels(encoded, cube, 0);
+        EXPECT_EQ(cube.getNumFaces(), 6u);
+        EXPECT_EQ(cube.getNumMipmaps(), TextureMipmap(4));
+        ASSERT_EQ(cube.getSize(), img.getSize());
+        EXPECT_TRUE(!memcmp(cube.getData(), img.getData(), img.getSize()));
+    }
+}
+namespace {
+    // the contents of the files made by a KTX2 writer following the specification,
+    // with the levels supercompressed by the reference zstd tool
+    auto ktx2Pattern(uint32 level, uint32 part, size_t i) -> uchar
+    {
+        return uchar(i * 5 + 31 * level + 57 * part);
+    }
+
+    void checkKTX2Pattern(const PixelBox& box, uint32 level, uint32 part)
+    {
+        auto size = PixelUtil::getMemorySize(box.getWidth(), box.getHeight(), box.getDepth(), box.format);
+        for (size_t i = 0; i < size; ++i)
+            ASSERT_EQ(box.data[i], ktx2Pattern(level, part, i)) << "level " << level << " part " << part;
+    }
+}
+TEST(Image, KTX2External)
+{
+    ResourceGroupManager mgr;
+    ConfigFile cf;
+    cf.load(FileSystemLayer(/*OGRE_VERSION_NAME*/"Tsathoggua").getConfigFilePath("resources.cfg"));
+    auto testPath = cf.getSettings("Tests").begin()->second;
+
+    // 3 layers of 16x8 with all 5 levels, zstd supercompressed
+    std::vector<Image> layers;
+    KTX2Codec::loadLayers(Root::openFileStream(::std::format("{}/ktx2_array_zstd.ktx2", testPath)), layers, 0);
+    ASSERT_EQ(layers.size(), 3u);
+    for (uint32 layer = 0; layer < 3; ++layer)
+    {
+        EXPECT_EQ(layers[layer].getWidth(), 16u);
+        EXPECT_EQ(layers[layer].getHeight(), 8u);
+        EXPECT_FALSE(layers[layer].hasFlag(ImageFlags::_3D_TEXTURE));
+        ASSERT_EQ(layers[layer].getNumMipmaps(), TextureMipmap(4));
+        for (uint32 level = 0; level < 5; ++level)
+            checkKTX2Pattern(layers[layer].getPixelBox(0, TextureMipmap(level)), level, layer);
+    }
+
+    // as a single image the layers are its depth, which only holds the first level
+    Image array;
+    KTX2Codec::loadLevels(Root::openFileStream(::std::format("{}/ktx2_array_zstd.ktx2", testPath)), array, 0);
+    EXPECT_EQ(array.getDepth(), 3u);
+    EXPECT_EQ(array.getNumMipmaps(), TextureMipmap(0));
+    EXPECT_FALSE(array.hasFlag(ImageFlags::_3D_TEXTURE));
+    for (uint32 layer = 0; layer < 3; ++layer)
+        checkKTX2Pattern(array.getPixelBox().getSubVolume(Box{0, 0, 16, 8, layer, layer + 1}), 0, layer);
+
+    // 8x8 cubemap with 4 levels, uncompressed and read straight from the file
+    Image cube;
+    KTX2Codec::loadLevels(Root::openFileStream(::std::format("{}/ktx2_cube.ktx2", testPath)), cube, 0);
+    EXPECT_EQ(cube.getNumFaces(), 6u);
+    ASSERT_EQ(cube.getNumMipmaps(), TextureMipmap(3));
+    for (uint32 face = 0; face < 6; ++face)
+        for (uint32 level = 0; level < 4; ++level)
+            checkKTX2Pattern(cube.getPixelBox(face, TextureMipmap(level)), level, face);
+}
+TEST(Image, ResizeFilters)
+{
+    // a black and white checkerboard averages to mid grey, which is 188 in sRGB
+    Image checker(PixelFormat::BYTE_RGBA, 64, 64);
+    for (uint32 y = 0; y < 64; ++y)
+        for (uint32 x = 0; x < 64; ++x)
+            checker.setColourAt((x + y) % 2 ? ColourValue::White : ColourValue::Black, x, y, 0);
+
+    Image linear(PixelFormat::BYTE_RGBA, 32, 32);
+    Image::scale(checker.getPixelBox(), linear.getPixelBox(), Image::Filter::BOX);
+    EXPECT_EQ(linear.getData()[0], 128);
+
+    Image gamma(PixelFormat::BYTE_RGBA, 32, 32);
+    Image::scale(checker.getPixelBox(), gamma.getPixelBox(), Image::Filter::BOX, true);
+    EXPECT_EQ(gamma.getData()[0], 188);
+    EXPECT_EQ(gamma.getData()[3], 255);
+
+    // flat images stay flat with every filter, including format conversion and depth changes
+    for (auto filter : {Image::Filter::BOX, Image::Filter::BILINEAR, Image::Filter::MITCHELL, Image::Filter::LANCZOS,
+                        Image::Filter::KAISER})
+    {
+        Image flat(PixelFormat::FLOAT32_RGBA, 37, 21, 3);
+        for (uint32 z = 0; z < 3; ++z)
+            for (uint32 y = 0; y < 21; ++y)
+                for (uint32 x = 0; x < 37; ++x)
+                    flat.setColourAt(ColourValue(0.5f, 0.25f, 1.0f, 1.0f), x, y, z);
+
+        Image scaled(PixelFormat::BYTE_RGBA, 80, 9, 2);
+        Image::scale(flat.getPixelBox(), scaled.getPixelBox(), filter, true);
+        for (uint32 z = 0; z < 2; ++z)
+            for (uint32 y = 0; y < 9; ++y)
+                for (uint32 x = 0; x < 80; ++x)
+                {
+                    ColourValue c = scaled.getColourAt(x, y, z);
+                    ASSERT_NEAR(c.r, 0.5f, 0.01f);
+                    ASSERT_NEAR(c.g, 0.25f, 0.01f);
+                    ASSERT_NEAR(c.b, 1.0f, 0.01f);
+                }
+    }
+}
+TEST(Image, GenerateMipmaps)
+{
+    // every 2x2 block averages to 70 plus the channel index
+    Image img(PixelFormat::BYTE_RGBA, 8, 4);
+    uchar* data = img.getData();
+    for (uint32 y = 0; y < 4; ++y)
+        for (uint32 x = 0; x < 8; ++x)
+            for (uint32 c = 0; c < 4; ++c)
+                data[(y * 8 + x) * 4 + c] = uchar((x % 2) * 100 + (y % 2) * 40 + c);
+
+    ASSERT_TRUE(img.generateMipmaps());
+    ASSERT_EQ(img.getNumMipmaps(), TextureMipmap{3});
+    EXPECT_EQ(img.getData()[0], 0);
+    for (uint32 mip = 1; mip <= 3; ++mip)
+    {
+        PixelBox box = img.getPixelBox(0, TextureMipmap(mip));
+        EXPECT_EQ(box.getWidth(), 8u >> mip);
+        EXPECT_EQ(box.getHeight(), std::max(1u, 4u >> mip));
+        for (size_t i = 0; i < box.getWidth() * box.getHeight() * 4; ++i)
+            EXPECT_EQ(box.data[i], 70 + i % 4);
+    }
+
+    // faces of a cube map are filtered independently
+    Image cube;
+    cube.create(PixelFormat::BYTE_RGBA, 16, 16, 1, 6);
+    for (uint32 face = 0; face < 6; ++face)
+    {
+        PixelBox box = cube.getPixelBox(face);
+        std::fill(box.data, box.data + 16 * 16 * 4, uchar(face * 40));
+    }
+
+    ASSERT_TRUE(cube.generateMipmaps(Image::Filter::KAISER, true));
+    ASSERT_EQ(cube.getNumMipmaps(), TextureMipmap{4});
+    for (uint32 face = 0; face < 6; ++face)
+    {
+        PixelBox box = cube.getPixelBox(face, TextureMipmap{4});
+        EXPECT_EQ(box.getWidth(), 1u);
+        for (uint32 c = 0; c < 4; ++c)
+            EXPECT_NEAR(box.data[c], face * 40, 1);
+    }
+}
+TEST(Image, GenerateMipmapsAlphaCoverage)
+{
+    // sparse opaque texels, as in alpha tested foliage
+    minstd_rand rng(5);
+    Image img(PixelFormat::BYTE_RGBA, 128, 128);
+    for (uint32 i = 0; i < 128 * 128; ++i)
+    {
+        uchar* texel = img.getData() + i * 4;
+        texel[0] = texel[1] = texel[2] = 255;
+        texel[3] = rng() % 10 < 3 ? 255 : 0;
+    }
+    Image plain(img);
+
+    auto coverage = [](const PixelBox& box)
+    {
+        size_t covered = 0;
+        for (size_t i = 0; i < box.getWidth() * box.getHeight(); ++i)
+            covered += box.data[i * 4 + 3] >= 128;
+        return float(covered) / float(box.getWidth() * box.getHeight());
+    };
+    float const top = coverage(img.getPixelBox());
+
+    ASSERT_TRUE(img.generateMipmaps(Image::Filter::BOX, false, 0.5f));
+    ASSERT_TRUE(plain.generateMipmaps(Image::Filter::BOX));
+    // averaging drops the alpha of every texel below the reference further down the chain
+    EXPECT_LT(coverage(plain.getPixelBox(0, TextureMipmap{3})), 0.05f);
+    // levels large enough to resolve the fraction keep the coverage of the top level
+    for (uint32 mip = 1; mip <= 3; ++mip)
+        EXPECT_NEAR(coverage(img.getPixelBox(0, TextureMipmap(mip))), top, 0.1f) << "level " << mip;
+    // only alpha is scaled
+    EXPECT_EQ(img.getPixelBox(0, TextureMipmap{3}).data[0], 255);
+}
+TEST(Image, Compress)
+{
+    // a solid colour encodes exactly, 6x5 pads to 2x2 blocks
+    auto solid = [](PixelFormat format)
+    {
+        Image img(PixelFormat::BYTE_RGBA, 6, 5);
+        for (size_t i = 0; i < 6 * 5; ++i)
+        {
+            uchar* texel = img.getData() + i * 4;
+            texel[0] = 255;
+            texel[1] = 0;
+            texel[2] = 77;
+            texel[3] = 200;
+        }
+        img.compress(format, Image::CompressionQuality::FAST);
+        EXPECT_EQ(img.getFormat(), format);
+        EXPECT_EQ(img.getWidth(), 6u);
+        return img;
+    };
+
+    Image bc1 = solid(PixelFormat::DXT1);
+    ASSERT_EQ(bc1.getSize(), 4 * 8u);
+    uint16 colour0;
+    memcpy(&colour0, bc1.getData(), sizeof(uint16));
+    EXPECT_EQ(colour0 & 0xF800, 0xF800);
+    EXPECT_EQ(colour0 & 0x07E0, 0);
+
+    Image bc3 = solid(PixelFormat::DXT5);
+    ASSERT_EQ(bc3.getSize(), 4 * 16u);
+    EXPECT_EQ(bc3.getData()[0], 200);
+
+    Image bc4 = solid(PixelFormat::BC4_UNORM);
+    ASSERT_EQ(bc4.getSize(), 4 * 8u);
+    EXPECT_EQ(bc4.getData()[0], 255);
+
+    Image bc5 = solid(PixelFormat::BC5_UNORM);
+    ASSERT_EQ(bc5.getSize(), 4 * 16u);
+    EXPECT_EQ(bc5.getData()[0], 255);
+    EXPECT_EQ(bc5.getData()[8], 0);
+
+    Image bc7 = solid(PixelFormat::BC7_UNORM);
+    ASSERT_EQ(bc7.getSize(), 4 * 16u);
+    // mode 6
+    EXPECT_EQ(bc7.getData()[0] & 0x7F, 0x40);
+
+    EXPECT_THROW(bc1.compress(PixelFormat::DXT5), InvalidParametersException);
+    Image rgba(PixelFormat::BYTE_RGBA, 4, 4);
+    EXPECT_THROW(rgba.compress(PixelFormat::DXT3), InvalidParametersException);
+}
+using ImageCompression = RootWithoutRenderSystemFixture;
+TEST_F(ImageCompression, EncodeDDS)
+{
+    Image img(PixelFormat::BYTE_RGBA, 12, 12);
+    memset(img.getData(), 128, img.getSize());
+    ASSERT_TRUE(img.generateMipmaps());
+    img.compress(PixelFormat::DXT1);
+
+    DataStreamPtr stream = img.encode("dds");
+    // magic, header with the fourCC at byte 84, then the compressed chain
+    ASSERT_EQ(stream->size(), 4 + 124 + img.getSize());
+    std::vector<char> file(stream->size());
+    stream->read(file.data(), file.size());
+    EXPECT_EQ(std::string(file.data(), 4), "DDS ");
+    EXPECT_EQ(std::string(file.data() + 84, 4), "DXT1");
+
+    // images stay compressed on load, decoding on the CPU is explicit
+    stream->seek(0);
+    Image decoded;
+    decoded.load(stream, "dds");
+    EXPECT_EQ(decoded.getFormat(), PixelFormat::DXT1);
+    decoded.decompress();
+    EXPECT_EQ(decoded.getFormat(), PixelFormat::BYTE_RGBA);
+    EXPECT_EQ(decoded.getWidth(), 12u);
+    EXPECT_EQ(decoded.getNumMipmaps(), TextureMipmap{3});
+    EXPECT_NEAR(decoded.getColourAt(5, 7, 0).g, 0.5f, 0.02f);
+}
+TEST(Image, Decompress)
+{
+    // a diagonal gradient survives a round trip through the encoder, 9x7 has partial blocks
+    auto roundTrip = [](PixelFormat format, PixelFormat expected)
+    {
+        Image img(PixelFormat::BYTE_RGBA, 9, 7);
+        for (uint32 y = 0; y < 7; ++y)
+            for (uint32 x = 0; x < 9; ++x)
+            {
+                uchar* texel = img.getData(x, y);
+                texel[0] = static_cast<uchar>(40 + (x + y) * 10);
+                texel[1] = static_cast<uchar>(200 - (x + y) * 10);
+                texel[2] = 90;
+                texel[3] = format == PixelFormat::DXT1 ? 255 : static_cast<uchar>(100 + (x + y) * 8);
+            }
+        Image compressed = img;
+        compressed.compress(format, Image::CompressionQuality::HIGH);
+        compressed.decompress();
+        EXPECT_EQ(compressed.getFormat(), expected);
+        EXPECT_EQ(compressed.getWidth(), 9u);
+        EXPECT_EQ(compressed.getHeight(), 7u);
+
+        float maxError = 0;
+        for (uint32 y = 0; y < 7; ++y)
+            for (uint32 x = 0; x < 9; ++x)
+            {
+                ColourValue const a = img.getColourAt(x, y, 0);
+                ColourValue const b = compressed.getColourAt(x, y, 0);
+                maxError = std::max(maxError, std::abs(a.r - b.r));
+                if (expected != PixelFormat::R8)
+                    maxError = std::max(maxError, std::abs(a.g - b.g));
+                if (expected == PixelFormat::BYTE_RGBA)
+                    maxError = std::max({maxError, std::abs(a.b - b.b), std::abs(a.a - b.a)});
+            }
+        EXPECT_LT(maxError, 0.06f) << PixelUtil::getFormatName(format);
+    };
+    roundTrip(PixelFormat::DXT1, PixelFormat::BYTE_RGBA);
+    roundTrip(PixelFormat::DXT5, PixelFormat::BYTE_RGBA);
+    roundTrip(PixelFormat::BC4_UNORM, PixelFormat::R8);
+    roundTrip(PixelFormat::BC5_UNORM, PixelFormat::RG8);
+    roundTrip(PixelFormat::BC7_UNORM, PixelFormat::BYTE_RGBA);
+
+    // ETC1 individual mode: left half white, right half black, all texels +2
+    uchar etc1[8] = {0xF0, 0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00};
+    Image etc(PixelFormat::UNKNOWN);
+    etc.loadDynamicImage(etc1, 4, 4, 1, PixelFormat::ETC1_RGB8);
+    etc.decompress();
+    EXPECT_EQ(etc.getColourAt(0, 3, 0), ColourValue::White);
+    EXPECT_EQ(etc.getColourAt(3, 0, 0).r, 2 / 255.0f);
+
+    // ASTC void extent block, a constant colour from the top 64 bits, through bulkPixelConversion
+    uchar astc[16] = {0xFC, 0xFD, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x80, 0x00, 0x40, 0x00, 0x20, 0xFF, 0xFF};
+    std::vector<uchar> rgb(5 * 5 * 3);
+    PixelUtil::bulkPixelConversion(PixelBox(5, 5, 1, PixelFormat::ASTC_RGBA_6X6_LDR, astc),
+                                   PixelBox(5, 5, 1, PixelFormat::BYTE_RGB, rgb.data()));
+    EXPECT_EQ(rgb[3 * 24 + 0], 0x80);
+    EXPECT_EQ(rgb[3 * 24 + 1], 0x40);
+    EXPECT_EQ(rgb[3 * 24 + 2], 0x20);
+
+    EXPECT_THROW(Image(PixelFormat::BYTE_RGBA, 4, 4).decompress(), InvalidParametersException);
+}
 TEST(Image, Combine)
 {
     ResourceGroupManager mgr;
@@ -268,6 +723,78 @@ TEST(Image, Combine)
     ASSERT_TRUE(!memcmp(combined.getData(), ref.getData(), ref.getSize()));
 }
 
+TEST(TexturePacker, Atlas)
+{
+    // three flat images, each with a distinct grey level
+    TexturePacker packer;
+    packer.setPadding(2);
+    uint32 const sizes[][2] = {{30, 20}, {12, 12}, {7, 25}};
+    for (uint32 i = 0; i < 3; ++i)
+    {
+        Image img(PixelFormat::BYTE_RGBA, sizes[i][0], sizes[i][1]);
+        memset(img.getData(), 50 * (i + 1), img.getSize());
+        packer.addImage(::std::format("tex{}", i), img);
+    }
+    packer.addImage("tex0", Image(PixelFormat::BYTE_RGBA, 4, 4));
+    EXPECT_EQ(packer.getNumImages(), 3u);
+
+    Image packed;
+    TextureAtlas atlas = packer.pack("atlas", packed);
+    EXPECT_EQ(atlas.width, packed.getWidth());
+    EXPECT_EQ(atlas.height, packed.getHeight());
+    ASSERT_EQ(atlas.entries.size(), 3u);
+
+    for (uint32 i = 0; i < 3; ++i)
+    {
+        const auto& e = atlas.entries[i];
+        EXPECT_EQ(e.name, ::std::format("tex{}", i));
+        EXPECT_EQ(e.width, sizes[i][0]);
+        EXPECT_EQ(e.height, sizes[i][1]);
+        uchar const grey = 50 * (i + 1);
+        // the corners of the image and of its replicated border
+        EXPECT_EQ(packed.getData()[(e.top * packed.getWidth() + e.left) * 4], grey);
+        EXPECT_EQ(packed.getData()[((e.top - 2) * packed.getWidth() + e.left - 2) * 4], grey);
+        EXPECT_EQ(packed.getData()[((e.top + e.height + 1) * packed.getWidth() + e.left + e.width + 1) * 4], grey);
+
+        for (uint32 j = 0; j < i; ++j)
+        {
+            const auto& o = atlas.entries[j];
+            EXPECT_TRUE(e.left >= o.left + o.width + 4 || o.left >= e.left + e.width + 4 ||
+                        e.top >= o.top + o.height + 4 || o.top >= e.top + e.height + 4);
+        }
+    }
+
+    Vector4 uv = atlas.getTransform(atlas.entries[1]) * Vector4(1, 1, 0, 1);
+    EXPECT_FLOAT_EQ(uv.x, Real(atlas.entries[1].left + 12) / atlas.width);
+    EXPECT_FLOAT_EQ(uv.y, Real(atlas.entries[1].top + 12) / atlas.height);
+
+    // the descriptor survives a round trip
+    auto file = (std::filesystem::temp_directory_path() / "TexturePacker.atlas").string();
+    atlas.save(file);
+    TextureAtlas loaded;
+    loaded.load(Root::openFileStream(file));
+    std::filesystem::remove(file);
+    EXPECT_EQ(loaded.textureName, "atlas");
+    EXPECT_EQ(loaded.textureType, TextureType::_2D);
+    EXPECT_EQ(loaded.width, atlas.width);
+    ASSERT_EQ(loaded.entries.size(), 3u);
+    EXPECT_EQ(loaded.getEntry("tex2")->left, atlas.entries[2].left);
+    EXPECT_EQ(loaded.getEntry("tex2")->height, 25u);
+    EXPECT_FALSE(loaded.getEntry("missing"));
+
+    // as an array every image becomes a layer of the largest size
+    TexturePacker arrays(TexturePacker::Layout::ARRAY);
+    arrays.addImage("tex0", packed);
+    arrays.addImage("tex1", Image(PixelFormat::BYTE_RGBA, 8, 8));
+    Image layers;
+    atlas = arrays.pack("array", layers);
+    EXPECT_EQ(atlas.textureType, TextureType::_2D_ARRAY);
+    EXPECT_EQ(layers.getDepth(), 2u);
+    EXPECT_EQ(layers.getWidth(), packed.getWidth());
+    EXPECT_TRUE(!memcmp(layers.getData(), packed.getData(), packed.getSize()));
+    EXPECT_FLOAT_EQ(atlas.getTransform(atlas.entries[1])[2][3], 1);
+}
+
 struct UsePreviousResourceLoadingListener : public ResourceLoadingListener
 {
     auto resourceCollision(Resource *resource, ResourceManager *resourceManager) noexcept -> bool override { return false; }
@@ -321,6 +848,141 @@ TEST_F(ResourceLoading, CollsionDeleteExisting)
     EXPECT_TRUE(mat->clone("Collision"));
 }
 
+struct ScriptOrderListener : public ResourceGroupListener
+{
+    std::vector<String> started;
+    void scriptParseStarted(std::string_view scriptName, bool& skipThisScript) override
+    {
+        started.emplace_back(scriptName);
+        skipThisScript = scriptName == "Parallel3.material";
+    }
+};
+TEST_F(ResourceLoading, ParallelScriptParsing)
+{
+    auto dir = std::filesystem::temp_directory_path() / "ParallelScriptParsing";
+    std::filesystem::create_directories(dir);
+    // enough scripts to need several batches of open streams
+    int const count = 200;
+    for (int i = 0; i < count; ++i)
+        std::ofstream(dir / std::format("Parallel{}.material", i))
+            << std::format("material Parallel{}\n{{\n    technique\n    {{\n        pass {{ ambient 0 {} 0 }}\n    }}\n}}\n", i, i % 2);
+
+    auto& rgm = ResourceGroupManager::getSingleton();
+    ScriptOrderListener listener;
+    rgm.addResourceGroupListener(&listener);
+    rgm.setParallelScriptParsing(true);
+    rgm.addResourceLocation(dir.string(), "FileSystem", "ParallelScripts");
+    rgm.initialiseResourceGroup("ParallelScripts");
+    rgm.removeResourceGroupListener(&listener);
+
+    std::vector<String> expected;
+    for (auto& fi : *rgm.findResourceFileInfo("ParallelScripts", "*.material"))
+        expected.push_back(fi.filename);
+    EXPECT_EQ(listener.started, expected);
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto mat = MaterialManager::getSingleton().getByName(std::format("Parallel{}", i), "ParallelScripts");
+        ASSERT_EQ(bool(mat), i != 3);
+        if (mat)
+            EXPECT_EQ(mat->getTechniques()[0]->getPasses()[0]->getAmbient(), ColourValue(0, i % 2, 0));
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_F(ResourceLoading, CompiledScriptCache)
+{
+    auto cacheFile = (std::filesystem::temp_directory_path() / "CompiledScriptCache.bin").string();
+    std::filesystem::remove(cacheFile);
+
+    String script = "material Cached\n{\n    technique\n    {\n        pass { ambient 0 1 0 }\n    }\n}\n";
+    auto& compilerManager = ScriptCompilerManager::getSingleton();
+    compilerManager.setCompiledScriptCache(cacheFile);
+
+    DataStreamPtr stream = std::make_shared<MemoryDataStream>("cached.material", &script[0], script.size());
+    compilerManager.parseScript(stream, "General");
+    EXPECT_EQ(compilerManager.getCompiledScriptCacheHits(), 0u);
+    compilerManager.saveCompiledScriptCache();
+    EXPECT_TRUE(std::filesystem::exists(cacheFile));
+    MaterialManager::getSingleton().remove("Cached", "General");
+
+    // reload the cache and compile from the stored AST
+    compilerManager.setCompiledScriptCache(cacheFile);
+    stream = std::make_shared<MemoryDataStream>("cached.material", &script[0], script.size());
+    compilerManager.parseScript(stream, "General");
+    EXPECT_EQ(compilerManager.getCompiledScriptCacheHits(), 1u);
+
+    auto mat = MaterialManager::getSingleton().getByName("Cached", "General");
+    ASSERT_TRUE(mat);
+    EXPECT_EQ(mat->getTechniques()[0]->getPasses()[0]->getAmbient(), ColourValue::Green);
+
+    // a changed script misses its entry
+    MaterialManager::getSingleton().remove("Cached", "General");
+    script.replace(script.find("0 1 0"), 5, "1 0 0");
+    stream = std::make_shared<MemoryDataStream>("cached.material", &script[0], script.size());
+    compilerManager.parseScript(stream, "General");
+    EXPECT_EQ(compilerManager.getCompiledScriptCacheHits(), 1u);
+    mat = MaterialManager::getSingleton().getByName("Cached", "General");
+    ASSERT_TRUE(mat);
+    EXPECT_EQ(mat->getTechniques()[0]->getPasses()[0]->getAmbient(), ColourValue::Red);
+
+    compilerManager.setCompiledScriptCache("");
+    std::filesystem::remove(cacheFile);
+}
+
+TEST_F(ResourceLoading, CompiledScriptCacheImports)
+{
+    auto dir = std::filesystem::temp_directory_path() / "CompiledScriptCacheImports";
+    std::filesystem::create_directories(dir);
+    auto cacheFile = (dir / "cache.bin").string();
+    std::filesystem::remove(cacheFile);
+
+    auto writeBase = [&](std::string_view ambient)
+    {
+        std::ofstream(dir / "base.material")
+            << std::format("abstract pass BasePass\n{{\n    ambient {}\n}}\n", ambient);
+    };
+    writeBase("0 1 0");
+    std::ofstream(dir / "derived.material")
+        << "import BasePass from \"base.material\"\n"
+           "material Derived\n{\n    technique\n    {\n        pass : BasePass {}\n    }\n}\n";
+
+    auto& rgm = ResourceGroupManager::getSingleton();
+    rgm.addResourceLocation(dir.string(), "FileSystem", "CachedImports");
+    auto& compilerManager = ScriptCompilerManager::getSingleton();
+    compilerManager.setCompiledScriptCache(cacheFile);
+
+    auto parseDerived = [&]() -> ColourValue
+    {
+        auto stream = rgm.openResource("derived.material", "CachedImports");
+        compilerManager.parseScript(stream, "CachedImports");
+        auto mat = MaterialManager::getSingleton().getByName("Derived", "CachedImports");
+        if (!mat)
+            return ColourValue::ZERO;
+        MaterialManager::getSingleton().remove(mat);
+        return mat->getTechniques()[0]->getPasses()[0]->getAmbient();
+    };
+
+    EXPECT_EQ(parseDerived(), ColourValue::Green);
+    EXPECT_EQ(compilerManager.getCompiledScriptCacheHits(), 0u);
+    EXPECT_EQ(parseDerived(), ColourValue::Green);
+    EXPECT_EQ(compilerManager.getCompiledScriptCacheHits(), 1u);
+
+    // the derived script is unchanged, but the import it was built from is not
+    writeBase("0 0 1");
+    EXPECT_EQ(parseDerived(), ColourValue::Blue);
+    EXPECT_EQ(compilerManager.getCompiledScriptCacheHits(), 1u);
+
+    // the entry was replaced by the one built from the new import
+    EXPECT_EQ(parseDerived(), ColourValue::Blue);
+    EXPECT_EQ(compilerManager.getCompiledScriptCacheHits(), 2u);
+
+    compilerManager.setCompiledScriptCache("");
+    rgm.destroyResourceGroup("CachedImports");
+    std::filesystem::remove_all(dir);
+}
+
 using TextureTests = RootWithoutRenderSystemFixture;
 TEST_F(TextureTests, Blank)
 {
@@ -336,6 +998,273 @@ TEST_F(TextureTests, Blank)
     EXPECT_EQ(tus->getGamma(), 1.0f);
     EXPECT_EQ(tus->isHardwareGammaEnabled(), false);
 }
+
+namespace {
+    // keeps the pixels of a texture level in memory
+    class MemoryPixelBuffer : public HardwarePixelBuffer
+    {
+        std::vector<uchar> mData;
+
+        auto lockImpl(const Box& lockBox, LockOptions) -> PixelBox override { return getPixelBox().getSubVolume(lockBox); }
+        void unlockImpl() override {}
+
+    public:
+        MemoryPixelBuffer(uint32 width, uint32 height, PixelFormat format)
+            : HardwarePixelBuffer(width, height, 1, format, HardwareBufferUsage::CPU_ONLY, true, false)
+            , mData(PixelUtil::getMemorySize(width, height, 1, format))
+        {
+        }
+
+        auto getPixelBox() -> PixelBox { return {mWidth, mHeight, 1, mFormat, mData.data()}; }
+
+        void blitFromMemory(const PixelBox& src, const Box& dstBox) override
+        {
+            PixelUtil::bulkPixelConversion(src, getPixelBox().getSubVolume(dstBox));
+        }
+        void blitToMemory(const Box& srcBox, const PixelBox& dst) override
+        {
+            PixelUtil::bulkPixelConversion(getPixelBox().getSubVolume(srcBox), dst);
+        }
+    };
+
+    // a single level texture in memory, loaded through the streaming path
+    class StreamedTexture : public Texture
+    {
+        HardwarePixelBufferSharedPtr mBuffer;
+
+    protected:
+        void createInternalResourcesImpl() override
+        {
+            mBuffer = std::make_shared<MemoryPixelBuffer>(mWidth, mHeight, mFormat);
+        }
+        void freeInternalResourcesImpl() override { mBuffer.reset(); }
+
+    public:
+        using Texture::Texture;
+        using Texture::readImage;
+
+        auto getBuffer(size_t, TextureMipmap) -> const HardwarePixelBufferSharedPtr& override { return mBuffer; }
+
+        auto stream(DataStreamPtr dstream, std::string_view ext) -> bool
+        {
+            if (!prepareStreamedImage(dstream, ext, true))
+                return false;
+            loadStreamedImage(mStreamedImage);
+            return true;
+        }
+    };
+}
+TEST_F(TextureTests, StreamedLoad)
+{
+    DefaultTextureManager texMgr;
+    texMgr.setStreamingThreshold(1);
+    STBIImageCodec::startup();
+    ConfigFile cf;
+    cf.load(FileSystemLayer(/*OGRE_VERSION_NAME*/"Tsathoggua").getConfigFilePath("resources.cfg"));
+    auto path = ::std::format("{}/decal1.png", cf.getSettings("Tests").begin()->second);
+
+    Image ref;
+    ref.load(Root::openFileStream(path), "png");
+
+    // the rows are converted to the texture format while decoding
+    StreamedTexture tex(&texMgr, "decal1.png", 0, RGN_DEFAULT);
+    tex.setNumMipmaps(TextureMipmap{});
+    tex.setFormat(PixelFormat::BYTE_BGRA);
+    ASSERT_TRUE(tex.stream(Root::openFileStream(path), "png"));
+    EXPECT_EQ(tex.getWidth(), ref.getWidth());
+    EXPECT_EQ(tex.getHeight(), ref.getHeight());
+    ASSERT_EQ(tex.getFormat(), PixelFormat::BYTE_BGRA);
+
+    Image expected(PixelFormat::BYTE_BGRA, ref.getWidth(), ref.getHeight());
+    PixelUtil::bulkPixelConversion(ref.getPixelBox(), expected.getPixelBox());
+    auto* buffer = static_cast<MemoryPixelBuffer*>(tex.getBuffer(0, {}).get());
+    EXPECT_TRUE(!memcmp(buffer->getPixelBox().data, expected.getData(), expected.getSize()));
+
+    // below the threshold the image is decoded as a whole
+    texMgr.setStreamingThreshold(expected.getSize() * 2);
+    StreamedTexture small(&texMgr, "decal1.png", 1, RGN_DEFAULT);
+    small.setNumMipmaps(TextureMipmap{});
+    EXPECT_FALSE(small.stream(Root::openFileStream(path), "png"));
+
+    STBIImageCodec::shutdown();
+}
+
+TEST_F(TextureTests, SoftwareDecompression)
+{
+    Image img(PixelFormat::BYTE_RGBA, 8, 8);
+    memset(img.getData(), 128, img.getSize());
+    img.compress(PixelFormat::DXT1);
+    DataStreamPtr encoded = img.encode("dds");
+
+    // without a render system nothing can be sampled, so the fallback decodes unless disabled
+    DefaultTextureManager texMgr;
+    auto readWith = [&](bool softwareDecompression)
+    {
+        texMgr.setSoftwareDecompression(softwareDecompression);
+        StreamedTexture tex(&texMgr, "compressed.dds", 0, RGN_DEFAULT);
+        encoded->seek(0);
+        Image decoded;
+        tex.readImage(decoded, encoded, "dds", true);
+        return decoded;
+    };
+    EXPECT_TRUE(texMgr.getSoftwareDecompression());
+    Image decoded = readWith(true);
+    EXPECT_EQ(decoded.getFormat(), PixelFormat::BYTE_RGBA);
+    EXPECT_NEAR(decoded.getColourAt(3, 5, 0).g, 0.5f, 0.02f);
+
+    EXPECT_EQ(readWith(false).getFormat(), PixelFormat::DXT1);
+
+    // loading an Image by itself keeps the compressed data
+    encoded->seek(0);
+    Image loaded;
+    loaded.load(encoded, "dds");
+    EXPECT_EQ(loaded.getFormat(), PixelFormat::DXT1);
+}
+
+TEST_F(TextureTests, CachedDesiredFormat)
+{
+    auto dir = std::filesystem::temp_directory_path() / "TextureCacheFormat";
+    std::filesystem::remove_all(dir);
+    DefaultTextureManager texMgr;
+    texMgr.setTextureCache(dir.string());
+    STBIImageCodec::startup();
+    ConfigFile cf;
+    cf.load(FileSystemLayer(/*OGRE_VERSION_NAME*/"Tsathoggua").getConfigFilePath("resources.cfg"));
+    auto path = ::std::format("{}/decal1.png", cf.getSettings("Tests").begin()->second);
+
+    Image ref;
+    ref.load(Root::openFileStream(path), "png");
+
+    auto readAs = [&](PixelFormat format)
+    {
+        StreamedTexture tex(&texMgr, "decal1.png", 0, RGN_DEFAULT);
+        tex.setNumMipmaps(TextureMipmap{});
+        tex.setFormat(format);
+        Image img;
+        tex.readImage(img, Root::openFileStream(path), "png", true);
+        return img;
+    };
+
+    // the first pass stores the entries, the second maps them. Each format has its own.
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (auto format : {PixelFormat::BYTE_BGRA, PixelFormat::L8})
+        {
+            Image img = readAs(format);
+            ASSERT_EQ(img.getFormat(), format);
+            Image expected(format, ref.getWidth(), ref.getHeight());
+            PixelUtil::bulkPixelConversion(ref.getPixelBox(), expected.getPixelBox());
+            ASSERT_EQ(img.getSize(), expected.getSize());
+            EXPECT_TRUE(!memcmp(img.getData(), expected.getData(), expected.getSize()));
+        }
+    }
+
+    texMgr.setTextureCache("");
+    STBIImageCodec::shutdown();
+    std::filesystem::remove_all(dir);
+}
+
+TEST_F(TextureTests, AtlasApply)
+{
+    // units with their own addressing mode create a sampler
+    DefaultTextureManager texMgr;
+
+    TextureAtlas atlas;
+    atlas.textureName = "atlas";
+    atlas.width = 64;
+    atlas.height = 32;
+    atlas.entries.push_back({"a", 0, 8, 4, 16, 8});
+
+    auto mat = std::make_shared<Material>(nullptr, "Atlas Material", 0, "Group");
+    auto pass = mat->createTechnique()->createPass();
+    auto clamped = pass->createTextureUnitState("a");
+    clamped->setTextureAddressingMode(TextureAddressingMode::CLAMP);
+    clamped->setTextureScale(2, 2);
+    // repeats, which would sample the neighbours in the atlas
+    auto wrapped = pass->createTextureUnitState("a");
+    // recalculates its matrix every frame
+    auto animated = pass->createTextureUnitState("a");
+    animated->setTextureAddressingMode(TextureAddressingMode::CLAMP);
+    animated->setScrollAnimation(0.5, 0);
+    auto other = pass->createTextureUnitState("b");
+    other->setTextureAddressingMode(TextureAddressingMode::CLAMP);
+
+    EXPECT_EQ(atlas.apply(mat), 1u);
+    EXPECT_EQ(clamped->getTextureName(), "atlas");
+    EXPECT_EQ(clamped->getTextureType(), TextureType::_2D);
+    EXPECT_EQ(wrapped->getTextureName(), "a");
+    EXPECT_EQ(animated->getTextureName(), "a");
+    EXPECT_EQ(other->getTextureName(), "b");
+
+    // the unit's own scaling about the centre maps (1, 1) to (0.75, 0.75), then into the entry
+    Vector4 uv = clamped->getTextureTransform() * Vector4(1, 1, 0, 1);
+    EXPECT_FLOAT_EQ(uv.x, (8 + 0.75f * 16) / 64);
+    EXPECT_FLOAT_EQ(uv.y, (4 + 0.75f * 8) / 32);
+    EXPECT_EQ(wrapped->getTextureTransform(), Matrix4::IDENTITY);
+
+    // array layers repeat on their own
+    atlas.textureName = "array";
+    atlas.textureType = TextureType::_2D_ARRAY;
+    atlas.layers = 3;
+    atlas.width = 16;
+    atlas.height = 8;
+    atlas.entries = {{"a", 2, 0, 0, 16, 8}};
+    EXPECT_EQ(atlas.apply(mat), 1u);
+    EXPECT_EQ(wrapped->getTextureName(), "array");
+    EXPECT_EQ(wrapped->getTextureType(), TextureType::_2D_ARRAY);
+    EXPECT_FLOAT_EQ(wrapped->getTextureTransform()[2][3], 2);
+    EXPECT_EQ(animated->getTextureName(), "a");
+}
+
+TEST(TextureCache, FindInsertEvict)
+{
+    auto dir = (std::filesystem::temp_directory_path() / "TextureCacheTest").string();
+    std::filesystem::remove_all(dir);
+
+    Image img(PixelFormat::BYTE_RGBA, 8, 8);
+    for (uint32 i = 0; i < 8 * 8 * 4; ++i)
+        img.getData()[i] = uchar(i);
+    ASSERT_TRUE(img.generateMipmaps());
+    size_t const entrySize = 64 + img.getSize();
+
+    String source = "encoded image";
+    auto key = TextureCache::makeKey(source.data(), source.size(), "png");
+    EXPECT_NE(key, TextureCache::makeKey(source.data(), source.size(), "png|mipmaps"));
+    {
+        TextureCache cache{dir, 2 * entrySize};
+        Image found;
+        EXPECT_FALSE(cache.find(key, found));
+        cache.insert(key, img);
+        EXPECT_EQ(cache.getSize(), entrySize);
+    }
+
+    // entries persist and are mapped with all their mipmaps
+    TextureCache cache{dir, 2 * entrySize};
+    EXPECT_EQ(cache.getSize(), entrySize);
+    Image found;
+    ASSERT_TRUE(cache.find(key, found));
+    EXPECT_EQ(found.getFormat(), PixelFormat::BYTE_RGBA);
+    EXPECT_EQ(found.getWidth(), 8u);
+    EXPECT_EQ(found.getNumMipmaps(), img.getNumMipmaps());
+    ASSERT_EQ(found.getSize(), img.getSize());
+    EXPECT_EQ(memcmp(found.getData(), img.getData(), img.getSize()), 0);
+
+    // the least recently used entry goes first
+    auto key2 = TextureCache::makeKey(source.data(), source.size(), "jpg");
+    auto key3 = TextureCache::makeKey(source.data(), source.size(), "tga");
+    cache.insert(key2, img);
+    ASSERT_TRUE(cache.find(key, found));
+    cache.insert(key3, img);
+    EXPECT_EQ(cache.getSize(), 2 * entrySize);
+    EXPECT_TRUE(cache.find(key, found));
+    EXPECT_FALSE(cache.find(key2, found));
+    EXPECT_TRUE(cache.find(key3, found));
+
+    cache.clear();
+    EXPECT_EQ(cache.getSize(), 0u);
+    EXPECT_FALSE(cache.find(key, found));
+    std::filesystem::remove_all(dir);
+}
 TEST(GpuSharedParameters, align)
 {
     Root root("");
@@ -402,6 +1331,246 @@ TEST(Math, TriangleRayIntersection)
     EXPECT_TRUE(Math::intersects(ray, tri[0], tri[1], tri[2], false, true).first);
     EXPECT_FALSE(Math::intersects(ray, tri[0], tri[1], tri[2], false, false).first);
 }
+TEST(MemoryDataStream, SubStream)
+{
+    auto stream = std::make_shared<MemoryDataStream>("slices", 16);
+    for (uchar i = 0; i < 16; ++i)
+        stream->getPtr()[i] = i;
+
+    auto slice = stream->subStream(4, 8);
+    EXPECT_EQ(slice->size(), 8u);
+    EXPECT_FALSE(slice->isWriteable());
+    EXPECT_EQ(slice->getPtr(), stream->getPtr() + 4);
+    EXPECT_EQ(slice->getSharedData().get(), stream->getPtr() + 4);
+
+    // slices of slices share the same memory
+    auto inner = slice->subStream(2, 4);
+    EXPECT_EQ(inner->getPtr(), stream->getPtr() + 6);
+
+    // the memory outlives the original stream
+    stream->close();
+    stream.reset();
+    uchar value = 0;
+    inner->seek(1);
+    EXPECT_EQ(inner->read(&value, 1), 1u);
+    EXPECT_EQ(value, 7);
+    EXPECT_EQ(slice->getAsString().size(), 8u);
+
+    EXPECT_THROW(slice->subStream(6, 4), InvalidParametersException);
+}
+
+using StreamingVertexBufferTests = RootWithoutRenderSystemFixture;
+TEST_F(StreamingVertexBufferTests, WrapAround)
+{
+    const size_t kept = StreamingVertexBuffer::FRAMES_IN_FLIGHT + 1;
+    StreamingVertexBuffer ring(&HardwareBufferManager::getSingleton(), 12, 4);
+    ASSERT_EQ(ring.getCapacity(), 4 * kept);
+
+    // one range for each frame kept, from the front of the ring
+    std::vector<StreamingVertexBuffer::Allocation> allocs;
+    for (size_t frame = 0; frame < kept; ++frame)
+    {
+        allocs.push_back(ring.allocate(3));
+        EXPECT_EQ(allocs.back().vertexStart, frame * 3);
+        ring._notifyFrameEnded();
+    }
+
+    // the first frame has retired, the remaining tail still fits
+    auto tail = ring.allocate(3);
+    EXPECT_EQ(tail.buffer, allocs.front().buffer);
+    EXPECT_EQ(tail.vertexStart, kept * 3);
+    ring._notifyFrameEnded();
+
+    // the tail is too short now, so the ring wraps into the range of the retired frames
+    auto wrapped = ring.allocate(3);
+    EXPECT_EQ(wrapped.buffer, allocs.front().buffer);
+    EXPECT_EQ(wrapped.vertexStart, 0u);
+    EXPECT_EQ(ring.getCapacity(), 4 * kept);
+}
+
+TEST_F(StreamingVertexBufferTests, Fencing)
+{
+    const size_t kept = StreamingVertexBuffer::FRAMES_IN_FLIGHT + 1;
+    StreamingVertexBuffer ring(&HardwareBufferManager::getSingleton(), 12, 16);
+
+    // no range of the frames kept may be handed out again, whatever the sizes
+    minstd_rand rng(7);
+    std::deque<std::vector<StreamingVertexBuffer::Allocation>> frames;
+    for (int frame = 0; frame < 2000; ++frame)
+    {
+        frames.emplace_back();
+        for (size_t i = rng() % 4; i > 0; --i)
+        {
+            auto alloc = ring.allocate(1 + rng() % 40);
+            ASSERT_LE(alloc.vertexStart + alloc.vertexCount, alloc.buffer->getNumVertices());
+            for (auto& keptFrame : frames)
+                for (auto& other : keptFrame)
+                    ASSERT_TRUE(other.buffer != alloc.buffer ||
+                                other.vertexStart + other.vertexCount <= alloc.vertexStart ||
+                                alloc.vertexStart + alloc.vertexCount <= other.vertexStart);
+            frames.back().push_back(alloc);
+        }
+        ring._notifyFrameEnded();
+        if (frames.size() == kept)
+            frames.pop_front();
+    }
+
+    // a full ring grows into a new buffer, earlier allocations keep the old one
+    StreamingVertexBuffer small(&HardwareBufferManager::getSingleton(), 12, 2);
+    auto old = small.allocate(small.getCapacity());
+    auto grown = small.allocate(1);
+    EXPECT_NE(grown.buffer, old.buffer);
+    EXPECT_EQ(grown.vertexStart, 0u);
+    EXPECT_GT(small.getCapacity(), old.vertexCount);
+    EXPECT_EQ(old.buffer->getNumVertices(), old.vertexCount);
+
+    // allocations render in their own frame and can be copied from in the next one
+    EXPECT_TRUE(small.isCurrent(old));
+    EXPECT_TRUE(small.canCopyFrom(old));
+    small._notifyFrameEnded();
+    EXPECT_FALSE(small.isCurrent(old));
+    EXPECT_TRUE(small.canCopyFrom(old));
+    small._notifyFrameEnded();
+    EXPECT_FALSE(small.canCopyFrom(old));
+    EXPECT_FALSE(small.canCopyFrom({}));
+}
+
+TEST_F(StreamingVertexBufferTests, CopyBetweenFrames)
+{
+    StreamingVertexBuffer ring(&HardwareBufferManager::getSingleton(), sizeof(float), 8);
+
+    auto first = ring.allocate(8);
+    auto* pFloat = static_cast<float*>(StreamingVertexBuffer::lock(first));
+    for (int i = 0; i < 8; ++i)
+        pFloat[i] = float(i);
+    first.buffer->unlock();
+    ring._notifyFrameEnded();
+
+    // copy the first half, write the second
+    auto second = ring.allocate(8);
+    EXPECT_NE(second.vertexStart, first.vertexStart);
+    StreamingVertexBuffer::copy(first, 0, second, 0, 4);
+    pFloat = static_cast<float*>(StreamingVertexBuffer::lock(second, 4, 4));
+    for (int i = 0; i < 4; ++i)
+        pFloat[i] = float(10 + i);
+    second.buffer->unlock();
+
+    std::vector<float> result(8);
+    second.buffer->readData(second.vertexStart * sizeof(float), 8 * sizeof(float), result.data());
+    EXPECT_EQ(result, (std::vector<float>{0, 1, 2, 3, 10, 11, 12, 13}));
+}
+
+namespace {
+struct StreamedChain : public BillboardChain
+{
+    using BillboardChain::BillboardChain;
+    using BillboardChain::updateVertexBuffer;
+
+    auto getVertices() const -> std::vector<uchar>
+    {
+        auto buffer = mVertexData->vertexBufferBinding->getBuffer(0);
+        std::vector<uchar> ret(mVertexData->vertexCount * buffer->getVertexSize());
+        buffer->readData(mVertexData->vertexStart * buffer->getVertexSize(), ret.size(), ret.data());
+        return ret;
+    }
+    auto getVertexStart() const -> size_t { return mVertexData->vertexStart; }
+};
+}
+using BillboardChainTests = RootWithoutRenderSystemFixture;
+TEST_F(BillboardChainTests, DynamicUploadsChangedSegments)
+{
+    auto sceneMgr = mRoot->createSceneManager();
+    Camera* cam = sceneMgr->createCamera("cam");
+    sceneMgr->getRootSceneNode()->createChildSceneNode(Vector3{0, 0, 10})->attachObject(cam);
+
+    // the reference is built from scratch each time, the tested chain incrementally
+    StreamedChain chain("chain", 4, 3, true, true, true);
+    StreamedChain reference("reference", 4, 3, true, true, true);
+    sceneMgr->getRootSceneNode()->attachObject(&chain);
+    sceneMgr->getRootSceneNode()->attachObject(&reference);
+
+    auto addElement = [&](size_t chainIndex, float x)
+    {
+        BillboardChain::Element elem{Vector3{x, float(chainIndex), 0}, 1, x, ColourValue::White,
+                                     Quaternion::IDENTITY};
+        chain.addChainElement(chainIndex, elem);
+        reference.addChainElement(chainIndex, elem);
+    };
+    auto expectSameVertices = [&]
+    {
+        reference.setDynamic(true);
+        reference.updateVertexBuffer(cam);
+        EXPECT_EQ(chain.getVertices(), reference.getVertices());
+    };
+    auto& hbm = HardwareBufferManager::getSingleton();
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        addElement(i, 0);
+        addElement(i, 1);
+    }
+    chain.updateVertexBuffer(cam);
+    expectSameVertices();
+
+    // only the middle chain changed, the others are copied from the previous frame
+    hbm._notifyStreamingFrameEnded();
+    size_t previousStart = chain.getVertexStart();
+    addElement(1, 2);
+    chain.updateVertexBuffer(cam);
+    EXPECT_NE(chain.getVertexStart(), previousStart);
+    expectSameVertices();
+
+    // nothing changed, everything is copied
+    hbm._notifyStreamingFrameEnded();
+    chain.updateVertexBuffer(cam);
+    expectSameVertices();
+
+    // the previous range is gone after a frame without update, so all is uploaded again
+    hbm._notifyStreamingFrameEnded();
+    hbm._notifyStreamingFrameEnded();
+    addElement(2, 2);
+    chain.updateVertexBuffer(cam);
+    expectSameVertices();
+
+    sceneMgr->getRootSceneNode()->detachObject(&chain);
+    sceneMgr->getRootSceneNode()->detachObject(&reference);
+}
+
+struct BudgetTestEmitter : public ParticleEmitter
+{
+    BudgetTestEmitter(ParticleSystem* psys) : ParticleEmitter(psys) { mType = "BudgetTest"; }
+};
+struct BudgetTestEmitterFactory : public ParticleEmitterFactory
+{
+    auto getName() const -> String override { return "BudgetTest"; }
+    auto createEmitter(ParticleSystem* psys) -> ParticleEmitter* override
+    {
+        mEmitters.push_back(new BudgetTestEmitter(psys));
+        return mEmitters.back();
+    }
+};
+using ParticleBudget = RootWithoutRenderSystemFixture;
+TEST_F(ParticleBudget, EmptySystemStartsEmitting)
+{
+    BudgetTestEmitterFactory factory;
+    auto& psm = ParticleSystemManager::getSingleton();
+    psm.addEmitterFactory(&factory);
+    psm.setParticleBudget(50);
+
+    auto sceneMgr = mRoot->createSceneManager();
+    ParticleSystem* psys = sceneMgr->createParticleSystem("budgeted", size_t(100));
+    psys->addEmitter("BudgetTest")->setEmissionRate(100);
+    sceneMgr->getRootSceneNode()->attachObject(psys);
+
+    // without particles there are no bounds, so no camera has ranked the system yet
+    ASSERT_EQ(psys->getNumParticles(), 0u);
+    psys->_update(0.5);
+    EXPECT_GT(psys->getNumParticles(), 0u);
+    EXPECT_LE(psys->getNumParticles(), 50u);
+
+    psm.setParticleBudget(0);
+    sceneMgr->destroyParticleSystem(psys);
+}
 
 using SkeletonTests = RootWithoutRenderSystemFixture;
 TEST_F(SkeletonTests, linkedSkeletonAnimationSource)
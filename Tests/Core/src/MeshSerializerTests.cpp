@@ -40,6 +40,7 @@ import :Core.MeshSerializer;
 import Ogre.Core;
 
 import <algorithm>;
+import <array>;
 import <format>;
 import <fstream>;
 import <list>;
@@ -171,6 +172,363 @@ TEST_F(MeshSerializerTests,Skeleton_Version_1_0)
     }
 }
 //--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_GeneratedLod)
+{
+    MeshLodGenerator generator;
+    generator.addLodLevel(1000, 0.5);
+    generator.addLodLevel(2000, 0.75);
+    generator.generate(mOrigMesh.get());
+
+    ASSERT_EQ(mOrigMesh->getNumLodLevels(), 3);
+    size_t totals[3] = {};
+    for (SubMesh* sm : mOrigMesh->getSubMeshes())
+    {
+        ASSERT_EQ(sm->mLodFaceList.size(), 2u);
+        EXPECT_LE(sm->mLodFaceList[0]->indexCount, sm->indexData->indexCount);
+        EXPECT_LE(sm->mLodFaceList[1]->indexCount, sm->mLodFaceList[0]->indexCount);
+        totals[0] += sm->indexData->indexCount;
+
+        const VertexData* vertexData = sm->useSharedVertices ? mOrigMesh->sharedVertexData : sm->vertexData.get();
+        for (size_t l = 0; l < 2; ++l)
+        {
+            const IndexData* lod = sm->mLodFaceList[l];
+            totals[l + 1] += lod->indexCount;
+
+            // still a triangle list of distinct, valid vertices
+            ASSERT_EQ(lod->indexCount % 3, 0u);
+            HardwareBufferLockGuard lock(lod->indexBuffer, HardwareBuffer::LockOptions::READ_ONLY);
+            auto index = [&](size_t i) -> uint32
+            {
+                if (lod->indexBuffer->getType() == HardwareIndexBuffer::IndexType::_32BIT)
+                    return static_cast<const uint32*>(lock.pData)[lod->indexStart + i];
+                return static_cast<const uint16*>(lock.pData)[lod->indexStart + i];
+            };
+            for (size_t i = 0; i < lod->indexCount; i += 3)
+            {
+                uint32 a = index(i), b = index(i + 1), c = index(i + 2);
+                EXPECT_LT(std::max({a, b, c}), vertexData->vertexCount);
+                EXPECT_TRUE(a != b && b != c && a != c);
+            }
+        }
+    }
+    // every level removes a substantial part of the triangles
+    EXPECT_LE(totals[1], totals[0] * 6 / 10);
+    EXPECT_LE(totals[2], totals[0] * 35 / 100);
+    EXPECT_LT(totals[2], totals[1]);
+
+    testMesh(MeshVersion::LATEST);
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_Optimised)
+{
+    MeshOptimiser optimiser;
+    MeshOptimiser::PassReportList reports = optimiser.optimise(mOrigMesh.get());
+
+    ASSERT_EQ(reports.size(), 4u);
+    EXPECT_LE(reports.back().after.acmr, reports.front().before.acmr);
+    EXPECT_EQ(reports.back().after.triangleCount, reports.front().before.triangleCount);
+
+    testMesh(MeshVersion::LATEST);
+}
+//--------------------------------------------------------------------------
+namespace
+{
+    /// Position, normal, texture coordinates and the bone assignment of a vertex
+    using VertexKey = std::array<float, 10>;
+    using TriangleKey = std::array<VertexKey, 3>;
+
+    /** A grid of quads in the z = 0 plane, each with its own four vertices, so that
+        every inner corner is duplicated. The quads are emitted in a scrambled order.
+    */
+    auto createQuadGrid(std::string_view name, uint32 quads) -> MeshPtr
+    {
+        MeshPtr mesh = MeshManager::getSingleton().createManual(name, "General");
+        SubMesh* sm = mesh->createSubMesh();
+        sm->useSharedVertices = false;
+        sm->vertexData = std::make_unique<VertexData>();
+        VertexDeclaration* decl = sm->vertexData->vertexDeclaration;
+        size_t offset = 0;
+        offset += decl->addElement(0, offset, VertexElementType::FLOAT3, VertexElementSemantic::POSITION).getSize();
+        offset += decl->addElement(0, offset, VertexElementType::FLOAT3, VertexElementSemantic::NORMAL).getSize();
+        offset += decl->addElement(0, offset, VertexElementType::FLOAT2, VertexElementSemantic::TEXTURE_COORDINATES).getSize();
+
+        uint32 const quadCount = quads * quads;
+        std::vector<float> vertices;
+        std::vector<uint16> indices;
+        for (uint32 i = 0; i < quadCount; ++i)
+        {
+            // 7 is coprime to the quad counts used, so every quad comes up once
+            uint32 const q = i * 7 % quadCount;
+            uint32 const qx = q % quads, qy = q / quads;
+            auto const base = static_cast<uint16>(i * 4);
+            uint32 const corners[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+            for (uint32 c = 0; c < 4; ++c)
+            {
+                uint32 const cx = qx + corners[c][0], cy = qy + corners[c][1];
+                auto const x = float(cx), y = float(cy);
+                vertices.insert(vertices.end(), {x, y, 0, 0, 0, 1, x / quads, y / quads});
+                sm->addBoneAssignment({base + c, ushort((cx + cy) % 3), 1});
+            }
+            indices.insert(indices.end(), {base, uint16(base + 1), uint16(base + 2), base, uint16(base + 2), uint16(base + 3)});
+        }
+
+        sm->vertexData->vertexCount = quadCount * 4;
+        auto vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+            offset, sm->vertexData->vertexCount, HardwareBuffer::STATIC_WRITE_ONLY, true);
+        vbuf->writeData(0, vbuf->getSizeInBytes(), vertices.data(), true);
+        sm->vertexData->vertexBufferBinding->setBinding(0, vbuf);
+
+        sm->indexData->indexCount = indices.size();
+        sm->indexData->indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+            HardwareIndexBuffer::IndexType::_16BIT, indices.size(), HardwareBuffer::STATIC_WRITE_ONLY, true);
+        sm->indexData->indexBuffer->writeData(0, sm->indexData->indexBuffer->getSizeInBytes(), indices.data(), true);
+
+        mesh->_setBounds(AxisAlignedBox{Vector3::ZERO, Vector3{float(quads), float(quads), 0}});
+        return mesh;
+    }
+
+    auto readIndices(const IndexData* indexData) -> std::vector<uint32>
+    {
+        std::vector<uint32> indices(indexData->indexCount);
+        HardwareBufferLockGuard lock(indexData->indexBuffer, HardwareBuffer::LockOptions::READ_ONLY);
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            if (indexData->indexBuffer->getType() == HardwareIndexBuffer::IndexType::_32BIT)
+                indices[i] = static_cast<const uint32*>(lock.pData)[indexData->indexStart + i];
+            else
+                indices[i] = static_cast<const uint16*>(lock.pData)[indexData->indexStart + i];
+        }
+        return indices;
+    }
+
+    /// The triangles of a submesh by the data of their vertices, each starting at its smallest vertex
+    auto readTriangles(const SubMesh* sm, const std::vector<uint32>& indices) -> std::vector<TriangleKey>
+    {
+        const VertexData* vertexData = sm->vertexData.get();
+        std::vector<VertexKey> keys(vertexData->vertexCount);
+        {
+            HardwareVertexBufferSharedPtr vbuf = vertexData->vertexBufferBinding->getBuffer(0);
+            HardwareBufferLockGuard lock(vbuf, HardwareBuffer::LockOptions::READ_ONLY);
+            for (size_t v = 0; v < keys.size(); ++v)
+                memcpy(keys[v].data(), static_cast<const uchar*>(lock.pData) + v * vbuf->getVertexSize(), 8 * sizeof(float));
+        }
+        for (const auto& [vertex, vba] : sm->getBoneAssignments())
+        {
+            keys.at(vertex)[8] = vba.boneIndex;
+            keys.at(vertex)[9] = vba.weight;
+        }
+
+        std::vector<TriangleKey> triangles;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            TriangleKey tri{keys.at(indices[i]), keys.at(indices[i + 1]), keys.at(indices[i + 2])};
+            std::ranges::rotate(tri, std::ranges::min_element(tri));
+            triangles.push_back(tri);
+        }
+        std::ranges::sort(triangles);
+        return triangles;
+    }
+}
+TEST_F(MeshSerializerTests,Mesh_OptimisedQuadGrid)
+{
+    uint32 const quads = 8;
+    MeshPtr mesh = createQuadGrid("QuadGrid.mesh", quads);
+    SubMesh* sm = mesh->getSubMesh(0);
+    std::vector<TriangleKey> before = readTriangles(sm, readIndices(sm->indexData.get()));
+
+    MeshOptimiser optimiser;
+    MeshOptimiser::PassReportList reports = optimiser.optimise(mesh.get());
+    ASSERT_EQ(reports.size(), 4u);
+    EXPECT_LE(reports.back().after.acmr, reports.front().before.acmr);
+
+    // welding keeps one vertex per grid corner
+    EXPECT_EQ(reports.front().pass, MeshOptimiserPass::WELD_VERTICES);
+    EXPECT_EQ(reports.front().before.vertexCount, quads * quads * 4);
+    EXPECT_EQ(reports.front().after.vertexCount, (quads + 1) * (quads + 1));
+    EXPECT_EQ(sm->vertexData->vertexCount, (quads + 1) * (quads + 1));
+    EXPECT_EQ(sm->getBoneAssignments().size(), sm->vertexData->vertexCount);
+
+    // vertices are stored in the order the triangles first use them
+    std::vector<uint32> indices = readIndices(sm->indexData.get());
+    uint32 nextNew = 0;
+    std::vector<bool> seen(sm->vertexData->vertexCount);
+    for (uint32 i : indices)
+    {
+        ASSERT_LT(i, seen.size());
+        if (!seen[i])
+        {
+            EXPECT_EQ(i, nextNew++);
+            seen[i] = true;
+        }
+    }
+    EXPECT_EQ(nextNew, sm->vertexData->vertexCount);
+
+    // the same triangles with the same positions, normals, texture coordinates and bones
+    EXPECT_EQ(readTriangles(sm, indices), before);
+
+    MeshManager::getSingleton().remove(mesh);
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_OptimisedMeshlets)
+{
+    MeshPtr mesh = createQuadGrid("QuadGridMeshlets.mesh", 8);
+    SubMesh* sm = mesh->getSubMesh(0);
+    sm->buildMeshlets(8, 8);
+    std::vector<TriangleKey> before = readTriangles(sm, readIndices(sm->indexData.get()));
+    uint32 const generation = sm->_getIndexGeneration();
+
+    MeshOptimiser optimiser;
+    optimiser.optimise(mesh.get());
+    EXPECT_NE(sm->_getIndexGeneration(), generation);
+
+    // with every meshlet visible, culling gathers exactly the triangles of the SubMesh
+    ASSERT_FALSE(sm->meshlets.empty());
+    std::vector<uint32> indices = readIndices(sm->indexData.get());
+    std::vector<uint32> gathered;
+    size_t nextIndex = sm->indexData->indexStart;
+    for (const auto& meshlet : sm->meshlets)
+    {
+        EXPECT_EQ(meshlet.indexStart, nextIndex);
+        EXPECT_LE(meshlet.indexCount, 8u * 3);
+        auto first = indices.begin() + (meshlet.indexStart - sm->indexData->indexStart);
+        std::vector<uint32> vertices(first, first + meshlet.indexCount);
+        gathered.insert(gathered.end(), vertices.begin(), vertices.end());
+
+        // the bounds culling tests must hold the triangles now in the range
+        for (const TriangleKey& tri : readTriangles(sm, vertices))
+            for (const VertexKey& v : tri)
+                EXPECT_LE(meshlet.center.distance(Vector3{v[0], v[1], v[2]}), meshlet.radius + 1e-4f);
+
+        std::ranges::sort(vertices);
+        EXPECT_LE(std::ranges::unique(vertices).begin() - vertices.begin(), 8);
+        nextIndex += meshlet.indexCount;
+    }
+    EXPECT_EQ(nextIndex, sm->indexData->indexStart + sm->indexData->indexCount);
+    EXPECT_EQ(readTriangles(sm, gathered), before);
+
+    MeshManager::getSingleton().remove(mesh);
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_Meshlets)
+{
+    for (SubMesh* sm : mOrigMesh->getSubMeshes())
+    {
+        sm->buildMeshlets(64, 124);
+        ASSERT_FALSE(sm->meshlets.empty());
+
+        size_t nextIndex = sm->indexData->indexStart;
+        for (const auto& meshlet : sm->meshlets)
+        {
+            EXPECT_EQ(meshlet.indexStart, nextIndex);
+            EXPECT_EQ(meshlet.indexCount % 3, 0u);
+            EXPECT_LE(meshlet.indexCount, 124u * 3);
+            EXPECT_GE(meshlet.radius, 0);
+            EXPECT_LE(meshlet.coneCutoff, 1);
+            nextIndex += meshlet.indexCount;
+        }
+        EXPECT_EQ(nextIndex, sm->indexData->indexStart + sm->indexData->indexCount);
+    }
+
+    testMesh(MeshVersion::LATEST);
+
+    for (size_t i = 0; i < mOrigMesh->getNumSubMeshes(); ++i)
+    {
+        const SubMesh::MeshletList& a = mOrigMesh->getSubMesh(i)->meshlets;
+        const SubMesh::MeshletList& b = mMesh->getSubMesh(i)->meshlets;
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t m = 0; m < a.size(); ++m)
+        {
+            EXPECT_EQ(a[m].indexStart, b[m].indexStart);
+            EXPECT_EQ(a[m].indexCount, b[m].indexCount);
+            EXPECT_TRUE(isEqual(a[m].center, b[m].center));
+            EXPECT_TRUE(isEqual(a[m].coneAxis, b[m].coneAxis));
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_MeshletsMalformed)
+{
+    SubMesh* sm = mOrigMesh->getSubMesh(0);
+    sm->buildMeshlets(64, 124);
+    const SubMesh::MeshletList meshlets = sm->meshlets;
+    size_t const triangles = sm->indexData->indexCount / 3;
+
+    // ranges outside the triangles of the SubMesh must not reach culling
+    auto importCorrupted = [&](auto&& corrupt)
+    {
+        corrupt(sm->meshlets);
+        MeshSerializer serializer;
+        serializer.exportMesh(mOrigMesh.get(), mMeshFullPath);
+        sm->meshlets = meshlets;
+        // a failed load leaves the Mesh unloaded, which reload would skip
+        mMesh->unload();
+        EXPECT_THROW(mMesh->load(), InvalidParametersException);
+    };
+    importCorrupted([&](auto& list) { list.back().indexCount += 3; });
+    importCorrupted([&](auto& list) { list.front().indexStart += 1; });
+    importCorrupted([&](auto& list) { list.front().indexCount -= 1; });
+    importCorrupted([&](auto& list) { list.front().indexStart = ~0u - 2; });
+    importCorrupted([&](auto& list) { list.resize(triangles + 1, list.front()); });
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_Quantised)
+{
+    std::vector<VertexData*> vertexDatas;
+    if (mOrigMesh->sharedVertexData)
+        vertexDatas.push_back(mOrigMesh->sharedVertexData);
+    for (SubMesh* sm : mOrigMesh->getSubMeshes())
+        if (!sm->useSharedVertices)
+            vertexDatas.push_back(sm->vertexData.get());
+
+    for (VertexData* vertexData : vertexDatas)
+    {
+        auto readPositions = [](VertexData* vd)
+        {
+            const VertexElement* posElem = vd->vertexDeclaration->findElementBySemantic(VertexElementSemantic::POSITION);
+            HardwareVertexBufferSharedPtr vbuf = vd->vertexBufferBinding->getBuffer(posElem->getSource());
+            HardwareBufferLockGuard lock(vbuf, HardwareBuffer::LockOptions::READ_ONLY);
+            std::vector<Vector3> positions;
+            for (size_t v = 0; v < vd->vertexCount; ++v)
+            {
+                float values[4];
+                posElem->readFloats(static_cast<uchar*>(lock.pData) + v * vbuf->getVertexSize() + posElem->getOffset(), values);
+                positions.push_back(vd->positionDecodeMatrix * Vector3{values[0], values[1], values[2]});
+            }
+            return positions;
+        };
+
+        std::vector<Vector3> before = readPositions(vertexData);
+        // bypass the vertex animation check of Mesh::quantiseVertexData
+        vertexData->reorganiseBuffers(vertexData->vertexDeclaration->getQuantisedDeclaration());
+        std::vector<Vector3> after = readPositions(vertexData);
+
+        const VertexElement* posElem = vertexData->vertexDeclaration->findElementBySemantic(VertexElementSemantic::POSITION);
+        EXPECT_EQ(posElem->getType(), VertexElementType::SHORT4_NORM);
+        if (const VertexElement* normElem = vertexData->vertexDeclaration->findElementBySemantic(VertexElementSemantic::NORMAL))
+            EXPECT_TRUE(normElem->isOctahedral());
+
+        Real extent = mOrigMesh->getBounds().getSize().length();
+        ASSERT_EQ(before.size(), after.size());
+        for (size_t v = 0; v < before.size(); ++v)
+            EXPECT_LE(before[v].distance(after[v]), extent * 1e-4f);
+    }
+
+    testMesh(MeshVersion::LATEST);
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_QuantisedOlderVersion)
+{
+    VertexData* vertexData = mOrigMesh->sharedVertexData ? mOrigMesh->sharedVertexData
+                                                         : mOrigMesh->getSubMesh(0)->vertexData.get();
+    vertexData->reorganiseBuffers(vertexData->vertexDeclaration->getQuantisedDeclaration());
+    ASSERT_NE(vertexData->positionDecodeMatrix, Affine3::IDENTITY);
+
+    // older formats have no place for the decode matrix
+    MeshSerializer serializer;
+    EXPECT_THROW(serializer.exportMesh(mOrigMesh.get(), mMeshFullPath, MeshVersion::_1_8), InvalidParametersException);
+    EXPECT_THROW(serializer.exportMesh(mOrigMesh.get(), mMeshFullPath, MeshVersion::_1_4), InvalidParametersException);
+}
+//--------------------------------------------------------------------------
 TEST_F(MeshSerializerTests,Mesh_Version_1_10)
 {
     testMesh(MeshVersion::LATEST);
@@ -195,6 +553,55 @@ TEST_F(MeshSerializerTests,Mesh_Version_1_3)
 {
     testMesh(MeshVersion::_1_0);
 }
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_Version_Mappable)
+{
+    testMesh(MeshVersion::MAPPABLE);
+
+    // load again in place from a memory mapped file
+    FileSystemArchiveFactory::setMapFiles(true);
+    mMesh->reload();
+    FileSystemArchiveFactory::setMapFiles(false);
+    assertMeshClone(mOrigMesh.get(), mMesh.get(), MeshVersion::MAPPABLE);
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_ParallelImport)
+{
+    MeshManager::getSingleton().setParallelImport(true);
+    testMesh(MeshVersion::LATEST);
+    testMesh(MeshVersion::MAPPABLE);
+    MeshManager::getSingleton().setParallelImport(false);
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_ParallelImportMatchesSerial)
+{
+    // exercise every chunk the import decodes on workers
+    ASSERT_GT(mOrigMesh->getNumSubMeshes(), 1u);
+    ASSERT_FALSE(mOrigMesh->getPoseList().empty());
+    MeshLodGenerator generator;
+    generator.addLodLevel(1000, 0.5);
+    generator.addLodLevel(2000, 0.75);
+    generator.generate(mOrigMesh.get());
+    mOrigMesh->buildEdgeList();
+
+    MeshSerializer serializer;
+    for (MeshVersion version : {MeshVersion::LATEST, MeshVersion::MAPPABLE})
+    {
+        serializer.exportMesh(mOrigMesh.get(), mMeshFullPath, version);
+        mMesh->reload();
+        MeshPtr serial = mMesh->clone(::std::format("{}.serial.mesh", mMesh->getName()), mMesh->getGroup());
+
+        MeshManager::getSingleton().setParallelImport(true);
+        mMesh->reload();
+        MeshManager::getSingleton().setParallelImport(false);
+
+        ASSERT_EQ(mMesh->getNumLodLevels(), 3);
+        ASSERT_TRUE(mMesh->isEdgeListBuilt());
+        assertMeshClone(serial.get(), mMesh.get(), version);
+        assertMeshClone(mOrigMesh.get(), mMesh.get(), version);
+        MeshManager::getSingleton().remove(serial);
+    }
+}
 
 namespace Ogre
 {
@@ -286,7 +693,7 @@ void MeshSerializerTests::assertMeshClone(Mesh* a, Mesh* b, MeshVersion version
 
     // pose animations
     const PoseList& aPoseList = a->getPoseList();
-    const PoseList& bPoseList = a->getPoseList();
+    const PoseList& bPoseList = b->getPoseList();
     ASSERT_EQ(bPoseList.size(), aPoseList.size());
     for (size_t i = 0; i < aPoseList.size(); i++)
     {
@@ -395,6 +802,7 @@ void MeshSerializerTests::assertVertexDataClone(VertexData* a, VertexData* b, Me
         EXPECT_TRUE(a->vertexStart == b->vertexStart);
         EXPECT_TRUE(a->vertexCount == b->vertexCount);
         EXPECT_TRUE(a->hwAnimDataItemsUsed == b->hwAnimDataItemsUsed);
+        EXPECT_TRUE(a->positionDecodeMatrix == b->positionDecodeMatrix);
 
         // Compare hwAnimationData
         {
@@ -0,0 +1,507 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+module;
+
+#include <gtest/gtest.h>
+#include <cstddef>
+
+module Ogre.Tests;
+
+import :Core.PackArchive;
+
+import Ogre.Core;
+
+import <filesystem>;
+import <format>;
+import <fstream>;
+import <initializer_list>;
+import <iterator>;
+import <string>;
+import <string_view>;
+import <thread>;
+import <vector>;
+
+using namespace Ogre;
+
+//--------------------------------------------------------------------------
+void PackArchiveTests::SetUp()
+{
+    Ogre::ConfigFile cf;
+    cf.load(Ogre::FileSystemLayer(/*OGRE_VERSION_NAME*/"Tsathoggua").getConfigFilePath("resources.cfg"));
+    Ogre::String testPath = ::std::format("{}/misc/ArchiveTest", cf.getSettings("Tests").begin()->second);
+
+    mSource = mSourceFactory.createInstance(testPath, true);
+    mSource->load();
+    mPackPath = (std::filesystem::temp_directory_path() / "ArchiveTest.pack").string();
+    mArch = nullptr;
+}
+
+//--------------------------------------------------------------------------
+void PackArchiveTests::TearDown()
+{
+    if (mArch)
+        mFactory.destroyInstance(mArch);
+    mSourceFactory.destroyInstance(mSource);
+    std::filesystem::remove(mPackPath);
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::pack(PackCompression compression)
+{
+    PackWriter writer;
+    writer.addArchive(mSource, compression);
+    writer.write(mPackPath);
+
+    mArch = mFactory.createInstance(mPackPath, true);
+    mArch->load();
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::packFrames(const std::vector<uchar>& frames, size_t size)
+{
+    if (mArch)
+        mFactory.destroyInstance(mArch);
+
+    // PackWriter only stores what it compressed itself, so lay out the header and the entry by hand
+    std::string_view const name{"frames.zst"};
+    uint64 nameHash[2];
+    MurmurHash3_128(name.data(), name.size(), 0, nameHash);
+
+    String bytes{"OGREPACK"};
+    auto put = [&](uint64 value, size_t width)
+    {
+        for (size_t i = 0; i < width; ++i)
+            bytes += char(value >> (8 * i));
+    };
+    put(1, 4);                  // version
+    put(1, 4);                  // entry count
+    put(32 + 64, 8);            // names offset, right after the directory
+    put(name.size(), 8);
+    put(nameHash[0], 8);
+    put(0, 4);                  // name offset
+    put(name.size(), 4);
+    put(4096, 8);               // data offset
+    put(frames.size(), 8);
+    put(size, 8);
+    put(uint32(PackCompression::ZSTD), 4);
+    put(0, 4);
+    put(0, 8);                  // content hash, only checked when verifying
+    put(0, 8);
+    bytes += name;
+    bytes.resize(4096);
+    bytes.append(frames.begin(), frames.end());
+    {
+        std::ofstream out{mPackPath, std::ios::binary | std::ios::trunc};
+        out.write(bytes.data(), std::streamsize(bytes.size()));
+    }
+
+    mArch = mFactory.createInstance(mPackPath, true);
+    mArch->load();
+}
+//--------------------------------------------------------------------------
+TEST_F(PackArchiveTests,ListRecursive)
+{
+    pack(PackCompression::NONE);
+    StringVectorPtr vec = mArch->list(true);
+
+    ASSERT_EQ((size_t)6, vec->size());
+    EXPECT_EQ(String("level1/materials/scripts/file.material"), vec->at(0));
+    EXPECT_EQ(String("level1/materials/scripts/file2.material"), vec->at(1));
+    EXPECT_EQ(String("level2/materials/scripts/file3.material"), vec->at(2));
+    EXPECT_EQ(String("level2/materials/scripts/file4.material"), vec->at(3));
+    EXPECT_EQ(String("rootfile.txt"), vec->at(4));
+    EXPECT_EQ(String("rootfile2.txt"), vec->at(5));
+
+    vec = mArch->list(false);
+    ASSERT_EQ((size_t)2, vec->size());
+
+    vec = mArch->list(true, true);
+    EXPECT_EQ((size_t)6, vec->size());
+    EXPECT_TRUE(mArch->exists("level1/materials"));
+    EXPECT_TRUE(mArch->exists("level2/materials/scripts/file3.material"));
+    EXPECT_FALSE(mArch->exists("file3.material"));
+}
+//--------------------------------------------------------------------------
+TEST_F(PackArchiveTests,FileReadInPlace)
+{
+    pack(PackCompression::NONE);
+    DataStreamPtr stream = mArch->open("rootfile.txt");
+
+    // stored entries are views into the mapping
+    EXPECT_TRUE(stream->getSharedData());
+    EXPECT_EQ(String("this is line 1 in file 1"), stream->getLine());
+    EXPECT_EQ(mSource->open("rootfile.txt")->getAsString(), mArch->open("rootfile.txt")->getAsString());
+
+    // the stream outlives the archive
+    mFactory.destroyInstance(mArch);
+    mArch = nullptr;
+    EXPECT_EQ(String("this is line 2 in file 1"), stream->getLine());
+}
+//--------------------------------------------------------------------------
+TEST_F(PackArchiveTests,FileReadCompressed)
+{
+    mFactory.setVerifyContent(true);
+    pack(PackCompression::DEFLATE);
+
+    FileInfoListPtr infos = mArch->findFileInfo("rootfile2.txt");
+    ASSERT_EQ((size_t)1, infos->size());
+    EXPECT_LT(infos->front().compressedSize, infos->front().uncompressedSize);
+
+    std::vector<String> contents(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < contents.size(); ++i)
+        threads.emplace_back([&, i] { contents[i] = mArch->open("rootfile2.txt")->getAsString(); });
+    for (auto& t : threads)
+        t.join();
+
+    String expected = mSource->open("rootfile2.txt")->getAsString();
+    for (const String& s : contents)
+        EXPECT_EQ(expected, s);
+}
+//--------------------------------------------------------------------------
+TEST_F(PackArchiveTests,FileReadLZ4)
+{
+    mFactory.setVerifyContent(true);
+    pack(PackCompression::LZ4);
+
+    FileInfoListPtr infos = mArch->listFileInfo();
+    ASSERT_EQ((size_t)6, infos->size());
+    // empty files are stored, the text files must compress
+    bool anyCompressed = false;
+    for (const FileInfo& info : *infos)
+    {
+        anyCompressed |= info.compressedSize < info.uncompressedSize;
+        EXPECT_EQ(mSource->open(info.filename)->getAsString(), mArch->open(info.filename)->getAsString());
+    }
+    EXPECT_TRUE(anyCompressed);
+}
+//--------------------------------------------------------------------------
+TEST_F(PackArchiveTests,FileReadZstd)
+{
+    mFactory.setVerifyContent(true);
+    pack(PackCompression::ZSTD);
+
+    FileInfoListPtr infos = mArch->listFileInfo();
+    ASSERT_EQ((size_t)6, infos->size());
+    bool anyCompressed = false;
+    for (const FileInfo& info : *infos)
+    {
+        anyCompressed |= info.compressedSize < info.uncompressedSize;
+        EXPECT_EQ(mSource->open(info.filename)->getAsString(), mArch->open(info.filename)->getAsString());
+    }
+    EXPECT_TRUE(anyCompressed);
+}
+//--------------------------------------------------------------------------
+TEST_F(PackArchiveTests,CorruptZstdRejected)
+{
+    pack(PackCompression::ZSTD);
+    mFactory.destroyInstance(mArch);
+    mArch = nullptr;
+
+    String bytes;
+    {
+        std::ifstream in{mPackPath, std::ios::binary};
+        bytes.assign(std::istreambuf_iterator<char>{in}, {});
+    }
+    // break the magic number of every frame
+    String const magic{"\x28\xB5\x2F\xFD"};
+    size_t frames = 0;
+    for (size_t pos = bytes.find(magic); pos != String::npos; pos = bytes.find(magic, pos + 1), ++frames)
+        bytes[pos] = 0;
+    EXPECT_EQ(frames, 2u);
+    {
+        std::ofstream out{mPackPath, std::ios::binary | std::ios::trunc};
+        out.write(bytes.data(), std::streamsize(bytes.size()));
+    }
+
+    mArch = mFactory.createInstance(mPackPath, true);
+    mArch->load();
+    EXPECT_THROW(mArch->open("rootfile.txt"), FileNotFoundException);
+    EXPECT_THROW(mArch->open("rootfile2.txt"), FileNotFoundException);
+}
+//--------------------------------------------------------------------------
+TEST_F(PackArchiveTests,CorruptContentRejected)
+{
+    pack(PackCompression::NONE);
+    mFactory.destroyInstance(mArch);
+    mArch = nullptr;
+
+    String bytes;
+    {
+        std::ifstream in{mPackPath, std::ios::binary};
+        bytes.assign(std::istreambuf_iterator<char>{in}, {});
+    }
+    // stored entries are copied verbatim, so flip a byte of one in place
+    size_t pos = bytes.find("this is line 1 in file 1");
+    ASSERT_NE(String::npos, pos);
+    bytes[pos] = 'T';
+    {
+        std::ofstream out{mPackPath, std::ios::binary | std::ios::trunc};
+        out.write(bytes.data(), std::streamsize(bytes.size()));
+    }
+
+    // without verification the damage goes unnoticed
+    mArch = mFactory.createInstance(mPackPath, true);
+    mArch->load();
+    EXPECT_EQ(String("This is line 1 in file 1"), mArch->open("rootfile.txt")->getLine());
+    mFactory.destroyInstance(mArch);
+
+    mFactory.setVerifyContent(true);
+    mArch = mFactory.createInstance(mPackPath, true);
+    mArch->load();
+    EXPECT_THROW(mArch->open("rootfile.txt"), InvalidParametersException);
+    // the other entries are intact
+    EXPECT_EQ(mSource->open("rootfile2.txt")->getAsString(), mArch->open("rootfile2.txt")->getAsString());
+}
+//--------------------------------------------------------------------------
+TEST_F(PackArchiveTests,TruncatedPackRejected)
+{
+    pack(PackCompression::NONE);
+    mFactory.destroyInstance(mArch);
+    mArch = nullptr;
+
+    // cut into the data of the last entry
+    std::filesystem::resize_file(mPackPath, std::filesystem::file_size(mPackPath) - 1);
+
+    Archive* arch = mFactory.createInstance(mPackPath, true);
+    EXPECT_THROW(arch->load(), InvalidParametersException);
+    mFactory.destroyInstance(arch);
+}
+//--------------------------------------------------------------------------
+namespace {
+    // Text-like input of the reference frames, a small vocabulary mixed with random words
+    auto zstdText(size_t size, uint32 seed) -> String
+    {
+        static constexpr std::string_view words[] = {
+            "the ", "of ", "and ", "mesh ", "texture ", "material ", "pass ", "shader ", "node ", "scene ",
+            "entity ", "light ", "camera ", "frame ", "buffer ", "vertex ", "index ", "\n", "a ", "to "};
+
+        String text;
+        uint32 state = seed;
+        auto next = [&] { state = state * 1664525u + 1013904223u; return state >> 16; };
+        while (text.size() < size)
+        {
+            if (next() % 4 == 0)
+            {
+                for (uint32 n = 3 + next() % 5; n; --n)
+                    text += char('a' + next() % 26);
+                text += ' ';
+            }
+            else
+                text += words[next() % std::size(words)];
+        }
+        text.resize(size);
+        return text;
+    }
+
+    // three 128 KiB blocks, each repeating 600 bytes of its own text
+    auto zstdBlocks() -> String
+    {
+        String data;
+        for (uint32 seed = 1; seed <= 3; ++seed)
+        {
+            String text = zstdText(600, seed);
+            for (size_t i = 0; i < 128 * 1024; ++i)
+                data += text[i % text.size()];
+        }
+        return data;
+    }
+
+    // 40 records of two letters and the same ten digits, so every match has the same length
+    auto zstdRecords() -> String
+    {
+        String data;
+        for (uint32 i = 0; i < 40; ++i)
+        {
+            data += char('a' + i % 26);
+            data += char('A' + i / 26 * 3 + i % 7);
+            data += "0123456789";
+        }
+        return data;
+    }
+
+    // a skippable frame of size filler bytes, using one of its 16 magic numbers
+    auto zstdSkippable(uint32 size) -> std::vector<uchar>
+    {
+        std::vector<uchar> frame{0x5A, 0x2A, 0x4D, 0x18};
+        for (uint32 i = 0; i < 4; ++i)
+            frame.push_back(uchar(size >> (8 * i)));
+        frame.resize(8 + size, 0xCD);
+        return frame;
+    }
+
+    // The frames were made by the reference zstd tool.
+    // zstd -19 --check of zstdBlocks(): the first block has 4-stream Huffman literals and the other two
+    // treeless literals reusing its table, the last also repeats the match length table of the second.
+    uchar const BLOCKS_FRAME[] = {
+        0x28, 0xb5, 0x2f, 0xfd, 0x04, 0x68, 0xc4, 0x09, 0x00, 0x76, 0x52, 0x31, 0x12, 0x90, 0xcf, 0x01,
+        0x60, 0x83, 0x0d, 0x36, 0xd8, 0x60, 0x2d, 0x00, 0xfe, 0xff, 0x3f, 0x5e, 0xff, 0x81, 0x0e, 0x2b,
+        0x00, 0x2b, 0x00, 0x2b, 0x00, 0x83, 0x3a, 0x0c, 0xde, 0xc4, 0xb5, 0x27, 0xe5, 0x18, 0x82, 0x00,
+        0xac, 0x80, 0x62, 0xcf, 0xc0, 0x7e, 0x9b, 0x34, 0xf4, 0x64, 0x2a, 0x9e, 0x34, 0x1c, 0x4f, 0x34,
+        0x5b, 0xbf, 0x5b, 0x0f, 0x79, 0xd2, 0xc2, 0xfb, 0xcc, 0xbf, 0x0b, 0xcf, 0x71, 0xf8, 0x6a, 0x86,
+        0xe0, 0x94, 0x8c, 0x3e, 0x5c, 0xa3, 0x1d, 0xd9, 0xec, 0xcd, 0x42, 0x2c, 0x7d, 0xe6, 0x2d, 0xb4,
+        0x97, 0x8e, 0xbe, 0xf6, 0xd9, 0x0b, 0xb7, 0xca, 0x8b, 0xfb, 0x91, 0x0f, 0xd1, 0x5a, 0x6f, 0x4b,
+        0x20, 0x6e, 0x3e, 0xc4, 0x66, 0x61, 0x5c, 0xca, 0xf0, 0x2e, 0x50, 0xf5, 0xc5, 0xdd, 0xcd, 0x39,
+        0xe2, 0x74, 0xf8, 0x21, 0x33, 0x74, 0x6f, 0x47, 0xd2, 0xc2, 0xc3, 0x63, 0x97, 0x42, 0xc5, 0x8b,
+        0x7b, 0x80, 0x82, 0x30, 0xd3, 0x91, 0xce, 0xdb, 0xf3, 0xa6, 0x94, 0x53, 0xe9, 0x6d, 0x9b, 0x0e,
+        0x31, 0x3e, 0xc4, 0x26, 0xe1, 0xc8, 0x80, 0x55, 0xf5, 0x48, 0x03, 0x67, 0x2d, 0xcb, 0xc3, 0xd1,
+        0xb9, 0xe0, 0x63, 0x65, 0x17, 0xad, 0x31, 0x31, 0xdf, 0x4b, 0x81, 0x97, 0x10, 0xab, 0x0b, 0x9b,
+        0xc7, 0xa0, 0x75, 0x26, 0xa2, 0xed, 0x4b, 0xf9, 0x8a, 0x64, 0x4e, 0xbd, 0x7e, 0xe9, 0xb7, 0x67,
+        0xec, 0x2d, 0x28, 0x10, 0x18, 0x62, 0x0c, 0x93, 0x76, 0x03, 0x11, 0x70, 0x88, 0x2f, 0x3d, 0x29,
+        0xb5, 0xff, 0xff, 0x7f, 0x07, 0xa5, 0xfd, 0x5b, 0x2a, 0x58, 0x2e, 0x80, 0x05, 0x3c, 0x00, 0xa3,
+        0xd1, 0x82, 0x80, 0x54, 0x88, 0x9f, 0xd7, 0xe4, 0xc1, 0xa3, 0x25, 0xb8, 0xb3, 0x07, 0x0b, 0x75,
+        0x7e, 0x84, 0x81, 0xdf, 0xc0, 0x1e, 0x60, 0x88, 0x04, 0x28, 0xc0, 0x50, 0x14, 0x2b, 0x03, 0x2c,
+        0x00, 0xed, 0x01, 0x8b, 0x04, 0x16, 0x08, 0x71, 0x38, 0x0d, 0x0c, 0xc7, 0x59, 0x2b, 0x45, 0x82,
+        0x0b, 0x7e, 0x34, 0x60, 0x3c, 0x0b, 0x4f, 0x38, 0x0c, 0x25, 0x77, 0xa7, 0x64, 0x01, 0xb4, 0x5b,
+        0xaa, 0xba, 0x65, 0xa1, 0x1e, 0x18, 0xa1, 0x65, 0x7c, 0x8b, 0x97, 0xf0, 0x6c, 0x99, 0x18, 0xf1,
+        0x27, 0x94, 0x07, 0x00, 0x63, 0x88, 0x14, 0x35, 0x3f, 0x7a, 0x1c, 0xab, 0x1d, 0x42, 0x7a, 0x76,
+        0x9c, 0x53, 0x88, 0x23, 0xac, 0x87, 0x74, 0x54, 0xbd, 0x4e, 0x8c, 0x46, 0x38, 0xc3, 0x4d, 0x50,
+        0xc5, 0x48, 0xeb, 0x3e, 0x77, 0x7b, 0x6d, 0xb9, 0xf3, 0x45, 0x86, 0xd9, 0x65, 0x1a, 0xe7, 0xb4,
+        0x4b, 0x68, 0x0b, 0xe1, 0xf3, 0x3a, 0x09, 0xd1, 0x9a, 0xd9, 0xcd, 0x51, 0xaa, 0xca, 0x6e, 0x48,
+        0x2a, 0x9d, 0xad, 0x27, 0x15, 0xf7, 0x14, 0x64, 0x38, 0xec, 0xe4, 0x8f, 0x54, 0x5b, 0x8c, 0xaa,
+        0x95, 0x3e, 0xa5, 0xdc, 0x09, 0xf2, 0x1a, 0x17, 0x17, 0x44, 0xa8, 0xf0, 0x6a, 0x64, 0xb4, 0xc9,
+        0x72, 0x11, 0x68, 0x18, 0x88, 0xba, 0xab, 0xec, 0x01, 0x12, 0xe0, 0x12, 0x40, 0x72, 0x5c, 0x9b,
+        0x5a, 0xac, 0xff, 0xff, 0xff, 0x19, 0xa7, 0xfd, 0x5b, 0x9c, 0x2d, 0x1c, 0xa1, 0xf5, 0x3d, 0xf3,
+        0x0c, 0x60, 0x4d, 0x6f, 0x18, 0x0f, 0x17, 0x92, 0xa8, 0x79, 0x19, 0x38, 0x4e, 0xc3, 0xcb, 0xfc,
+        0x33, 0xec, 0x2f, 0x60, 0xc0, 0x3e, 0x18, 0xa6, 0x50, 0x00, 0x3e, 0x5a, 0x4f, 0x4b, 0x52, 0x0d,
+        0x28, 0x75, 0x9c, 0x30, 0x91, 0x50, 0x55, 0xd1, 0x24, 0x4b, 0xff, 0xfb, 0xfb, 0xdf, 0x2b, 0xbd,
+        0x4c, 0xad, 0x61, 0xc1, 0xc1, 0xb8, 0xae, 0xdc, 0xa7, 0xba, 0xf9, 0x00, 0xb4, 0x29, 0x28, 0xe5,
+        0xfb, 0xa3, 0x7a, 0x0d, 0xd3, 0x8a, 0x92, 0x22, 0xc5, 0xfb, 0x17, 0xb5, 0x90, 0xcd, 0xa4, 0xc6,
+        0x43, 0x08, 0x08, 0x50, 0x03, 0x31, 0x7b, 0xc8, 0x93, 0xdd, 0x06, 0xf9, 0xd7, 0xc6, 0xcb, 0x9f,
+        0xa1, 0x5f, 0x73, 0x9e, 0x9a, 0x21, 0x05, 0xca, 0x62, 0xf6, 0xbf, 0x16, 0x11, 0xf8, 0xdb, 0xbf,
+        0xf4, 0x95, 0xe5, 0xa9, 0xe0, 0x01, 0xb5, 0x07, 0x00, 0xc3, 0x4a, 0x1a, 0xa4, 0xc8, 0x59, 0xc8,
+        0x4d, 0x09, 0x4d, 0x88, 0x5c, 0xae, 0xad, 0x02, 0x34, 0xae, 0x4a, 0xe3, 0x89, 0x7e, 0x62, 0xa1,
+        0x52, 0xbe, 0x18, 0x2e, 0xaf, 0x4d, 0x8a, 0xa3, 0x65, 0x84, 0x2f, 0x66, 0x67, 0x91, 0x35, 0x1b,
+        0x17, 0xce, 0xaa, 0x25, 0x44, 0xc0, 0x42, 0x22, 0xc0, 0x4e, 0x13, 0x1a, 0x32, 0x0c, 0xb9, 0x40,
+        0x22, 0x33, 0x04, 0xd7, 0x9a, 0xcc, 0x1d, 0xf3, 0x99, 0x96, 0xd7, 0x64, 0x9b, 0x8a, 0x0f, 0x65,
+        0x28, 0x57, 0x97, 0x39, 0x76, 0x36, 0x44, 0xb7, 0x7e, 0x84, 0xcc, 0xb0, 0x52, 0x96, 0xa5, 0x3d,
+        0xa2, 0x73, 0x26, 0x47, 0x38, 0x37, 0x97, 0xdb, 0x15, 0x69, 0x31, 0xb9, 0x0b, 0x2f, 0x6e, 0xa9,
+        0x17, 0x9b, 0x29, 0xfd, 0x02, 0x40, 0xac, 0x71, 0x06, 0x52, 0xea, 0x54, 0x0b, 0x95, 0x65, 0x0d,
+        0x11, 0x24, 0x08, 0x85, 0x13, 0xad, 0xb7, 0xd6, 0x01, 0xa5, 0xfd, 0x5b, 0x18, 0x13, 0xe6, 0x53,
+        0xa9, 0x0f, 0xf6, 0x66, 0x18, 0xe0, 0x98, 0x4b, 0xcb, 0xb1, 0x35, 0x90, 0x94, 0x33, 0x42, 0x7f,
+        0xc5, 0x88, 0x02, 0x31, 0x6f, 0x27, 0x9c, 0xdd, 0x81, 0x56, 0x29, 0x8c, 0x65, 0xd2, 0x82, 0x0e,
+        0xe1, 0x27, 0xbd, 0x79, 0x5d, 0x48, 0xe1, 0xcf, 0xe6, 0xf1, 0xba, 0xb1, 0xb8, 0x58, 0x7f, 0xd5,
+        0xe9, 0x10, 0xd1, 0x00, 0x10, 0x03, 0x09, 0xc5, 0x7b, 0xa5, 0x0f, 0x21, 0xfc, 0xae, 0xa6, 0x8b,
+        0x8b, 0x6f, 0x1e, 0x3f, 0x23, 0xb1, 0xff, 0x7a, 0xaf, 0x0b, 0xe0, 0xb2, 0xcf, 0x4b, 0xb7, 0xe7,
+        0x90, 0x3d, 0x0b, 0x70, 0x03, 0xac, 0x89, 0x80, 0x80, 0xa2, 0xcd, 0x64, 0xf0, 0x7d, 0x38, 0xfc,
+        0x0f, 0x11, 0x52, 0x2c, 0xda, 0x7f, 0x8e, 0x0c, 0x38, 0x75, 0xdf, 0x57, 0x35, 0x1a, 0x21, 0x8f,
+        0x47, 0xb0, 0x12,
+    };
+    // zstd -19 --check of zstdRecords(): single stream Huffman literals and RLE coded match lengths
+    uchar const RECORDS_FRAME[] = {
+        0x28, 0xb5, 0x2f, 0xfd, 0x04, 0x68, 0x2d, 0x03, 0x00, 0xa2, 0x45, 0x15, 0x18, 0x50, 0x79, 0x03,
+        0xbf, 0x16, 0xc0, 0xaf, 0x05, 0x04, 0xcc, 0x00, 0xbb, 0x77, 0x4a, 0x99, 0x62, 0xd9, 0x8d, 0x04,
+        0xa8, 0xaa, 0xaa, 0x6a, 0x54, 0xf5, 0x7a, 0xcb, 0xab, 0xa6, 0x78, 0xba, 0x92, 0x8d, 0x2a, 0xf4,
+        0x8f, 0x3b, 0xdd, 0x30, 0x73, 0x17, 0xab, 0xf4, 0xc8, 0x22, 0x0d, 0x27, 0x28, 0xbf, 0xf7, 0xbc,
+        0x6b, 0x8e, 0x37, 0xaa, 0xcd, 0x4c, 0x62, 0x7f, 0xb9, 0xd5, 0x15, 0x53, 0x74, 0x9a, 0x92, 0x8c,
+        0x1e, 0xf2, 0xa7, 0x1d, 0x6e, 0x28, 0x33, 0x97, 0x04, 0x39, 0x8c, 0x82, 0x18, 0x84, 0x00, 0x90,
+        0x4a, 0x27, 0xa4, 0x10, 0xf2, 0xfb, 0x1b, 0xe0, 0xd7, 0x07, 0x68, 0xfd, 0x94, 0x02, 0xcb, 0x3a,
+        0x53, 0xe1,
+    };
+    // zstd -19 --no-check of 200000 'x': a compressed block followed by an RLE block
+    uchar const RUN_FRAME[] = {
+        0x28, 0xb5, 0x2f, 0xfd, 0x00, 0x68, 0x4c, 0x00, 0x00, 0x08, 0x78, 0x01, 0x00, 0xfc, 0xff, 0x39,
+        0x10, 0x02, 0x03, 0x6a, 0x08, 0x78,
+    };
+
+    auto zstdFrames(std::initializer_list<std::vector<uchar>> parts) -> std::vector<uchar>
+    {
+        std::vector<uchar> frames;
+        for (const auto& part : parts)
+            frames.insert(frames.end(), part.begin(), part.end());
+        return frames;
+    }
+    auto const BLOCKS = std::vector<uchar>(std::begin(BLOCKS_FRAME), std::end(BLOCKS_FRAME));
+    auto const RECORDS = std::vector<uchar>(std::begin(RECORDS_FRAME), std::end(RECORDS_FRAME));
+    auto const RUN = std::vector<uchar>(std::begin(RUN_FRAME), std::end(RUN_FRAME));
+}
+//--------------------------------------------------------------------------
+TEST_F(PackArchiveTests,ZstdHuffmanLiterals)
+{
+    packFrames(BLOCKS, 3 * 128 * 1024);
+    EXPECT_EQ(zstdBlocks(), mArch->open("frames.zst")->getAsString());
+
+    packFrames(RECORDS, 480);
+    EXPECT_EQ(zstdRecords(), mArch->open("frames.zst")->getAsString());
+}
+//--------------------------------------------------------------------------
+TEST_F(PackArchiveTests,ZstdRLEBlocks)
+{
+    packFrames(RUN, 200000);
+    EXPECT_EQ(String(200000, 'x'), mArch->open("frames.zst")->getAsString());
+}
+//--------------------------------------------------------------------------
+TEST_F(PackArchiveTests,ZstdMultipleFrames)
+{
+    // frames are concatenated, skippable ones anywhere, including empty ones
+    packFrames(zstdFrames({zstdSkippable(5), RECORDS, zstdSkippable(0), RUN, BLOCKS}), 480 + 200000 + 3 * 128 * 1024);
+    EXPECT_EQ(zstdRecords() + String(200000, 'x') + zstdBlocks(), mArch->open("frames.zst")->getAsString());
+
+    packFrames(zstdSkippable(16), 0);
+    EXPECT_EQ(String(), mArch->open("frames.zst")->getAsString());
+}
+//--------------------------------------------------------------------------
+TEST_F(PackArchiveTests,ZstdTruncatedRejected)
+{
+    for (size_t length : {size_t(0), size_t(4), size_t(20), BLOCKS.size() / 2, BLOCKS.size() - 4, BLOCKS.size() - 1})
+    {
+        packFrames({BLOCKS.begin(), BLOCKS.begin() + length}, 3 * 128 * 1024);
+        EXPECT_THROW(mArch->open("frames.zst"), FileNotFoundException) << length << " bytes";
+    }
+
+    // a skippable frame running past the end
+    auto skippable = zstdSkippable(16);
+    skippable.resize(12);
+    packFrames(zstdFrames({RECORDS, skippable}), 480);
+    EXPECT_THROW(mArch->open("frames.zst"), FileNotFoundException);
+}
+//--------------------------------------------------------------------------
+TEST_F(PackArchiveTests,ZstdCorruptRejected)
+{
+    // the content checksum
+    auto frames = BLOCKS;
+    frames.back() ^= 1;
+    packFrames(frames, 3 * 128 * 1024);
+    EXPECT_THROW(mArch->open("frames.zst"), FileNotFoundException);
+
+    // the compressed data of the second block
+    frames = BLOCKS;
+    frames[frames.size() / 2] ^= 0x10;
+    packFrames(frames, 3 * 128 * 1024);
+    EXPECT_THROW(mArch->open("frames.zst"), FileNotFoundException);
+
+    // a reserved block type
+    frames = RUN;
+    frames[6] |= 0x06;
+    packFrames(frames, 200000);
+    EXPECT_THROW(mArch->open("frames.zst"), FileNotFoundException);
+
+    // more or less content than the entry size
+    packFrames(RECORDS, 481);
+    EXPECT_THROW(mArch->open("frames.zst"), FileNotFoundException);
+    packFrames(RECORDS, 479);
+    EXPECT_THROW(mArch->open("frames.zst"), FileNotFoundException);
+}
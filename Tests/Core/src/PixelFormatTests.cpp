@@ -38,10 +38,14 @@ import :Core.PixelFormat;
 
 import Ogre.Core;
 
+import <chrono>;
 import <format>;
 import <iomanip>;
+import <iostream>;
 import <ostream>;
 import <string>;
+import <utility>;
+import <vector>;
 
 // Register the test suite
 //--------------------------------------------------------------------------
@@ -242,5 +246,62 @@ TEST_F(PixelFormatTests,BulkConversion)
     testCase(PixelFormat::X8B8G8R8, PixelFormat::A8B8G8R8);
     testCase(PixelFormat::X8B8G8R8, PixelFormat::B8G8R8A8);
     testCase(PixelFormat::X8B8G8R8, PixelFormat::R8G8B8A8);
+
+    // Vectorised
+    testCase(PixelFormat::R8G8B8, PixelFormat::R8G8B8A8);
+    testCase(PixelFormat::L8, PixelFormat::R8G8B8A8);
+    testCase(PixelFormat::BYTE_LA, PixelFormat::A8R8G8B8);
+    testCase(PixelFormat::BYTE_LA, PixelFormat::R8G8B8A8);
+    testCase(PixelFormat::A8R8G8B8, PixelFormat::FLOAT32_RGBA);
+    testCase(PixelFormat::R8G8B8A8, PixelFormat::FLOAT32_RGBA);
+    testCase(PixelFormat::X8R8G8B8, PixelFormat::FLOAT32_RGBA);
+    testCase(PixelFormat::B8G8R8, PixelFormat::FLOAT32_RGBA);
+    testCase(PixelFormat::L8, PixelFormat::FLOAT32_RGBA);
+    testCase(PixelFormat::BYTE_LA, PixelFormat::FLOAT32_RGBA);
+    testCase(PixelFormat::FLOAT32_R, PixelFormat::FLOAT16_R);
+    testCase(PixelFormat::FLOAT32_GR, PixelFormat::FLOAT16_GR);
+    testCase(PixelFormat::FLOAT32_RGB, PixelFormat::FLOAT16_RGB);
+    testCase(PixelFormat::FLOAT32_RGBA, PixelFormat::FLOAT16_RGBA);
+}
+//--------------------------------------------------------------------------
+// Run with --gtest_also_run_disabled_tests to compare against the per pixel path
+TEST_F(PixelFormatTests,DISABLED_BulkConversionThroughput)
+{
+    const std::pair<PixelFormat, PixelFormat> pairs[] = {
+        {PixelFormat::A8R8G8B8, PixelFormat::A8B8G8R8},
+        {PixelFormat::B8G8R8A8, PixelFormat::R8G8B8A8},
+        {PixelFormat::R8G8B8, PixelFormat::A8B8G8R8},
+        {PixelFormat::B8G8R8, PixelFormat::B8G8R8A8},
+        {PixelFormat::L8, PixelFormat::A8R8G8B8},
+        {PixelFormat::BYTE_LA, PixelFormat::A8B8G8R8},
+        {PixelFormat::A8B8G8R8, PixelFormat::FLOAT32_RGBA},
+        {PixelFormat::R8G8B8, PixelFormat::FLOAT32_RGBA},
+        {PixelFormat::L8, PixelFormat::FLOAT32_RGBA},
+        {PixelFormat::FLOAT32_RGBA, PixelFormat::FLOAT16_RGBA},
+    };
+
+    const uint32 width = 1024, height = 1024;
+    std::vector<uint8> srcData(width * height * 16), dstData(width * height * 16);
+    for (size_t i = 0; i < srcData.size(); ++i)
+        srcData[i] = uint8(i * 7919 >> 3);
+
+    auto millisecondsFor = [](auto&& convert)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 10; ++i)
+            convert();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / 10;
+    };
+
+    for (auto [srcFormat, dstFormat] : pairs)
+    {
+        PixelBox src(width, height, 1, srcFormat, srcData.data());
+        PixelBox dst(width, height, 1, dstFormat, dstData.data());
+        double bulk = millisecondsFor([&] { PixelUtil::bulkPixelConversion(src, dst); });
+        double naive = millisecondsFor([&] { naiveBulkPixelConversion(src, dst); });
+        std::cout << std::format("{:>14} -> {:<14} {:8.3f} ms {:8.3f} ms per pixel {:6.1f}x\n",
+                                 PixelUtil::getFormatName(srcFormat), PixelUtil::getFormatName(dstFormat),
+                                 bulk, naive, naive / bulk);
+    }
 }
 //--------------------------------------------------------------------------
@@ -39,6 +39,7 @@ import Ogre.Core;
 import <format>;
 import <map>;
 import <string>;
+import <thread>;
 import <utility>;
 import <vector>;
 
@@ -255,3 +256,21 @@ TEST_F(ZipArchiveTests,ReadInterleave)
     EXPECT_TRUE(stream2->eof());
 }
 //--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+TEST_F(ZipArchiveTests,ConcurrentOpen)
+{
+    EXPECT_TRUE(arch->exists("level1/materials/scripts/file.material"));
+    EXPECT_FALSE(arch->exists("file.material"));
+
+    std::vector<String> contents(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < contents.size(); ++i)
+        threads.emplace_back([&, i] { contents[i] = arch->open(i % 2 ? "rootfile2.txt" : "rootfile.txt")->getAsString(); });
+    for (auto& t : threads)
+        t.join();
+
+    for (size_t i = 0; i < contents.size(); ++i)
+        EXPECT_EQ(contents[i], contents[i % 2]);
+    EXPECT_EQ(contents[0].size(), (size_t)130);
+    EXPECT_EQ(contents[1].size(), (size_t)156);
+}
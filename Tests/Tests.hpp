@@ -4,6 +4,7 @@ export import :Core.EdgeBuilder;
 export import :Core.FileSystemArchive;
 export import :Core.MeshSerializer;
 export import :Core.MeshWithoutIndexData;
+export import :Core.PackArchive;
 export import :Core.PixelFormat;
 export import :Core.RadixSort;
 export import :Core.RenderSystemCapabilities;
@@ -0,0 +1,87 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+import Ogre.Core;
+
+import <iostream>;
+import <memory>;
+import <string_view>;
+import <vector>;
+
+namespace {
+    void help()
+    {
+        std::cout << "OgrePacker: packs a directory into an OgrePack archive\n"
+                     "Usage: OgrePacker [-z|-l|-s] <source directory> <pack file>\n"
+                     "  -z  deflate compress entries which get smaller\n"
+                     "  -l  LZ4 compress entries which get smaller\n"
+                     "  -s  Zstandard compress entries which get smaller\n";
+    }
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    std::vector<std::string_view> args{argv + 1, argv + argc};
+
+    auto compression = Ogre::PackCompression::NONE;
+    if (!args.empty() && (args.front() == "-z" || args.front() == "-l" || args.front() == "-s"))
+    {
+        compression = args.front() == "-z" ? Ogre::PackCompression::DEFLATE
+                    : args.front() == "-l" ? Ogre::PackCompression::LZ4
+                                           : Ogre::PackCompression::ZSTD;
+        args.erase(args.begin());
+    }
+
+    if (args.size() != 2)
+    {
+        help();
+        return 1;
+    }
+
+    Ogre::LogManager logMgr{};
+    logMgr.createLog("OgrePacker.log", true, false, true);
+
+    try
+    {
+        Ogre::FileSystemArchiveFactory factory;
+        std::unique_ptr<Ogre::Archive> source{factory.createInstance(args[0], true)};
+        source->load();
+
+        Ogre::PackWriter writer;
+        writer.addArchive(source.get(), compression);
+        writer.write(args[1]);
+
+        std::cout << "Packed " << writer.getNumFiles() << " files into " << args[1] << "\n";
+    }
+    catch (const Ogre::Exception& e)
+    {
+        std::cerr << e.getFullDescription() << "\n";
+        return 1;
+    }
+
+    return 0;
+}